@@ -0,0 +1,183 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A network interface that is not connected to any network, used by the
+ * benchmarks in main_benchmark.c.  Frames sent by the IP stack are counted and
+ * discarded.  When ipconfigUSE_TCP_SEGMENTATION_OFFLOAD or
+ * ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD is enabled, the interface can pretend to
+ * split large TCP sends or to set and check checksums in hardware, see
+ * vBenchmarkNetworkSetCapabilities().  Frames are received when the benchmark
+ * passes them to xBenchmarkNetworkReceive(), so the time measured is the time
+ * the IP stack takes to process them, not the time a real driver or the host
+ * takes to move them.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "NetworkInterface.h"
+#include "NetworkBufferManagement.h"
+
+#include "BenchmarkNetworkInterface.h"
+
+/* Only written by the IP task. */
+static volatile uint32_t ulFramesSent = 0U;
+static volatile uint32_t ulTCPDataSent = 0U;
+
+/* The ipNETWORK_CAPABILITY_... bits that the interface reports. */
+static UBaseType_t uxCapabilities = 0U;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xNetworkInterfaceInitialise( void )
+{
+    /* There is no hardware to wait for. */
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xNetworkInterfaceOutput( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                    BaseType_t xReleaseAfterSend )
+{
+    /* MISRA Ref 11.3.1 [Misaligned access] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+    /* coverity[misra_c_2012_rule_11_3_violation] */
+    const TCPPacket_t * pxTCPPacket = ( ( const TCPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
+    size_t uxDataLength = 0U;
+
+    iptraceNETWORK_INTERFACE_TRANSMIT();
+
+    if( ( pxTCPPacket->xEthernetHeader.usFrameType == ipIPv4_FRAME_TYPE ) &&
+        ( pxTCPPacket->xIPHeader.ucProtocol == ( uint8_t ) ipPROTOCOL_TCP ) )
+    {
+        uxDataLength = ( size_t ) FreeRTOS_ntohs( pxTCPPacket->xIPHeader.usLength );
+        uxDataLength -= ( size_t ) ( ( pxTCPPacket->xIPHeader.ucVersionHeaderLength & 0x0FU ) << 2 );
+        uxDataLength -= ( size_t ) ( ( pxTCPPacket->xTCPHeader.ucTCPOffset & 0xF0U ) >> 2 );
+        ulTCPDataSent += ( uint32_t ) uxDataLength;
+    }
+
+    #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+        if( pxNetworkBuffer->usSegmentSize != 0U )
+        {
+            /* A large send, which hardware would split into this many frames. */
+            ulFramesSent += ( uint32_t ) ( ( uxDataLength + pxNetworkBuffer->usSegmentSize - 1U ) / pxNetworkBuffer->usSegmentSize );
+        }
+        else
+    #endif
+    {
+        ulFramesSent++;
+    }
+
+    if( xReleaseAfterSend != pdFALSE )
+    {
+        vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+    }
+
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xGetPhyLinkStatus( void )
+{
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 ) || ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 )
+
+    UBaseType_t uxNetworkInterfaceGetCapabilities( void )
+    {
+        return uxCapabilities;
+    }
+
+#endif
+/*-----------------------------------------------------------*/
+
+NetworkBufferDescriptor_t * pxBenchmarkNetworkFrame( const uint8_t * pucFrame,
+                                                     size_t uxLength )
+{
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+
+    pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxLength, 0U );
+
+    if( pxNetworkBuffer != NULL )
+    {
+        ( void ) memcpy( pxNetworkBuffer->pucEthernetBuffer, pucFrame, uxLength );
+        pxNetworkBuffer->xDataLength = uxLength;
+    }
+
+    return pxNetworkBuffer;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xBenchmarkNetworkReceive( NetworkBufferDescriptor_t * pxNetworkBuffer )
+{
+    IPStackEvent_t xRxEvent = { eNetworkRxEvent, NULL };
+    BaseType_t xReturn;
+
+    iptraceNETWORK_INTERFACE_RECEIVE();
+
+    xRxEvent.pvData = ( void * ) pxNetworkBuffer;
+
+    /* A block time of zero, so this can be called while the scheduler is
+     * suspended. */
+    xReturn = xSendEventStructToIPTask( &xRxEvent, 0U );
+
+    if( xReturn == pdFAIL )
+    {
+        iptraceETHERNET_RX_EVENT_LOST();
+        vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulBenchmarkNetworkFramesSent( void )
+{
+    return ulFramesSent;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulBenchmarkNetworkTCPDataSent( void )
+{
+    return ulTCPDataSent;
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkNetworkSetCapabilities( UBaseType_t uxNewCapabilities )
+{
+    uxCapabilities = uxNewCapabilities;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,67 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef BENCHMARK_NETWORK_INTERFACE_H
+#define BENCHMARK_NETWORK_INTERFACE_H
+
+#include "NetworkBufferManagement.h"
+
+/*
+ * Copy a complete Ethernet frame into a network buffer that can later be passed
+ * to xBenchmarkNetworkReceive().  Returns NULL if no network buffer is free.
+ */
+NetworkBufferDescriptor_t * pxBenchmarkNetworkFrame( const uint8_t * pucFrame,
+                                                     size_t uxLength );
+
+/*
+ * Hand a frame to the IP task as if it had been received by a network driver,
+ * without blocking.  The buffer is released if the IP task's queue is full, in
+ * which case pdFAIL is returned.
+ */
+BaseType_t xBenchmarkNetworkReceive( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/*
+ * The number of frames the IP stack has sent since the network was started.
+ * Sent frames are counted, then discarded.
+ */
+uint32_t ulBenchmarkNetworkFramesSent( void );
+
+/*
+ * The number of bytes of TCP data the IP stack has sent since the network was
+ * started.
+ */
+uint32_t ulBenchmarkNetworkTCPDataSent( void );
+
+/*
+ * Set the ipNETWORK_CAPABILITY_... bits that uxNetworkInterfaceGetCapabilities()
+ * returns.  With ipNETWORK_CAPABILITY_TCP_SEGMENTATION, a large TCP send is
+ * counted as the number of frames that it would be split into.  The checksum
+ * bits only make the stack skip its own checksum work; the interface does not
+ * set or check anything.
+ */
+void vBenchmarkNetworkSetCapabilities( UBaseType_t uxNewCapabilities );
+
+#endif /* BENCHMARK_NETWORK_INTERFACE_H */
@@ -76,6 +76,9 @@ configMAX_PRIORITIES - 1. */
 unsigned long ulGetRunTimeCounterValue( void ); /* Prototype of function that returns run time counter. */
 void vConfigureTimerForRunTimeStats( void );	/* Prototype of function that initialises the run time counter. */
 #define configGENERATE_RUN_TIME_STATS			1
+#define configRUN_TIME_COUNTER_TYPE				unsigned long /* The counter is in nanoseconds, so would soon overflow 32 bits. */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vConfigureTimerForRunTimeStats()
+#define portGET_RUN_TIME_COUNTER_VALUE()		ulGetRunTimeCounterValue()
 
 /* Co-routine related configuration options. */
 #define configUSE_CO_ROUTINES 					0
@@ -53,6 +53,7 @@ void console_print( const char * fmt,
 
     vprintf( fmt, vargs );
 
+    xSemaphoreGive( xStdioMutex );
 
     va_end( vargs );
 }
@@ -25,13 +25,17 @@
  */
 
 /******************************************************************************
- * This project provides one demo application.  A TCP echo demo.
+ * This project provides two demo applications.  A TCP echo demo and a set of
+ * FreeRTOS+TCP benchmarks.
  * The mainSELECTED_APPLICATION setting is used to select between
- * the three
+ * the two.  It is set with USER_DEMO on the make command line.
  *
  * If mainSELECTED_APPLICATION = ECHO_CLIENT_DEMO the tcp echo demo will be built.
  * This is implemented and described in main_networking.c
  *
+ * If mainSELECTED_APPLICATION = BENCHMARK_DEMO a set of FreeRTOS+TCP benchmarks
+ * is built.  These are implemented and described in main_benchmark.c.
+ *
  * This file implements the code that is not demo specific, including the
  * hardware setup and FreeRTOS hook functions.
  *
@@ -65,13 +69,19 @@
 #include <trcRecorder.h>
 
 #define    ECHO_CLIENT_DEMO         0
+#define    BENCHMARK_DEMO           1
 
-#define mainSELECTED_APPLICATION    ECHO_CLIENT_DEMO
+#ifdef USER_DEMO
+    #define mainSELECTED_APPLICATION    USER_DEMO
+#else
+    #define mainSELECTED_APPLICATION    ECHO_CLIENT_DEMO
+#endif
 
 /* This demo uses heap_3.c (the libc provided malloc() and free()). */
 
 /*-----------------------------------------------------------*/
 extern void main_tcp_echo_client_tasks( void );
+extern void main_benchmark( void );
 static void traceOnEnter( void );
 
 /*
@@ -112,8 +122,14 @@ static BaseType_t xTraceRunning = pdTRUE;
 
 int main( void )
 {
-    /* Do not include trace code when performing a code coverage analysis. */
-    #if ( projCOVERAGE_TEST != 1 )
+    /* Do not include trace code when performing a code coverage analysis.  The
+     * benchmarks initialise the trace recorder, but do not start it, so it does
+     * not add to the times they measure. */
+    #if ( projCOVERAGE_TEST != 1 ) && ( mainSELECTED_APPLICATION == BENCHMARK_DEMO )
+        {
+            xTraceInitialize();
+        }
+    #elif ( projCOVERAGE_TEST != 1 )
         {
             /* Initialise the trace recorder.  Use of the trace recorder is optional.
              * See http://www.FreeRTOS.org/trace for more information. */
@@ -133,6 +149,11 @@ int main( void )
             console_print( "Starting echo client demo\n" );
             main_tcp_echo_client_tasks();
         }
+    #elif ( mainSELECTED_APPLICATION == BENCHMARK_DEMO )
+        {
+            console_print( "Starting benchmarks\n" );
+            main_benchmark();
+        }
     #else
         {
             #error "The selected demo is not valid"
@@ -0,0 +1,1251 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/******************************************************************************
+ * NOTE 1: The FreeRTOS demo threads will not be running continuously, so
+ * do not expect to get real time behaviour from the FreeRTOS Linux port, or
+ * this demo application.  The rates measured are only meaningful when compared
+ * with the rates measured by another build on the same machine.
+ *
+ * NOTE 2:  This file only contains the source code that is specific to the
+ * benchmarks.  Generic functions, such FreeRTOS hook functions, are defined in
+ * main.c.  Build it with:
+ *
+ *     make USER_DEMO=BENCHMARK_DEMO
+ *
+ * adding the options that select the FreeRTOS+TCP features to measure, for
+ * example TCP_HASH_TABLE=1, to compare the results of two builds.  The
+ * benchmark build does not use libpcap: the IP stack is connected to the
+ * network interface in BenchmarkNetworkInterface.c, which discards the frames
+ * sent by the stack and receives the frames built by the benchmarks.
+ ******************************************************************************
+ *
+ * main_benchmark() starts the IP stack.  When the network is up a single
+ * benchmark task, of lower priority than the IP task, runs each benchmark in
+ * turn, prints the results, then ends the scheduler.  The peer is on another
+ * subnet, so the stack never waits for an ARP reply, and the initial sequence
+ * numbers of both ends are constants, so the benchmark can build every frame
+ * of a connection in advance.
+ *
+ * The TCP Lookup Benchmark:
+ * A socket listens on port mainBENCHMARK_PORT.  1, 16, 64, 256 and 400
+ * connections from the same peer, each from its own port, are opened by
+ * passing a SYN and an ACK to the stack for each connection and accepting the
+ * new socket.  The benchmark then passes pure ACKs, which the stack processes
+ * without replying, to the connections in turn for one second, and reports
+ * the number of segments processed per second, and the run time of the IP
+ * task per segment.  The ACKs are passed in batches
+ * of mainBATCH_SIZE while the scheduler is suspended, so the IP task
+ * processes a whole batch each time it runs.  Every segment is matched to its
+ * socket by pxTCPSocketLookup(), which searches the list of all bound TCP
+ * sockets unless TCP_HASH_TABLE=1 sets ipconfigUSE_TCP_HASH_TABLE to 1, in
+ * which case the rate should not depend on the number of connections.  Each
+ * time the IP task has emptied its queue it also checks the timers of every
+ * TCP socket, which costs the same in both builds, and on this port the
+ * segments per second are further limited by the Linux thread switches between
+ * the benchmark task and the IP task, so the run time of the IP task shows the
+ * difference more clearly.
+ *
+ * The TCP Receive Burst Benchmark:
+ * A second socket listens on port mainBURST_PORT and accepts
+ * mainBURST_CONNECTIONS connections.  For one second the benchmark passes
+ * batches of data segments to the connections in turn, then reads the data
+ * from every connection.  The receive buffers of the demo are smaller than two
+ * segments of the default MSS, so the stack acknowledges each segment straight
+ * away, unless RX_BURST=n sets ipconfigIP_RX_BURST_LENGTH to n.  The IP task
+ * then handles up to n frames in a row without checking its timers in
+ * between, and each connection sends one ACK at the end of the burst.  The
+ * benchmark reports the segments processed per second, the run time of the IP
+ * task per segment, and the number of frames the stack sent per 100 segments.
+ *
+ * The TCP Bulk Send Benchmark:
+ * A third socket listens on port mainBULK_PORT and accepts
+ * mainBULK_CONNECTIONS connections, for which the peer announces a large MSS,
+ * so the segments are as large as the MTU allows.  For one second the
+ * benchmark gives each connection mainBULK_SEGMENTS full-sized segments of
+ * data, lets the IP task send them, then acknowledges all data sent.  Normally
+ * every segment is prepared and sent on its own.  When TCP_TSO=1 sets
+ * ipconfigUSE_TCP_SEGMENTATION_OFFLOAD to 1 the segments are prepared as one
+ * large send, which is measured twice: once split into frames by the IP task,
+ * and once passed as a whole to the network interface, as to a driver whose
+ * hardware splits it.  When CHECKSUM_OFFLOAD=1 sets
+ * ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD to 1, it is measured once more with an
+ * interface that reports that it sets and checks the checksums, so the IP task
+ * neither sets the checksums of the data nor checks those of the ACKs.  The
+ * benchmark reports the data sent per second and the run time of the IP task
+ * per KB of data.
+ *
+ * The Checksum Benchmark:
+ * Runs in the benchmark task only.  usGenerateChecksum() is first compared
+ * with a simple byte by byte implementation of RFC 1071 for every length up
+ * to mainCHECKSUM_MAX_SIZE at every alignment.  The benchmark then reports
+ * the time of one call for an IP header, a small packet, the minimum datagram
+ * size and a full-sized segment, starting at an aligned and at an odd address.
+ * CHECKSUM_64=1 sets ipconfigUSE_64BIT_CHECKSUM to 1, which sums 32-bit words
+ * into 64-bit sums rather than counting the carries of 32-bit sums.  Last it
+ * compares the time of usChecksumUpdate(), which updates the IP header
+ * checksum after a change of the TTL, with that of summing the header again.
+ *
+ * The Select Benchmark:
+ * Reuses the connections of the lookup benchmark.  1, 16, 64, 256 and 400 of
+ * them are added to a socket set for READ events, of which at most
+ * mainSELECT_ACTIVE connections, spread over the set, receive data.  For one
+ * second the benchmark passes a data segment to one of the active connections
+ * in turn, waits for the set without blocking, and reads the data from the
+ * connection that is ready.  FreeRTOS_select() has the IP task walk through
+ * all bound sockets to find the ready members, after which the benchmark tests
+ * every member with FreeRTOS_FD_ISSET().  When SOCKET_READY_LIST=1 sets
+ * ipconfigUSE_SOCKET_READY_LIST to 1, FreeRTOS_select_ready() is used
+ * instead: the IP task only checks the sockets that had an event, however many
+ * sockets are bound, and the ready ones are returned.  The benchmark reports the events handled per second, the time of the
+ * benchmark task and the run time of the IP task per event.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_TCP_IP.h"
+#include "NetworkBufferManagement.h"
+
+/* Local includes. */
+#include "console.h"
+#include "BenchmarkNetworkInterface.h"
+
+/* The benchmark task runs below the IP task, so a frame passed to the IP task
+ * is processed before the benchmark task continues. */
+#define mainBENCHMARK_TASK_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+
+/* The port the lookup benchmark listens on. */
+#define mainBENCHMARK_PORT             ( 8080U )
+
+/* The first port used by the peer, one port per connection. */
+#define mainPEER_FIRST_PORT            ( 20000U )
+
+/* The initial sequence numbers of both ends of every connection. */
+#define mainSERVER_ISN                 ( 0x10000000UL )
+#define mainPEER_ISN                   ( 0x20000000UL )
+
+/* The largest number of connections opened by the lookup benchmark. */
+#define mainLOOKUP_MAX_CONNECTIONS     ( 400U )
+
+/* The port the receive burst benchmark listens on, the first port the peer
+ * uses for its connections, and the number of connections. */
+#define mainBURST_PORT                 ( 8081U )
+#define mainBURST_PEER_FIRST_PORT      ( 30000U )
+#define mainBURST_CONNECTIONS          ( 10U )
+
+/* The port the bulk send benchmark listens on, the first port the peer uses
+ * for its connections, the number of connections, the MSS the peer announces,
+ * and the number of segments each connection sends per round. */
+#define mainBULK_PORT                  ( 8082U )
+#define mainBULK_PEER_FIRST_PORT       ( 40000U )
+#define mainBULK_CONNECTIONS           ( 8U )
+#define mainBULK_PEER_MSS              ( 1460U )
+#define mainBULK_SEGMENTS              ( 6U )
+
+/* The amount of data in each segment of the receive burst benchmark.  Each
+ * connection receives mainBATCH_SIZE / mainBURST_CONNECTIONS segments per
+ * batch, which must fit in its receive buffer. */
+#define mainBURST_SEGMENT_SIZE         ( 100U )
+
+/* The number of frames passed to the IP task each time it runs.  Fewer than
+ * the number of network buffers and the length of the IP task's queue. */
+#define mainBATCH_SIZE                 ( 50U )
+
+/* A TCP segment without options or data.  The room TCPPacket_t leaves for
+ * options is not counted in the IP length, so is padding. */
+#define mainTCP_FRAME_LENGTH           ( sizeof( TCPPacket_t ) )
+
+/* A TCP segment of the receive burst benchmark. */
+#define mainTCP_DATA_FRAME_LENGTH      ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + mainBURST_SEGMENT_SIZE )
+
+/* IPv4, with a header of five 32-bit words. */
+#define mainIPV4_VERSION_HEADER_LENGTH ( 0x45U )
+
+/* The longest data summed by the checksum benchmark, the number of calls
+ * timed in each measurement, and the number of measurements of which the
+ * fastest is reported. */
+#define mainCHECKSUM_MAX_SIZE          ( 1460U )
+#define mainCHECKSUM_CALLS             ( 20000U )
+#define mainCHECKSUM_RUNS              ( 5U )
+
+/* The largest number of connections of the select benchmark that receive
+ * data. */
+#define mainSELECT_ACTIVE              ( 4U )
+
+/* How long each measurement runs. */
+#define mainMEASURE_TIME_NS            ( 1000000000ULL )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that runs the benchmarks.
+ */
+static void prvBenchmarkTask( void * pvParameters );
+
+/*
+ * The benchmarks described at the top of this file.
+ */
+static void prvTCPLookupBenchmark( void );
+static void prvRxBurstBenchmark( void );
+static void prvBulkSendBenchmark( void );
+static void prvChecksumBenchmark( void );
+static void prvSelectBenchmark( void );
+
+/*
+ * One measurement of the bulk send benchmark, with a network interface that
+ * reports the ipNETWORK_CAPABILITY_... bits uxCapabilities.
+ */
+static void prvBulkSendMeasure( const char * pcName,
+                                UBaseType_t uxCapabilities );
+
+/*
+ * The checksum of RFC 1071, summed one byte at a time, in the form returned by
+ * usGenerateChecksum().
+ */
+static uint16_t prvReferenceChecksum( uint16_t usSum,
+                                      const uint8_t * pucData,
+                                      size_t uxLength );
+
+/*
+ * The fastest of mainCHECKSUM_RUNS measurements of the time of one call of
+ * usGenerateChecksum() for uxLength bytes, in tenths of a nanosecond.
+ */
+static uint64_t prvChecksumTime( const uint8_t * pucData,
+                                 size_t uxLength );
+
+/*
+ * Create a socket that listens on usLocalPort.
+ */
+static Socket_t prvListen( uint16_t usLocalPort,
+                           BaseType_t xBacklog );
+
+/*
+ * Open a connection from usPeerPort to a listening socket, and accept it.
+ * pucAckFrame receives the ACK that completed the connection, which is also a
+ * pure ACK that the connection can receive again.  When usPeerMSS is not zero,
+ * the SYN announces it as the peer's MSS.  Returns NULL on failure.
+ */
+static Socket_t prvOpenConnection( Socket_t xListenSocket,
+                                   uint16_t usLocalPort,
+                                   uint16_t usPeerPort,
+                                   uint16_t usPeerMSS,
+                                   uint8_t * pucAckFrame );
+
+/*
+ * Build a TCP segment from the peer, with uxDataLength bytes of data and its IP
+ * and TCP checksums.  When usMSS is not zero, the segment has an MSS option.
+ * Returns the length of the frame.
+ */
+static size_t prvBuildTCPFrame( uint8_t * pucFrame,
+                                uint16_t usLocalPort,
+                                uint16_t usPeerPort,
+                                uint8_t ucTCPFlags,
+                                uint32_t ulSequenceNumber,
+                                uint32_t ulAckNr,
+                                uint16_t usMSS,
+                                size_t uxDataLength );
+
+/*
+ * Pass a frame to the IP task and wait for it to be processed.
+ */
+static BaseType_t prvSendFrame( const uint8_t * pucFrame );
+
+/*
+ * Wait until the IP task has released every network buffer that was passed to
+ * it.  Returns pdFAIL if that did not happen within one second.
+ */
+static BaseType_t prvWaitForBuffers( UBaseType_t uxFreeBuffers );
+
+static uint64_t prvGetTimeNs( void );
+
+/*
+ * The run time counter of the IP task, or of xTask, in nanoseconds on this
+ * port.  A NULL xTask is the calling task.
+ */
+static configRUN_TIME_COUNTER_TYPE prvGetIPTaskRunTime( void );
+static configRUN_TIME_COUNTER_TYPE prvGetTaskRunTime( TaskHandle_t xTask );
+
+/*-----------------------------------------------------------*/
+
+/* The addresses of the device, passed to FreeRTOS_IPInit(). */
+static const uint8_t ucIPAddress[ 4 ] = { configIP_ADDR0, configIP_ADDR1, configIP_ADDR2, configIP_ADDR3 };
+static const uint8_t ucNetMask[ 4 ] = { configNET_MASK0, configNET_MASK1, configNET_MASK2, configNET_MASK3 };
+static const uint8_t ucGatewayAddress[ 4 ] = { configGATEWAY_ADDR0, configGATEWAY_ADDR1, configGATEWAY_ADDR2, configGATEWAY_ADDR3 };
+static const uint8_t ucDNSServerAddress[ 4 ] = { configDNS_SERVER_ADDR0, configDNS_SERVER_ADDR1, configDNS_SERVER_ADDR2, configDNS_SERVER_ADDR3 };
+static const uint8_t ucMACAddress[ 6 ] = { configMAC_ADDR0, configMAC_ADDR1, configMAC_ADDR2, configMAC_ADDR3, configMAC_ADDR4, configMAC_ADDR5 };
+
+/* The peer, on another subnet than the device. */
+static const uint8_t ucPeerMACAddress[ 6 ] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+static const uint8_t ucPeerIPAddress[ 4 ] = { 10, 0, 0, 2 };
+
+/* The connections opened by the lookup benchmark, the pure ACK of each, and
+ * the sequence number of the next data the peer sends on each. */
+static Socket_t xLookupConnections[ mainLOOKUP_MAX_CONNECTIONS ];
+static uint8_t ucLookupFrames[ mainLOOKUP_MAX_CONNECTIONS ][ mainTCP_FRAME_LENGTH ];
+static uint32_t ulLookupSequenceNumbers[ mainLOOKUP_MAX_CONNECTIONS ];
+static UBaseType_t uxLookupConnections = 0U;
+
+/* The connections of the bulk send benchmark, and the amount of data given to
+ * each, which the peer acknowledges. */
+static Socket_t xBulkConnections[ mainBULK_CONNECTIONS ];
+static uint32_t ulBulkQueued[ mainBULK_CONNECTIONS ];
+
+/* Used by the pseudo random number generator. */
+static UBaseType_t uxNextRand = 1U;
+
+/*-----------------------------------------------------------*/
+
+void main_benchmark( void )
+{
+    /* The benchmark task is created in vApplicationIPNetworkEventHook(). */
+    ( void ) FreeRTOS_IPInit( ucIPAddress,
+                              ucNetMask,
+                              ucGatewayAddress,
+                              ucDNSServerAddress,
+                              ucMACAddress );
+
+    /* Start the benchmark task running.  vTaskStartScheduler() returns when
+     * the benchmark task ends the scheduler. */
+    vTaskStartScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIPNetworkEventHook( eIPCallbackEvent_t eNetworkEvent )
+{
+    static BaseType_t xTaskAlreadyCreated = pdFALSE;
+
+    if( ( eNetworkEvent == eNetworkUp ) && ( xTaskAlreadyCreated == pdFALSE ) )
+    {
+        xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE, NULL, mainBENCHMARK_TASK_PRIORITY, NULL );
+        xTaskAlreadyCreated = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    prvTCPLookupBenchmark();
+    prvRxBurstBenchmark();
+    prvBulkSendBenchmark();
+    prvChecksumBenchmark();
+    prvSelectBenchmark();
+
+    console_print( "Benchmarks complete\n" );
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTCPLookupBenchmark( void )
+{
+    static const UBaseType_t uxConnectionCounts[] = { 1U, 16U, 64U, 256U, mainLOOKUP_MAX_CONNECTIONS };
+    static NetworkBufferDescriptor_t * pxBatch[ mainBATCH_SIZE ];
+    Socket_t xListenSocket;
+    UBaseType_t uxFreeBuffers, uxConnections = 0U, uxCount, uxIndex, uxNext = 0U;
+    uint64_t ullStart, ullElapsed = 0U, ullSegments;
+    configRUN_TIME_COUNTER_TYPE xIPTaskStart, xIPTaskTime;
+
+    console_print( "TCP lookup benchmark (ipconfigUSE_TCP_HASH_TABLE = %d)\n", ( int ) ipconfigUSE_TCP_HASH_TABLE );
+
+    xListenSocket = prvListen( mainBENCHMARK_PORT, mainLOOKUP_MAX_CONNECTIONS );
+
+    uxFreeBuffers = uxGetNumberOfFreeNetworkBuffers();
+
+    for( uxCount = 0U; uxCount < ( sizeof( uxConnectionCounts ) / sizeof( uxConnectionCounts[ 0 ] ) ); uxCount++ )
+    {
+        /* Open the connections that the previous measurement did not. */
+        while( uxConnections < uxConnectionCounts[ uxCount ] )
+        {
+            xLookupConnections[ uxConnections ] = prvOpenConnection( xListenSocket,
+                                                                     mainBENCHMARK_PORT,
+                                                                     ( uint16_t ) ( mainPEER_FIRST_PORT + uxConnections ),
+                                                                     0U,
+                                                                     ucLookupFrames[ uxConnections ] );
+
+            if( xLookupConnections[ uxConnections ] == NULL )
+            {
+                break;
+            }
+
+            ulLookupSequenceNumbers[ uxConnections ] = mainPEER_ISN + 1U;
+            uxConnections++;
+            uxLookupConnections = uxConnections;
+        }
+
+        if( uxConnections < uxConnectionCounts[ uxCount ] )
+        {
+            console_print( "Could not open connection %u\n", ( unsigned ) uxConnections + 1U );
+            break;
+        }
+
+        ullSegments = 0U;
+        ullStart = prvGetTimeNs();
+        xIPTaskStart = prvGetIPTaskRunTime();
+
+        do
+        {
+            for( uxIndex = 0U; uxIndex < mainBATCH_SIZE; uxIndex++ )
+            {
+                pxBatch[ uxIndex ] = pxBenchmarkNetworkFrame( ucLookupFrames[ uxNext ], mainTCP_FRAME_LENGTH );
+                configASSERT( pxBatch[ uxIndex ] != NULL );
+
+                uxNext = ( uxNext + 1U ) % uxConnections;
+            }
+
+            vTaskSuspendAll();
+            {
+                for( uxIndex = 0U; uxIndex < mainBATCH_SIZE; uxIndex++ )
+                {
+                    ( void ) xBenchmarkNetworkReceive( pxBatch[ uxIndex ] );
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( prvWaitForBuffers( uxFreeBuffers ) == pdFAIL )
+            {
+                console_print( "The IP task did not release its buffers\n" );
+                return;
+            }
+
+            ullSegments += mainBATCH_SIZE;
+            ullElapsed = prvGetTimeNs() - ullStart;
+        } while( ullElapsed < mainMEASURE_TIME_NS );
+
+        xIPTaskTime = prvGetIPTaskRunTime() - xIPTaskStart;
+
+        console_print( "  %3u connections: %8llu segments per second, %5llu ns of IP task time per segment\n",
+                       ( unsigned ) uxConnections,
+                       ( unsigned long long ) ( ( ullSegments * 1000000000ULL ) / ullElapsed ),
+                       ( unsigned long long ) ( xIPTaskTime / ullSegments ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRxBurstBenchmark( void )
+{
+    static NetworkBufferDescriptor_t * pxBatch[ mainBATCH_SIZE ];
+    static Socket_t xConnections[ mainBURST_CONNECTIONS ];
+    static uint32_t ulPeerSequenceNumbers[ mainBURST_CONNECTIONS ];
+    uint8_t ucFrame[ mainTCP_DATA_FRAME_LENGTH ];
+    uint8_t ucData[ mainBURST_SEGMENT_SIZE * 4U ];
+    Socket_t xListenSocket;
+    UBaseType_t uxFreeBuffers, uxIndex, uxConnection;
+    BaseType_t xReceived;
+    size_t uxLength;
+    uint64_t ullStart, ullElapsed = 0U, ullSegments = 0U, ullBytesReceived = 0U;
+    uint32_t ulFramesSent;
+    configRUN_TIME_COUNTER_TYPE xIPTaskStart, xIPTaskTime;
+
+    console_print( "TCP receive burst benchmark (ipconfigIP_RX_BURST_LENGTH = %u)\n", ( unsigned ) ipconfigIP_RX_BURST_LENGTH );
+
+    xListenSocket = prvListen( mainBURST_PORT, mainBURST_CONNECTIONS );
+
+    for( uxConnection = 0U; uxConnection < mainBURST_CONNECTIONS; uxConnection++ )
+    {
+        xConnections[ uxConnection ] = prvOpenConnection( xListenSocket,
+                                                          mainBURST_PORT,
+                                                          ( uint16_t ) ( mainBURST_PEER_FIRST_PORT + uxConnection ),
+                                                          0U,
+                                                          ucFrame );
+
+        if( xConnections[ uxConnection ] == NULL )
+        {
+            console_print( "Could not open connection %u\n", ( unsigned ) uxConnection + 1U );
+            return;
+        }
+
+        ulPeerSequenceNumbers[ uxConnection ] = mainPEER_ISN + 1U;
+    }
+
+    uxFreeBuffers = uxGetNumberOfFreeNetworkBuffers();
+    ulFramesSent = ulBenchmarkNetworkFramesSent();
+    ullStart = prvGetTimeNs();
+    xIPTaskStart = prvGetIPTaskRunTime();
+
+    do
+    {
+        for( uxIndex = 0U; uxIndex < mainBATCH_SIZE; uxIndex++ )
+        {
+            uxConnection = uxIndex % mainBURST_CONNECTIONS;
+
+            uxLength = prvBuildTCPFrame( ucFrame,
+                                         mainBURST_PORT,
+                                         ( uint16_t ) ( mainBURST_PEER_FIRST_PORT + uxConnection ),
+                                         tcpTCP_FLAG_ACK | tcpTCP_FLAG_PSH,
+                                         ulPeerSequenceNumbers[ uxConnection ],
+                                         mainSERVER_ISN + 1U,
+                                         0U,
+                                         mainBURST_SEGMENT_SIZE );
+            ulPeerSequenceNumbers[ uxConnection ] += mainBURST_SEGMENT_SIZE;
+
+            pxBatch[ uxIndex ] = pxBenchmarkNetworkFrame( ucFrame, uxLength );
+            configASSERT( pxBatch[ uxIndex ] != NULL );
+        }
+
+        vTaskSuspendAll();
+        {
+            for( uxIndex = 0U; uxIndex < mainBATCH_SIZE; uxIndex++ )
+            {
+                ( void ) xBenchmarkNetworkReceive( pxBatch[ uxIndex ] );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( prvWaitForBuffers( uxFreeBuffers ) == pdFAIL )
+        {
+            console_print( "The IP task did not release its buffers\n" );
+            return;
+        }
+
+        /* Make room for the next batch. */
+        for( uxConnection = 0U; uxConnection < mainBURST_CONNECTIONS; uxConnection++ )
+        {
+            do
+            {
+                xReceived = FreeRTOS_recv( xConnections[ uxConnection ], ucData, sizeof( ucData ), FREERTOS_MSG_DONTWAIT );
+
+                if( xReceived > 0 )
+                {
+                    ullBytesReceived += ( uint64_t ) xReceived;
+                }
+            } while( xReceived > 0 );
+        }
+
+        ullSegments += mainBATCH_SIZE;
+        ullElapsed = prvGetTimeNs() - ullStart;
+    } while( ullElapsed < mainMEASURE_TIME_NS );
+
+    xIPTaskTime = prvGetIPTaskRunTime() - xIPTaskStart;
+    ulFramesSent = ulBenchmarkNetworkFramesSent() - ulFramesSent;
+
+    console_print( "  %8llu segments per second, %5llu ns of IP task time per segment, %3llu frames sent per 100 segments\n",
+                   ( unsigned long long ) ( ( ullSegments * 1000000000ULL ) / ullElapsed ),
+                   ( unsigned long long ) ( xIPTaskTime / ullSegments ),
+                   ( unsigned long long ) ( ( ( uint64_t ) ulFramesSent * 100U ) / ullSegments ) );
+
+    if( ullBytesReceived != ( ullSegments * mainBURST_SEGMENT_SIZE ) )
+    {
+        console_print( "  Received %llu of %llu bytes\n",
+                       ( unsigned long long ) ullBytesReceived,
+                       ( unsigned long long ) ( ullSegments * mainBURST_SEGMENT_SIZE ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBulkSendBenchmark( void )
+{
+    uint8_t ucFrame[ mainTCP_FRAME_LENGTH ];
+    WinProperties_t xWinProperties;
+    Socket_t xListenSocket;
+    UBaseType_t uxConnection;
+
+    console_print( "TCP bulk send benchmark (ipconfigUSE_TCP_SEGMENTATION_OFFLOAD = %d)\n", ( int ) ipconfigUSE_TCP_SEGMENTATION_OFFLOAD );
+
+    xListenSocket = prvListen( mainBULK_PORT, mainBULK_CONNECTIONS );
+
+    /* Room for a round of full-sized segments, and a transmit window that
+     * does not hold them back.  The connections inherit the properties of the
+     * listening socket. */
+    memset( &xWinProperties, 0, sizeof( xWinProperties ) );
+    xWinProperties.lTxBufSize = ( int32_t ) ( ( mainBULK_SEGMENTS + 2U ) * ipconfigTCP_MSS );
+    xWinProperties.lTxWinSize = ( int32_t ) ( mainBULK_SEGMENTS + 2U );
+    xWinProperties.lRxBufSize = ipconfigTCP_RX_BUFFER_LENGTH;
+    xWinProperties.lRxWinSize = 1;
+    ( void ) FreeRTOS_setsockopt( xListenSocket, 0, FREERTOS_SO_WIN_PROPERTIES, &xWinProperties, sizeof( xWinProperties ) );
+
+    for( uxConnection = 0U; uxConnection < mainBULK_CONNECTIONS; uxConnection++ )
+    {
+        xBulkConnections[ uxConnection ] = prvOpenConnection( xListenSocket,
+                                                              mainBULK_PORT,
+                                                              ( uint16_t ) ( mainBULK_PEER_FIRST_PORT + uxConnection ),
+                                                              mainBULK_PEER_MSS,
+                                                              ucFrame );
+
+        if( xBulkConnections[ uxConnection ] == NULL )
+        {
+            console_print( "Could not open connection %u\n", ( unsigned ) uxConnection + 1U );
+            return;
+        }
+    }
+
+    #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+        {
+            prvBulkSendMeasure( "segmented by the IP task", 0U );
+            prvBulkSendMeasure( "segmented by the interface", ipNETWORK_CAPABILITY_TCP_SEGMENTATION );
+        }
+    #else
+        {
+            prvBulkSendMeasure( "one segment per frame", 0U );
+        }
+    #endif
+
+    #if ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 )
+        {
+            prvBulkSendMeasure( "checksums by the interface", ipNETWORK_CAPABILITY_TX_CHECKSUM | ipNETWORK_CAPABILITY_RX_CHECKSUM );
+        }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvBulkSendMeasure( const char * pcName,
+                                UBaseType_t uxCapabilities )
+{
+    static uint8_t ucData[ mainBULK_SEGMENTS * ipconfigTCP_MSS ];
+    static uint8_t ucAckFrames[ mainBULK_CONNECTIONS ][ mainTCP_FRAME_LENGTH ];
+    static NetworkBufferDescriptor_t * pxBatch[ mainBULK_CONNECTIONS ];
+    UBaseType_t uxFreeBuffers, uxConnection;
+    BaseType_t xLength;
+    TickType_t xTimeOut;
+    uint64_t ullStart, ullElapsed = 0U, ullBytes = 0U;
+    uint32_t ulDataSent, ulQueued;
+    configRUN_TIME_COUNTER_TYPE xIPTaskStart, xIPTaskTime;
+
+    vBenchmarkNetworkSetCapabilities( uxCapabilities );
+
+    uxFreeBuffers = uxGetNumberOfFreeNetworkBuffers();
+    ullStart = prvGetTimeNs();
+    xIPTaskStart = prvGetIPTaskRunTime();
+
+    do
+    {
+        ulDataSent = ulBenchmarkNetworkTCPDataSent();
+        ulQueued = 0U;
+
+        /* Give every connection as many full-sized segments as fit, while the
+         * scheduler is suspended, so the IP task sends them all in one go. */
+        vTaskSuspendAll();
+        {
+            for( uxConnection = 0U; uxConnection < mainBULK_CONNECTIONS; uxConnection++ )
+            {
+                xLength = FreeRTOS_tx_space( xBulkConnections[ uxConnection ] );
+                xLength = ( BaseType_t ) FreeRTOS_min_int32( ( int32_t ) xLength, ( int32_t ) sizeof( ucData ) );
+                xLength -= xLength % FreeRTOS_mss( xBulkConnections[ uxConnection ] );
+
+                if( xLength > 0 )
+                {
+                    ( void ) FreeRTOS_send( xBulkConnections[ uxConnection ], ucData, ( size_t ) xLength, FREERTOS_MSG_DONTWAIT );
+                    ulBulkQueued[ uxConnection ] += ( uint32_t ) xLength;
+                    ulQueued += ( uint32_t ) xLength;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        xTimeOut = pdMS_TO_TICKS( 1000U );
+
+        while( ( ulBenchmarkNetworkTCPDataSent() - ulDataSent ) < ulQueued )
+        {
+            if( xTimeOut == 0U )
+            {
+                console_print( "The IP task did not send the data\n" );
+                return;
+            }
+
+            vTaskDelay( 1U );
+            xTimeOut--;
+        }
+
+        /* Acknowledge all data sent. */
+        for( uxConnection = 0U; uxConnection < mainBULK_CONNECTIONS; uxConnection++ )
+        {
+            ( void ) prvBuildTCPFrame( ucAckFrames[ uxConnection ],
+                                       mainBULK_PORT,
+                                       ( uint16_t ) ( mainBULK_PEER_FIRST_PORT + uxConnection ),
+                                       tcpTCP_FLAG_ACK,
+                                       mainPEER_ISN + 1U,
+                                       mainSERVER_ISN + 1U + ulBulkQueued[ uxConnection ],
+                                       0U,
+                                       0U );
+            pxBatch[ uxConnection ] = pxBenchmarkNetworkFrame( ucAckFrames[ uxConnection ], mainTCP_FRAME_LENGTH );
+            configASSERT( pxBatch[ uxConnection ] != NULL );
+        }
+
+        vTaskSuspendAll();
+        {
+            for( uxConnection = 0U; uxConnection < mainBULK_CONNECTIONS; uxConnection++ )
+            {
+                ( void ) xBenchmarkNetworkReceive( pxBatch[ uxConnection ] );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( prvWaitForBuffers( uxFreeBuffers ) == pdFAIL )
+        {
+            console_print( "The IP task did not release its buffers\n" );
+            return;
+        }
+
+        ullBytes += ( uint64_t ) ulQueued;
+        ullElapsed = prvGetTimeNs() - ullStart;
+    } while( ullElapsed < mainMEASURE_TIME_NS );
+
+    xIPTaskTime = prvGetIPTaskRunTime() - xIPTaskStart;
+
+    console_print( "  %-28s %8llu KB per second, %5llu ns of IP task time per KB\n",
+                   pcName,
+                   ( unsigned long long ) ( ( ullBytes * 1000000000ULL ) / ( ullElapsed * 1024U ) ),
+                   ( unsigned long long ) ( ( xIPTaskTime * 1024U ) / ullBytes ) );
+
+    vBenchmarkNetworkSetCapabilities( 0U );
+}
+/*-----------------------------------------------------------*/
+
+static void prvChecksumBenchmark( void )
+{
+    static const size_t uxSizes[] = { ipSIZE_OF_IPv4_HEADER, 64U, 576U, mainCHECKSUM_MAX_SIZE };
+    /* Room to start at any alignment. */
+    static uint64_t ullData[ ( mainCHECKSUM_MAX_SIZE / sizeof( uint64_t ) ) + 2U ];
+    uint8_t * pucData = ( uint8_t * ) ullData;
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) ullData;
+    volatile uint16_t usResult = 0U;
+    uint16_t usSum, usOldTTL;
+    size_t uxLength, uxOffset, uxSize;
+    UBaseType_t uxMismatches = 0U, uxCall;
+    uint64_t ullStart, ullElapsed, ullUpdate = UINT64_MAX, ullRecalculate = UINT64_MAX;
+    uint64_t ullAligned, ullOdd;
+    UBaseType_t uxRun;
+
+    console_print( "Checksum benchmark (ipconfigUSE_64BIT_CHECKSUM = %d)\n", ( int ) ipconfigUSE_64BIT_CHECKSUM );
+
+    for( uxLength = 0U; uxLength < sizeof( ullData ); uxLength++ )
+    {
+        pucData[ uxLength ] = ( uint8_t ) uxRand();
+    }
+
+    for( uxLength = 0U; uxLength <= mainCHECKSUM_MAX_SIZE; uxLength++ )
+    {
+        for( uxOffset = 0U; uxOffset < sizeof( uint64_t ); uxOffset++ )
+        {
+            usSum = ( uint16_t ) uxRand();
+
+            if( usGenerateChecksum( usSum, &( pucData[ uxOffset ] ), uxLength ) != prvReferenceChecksum( usSum, &( pucData[ uxOffset ] ), uxLength ) )
+            {
+                uxMismatches++;
+            }
+        }
+    }
+
+    if( uxMismatches != 0U )
+    {
+        console_print( "  usGenerateChecksum() differs from RFC 1071 in %u cases\n", ( unsigned ) uxMismatches );
+    }
+
+    for( uxSize = 0U; uxSize < ( sizeof( uxSizes ) / sizeof( uxSizes[ 0 ] ) ); uxSize++ )
+    {
+        ullAligned = prvChecksumTime( pucData, uxSizes[ uxSize ] );
+        ullOdd = prvChecksumTime( &( pucData[ 1 ] ), uxSizes[ uxSize ] );
+
+        console_print( "  %4u bytes: %5llu.%llu ns aligned, %5llu.%llu ns at an odd address\n",
+                       ( unsigned ) uxSizes[ uxSize ],
+                       ( unsigned long long ) ( ullAligned / 10U ),
+                       ( unsigned long long ) ( ullAligned % 10U ),
+                       ( unsigned long long ) ( ullOdd / 10U ),
+                       ( unsigned long long ) ( ullOdd % 10U ) );
+    }
+
+    /* A valid IP header, of which the TTL is decremented as by a router. */
+    pxIPHeader->ucVersionHeaderLength = mainIPV4_VERSION_HEADER_LENGTH;
+    pxIPHeader->usHeaderChecksum = 0U;
+    pxIPHeader->usHeaderChecksum = ~FreeRTOS_htons( usGenerateChecksum( 0U, ( uint8_t * ) pxIPHeader, ipSIZE_OF_IPv4_HEADER ) );
+    usOldTTL = *( ( uint16_t * ) &( pxIPHeader->ucTimeToLive ) );
+    pxIPHeader->ucTimeToLive--;
+    usSum = usChecksumUpdate( pxIPHeader->usHeaderChecksum, usOldTTL, *( ( uint16_t * ) &( pxIPHeader->ucTimeToLive ) ) );
+    pxIPHeader->usHeaderChecksum = 0U;
+
+    if( usSum != ( uint16_t ) ~FreeRTOS_htons( usGenerateChecksum( 0U, ( uint8_t * ) pxIPHeader, ipSIZE_OF_IPv4_HEADER ) ) )
+    {
+        console_print( "  usChecksumUpdate() differs from a new checksum\n" );
+    }
+
+    for( uxRun = 0U; uxRun < mainCHECKSUM_RUNS; uxRun++ )
+    {
+        ullStart = prvGetTimeNs();
+
+        for( uxCall = 0U; uxCall < mainCHECKSUM_CALLS; uxCall++ )
+        {
+            usResult = usChecksumUpdate( usResult, usOldTTL, ( uint16_t ) uxCall );
+        }
+
+        ullElapsed = prvGetTimeNs() - ullStart;
+
+        if( ullElapsed < ullUpdate )
+        {
+            ullUpdate = ullElapsed;
+        }
+
+        ullStart = prvGetTimeNs();
+
+        for( uxCall = 0U; uxCall < mainCHECKSUM_CALLS; uxCall++ )
+        {
+            pxIPHeader->usHeaderChecksum = 0U;
+            usResult = ~FreeRTOS_htons( usGenerateChecksum( 0U, ( uint8_t * ) pxIPHeader, ipSIZE_OF_IPv4_HEADER ) );
+        }
+
+        ullElapsed = prvGetTimeNs() - ullStart;
+
+        if( ullElapsed < ullRecalculate )
+        {
+            ullRecalculate = ullElapsed;
+        }
+    }
+
+    /* In tenths of a nanosecond per call. */
+    ullUpdate = ( ullUpdate * 10U ) / mainCHECKSUM_CALLS;
+    ullRecalculate = ( ullRecalculate * 10U ) / mainCHECKSUM_CALLS;
+
+    console_print( "  IP header after a TTL change: %llu.%llu ns to update the checksum, %llu.%llu ns to sum the header again\n",
+                   ( unsigned long long ) ( ullUpdate / 10U ),
+                   ( unsigned long long ) ( ullUpdate % 10U ),
+                   ( unsigned long long ) ( ullRecalculate / 10U ),
+                   ( unsigned long long ) ( ullRecalculate % 10U ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSelectBenchmark( void )
+{
+    static const UBaseType_t uxSetSizes[] = { 1U, 16U, 64U, 256U, mainLOOKUP_MAX_CONNECTIONS };
+    uint8_t ucFrame[ mainTCP_DATA_FRAME_LENGTH ];
+    uint8_t ucData[ mainBURST_SEGMENT_SIZE ];
+    Socket_t xReadySockets[ mainSELECT_ACTIVE ];
+    SocketSet_t xSocketSet;
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    UBaseType_t uxFreeBuffers, uxSize, uxSetSize, uxActive, uxIndex, uxConnection, uxNext = 0U;
+    BaseType_t xReady, xReceived;
+    size_t uxLength;
+    uint64_t ullStart, ullElapsed, ullEvents, ullBytesReceived;
+    configRUN_TIME_COUNTER_TYPE xIPTaskStart, xIPTaskTime, xTaskStart, xTaskTime;
+
+    console_print( "Select benchmark (ipconfigUSE_SOCKET_READY_LIST = %d)\n", ( int ) ipconfigUSE_SOCKET_READY_LIST );
+
+    uxFreeBuffers = uxGetNumberOfFreeNetworkBuffers();
+
+    for( uxSize = 0U; uxSize < ( sizeof( uxSetSizes ) / sizeof( uxSetSizes[ 0 ] ) ); uxSize++ )
+    {
+        uxSetSize = uxSetSizes[ uxSize ];
+
+        if( uxSetSize > uxLookupConnections )
+        {
+            break;
+        }
+
+        uxActive = ( uxSetSize < mainSELECT_ACTIVE ) ? uxSetSize : mainSELECT_ACTIVE;
+
+        xSocketSet = FreeRTOS_CreateSocketSet();
+        configASSERT( xSocketSet != NULL );
+
+        for( uxConnection = 0U; uxConnection < uxSetSize; uxConnection++ )
+        {
+            FreeRTOS_FD_SET( xLookupConnections[ uxConnection ], xSocketSet, eSELECT_READ );
+        }
+
+        ullEvents = 0U;
+        ullBytesReceived = 0U;
+        ullStart = prvGetTimeNs();
+        xIPTaskStart = prvGetIPTaskRunTime();
+        xTaskStart = prvGetTaskRunTime( NULL );
+
+        do
+        {
+            /* Spread the active connections over the set. */
+            uxConnection = ( uxNext * uxSetSize ) / uxActive;
+            uxNext = ( uxNext + 1U ) % uxActive;
+
+            uxLength = prvBuildTCPFrame( ucFrame,
+                                         mainBENCHMARK_PORT,
+                                         ( uint16_t ) ( mainPEER_FIRST_PORT + uxConnection ),
+                                         tcpTCP_FLAG_ACK | tcpTCP_FLAG_PSH,
+                                         ulLookupSequenceNumbers[ uxConnection ],
+                                         mainSERVER_ISN + 1U,
+                                         0U,
+                                         mainBURST_SEGMENT_SIZE );
+            ulLookupSequenceNumbers[ uxConnection ] += mainBURST_SEGMENT_SIZE;
+
+            pxNetworkBuffer = pxBenchmarkNetworkFrame( ucFrame, uxLength );
+            configASSERT( pxNetworkBuffer != NULL );
+            ( void ) xBenchmarkNetworkReceive( pxNetworkBuffer );
+
+            if( prvWaitForBuffers( uxFreeBuffers ) == pdFAIL )
+            {
+                console_print( "The IP task did not release its buffers\n" );
+                return;
+            }
+
+            #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+                {
+                    xReady = FreeRTOS_select_ready( xSocketSet, xReadySockets, mainSELECT_ACTIVE, 0U );
+                }
+            #else
+                {
+                    xReady = 0;
+
+                    if( FreeRTOS_select( xSocketSet, 0U ) != 0 )
+                    {
+                        for( uxIndex = 0U; uxIndex < uxSetSize; uxIndex++ )
+                        {
+                            if( ( FreeRTOS_FD_ISSET( xLookupConnections[ uxIndex ], xSocketSet ) != 0U ) && ( xReady < ( BaseType_t ) mainSELECT_ACTIVE ) )
+                            {
+                                xReadySockets[ xReady ] = xLookupConnections[ uxIndex ];
+                                xReady++;
+                            }
+                        }
+                    }
+                }
+            #endif /* if ( ipconfigUSE_SOCKET_READY_LIST == 1 ) */
+
+            for( uxIndex = 0U; uxIndex < ( UBaseType_t ) xReady; uxIndex++ )
+            {
+                xReceived = FreeRTOS_recv( xReadySockets[ uxIndex ], ucData, sizeof( ucData ), FREERTOS_MSG_DONTWAIT );
+
+                if( xReceived > 0 )
+                {
+                    ullBytesReceived += ( uint64_t ) xReceived;
+                }
+            }
+
+            ullEvents++;
+            ullElapsed = prvGetTimeNs() - ullStart;
+        } while( ullElapsed < mainMEASURE_TIME_NS );
+
+        xIPTaskTime = prvGetIPTaskRunTime() - xIPTaskStart;
+        xTaskTime = prvGetTaskRunTime( NULL ) - xTaskStart;
+
+        console_print( "  %3u sockets in the set: %7llu events per second, %6llu ns of task time and %6llu ns of IP task time per event\n",
+                       ( unsigned ) uxSetSize,
+                       ( unsigned long long ) ( ( ullEvents * 1000000000ULL ) / ullElapsed ),
+                       ( unsigned long long ) ( xTaskTime / ullEvents ),
+                       ( unsigned long long ) ( xIPTaskTime / ullEvents ) );
+
+        if( ullBytesReceived != ( ullEvents * mainBURST_SEGMENT_SIZE ) )
+        {
+            console_print( "  Received %llu of %llu bytes\n",
+                           ( unsigned long long ) ullBytesReceived,
+                           ( unsigned long long ) ( ullEvents * mainBURST_SEGMENT_SIZE ) );
+        }
+
+        for( uxConnection = 0U; uxConnection < uxSetSize; uxConnection++ )
+        {
+            FreeRTOS_FD_CLR( xLookupConnections[ uxConnection ], xSocketSet, eSELECT_ALL );
+        }
+
+        FreeRTOS_DeleteSocketSet( xSocketSet );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint16_t prvReferenceChecksum( uint16_t usSum,
+                                      const uint8_t * pucData,
+                                      size_t uxLength )
+{
+    uint32_t ulSum = usSum;
+    size_t uxIndex;
+
+    for( uxIndex = 0U; ( uxIndex + 1U ) < uxLength; uxIndex += 2U )
+    {
+        ulSum += ( ( uint32_t ) pucData[ uxIndex ] << 8 ) | pucData[ uxIndex + 1U ];
+    }
+
+    if( ( uxLength & 1U ) != 0U )
+    {
+        ulSum += ( uint32_t ) pucData[ uxLength - 1U ] << 8;
+    }
+
+    while( ( ulSum >> 16 ) != 0U )
+    {
+        ulSum = ( ulSum & 0xffffU ) + ( ulSum >> 16 );
+    }
+
+    return ( uint16_t ) ulSum;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvChecksumTime( const uint8_t * pucData,
+                                 size_t uxLength )
+{
+    volatile uint16_t usResult;
+    uint64_t ullStart, ullElapsed, ullFastest = UINT64_MAX;
+    UBaseType_t uxRun, uxCall;
+
+    for( uxRun = 0U; uxRun < mainCHECKSUM_RUNS; uxRun++ )
+    {
+        ullStart = prvGetTimeNs();
+
+        for( uxCall = 0U; uxCall < mainCHECKSUM_CALLS; uxCall++ )
+        {
+            usResult = usGenerateChecksum( ( uint16_t ) uxCall, pucData, uxLength );
+        }
+
+        ullElapsed = prvGetTimeNs() - ullStart;
+
+        if( ullElapsed < ullFastest )
+        {
+            ullFastest = ullElapsed;
+        }
+    }
+
+    ( void ) usResult;
+
+    return ( ullFastest * 10U ) / mainCHECKSUM_CALLS;
+}
+/*-----------------------------------------------------------*/
+
+static Socket_t prvListen( uint16_t usLocalPort,
+                           BaseType_t xBacklog )
+{
+    struct freertos_sockaddr xAddress;
+    Socket_t xListenSocket;
+    TickType_t xNoBlock = 0U;
+
+    xListenSocket = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+    configASSERT( xListenSocket != FREERTOS_INVALID_SOCKET );
+
+    /* FreeRTOS_accept() should not block: every connection is complete by the
+     * time it is called. */
+    ( void ) FreeRTOS_setsockopt( xListenSocket, 0, FREERTOS_SO_RCVTIMEO, &xNoBlock, sizeof( xNoBlock ) );
+
+    memset( &xAddress, 0, sizeof( xAddress ) );
+    xAddress.sin_port = FreeRTOS_htons( usLocalPort );
+    ( void ) FreeRTOS_bind( xListenSocket, &xAddress, sizeof( xAddress ) );
+    ( void ) FreeRTOS_listen( xListenSocket, xBacklog );
+
+    return xListenSocket;
+}
+/*-----------------------------------------------------------*/
+
+static Socket_t prvOpenConnection( Socket_t xListenSocket,
+                                   uint16_t usLocalPort,
+                                   uint16_t usPeerPort,
+                                   uint16_t usPeerMSS,
+                                   uint8_t * pucAckFrame )
+{
+    uint8_t ucSynFrame[ mainTCP_FRAME_LENGTH ];
+    Socket_t xClientSocket = NULL;
+
+    ( void ) prvBuildTCPFrame( ucSynFrame, usLocalPort, usPeerPort, tcpTCP_FLAG_SYN, mainPEER_ISN, 0U, usPeerMSS, 0U );
+    ( void ) prvBuildTCPFrame( pucAckFrame, usLocalPort, usPeerPort, tcpTCP_FLAG_ACK, mainPEER_ISN + 1U, mainSERVER_ISN + 1U, 0U, 0U );
+
+    if( ( prvSendFrame( ucSynFrame ) == pdPASS ) && ( prvSendFrame( pucAckFrame ) == pdPASS ) )
+    {
+        xClientSocket = FreeRTOS_accept( xListenSocket, NULL, NULL );
+    }
+
+    return xClientSocket;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBuildTCPFrame( uint8_t * pucFrame,
+                                uint16_t usLocalPort,
+                                uint16_t usPeerPort,
+                                uint8_t ucTCPFlags,
+                                uint32_t ulSequenceNumber,
+                                uint32_t ulAckNr,
+                                uint16_t usMSS,
+                                size_t uxDataLength )
+{
+    TCPPacket_t * pxTCPPacket = ( TCPPacket_t * ) pucFrame;
+    IPHeader_t * pxIPHeader = &( pxTCPPacket->xIPHeader );
+    TCPHeader_t * pxTCPHeader = &( pxTCPPacket->xTCPHeader );
+    size_t uxOptionsLength = ( usMSS != 0U ) ? tcpTCP_OPT_MSS_LEN : 0U;
+    size_t uxLength = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + uxOptionsLength + uxDataLength;
+
+    if( uxLength < mainTCP_FRAME_LENGTH )
+    {
+        uxLength = mainTCP_FRAME_LENGTH;
+    }
+
+    /* The data is all zeros. */
+    memset( pucFrame, 0, uxLength );
+
+    memcpy( pxTCPPacket->xEthernetHeader.xDestinationAddress.ucBytes, ucMACAddress, sizeof( ucMACAddress ) );
+    memcpy( pxTCPPacket->xEthernetHeader.xSourceAddress.ucBytes, ucPeerMACAddress, sizeof( ucPeerMACAddress ) );
+    pxTCPPacket->xEthernetHeader.usFrameType = ipIPv4_FRAME_TYPE;
+
+    pxIPHeader->ucVersionHeaderLength = mainIPV4_VERSION_HEADER_LENGTH;
+    pxIPHeader->usLength = FreeRTOS_htons( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + uxOptionsLength + uxDataLength );
+    pxIPHeader->ucTimeToLive = 64U;
+    pxIPHeader->ucProtocol = ( uint8_t ) ipPROTOCOL_TCP;
+    pxIPHeader->ulSourceIPAddress = FreeRTOS_inet_addr_quick( ucPeerIPAddress[ 0 ], ucPeerIPAddress[ 1 ], ucPeerIPAddress[ 2 ], ucPeerIPAddress[ 3 ] );
+    pxIPHeader->ulDestinationIPAddress = FreeRTOS_inet_addr_quick( ucIPAddress[ 0 ], ucIPAddress[ 1 ], ucIPAddress[ 2 ], ucIPAddress[ 3 ] );
+
+    pxTCPHeader->usSourcePort = FreeRTOS_htons( usPeerPort );
+    pxTCPHeader->usDestinationPort = FreeRTOS_htons( usLocalPort );
+    pxTCPHeader->ulSequenceNumber = FreeRTOS_htonl( ulSequenceNumber );
+    pxTCPHeader->ulAckNr = FreeRTOS_htonl( ulAckNr );
+    pxTCPHeader->ucTCPOffset = ( uint8_t ) ( ( ( ipSIZE_OF_TCP_HEADER + uxOptionsLength ) / 4U ) << 4 );
+    pxTCPHeader->ucTCPFlags = ucTCPFlags;
+    pxTCPHeader->usWindow = FreeRTOS_htons( 8192U );
+
+    if( usMSS != 0U )
+    {
+        pxTCPHeader->ucOptdata[ 0 ] = tcpTCP_OPT_MSS;
+        pxTCPHeader->ucOptdata[ 1 ] = tcpTCP_OPT_MSS_LEN;
+        pxTCPHeader->ucOptdata[ 2 ] = ( uint8_t ) ( usMSS >> 8 );
+        pxTCPHeader->ucOptdata[ 3 ] = ( uint8_t ) ( usMSS & 0xffU );
+    }
+
+    pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER );
+    pxIPHeader->usHeaderChecksum = ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
+    ( void ) usGenerateProtocolChecksum( pucFrame, uxLength, pdTRUE );
+
+    return uxLength;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSendFrame( const uint8_t * pucFrame )
+{
+    UBaseType_t uxFreeBuffers = uxGetNumberOfFreeNetworkBuffers();
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    BaseType_t xReturn = pdFAIL;
+
+    pxNetworkBuffer = pxBenchmarkNetworkFrame( pucFrame, mainTCP_FRAME_LENGTH );
+
+    if( ( pxNetworkBuffer != NULL ) && ( xBenchmarkNetworkReceive( pxNetworkBuffer ) == pdPASS ) )
+    {
+        xReturn = prvWaitForBuffers( uxFreeBuffers );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWaitForBuffers( UBaseType_t uxFreeBuffers )
+{
+    TickType_t xTimeOut = pdMS_TO_TICKS( 1000U );
+
+    /* The IP task has the higher priority, so has normally processed every
+     * frame already. */
+    while( uxGetNumberOfFreeNetworkBuffers() < uxFreeBuffers )
+    {
+        if( xTimeOut == 0U )
+        {
+            return pdFAIL;
+        }
+
+        vTaskDelay( 1U );
+        xTimeOut--;
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeNs( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static configRUN_TIME_COUNTER_TYPE prvGetIPTaskRunTime( void )
+{
+    return prvGetTaskRunTime( FreeRTOS_GetIPTaskHandle() );
+}
+/*-----------------------------------------------------------*/
+
+static configRUN_TIME_COUNTER_TYPE prvGetTaskRunTime( TaskHandle_t xTask )
+{
+    TaskStatus_t xStatus;
+
+    vTaskGetInfo( xTask, &xStatus, pdFALSE, eInvalid );
+
+    return xStatus.ulRunTimeCounter;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRand( void )
+{
+    const uint32_t ulMultiplier = 0x015a4e35UL, ulIncrement = 1UL;
+
+    /* Utility function to generate a pseudo random number.  Always seeded with
+     * the same value, so every run of the benchmarks is the same. */
+
+    uxNextRand = ( ulMultiplier * uxNextRand ) + ulIncrement;
+    return( ( int ) ( uxNextRand >> 16UL ) & 0x7fffUL );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xApplicationGetRandomNumber( uint32_t * pulNumber )
+{
+    *( pulNumber ) = uxRand();
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Every connection starts with the same sequence number, so the benchmarks can
+ * build the frames of a connection before opening it.  NOT FOR USE IN
+ * PRODUCTION SYSTEMS.
+ */
+uint32_t ulApplicationGetNextSequenceNumber( uint32_t ulSourceAddress,
+                                             uint16_t usSourcePort,
+                                             uint32_t ulDestinationAddress,
+                                             uint16_t usDestinationPort )
+{
+    ( void ) ulSourceAddress;
+    ( void ) usSourcePort;
+    ( void ) ulDestinationAddress;
+    ( void ) usDestinationPort;
+
+    return mainSERVER_ISN;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_LLMNR != 0 ) || ( ipconfigUSE_NBNS != 0 ) || ( ipconfigDHCP_REGISTER_HOSTNAME == 1 )
+
+    const char * pcApplicationHostnameHook( void )
+    {
+        return "RTOSBench";
+    }
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_LLMNR != 0 ) || ( ipconfigUSE_NBNS != 0 )
+
+    BaseType_t xApplicationDNSQueryHook( const char * pcName )
+    {
+        /* No name lookups reach the benchmark. */
+        ( void ) pcName;
+
+        return pdFAIL;
+    }
+
+#endif
+/*-----------------------------------------------------------*/
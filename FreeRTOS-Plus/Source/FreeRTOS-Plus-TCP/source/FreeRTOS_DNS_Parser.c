@@ -42,6 +42,7 @@
 #include "FreeRTOS_DNS_Callback.h"
 
 #include "NetworkBufferManagement.h"
+#include "NetworkInterface.h"
 
 #include <string.h>
 
@@ -772,6 +773,9 @@
             uxDataLength = ( ( size_t ) lNetLength ) + ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER + ipSIZE_OF_ETH_HEADER;
 
             #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+                #if ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 )
+                    if( ( uxNetworkInterfaceGetCapabilities() & ipNETWORK_CAPABILITY_TX_CHECKSUM ) == 0U )
+                #endif
                 {
                     /* Calculate the IP header checksum. */
                     pxIPHeader->usHeaderChecksum = 0U;
@@ -57,8 +57,7 @@
  * Turns around an incoming ping request to convert it into a ping reply.
  */
 #if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 )
-    static eFrameProcessingResult_t prvProcessICMPEchoRequest( ICMPPacket_t * const pxICMPPacket,
-                                                               const NetworkBufferDescriptor_t * const pxNetworkBuffer );
+    static eFrameProcessingResult_t prvProcessICMPEchoRequest( ICMPPacket_t * const pxICMPPacket );
 #endif /* ipconfigREPLY_TO_INCOMING_PINGS */
 
 /*
@@ -102,7 +101,7 @@
                 case ipICMP_ECHO_REQUEST:
                     #if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 )
                         {
-                            eReturn = prvProcessICMPEchoRequest( pxICMPPacket, pxNetworkBuffer );
+                            eReturn = prvProcessICMPEchoRequest( pxICMPPacket );
                         }
                     #endif /* ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) */
                     break;
@@ -134,8 +133,7 @@
  *
  * @param[in,out] pxICMPPacket: The IP packet that contains the ICMP message.
  */
-    static eFrameProcessingResult_t prvProcessICMPEchoRequest( ICMPPacket_t * const pxICMPPacket,
-                                                               const NetworkBufferDescriptor_t * const pxNetworkBuffer )
+    static eFrameProcessingResult_t prvProcessICMPEchoRequest( ICMPPacket_t * const pxICMPPacket )
     {
         ICMPHeader_t * pxICMPHeader;
         IPHeader_t * pxIPHeader;
@@ -166,14 +164,26 @@
         #endif
 
         #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+            #if ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 )
+                if( ( uxNetworkInterfaceGetCapabilities() & ipNETWORK_CAPABILITY_TX_CHECKSUM ) != 0U )
+                {
+                    /* The network interface sets the checksums. */
+                    pxICMPHeader->usChecksum = 0U;
+                }
+                else
+            #endif
             {
                 /* calculate the IP header checksum, in case the driver won't do that. */
                 pxIPHeader->usHeaderChecksum = 0x00U;
                 pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER );
                 pxIPHeader->usHeaderChecksum = ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
 
-                /* calculate the ICMP checksum for an outgoing packet. */
-                ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxICMPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+                /* Only the message type differs from the request, whose
+                 * checksum has been verified, so update the ICMP checksum
+                 * rather than summing the whole message again. */
+                pxICMPHeader->usChecksum = usChecksumUpdate( pxICMPHeader->usChecksum,
+                                                             FreeRTOS_htons( ( uint16_t ) ( ( ( uint16_t ) ipICMP_ECHO_REQUEST << 8 ) | pxICMPHeader->ucTypeOfService ) ),
+                                                             FreeRTOS_htons( ( uint16_t ) ( ( ( uint16_t ) ipICMP_ECHO_REPLY << 8 ) | pxICMPHeader->ucTypeOfService ) ) );
             }
         #else
             {
@@ -156,19 +156,34 @@ static eFrameProcessingResult_t prvProcessIPPacket( IPPacket_t * pxIPPacket,
  */
 static void prvHandleEthernetPacket( NetworkBufferDescriptor_t * pxBuffer );
 
+#if ( ipconfigIP_RX_BURST_LENGTH > 1 )
+
+/*
+ * Handle a received packet, followed by the received packets that are waiting
+ * behind it in the event queue, as one burst.
+ */
+    static void prvHandleEthernetBurst( NetworkBufferDescriptor_t * pxBuffer );
+#endif
+
 
 /* The function 'prvAllowIPPacket()' checks if a packets should be processed. */
 static eFrameProcessingResult_t prvAllowIPPacket( const IPPacket_t * const pxIPPacket,
                                                   const NetworkBufferDescriptor_t * const pxNetworkBuffer,
                                                   UBaseType_t uxHeaderLength );
 
-#if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 )
+#if ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 ) )
 
 /* Even when the driver takes care of checksum calculations,
  *  the IP-task will still check if the length fields are OK. */
     static BaseType_t xCheckSizeFields( const uint8_t * const pucEthernetBuffer,
                                         size_t uxBufferLength );
-#endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) */
+
+/* The checks of prvAllowIPPacket() that remain when the checksums of a
+ * received packet have been checked by the network interface. */
+    static eFrameProcessingResult_t prvAllowOffloadedChecksumPacket( const IPPacket_t * const pxIPPacket,
+                                                                     const NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                                     UBaseType_t uxHeaderLength );
+#endif /* ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 ) ) */
 /*-----------------------------------------------------------*/
 
 /** @brief The queue used to pass events into the IP-task for processing. */
@@ -328,7 +343,11 @@ static void prvProcessIPEventsAndTimers( void )
             /* The network hardware driver has received a new packet.  A
              * pointer to the received buffer is located in the pvData member
              * of the received event structure. */
-            prvHandleEthernetPacket( ( NetworkBufferDescriptor_t * ) xReceivedEvent.pvData );
+            #if ( ipconfigIP_RX_BURST_LENGTH > 1 )
+                prvHandleEthernetBurst( ( NetworkBufferDescriptor_t * ) xReceivedEvent.pvData );
+            #else
+                prvHandleEthernetPacket( ( NetworkBufferDescriptor_t * ) xReceivedEvent.pvData );
+            #endif
             break;
 
         case eNetworkTxEvent:
@@ -476,6 +495,18 @@ static void prvProcessIPEventsAndTimers( void )
                 {
                     SocketSelect_t * pxSocketSet = ( SocketSelect_t * ) ( xReceivedEvent.pvData );
 
+                    #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+                        {
+                            /* Sockets in the ready list must not refer to the set anymore. */
+                            while( listCURRENT_LIST_LENGTH( &( pxSocketSet->xReadyList ) ) > 0U )
+                            {
+                                pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocketSet->xReadyList ) ) );
+                                ( void ) uxListRemove( &( pxSocket->xSelectListItem ) );
+                                pxSocket->pxSocketSet = NULL;
+                            }
+                        }
+                    #endif /* ipconfigUSE_SOCKET_READY_LIST */
+
                     iptraceMEM_STATS_DELETE( pxSocketSet );
                     vEventGroupDelete( pxSocketSet->xSelectGroup );
                     vPortFree( ( void * ) pxSocketSet );
@@ -597,6 +628,62 @@ static void prvHandleEthernetPacket( NetworkBufferDescriptor_t * pxBuffer )
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigIP_RX_BURST_LENGTH > 1 )
+
+/**
+ * @brief Handle a received packet, and then the received packets that are
+ *        waiting behind it in the event queue, up to ipconfigIP_RX_BURST_LENGTH
+ *        messages in total.  The timers are not checked between the packets of
+ *        a burst, and TCP sockets send one acknowledgement after the last one.
+ *
+ * @param[in] pxBuffer: The network buffer descriptor(s) of the first message.
+ */
+    static void prvHandleEthernetBurst( NetworkBufferDescriptor_t * pxBuffer )
+    {
+        IPStackEvent_t xNextEvent;
+        UBaseType_t uxCount = 1U;
+        BaseType_t xHasNext = pdTRUE;
+
+        #if ( ipconfigUSE_TCP == 1 )
+            {
+                vTCPRxBurstStart();
+            }
+        #endif
+
+        prvHandleEthernetPacket( pxBuffer );
+
+        while( ( xHasNext != pdFALSE ) && ( uxCount < ( UBaseType_t ) ipconfigIP_RX_BURST_LENGTH ) )
+        {
+            /* Only the IP-task receives from the queue, and other tasks only
+             * send to its back, so the message peeked at is the message that
+             * will be received.  Any other kind of event ends the burst, and
+             * is handled in the next pass, so events keep their order. */
+            if( ( xQueuePeek( xNetworkEventQueue, ( void * ) &xNextEvent, 0U ) != pdFALSE ) &&
+                ( xNextEvent.eEventType == eNetworkRxEvent ) )
+            {
+                ( void ) xQueueReceive( xNetworkEventQueue, ( void * ) &xNextEvent, 0U );
+
+                iptraceNETWORK_EVENT_RECEIVED( xNextEvent.eEventType );
+
+                prvHandleEthernetPacket( ( NetworkBufferDescriptor_t * ) xNextEvent.pvData );
+                uxCount++;
+            }
+            else
+            {
+                xHasNext = pdFALSE;
+            }
+        }
+
+        #if ( ipconfigUSE_TCP == 1 )
+            {
+                vTCPRxBurstEnd();
+            }
+        #endif
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* ipconfigIP_RX_BURST_LENGTH > 1 */
+
 /**
  * @brief Send a network down event to the IP-task. If it fails to post a message,
  *         the failure will be noted in the variable 'xNetworkDownEventPending'
@@ -1504,6 +1591,14 @@ static eFrameProcessingResult_t prvAllowIPPacket( const IPPacket_t * const pxIPP
                  * https://en.wikipedia.org/wiki/IPv4_header_checksum#Verifying_the_IPv4_header_checksum
                  * and this RFC: https://tools.ietf.org/html/rfc1624#page-4
                  */
+                #if ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 )
+                    if( ( uxNetworkInterfaceGetCapabilities() & ipNETWORK_CAPABILITY_RX_CHECKSUM ) != 0U )
+                    {
+                        /* The network interface has checked the checksums. */
+                        eReturn = prvAllowOffloadedChecksumPacket( pxIPPacket, pxNetworkBuffer, uxHeaderLength );
+                    }
+                    else
+                #endif
                 if( usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ( size_t ) uxHeaderLength ) != ipCORRECT_CRC )
                 {
                     /* Check sum in IP-header not correct. */
@@ -1525,65 +1620,93 @@ static eFrameProcessingResult_t prvAllowIPPacket( const IPPacket_t * const pxIPP
         {
             if( eReturn == eProcessBuffer )
             {
-                if( xCheckSizeFields( ( uint8_t * ) ( pxNetworkBuffer->pucEthernetBuffer ), pxNetworkBuffer->xDataLength ) != pdPASS )
-                {
-                    /* Some of the length checks were not successful. */
-                    eReturn = eReleaseBuffer;
-                }
+                eReturn = prvAllowOffloadedChecksumPacket( pxIPPacket, pxNetworkBuffer, uxHeaderLength );
             }
+        }
+    #endif /* ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 */
+
+    return eReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 ) )
 
-            #if ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 )
+/**
+ * @brief Check a received IP packet whose checksums have already been checked by
+ *        the network interface: only the length fields are checked, and UDP packets
+ *        without a checksum are dropped unless ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS
+ *        is set.
+ *
+ * @param[in] pxIPPacket: The IP packet under consideration.
+ * @param[in] pxNetworkBuffer: The whole network buffer.
+ * @param[in] uxHeaderLength: The length of the header.
+ *
+ * @return Whether the packet should be processed or dropped.
+ */
+    static eFrameProcessingResult_t prvAllowOffloadedChecksumPacket( const IPPacket_t * const pxIPPacket,
+                                                                     const NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                                     UBaseType_t uxHeaderLength )
+    {
+        eFrameProcessingResult_t eReturn = eProcessBuffer;
+
+        if( xCheckSizeFields( ( uint8_t * ) ( pxNetworkBuffer->pucEthernetBuffer ), pxNetworkBuffer->xDataLength ) != pdPASS )
+        {
+            /* Some of the length checks were not successful. */
+            eReturn = eReleaseBuffer;
+        }
+
+        #if ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 )
+            {
+                /* Check if this is a UDP packet without a checksum. */
+                if( eReturn == eProcessBuffer )
                 {
-                    /* Check if this is a UDP packet without a checksum. */
-                    if( eReturn == eProcessBuffer )
+                    /* ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS is defined as 0,
+                     * and so UDP packets carrying a protocol checksum of 0, will
+                     * be dropped. */
+
+                    /* Identify the next protocol. */
+                    if( pxIPPacket->xIPHeader.ucProtocol == ( uint8_t ) ipPROTOCOL_UDP )
                     {
-                        /* ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS is defined as 0,
-                         * and so UDP packets carrying a protocol checksum of 0, will
-                         * be dropped. */
+                        const ProtocolPacket_t * pxProtPack;
 
-                        /* Identify the next protocol. */
-                        if( pxIPPacket->xIPHeader.ucProtocol == ( uint8_t ) ipPROTOCOL_UDP )
-                        {
-                            const ProtocolPacket_t * pxProtPack;
+                        /* pxProtPack will point to the offset were the protocols begin. */
 
-                            /* pxProtPack will point to the offset were the protocols begin. */
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        pxProtPack = ( ( ProtocolPacket_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ uxHeaderLength - ipSIZE_OF_IPv4_HEADER ] ) );
 
-                            /* MISRA Ref 11.3.1 [Misaligned access] */
-                            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-                            /* coverity[misra_c_2012_rule_11_3_violation] */
-                            pxProtPack = ( ( ProtocolPacket_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ uxHeaderLength - ipSIZE_OF_IPv4_HEADER ] ) );
+                        if( pxProtPack->xUDPPacket.xUDPHeader.usChecksum == ( uint16_t ) 0U )
+                        {
+                            #if ( ipconfigHAS_PRINTF != 0 )
+                                {
+                                    static BaseType_t xCount = 0;
 
-                            if( pxProtPack->xUDPPacket.xUDPHeader.usChecksum == ( uint16_t ) 0U )
-                            {
-                                #if ( ipconfigHAS_PRINTF != 0 )
+                                    /* Exclude this from branch coverage as this is only used for debugging. */
+                                    if( xCount < 5 ) /* LCOV_EXCL_BR_LINE */
                                     {
-                                        static BaseType_t xCount = 0;
-
-                                        /* Exclude this from branch coverage as this is only used for debugging. */
-                                        if( xCount < 5 ) /* LCOV_EXCL_BR_LINE */
-                                        {
-                                            FreeRTOS_printf( ( "prvAllowIPPacket: UDP packet from %xip without CRC dropped\n",
-                                                               FreeRTOS_ntohl( pxIPPacket->xIPHeader.ulSourceIPAddress ) ) );
-                                            xCount++;
-                                        }
+                                        FreeRTOS_printf( ( "prvAllowIPPacket: UDP packet from %xip without CRC dropped\n",
+                                                           FreeRTOS_ntohl( pxIPPacket->xIPHeader.ulSourceIPAddress ) ) );
+                                        xCount++;
                                     }
-                                #endif /* ( ipconfigHAS_PRINTF != 0 ) */
+                                }
+                            #endif /* ( ipconfigHAS_PRINTF != 0 ) */
 
-                                /* Protocol checksum not accepted. */
-                                eReturn = eReleaseBuffer;
-                            }
+                            /* Protocol checksum not accepted. */
+                            eReturn = eReleaseBuffer;
                         }
                     }
                 }
-            #endif /* ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 ) */
+            }
+        #endif /* ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 ) */
 
-            /* to avoid warning unused parameters */
-            ( void ) uxHeaderLength;
-        }
-    #endif /* ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 */
+        /* to avoid warning unused parameters */
+        ( void ) pxIPPacket;
+        ( void ) uxHeaderLength;
 
-    return eReturn;
-}
+        return eReturn;
+    }
+#endif /* ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 ) ) */
 /*-----------------------------------------------------------*/
 
 /**
@@ -1811,7 +1934,7 @@ static eFrameProcessingResult_t prvProcessIPPacket( IPPacket_t * pxIPPacket,
 
 /*-----------------------------------------------------------*/
 
-#if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 )
+#if ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 ) )
 
 /**
  * @brief Although the driver will take care of checksum calculations, the IP-task
@@ -1940,7 +2063,7 @@ static eFrameProcessingResult_t prvProcessIPPacket( IPPacket_t * pxIPPacket,
 
         return xResult;
     }
-#endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) */
+#endif /* ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) || ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 ) ) */
 /*-----------------------------------------------------------*/
 
 /* This function is used in other files, has external linkage e.g. in
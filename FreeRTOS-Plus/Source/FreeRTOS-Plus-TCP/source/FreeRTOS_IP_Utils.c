@@ -804,6 +804,12 @@ uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
  * counting up instead of overflowing after 16 bits. That is why the actual checksum calculations look like:
  *   union.u32 = ( uint32_t ) union.u16[ 0 ] + union.u16[ 1 ];
  *
+ * When ipconfigUSE_64BIT_CHECKSUM is enabled, the fast loop adds 8 32-bit words at a time
+ * into two 64-bit sums instead, which cannot overflow for any packet size, so no 'carries'
+ * need to be counted inside the loop.  The two sums are folded back to 16 bits at the end.
+ * On targets with 64-bit registers this is about twice as fast for full-sized packets, and
+ * compilers can vectorise the loop.
+ *
  * Arguments:
  *   ulSum: This argument provides a value to initialise the progressive summation
  *   of the header's values to. It is often 0, but protocols like TCP or UDP
@@ -830,12 +836,10 @@ uint16_t usGenerateChecksum( uint16_t usSum,
 {
 /* MISRA/PC-lint doesn't like the use of unions. Here, they are a great
  * aid though to optimise the calculations. */
-    xUnion32 xSum2;
     xUnion32 xSum;
     xUnion32 xTerm;
     xUnionPtr xSource;
     uintptr_t uxAlignBits;
-    uint32_t ulCarry = 0U;
     uint16_t usTemp;
     size_t uxDataLengthBytes = uxByteCount;
     size_t uxSize;
@@ -885,65 +889,107 @@ uint16_t usGenerateChecksum( uint16_t usSum,
         /* Now xSource is word (32-bit) aligned. */
     }
 
-    /* Word (32-bit) aligned, do the most part. */
+    #if ( ipconfigUSE_64BIT_CHECKSUM != 0 )
+        {
+            /* Word (32-bit) aligned, do the most part.  In this loop, eight
+             * words are added to two 64-bit sums.  The carries collect in
+             * the upper 32 bits, so there is no need to test for them after
+             * each addition. */
+            uint64_t ullSum = ( uint64_t ) xSum.u32;
+            uint64_t ullSum2 = 0U;
 
-    uxSize = ( size_t ) ( ( uxDataLengthBytes / 4U ) * 4U );
+            uxSize = uxDataLengthBytes / sizeof( uint32_t );
 
-    if( uxSize >= ( 3U * sizeof( uint32_t ) ) )
-    {
-        uxSize -= ( 3U * sizeof( uint32_t ) );
-    }
-    else
-    {
-        uxSize = 0U;
-    }
+            for( ulX = 0U; ( ulX + 8U ) <= uxSize; ulX += 8U )
+            {
+                ullSum += ( uint64_t ) xSource.u32ptr[ ulX ] + xSource.u32ptr[ ulX + 1U ];
+                ullSum2 += ( uint64_t ) xSource.u32ptr[ ulX + 2U ] + xSource.u32ptr[ ulX + 3U ];
+                ullSum += ( uint64_t ) xSource.u32ptr[ ulX + 4U ] + xSource.u32ptr[ ulX + 5U ];
+                ullSum2 += ( uint64_t ) xSource.u32ptr[ ulX + 6U ] + xSource.u32ptr[ ulX + 7U ];
+            }
 
-    /* In this loop, four 32-bit additions will be done, in total 16 bytes.
-     * Indexing with constants (0,1,2,3) gives faster code than using
-     * post-increments. */
-    for( ulX = 0U; ulX < uxSize; ulX += 4U * sizeof( uint32_t ) )
-    {
-        /* Use a secondary Sum2, just to see if the addition produced an
-         * overflow. */
-        xSum2.u32 = xSum.u32 + xSource.u32ptr[ 0 ];
+            for( ; ulX < uxSize; ulX++ )
+            {
+                ullSum += xSource.u32ptr[ ulX ];
+            }
 
-        if( xSum2.u32 < xSum.u32 )
-        {
-            ulCarry++;
-        }
+            xSource.u32ptr = &( xSource.u32ptr[ uxSize ] );
 
-        /* Now add the secondary sum to the major sum, and remember if there was
-         * a carry. */
-        xSum.u32 = xSum2.u32 + xSource.u32ptr[ 1 ];
+            /* Fold the sum to 32 bits, then add all carries. */
+            ullSum += ullSum2;
+            ullSum = ( ullSum & 0xffffffffU ) + ( ullSum >> 32 );
+            ullSum = ( ullSum & 0xffffffffU ) + ( ullSum >> 32 );
+            xSum.u32 = ( uint32_t ) ullSum;
+            xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ];
 
-        if( xSum2.u32 > xSum.u32 )
-        {
-            ulCarry++;
+            uxDataLengthBytes %= 4U;
         }
+    #else /* if ( ipconfigUSE_64BIT_CHECKSUM != 0 ) */
+        {
+            xUnion32 xSum2;
+            uint32_t ulCarry = 0U;
 
-        /* And do the same trick once again for indexes 2 and 3 */
-        xSum2.u32 = xSum.u32 + xSource.u32ptr[ 2 ];
+            /* Word (32-bit) aligned, do the most part. */
 
-        if( xSum2.u32 < xSum.u32 )
-        {
-            ulCarry++;
-        }
+            uxSize = ( size_t ) ( ( uxDataLengthBytes / 4U ) * 4U );
 
-        xSum.u32 = xSum2.u32 + xSource.u32ptr[ 3 ];
+            if( uxSize >= ( 3U * sizeof( uint32_t ) ) )
+            {
+                uxSize -= ( 3U * sizeof( uint32_t ) );
+            }
+            else
+            {
+                uxSize = 0U;
+            }
 
-        if( xSum2.u32 > xSum.u32 )
-        {
-            ulCarry++;
-        }
+            /* In this loop, four 32-bit additions will be done, in total 16 bytes.
+             * Indexing with constants (0,1,2,3) gives faster code than using
+             * post-increments. */
+            for( ulX = 0U; ulX < uxSize; ulX += 4U * sizeof( uint32_t ) )
+            {
+                /* Use a secondary Sum2, just to see if the addition produced an
+                 * overflow. */
+                xSum2.u32 = xSum.u32 + xSource.u32ptr[ 0 ];
 
-        /* And finally advance the pointer 4 * 4 = 16 bytes. */
-        xSource.u32ptr = &( xSource.u32ptr[ 4 ] );
-    }
+                if( xSum2.u32 < xSum.u32 )
+                {
+                    ulCarry++;
+                }
+
+                /* Now add the secondary sum to the major sum, and remember if there was
+                 * a carry. */
+                xSum.u32 = xSum2.u32 + xSource.u32ptr[ 1 ];
+
+                if( xSum2.u32 > xSum.u32 )
+                {
+                    ulCarry++;
+                }
+
+                /* And do the same trick once again for indexes 2 and 3 */
+                xSum2.u32 = xSum.u32 + xSource.u32ptr[ 2 ];
+
+                if( xSum2.u32 < xSum.u32 )
+                {
+                    ulCarry++;
+                }
+
+                xSum.u32 = xSum2.u32 + xSource.u32ptr[ 3 ];
+
+                if( xSum2.u32 > xSum.u32 )
+                {
+                    ulCarry++;
+                }
+
+                /* And finally advance the pointer 4 * 4 = 16 bytes. */
+                xSource.u32ptr = &( xSource.u32ptr[ 4 ] );
+            }
 
-    /* Now add all carries. */
-    xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ] + ulCarry;
+            /* Now add all carries. */
+            xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ] + ulCarry;
 
-    uxDataLengthBytes %= 16U;
+            uxDataLengthBytes %= 16U;
+        }
+    #endif /* if ( ipconfigUSE_64BIT_CHECKSUM != 0 ) */
 
     /* Half-word aligned. */
     uxSize = ( ( uxDataLengthBytes & ~( ( size_t ) 1U ) ) );
@@ -993,6 +1039,38 @@ uint16_t usGenerateChecksum( uint16_t usSum,
 }
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Update an internet checksum after a 16-bit word in the data that it
+ *        covers has been changed, without summing the data again.  This is
+ *        equation 3 of RFC 1624: HC' = ~( ~HC + ~m + m' ).
+ *
+ * @param[in] usChecksum: The checksum as found in the packet.
+ * @param[in] usOldValue: The old value of the word that was changed.
+ * @param[in] usNewValue: The new value of the word.
+ *
+ * @return The checksum to store in the packet.
+ *
+ * The one's complement sum does not depend on the byte order, so the
+ * parameters may be either all in network byte order, as read from the packet,
+ * or all in host byte order.  A changed 32-bit field is handled by calling this
+ * function once for each half.
+ */
+uint16_t usChecksumUpdate( uint16_t usChecksum,
+                           uint16_t usOldValue,
+                           uint16_t usNewValue )
+{
+    uint32_t ulSum;
+
+    ulSum = ( uint32_t ) ( ( uint16_t ) ~usChecksum ) + ( uint32_t ) ( ( uint16_t ) ~usOldValue ) + ( uint32_t ) usNewValue;
+
+    /* Add the carries, twice, as the first addition may produce a new one. */
+    ulSum = ( ulSum & 0xffffU ) + ( ulSum >> 16 );
+    ulSum = ( ulSum & 0xffffU ) + ( ulSum >> 16 );
+
+    return ( uint16_t ) ~( ( uint16_t ) ulSum );
+}
+/*-----------------------------------------------------------*/
+
 #if ( ipconfigHAS_PRINTF != 0 )
 
     #ifndef ipMONITOR_MAX_HEAP
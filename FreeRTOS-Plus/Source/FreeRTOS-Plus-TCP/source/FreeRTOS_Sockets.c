@@ -96,6 +96,23 @@
 #define sock80_PERCENT            80U  /**< 80% of the defined limit. */
 #define sock100_PERCENT           100U /**< 100% of the defined limit. */
 
+/** @brief Multiplier used to spread keys over the TCP hash tables (2^32 divided
+ *         by the golden ratio). */
+#define socketHASH_MULTIPLIER     0x9E3779B1U
+
+/** @brief The number of bits in an index of a TCP hash table, which is the base 2
+ *         logarithm of ipconfigTCP_HASH_TABLE_SIZE, a power of 2. */
+#define socketHASH_BITS                                                                    \
+    ( ( ( ( ( uint32_t ) ipconfigTCP_HASH_TABLE_SIZE & 0xAAAAAAAAU ) != 0U ) ? 1U : 0U ) + \
+      ( ( ( ( uint32_t ) ipconfigTCP_HASH_TABLE_SIZE & 0xCCCCCCCCU ) != 0U ) ? 2U : 0U ) + \
+      ( ( ( ( uint32_t ) ipconfigTCP_HASH_TABLE_SIZE & 0xF0F0F0F0U ) != 0U ) ? 4U : 0U ) + \
+      ( ( ( ( uint32_t ) ipconfigTCP_HASH_TABLE_SIZE & 0xFF00FF00U ) != 0U ) ? 8U : 0U ) + \
+      ( ( ( ( uint32_t ) ipconfigTCP_HASH_TABLE_SIZE & 0xFFFF0000U ) != 0U ) ? 16U : 0U ) )
+
+/** @brief Shifts the top socketHASH_BITS bits of a hash down to an index of a
+ *         TCP hash table. */
+#define socketHASH_SHIFT          ( 32U - socketHASH_BITS )
+
 /** @brief When ucASCIIToHex() can not convert a character,
  *         the value 255 will be returned.
  */
@@ -196,7 +213,49 @@ static uint8_t ucASCIIToHex( char cChar );
 /* Executed by the IP-task, it will check all sockets belonging to a set */
     static void prvFindSelectedSocket( SocketSelect_t * pxSocketSet );
 
+/* Find out which of the select events of a socket have actually occurred. */
+    static EventBits_t prvSocketSelectBits( FreeRTOS_Socket_t * pxSocket );
+
 #endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
+
+#if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+
+/* Take a socket from the ready list of its socket set, if it is in there. */
+    static void prvSocketSelectRemoveReady( FreeRTOS_Socket_t * pxSocket );
+
+/* Add a socket to a set, move it to another set, or remove it from its set. */
+    static void prvSocketSelectSetSocketSet( FreeRTOS_Socket_t * pxSocket,
+                                             SocketSelect_t * pxSocketSet );
+
+/* Copy the ready sockets of a socket set to an array of the application. */
+    static BaseType_t prvSocketSelectCollect( SocketSelect_t * pxSocketSet,
+                                              Socket_t * pxReadySockets,
+                                              BaseType_t xMaxSockets );
+
+#endif /* ipconfigUSE_SOCKET_READY_LIST == 1 */
+
+#if ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_HASH_TABLE == 1 )
+
+/*
+ * Translate a local port, or a local port plus a remote IP address and port,
+ * into an index in one of the TCP hash tables.
+ */
+    static UBaseType_t prvTCPPortHash( UBaseType_t uxLocalPort );
+
+    static UBaseType_t prvTCPConnectionHash( UBaseType_t uxLocalPort,
+                                             uint32_t ulRemoteIP,
+                                             UBaseType_t uxRemotePort );
+
+/*
+ * Add a TCP socket to a hash bucket, or remove it from the bucket that it is
+ * stored in.
+ */
+    static void prvTCPHashInsert( FreeRTOS_Socket_t ** ppxBucket,
+                                  FreeRTOS_Socket_t * pxSocket );
+
+    static void prvTCPHashRemove( FreeRTOS_Socket_t * pxSocket );
+
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_HASH_TABLE == 1 ) */
 /*-----------------------------------------------------------*/
 
 /** @brief The list that contains mappings between sockets and port numbers.
@@ -215,6 +274,20 @@ List_t xBoundUDPSocketsList;
 
 #endif /* ipconfigUSE_TCP == 1 */
 
+#if ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_HASH_TABLE == 1 )
+
+/** @brief Sockets that were created by a listening socket, hashed on their local
+ *         port, remote IP address and remote port.  Only accessed by the IP-task.
+ */
+    static FreeRTOS_Socket_t * pxTCPConnectionTable[ ipconfigTCP_HASH_TABLE_SIZE ];
+
+/** @brief All other bound TCP sockets, hashed on their local port.  Only
+ *         accessed by the IP-task.
+ */
+    static FreeRTOS_Socket_t * pxTCPPortTable[ ipconfigTCP_HASH_TABLE_SIZE ];
+
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_HASH_TABLE == 1 ) */
+
 /*-----------------------------------------------------------*/
 
 /**
@@ -271,6 +344,13 @@ void vNetworkSocketsInit( void )
             vListInitialise( &xBoundTCPSocketsList );
         }
     #endif /* ipconfigUSE_TCP == 1 */
+
+    #if ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_HASH_TABLE == 1 )
+        {
+            ( void ) memset( pxTCPConnectionTable, 0, sizeof( pxTCPConnectionTable ) );
+            ( void ) memset( pxTCPPortTable, 0, sizeof( pxTCPPortTable ) );
+        }
+    #endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_HASH_TABLE == 1 ) */
 }
 /*-----------------------------------------------------------*/
 
@@ -472,6 +552,13 @@ Socket_t FreeRTOS_socket( BaseType_t xDomain,
                 vListInitialiseItem( &( pxSocket->xBoundSocketListItem ) );
                 listSET_LIST_ITEM_OWNER( &( pxSocket->xBoundSocketListItem ), ( void * ) pxSocket );
 
+                #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+                    {
+                        vListInitialiseItem( &( pxSocket->xSelectListItem ) );
+                        listSET_LIST_ITEM_OWNER( &( pxSocket->xSelectListItem ), ( void * ) pxSocket );
+                    }
+                #endif /* ipconfigUSE_SOCKET_READY_LIST */
+
                 pxSocket->xReceiveBlockTime = ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME;
                 pxSocket->xSendBlockTime = ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME;
                 pxSocket->ucSocketOptions = ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT;
@@ -535,6 +622,12 @@ Socket_t FreeRTOS_socket( BaseType_t xDomain,
             ( void ) memset( pxSocketSet, 0, sizeof( *pxSocketSet ) );
             pxSocketSet->xSelectGroup = xEventGroupCreate();
 
+            #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+                {
+                    vListInitialise( &( pxSocketSet->xReadyList ) );
+                }
+            #endif /* ipconfigUSE_SOCKET_READY_LIST */
+
             if( pxSocketSet->xSelectGroup == NULL )
             {
                 vPortFree( pxSocketSet );
@@ -604,8 +697,18 @@ Socket_t FreeRTOS_socket( BaseType_t xDomain,
 
         if( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_ALL ) ) != ( EventBits_t ) 0U )
         {
-            /* Adding a socket to a socket set. */
-            pxSocket->pxSocketSet = ( SocketSelect_t * ) xSocketSet;
+            #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+                {
+                    /* Adding a socket to a socket set.  The socket may be ready
+                     * already: have vSocketSelect() look at it. */
+                    prvSocketSelectSetSocketSet( pxSocket, pxSocketSet );
+                }
+            #else
+                {
+                    /* Adding a socket to a socket set. */
+                    pxSocket->pxSocketSet = ( SocketSelect_t * ) xSocketSet;
+                }
+            #endif /* ipconfigUSE_SOCKET_READY_LIST */
 
             /* Now have the IP-task call vSocketSelect() to see if the set contains
              * any sockets which are 'ready' and set the proper bits. */
@@ -639,15 +742,31 @@ Socket_t FreeRTOS_socket( BaseType_t xDomain,
 
         pxSocket->xSelectBits &= ~( xBitsToClear & ( ( EventBits_t ) eSELECT_ALL ) );
 
-        if( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_ALL ) ) != ( EventBits_t ) 0U )
-        {
-            pxSocket->pxSocketSet = ( SocketSelect_t * ) xSocketSet;
-        }
-        else
-        {
-            /* disconnect it from the socket set */
-            pxSocket->pxSocketSet = NULL;
-        }
+        #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+            {
+                if( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_ALL ) ) != ( EventBits_t ) 0U )
+                {
+                    prvSocketSelectSetSocketSet( pxSocket, ( SocketSelect_t * ) xSocketSet );
+                }
+                else
+                {
+                    /* disconnect it from the socket set */
+                    prvSocketSelectSetSocketSet( pxSocket, NULL );
+                }
+            }
+        #else
+            {
+                if( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_ALL ) ) != ( EventBits_t ) 0U )
+                {
+                    pxSocket->pxSocketSet = ( SocketSelect_t * ) xSocketSet;
+                }
+                else
+                {
+                    /* disconnect it from the socket set */
+                    pxSocket->pxSocketSet = NULL;
+                }
+            }
+        #endif /* ipconfigUSE_SOCKET_READY_LIST */
     }
 
 
@@ -823,6 +942,253 @@ Socket_t FreeRTOS_socket( BaseType_t xDomain,
 #endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+
+/**
+ * @brief Wait until at least one socket of a socket set is ready, and return
+ *        the ready sockets.  Only the sockets in the ready list of the set are
+ *        examined, the other members of the set are never looked at.
+ *        FreeRTOS_FD_ISSET() tells which events occurred on a returned socket.
+ *
+ * @param[in] xSocketSet: The socket set including the sockets on which we are
+ *                        waiting for an event to occur.
+ * @param[out] pxReadySockets: An array that will receive the ready sockets.
+ * @param[in] xMaxSockets: The number of elements in 'pxReadySockets'.
+ * @param[in] xBlockTimeTicks: Maximum time ticks to wait for an event to occur.
+ *                   If the value is 'portMAX_DELAY' then the function will wait
+ *                   indefinitely for an event to occur.
+ *
+ * @return The number of sockets stored in 'pxReadySockets', zero when the
+ *         time-out was reached, or -pdFREERTOS_ERRNO_EINTR when the set was
+ *         signalled.
+ */
+    BaseType_t FreeRTOS_select_ready( SocketSet_t xSocketSet,
+                                      Socket_t * pxReadySockets,
+                                      BaseType_t xMaxSockets,
+                                      TickType_t xBlockTimeTicks )
+    {
+        TimeOut_t xTimeOut;
+        TickType_t xRemainingTime;
+        SocketSelect_t * pxSocketSet = ( SocketSelect_t * ) xSocketSet;
+        EventBits_t uxResult;
+        BaseType_t xReturn;
+
+        configASSERT( xSocketSet != NULL );
+        configASSERT( pxReadySockets != NULL );
+        configASSERT( xMaxSockets > 0 );
+
+        /* Only in the first round, check for non-blocking */
+        xRemainingTime = xBlockTimeTicks;
+
+        /* Fetch the current time */
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            uxResult = xEventGroupWaitBits( pxSocketSet->xSelectGroup, ( ( EventBits_t ) eSELECT_ALL ), pdFALSE, pdFALSE, xRemainingTime );
+
+            #if ( ipconfigSUPPORT_SIGNALS != 0 )
+                {
+                    if( ( uxResult & ( ( EventBits_t ) eSELECT_INTR ) ) != 0U )
+                    {
+                        ( void ) xEventGroupClearBits( pxSocketSet->xSelectGroup, ( EventBits_t ) eSELECT_INTR );
+                        FreeRTOS_debug_printf( ( "FreeRTOS_select_ready: interrupted\n" ) );
+                        xReturn = -pdFREERTOS_ERRNO_EINTR;
+                        break;
+                    }
+                }
+            #else
+                {
+                    ( void ) uxResult;
+                }
+            #endif /* ipconfigSUPPORT_SIGNALS */
+
+            /* Have the IP-task check the sockets in the ready list. */
+            prvFindSelectedSocket( pxSocketSet );
+
+            xReturn = prvSocketSelectCollect( pxSocketSet, pxReadySockets, xMaxSockets );
+
+            if( xReturn != 0 )
+            {
+                break;
+            }
+
+            /* Has the timeout been reached? */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
+            {
+                break;
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* ipconfigUSE_SOCKET_READY_LIST == 1 */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+
+/**
+ * @brief Copy the sockets from the ready list of a socket set that have at
+ *        least one select event.  The sockets that are returned are moved to
+ *        the end of the list, so when more sockets are ready than fit in the
+ *        array, the next call will start with the ones that were left out.
+ *
+ * @param[in] pxSocketSet: The socket set.
+ * @param[out] pxReadySockets: An array that will receive the ready sockets.
+ * @param[in] xMaxSockets: The number of elements in 'pxReadySockets'.
+ *
+ * @return The number of sockets stored in 'pxReadySockets'.
+ */
+    static BaseType_t prvSocketSelectCollect( SocketSelect_t * pxSocketSet,
+                                              Socket_t * pxReadySockets,
+                                              BaseType_t xMaxSockets )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( pxSocketSet->xReadyList.xListEnd ) );
+        const ListItem_t * pxIterator;
+        BaseType_t xCount = 0;
+        BaseType_t xIndex;
+
+        /* The IP-task changes the list as well. */
+        vTaskSuspendAll();
+        {
+            for( pxIterator = listGET_NEXT( pxEnd );
+                 ( pxIterator != pxEnd ) && ( xCount < xMaxSockets );
+                 pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+                if( ( pxSocket->xSocketBits & ( ( EventBits_t ) eSELECT_ALL ) ) != 0U )
+                {
+                    pxReadySockets[ xCount ] = pxSocket;
+                    xCount++;
+                }
+            }
+
+            if( pxIterator != pxEnd )
+            {
+                for( xIndex = 0; xIndex < xCount; xIndex++ )
+                {
+                    FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) pxReadySockets[ xIndex ];
+
+                    ( void ) uxListRemove( &( pxSocket->xSelectListItem ) );
+                    vListInsertEnd( &( pxSocketSet->xReadyList ), &( pxSocket->xSelectListItem ) );
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xCount;
+    }
+
+#endif /* ipconfigUSE_SOCKET_READY_LIST == 1 */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+
+/**
+ * @brief Put a socket on the ready list of its socket set, unless it is in
+ *        there already.  The socket is only a candidate: vSocketSelect() will
+ *        find out whether any of its select events has actually occurred.
+ *
+ * @param[in] pxSocket: The socket that may have become ready.
+ */
+    void vSocketSelectMarkReady( FreeRTOS_Socket_t * pxSocket )
+    {
+        SocketSelect_t * pxSocketSet;
+
+        /* A socket that is added to a set after this test is put on the ready
+         * list by FreeRTOS_FD_SET(). */
+        if( pxSocket->pxSocketSet != NULL )
+        {
+            vTaskSuspendAll();
+            {
+                /* Read the set again, as FreeRTOS_FD_SET() or FreeRTOS_FD_CLR()
+                 * may have moved the socket to another set in the meantime. */
+                pxSocketSet = pxSocket->pxSocketSet;
+
+                if( ( pxSocketSet != NULL ) &&
+                    ( listLIST_ITEM_CONTAINER( &( pxSocket->xSelectListItem ) ) == NULL ) )
+                {
+                    vListInsertEnd( &( pxSocketSet->xReadyList ), &( pxSocket->xSelectListItem ) );
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+    }
+
+#endif /* ipconfigUSE_SOCKET_READY_LIST == 1 */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+
+/**
+ * @brief Take a socket from the ready list of its socket set.
+ *
+ * @param[in] pxSocket: The socket that leaves its socket set or is closed.
+ */
+    static void prvSocketSelectRemoveReady( FreeRTOS_Socket_t * pxSocket )
+    {
+        vTaskSuspendAll();
+        {
+            if( listLIST_ITEM_CONTAINER( &( pxSocket->xSelectListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxSocket->xSelectListItem ) );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        pxSocket->xSocketBits = 0U;
+    }
+
+#endif /* ipconfigUSE_SOCKET_READY_LIST == 1 */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+
+/**
+ * @brief Change the socket set of a socket.  When the socket leaves its set,
+ *        it is taken from the ready list of that set.  When it is in a set
+ *        afterwards, it is put on the ready list of the set, so that
+ *        vSocketSelect() looks at it.  This is all done with the scheduler
+ *        suspended, so that vSocketSelectMarkReady() can not put the socket
+ *        on the ready list of the set that it is leaving.
+ *
+ * @param[in] pxSocket: The socket that is added to, moved or removed from a set.
+ * @param[in] pxSocketSet: The new set of the socket, or NULL.
+ */
+    static void prvSocketSelectSetSocketSet( FreeRTOS_Socket_t * pxSocket,
+                                             SocketSelect_t * pxSocketSet )
+    {
+        vTaskSuspendAll();
+        {
+            if( ( pxSocket->pxSocketSet != pxSocketSet ) || ( pxSocketSet == NULL ) )
+            {
+                if( listLIST_ITEM_CONTAINER( &( pxSocket->xSelectListItem ) ) != NULL )
+                {
+                    ( void ) uxListRemove( &( pxSocket->xSelectListItem ) );
+                }
+
+                pxSocket->xSocketBits = 0U;
+            }
+
+            pxSocket->pxSocketSet = pxSocketSet;
+
+            if( ( pxSocketSet != NULL ) &&
+                ( listLIST_ITEM_CONTAINER( &( pxSocket->xSelectListItem ) ) == NULL ) )
+            {
+                vListInsertEnd( &( pxSocketSet->xReadyList ), &( pxSocket->xSelectListItem ) );
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+#endif /* ipconfigUSE_SOCKET_READY_LIST == 1 */
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Receive data from a bound socket. In this library, the function
  *        can only be used with connection-less sockets (UDP). For TCP sockets,
@@ -1426,6 +1792,19 @@ BaseType_t vSocketBind( FreeRTOS_Socket_t * pxSocket,
                         }
                     #endif /* ipconfigETHERNET_DRIVER_FILTERS_PACKETS */
                 }
+
+                #if ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_HASH_TABLE == 1 )
+                    {
+                        /* A TCP socket bound by the application is found through its
+                         * port number.  A child socket, which is bound internally, will
+                         * be stored in the connection table as soon as its peer is
+                         * known. */
+                        if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) && ( xInternal == pdFALSE ) )
+                        {
+                            prvTCPHashInsert( &( pxTCPPortTable[ prvTCPPortHash( pxSocket->usLocalPort ) ] ), pxSocket );
+                        }
+                    }
+                #endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_HASH_TABLE == 1 ) */
             }
         } while( ipFALSE_BOOL );
     }
@@ -1570,6 +1949,23 @@ void * vSocketClose( FreeRTOS_Socket_t * pxSocket )
                     vPortFreeLarge( pxSocket->u.xTCP.txStream );
                 }
 
+                #if ( ipconfigUSE_TCP_HASH_TABLE == 1 )
+                    {
+                        /* No more segments should find this socket. */
+                        prvTCPHashRemove( pxSocket );
+                    }
+                #endif /* ipconfigUSE_TCP_HASH_TABLE */
+
+                #if ( ipconfigIP_RX_BURST_LENGTH > 1 )
+                    {
+                        /* The end of a burst must not send an ACK for this socket. */
+                        if( pxSocket->u.xTCP.bits.bRxBurstAck != pdFALSE_UNSIGNED )
+                        {
+                            vTCPRxBurstRemoveSocket( pxSocket );
+                        }
+                    }
+                #endif /* ipconfigIP_RX_BURST_LENGTH > 1 */
+
                 /* In case this is a child socket, make sure the child-count of the
                  * parent socket is decreased. */
                 prvTCPSetSocketCount( pxSocket );
@@ -1577,6 +1973,13 @@ void * vSocketClose( FreeRTOS_Socket_t * pxSocket )
         }
     #endif /* ipconfigUSE_TCP == 1 */
 
+    #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+        {
+            /* The socket set must not refer to this socket anymore. */
+            prvSocketSelectRemoveReady( pxSocket );
+        }
+    #endif /* ipconfigUSE_SOCKET_READY_LIST */
+
     /* Socket must be unbound first, to ensure no more packets are queued on
      * it. */
     if( socketSOCKET_IS_BOUND( pxSocket ) )
@@ -2886,6 +3289,14 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t * pxSocket )
             {
                 EventBits_t xSelectBits = ( pxSocket->xEventBits >> SOCKET_EVENT_BIT_COUNT ) & ( ( EventBits_t ) eSELECT_ALL );
 
+                #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+                    {
+                        /* Any event may change the readiness of the socket,
+                         * vSocketSelect() will find out. */
+                        vSocketSelectMarkReady( pxSocket );
+                    }
+                #endif /* ipconfigUSE_SOCKET_READY_LIST */
+
                 if( xSelectBits != 0U )
                 {
                     pxSocket->xSocketBits |= xSelectBits;
@@ -3256,6 +3667,14 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t * pxSocket )
                         *pxAddressLength = ( socklen_t ) sizeof( *pxAddress );
                     }
 
+                    #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+                        {
+                            /* Data that arrived before the socket was accepted
+                             * did not make it ready, have it checked again. */
+                            vSocketSelectMarkReady( pxClientSocket );
+                        }
+                    #endif /* ipconfigUSE_SOCKET_READY_LIST */
+
                     if( pxSocket->u.xTCP.bits.bReuseSocket == pdFALSE_UNSIGNED )
                     {
                         xAsk = pdTRUE;
@@ -4086,44 +4505,101 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t * pxSocket )
                                            uint32_t ulRemoteIP,
                                            UBaseType_t uxRemotePort )
     {
-        const ListItem_t * pxIterator;
         FreeRTOS_Socket_t * pxResult = NULL, * pxListenSocket = NULL;
 
-        /* MISRA Ref 11.3.1 [Misaligned access] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-        /* coverity[misra_c_2012_rule_11_3_violation] */
-        const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
+        #if ( ipconfigUSE_TCP_HASH_TABLE == 1 )
+            FreeRTOS_Socket_t * pxSocket;
+        #else
+            const ListItem_t * pxIterator;
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
+        #endif
 
         /* Parameter not yet supported. */
         ( void ) ulLocalIP;
 
-        for( pxIterator = listGET_NEXT( pxEnd );
-             pxIterator != pxEnd;
-             pxIterator = listGET_NEXT( pxIterator ) )
-        {
-            FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
-
-            if( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort )
+        #if ( ipconfigUSE_TCP_HASH_TABLE == 1 )
             {
-                if( pxSocket->u.xTCP.eTCPState == eTCP_LISTEN )
+                /* Most segments are for a connection that was accepted by a
+                 * listening socket: look in the connection table first. */
+                for( pxSocket = pxTCPConnectionTable[ prvTCPConnectionHash( uxLocalPort, ulRemoteIP, uxRemotePort ) ];
+                     pxSocket != NULL;
+                     pxSocket = pxSocket->u.xTCP.pxHashNext )
                 {
-                    /* If this is a socket listening to uxLocalPort, remember it
-                     * in case there is no perfect match. */
-                    pxListenSocket = pxSocket;
+                    if( ( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort ) &&
+                        ( pxSocket->u.xTCP.usRemotePort == ( uint16_t ) uxRemotePort ) &&
+                        ( pxSocket->u.xTCP.ulRemoteIP == ulRemoteIP ) &&
+                        ( pxSocket->u.xTCP.eTCPState != eTCP_LISTEN ) )
+                    {
+                        pxResult = pxSocket;
+                        break;
+                    }
                 }
-                else if( ( pxSocket->u.xTCP.usRemotePort == ( uint16_t ) uxRemotePort ) && ( pxSocket->u.xTCP.ulRemoteIP == ulRemoteIP ) )
+
+                if( pxResult == NULL )
                 {
-                    /* For sockets not in listening mode, find a match with
-                     * xLocalPort, ulRemoteIP AND xRemotePort. */
-                    pxResult = pxSocket;
-                    break;
+                    /* The sockets bound by the application, both listening and
+                     * connecting ones, are matched like in the linear search. */
+                    for( pxSocket = pxTCPPortTable[ prvTCPPortHash( uxLocalPort ) ];
+                         pxSocket != NULL;
+                         pxSocket = pxSocket->u.xTCP.pxHashNext )
+                    {
+                        if( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort )
+                        {
+                            if( pxSocket->u.xTCP.eTCPState == eTCP_LISTEN )
+                            {
+                                if( pxListenSocket == NULL )
+                                {
+                                    pxListenSocket = pxSocket;
+                                }
+                            }
+                            else if( ( pxSocket->u.xTCP.usRemotePort == ( uint16_t ) uxRemotePort ) && ( pxSocket->u.xTCP.ulRemoteIP == ulRemoteIP ) )
+                            {
+                                pxResult = pxSocket;
+                                break;
+                            }
+                            else
+                            {
+                                /* This 'pxSocket' doesn't match. */
+                            }
+                        }
+                    }
                 }
-                else
+            }
+        #else /* if ( ipconfigUSE_TCP_HASH_TABLE == 1 ) */
+            {
+                for( pxIterator = listGET_NEXT( pxEnd );
+                     pxIterator != pxEnd;
+                     pxIterator = listGET_NEXT( pxIterator ) )
                 {
-                    /* This 'pxSocket' doesn't match. */
+                    FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+                    if( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort )
+                    {
+                        if( pxSocket->u.xTCP.eTCPState == eTCP_LISTEN )
+                        {
+                            /* If this is a socket listening to uxLocalPort, remember it
+                             * in case there is no perfect match. */
+                            pxListenSocket = pxSocket;
+                        }
+                        else if( ( pxSocket->u.xTCP.usRemotePort == ( uint16_t ) uxRemotePort ) && ( pxSocket->u.xTCP.ulRemoteIP == ulRemoteIP ) )
+                        {
+                            /* For sockets not in listening mode, find a match with
+                             * xLocalPort, ulRemoteIP AND xRemotePort. */
+                            pxResult = pxSocket;
+                            break;
+                        }
+                        else
+                        {
+                            /* This 'pxSocket' doesn't match. */
+                        }
+                    }
                 }
             }
-        }
+        #endif /* if ( ipconfigUSE_TCP_HASH_TABLE == 1 ) */
 
         if( pxResult == NULL )
         {
@@ -4138,6 +4614,107 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t * pxSocket )
 #endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_HASH_TABLE == 1 )
+
+/**
+ * @brief Find the bucket of the port hash table for a local port number.
+ *
+ * @param[in] uxLocalPort: The local port number, in host-endian notation.
+ *
+ * @return An index in pxTCPPortTable.
+ */
+    static UBaseType_t prvTCPPortHash( UBaseType_t uxLocalPort )
+    {
+        /* Multiplicative hashing: the top bits of the product depend on all
+         * bits of the key, so those are used as the index. */
+        uint32_t ulHash = ( ( uint32_t ) uxLocalPort ) * socketHASH_MULTIPLIER;
+
+        return ( UBaseType_t ) ( ulHash >> socketHASH_SHIFT );
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the bucket of the connection hash table for a connection.
+ *
+ * @param[in] uxLocalPort: The local port number, in host-endian notation.
+ * @param[in] ulRemoteIP: The IP address of the peer, in host-endian notation.
+ * @param[in] uxRemotePort: The port number of the peer, in host-endian notation.
+ *
+ * @return An index in pxTCPConnectionTable.
+ */
+    static UBaseType_t prvTCPConnectionHash( UBaseType_t uxLocalPort,
+                                             uint32_t ulRemoteIP,
+                                             UBaseType_t uxRemotePort )
+    {
+        uint32_t ulKey = ulRemoteIP ^ ( ( ( uint32_t ) uxRemotePort ) << 16 ) ^ ( ( uint32_t ) uxLocalPort );
+        uint32_t ulHash = ulKey * socketHASH_MULTIPLIER;
+
+        return ( UBaseType_t ) ( ulHash >> socketHASH_SHIFT );
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a TCP socket to the front of a hash bucket.
+ *
+ * @param[in] ppxBucket: The bucket, an element of one of the two hash tables.
+ * @param[in] pxSocket: The socket, which is not stored in any bucket yet.
+ */
+    static void prvTCPHashInsert( FreeRTOS_Socket_t ** ppxBucket,
+                                  FreeRTOS_Socket_t * pxSocket )
+    {
+        configASSERT( pxSocket->u.xTCP.ppxHashBucket == NULL );
+
+        pxSocket->u.xTCP.pxHashNext = *ppxBucket;
+        pxSocket->u.xTCP.ppxHashBucket = ppxBucket;
+        *ppxBucket = pxSocket;
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a TCP socket from the hash bucket that it is stored in, if any.
+ *
+ * @param[in] pxSocket: The socket to be removed.
+ */
+    static void prvTCPHashRemove( FreeRTOS_Socket_t * pxSocket )
+    {
+        FreeRTOS_Socket_t ** ppxLink = pxSocket->u.xTCP.ppxHashBucket;
+
+        if( ppxLink != NULL )
+        {
+            while( *ppxLink != pxSocket )
+            {
+                /* The socket must be present in its own bucket. */
+                configASSERT( *ppxLink != NULL );
+                ppxLink = &( ( *ppxLink )->u.xTCP.pxHashNext );
+            }
+
+            *ppxLink = pxSocket->u.xTCP.pxHashNext;
+            pxSocket->u.xTCP.pxHashNext = NULL;
+            pxSocket->u.xTCP.ppxHashBucket = NULL;
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+/**
+ * @brief Store a socket that was created by a listening socket in the connection
+ *        hash table.  Called by the IP-task as soon as the remote IP address and
+ *        port of the new connection are known.
+ *
+ * @param[in] pxSocket: The new socket.
+ */
+    void vTCPSocketHashConnection( FreeRTOS_Socket_t * pxSocket )
+    {
+        UBaseType_t uxIndex = prvTCPConnectionHash( pxSocket->usLocalPort,
+                                                    pxSocket->u.xTCP.ulRemoteIP,
+                                                    pxSocket->u.xTCP.usRemotePort );
+
+        prvTCPHashRemove( pxSocket );
+        prvTCPHashInsert( &( pxTCPConnectionTable[ uxIndex ] ), pxSocket );
+    }
+
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_TCP_HASH_TABLE == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( ipconfigUSE_TCP == 1 )
 
 /**
@@ -4881,168 +5458,232 @@ BaseType_t xSocketValid( const ConstSocket_t xSocket )
 
 #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
 
+/**
+ * @brief Find out which of the select events that the owner of a socket is
+ *        interested in, have actually occurred.
+ *
+ * @param[in] pxSocket: The socket to be checked.
+ *
+ * @return The select events that are pending for the socket.
+ */
+    static EventBits_t prvSocketSelectBits( FreeRTOS_Socket_t * pxSocket )
+    {
+        EventBits_t xSocketBits = 0;
+
+        #if ( ipconfigUSE_TCP == 1 )
+            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+            {
+                /* Check if the socket has already been accepted by the
+                 * owner.  If not, it is useless to return it from a
+                 * select(). */
+                BaseType_t bAccepted = pdFALSE;
+
+                if( pxSocket->u.xTCP.bits.bPassQueued == pdFALSE_UNSIGNED )
+                {
+                    if( pxSocket->u.xTCP.bits.bPassAccept == pdFALSE_UNSIGNED )
+                    {
+                        bAccepted = pdTRUE;
+                    }
+                }
+
+                /* Is the set owner interested in READ events? */
+                if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_READ ) != ( EventBits_t ) 0U )
+                {
+                    if( pxSocket->u.xTCP.eTCPState == eTCP_LISTEN )
+                    {
+                        if( ( pxSocket->u.xTCP.pxPeerSocket != NULL ) && ( pxSocket->u.xTCP.pxPeerSocket->u.xTCP.bits.bPassAccept != pdFALSE_UNSIGNED ) )
+                        {
+                            xSocketBits |= ( EventBits_t ) eSELECT_READ;
+                        }
+                    }
+                    else if( ( pxSocket->u.xTCP.bits.bReuseSocket != pdFALSE_UNSIGNED ) && ( pxSocket->u.xTCP.bits.bPassAccept != pdFALSE_UNSIGNED ) )
+                    {
+                        /* This socket has the re-use flag. After connecting it turns into
+                         * a connected socket. Set the READ event, so that accept() will be called. */
+                        xSocketBits |= ( EventBits_t ) eSELECT_READ;
+                    }
+                    else if( ( bAccepted != 0 ) && ( FreeRTOS_recvcount( pxSocket ) > 0 ) )
+                    {
+                        xSocketBits |= ( EventBits_t ) eSELECT_READ;
+                    }
+                    else
+                    {
+                        /* Nothing. */
+                    }
+                }
+
+                /* Is the set owner interested in EXCEPTION events? */
+                if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_EXCEPT ) != 0U )
+                {
+                    if( ( pxSocket->u.xTCP.eTCPState == eCLOSE_WAIT ) || ( pxSocket->u.xTCP.eTCPState == eCLOSED ) )
+                    {
+                        xSocketBits |= ( EventBits_t ) eSELECT_EXCEPT;
+                    }
+                }
+
+                /* Is the set owner interested in WRITE events? */
+                if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_WRITE ) != 0U )
+                {
+                    BaseType_t bMatch = pdFALSE;
+
+                    if( bAccepted != 0 )
+                    {
+                        if( FreeRTOS_tx_space( pxSocket ) > 0 )
+                        {
+                            bMatch = pdTRUE;
+                        }
+                    }
+
+                    if( bMatch == pdFALSE )
+                    {
+                        if( ( pxSocket->u.xTCP.bits.bConnPrepared != pdFALSE_UNSIGNED ) &&
+                            ( pxSocket->u.xTCP.eTCPState >= eESTABLISHED ) &&
+                            ( pxSocket->u.xTCP.bits.bConnPassed == pdFALSE_UNSIGNED ) )
+                        {
+                            pxSocket->u.xTCP.bits.bConnPassed = pdTRUE;
+                            bMatch = pdTRUE;
+                        }
+                    }
+
+                    if( bMatch != pdFALSE )
+                    {
+                        xSocketBits |= ( EventBits_t ) eSELECT_WRITE;
+                    }
+                }
+            }
+            else
+        #endif /* ipconfigUSE_TCP == 1 */
+        {
+            /* Select events for UDP are simpler. */
+            if( ( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_READ ) != 0U ) &&
+                ( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U ) )
+            {
+                xSocketBits |= ( EventBits_t ) eSELECT_READ;
+            }
+
+            /* The WRITE and EXCEPT bits are not used for UDP */
+        } /* if( pxSocket->ucProtocol == FREERTOS_IPPROTO_TCP ) */
+
+        return xSocketBits;
+    }
+
+#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+
 /**
  * @brief This internal non-blocking function will check all sockets that belong
  *        to a select set.  The events bits of each socket will be updated, and it
  *        will check if an ongoing select() call must be interrupted because of an
- *        event has occurred.
+ *        event has occurred.  When ipconfigUSE_SOCKET_READY_LIST is enabled, only
+ *        the sockets in the ready list of the set are checked, and the ones that
+ *        turn out to be idle are taken out of the list.
  *
  * @param[in] pxSocketSet: The socket-set which is to be waited on for change.
  */
     void vSocketSelect( const SocketSelect_t * pxSocketSet )
     {
-        BaseType_t xRound;
         EventBits_t xSocketBits, xBitsToClear;
 
-        #if ipconfigUSE_TCP == 1
-            BaseType_t xLastRound = 1;
-        #else
-            BaseType_t xLastRound = 0;
-        #endif
-
         /* These flags will be switched on after checking the socket status. */
         EventBits_t xGroupBits = 0;
 
-        for( xRound = 0; xRound <= xLastRound; xRound++ )
-        {
-            const ListItem_t * pxIterator;
-            const ListItem_t * pxEnd;
-
-            if( xRound == 0 )
+        #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
             {
+                /* Only the sockets that had an event since they were last
+                 * found idle have to be checked. */
                 /* MISRA Ref 11.3.1 [Misaligned access] */
                 /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
                 /* coverity[misra_c_2012_rule_11_3_violation] */
-                pxEnd = ( ( const ListItem_t * ) &( xBoundUDPSocketsList.xListEnd ) );
-            }
+                const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( pxSocketSet->xReadyList.xListEnd ) );
+                ListItem_t * pxIterator;
+                ListItem_t * pxNext;
 
-            #if ipconfigUSE_TCP == 1
-                else
+                /* The API may change the list from another task. */
+                vTaskSuspendAll();
                 {
-                    /* MISRA Ref 11.3.1 [Misaligned access] */
-                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-                    /* coverity[misra_c_2012_rule_11_3_violation] */
-                    pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
-                }
-            #endif /* ipconfigUSE_TCP == 1 */
+                    for( pxIterator = listGET_NEXT( pxEnd );
+                         pxIterator != pxEnd;
+                         pxIterator = pxNext )
+                    {
+                        FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
 
-            for( pxIterator = listGET_NEXT( pxEnd );
-                 pxIterator != pxEnd;
-                 pxIterator = listGET_NEXT( pxIterator ) )
-            {
-                FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                        pxNext = listGET_NEXT( pxIterator );
 
-                if( pxSocket->pxSocketSet != pxSocketSet )
-                {
-                    /* Socket does not belong to this select group. */
-                    continue;
+                        xSocketBits = prvSocketSelectBits( pxSocket );
+                        pxSocket->xSocketBits = xSocketBits;
+
+                        if( xSocketBits == 0U )
+                        {
+                            /* The socket will be put back in the list by
+                             * vSocketWakeUpUser() at its next event. */
+                            ( void ) uxListRemove( pxIterator );
+                        }
+
+                        xGroupBits |= xSocketBits;
+                    }
                 }
+                ( void ) xTaskResumeAll();
+            }
+        #else /* if ( ipconfigUSE_SOCKET_READY_LIST == 1 ) */
+            {
+                BaseType_t xRound;
 
-                xSocketBits = 0;
+                #if ipconfigUSE_TCP == 1
+                    BaseType_t xLastRound = 1;
+                #else
+                    BaseType_t xLastRound = 0;
+                #endif
 
-                #if ( ipconfigUSE_TCP == 1 )
-                    if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
-                    {
-                        /* Check if the socket has already been accepted by the
-                         * owner.  If not, it is useless to return it from a
-                         * select(). */
-                        BaseType_t bAccepted = pdFALSE;
+                for( xRound = 0; xRound <= xLastRound; xRound++ )
+                {
+                    const ListItem_t * pxIterator;
+                    const ListItem_t * pxEnd;
 
-                        if( pxSocket->u.xTCP.bits.bPassQueued == pdFALSE_UNSIGNED )
-                        {
-                            if( pxSocket->u.xTCP.bits.bPassAccept == pdFALSE_UNSIGNED )
-                            {
-                                bAccepted = pdTRUE;
-                            }
-                        }
+                    if( xRound == 0 )
+                    {
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        pxEnd = ( ( const ListItem_t * ) &( xBoundUDPSocketsList.xListEnd ) );
+                    }
 
-                        /* Is the set owner interested in READ events? */
-                        if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_READ ) != ( EventBits_t ) 0U )
+                    #if ipconfigUSE_TCP == 1
+                        else
                         {
-                            if( pxSocket->u.xTCP.eTCPState == eTCP_LISTEN )
-                            {
-                                if( ( pxSocket->u.xTCP.pxPeerSocket != NULL ) && ( pxSocket->u.xTCP.pxPeerSocket->u.xTCP.bits.bPassAccept != pdFALSE_UNSIGNED ) )
-                                {
-                                    xSocketBits |= ( EventBits_t ) eSELECT_READ;
-                                }
-                            }
-                            else if( ( pxSocket->u.xTCP.bits.bReuseSocket != pdFALSE_UNSIGNED ) && ( pxSocket->u.xTCP.bits.bPassAccept != pdFALSE_UNSIGNED ) )
-                            {
-                                /* This socket has the re-use flag. After connecting it turns into
-                                 * a connected socket. Set the READ event, so that accept() will be called. */
-                                xSocketBits |= ( EventBits_t ) eSELECT_READ;
-                            }
-                            else if( ( bAccepted != 0 ) && ( FreeRTOS_recvcount( pxSocket ) > 0 ) )
-                            {
-                                xSocketBits |= ( EventBits_t ) eSELECT_READ;
-                            }
-                            else
-                            {
-                                /* Nothing. */
-                            }
+                            /* MISRA Ref 11.3.1 [Misaligned access] */
+                            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                            /* coverity[misra_c_2012_rule_11_3_violation] */
+                            pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
                         }
+                    #endif /* ipconfigUSE_TCP == 1 */
 
-                        /* Is the set owner interested in EXCEPTION events? */
-                        if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_EXCEPT ) != 0U )
-                        {
-                            if( ( pxSocket->u.xTCP.eTCPState == eCLOSE_WAIT ) || ( pxSocket->u.xTCP.eTCPState == eCLOSED ) )
-                            {
-                                xSocketBits |= ( EventBits_t ) eSELECT_EXCEPT;
-                            }
-                        }
+                    for( pxIterator = listGET_NEXT( pxEnd );
+                         pxIterator != pxEnd;
+                         pxIterator = listGET_NEXT( pxIterator ) )
+                    {
+                        FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
 
-                        /* Is the set owner interested in WRITE events? */
-                        if( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_WRITE ) != 0U )
+                        if( pxSocket->pxSocketSet != pxSocketSet )
                         {
-                            BaseType_t bMatch = pdFALSE;
-
-                            if( bAccepted != 0 )
-                            {
-                                if( FreeRTOS_tx_space( pxSocket ) > 0 )
-                                {
-                                    bMatch = pdTRUE;
-                                }
-                            }
-
-                            if( bMatch == pdFALSE )
-                            {
-                                if( ( pxSocket->u.xTCP.bits.bConnPrepared != pdFALSE_UNSIGNED ) &&
-                                    ( pxSocket->u.xTCP.eTCPState >= eESTABLISHED ) &&
-                                    ( pxSocket->u.xTCP.bits.bConnPassed == pdFALSE_UNSIGNED ) )
-                                {
-                                    pxSocket->u.xTCP.bits.bConnPassed = pdTRUE;
-                                    bMatch = pdTRUE;
-                                }
-                            }
-
-                            if( bMatch != pdFALSE )
-                            {
-                                xSocketBits |= ( EventBits_t ) eSELECT_WRITE;
-                            }
+                            /* Socket does not belong to this select group. */
+                            continue;
                         }
-                    }
-                    else
-                #endif /* ipconfigUSE_TCP == 1 */
-                {
-                    /* Select events for UDP are simpler. */
-                    if( ( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_READ ) != 0U ) &&
-                        ( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U ) )
-                    {
-                        xSocketBits |= ( EventBits_t ) eSELECT_READ;
-                    }
 
-                    /* The WRITE and EXCEPT bits are not used for UDP */
-                } /* if( pxSocket->ucProtocol == FREERTOS_IPPROTO_TCP ) */
+                        xSocketBits = prvSocketSelectBits( pxSocket );
 
-                /* Each socket keeps its own event flags, which are looked-up
-                 * by FreeRTOS_FD_ISSSET() */
-                pxSocket->xSocketBits = xSocketBits;
+                        /* Each socket keeps its own event flags, which are looked-up
+                         * by FreeRTOS_FD_ISSSET() */
+                        pxSocket->xSocketBits = xSocketBits;
 
-                /* The ORed value will be used to set the bits in the event
-                 * group. */
-                xGroupBits |= xSocketBits;
-            } /* for( pxIterator ... ) */
-        }     /* for( xRound = 0; xRound <= xLastRound; xRound++ ) */
+                        /* The ORed value will be used to set the bits in the event
+                         * group. */
+                        xGroupBits |= xSocketBits;
+                    } /* for( pxIterator ... ) */
+                }     /* for( xRound = 0; xRound <= xLastRound; xRound++ ) */
+            }
+        #endif /* if ( ipconfigUSE_SOCKET_READY_LIST == 1 ) */
 
         xBitsToClear = xEventGroupGetBits( pxSocketSet->xSelectGroup );
 
@@ -88,6 +88,21 @@
     /* coverity[misra_c_2012_rule_8_9_violation] */
     static FreeRTOS_Socket_t * xSocketToListen = NULL;
 
+    #if ( ipconfigIP_RX_BURST_LENGTH > 1 )
+
+/** @brief The sockets of which the acknowledgement is held back until the
+ *         IP-task has handled the current burst of received packets.  These
+ *         variables can be accessed by the IP task only.
+ */
+        static FreeRTOS_Socket_t * pxRxBurstSockets[ ipconfigIP_RX_BURST_LENGTH ];
+
+/** @brief The number of sockets stored in pxRxBurstSockets. */
+        static UBaseType_t uxRxBurstSocketCount = 0U;
+
+/** @brief pdTRUE while the IP-task handles a burst of received packets. */
+        static BaseType_t xRxBurstActive = pdFALSE;
+    #endif /* ipconfigIP_RX_BURST_LENGTH > 1 */
+
 /*
  * For anti-hang protection and TCP keep-alive messages.  Called in two places:
  * after receiving a packet and after a state change.  The socket's alive timer
@@ -146,6 +161,111 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigIP_RX_BURST_LENGTH > 1 )
+
+/**
+ * @brief The IP-task starts handling a burst of received packets.
+ */
+        void vTCPRxBurstStart( void )
+        {
+            xRxBurstActive = pdTRUE;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Hold back the acknowledgement of a socket until the IP-task has handled
+ *        the current burst of received packets.  The ACK message itself is
+ *        stored in 'pxAckMessage', as for a delayed ACK.
+ *
+ * @param[in] pxSocket: The socket that wants to acknowledge received data.
+ *
+ * @return pdTRUE when vTCPRxBurstEnd() will send the acknowledgement, pdFALSE
+ *         when it must be sent now.
+ */
+        BaseType_t xTCPRxBurstDeferAck( FreeRTOS_Socket_t * pxSocket )
+        {
+            BaseType_t xReturn = pdFALSE;
+
+            if( xRxBurstActive != pdFALSE )
+            {
+                if( pxSocket->u.xTCP.bits.bRxBurstAck != pdFALSE_UNSIGNED )
+                {
+                    /* An earlier packet of this burst was held back already.
+                     * The new ACK replaces it. */
+                    xReturn = pdTRUE;
+                }
+                else if( uxRxBurstSocketCount < ( UBaseType_t ) ipconfigIP_RX_BURST_LENGTH )
+                {
+                    pxRxBurstSockets[ uxRxBurstSocketCount ] = pxSocket;
+                    uxRxBurstSocketCount++;
+                    pxSocket->u.xTCP.bits.bRxBurstAck = pdTRUE_UNSIGNED;
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    /* No more room: a message with linked packets may hold
+                     * more packets than ipconfigIP_RX_BURST_LENGTH. */
+                }
+            }
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief The IP-task has handled a burst of received packets.  Send the
+ *        acknowledgements that were held back, along with any data that is
+ *        waiting to be sent, just like when the socket's timer expires.
+ */
+        void vTCPRxBurstEnd( void )
+        {
+            UBaseType_t uxIndex;
+            FreeRTOS_Socket_t * pxSocket;
+
+            xRxBurstActive = pdFALSE;
+
+            /* uxRxBurstSocketCount is only cleared at the end, because a socket
+             * that gets closed from xTCPSocketCheck() may be in the list. */
+            for( uxIndex = 0U; uxIndex < uxRxBurstSocketCount; uxIndex++ )
+            {
+                pxSocket = pxRxBurstSockets[ uxIndex ];
+
+                /* NULL when the socket was closed during the burst. */
+                if( pxSocket != NULL )
+                {
+                    pxSocket->u.xTCP.bits.bRxBurstAck = pdFALSE_UNSIGNED;
+                    pxSocket->u.xTCP.usTimeout = 0U;
+                    ( void ) xTCPSocketCheck( pxSocket );
+                }
+            }
+
+            uxRxBurstSocketCount = 0U;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a socket that is being closed from the sockets of which the
+ *        acknowledgement is held back.
+ *
+ * @param[in] pxSocket: The socket being closed.
+ */
+        void vTCPRxBurstRemoveSocket( FreeRTOS_Socket_t * pxSocket )
+        {
+            UBaseType_t uxIndex;
+
+            for( uxIndex = 0U; uxIndex < uxRxBurstSocketCount; uxIndex++ )
+            {
+                if( pxRxBurstSockets[ uxIndex ] == pxSocket )
+                {
+                    pxRxBurstSockets[ uxIndex ] = NULL;
+                }
+            }
+
+            pxSocket->u.xTCP.bits.bRxBurstAck = pdFALSE_UNSIGNED;
+        }
+        /*-----------------------------------------------------------*/
+    #endif /* ipconfigIP_RX_BURST_LENGTH > 1 */
+
 /**
  * @brief As soon as a TCP socket timer expires, this function will be called
  *       (from xTCPTimerCheck). It can send a delayed ACK or new data.
@@ -1003,6 +1003,18 @@
 
             pxReturn->u.xTCP.usRemotePort = FreeRTOS_htons( pxTCPPacket->xTCPHeader.usSourcePort );
             pxReturn->u.xTCP.ulRemoteIP = FreeRTOS_htonl( pxTCPPacket->xIPHeader.ulSourceIPAddress );
+
+            #if ( ipconfigUSE_TCP_HASH_TABLE == 1 )
+                {
+                    /* A new child socket can now be found through its peer.  A
+                     * reused listening socket stays in the port table. */
+                    if( pxReturn != pxSocket )
+                    {
+                        vTCPSocketHashConnection( pxReturn );
+                    }
+                }
+            #endif /* ipconfigUSE_TCP_HASH_TABLE */
+
             pxReturn->u.xTCP.xTCPWindow.ulOurSequenceNumber = ulInitialSequenceNumber;
 
             /* Here is the SYN action. */
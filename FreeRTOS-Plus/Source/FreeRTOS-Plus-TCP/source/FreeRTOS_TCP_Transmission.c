@@ -211,17 +211,38 @@
         UBaseType_t uxOptionsLength = 0U;
         int32_t xSendLength;
 
+        #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+            UBaseType_t uxSegmentCount;
+        #endif
+
         for( uxIndex = 0U; uxIndex < ( UBaseType_t ) SEND_REPEATED_COUNT; uxIndex++ )
         {
-            /* prvTCPPrepareSend() might allocate a network buffer if there is data
-             * to be sent. */
-            xSendLength = prvTCPPrepareSend( pxSocket, ppxNetworkBuffer, uxOptionsLength );
+            #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+                {
+                    /* Put the segments that follow in the same network buffer, as
+                     * many as the remaining repetitions allow. */
+                    uxSegmentCount = ( ( UBaseType_t ) SEND_REPEATED_COUNT ) - uxIndex;
+                    xSendLength = prvTCPPrepareLargeSend( pxSocket, ppxNetworkBuffer, uxOptionsLength, &( uxSegmentCount ) );
+                }
+            #else
+                {
+                    /* prvTCPPrepareSend() might allocate a network buffer if there is data
+                     * to be sent. */
+                    xSendLength = prvTCPPrepareSend( pxSocket, ppxNetworkBuffer, uxOptionsLength );
+                }
+            #endif
 
             if( xSendLength <= 0 )
             {
                 break;
             }
 
+            #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+                {
+                    uxIndex += uxSegmentCount - 1U;
+                }
+            #endif
+
             /* And return the packet to the peer. */
             prvTCPReturnPacket( pxSocket, *ppxNetworkBuffer, ( uint32_t ) xSendLength, ipconfigZERO_COPY_TX_DRIVER );
 
@@ -280,6 +301,11 @@
                     pxNetworkBuffer->pxNextBuffer = NULL;
                 }
             #endif
+            #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+                {
+                    pxNetworkBuffer->usSegmentSize = 0U;
+                }
+            #endif
             pxNetworkBuffer->pucEthernetBuffer = pxSocket->u.xTCP.xPacket.u.ucLastPacket;
             pxNetworkBuffer->xDataLength = sizeof( pxSocket->u.xTCP.xPacket.u.ucLastPacket );
             xDoRelease = pdFALSE;
@@ -450,6 +476,15 @@
             pxIPHeader->usIdentification = FreeRTOS_htons( usPacketIdentifier );
             usPacketIdentifier++;
 
+            #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+                if( pxNetworkBuffer->usSegmentSize != 0U )
+                {
+                    /* Each segment of a large send gets the next number.  Large
+                     * sends are prepared without TCP options. */
+                    usPacketIdentifier += ( uint16_t ) ( ( ulLen - ( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + 1U ) ) / pxNetworkBuffer->usSegmentSize );
+                }
+            #endif
+
             /* The stack doesn't support fragments, so the fragment offset field must always be zero.
              * The header was never memset to zero, so set both the fragment offset and fragmentation flags in one go.
              */
@@ -465,13 +500,35 @@
 
             #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
                 {
-                    /* calculate the IP header checksum, in case the driver won't do that. */
-                    pxIPHeader->usHeaderChecksum = 0x00U;
-                    pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER );
-                    pxIPHeader->usHeaderChecksum = ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
+                    BaseType_t xSetChecksums = pdTRUE;
 
-                    /* calculate the TCP checksum for an outgoing packet. */
-                    ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxTCPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+                    #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+                        /* The checksums of a large send are set for each segment. */
+                        if( pxNetworkBuffer->usSegmentSize != 0U )
+                        {
+                            xSetChecksums = pdFALSE;
+                        }
+                    #endif
+
+                    #if ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 )
+                        /* Leave the checksums to the network interface if it
+                         * can set them. */
+                        if( ( uxNetworkInterfaceGetCapabilities() & ipNETWORK_CAPABILITY_TX_CHECKSUM ) != 0U )
+                        {
+                            xSetChecksums = pdFALSE;
+                        }
+                    #endif
+
+                    if( xSetChecksums != pdFALSE )
+                    {
+                        /* calculate the IP header checksum, in case the driver won't do that. */
+                        pxIPHeader->usHeaderChecksum = 0x00U;
+                        pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER );
+                        pxIPHeader->usHeaderChecksum = ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
+
+                        /* calculate the TCP checksum for an outgoing packet. */
+                        ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxTCPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+                    }
                 }
             #endif /* if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) */
 
@@ -530,8 +587,19 @@
             #endif /* if( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 ) */
 
             /* Send! */
-            iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
-            ( void ) xNetworkInterfaceOutput( pxNetworkBuffer, xDoRelease );
+            #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+                if( ( pxNetworkBuffer->usSegmentSize != 0U ) &&
+                    ( ( uxNetworkInterfaceGetCapabilities() & ipNETWORK_CAPABILITY_TCP_SEGMENTATION ) == 0U ) )
+                {
+                    /* The network interface can not split a large send. */
+                    prvTCPSendSegmented( pxNetworkBuffer, xDoRelease );
+                }
+                else
+            #endif
+            {
+                iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
+                ( void ) xNetworkInterfaceOutput( pxNetworkBuffer, xDoRelease );
+            }
 
             if( xDoRelease == pdFALSE )
             {
@@ -540,6 +608,13 @@
                 vFlip_16( pxTCPPacket->xTCPHeader.usSourcePort, pxTCPPacket->xTCPHeader.usDestinationPort );
                 pxTCPPacket->xIPHeader.ulSourceIPAddress = pxTCPPacket->xIPHeader.ulDestinationIPAddress;
                 ( void ) memcpy( ( void * ) ( pxEthernetHeader->xSourceAddress.ucBytes ), ( const void * ) ( pxEthernetHeader->xDestinationAddress.ucBytes ), ( size_t ) ipMAC_ADDRESS_LENGTH_BYTES );
+
+                #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+                    {
+                        /* The buffer may be used again for a normal packet. */
+                        pxNetworkBuffer->usSegmentSize = 0U;
+                    }
+                #endif
             }
             else
             {
@@ -1156,6 +1231,279 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+
+/**
+ * @brief Prepare an outgoing message, as prvTCPPrepareSend() does, and add the
+ *        segments that follow to the same network buffer, so they can be sent
+ *        as one large send.
+ *
+ * @param[in] pxSocket: The socket owning the connection.
+ * @param[in,out] ppxNetworkBuffer: Pointer to the pointer to the network buffer.
+ * @param[in] uxOptionsLength: The length of the TCP options.
+ * @param[in,out] puxSegmentCount: The maximum number of segments to send, and
+ *                                 on return the number of segments in the buffer.
+ *
+ * @return The length of the packet, or the value returned by prvTCPPrepareSend().
+ *
+ * @note Only new data, of full-sized segments, is combined.  The network buffer
+ *       is given its size before the first segment is copied to it, so that a
+ *       large send costs one allocation, just like a single segment.  The field
+ *       'usSegmentSize' of the network buffer is set when there is more than
+ *       one segment.
+ */
+        int32_t prvTCPPrepareLargeSend( FreeRTOS_Socket_t * pxSocket,
+                                        NetworkBufferDescriptor_t ** ppxNetworkBuffer,
+                                        UBaseType_t uxOptionsLength,
+                                        UBaseType_t * puxSegmentCount )
+        {
+            TCPWindow_t * pxTCPWindow = &( pxSocket->u.xTCP.xTCPWindow );
+            const size_t uxHeaderLength = uxIPHeaderSizeSocket( pxSocket ) + ipSIZE_OF_TCP_HEADER;
+            UBaseType_t uxMaxSegments = *puxSegmentCount;
+            UBaseType_t uxSegmentCount = 1U;
+            NetworkBufferDescriptor_t * pxLargeBuffer = NULL;
+            ProtocolHeaders_t * pxProtocolHeaders;
+            uint8_t * pucSendData;
+            int32_t lSendLength, lSegmentSize, lDataLength, lMaxDataLength = 0, lLength, lStreamPos;
+            uint32_t ulFirstSequenceNumber, ulNextSequenceNumber, ulDataGot, ulDistance, ulUnsent;
+            size_t uxOffset;
+
+            /* The 16-bit IP length field must be able to hold the length of the
+             * large send. */
+            if( uxMaxSegments > ( ( 0xFFFFU - uxHeaderLength ) / ( size_t ) pxTCPWindow->usMSS ) )
+            {
+                uxMaxSegments = ( UBaseType_t ) ( ( 0xFFFFU - uxHeaderLength ) / ( size_t ) pxTCPWindow->usMSS );
+            }
+
+            /* The amount of new data in the transmission queue. */
+            ulUnsent = pxTCPWindow->ulNextTxSequenceNumber - pxTCPWindow->tx.ulHighestSequenceNumber;
+
+            if( ( xBufferAllocFixedSize == pdFALSE ) &&
+                ( uxOptionsLength == 0U ) &&
+                ( uxMaxSegments > 1U ) &&
+                ( ulUnsent > ( uint32_t ) pxTCPWindow->usMSS ) &&
+                ( xTCPWindowTxHasFollowing( pxTCPWindow, pxSocket->u.xTCP.ulWindowSize, pxTCPWindow->tx.ulHighestSequenceNumber ) != pdFALSE ) )
+            {
+                /* More than one segment of new data is waiting.  Make the network
+                 * buffer large enough to hold them all, before prvTCPPrepareSend()
+                 * allocates one that only holds the first. */
+                lMaxDataLength = ( int32_t ) FreeRTOS_min_uint32( ulUnsent, ( uint32_t ) pxTCPWindow->usMSS * ( uint32_t ) uxMaxSegments );
+                pxLargeBuffer = prvTCPBufferResize( pxSocket, *ppxNetworkBuffer, lMaxDataLength, 0U );
+
+                if( pxLargeBuffer != NULL )
+                {
+                    *ppxNetworkBuffer = pxLargeBuffer;
+                }
+            }
+
+            lSendLength = prvTCPPrepareSend( pxSocket, ppxNetworkBuffer, uxOptionsLength );
+
+            if( ( lSendLength > 0 ) && ( *ppxNetworkBuffer != NULL ) )
+            {
+                /* The buffer may still hold a previous large send. */
+                ( *ppxNetworkBuffer )->usSegmentSize = 0U;
+
+                /* prvTCPPrepareSend() does not replace a buffer that is large enough. */
+                if( ( pxLargeBuffer != NULL ) && ( *ppxNetworkBuffer == pxLargeBuffer ) )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    pxProtocolHeaders = ( ( ProtocolHeaders_t * ) &( pxLargeBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderSizeSocket( pxSocket ) ] ) );
+                    lSegmentSize = lSendLength - ( int32_t ) uxHeaderLength;
+                    ulFirstSequenceNumber = pxTCPWindow->ulOurSequenceNumber;
+                    ulNextSequenceNumber = ulFirstSequenceNumber + ( uint32_t ) lSegmentSize;
+                    lDataLength = lSegmentSize;
+                    lLength = lSegmentSize;
+
+                    while( ( uxSegmentCount < uxMaxSegments ) &&
+                           ( lSegmentSize == ( int32_t ) pxTCPWindow->usMSS ) &&
+                           ( lLength == lSegmentSize ) &&
+                           ( ( lDataLength + lSegmentSize ) <= lMaxDataLength ) &&
+                           ( ( pxProtocolHeaders->xTCPHeader.ucTCPFlags & tcpTCP_FLAG_FIN ) == 0U ) &&
+                           ( xTCPWindowTxHasFollowing( pxTCPWindow, pxSocket->u.xTCP.ulWindowSize, ulNextSequenceNumber ) != pdFALSE ) )
+                    {
+                        lLength = ( int32_t ) ulTCPWindowTxGet( pxTCPWindow, pxSocket->u.xTCP.ulWindowSize, &lStreamPos );
+
+                        /* The data follows that of the previous segment. */
+                        pucSendData = &( pxLargeBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxHeaderLength + ( size_t ) lDataLength ] );
+                        uxOffset = uxStreamBufferDistance( pxSocket->u.xTCP.txStream, pxSocket->u.xTCP.txStream->uxTail, ( size_t ) lStreamPos );
+                        ulDataGot = ( uint32_t ) uxStreamBufferGet( pxSocket->u.xTCP.txStream, uxOffset, pucSendData, ( size_t ) lLength, pdTRUE );
+
+                        /* Add the FIN flag to the last segment, as in prvTCPPrepareSend(). */
+                        if( pxSocket->u.xTCP.bits.bCloseRequested != pdFALSE_UNSIGNED )
+                        {
+                            ulDistance = ( uint32_t ) uxStreamBufferDistance( pxSocket->u.xTCP.txStream, ( size_t ) lStreamPos, pxSocket->u.xTCP.txStream->uxHead );
+
+                            if( ulDistance == ulDataGot )
+                            {
+                                pxProtocolHeaders->xTCPHeader.ucTCPFlags |= tcpTCP_FLAG_FIN;
+                                pxTCPWindow->tx.ulFINSequenceNumber = ulNextSequenceNumber + ( uint32_t ) lLength;
+                                pxSocket->u.xTCP.bits.bFinSent = pdTRUE_UNSIGNED;
+                            }
+                        }
+
+                        lDataLength += lLength;
+                        ulNextSequenceNumber += ( uint32_t ) lLength;
+                        uxSegmentCount++;
+                    }
+
+                    if( uxSegmentCount > 1U )
+                    {
+                        /* ulTCPWindowTxGet() has set the sequence number of the last
+                         * segment, the header gets the one of the first. */
+                        pxTCPWindow->ulOurSequenceNumber = ulFirstSequenceNumber;
+                        pxLargeBuffer->usSegmentSize = ( uint16_t ) lSegmentSize;
+                        lSendLength = ( int32_t ) uxHeaderLength + lDataLength;
+                    }
+                }
+            }
+
+            *puxSegmentCount = uxSegmentCount;
+
+            return lSendLength;
+        }
+    #endif /* ipconfigUSE_TCP_SEGMENTATION_OFFLOAD */
+    /*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+
+/**
+ * @brief Split a large send into segments of 'usSegmentSize' bytes of data, for
+ *        a network interface that can not do it.
+ *
+ * @param[in] pxNetworkBuffer: The large send, with its headers filled in by
+ *                             prvTCPReturnPacket(), except for the checksums.
+ * @param[in] xReleaseAfterSend: pdTRUE if the ownership of the large send was
+ *                               transferred to the network interface.
+ *
+ * @note When the network interface copies the packets that it sends, each
+ *       segment is sent from within the large buffer: its headers are written
+ *       over the end of the previous segment, which has been sent already.
+ */
+        void prvTCPSendSegmented( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                  BaseType_t xReleaseAfterSend )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            TCPPacket_t * pxLargePacket = ( ( TCPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
+            const size_t uxHeaderLength = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + ( ( size_t ) ( pxLargePacket->xTCPHeader.ucTCPOffset & 0xF0U ) >> 2 );
+            const size_t uxDataLength = pxNetworkBuffer->xDataLength - uxHeaderLength;
+            const size_t uxSegmentSize = ( size_t ) pxNetworkBuffer->usSegmentSize;
+            const uint32_t ulSequenceNumber = FreeRTOS_ntohl( pxLargePacket->xTCPHeader.ulSequenceNumber );
+            const uint16_t usIdentification = FreeRTOS_ntohs( pxLargePacket->xIPHeader.usIdentification );
+            const uint8_t ucTCPFlags = pxLargePacket->xTCPHeader.ucTCPFlags;
+            NetworkBufferDescriptor_t xTempBuffer;
+            NetworkBufferDescriptor_t * pxSegment;
+            TCPPacket_t * pxTCPPacket;
+            BaseType_t xSegmentRelease;
+            size_t uxOffset, uxLength;
+            uint16_t usIndex = 0U;
+
+            for( uxOffset = 0U; uxOffset < uxDataLength; uxOffset += uxSegmentSize )
+            {
+                uxLength = FreeRTOS_min_size_t( uxSegmentSize, uxDataLength - uxOffset );
+
+                if( ( xReleaseAfterSend == pdFALSE ) &&
+                    ( uxSegmentSize >= uxHeaderLength ) &&
+                    ( ( uxHeaderLength + uxLength ) >= ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES ) )
+                {
+                    pxSegment = &( xTempBuffer );
+                    pxSegment->pucEthernetBuffer = &( pxNetworkBuffer->pucEthernetBuffer[ uxOffset ] );
+                    pxSegment->usSegmentSize = 0U;
+
+                    #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+                        {
+                            pxSegment->pxNextBuffer = NULL;
+                        }
+                    #endif
+
+                    if( uxOffset != 0U )
+                    {
+                        ( void ) memcpy( pxSegment->pucEthernetBuffer, pxNetworkBuffer->pucEthernetBuffer, uxHeaderLength );
+                    }
+
+                    xSegmentRelease = pdFALSE;
+                }
+                else
+                {
+                    /* A network buffer of its own, large enough to be padded. */
+                    pxSegment = pxGetNetworkBufferWithDescriptor( FreeRTOS_max_size_t( uxHeaderLength + uxLength, ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES ), 0U );
+
+                    if( pxSegment == NULL )
+                    {
+                        FreeRTOS_debug_printf( ( "prvTCPSendSegmented: no buffer for %u bytes\n", ( unsigned ) uxLength ) );
+                        break;
+                    }
+
+                    ( void ) memcpy( pxSegment->pucEthernetBuffer, pxNetworkBuffer->pucEthernetBuffer, uxHeaderLength );
+                    ( void ) memcpy( &( pxSegment->pucEthernetBuffer[ uxHeaderLength ] ), &( pxNetworkBuffer->pucEthernetBuffer[ uxHeaderLength + uxOffset ] ), uxLength );
+                    xSegmentRelease = pdTRUE;
+                }
+
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxTCPPacket = ( ( TCPPacket_t * ) pxSegment->pucEthernetBuffer );
+                pxSegment->xDataLength = uxHeaderLength + uxLength;
+
+                pxTCPPacket->xIPHeader.usLength = FreeRTOS_htons( ( uint16_t ) ( pxSegment->xDataLength - ipSIZE_OF_ETH_HEADER ) );
+                pxTCPPacket->xIPHeader.usIdentification = FreeRTOS_htons( ( uint16_t ) ( usIdentification + usIndex ) );
+                pxTCPPacket->xTCPHeader.ulSequenceNumber = FreeRTOS_htonl( ulSequenceNumber + ( uint32_t ) uxOffset );
+
+                if( ( uxOffset + uxLength ) < uxDataLength )
+                {
+                    /* Only the last segment may carry the FIN flag. */
+                    pxTCPPacket->xTCPHeader.ucTCPFlags = ucTCPFlags & ( ( uint8_t ) ~tcpTCP_FLAG_FIN );
+                }
+                else
+                {
+                    pxTCPPacket->xTCPHeader.ucTCPFlags = ucTCPFlags;
+                }
+
+                #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+                    #if ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 )
+                        if( ( uxNetworkInterfaceGetCapabilities() & ipNETWORK_CAPABILITY_TX_CHECKSUM ) == 0U )
+                    #endif
+                    {
+                        pxTCPPacket->xIPHeader.usHeaderChecksum = 0x00U;
+                        pxTCPPacket->xIPHeader.usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxTCPPacket->xIPHeader.ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER );
+                        pxTCPPacket->xIPHeader.usHeaderChecksum = ~FreeRTOS_htons( pxTCPPacket->xIPHeader.usHeaderChecksum );
+
+                        ( void ) usGenerateProtocolChecksum( pxSegment->pucEthernetBuffer, pxSegment->xDataLength, pdTRUE );
+                    }
+                #endif
+
+                #if ( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 )
+                    {
+                        if( pxSegment->xDataLength < ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES )
+                        {
+                            ( void ) memset( &( pxSegment->pucEthernetBuffer[ pxSegment->xDataLength ] ), 0, ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES - pxSegment->xDataLength );
+                            pxSegment->xDataLength = ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES;
+                        }
+                    }
+                #endif
+
+                iptraceNETWORK_INTERFACE_OUTPUT( pxSegment->xDataLength, pxSegment->pucEthernetBuffer );
+                ( void ) xNetworkInterfaceOutput( pxSegment, xSegmentRelease );
+
+                usIndex++;
+            }
+
+            if( xReleaseAfterSend != pdFALSE )
+            {
+                vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+            }
+            else
+            {
+                /* Restore the flags of the headers, which may be used again. */
+                pxLargePacket->xTCPHeader.ucTCPFlags = ucTCPFlags;
+            }
+        }
+    #endif /* ipconfigUSE_TCP_SEGMENTATION_OFFLOAD */
+    /*-----------------------------------------------------------*/
+
 
 /**
  * @brief The API FreeRTOS_send() adds data to the TX stream. Add
@@ -1318,6 +1666,7 @@
 
         #if ( ipconfigUSE_TCP_WIN == 1 )
             int32_t lMinLength;
+            BaseType_t xDelayAck = pdFALSE;
         #endif
 
         /* Set the time-out field, so that we'll be called by the IP-task in case no
@@ -1334,11 +1683,32 @@
                  * an ACK to gain performance. */
                 /* lint e9007 is OK because 'uxIPHeaderSizeSocket()' has no side-effects. */
                 if( ( ulReceiveLength > 0U ) &&                               /* Data was sent to this socket. */
-                    ( lRxSpace >= lMinLength ) &&                             /* There is Rx space for more data. */
                     ( pxSocket->u.xTCP.bits.bFinSent == pdFALSE_UNSIGNED ) && /* Not in a closure phase. */
                     ( xSendLength == xSizeWithoutData ) &&                    /* No Tx data or options to be sent. */
                     ( pxSocket->u.xTCP.eTCPState == eESTABLISHED ) &&         /* Connection established. */
                     ( pxTCPHeader->ucTCPFlags == tcpTCP_FLAG_ACK ) )          /* There are no other flags than an ACK. */
+                {
+                    if( lRxSpace >= lMinLength ) /* There is Rx space for more data. */
+                    {
+                        xDelayAck = pdTRUE;
+                    }
+
+                    #if ( ipconfigIP_RX_BURST_LENGTH > 1 )
+                        {
+                            /* When more packets of a burst follow, a single ACK
+                             * will be sent after the last one.  The socket is
+                             * registered even when the ACK may be delayed anyway,
+                             * so that every socket gets its ACK at the end of
+                             * the burst. */
+                            if( xTCPRxBurstDeferAck( pxSocket ) != pdFALSE )
+                            {
+                                xDelayAck = pdTRUE;
+                            }
+                        }
+                    #endif /* ipconfigIP_RX_BURST_LENGTH > 1 */
+                }
+
+                if( xDelayAck != pdFALSE )
                 {
                     uint32_t ulCurMSS = ( uint32_t ) pxSocket->u.xTCP.usMSS;
 
@@ -1884,6 +1884,81 @@
     #endif /* ipconfigUSE_TCP_WIN == 1 */
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+
+/**
+ * @brief See if the next call to ulTCPWindowTxGet() will return new data that
+ *        starts at a given sequence number.  Used to add more segments to a
+ *        large send: that is only possible as long as no segment must be
+ *        retransmitted first.
+ *
+ * @param[in] pxWindow: The descriptor of the TCP sliding windows.
+ * @param[in] ulWindowSize: The current size of the sliding RX window of the peer.
+ * @param[in] ulSequenceNumber: The sequence number that the data must start with.
+ *
+ * @return pdTRUE if ulTCPWindowTxGet() will return the data, else pdFALSE.
+ */
+        BaseType_t xTCPWindowTxHasFollowing( TCPWindow_t const * pxWindow,
+                                             uint32_t ulWindowSize,
+                                             uint32_t ulSequenceNumber )
+        {
+            TCPSegment_t const * pxSegment;
+            BaseType_t xReturn = pdTRUE;
+
+            if( listLIST_IS_EMPTY( &pxWindow->xPriorityQueue ) == pdFALSE )
+            {
+                /* Priority segments are sent first. */
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                pxSegment = xTCPWindowPeekHead( &( pxWindow->xWaitQueue ) );
+
+                if( pxSegment != NULL )
+                {
+                    uint32_t ulMaxTime;
+
+                    /* The same test as in pxTCPWindowTx_GetWaitQueue(): a segment
+                     * of which the timer has expired is retransmitted first. */
+                    ulMaxTime = ( ( uint32_t ) 1U ) << pxSegment->u.bits.ucTransmitCount;
+                    ulMaxTime *= ( uint32_t ) pxWindow->lSRTT;
+
+                    if( ulTimerGetAge( &pxSegment->xTransmitTimer ) > ulMaxTime )
+                    {
+                        xReturn = pdFALSE;
+                    }
+                }
+            }
+
+            if( xReturn != pdFALSE )
+            {
+                /* The same tests as in pxTCPWindowTx_GetTXQueue(). */
+                pxSegment = xTCPWindowPeekHead( &( pxWindow->xTxQueue ) );
+
+                if( ( pxSegment == NULL ) || ( pxSegment->ulSequenceNumber != ulSequenceNumber ) )
+                {
+                    xReturn = pdFALSE;
+                }
+                else if( ( pxWindow->u.bits.bSendFullSize != pdFALSE_UNSIGNED ) &&
+                         ( pxSegment->lDataLength < pxSegment->lMaxLength ) )
+                {
+                    xReturn = pdFALSE;
+                }
+                else if( prvTCPWindowTxHasSpace( pxWindow, ulWindowSize ) == pdFALSE )
+                {
+                    xReturn = pdFALSE;
+                }
+                else
+                {
+                    /* ulTCPWindowTxGet() will return this segment. */
+                }
+            }
+
+            return xReturn;
+        }
+    #endif /* ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 ) */
+/*-----------------------------------------------------------*/
+
     #if ( ipconfigUSE_TCP_WIN == 1 )
 
 /**
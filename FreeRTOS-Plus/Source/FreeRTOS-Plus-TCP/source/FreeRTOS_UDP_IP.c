@@ -226,6 +226,11 @@ void vProcessGeneratedUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuff
             #endif
 
             #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+                #if ( ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD != 0 )
+                    /* Leave the checksums to the network interface if it can
+                     * set them. */
+                    if( ( uxNetworkInterfaceGetCapabilities() & ipNETWORK_CAPABILITY_TX_CHECKSUM ) == 0U )
+                #endif
                 {
                     pxIPHeader->usHeaderChecksum = 0U;
                     pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER );
@@ -426,6 +431,12 @@ BaseType_t xProcessReceivedUDPPacket( NetworkBufferDescriptor_t * pxNetworkBuffe
                     {
                         if( ( pxSocket->pxSocketSet != NULL ) && ( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_READ ) ) != 0U ) )
                         {
+                            #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+                                {
+                                    vSocketSelectMarkReady( pxSocket );
+                                }
+                            #endif /* ipconfigUSE_SOCKET_READY_LIST */
+
                             ( void ) xEventGroupSetBits( pxSocket->pxSocketSet->xSelectGroup, ( EventBits_t ) eSELECT_READ );
                         }
                     }
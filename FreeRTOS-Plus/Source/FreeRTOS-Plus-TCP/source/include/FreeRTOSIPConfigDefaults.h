@@ -416,6 +416,22 @@
     #define ipconfigUSE_LINKED_RX_MESSAGES    0
 #endif
 
+/* The maximum number of 'eNetworkRxEvent' messages that the IP-task handles
+ * in a row, as one burst, before it checks its timers again.  After the first
+ * message, the IP-task only continues while the next message in its queue is
+ * also a received packet, so other events keep their order.
+ * TCP acknowledgements that would be sent immediately for each packet of a
+ * burst are held back and sent once per socket, when the burst is over.
+ * The default of 1 handles one message per pass, as before.
+ */
+#ifndef ipconfigIP_RX_BURST_LENGTH
+    #define ipconfigIP_RX_BURST_LENGTH    1U
+#endif
+
+#if ( ipconfigIP_RX_BURST_LENGTH < 1U )
+    #error ipconfigIP_RX_BURST_LENGTH must be at least 1
+#endif
+
 /* 'ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS' is an important macro: it
  * determines the number of network buffers that are available in the
  * entire application.
@@ -924,6 +940,27 @@
     #define ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM    0
 #endif
 
+/* TCP only: when 'ipconfigUSE_TCP_SEGMENTATION_OFFLOAD' is defined as 1, a TCP
+ * socket that has several full-sized segments ready to be sent passes them to
+ * the network interface in a single large network buffer: one header,
+ * followed by the data of all segments.  The field 'usSegmentSize' of the
+ * descriptor holds the size of each segment.  When the network interface
+ * reports ipNETWORK_CAPABILITY_TCP_SEGMENTATION from
+ * uxNetworkInterfaceGetCapabilities(), it receives the large buffer and must
+ * split it into segments itself, normally in hardware.  Otherwise the IP-task
+ * splits it in software, which still saves the work of preparing every
+ * segment separately.
+ * Large buffers are only used together with BufferAllocation_2.c, and the
+ * network interface must define uxNetworkInterfaceGetCapabilities().
+ */
+#ifndef ipconfigUSE_TCP_SEGMENTATION_OFFLOAD
+    #define ipconfigUSE_TCP_SEGMENTATION_OFFLOAD    0
+#endif
+
+#if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 ) && ( ( ipconfigUSE_TCP == 0 ) || ( ipconfigUSE_TCP_WIN == 0 ) )
+    #error ipconfigUSE_TCP_SEGMENTATION_OFFLOAD requires ipconfigUSE_TCP_WIN
+#endif
+
 /* When ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM is enabled,
  * the network interface is responsible for checking the checksums
  * of the incoming packets.
@@ -934,6 +971,34 @@
     #define ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM    0
 #endif
 
+/* When 'ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD' is defined as 1, the stack asks
+ * the network interface which checksums it handles, by calling
+ * uxNetworkInterfaceGetCapabilities() for every packet.  When it reports
+ * ipNETWORK_CAPABILITY_TX_CHECKSUM, the stack leaves the checksums of outgoing
+ * packets to the interface.  When it reports ipNETWORK_CAPABILITY_RX_CHECKSUM,
+ * the stack does not check the checksums of incoming packets, only their
+ * length fields.  So a driver can decide at run-time, e.g. after it has found
+ * out what the hardware supports, and for each direction.
+ * The option has no effect on a direction for which
+ * ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM or
+ * ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM is already defined as 1.
+ */
+#ifndef ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD
+    #define ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD    0
+#endif
+
+/* When 'ipconfigUSE_64BIT_CHECKSUM' is defined as 1, usGenerateChecksum()
+ * adds the data as 32-bit words to a 64-bit sum.  The carries collect in the
+ * upper half of the sum, so the loop does not have to test for them after
+ * every addition.  It is faster on CPUs that have 64-bit registers, or that
+ * can add with carry, and compilers for hosted platforms can vectorise it.
+ * The default 32-bit version is better for small 8- and 16-bit CPUs.  Both
+ * return the same results.
+ */
+#ifndef ipconfigUSE_64BIT_CHECKSUM
+    #define ipconfigUSE_64BIT_CHECKSUM    0
+#endif
+
 /* The macro 'ipconfigSOCKET_HAS_USER_SEMAPHORE' is rarely used, yet it
  * can be very useful.  IT applies to both TCP and UDP sockets.
  *
@@ -982,6 +1047,24 @@
     #define ipconfigSELECT_USES_NOTIFY    0
 #endif
 
+/* When 'ipconfigUSE_SOCKET_READY_LIST' is defined as 1, every socket set keeps
+ * a list of its sockets that may be ready.  A socket puts itself on that list
+ * as soon as the IP-task wakes up its owner, so vSocketSelect() only looks at
+ * those sockets instead of walking through all bound sockets.  The function
+ * FreeRTOS_select_ready() returns the ready sockets themselves, so that the
+ * application does not have to test every member with FreeRTOS_FD_ISSET().
+ * Readiness is level-triggered: a socket stays in the list for as long as
+ * the condition that it is waiting for is true.
+ * Recommended when a single task serves many sockets with FreeRTOS_select().
+ */
+#ifndef ipconfigUSE_SOCKET_READY_LIST
+    #define ipconfigUSE_SOCKET_READY_LIST    0
+#endif
+
+#if ( ipconfigUSE_SOCKET_READY_LIST != 0 ) && ( ipconfigSUPPORT_SELECT_FUNCTION != 1 )
+    #error ipconfigUSE_SOCKET_READY_LIST requires ipconfigSUPPORT_SELECT_FUNCTION
+#endif
+
 /* TCP only: if the 'ipconfigTCP_KEEP_ALIVE' macro is defined as 1,
  * sockets in state "ESTABLISHED" can be protected using keep-alive packets.
  * These packets will be sent as soon as there hasn't been any activity
@@ -1034,6 +1117,28 @@
     #define ipconfigTCP_HANG_PROTECTION_TIME    30U
 #endif
 
+/* TCP only: when 'ipconfigUSE_TCP_HASH_TABLE' is defined as 1, the IP-task
+ * finds the socket for an incoming segment through two hash tables instead of
+ * walking through all bound TCP sockets.  Sockets that were created by a
+ * listening socket for a new connection are hashed on their local port, remote
+ * IP address and remote port.  All other TCP sockets, among which the listening
+ * ones, are hashed on their local port only.
+ * Recommended for servers that keep many connections open at the same time.
+ */
+#ifndef ipconfigUSE_TCP_HASH_TABLE
+    #define ipconfigUSE_TCP_HASH_TABLE    0
+#endif
+
+/* The number of buckets in each of the two TCP hash tables.  Every bucket costs
+ * one pointer.  The value must be a power of 2, and at least 2. */
+#ifndef ipconfigTCP_HASH_TABLE_SIZE
+    #define ipconfigTCP_HASH_TABLE_SIZE    64U
+#endif
+
+#if ( ( ipconfigTCP_HASH_TABLE_SIZE & ( ipconfigTCP_HASH_TABLE_SIZE - 1U ) ) != 0U ) || ( ipconfigTCP_HASH_TABLE_SIZE < 2U )
+    #error ipconfigTCP_HASH_TABLE_SIZE must be a power of 2, and at least 2
+#endif
+
 /* Initially, 'ipconfigTCP_IP_SANITY' was introduced to include all code that checks
  * the correctness of the algorithms.  However, it is only used in BufferAllocation_1.c
  * When defined as non-zero, some extra code will check the validity of network buffers.
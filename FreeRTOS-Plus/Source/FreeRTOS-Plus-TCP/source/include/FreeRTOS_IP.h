@@ -167,6 +167,9 @@ typedef struct xNETWORK_BUFFER
     size_t xDataLength;                        /**< Starts by holding the total Ethernet frame length, then the UDP/TCP payload length. */
     uint16_t usPort;                           /**< Source or destination port, depending on usage scenario. */
     uint16_t usBoundPort;                      /**< The port to which a transmitting socket is bound. */
+    #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+        uint16_t usSegmentSize;                /**< Non-zero for a large TCP send: the amount of data in each segment. */
+    #endif
     #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
         struct xNETWORK_BUFFER * pxNextBuffer; /**< Possible optimisation for expert users - requires network driver support. */
     #endif
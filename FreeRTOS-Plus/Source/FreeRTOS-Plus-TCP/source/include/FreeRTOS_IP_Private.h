@@ -466,6 +466,14 @@ uint16_t usGenerateChecksum( uint16_t usSum,
                              const uint8_t * pucNextData,
                              size_t uxByteCount );
 
+/*
+ * Return the checksum after a 16-bit word that it covers has changed from
+ * usOldValue to usNewValue.
+ */
+uint16_t usChecksumUpdate( uint16_t usChecksum,
+                           uint16_t usOldValue,
+                           uint16_t usNewValue );
+
 /* Socket related private functions. */
 
 /*
@@ -568,6 +576,7 @@ BaseType_t xIPIsNetworkTaskReady( void );
                 bFinLast : 1,          /**< The last ACK (after FIN and FIN+ACK) has been sent or will be sent by the peer */
                 bRxStopped : 1,        /**< Application asked to temporarily stop reception */
                 bMallocError : 1,      /**< There was an error allocating a stream */
+                bRxBurstAck : 1,       /**< An ACK is held back until the IP-task has handled a burst of received packets */
                 bWinScaling : 1;       /**< A TCP-Window Scaling option was offered and accepted in the SYN phase. */
         } bits;                        /**< The bits structure */
         uint32_t ulHighestRxAllowed;   /**< The highest sequence number that we can receive at any moment */
@@ -580,6 +589,10 @@ BaseType_t xIPIsNetworkTaskReady( void );
                                         * TCP win segments */
         eIPTCPState_t eTCPState;       /**< TCP state: see eTCP_STATE */
         struct xSOCKET * pxPeerSocket; /**< for server socket: child, for child socket: parent */
+        #if ( ipconfigUSE_TCP_HASH_TABLE == 1 )
+            struct xSOCKET * pxHashNext;     /**< The next socket in the same hash bucket */
+            struct xSOCKET ** ppxHashBucket; /**< The hash bucket that holds this socket, or NULL */
+        #endif /* ipconfigUSE_TCP_HASH_TABLE */
         #if ( ipconfigTCP_KEEP_ALIVE == 1 )
             uint8_t ucKeepRepCount;
             TickType_t xLastAliveTime; /**< The last value of keepalive time.*/
@@ -679,6 +692,9 @@ typedef struct xSOCKET
 
         EventBits_t xSocketBits;          /**< These bits indicate the events which have actually occurred.
                                            * They are maintained by the IP-task */
+        #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+            ListItem_t xSelectListItem; /**< Used to reference the socket from the ready list of its socket set. */
+        #endif /* ipconfigUSE_SOCKET_READY_LIST */
     #endif /* ipconfigSUPPORT_SELECT_FUNCTION */
     /* TCP/UDP specific fields: */
     /* Before accessing any member of this structure, it should be confirmed */
@@ -717,6 +733,38 @@ typedef struct xSOCKET
                                            uint32_t ulRemoteIP,
                                            UBaseType_t uxRemotePort );
 
+    #if ( ipconfigUSE_TCP_HASH_TABLE == 1 )
+
+/*
+ * Store a socket that was just created by a listening socket in the connection
+ * hash table, now that its remote IP address and port are known.
+ */
+        void vTCPSocketHashConnection( FreeRTOS_Socket_t * pxSocket );
+    #endif /* ipconfigUSE_TCP_HASH_TABLE */
+
+    #if ( ipconfigIP_RX_BURST_LENGTH > 1 )
+
+/*
+ * Called by the IP-task before and after it handles a burst of received
+ * packets.  In between, the acknowledgements that would be sent immediately
+ * are held back, and vTCPRxBurstEnd() sends them, once for each socket.
+ */
+        void vTCPRxBurstStart( void );
+
+        void vTCPRxBurstEnd( void );
+
+/*
+ * Hold back the acknowledgement of a socket until the end of the current
+ * burst.  Returns pdFALSE when it must be sent now.
+ */
+        BaseType_t xTCPRxBurstDeferAck( FreeRTOS_Socket_t * pxSocket );
+
+/*
+ * Forget a socket that gets closed while its acknowledgement is held back.
+ */
+        void vTCPRxBurstRemoveSocket( FreeRTOS_Socket_t * pxSocket );
+    #endif /* ipconfigIP_RX_BURST_LENGTH > 1 */
+
 #endif /* ipconfigUSE_TCP */
 
 
@@ -832,10 +880,20 @@ BaseType_t xIsCallingFromIPTask( void );
         /** @brief Event group for the socket select function.
          */
         EventGroupHandle_t xSelectGroup;
+        #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+            /** @brief The sockets of this set which may be ready, see ipconfigUSE_SOCKET_READY_LIST.
+             */
+            List_t xReadyList;
+        #endif /* ipconfigUSE_SOCKET_READY_LIST */
     } SocketSelect_t;
 
     extern void vSocketSelect( const SocketSelect_t * pxSocketSet );
 
+    #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+        /* Put a socket on the ready list of its socket set. */
+        void vSocketSelectMarkReady( FreeRTOS_Socket_t * pxSocket );
+    #endif /* ipconfigUSE_SOCKET_READY_LIST */
+
 /** @brief Define the data that must be passed for a 'eSocketSelectEvent'. */
     typedef struct xSocketSelectMessage
     {
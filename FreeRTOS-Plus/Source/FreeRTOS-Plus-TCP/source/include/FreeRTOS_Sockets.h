@@ -542,6 +542,16 @@
         EventBits_t FreeRTOS_FD_ISSET( const ConstSocket_t xSocket,
                                        const ConstSocketSet_t xSocketSet );
 
+        #if ( ipconfigUSE_SOCKET_READY_LIST == 1 )
+
+/* Block on a "socket set" until at least one of its sockets is ready, and
+ * store up to 'xMaxSockets' of the ready sockets in 'pxReadySockets'. */
+            BaseType_t FreeRTOS_select_ready( SocketSet_t xSocketSet,
+                                              Socket_t * pxReadySockets,
+                                              BaseType_t xMaxSockets,
+                                              TickType_t xBlockTimeTicks );
+        #endif /* ( ipconfigUSE_SOCKET_READY_LIST == 1 ) */
+
     #endif /* ( ipconfigSUPPORT_SELECT_FUNCTION == 1 ) */
 
     #ifdef __cplusplus
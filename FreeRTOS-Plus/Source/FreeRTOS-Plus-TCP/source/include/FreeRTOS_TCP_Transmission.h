@@ -115,6 +115,25 @@ NetworkBufferDescriptor_t * prvTCPBufferResize( const FreeRTOS_Socket_t * pxSock
                                                 NetworkBufferDescriptor_t * pxNetworkBuffer,
                                                 int32_t lDataLen,
                                                 UBaseType_t uxOptionsLength );
+
+#if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+
+/*
+ * Prepare an outgoing message as prvTCPPrepareSend() does, and add the segments
+ * that follow to the same network buffer, to be sent as one large send.
+ */
+    int32_t prvTCPPrepareLargeSend( FreeRTOS_Socket_t * pxSocket,
+                                    NetworkBufferDescriptor_t ** ppxNetworkBuffer,
+                                    UBaseType_t uxOptionsLength,
+                                    UBaseType_t * puxSegmentCount );
+
+/*
+ * Split a large send into segments, for a network interface that can not do it.
+ */
+    void prvTCPSendSegmented( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                              BaseType_t xReleaseAfterSend );
+#endif /* ipconfigUSE_TCP_SEGMENTATION_OFFLOAD */
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     } /* extern "C" */
@@ -214,6 +214,13 @@ uint32_t ulTCPWindowTxGet( TCPWindow_t * pxWindow,
                            uint32_t ulWindowSize,
                            int32_t * plPosition );
 
+/* See if the next data to be sent is new data that starts at ulSequenceNumber,
+ * so it can be added to a large send.  The following function is defined only
+ * when ipconfigUSE_TCP_SEGMENTATION_OFFLOAD is enabled. */
+BaseType_t xTCPWindowTxHasFollowing( TCPWindow_t const * pxWindow,
+                                     uint32_t ulWindowSize,
+                                     uint32_t ulSequenceNumber );
+
 /* Receive a normal ACK */
 uint32_t ulTCPWindowTxAck( TCPWindow_t * pxWindow,
                            uint32_t ulSequenceNumber );
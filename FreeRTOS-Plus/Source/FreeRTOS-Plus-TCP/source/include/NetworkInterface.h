@@ -45,6 +45,30 @@ void vNetworkInterfaceAllocateRAMToBuffers( NetworkBufferDescriptor_t pxNetworkB
 /* The following function is defined only when BufferAllocation_1.c is linked in the project. */
 BaseType_t xGetPhyLinkStatus( void );
 
+/* Bits returned by uxNetworkInterfaceGetCapabilities(). */
+
+/* xNetworkInterfaceOutput() accepts TCP packets that are larger than the MTU,
+ * and splits them into segments of 'usSegmentSize' bytes of data.  Each segment
+ * gets a copy of the headers, with its own IP length, IP identification
+ * (incremented per segment), TCP sequence number and checksums.  Only the last
+ * segment keeps the FIN flag. */
+#define ipNETWORK_CAPABILITY_TCP_SEGMENTATION    ( 0x0001U )
+
+/* xNetworkInterfaceOutput() sets the IP header checksum and the TCP, UDP or
+ * ICMP checksum of every outgoing packet. */
+#define ipNETWORK_CAPABILITY_TX_CHECKSUM    ( 0x0002U )
+
+/* The network interface has checked the IP header checksum and the TCP, UDP or
+ * ICMP checksum of every packet that it passes to the IP-task, and has dropped
+ * the packets in which they were wrong. */
+#define ipNETWORK_CAPABILITY_RX_CHECKSUM    ( 0x0004U )
+
+/* Return the ipNETWORK_CAPABILITY_... bits of the features that the network
+ * interface offers.  The following function needs to be defined only when
+ * ipconfigUSE_TCP_SEGMENTATION_OFFLOAD or ipconfigUSE_RUNTIME_CHECKSUM_OFFLOAD
+ * is enabled. */
+UBaseType_t uxNetworkInterfaceGetCapabilities( void );
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     } /* extern "C" */
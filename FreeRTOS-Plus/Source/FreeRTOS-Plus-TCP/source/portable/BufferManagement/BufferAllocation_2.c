@@ -312,6 +312,13 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
                             pxReturn->pxNextBuffer = NULL;
                         }
                     #endif /* ipconfigUSE_LINKED_RX_MESSAGES */
+
+                    #if ( ipconfigUSE_TCP_SEGMENTATION_OFFLOAD != 0 )
+                        {
+                            /* A normal frame, not a large TCP send. */
+                            pxReturn->usSegmentSize = 0U;
+                        }
+                    #endif /* ipconfigUSE_TCP_SEGMENTATION_OFFLOAD */
                 }
             }
             else
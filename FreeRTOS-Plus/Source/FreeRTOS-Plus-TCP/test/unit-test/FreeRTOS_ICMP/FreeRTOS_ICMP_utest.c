@@ -115,10 +115,17 @@ void test_ProcessICMPPacket_EchoRequest( void )
     pxIPHeader = &( pxICMPPacket->xIPHeader );
 
     pxICMPPacket->xICMPHeader.ucTypeOfMessage = ipICMP_ECHO_REQUEST;
+    pxICMPPacket->xICMPHeader.ucTypeOfService = 0x12;
+    pxICMPPacket->xICMPHeader.usChecksum = 0x1234;
 
     usGenerateChecksum_ExpectAnyArgsAndReturn( 0xAA );
 
-    usGenerateProtocolChecksum_ExpectAnyArgsAndReturn( 0 );
+    /* Only the message type changes, so the ICMP checksum is updated rather
+     * than calculated again. */
+    usChecksumUpdate_ExpectAndReturn( 0x1234,
+                                      FreeRTOS_htons( ( ipICMP_ECHO_REQUEST << 8 ) | 0x12 ),
+                                      FreeRTOS_htons( ( ipICMP_ECHO_REPLY << 8 ) | 0x12 ),
+                                      0x5678 );
 
     eResult = ProcessICMPPacket( pxNetworkBuffer );
 
@@ -129,6 +136,7 @@ void test_ProcessICMPPacket_EchoRequest( void )
     TEST_ASSERT_EQUAL( ipconfigICMP_TIME_TO_LIVE, pxIPHeader->ucTimeToLive );
     TEST_ASSERT_EQUAL( 0, pxIPHeader->usFragmentOffset );
     TEST_ASSERT_EQUAL( ( uint16_t ) ~FreeRTOS_htons( 0xAA ), pxIPHeader->usHeaderChecksum );
+    TEST_ASSERT_EQUAL( 0x5678, pxICMPHeader->usChecksum );
 }
 
 void test_ProcessICMPPacket_UnknownICMPPacket( void )
@@ -0,0 +1,219 @@
+/*
+ * FreeRTOS+TCP V3.1.0
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_IP_ChecksumOffload_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_TCP_IP.h"
+#include "mock_FreeRTOS_ICMP.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+#include "mock_FreeRTOS_DHCP.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_DNS.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_UDP_IP.h"
+
+#include "FreeRTOS_IP.h"
+
+#include "FreeRTOS_IP_stubs.c"
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+void prvIPTask( void * pvParameters );
+void prvProcessIPEventsAndTimers( void );
+eFrameProcessingResult_t prvProcessIPPacket( IPPacket_t * pxIPPacket,
+                                             NetworkBufferDescriptor_t * const pxNetworkBuffer );
+void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetworkBuffer );
+eFrameProcessingResult_t prvAllowIPPacket( const IPPacket_t * const pxIPPacket,
+                                           const NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                           UBaseType_t uxHeaderLength );
+
+/*
+ * Fill in a packet that passes the address checks of prvAllowIPPacket(), for
+ * a UDP or TCP header without data.
+ */
+static IPPacket_t * prvPreparePacket( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                      uint8_t ucProtocol )
+{
+    IPPacket_t * pxIPPacket;
+    IPHeader_t * pxIPHeader;
+    size_t uxProtocolHeaderLength = ( ucProtocol == ipPROTOCOL_UDP ) ? sizeof( UDPHeader_t ) : ipSIZE_OF_TCP_HEADER;
+
+    memset( pxNetworkBuffer->pucEthernetBuffer, 0, ipconfigTCP_MSS );
+
+    pxNetworkBuffer->xDataLength = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + uxProtocolHeaderLength;
+    pxIPPacket = ( IPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer;
+    pxIPHeader = &( pxIPPacket->xIPHeader );
+
+    *ipLOCAL_IP_ADDRESS_POINTER = 0xFFFFFFFF;
+
+    pxIPHeader->ucVersionHeaderLength = 0x45;
+    pxIPHeader->ulDestinationIPAddress = *ipLOCAL_IP_ADDRESS_POINTER;
+    pxIPHeader->ucProtocol = ucProtocol;
+    pxIPHeader->usLength = FreeRTOS_htons( ipSIZE_OF_IPv4_HEADER + uxProtocolHeaderLength );
+    pxIPHeader->ulSourceIPAddress = 0xC0C00101;
+
+    memcpy( pxIPPacket->xEthernetHeader.xDestinationAddress.ucBytes, xBroadcastMACAddress.ucBytes, sizeof( MACAddress_t ) );
+
+    return pxIPPacket;
+}
+
+void test_prvAllowIPPacket_NoOffload_ChecksumsCorrect( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket;
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthBuffer;
+    pxIPPacket = prvPreparePacket( &xNetworkBuffer, ipPROTOCOL_TCP );
+
+    uxNetworkInterfaceGetCapabilities_ExpectAndReturn( 0U );
+    usGenerateChecksum_ExpectAndReturn( 0U, ( uint8_t * ) &( pxIPPacket->xIPHeader.ucVersionHeaderLength ), ipSIZE_OF_IPv4_HEADER, ipCORRECT_CRC );
+    usGenerateProtocolChecksum_ExpectAndReturn( ucEthBuffer, xNetworkBuffer.xDataLength, pdFALSE, ipCORRECT_CRC );
+
+    eResult = prvAllowIPPacket( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eProcessBuffer, eResult );
+}
+
+void test_prvAllowIPPacket_NoOffload_IncorrectIPChecksum( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket;
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthBuffer;
+    pxIPPacket = prvPreparePacket( &xNetworkBuffer, ipPROTOCOL_TCP );
+
+    /* Only the transmit checksums are offloaded. */
+    uxNetworkInterfaceGetCapabilities_ExpectAndReturn( ipNETWORK_CAPABILITY_TX_CHECKSUM );
+    usGenerateChecksum_ExpectAnyArgsAndReturn( ipCORRECT_CRC - 1U );
+
+    eResult = prvAllowIPPacket( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eResult );
+}
+
+void test_prvAllowIPPacket_Offload_TCP_HappyPath( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket;
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthBuffer;
+    pxIPPacket = prvPreparePacket( &xNetworkBuffer, ipPROTOCOL_TCP );
+
+    /* No checksum is calculated. */
+    uxNetworkInterfaceGetCapabilities_ExpectAndReturn( ipNETWORK_CAPABILITY_RX_CHECKSUM );
+
+    eResult = prvAllowIPPacket( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eProcessBuffer, eResult );
+}
+
+void test_prvAllowIPPacket_Offload_IncorrectSizeFields( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket;
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthBuffer;
+    pxIPPacket = prvPreparePacket( &xNetworkBuffer, ipPROTOCOL_TCP );
+
+    /* The IP length is more than was received. */
+    pxIPPacket->xIPHeader.usLength = FreeRTOS_htons( ipconfigNETWORK_MTU );
+
+    uxNetworkInterfaceGetCapabilities_ExpectAndReturn( ipNETWORK_CAPABILITY_RX_CHECKSUM );
+
+    eResult = prvAllowIPPacket( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eResult );
+}
+
+void test_prvAllowIPPacket_Offload_UDPCheckSumZero( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket;
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthBuffer;
+    pxIPPacket = prvPreparePacket( &xNetworkBuffer, ipPROTOCOL_UDP );
+
+    uxNetworkInterfaceGetCapabilities_ExpectAndReturn( ipNETWORK_CAPABILITY_RX_CHECKSUM | ipNETWORK_CAPABILITY_TX_CHECKSUM );
+
+    eResult = prvAllowIPPacket( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eResult );
+}
+
+void test_prvAllowIPPacket_Offload_UDP_HappyPath( void )
+{
+    eFrameProcessingResult_t eResult;
+    IPPacket_t * pxIPPacket;
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    ProtocolPacket_t * pxProtPack;
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthBuffer;
+    pxIPPacket = prvPreparePacket( &xNetworkBuffer, ipPROTOCOL_UDP );
+
+    pxProtPack = ( ProtocolPacket_t * ) ucEthBuffer;
+    pxProtPack->xUDPPacket.xUDPHeader.usChecksum = 0xFF12;
+
+    uxNetworkInterfaceGetCapabilities_ExpectAndReturn( ipNETWORK_CAPABILITY_RX_CHECKSUM );
+
+    eResult = prvAllowIPPacket( pxIPPacket, &xNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( eProcessBuffer, eResult );
+}
@@ -1340,6 +1340,64 @@ void test_usGenerateChecksum_FourByteAllignedSumOverflow2( void )
     TEST_ASSERT_EQUAL( 21759, usResult );
 }
 
+void test_usChecksumUpdate_SameAsNewChecksum( void )
+{
+    uint16_t usHeader[ ipSIZE_OF_IPv4_HEADER / 2U ] = { 0x4500, 0x0054, 0x1c46, 0x4000, 0x4001, 0x0000, 0xc0a8, 0x0001, 0xc0a8, 0x00c7 };
+    uint16_t usOldValue, usUpdated;
+
+    usHeader[ 5 ] = ~FreeRTOS_htons( usGenerateChecksum( 0U, ( uint8_t * ) usHeader, ipSIZE_OF_IPv4_HEADER ) );
+
+    /* Decrement the TTL. */
+    usOldValue = usHeader[ 4 ];
+    ( ( uint8_t * ) usHeader )[ 8 ]--;
+
+    usUpdated = usChecksumUpdate( usHeader[ 5 ], usOldValue, usHeader[ 4 ] );
+
+    usHeader[ 5 ] = 0U;
+    TEST_ASSERT_EQUAL( ( uint16_t ) ~FreeRTOS_htons( usGenerateChecksum( 0U, ( uint8_t * ) usHeader, ipSIZE_OF_IPv4_HEADER ) ), usUpdated );
+}
+
+void test_usChecksumUpdate_32BitField( void )
+{
+    uint16_t usHeader[ ipSIZE_OF_IPv4_HEADER / 2U ] = { 0x4500, 0x0054, 0x1c46, 0x4000, 0x4001, 0x0000, 0xc0a8, 0x0001, 0xc0a8, 0x00c7 };
+    uint16_t usChecksum, usOldHigh, usOldLow;
+    uint32_t ulNewAddress = 0xFFFFFFFEU;
+
+    usHeader[ 5 ] = ~FreeRTOS_htons( usGenerateChecksum( 0U, ( uint8_t * ) usHeader, ipSIZE_OF_IPv4_HEADER ) );
+
+    /* Replace the destination address, then update the checksum for each
+     * half. */
+    usOldHigh = usHeader[ 8 ];
+    usOldLow = usHeader[ 9 ];
+    memcpy( &usHeader[ 8 ], &ulNewAddress, sizeof( ulNewAddress ) );
+
+    usChecksum = usChecksumUpdate( usHeader[ 5 ], usOldHigh, usHeader[ 8 ] );
+    usChecksum = usChecksumUpdate( usChecksum, usOldLow, usHeader[ 9 ] );
+
+    usHeader[ 5 ] = 0U;
+    TEST_ASSERT_EQUAL( ( uint16_t ) ~FreeRTOS_htons( usGenerateChecksum( 0U, ( uint8_t * ) usHeader, ipSIZE_OF_IPv4_HEADER ) ), usChecksum );
+}
+
+void test_usChecksumUpdate_TwoCarries( void )
+{
+    uint16_t usChecksum;
+
+    /* ~0x0000 + ~0x0000 + 0xFFFF overflows twice when the carries are
+     * added. */
+    usChecksum = usChecksumUpdate( 0x0000U, 0x0000U, 0xFFFFU );
+
+    TEST_ASSERT_EQUAL( 0x0000U, usChecksum );
+}
+
+void test_usChecksumUpdate_NoChange( void )
+{
+    uint16_t usChecksum;
+
+    usChecksum = usChecksumUpdate( 0x1234U, 0xABCDU, 0xABCDU );
+
+    TEST_ASSERT_EQUAL( 0x1234U, usChecksum );
+}
+
 void test_vPrintResourceStats_BufferCountMore( void )
 {
     uxGetMinimumFreeNetworkBuffers_ExpectAndReturn( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 2 );
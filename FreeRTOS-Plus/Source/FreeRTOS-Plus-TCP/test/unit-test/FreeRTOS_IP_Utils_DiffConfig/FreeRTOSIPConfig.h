@@ -60,6 +60,9 @@
  * stack repeating the checksum calculations. */
 #define ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM     0
 
+/* Sum the 32-bit words of a checksum in 64-bit sums. */
+#define ipconfigUSE_64BIT_CHECKSUM                 1
+
 /* Several API's will block until the result is known, or the action has been
  * performed, for example FreeRTOS_send() and FreeRTOS_recv().  The timeouts can be
  * set per socket, using setsockopt().  If not set, the times below will be
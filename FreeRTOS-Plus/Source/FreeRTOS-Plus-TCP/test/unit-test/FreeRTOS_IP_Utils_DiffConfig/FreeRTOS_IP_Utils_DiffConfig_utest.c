@@ -149,3 +149,95 @@ void test_vPrintResourceStats_LastQueueNECurrentQueue( void )
     TEST_ASSERT_EQUAL( 10, uxMinLastSize );
     TEST_ASSERT_EQUAL( 10, uxLastMinQueueSpace );
 }
+
+/* A checksum of RFC 1071, summed one byte at a time, in the form returned by
+ * usGenerateChecksum(). */
+static uint16_t prvReferenceChecksum( uint16_t usSum,
+                                      const uint8_t * pucData,
+                                      size_t uxLength )
+{
+    uint32_t ulSum = usSum;
+    size_t uxIndex;
+
+    for( uxIndex = 0; ( uxIndex + 1U ) < uxLength; uxIndex += 2U )
+    {
+        ulSum += ( ( uint32_t ) pucData[ uxIndex ] << 8 ) | pucData[ uxIndex + 1U ];
+    }
+
+    if( ( uxLength & 1U ) != 0U )
+    {
+        ulSum += ( uint32_t ) pucData[ uxLength - 1U ] << 8;
+    }
+
+    while( ( ulSum >> 16 ) != 0U )
+    {
+        ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+    }
+
+    return ( uint16_t ) ulSum;
+}
+
+void test_usGenerateChecksum_64Bit_FourByteAllignedSumOverflow( void )
+{
+    uint16_t usResult;
+    uint16_t usSum = FreeRTOS_htons( 0xFFFF - 0xAB );
+    uint32_t ulNextData[ ipconfigTCP_MSS / sizeof( uint32_t ) ];
+
+    memset( ulNextData, 0xAB, sizeof( ulNextData ) );
+
+    usResult = usGenerateChecksum( usSum, ( uint8_t * ) ulNextData, 20 );
+
+    TEST_ASSERT_EQUAL( 2484, usResult );
+}
+
+void test_usGenerateChecksum_64Bit_FourByteAllignedSumOverflow2( void )
+{
+    uint16_t usResult;
+    uint16_t usSum = FreeRTOS_htons( 0xFFFF - 0xAB );
+    uint32_t ulNextData[ ipconfigTCP_MSS / sizeof( uint32_t ) ];
+
+    memset( ulNextData, 0xFF, sizeof( ulNextData ) );
+
+    usResult = usGenerateChecksum( usSum, ( uint8_t * ) ulNextData, 20 );
+
+    TEST_ASSERT_EQUAL( 21759, usResult );
+}
+
+void test_usGenerateChecksum_64Bit_AllOnes( void )
+{
+    uint16_t usResult;
+    uint32_t ulNextData[ ipconfigTCP_MSS / sizeof( uint32_t ) ];
+
+    /* The largest sums the 64-bit loop can meet. */
+    memset( ulNextData, 0xFF, sizeof( ulNextData ) );
+
+    usResult = usGenerateChecksum( 0xFFFF, ( uint8_t * ) ulNextData, sizeof( ulNextData ) );
+
+    TEST_ASSERT_EQUAL( prvReferenceChecksum( 0xFFFF, ( uint8_t * ) ulNextData, sizeof( ulNextData ) ), usResult );
+}
+
+void test_usGenerateChecksum_64Bit_AllLengthsAndAlignments( void )
+{
+    uint32_t ulNextData[ ( ipconfigTCP_MSS / sizeof( uint32_t ) ) + 2U ];
+    uint8_t * pucNextData = ( uint8_t * ) ulNextData;
+    size_t uxLength, uxOffset, uxIndex;
+    uint16_t usSum = 0x1234;
+
+    for( uxIndex = 0; uxIndex < sizeof( ulNextData ); uxIndex++ )
+    {
+        pucNextData[ uxIndex ] = ( uint8_t ) ( ( uxIndex * 167U ) + 13U );
+    }
+
+    /* Every length around the 8-word blocks, and some longer ones, at every
+     * alignment. */
+    for( uxLength = 0; uxLength <= ipconfigTCP_MSS; uxLength += ( uxLength < 80U ) ? 1U : 37U )
+    {
+        for( uxOffset = 0; uxOffset < sizeof( uint64_t ); uxOffset++ )
+        {
+            usSum = ( uint16_t ) ( ( usSum * 31U ) + 7U );
+
+            TEST_ASSERT_EQUAL( prvReferenceChecksum( usSum, &( pucNextData[ uxOffset ] ), uxLength ),
+                               usGenerateChecksum( usSum, &( pucNextData[ uxOffset ] ), uxLength ) );
+        }
+    }
+}
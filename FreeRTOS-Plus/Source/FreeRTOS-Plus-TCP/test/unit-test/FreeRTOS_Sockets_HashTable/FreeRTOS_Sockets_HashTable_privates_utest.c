@@ -0,0 +1,439 @@
+/*
+ * FreeRTOS+TCP V3.1.0
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_Sockets_HashTable_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_portable.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+#include "mock_FreeRTOS_DHCP.h"
+#include "mock_FreeRTOS_DNS.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_IP_Private.h"
+
+
+#include "catch_assert.h"
+
+#define TEST_LOCAL_PORT     80U
+#define TEST_REMOTE_IP      0xC0A80002U
+#define TEST_SOCKET_COUNT   32U
+
+extern List_t xBoundUDPSocketsList;
+extern List_t xBoundTCPSocketsList;
+
+extern FreeRTOS_Socket_t * pxTCPConnectionTable[ ipconfigTCP_HASH_TABLE_SIZE ];
+extern FreeRTOS_Socket_t * pxTCPPortTable[ ipconfigTCP_HASH_TABLE_SIZE ];
+
+void prvTCPHashRemove( FreeRTOS_Socket_t * pxSocket );
+UBaseType_t prvTCPConnectionHash( UBaseType_t uxLocalPort,
+                                  uint32_t ulRemoteIP,
+                                  UBaseType_t uxRemotePort );
+
+static FreeRTOS_Socket_t xSockets[ TEST_SOCKET_COUNT ];
+
+/* ============================ Unity Fixtures ============================ */
+
+void setUp( void )
+{
+    memset( pxTCPConnectionTable, 0, sizeof( FreeRTOS_Socket_t * ) * ipconfigTCP_HASH_TABLE_SIZE );
+    memset( pxTCPPortTable, 0, sizeof( FreeRTOS_Socket_t * ) * ipconfigTCP_HASH_TABLE_SIZE );
+    memset( xSockets, 0, sizeof( xSockets ) );
+}
+
+/* ======================== Local helper functions ======================== */
+
+/*
+ * @brief Bind a TCP socket the way FreeRTOS_bind() would.
+ */
+static void prvBindTCPSocket( FreeRTOS_Socket_t * pxSocket,
+                              uint16_t usPort,
+                              BaseType_t xInternal )
+{
+    struct freertos_sockaddr xBindAddress;
+    BaseType_t xReturn;
+
+    memset( &xBindAddress, 0, sizeof( xBindAddress ) );
+    xBindAddress.sin_port = FreeRTOS_htons( usPort );
+
+    pxSocket->ucProtocol = ( uint8_t ) FREERTOS_IPPROTO_TCP;
+
+    if( xInternal == pdFALSE )
+    {
+        /* The port is not in use yet. */
+        xIPIsNetworkTaskReady_ExpectAndReturn( pdFALSE );
+    }
+
+    listSET_LIST_ITEM_VALUE_Expect( &( pxSocket->xBoundSocketListItem ), xBindAddress.sin_port );
+    vListInsertEnd_Expect( NULL, &( pxSocket->xBoundSocketListItem ) );
+    vListInsertEnd_IgnoreArg_pxList();
+
+    xReturn = vSocketBind( pxSocket, &xBindAddress, sizeof( xBindAddress ), xInternal );
+
+    TEST_ASSERT_EQUAL( 0, xReturn );
+    TEST_ASSERT_EQUAL( usPort, pxSocket->usLocalPort );
+}
+
+/*
+ * @brief Create a child socket of a listening socket, the way prvHandleListen()
+ *        would.
+ */
+static void prvAcceptTCPSocket( FreeRTOS_Socket_t * pxSocket,
+                                uint16_t usPort,
+                                uint32_t ulRemoteIP,
+                                uint16_t usRemotePort )
+{
+    prvBindTCPSocket( pxSocket, usPort, pdTRUE );
+
+    pxSocket->u.xTCP.eTCPState = eSYN_RECEIVED;
+    pxSocket->u.xTCP.ulRemoteIP = ulRemoteIP;
+    pxSocket->u.xTCP.usRemotePort = usRemotePort;
+
+    vTCPSocketHashConnection( pxSocket );
+}
+
+/* ============================== Test Cases ============================== */
+
+/*
+ * @brief Initialisation also empties both hash tables.
+ */
+void test_vNetworkSocketsInit_ClearsHashTables( void )
+{
+    pxTCPConnectionTable[ 0 ] = &( xSockets[ 0 ] );
+    pxTCPPortTable[ ipconfigTCP_HASH_TABLE_SIZE - 1U ] = &( xSockets[ 1 ] );
+
+    vListInitialise_Expect( &xBoundUDPSocketsList );
+    vListInitialise_Expect( &xBoundTCPSocketsList );
+
+    vNetworkSocketsInit();
+
+    TEST_ASSERT_EQUAL_PTR( NULL, pxTCPConnectionTable[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( NULL, pxTCPPortTable[ ipconfigTCP_HASH_TABLE_SIZE - 1U ] );
+}
+
+/*
+ * @brief A TCP socket bound by the application is stored in the port table.
+ */
+void test_vSocketBind_TCP_StoredInPortTable( void )
+{
+    prvBindTCPSocket( &( xSockets[ 0 ] ), TEST_LOCAL_PORT, pdFALSE );
+
+    TEST_ASSERT_NOT_NULL( xSockets[ 0 ].u.xTCP.ppxHashBucket );
+    TEST_ASSERT_EQUAL_PTR( &( xSockets[ 0 ] ), *( xSockets[ 0 ].u.xTCP.ppxHashBucket ) );
+}
+
+/*
+ * @brief A TCP socket bound internally is not hashed until its peer is known.
+ */
+void test_vSocketBind_TCPInternal_NotHashed( void )
+{
+    UBaseType_t uxIndex;
+
+    prvBindTCPSocket( &( xSockets[ 0 ] ), TEST_LOCAL_PORT, pdTRUE );
+
+    TEST_ASSERT_EQUAL_PTR( NULL, xSockets[ 0 ].u.xTCP.ppxHashBucket );
+
+    for( uxIndex = 0U; uxIndex < ipconfigTCP_HASH_TABLE_SIZE; uxIndex++ )
+    {
+        TEST_ASSERT_EQUAL_PTR( NULL, pxTCPPortTable[ uxIndex ] );
+        TEST_ASSERT_EQUAL_PTR( NULL, pxTCPConnectionTable[ uxIndex ] );
+    }
+}
+
+/*
+ * @brief A UDP socket is never hashed.
+ */
+void test_vSocketBind_UDP_NotHashed( void )
+{
+    struct freertos_sockaddr xBindAddress;
+    BaseType_t xReturn;
+
+    memset( &xBindAddress, 0, sizeof( xBindAddress ) );
+    xBindAddress.sin_port = FreeRTOS_htons( TEST_LOCAL_PORT );
+
+    xSockets[ 0 ].ucProtocol = ( uint8_t ) FREERTOS_IPPROTO_UDP;
+
+    xIPIsNetworkTaskReady_ExpectAndReturn( pdFALSE );
+
+    listSET_LIST_ITEM_VALUE_Expect( &( xSockets[ 0 ].xBoundSocketListItem ), xBindAddress.sin_port );
+    vListInsertEnd_Expect( NULL, &( xSockets[ 0 ].xBoundSocketListItem ) );
+    vListInsertEnd_IgnoreArg_pxList();
+
+    xReturn = vSocketBind( &( xSockets[ 0 ] ), &xBindAddress, sizeof( xBindAddress ), pdFALSE );
+
+    TEST_ASSERT_EQUAL( 0, xReturn );
+    TEST_ASSERT_EQUAL_PTR( NULL, xSockets[ 0 ].u.xTCP.ppxHashBucket );
+}
+
+/*
+ * @brief Every child of a listening socket is found, also when many of them
+ *        share a bucket.
+ */
+void test_pxTCPSocketLookup_ConnectionTable_ManyChildren( void )
+{
+    FreeRTOS_Socket_t * pxListenSocket = &( xSockets[ 0 ] );
+    FreeRTOS_Socket_t * pxReturn;
+    UBaseType_t uxIndex;
+
+    prvBindTCPSocket( pxListenSocket, TEST_LOCAL_PORT, pdFALSE );
+    pxListenSocket->u.xTCP.eTCPState = eTCP_LISTEN;
+
+    for( uxIndex = 1U; uxIndex < TEST_SOCKET_COUNT; uxIndex++ )
+    {
+        prvAcceptTCPSocket( &( xSockets[ uxIndex ] ), TEST_LOCAL_PORT, TEST_REMOTE_IP, ( uint16_t ) ( 1024U + uxIndex ) );
+    }
+
+    for( uxIndex = 1U; uxIndex < TEST_SOCKET_COUNT; uxIndex++ )
+    {
+        pxReturn = pxTCPSocketLookup( 0U, TEST_LOCAL_PORT, TEST_REMOTE_IP, 1024U + uxIndex );
+
+        TEST_ASSERT_EQUAL_PTR( &( xSockets[ uxIndex ] ), pxReturn );
+    }
+}
+
+/*
+ * @brief A segment from an unknown peer is passed to the listening socket.
+ */
+void test_pxTCPSocketLookup_FallBackToListeningSocket( void )
+{
+    FreeRTOS_Socket_t * pxListenSocket = &( xSockets[ 0 ] );
+    FreeRTOS_Socket_t * pxReturn;
+
+    prvBindTCPSocket( pxListenSocket, TEST_LOCAL_PORT, pdFALSE );
+    pxListenSocket->u.xTCP.eTCPState = eTCP_LISTEN;
+
+    prvAcceptTCPSocket( &( xSockets[ 1 ] ), TEST_LOCAL_PORT, TEST_REMOTE_IP, 2000U );
+
+    pxReturn = pxTCPSocketLookup( 0U, TEST_LOCAL_PORT, TEST_REMOTE_IP, 2001U );
+
+    TEST_ASSERT_EQUAL_PTR( pxListenSocket, pxReturn );
+}
+
+/*
+ * @brief A socket that was connected by the application is found in the port
+ *        table, next to a listening socket on another port in the same bucket.
+ */
+void test_pxTCPSocketLookup_PortTable_ExactMatch( void )
+{
+    FreeRTOS_Socket_t * pxReturn;
+    UBaseType_t uxIndex;
+
+    /* Bind more sockets than there are buckets, so that at least one bucket
+     * holds several of them. */
+    for( uxIndex = 0U; uxIndex < TEST_SOCKET_COUNT; uxIndex++ )
+    {
+        prvBindTCPSocket( &( xSockets[ uxIndex ] ), ( uint16_t ) ( 5000U + uxIndex ), pdFALSE );
+        xSockets[ uxIndex ].u.xTCP.eTCPState = eESTABLISHED;
+        xSockets[ uxIndex ].u.xTCP.ulRemoteIP = TEST_REMOTE_IP;
+        xSockets[ uxIndex ].u.xTCP.usRemotePort = 443U;
+    }
+
+    for( uxIndex = 0U; uxIndex < TEST_SOCKET_COUNT; uxIndex++ )
+    {
+        pxReturn = pxTCPSocketLookup( 0U, 5000U + uxIndex, TEST_REMOTE_IP, 443U );
+
+        TEST_ASSERT_EQUAL_PTR( &( xSockets[ uxIndex ] ), pxReturn );
+    }
+
+    /* Same port, other peer. */
+    pxReturn = pxTCPSocketLookup( 0U, 5000U, TEST_REMOTE_IP, 444U );
+
+    TEST_ASSERT_EQUAL_PTR( NULL, pxReturn );
+}
+
+/*
+ * @brief Nothing is bound to the port.
+ */
+void test_pxTCPSocketLookup_NoMatch( void )
+{
+    FreeRTOS_Socket_t * pxReturn;
+
+    prvBindTCPSocket( &( xSockets[ 0 ] ), TEST_LOCAL_PORT, pdFALSE );
+    xSockets[ 0 ].u.xTCP.eTCPState = eTCP_LISTEN;
+
+    pxReturn = pxTCPSocketLookup( 0U, TEST_LOCAL_PORT + 1U, TEST_REMOTE_IP, 2000U );
+
+    TEST_ASSERT_EQUAL_PTR( NULL, pxReturn );
+}
+
+/*
+ * @brief A child socket moves from the port table to the connection table.
+ */
+void test_vTCPSocketHashConnection_MovesSocket( void )
+{
+    FreeRTOS_Socket_t * pxSocket = &( xSockets[ 0 ] );
+    FreeRTOS_Socket_t ** ppxPortBucket;
+
+    prvBindTCPSocket( pxSocket, TEST_LOCAL_PORT, pdFALSE );
+    ppxPortBucket = pxSocket->u.xTCP.ppxHashBucket;
+
+    pxSocket->u.xTCP.eTCPState = eSYN_RECEIVED;
+    pxSocket->u.xTCP.ulRemoteIP = TEST_REMOTE_IP;
+    pxSocket->u.xTCP.usRemotePort = 2000U;
+
+    vTCPSocketHashConnection( pxSocket );
+
+    TEST_ASSERT_EQUAL_PTR( NULL, *ppxPortBucket );
+    TEST_ASSERT_TRUE( pxSocket->u.xTCP.ppxHashBucket >= &( pxTCPConnectionTable[ 0 ] ) );
+    TEST_ASSERT_TRUE( pxSocket->u.xTCP.ppxHashBucket <= &( pxTCPConnectionTable[ ipconfigTCP_HASH_TABLE_SIZE - 1U ] ) );
+    TEST_ASSERT_EQUAL_PTR( pxSocket, pxTCPSocketLookup( 0U, TEST_LOCAL_PORT, TEST_REMOTE_IP, 2000U ) );
+}
+
+/*
+ * @brief Removing a socket that is not hashed does nothing.
+ */
+void test_prvTCPHashRemove_NotHashed( void )
+{
+    prvTCPHashRemove( &( xSockets[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL_PTR( NULL, xSockets[ 0 ].u.xTCP.ppxHashBucket );
+    TEST_ASSERT_EQUAL_PTR( NULL, xSockets[ 0 ].u.xTCP.pxHashNext );
+}
+
+/*
+ * @brief A socket that is stored in a bucket but can not be found there.
+ */
+void test_prvTCPHashRemove_CorruptBucket( void )
+{
+    FreeRTOS_Socket_t * pxBucket = NULL;
+
+    xSockets[ 0 ].u.xTCP.ppxHashBucket = &pxBucket;
+
+    catch_assert( prvTCPHashRemove( &( xSockets[ 0 ] ) ) );
+}
+
+/*
+ * @brief Closing a child socket removes it from its bucket, and leaves the other
+ *        sockets in that bucket reachable.
+ */
+void test_vSocketClose_TCP_RemovedFromHashTable( void )
+{
+    FreeRTOS_Socket_t * pxListenSocket = &( xSockets[ 0 ] );
+    FreeRTOS_Socket_t * pxSocket;
+    void * pvReturn;
+    UBaseType_t uxIndex;
+
+    prvBindTCPSocket( pxListenSocket, TEST_LOCAL_PORT, pdFALSE );
+    pxListenSocket->u.xTCP.eTCPState = eTCP_LISTEN;
+
+    for( uxIndex = 1U; uxIndex < TEST_SOCKET_COUNT; uxIndex++ )
+    {
+        prvAcceptTCPSocket( &( xSockets[ uxIndex ] ), TEST_LOCAL_PORT, TEST_REMOTE_IP, ( uint16_t ) ( 1024U + uxIndex ) );
+    }
+
+    /* Pick a socket from the middle of its chain. */
+    pxSocket = &( xSockets[ TEST_SOCKET_COUNT / 2U ] );
+
+    vTCPWindowDestroy_Expect( &( pxSocket->u.xTCP.xTCPWindow ) );
+    listGET_NEXT_ExpectAndReturn( &( xBoundTCPSocketsList.xListEnd ), &( xBoundTCPSocketsList.xListEnd ) );
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xBoundSocketListItem ), NULL );
+    vPortFree_Expect( pxSocket );
+
+    pvReturn = vSocketClose( pxSocket );
+
+    TEST_ASSERT_EQUAL( NULL, pvReturn );
+    TEST_ASSERT_EQUAL_PTR( NULL, pxSocket->u.xTCP.ppxHashBucket );
+
+    for( uxIndex = 1U; uxIndex < TEST_SOCKET_COUNT; uxIndex++ )
+    {
+        if( &( xSockets[ uxIndex ] ) == pxSocket )
+        {
+            /* The segment now goes to the listening socket. */
+            TEST_ASSERT_EQUAL_PTR( pxListenSocket, pxTCPSocketLookup( 0U, TEST_LOCAL_PORT, TEST_REMOTE_IP, 1024U + uxIndex ) );
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL_PTR( &( xSockets[ uxIndex ] ), pxTCPSocketLookup( 0U, TEST_LOCAL_PORT, TEST_REMOTE_IP, 1024U + uxIndex ) );
+        }
+    }
+}
+
+/*
+ * @brief Connections that only differ in the high bits of the remote port, or
+ *        in the top byte of the remote IP address, are spread evenly over the
+ *        buckets.
+ */
+void test_prvTCPConnectionHash_HighKeyBitsSpreadOverBuckets( void )
+{
+    UBaseType_t uxCount[ ipconfigTCP_HASH_TABLE_SIZE ];
+    UBaseType_t uxIndex;
+    UBaseType_t uxBucket;
+
+    /* Remote ports that differ in bits 10 to 15 only. */
+    memset( uxCount, 0, sizeof( uxCount ) );
+
+    for( uxIndex = 0U; uxIndex < 64U; uxIndex++ )
+    {
+        uxBucket = prvTCPConnectionHash( TEST_LOCAL_PORT, TEST_REMOTE_IP, uxIndex << 10 );
+
+        TEST_ASSERT_LESS_THAN( ipconfigTCP_HASH_TABLE_SIZE, uxBucket );
+        uxCount[ uxBucket ]++;
+    }
+
+    for( uxBucket = 0U; uxBucket < ipconfigTCP_HASH_TABLE_SIZE; uxBucket++ )
+    {
+        TEST_ASSERT_EQUAL( 64U / ipconfigTCP_HASH_TABLE_SIZE, uxCount[ uxBucket ] );
+    }
+
+    /* Remote IP addresses that differ in the top byte only. */
+    memset( uxCount, 0, sizeof( uxCount ) );
+
+    for( uxIndex = 0U; uxIndex < 256U; uxIndex++ )
+    {
+        uxBucket = prvTCPConnectionHash( TEST_LOCAL_PORT, ( TEST_REMOTE_IP & 0x00FFFFFFU ) | ( ( uint32_t ) uxIndex << 24 ), 1024U );
+
+        TEST_ASSERT_LESS_THAN( ipconfigTCP_HASH_TABLE_SIZE, uxBucket );
+        uxCount[ uxBucket ]++;
+    }
+
+    for( uxBucket = 0U; uxBucket < ipconfigTCP_HASH_TABLE_SIZE; uxBucket++ )
+    {
+        TEST_ASSERT_EQUAL( 256U / ipconfigTCP_HASH_TABLE_SIZE, uxCount[ uxBucket ] );
+    }
+}
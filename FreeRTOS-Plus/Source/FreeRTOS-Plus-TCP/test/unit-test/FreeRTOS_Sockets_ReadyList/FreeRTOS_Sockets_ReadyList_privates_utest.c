@@ -0,0 +1,526 @@
+/*
+ * FreeRTOS+TCP V3.1.0
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_Sockets_ReadyList_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_portable.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+#include "mock_FreeRTOS_DHCP.h"
+#include "mock_FreeRTOS_DNS.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_IP_Private.h"
+
+#include "FreeRTOS_Sockets.h"
+
+
+#include "catch_assert.h"
+
+#define TEST_BLOCK_TIME    ( ( TickType_t ) 0xAB12 )
+
+static SocketSelect_t xSocketSet;
+static SocketSelect_t xOtherSocketSet;
+static FreeRTOS_Socket_t xSockets[ 2 ];
+static Socket_t xReadySockets[ 2 ];
+
+/* ============================ Unity Fixtures ============================ */
+
+void setUp( void )
+{
+    memset( &xSocketSet, 0, sizeof( xSocketSet ) );
+    memset( &xOtherSocketSet, 0, sizeof( xOtherSocketSet ) );
+    memset( xSockets, 0, sizeof( xSockets ) );
+    memset( xReadySockets, 0, sizeof( xReadySockets ) );
+
+    xSocketSet.xSelectGroup = ( EventGroupHandle_t ) &( xSocketSet );
+    xOtherSocketSet.xSelectGroup = ( EventGroupHandle_t ) &( xOtherSocketSet );
+}
+
+/* ======================== Local helper functions ======================== */
+
+/*
+ * @brief The end marker of the ready list of the socket set.
+ */
+static ListItem_t * prvReadyListEnd( void )
+{
+    return ( ListItem_t * ) &( xSocketSet.xReadyList.xListEnd );
+}
+
+/*
+ * @brief Expect prvFindSelectedSocket() to fail to wake up the IP task, which
+ *        is the same as the IP task not finding anything new.
+ */
+static void prvExpectFindSelectedSocket( void )
+{
+    xEventGroupClearBits_ExpectAndReturn( xSocketSet.xSelectGroup, ( BaseType_t ) eSELECT_CALL_IP, 0 );
+    xSendEventStructToIPTask_ExpectAnyArgsAndReturn( pdFAIL );
+}
+
+/*
+ * @brief Moves xSockets[ 0 ] to xOtherSocketSet just before the IP task
+ *        suspends the scheduler in vSocketSelectMarkReady(), as
+ *        FreeRTOS_FD_SET() would do if it ran at that moment.
+ */
+static void prvMoveSocketOnSuspend( int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    xSockets[ 0 ].pxSocketSet = &( xOtherSocketSet );
+}
+
+/*
+ * @brief Expect the ready list to be walked while it holds xSockets[ 0 .. uxCount - 1 ].
+ */
+static void prvExpectReadyList( UBaseType_t uxCount )
+{
+    ListItem_t * pxPrevious = prvReadyListEnd();
+    UBaseType_t uxIndex;
+
+    for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+    {
+        listGET_NEXT_ExpectAndReturn( pxPrevious, &( xSockets[ uxIndex ].xSelectListItem ) );
+        listGET_LIST_ITEM_OWNER_ExpectAndReturn( &( xSockets[ uxIndex ].xSelectListItem ), &( xSockets[ uxIndex ] ) );
+        pxPrevious = &( xSockets[ uxIndex ].xSelectListItem );
+    }
+
+    listGET_NEXT_ExpectAndReturn( pxPrevious, prvReadyListEnd() );
+}
+
+/* ============================== Test Cases ============================== */
+
+/*
+ * @brief A new socket set starts with an empty ready list.
+ */
+void test_FreeRTOS_CreateSocketSet_InitialisesReadyList( void )
+{
+    SocketSelect_t * pxSocketSet;
+    uint8_t xEventGroup[ sizeof( uintptr_t ) ];
+
+    pvPortMalloc_ExpectAndReturn( sizeof( xSocketSet ), &( xSocketSet ) );
+    xEventGroupCreate_ExpectAndReturn( xEventGroup );
+    vListInitialise_Expect( &( xSocketSet.xReadyList ) );
+
+    pxSocketSet = FreeRTOS_CreateSocketSet();
+
+    TEST_ASSERT_EQUAL_PTR( &( xSocketSet ), pxSocketSet );
+}
+
+/*
+ * @brief A socket added to a set is put in the ready list, so that the IP task
+ *        checks it straight away.
+ */
+void test_FreeRTOS_FD_SET_PutsSocketInReadyList( void )
+{
+    FreeRTOS_Socket_t * pxSocket = &( xSockets[ 0 ] );
+
+    /* Not in the ready list of another set. */
+    vTaskSuspendAll_Expect();
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xSelectListItem ), NULL );
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xSelectListItem ), NULL );
+    vListInsertEnd_Expect( &( xSocketSet.xReadyList ), &( pxSocket->xSelectListItem ) );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    prvExpectFindSelectedSocket();
+
+    FreeRTOS_FD_SET( pxSocket, &( xSocketSet ), eSELECT_READ );
+
+    TEST_ASSERT_EQUAL_PTR( &( xSocketSet ), pxSocket->pxSocketSet );
+    TEST_ASSERT_EQUAL( eSELECT_READ, pxSocket->xSelectBits );
+}
+
+/*
+ * @brief Adding more bits for a socket that is in the ready list already does
+ *        not insert it twice.
+ */
+void test_FreeRTOS_FD_SET_AlreadyInReadyList( void )
+{
+    FreeRTOS_Socket_t * pxSocket = &( xSockets[ 0 ] );
+
+    pxSocket->pxSocketSet = &( xSocketSet );
+    pxSocket->xSelectBits = eSELECT_READ;
+
+    vTaskSuspendAll_Expect();
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xSelectListItem ), &( xSocketSet.xReadyList ) );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    prvExpectFindSelectedSocket();
+
+    FreeRTOS_FD_SET( pxSocket, &( xSocketSet ), eSELECT_WRITE );
+
+    TEST_ASSERT_EQUAL( eSELECT_READ | eSELECT_WRITE, pxSocket->xSelectBits );
+}
+
+/*
+ * @brief A socket that leaves its set is taken out of the ready list.
+ */
+void test_FreeRTOS_FD_CLR_LastBit_RemovesFromReadyList( void )
+{
+    FreeRTOS_Socket_t * pxSocket = &( xSockets[ 0 ] );
+
+    pxSocket->pxSocketSet = &( xSocketSet );
+    pxSocket->xSelectBits = eSELECT_READ;
+    pxSocket->xSocketBits = eSELECT_READ;
+
+    vTaskSuspendAll_Expect();
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xSelectListItem ), &( xSocketSet.xReadyList ) );
+    uxListRemove_ExpectAndReturn( &( pxSocket->xSelectListItem ), 0U );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    FreeRTOS_FD_CLR( pxSocket, &( xSocketSet ), eSELECT_READ );
+
+    TEST_ASSERT_EQUAL_PTR( NULL, pxSocket->pxSocketSet );
+    TEST_ASSERT_EQUAL( 0, pxSocket->xSocketBits );
+}
+
+/*
+ * @brief A socket that is added to another set leaves the ready list of its
+ *        old set and is put in the ready list of the new set, while the
+ *        scheduler is suspended once.
+ */
+void test_FreeRTOS_FD_SET_MovesSocketToOtherSet( void )
+{
+    FreeRTOS_Socket_t * pxSocket = &( xSockets[ 0 ] );
+
+    pxSocket->pxSocketSet = &( xSocketSet );
+    pxSocket->xSelectBits = eSELECT_READ;
+    pxSocket->xSocketBits = eSELECT_READ;
+
+    vTaskSuspendAll_Expect();
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xSelectListItem ), &( xSocketSet.xReadyList ) );
+    uxListRemove_ExpectAndReturn( &( pxSocket->xSelectListItem ), 0U );
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xSelectListItem ), NULL );
+    vListInsertEnd_Expect( &( xOtherSocketSet.xReadyList ), &( pxSocket->xSelectListItem ) );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    xEventGroupClearBits_ExpectAndReturn( xOtherSocketSet.xSelectGroup, ( BaseType_t ) eSELECT_CALL_IP, 0 );
+    xSendEventStructToIPTask_ExpectAnyArgsAndReturn( pdFAIL );
+
+    FreeRTOS_FD_SET( pxSocket, &( xOtherSocketSet ), eSELECT_WRITE );
+
+    TEST_ASSERT_EQUAL_PTR( &( xOtherSocketSet ), pxSocket->pxSocketSet );
+    TEST_ASSERT_EQUAL( 0, pxSocket->xSocketBits );
+}
+
+/*
+ * @brief Clearing some bits of a socket with another set moves the socket to
+ *        that set, and its ready list item with it.
+ */
+void test_FreeRTOS_FD_CLR_MovesSocketToOtherSet( void )
+{
+    FreeRTOS_Socket_t * pxSocket = &( xSockets[ 0 ] );
+
+    pxSocket->pxSocketSet = &( xSocketSet );
+    pxSocket->xSelectBits = eSELECT_READ | eSELECT_WRITE;
+    pxSocket->xSocketBits = eSELECT_READ;
+
+    vTaskSuspendAll_Expect();
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xSelectListItem ), &( xSocketSet.xReadyList ) );
+    uxListRemove_ExpectAndReturn( &( pxSocket->xSelectListItem ), 0U );
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xSelectListItem ), NULL );
+    vListInsertEnd_Expect( &( xOtherSocketSet.xReadyList ), &( pxSocket->xSelectListItem ) );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    FreeRTOS_FD_CLR( pxSocket, &( xOtherSocketSet ), eSELECT_READ );
+
+    TEST_ASSERT_EQUAL_PTR( &( xOtherSocketSet ), pxSocket->pxSocketSet );
+    TEST_ASSERT_EQUAL( eSELECT_WRITE, pxSocket->xSelectBits );
+    TEST_ASSERT_EQUAL( 0, pxSocket->xSocketBits );
+}
+
+/*
+ * @brief vSocketSelectMarkReady() reads the set of the socket after it has
+ *        suspended the scheduler, so a socket that has just moved to another
+ *        set is put in the ready list of its new set.
+ */
+void test_vSocketSelectMarkReady_SocketMovedToOtherSet( void )
+{
+    FreeRTOS_Socket_t * pxSocket = &( xSockets[ 0 ] );
+
+    pxSocket->pxSocketSet = &( xSocketSet );
+
+    vTaskSuspendAll_Stub( prvMoveSocketOnSuspend );
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xSelectListItem ), NULL );
+    vListInsertEnd_Expect( &( xOtherSocketSet.xReadyList ), &( pxSocket->xSelectListItem ) );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    vSocketSelectMarkReady( pxSocket );
+
+    TEST_ASSERT_EQUAL_PTR( &( xOtherSocketSet ), pxSocket->pxSocketSet );
+}
+
+/*
+ * @brief Waking up the owner of a socket in a set puts the socket in the
+ *        ready list of the set.
+ */
+void test_vSocketWakeUpUser_PutsSocketInReadyList( void )
+{
+    FreeRTOS_Socket_t * pxSocket = &( xSockets[ 0 ] );
+
+    pxSocket->pxSocketSet = &( xSocketSet );
+    pxSocket->xEventBits = ( ( EventBits_t ) eSELECT_READ << SOCKET_EVENT_BIT_COUNT ) | ( EventBits_t ) eSOCKET_RECEIVE;
+
+    vTaskSuspendAll_Expect();
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xSelectListItem ), NULL );
+    vListInsertEnd_Expect( &( xSocketSet.xReadyList ), &( pxSocket->xSelectListItem ) );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    xEventGroupSetBits_ExpectAndReturn( xSocketSet.xSelectGroup, eSELECT_READ, pdPASS );
+
+    vSocketWakeUpUser( pxSocket );
+
+    TEST_ASSERT_EQUAL( eSELECT_READ, pxSocket->xSocketBits );
+    TEST_ASSERT_EQUAL( 0, pxSocket->xEventBits );
+}
+
+/*
+ * @brief Any event of a socket in a set makes it a candidate, even when it is
+ *        not a select event, but it is not inserted twice.
+ */
+void test_vSocketWakeUpUser_AlreadyInReadyList( void )
+{
+    FreeRTOS_Socket_t * pxSocket = &( xSockets[ 0 ] );
+
+    pxSocket->pxSocketSet = &( xSocketSet );
+    pxSocket->xEventBits = ( EventBits_t ) eSOCKET_CLOSED;
+
+    vTaskSuspendAll_Expect();
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xSelectListItem ), &( xSocketSet.xReadyList ) );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    vSocketWakeUpUser( pxSocket );
+
+    TEST_ASSERT_EQUAL( 0, pxSocket->xSocketBits );
+}
+
+/*
+ * @brief vSocketSelect() only checks the sockets in the ready list, not the
+ *        lists of bound sockets, and drops the ones that are idle.
+ */
+void test_vSocketSelect_ChecksReadyListOnly( void )
+{
+    xSockets[ 0 ].ucProtocol = ( uint8_t ) FREERTOS_IPPROTO_UDP;
+    xSockets[ 0 ].xSelectBits = eSELECT_READ;
+    xSockets[ 1 ].ucProtocol = ( uint8_t ) FREERTOS_IPPROTO_UDP;
+    xSockets[ 1 ].xSelectBits = eSELECT_READ;
+    xSockets[ 1 ].xSocketBits = eSELECT_READ;
+
+    vTaskSuspendAll_Expect();
+
+    listGET_NEXT_ExpectAndReturn( prvReadyListEnd(), &( xSockets[ 0 ].xSelectListItem ) );
+    listGET_LIST_ITEM_OWNER_ExpectAndReturn( &( xSockets[ 0 ].xSelectListItem ), &( xSockets[ 0 ] ) );
+    listGET_NEXT_ExpectAndReturn( &( xSockets[ 0 ].xSelectListItem ), &( xSockets[ 1 ].xSelectListItem ) );
+    listCURRENT_LIST_LENGTH_ExpectAndReturn( &( xSockets[ 0 ].u.xUDP.xWaitingPacketsList ), 2 );
+
+    /* The packets of the second socket have been read. */
+    listGET_LIST_ITEM_OWNER_ExpectAndReturn( &( xSockets[ 1 ].xSelectListItem ), &( xSockets[ 1 ] ) );
+    listGET_NEXT_ExpectAndReturn( &( xSockets[ 1 ].xSelectListItem ), prvReadyListEnd() );
+    listCURRENT_LIST_LENGTH_ExpectAndReturn( &( xSockets[ 1 ].u.xUDP.xWaitingPacketsList ), 0 );
+    uxListRemove_ExpectAndReturn( &( xSockets[ 1 ].xSelectListItem ), 1U );
+
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    /* A WRITE event was signalled before, and is cleared now. */
+    xEventGroupClearBits_ExpectAndReturn( xSocketSet.xSelectGroup, 0, eSELECT_READ | eSELECT_WRITE );
+    xEventGroupClearBits_ExpectAndReturn( xSocketSet.xSelectGroup, eSELECT_WRITE, 0 );
+    xEventGroupSetBits_ExpectAndReturn( xSocketSet.xSelectGroup, eSELECT_READ | eSELECT_CALL_IP, pdPASS );
+
+    vSocketSelect( &( xSocketSet ) );
+
+    TEST_ASSERT_EQUAL( eSELECT_READ, xSockets[ 0 ].xSocketBits );
+    TEST_ASSERT_EQUAL( 0, xSockets[ 1 ].xSocketBits );
+}
+
+/*
+ * @brief The ready list of an empty set costs nothing to check.
+ */
+void test_vSocketSelect_EmptyReadyList( void )
+{
+    vTaskSuspendAll_Expect();
+    listGET_NEXT_ExpectAndReturn( prvReadyListEnd(), prvReadyListEnd() );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    xEventGroupClearBits_ExpectAndReturn( xSocketSet.xSelectGroup, 0, 0 );
+    xEventGroupSetBits_ExpectAndReturn( xSocketSet.xSelectGroup, eSELECT_CALL_IP, pdPASS );
+
+    vSocketSelect( &( xSocketSet ) );
+}
+
+/*
+ * @brief FreeRTOS_select_ready() asserts on its parameters.
+ */
+void test_FreeRTOS_select_ready_CatchAssert( void )
+{
+    catch_assert( FreeRTOS_select_ready( NULL, xReadySockets, 2, TEST_BLOCK_TIME ) );
+    catch_assert( FreeRTOS_select_ready( &( xSocketSet ), NULL, 2, TEST_BLOCK_TIME ) );
+    catch_assert( FreeRTOS_select_ready( &( xSocketSet ), xReadySockets, 0, TEST_BLOCK_TIME ) );
+}
+
+/*
+ * @brief Only the sockets of the ready list that have an event are returned.
+ */
+void test_FreeRTOS_select_ready_ReturnsReadySockets( void )
+{
+    BaseType_t xReturn;
+
+    /* The first socket has an event, the second was found idle. */
+    xSockets[ 0 ].xSocketBits = eSELECT_READ;
+
+    vTaskSetTimeOutState_ExpectAnyArgs();
+    xEventGroupWaitBits_ExpectAndReturn( xSocketSet.xSelectGroup, eSELECT_ALL, pdFALSE, pdFALSE, TEST_BLOCK_TIME, eSELECT_READ );
+    prvExpectFindSelectedSocket();
+
+    vTaskSuspendAll_Expect();
+    prvExpectReadyList( 2U );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    xReturn = FreeRTOS_select_ready( &( xSocketSet ), xReadySockets, 2, TEST_BLOCK_TIME );
+
+    TEST_ASSERT_EQUAL( 1, xReturn );
+    TEST_ASSERT_EQUAL_PTR( &( xSockets[ 0 ] ), xReadySockets[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( NULL, xReadySockets[ 1 ] );
+}
+
+/*
+ * @brief When more sockets are ready than fit in the array, the ones that are
+ *        returned move to the end of the ready list.
+ */
+void test_FreeRTOS_select_ready_ArrayFull_RotatesReadyList( void )
+{
+    BaseType_t xReturn;
+
+    xSockets[ 0 ].xSocketBits = eSELECT_READ;
+    xSockets[ 1 ].xSocketBits = eSELECT_READ;
+
+    vTaskSetTimeOutState_ExpectAnyArgs();
+    xEventGroupWaitBits_ExpectAndReturn( xSocketSet.xSelectGroup, eSELECT_ALL, pdFALSE, pdFALSE, TEST_BLOCK_TIME, eSELECT_READ );
+    prvExpectFindSelectedSocket();
+
+    vTaskSuspendAll_Expect();
+    listGET_NEXT_ExpectAndReturn( prvReadyListEnd(), &( xSockets[ 0 ].xSelectListItem ) );
+    listGET_LIST_ITEM_OWNER_ExpectAndReturn( &( xSockets[ 0 ].xSelectListItem ), &( xSockets[ 0 ] ) );
+    listGET_NEXT_ExpectAndReturn( &( xSockets[ 0 ].xSelectListItem ), &( xSockets[ 1 ].xSelectListItem ) );
+    uxListRemove_ExpectAndReturn( &( xSockets[ 0 ].xSelectListItem ), 1U );
+    vListInsertEnd_Expect( &( xSocketSet.xReadyList ), &( xSockets[ 0 ].xSelectListItem ) );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    xReturn = FreeRTOS_select_ready( &( xSocketSet ), xReadySockets, 1, TEST_BLOCK_TIME );
+
+    TEST_ASSERT_EQUAL( 1, xReturn );
+    TEST_ASSERT_EQUAL_PTR( &( xSockets[ 0 ] ), xReadySockets[ 0 ] );
+}
+
+/*
+ * @brief Nothing became ready before the time-out.
+ */
+void test_FreeRTOS_select_ready_Timeout( void )
+{
+    BaseType_t xReturn;
+
+    vTaskSetTimeOutState_ExpectAnyArgs();
+
+    /* The first round finds a socket that is not ready. */
+    xEventGroupWaitBits_ExpectAndReturn( xSocketSet.xSelectGroup, eSELECT_ALL, pdFALSE, pdFALSE, TEST_BLOCK_TIME, eSELECT_READ );
+    prvExpectFindSelectedSocket();
+    vTaskSuspendAll_Expect();
+    prvExpectReadyList( 1U );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdFALSE );
+
+    /* The second round finds nothing. */
+    xEventGroupWaitBits_ExpectAndReturn( xSocketSet.xSelectGroup, eSELECT_ALL, pdFALSE, pdFALSE, TEST_BLOCK_TIME, 0 );
+    prvExpectFindSelectedSocket();
+    vTaskSuspendAll_Expect();
+    prvExpectReadyList( 0U );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdTRUE );
+
+    xReturn = FreeRTOS_select_ready( &( xSocketSet ), xReadySockets, 2, TEST_BLOCK_TIME );
+
+    TEST_ASSERT_EQUAL( 0, xReturn );
+}
+
+/*
+ * @brief A signal interrupts the wait.
+ */
+void test_FreeRTOS_select_ready_Interrupted( void )
+{
+    BaseType_t xReturn;
+
+    vTaskSetTimeOutState_ExpectAnyArgs();
+    xEventGroupWaitBits_ExpectAndReturn( xSocketSet.xSelectGroup, eSELECT_ALL, pdFALSE, pdFALSE, TEST_BLOCK_TIME, eSELECT_INTR );
+    xEventGroupClearBits_ExpectAndReturn( xSocketSet.xSelectGroup, eSELECT_INTR, eSELECT_INTR );
+
+    xReturn = FreeRTOS_select_ready( &( xSocketSet ), xReadySockets, 2, TEST_BLOCK_TIME );
+
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINTR, xReturn );
+}
+
+/*
+ * @brief A closed socket is taken out of the ready list of its set.
+ */
+void test_vSocketClose_RemovesFromReadyList( void )
+{
+    FreeRTOS_Socket_t * pxSocket = &( xSockets[ 0 ] );
+    void * pvReturn;
+
+    pxSocket->pxSocketSet = &( xSocketSet );
+
+    vTaskSuspendAll_Expect();
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xSelectListItem ), &( xSocketSet.xReadyList ) );
+    uxListRemove_ExpectAndReturn( &( pxSocket->xSelectListItem ), 0U );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    /* Not bound. */
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( pxSocket->xBoundSocketListItem ), NULL );
+
+    vPortFree_Expect( pxSocket );
+
+    pvReturn = vSocketClose( pxSocket );
+
+    TEST_ASSERT_EQUAL( NULL, pvReturn );
+}
@@ -0,0 +1,164 @@
+/*
+ * FreeRTOS+TCP V3.1.0
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_list.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_task.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_UDP_IP.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_FreeRTOS_TCP_State_Handling.h"
+#include "mock_FreeRTOS_TCP_Reception.h"
+#include "mock_FreeRTOS_TCP_Utils.h"
+
+#include "FreeRTOS_TCP_IP.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_IP_RxBurst_SendData_stubs.c"
+#include "FreeRTOS_TCP_Transmission.h"
+
+/* Not in the mocks, as the mocked headers leave out the RX burst functions. */
+BaseType_t xTCPRxBurstDeferAck( FreeRTOS_Socket_t * pxSocket );
+
+FreeRTOS_Socket_t xSocket, * pxSocket;
+NetworkBufferDescriptor_t xNetworkBuffer, * pxNetworkBuffer;
+uint8_t ucEthernetBuffer[ ipconfigNETWORK_MTU ];
+
+static BaseType_t xDeferAckReturn;
+static UBaseType_t uxDeferAckCalls;
+
+BaseType_t xTCPRxBurstDeferAck( FreeRTOS_Socket_t * pxSocket )
+{
+    TEST_ASSERT_EQUAL( &xSocket, pxSocket );
+    uxDeferAckCalls++;
+
+    return xDeferAckReturn;
+}
+
+void setUp( void )
+{
+    ProtocolHeaders_t * pxProtocolHeader;
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+    memset( ucEthernetBuffer, 0, sizeof( ucEthernetBuffer ) );
+
+    pxSocket = &xSocket;
+    pxNetworkBuffer = &xNetworkBuffer;
+    pxNetworkBuffer->pucEthernetBuffer = ucEthernetBuffer;
+    ucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] = ipIP_VERSION_AND_HEADER_LENGTH_BYTE;
+    xTCPWindowLoggingLevel = 0;
+    xDeferAckReturn = pdFALSE;
+    uxDeferAckCalls = 0U;
+
+    /* An established socket received 100 bytes of data, and only needs to
+     * acknowledge them. */
+    pxProtocolHeader = ( ( ProtocolHeaders_t * ) &( ucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER ] ) );
+    pxProtocolHeader->xTCPHeader.ucTCPFlags = tcpTCP_FLAG_ACK;
+    pxSocket->u.xTCP.eTCPState = eESTABLISHED;
+    pxSocket->u.xTCP.bits.bFinSent = pdFALSE;
+    pxSocket->u.xTCP.usMSS = 1000;
+    pxSocket->u.xTCP.xTCPWindow.rx.ulCurrentSequenceNumber = 1000;
+}
+
+/* test prvSendData function */
+void test_prvSendData_RxBurst_EnoughRxSpace( void )
+{
+    BaseType_t xBytesSent;
+
+    /* There is space for more than 2 x MSS, so the ACK may be delayed anyway.
+     * The socket must still be registered, so that its ACK is sent at the end
+     * of the burst, rather than when the delayed ACK timer expires. */
+    pxSocket->u.xTCP.ulHighestRxAllowed = 5000;
+
+    xDeferAckReturn = pdTRUE;
+
+    xBytesSent = prvSendData( pxSocket, &pxNetworkBuffer, 100, ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER );
+
+    TEST_ASSERT_EQUAL( 0, xBytesSent );
+    TEST_ASSERT_EQUAL( 1U, uxDeferAckCalls );
+    TEST_ASSERT_EQUAL( &xNetworkBuffer, pxSocket->u.xTCP.pxAckMessage );
+    TEST_ASSERT_EQUAL( NULL, pxNetworkBuffer );
+}
+
+/* test prvSendData function */
+void test_prvSendData_RxBurst_EnoughRxSpace_NoBurst( void )
+{
+    BaseType_t xBytesSent;
+
+    pxSocket->u.xTCP.ulHighestRxAllowed = 5000;
+
+    /* Outside a burst, the ACK is still delayed as usual. */
+    xDeferAckReturn = pdFALSE;
+
+    xBytesSent = prvSendData( pxSocket, &pxNetworkBuffer, 100, ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER );
+
+    TEST_ASSERT_EQUAL( 0, xBytesSent );
+    TEST_ASSERT_EQUAL( 1U, uxDeferAckCalls );
+    TEST_ASSERT_EQUAL( &xNetworkBuffer, pxSocket->u.xTCP.pxAckMessage );
+    TEST_ASSERT_EQUAL( tcpDELAYED_ACK_SHORT_DELAY_MS, pxSocket->u.xTCP.usTimeout );
+}
+
+/* test prvSendData function */
+void test_prvSendData_RxBurst_LittleRxSpace( void )
+{
+    BaseType_t xBytesSent;
+
+    /* There is space for less than 2 x MSS, so the ACK would be sent now, were
+     * it not for the burst. */
+    pxSocket->u.xTCP.ulHighestRxAllowed = 2500;
+
+    xDeferAckReturn = pdTRUE;
+
+    xBytesSent = prvSendData( pxSocket, &pxNetworkBuffer, 100, ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER );
+
+    TEST_ASSERT_EQUAL( 0, xBytesSent );
+    TEST_ASSERT_EQUAL( 1U, uxDeferAckCalls );
+    TEST_ASSERT_EQUAL( &xNetworkBuffer, pxSocket->u.xTCP.pxAckMessage );
+}
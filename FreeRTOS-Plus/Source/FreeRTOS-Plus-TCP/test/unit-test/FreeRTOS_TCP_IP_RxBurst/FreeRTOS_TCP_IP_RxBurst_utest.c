@@ -0,0 +1,227 @@
+/*
+ * FreeRTOS+TCP V3.1.0
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_TCP_IP_RxBurst_list_macros.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_queue.h"
+#include "mock_task.h"
+#include "mock_event_groups.h"
+#include "mock_list.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_TCP_State_Handling.h"
+#include "mock_FreeRTOS_UDP_IP.h"
+#include "mock_FreeRTOS_TCP_Transmission.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_IP.h"
+
+extern FreeRTOS_Socket_t * pxRxBurstSockets[ ipconfigIP_RX_BURST_LENGTH ];
+extern UBaseType_t uxRxBurstSocketCount;
+extern BaseType_t xRxBurstActive;
+
+static FreeRTOS_Socket_t xSocket1, xSocket2, xSocket3;
+
+void setUp( void )
+{
+    memset( &xSocket1, 0, sizeof( xSocket1 ) );
+    memset( &xSocket2, 0, sizeof( xSocket2 ) );
+    memset( &xSocket3, 0, sizeof( xSocket3 ) );
+
+    memset( pxRxBurstSockets, 0, sizeof( pxRxBurstSockets ) );
+    uxRxBurstSocketCount = 0U;
+    xRxBurstActive = pdFALSE;
+}
+
+/* Expect the calls that xTCPSocketCheck() makes for an established socket that
+ * has a held back ACK and no data to send. */
+static void prvExpectAckSent( FreeRTOS_Socket_t * pxSocket )
+{
+    TickType_t xDelayReturn = 0;
+
+    prvTCPReturnPacket_Expect( pxSocket, pxSocket->u.xTCP.pxAckMessage, ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER, ipconfigZERO_COPY_TX_DRIVER );
+
+    xTCPWindowTxHasData_ExpectAnyArgsAndReturn( pdTRUE );
+    xTCPWindowTxHasData_ReturnThruPtr_pulDelay( &xDelayReturn );
+
+    vReleaseNetworkBufferAndDescriptor_Expect( pxSocket->u.xTCP.pxAckMessage );
+
+    prvTCPSendPacket_ExpectAndReturn( pxSocket, 0 );
+
+    prvTCPStatusAgeCheck_ExpectAndReturn( pxSocket, 0 );
+}
+
+/* test xTCPRxBurstDeferAck function */
+void test_xTCPRxBurstDeferAck_NoBurst( void )
+{
+    BaseType_t xReturn;
+
+    xReturn = xTCPRxBurstDeferAck( &xSocket1 );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xReturn );
+    TEST_ASSERT_EQUAL( 0U, uxRxBurstSocketCount );
+    TEST_ASSERT_EQUAL( pdFALSE_UNSIGNED, xSocket1.u.xTCP.bits.bRxBurstAck );
+}
+
+/* test xTCPRxBurstDeferAck function */
+void test_xTCPRxBurstDeferAck_SameSocketTwice( void )
+{
+    BaseType_t xReturn;
+
+    vTCPRxBurstStart();
+
+    xReturn = xTCPRxBurstDeferAck( &xSocket1 );
+    TEST_ASSERT_EQUAL( pdTRUE, xReturn );
+
+    xReturn = xTCPRxBurstDeferAck( &xSocket1 );
+    TEST_ASSERT_EQUAL( pdTRUE, xReturn );
+
+    TEST_ASSERT_EQUAL( 1U, uxRxBurstSocketCount );
+    TEST_ASSERT_EQUAL( &xSocket1, pxRxBurstSockets[ 0 ] );
+    TEST_ASSERT_EQUAL( pdTRUE_UNSIGNED, xSocket1.u.xTCP.bits.bRxBurstAck );
+}
+
+/* test xTCPRxBurstDeferAck function */
+void test_xTCPRxBurstDeferAck_ListFull( void )
+{
+    BaseType_t xReturn;
+
+    vTCPRxBurstStart();
+
+    TEST_ASSERT_EQUAL( pdTRUE, xTCPRxBurstDeferAck( &xSocket1 ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xTCPRxBurstDeferAck( &xSocket2 ) );
+
+    /* The third socket must send its ACK now. */
+    xReturn = xTCPRxBurstDeferAck( &xSocket3 );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xReturn );
+    TEST_ASSERT_EQUAL( 2U, uxRxBurstSocketCount );
+    TEST_ASSERT_EQUAL( pdFALSE_UNSIGNED, xSocket3.u.xTCP.bits.bRxBurstAck );
+}
+
+/* test vTCPRxBurstEnd function */
+void test_vTCPRxBurstEnd_NoSockets( void )
+{
+    vTCPRxBurstStart();
+
+    vTCPRxBurstEnd();
+
+    TEST_ASSERT_EQUAL( pdFALSE, xRxBurstActive );
+    TEST_ASSERT_EQUAL( 0U, uxRxBurstSocketCount );
+}
+
+/* test vTCPRxBurstEnd function */
+void test_vTCPRxBurstEnd_SendsHeldBackAcks( void )
+{
+    uint8_t ucAck1, ucAck2;
+
+    xSocket1.u.xTCP.eTCPState = eESTABLISHED;
+    xSocket1.u.xTCP.pxAckMessage = ( void * ) &ucAck1;
+    xSocket1.u.xTCP.usTimeout = 20U;
+    xSocket2.u.xTCP.eTCPState = eESTABLISHED;
+    xSocket2.u.xTCP.pxAckMessage = ( void * ) &ucAck2;
+    xSocket2.u.xTCP.usTimeout = 20U;
+
+    vTCPRxBurstStart();
+    ( void ) xTCPRxBurstDeferAck( &xSocket1 );
+    ( void ) xTCPRxBurstDeferAck( &xSocket2 );
+
+    prvExpectAckSent( &xSocket1 );
+    prvExpectAckSent( &xSocket2 );
+
+    vTCPRxBurstEnd();
+
+    TEST_ASSERT_EQUAL( pdFALSE, xRxBurstActive );
+    TEST_ASSERT_EQUAL( 0U, uxRxBurstSocketCount );
+    TEST_ASSERT_EQUAL( pdFALSE_UNSIGNED, xSocket1.u.xTCP.bits.bRxBurstAck );
+    TEST_ASSERT_EQUAL( pdFALSE_UNSIGNED, xSocket2.u.xTCP.bits.bRxBurstAck );
+    TEST_ASSERT_EQUAL( NULL, xSocket1.u.xTCP.pxAckMessage );
+    TEST_ASSERT_EQUAL( NULL, xSocket2.u.xTCP.pxAckMessage );
+
+    /* The delayed ACK timeout was replaced by the timeout of the window. */
+    TEST_ASSERT_EQUAL( 1U, xSocket1.u.xTCP.usTimeout );
+    TEST_ASSERT_EQUAL( 1U, xSocket2.u.xTCP.usTimeout );
+}
+
+/* test vTCPRxBurstRemoveSocket function */
+void test_vTCPRxBurstRemoveSocket_ClosedDuringBurst( void )
+{
+    uint8_t ucAck2;
+
+    xSocket2.u.xTCP.eTCPState = eESTABLISHED;
+    xSocket2.u.xTCP.pxAckMessage = ( void * ) &ucAck2;
+
+    vTCPRxBurstStart();
+    ( void ) xTCPRxBurstDeferAck( &xSocket1 );
+    ( void ) xTCPRxBurstDeferAck( &xSocket2 );
+
+    vTCPRxBurstRemoveSocket( &xSocket1 );
+
+    TEST_ASSERT_EQUAL( NULL, pxRxBurstSockets[ 0 ] );
+    TEST_ASSERT_EQUAL( &xSocket2, pxRxBurstSockets[ 1 ] );
+    TEST_ASSERT_EQUAL( pdFALSE_UNSIGNED, xSocket1.u.xTCP.bits.bRxBurstAck );
+
+    /* Only the socket that is still open sends its ACK. */
+    prvExpectAckSent( &xSocket2 );
+
+    vTCPRxBurstEnd();
+
+    TEST_ASSERT_EQUAL( 0U, uxRxBurstSocketCount );
+}
+
+/* test vTCPRxBurstRemoveSocket function */
+void test_vTCPRxBurstRemoveSocket_NotInList( void )
+{
+    vTCPRxBurstStart();
+    ( void ) xTCPRxBurstDeferAck( &xSocket1 );
+
+    vTCPRxBurstRemoveSocket( &xSocket2 );
+
+    TEST_ASSERT_EQUAL( 1U, uxRxBurstSocketCount );
+    TEST_ASSERT_EQUAL( &xSocket1, pxRxBurstSockets[ 0 ] );
+    TEST_ASSERT_EQUAL( pdTRUE_UNSIGNED, xSocket1.u.xTCP.bits.bRxBurstAck );
+}
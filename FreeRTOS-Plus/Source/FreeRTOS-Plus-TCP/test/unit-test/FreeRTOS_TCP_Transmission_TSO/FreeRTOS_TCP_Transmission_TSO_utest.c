@@ -0,0 +1,464 @@
+/*
+ * FreeRTOS+TCP V3.1.0
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_task.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_UDP_IP.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_FreeRTOS_TCP_State_Handling.h"
+#include "mock_FreeRTOS_TCP_Reception.h"
+#include "mock_FreeRTOS_TCP_Utils.h"
+
+#include "FreeRTOS_TCP_IP.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+#include "FreeRTOSIPConfigDefaults.h"
+
+#include "FreeRTOS_TCP_Transmission_TSO_stubs.c"
+#include "FreeRTOS_TCP_Transmission.h"
+
+/* The size of the Ethernet, IPv4 and TCP headers of a segment without options. */
+#define HEADER_LENGTH    ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER )
+
+/* The MSS used by the tests of prvTCPPrepareLargeSend(). */
+#define TEST_MSS         ( 1000U )
+
+/* What xNetworkInterfaceOutput() was given, one entry per call. */
+typedef struct xSENT_SEGMENT
+{
+    size_t uxDataLength;
+    uint16_t usIPLength;
+    uint16_t usIdentification;
+    uint32_t ulSequenceNumber;
+    uint8_t ucTCPFlags;
+    uint8_t ucFirstData;
+    BaseType_t xReleaseAfterSend;
+} SentSegment_t;
+
+static SentSegment_t xSent[ 4 ];
+static BaseType_t xSentCount;
+
+static FreeRTOS_Socket_t xSocket, * pxSocket;
+static NetworkBufferDescriptor_t xLargeBuffer, xSegmentBuffer, * pxNetworkBuffer;
+static uint8_t ucLargeBuffer[ HEADER_LENGTH + ( 3U * TEST_MSS ) ];
+static uint8_t ucSegmentBuffer[ ipconfigNETWORK_MTU ];
+static StreamBuffer_t xStreamBuffer;
+
+void setUp( void )
+{
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    memset( &xLargeBuffer, 0, sizeof( xLargeBuffer ) );
+    memset( &xSegmentBuffer, 0, sizeof( xSegmentBuffer ) );
+    memset( ucLargeBuffer, 0, sizeof( ucLargeBuffer ) );
+    memset( ucSegmentBuffer, 0, sizeof( ucSegmentBuffer ) );
+    memset( xSent, 0, sizeof( xSent ) );
+    xSentCount = 0;
+
+    xLargeBuffer.pucEthernetBuffer = ucLargeBuffer;
+    xSegmentBuffer.pucEthernetBuffer = ucSegmentBuffer;
+    xBufferAllocFixedSize = pdFALSE;
+    usPacketIdentifier = 0U;
+
+    pxSocket = &xSocket;
+    pxSocket->u.xTCP.eTCPState = eESTABLISHED;
+    pxSocket->u.xTCP.usMSS = TEST_MSS;
+    pxSocket->u.xTCP.ulWindowSize = 8U * TEST_MSS;
+    pxSocket->u.xTCP.txStream = &xStreamBuffer;
+    pxSocket->u.xTCP.xTCPWindow.usMSS = TEST_MSS;
+}
+
+/* ulTCPWindowTxGet() returns full-sized segments, and sets the sequence number
+ * of the one returned, as the real one does. */
+static uint32_t ulTCPWindowTxGet_Segment( TCPWindow_t * pxWindow,
+                                          uint32_t ulWindowSize,
+                                          int32_t * plPosition,
+                                          int cmock_num_calls )
+{
+    ( void ) ulWindowSize;
+
+    pxWindow->ulOurSequenceNumber = pxWindow->tx.ulHighestSequenceNumber;
+    pxWindow->tx.ulHighestSequenceNumber += TEST_MSS;
+    *plPosition = ( int32_t ) ( ( uint32_t ) cmock_num_calls * TEST_MSS );
+
+    return TEST_MSS;
+}
+
+/* Copies the data, so that every segment can be recognised by its first byte. */
+static size_t uxStreamBufferGet_Data( StreamBuffer_t * pxBuffer,
+                                      size_t uxOffset,
+                                      uint8_t * pucData,
+                                      size_t uxMaxCount,
+                                      BaseType_t xPeek,
+                                      int cmock_num_calls )
+{
+    ( void ) pxBuffer;
+    ( void ) uxOffset;
+    ( void ) xPeek;
+
+    memset( pucData, 0xA0 + cmock_num_calls, uxMaxCount );
+
+    return uxMaxCount;
+}
+
+static BaseType_t xNetworkInterfaceOutput_Record( NetworkBufferDescriptor_t * const pxDescriptor,
+                                                  BaseType_t xReleaseAfterSend,
+                                                  int cmock_num_calls )
+{
+    const TCPPacket_t * pxTCPPacket = ( const TCPPacket_t * ) pxDescriptor->pucEthernetBuffer;
+
+    ( void ) cmock_num_calls;
+
+    TEST_ASSERT_LESS_THAN( 4, xSentCount );
+
+    xSent[ xSentCount ].uxDataLength = pxDescriptor->xDataLength;
+    xSent[ xSentCount ].usIPLength = FreeRTOS_ntohs( pxTCPPacket->xIPHeader.usLength );
+    xSent[ xSentCount ].usIdentification = FreeRTOS_ntohs( pxTCPPacket->xIPHeader.usIdentification );
+    xSent[ xSentCount ].ulSequenceNumber = FreeRTOS_ntohl( pxTCPPacket->xTCPHeader.ulSequenceNumber );
+    xSent[ xSentCount ].ucTCPFlags = pxTCPPacket->xTCPHeader.ucTCPFlags;
+    xSent[ xSentCount ].ucFirstData = pxDescriptor->pucEthernetBuffer[ HEADER_LENGTH ];
+    xSent[ xSentCount ].xReleaseAfterSend = xReleaseAfterSend;
+    xSentCount++;
+
+    return pdTRUE;
+}
+
+static size_t FreeRTOS_min_size_t_Real( size_t a,
+                                        size_t b,
+                                        int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return ( a < b ) ? a : b;
+}
+
+static size_t FreeRTOS_max_size_t_Real( size_t a,
+                                        size_t b,
+                                        int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return ( a > b ) ? a : b;
+}
+
+/* Fill ucLargeBuffer with a large send of 'uxDataLength' bytes, in segments of
+ * 'usSegmentSize' bytes. Data byte 'n' of every segment has the value 'n'. */
+static void prvMakeLargeSend( size_t uxDataLength,
+                              uint16_t usSegmentSize,
+                              uint8_t ucTCPFlags )
+{
+    TCPPacket_t * pxTCPPacket = ( TCPPacket_t * ) ucLargeBuffer;
+    size_t uxIndex;
+
+    pxTCPPacket->xIPHeader.ucVersionHeaderLength = 0x45U;
+    pxTCPPacket->xIPHeader.usLength = FreeRTOS_htons( ( uint16_t ) ( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + uxDataLength ) );
+    pxTCPPacket->xIPHeader.usIdentification = FreeRTOS_htons( 0x1000U );
+    pxTCPPacket->xTCPHeader.ucTCPOffset = ( uint8_t ) ( ipSIZE_OF_TCP_HEADER << 2 );
+    pxTCPPacket->xTCPHeader.ucTCPFlags = ucTCPFlags;
+    pxTCPPacket->xTCPHeader.ulSequenceNumber = FreeRTOS_htonl( 5000U );
+
+    for( uxIndex = 0U; uxIndex < uxDataLength; uxIndex++ )
+    {
+        ucLargeBuffer[ HEADER_LENGTH + uxIndex ] = ( uint8_t ) ( uxIndex / usSegmentSize );
+    }
+
+    xLargeBuffer.xDataLength = HEADER_LENGTH + uxDataLength;
+    xLargeBuffer.usSegmentSize = usSegmentSize;
+}
+
+/* test for prvTCPPrepareLargeSend function */
+void test_prvTCPPrepareLargeSend_Three_Segments( void )
+{
+    TCPWindow_t * pxTCPWindow = &( pxSocket->u.xTCP.xTCPWindow );
+    UBaseType_t uxSegmentCount = SEND_REPEATED_COUNT;
+    int32_t lSendLength;
+
+    pxNetworkBuffer = NULL;
+    pxTCPWindow->tx.ulHighestSequenceNumber = 10000U;
+    pxTCPWindow->ulNextTxSequenceNumber = 10000U + ( 3U * TEST_MSS );
+    pxTCPWindow->ulOurSequenceNumber = 9000U;
+
+    ulTCPWindowTxGet_Stub( ulTCPWindowTxGet_Segment );
+    uxStreamBufferDistance_IgnoreAndReturn( 0U );
+    uxStreamBufferGet_Stub( uxStreamBufferGet_Data );
+
+    /* The buffer is made large enough for all data, before the first segment. */
+    xTCPWindowTxHasFollowing_ExpectAndReturn( pxTCPWindow, 8U * TEST_MSS, 10000U, pdTRUE );
+    FreeRTOS_min_uint32_ExpectAndReturn( 3U * TEST_MSS, SEND_REPEATED_COUNT * TEST_MSS, 3U * TEST_MSS );
+    pxGetNetworkBufferWithDescriptor_ExpectAndReturn( HEADER_LENGTH + ( 3U * TEST_MSS ), 0U, &xLargeBuffer );
+
+    /* The segments that follow. */
+    xTCPWindowTxHasFollowing_ExpectAndReturn( pxTCPWindow, 8U * TEST_MSS, 11000U, pdTRUE );
+    xTCPWindowTxHasFollowing_ExpectAndReturn( pxTCPWindow, 8U * TEST_MSS, 12000U, pdTRUE );
+
+    lSendLength = prvTCPPrepareLargeSend( pxSocket, &pxNetworkBuffer, 0U, &uxSegmentCount );
+
+    TEST_ASSERT_EQUAL( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + ( 3U * TEST_MSS ), lSendLength );
+    TEST_ASSERT_EQUAL( 3U, uxSegmentCount );
+    TEST_ASSERT_EQUAL_PTR( &xLargeBuffer, pxNetworkBuffer );
+    TEST_ASSERT_EQUAL( TEST_MSS, xLargeBuffer.usSegmentSize );
+    TEST_ASSERT_EQUAL( 10000U, pxTCPWindow->ulOurSequenceNumber );
+
+    /* The data of the segments follow each other. */
+    TEST_ASSERT_EQUAL_HEX8( 0xA0U, ucLargeBuffer[ HEADER_LENGTH ] );
+    TEST_ASSERT_EQUAL_HEX8( 0xA1U, ucLargeBuffer[ HEADER_LENGTH + TEST_MSS ] );
+    TEST_ASSERT_EQUAL_HEX8( 0xA2U, ucLargeBuffer[ HEADER_LENGTH + ( 3U * TEST_MSS ) - 1U ] );
+}
+
+/* test for prvTCPPrepareLargeSend function */
+void test_prvTCPPrepareLargeSend_One_Segment_Of_Data( void )
+{
+    TCPWindow_t * pxTCPWindow = &( pxSocket->u.xTCP.xTCPWindow );
+    UBaseType_t uxSegmentCount = SEND_REPEATED_COUNT;
+    int32_t lSendLength;
+
+    /* A buffer that still holds a previous large send. */
+    pxNetworkBuffer = &xLargeBuffer;
+    xLargeBuffer.xDataLength = sizeof( ucLargeBuffer );
+    xLargeBuffer.usSegmentSize = TEST_MSS;
+    pxTCPWindow->tx.ulHighestSequenceNumber = 10000U;
+    pxTCPWindow->ulNextTxSequenceNumber = 10000U + TEST_MSS;
+
+    ulTCPWindowTxGet_Stub( ulTCPWindowTxGet_Segment );
+    uxStreamBufferDistance_IgnoreAndReturn( 0U );
+    uxStreamBufferGet_Stub( uxStreamBufferGet_Data );
+
+    lSendLength = prvTCPPrepareLargeSend( pxSocket, &pxNetworkBuffer, 0U, &uxSegmentCount );
+
+    TEST_ASSERT_EQUAL( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + TEST_MSS, lSendLength );
+    TEST_ASSERT_EQUAL( 1U, uxSegmentCount );
+    TEST_ASSERT_EQUAL_PTR( &xLargeBuffer, pxNetworkBuffer );
+    TEST_ASSERT_EQUAL( 0U, xLargeBuffer.usSegmentSize );
+}
+
+/* test for prvTCPPrepareLargeSend function */
+void test_prvTCPPrepareLargeSend_Retransmission_First( void )
+{
+    TCPWindow_t * pxTCPWindow = &( pxSocket->u.xTCP.xTCPWindow );
+    UBaseType_t uxSegmentCount = SEND_REPEATED_COUNT;
+    int32_t lSendLength;
+
+    pxNetworkBuffer = &xLargeBuffer;
+    xLargeBuffer.xDataLength = sizeof( ucLargeBuffer );
+    pxTCPWindow->tx.ulHighestSequenceNumber = 10000U;
+    pxTCPWindow->ulNextTxSequenceNumber = 10000U + ( 3U * TEST_MSS );
+
+    ulTCPWindowTxGet_Stub( ulTCPWindowTxGet_Segment );
+    uxStreamBufferDistance_IgnoreAndReturn( 0U );
+    uxStreamBufferGet_Stub( uxStreamBufferGet_Data );
+
+    /* ulTCPWindowTxGet() will not return new data: send one segment. */
+    xTCPWindowTxHasFollowing_ExpectAndReturn( pxTCPWindow, 8U * TEST_MSS, 10000U, pdFALSE );
+
+    lSendLength = prvTCPPrepareLargeSend( pxSocket, &pxNetworkBuffer, 0U, &uxSegmentCount );
+
+    TEST_ASSERT_EQUAL( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + TEST_MSS, lSendLength );
+    TEST_ASSERT_EQUAL( 1U, uxSegmentCount );
+    TEST_ASSERT_EQUAL( 0U, xLargeBuffer.usSegmentSize );
+}
+
+/* test for prvTCPPrepareLargeSend function */
+void test_prvTCPPrepareLargeSend_Fixed_Size_Buffers( void )
+{
+    TCPWindow_t * pxTCPWindow = &( pxSocket->u.xTCP.xTCPWindow );
+    UBaseType_t uxSegmentCount = SEND_REPEATED_COUNT;
+    int32_t lSendLength;
+
+    xBufferAllocFixedSize = pdTRUE;
+    pxNetworkBuffer = &xLargeBuffer;
+    pxTCPWindow->tx.ulHighestSequenceNumber = 10000U;
+    pxTCPWindow->ulNextTxSequenceNumber = 10000U + ( 3U * TEST_MSS );
+
+    ulTCPWindowTxGet_Stub( ulTCPWindowTxGet_Segment );
+    uxStreamBufferDistance_IgnoreAndReturn( 0U );
+    uxStreamBufferGet_Stub( uxStreamBufferGet_Data );
+
+    lSendLength = prvTCPPrepareLargeSend( pxSocket, &pxNetworkBuffer, 0U, &uxSegmentCount );
+
+    TEST_ASSERT_EQUAL( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + TEST_MSS, lSendLength );
+    TEST_ASSERT_EQUAL( 1U, uxSegmentCount );
+}
+
+/* test for prvTCPSendSegmented function */
+void test_prvTCPSendSegmented_In_Place( void )
+{
+    /* Two segments of 300 bytes and a short one of 100 bytes, which is
+     * copied to a network buffer of its own, so it can be padded. */
+    prvMakeLargeSend( 700U, 300U, tcpTCP_FLAG_ACK | tcpTCP_FLAG_FIN );
+
+    FreeRTOS_min_size_t_Stub( FreeRTOS_min_size_t_Real );
+    FreeRTOS_max_size_t_Stub( FreeRTOS_max_size_t_Real );
+    usGenerateChecksum_IgnoreAndReturn( 0x1234U );
+    usGenerateProtocolChecksum_IgnoreAndReturn( 0x2345U );
+    xNetworkInterfaceOutput_Stub( xNetworkInterfaceOutput_Record );
+    pxGetNetworkBufferWithDescriptor_ExpectAndReturn( ipconfigETHERNET_MINIMUM_PACKET_BYTES, 0U, &xSegmentBuffer );
+
+    prvTCPSendSegmented( &xLargeBuffer, pdFALSE );
+
+    TEST_ASSERT_EQUAL( 3, xSentCount );
+
+    TEST_ASSERT_EQUAL( HEADER_LENGTH + 300U, xSent[ 0 ].uxDataLength );
+    TEST_ASSERT_EQUAL( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + 300U, xSent[ 0 ].usIPLength );
+    TEST_ASSERT_EQUAL( 0x1000U, xSent[ 0 ].usIdentification );
+    TEST_ASSERT_EQUAL( 5000U, xSent[ 0 ].ulSequenceNumber );
+    TEST_ASSERT_EQUAL_HEX8( tcpTCP_FLAG_ACK, xSent[ 0 ].ucTCPFlags );
+    TEST_ASSERT_EQUAL( 0U, xSent[ 0 ].ucFirstData );
+    TEST_ASSERT_EQUAL( pdFALSE, xSent[ 0 ].xReleaseAfterSend );
+
+    TEST_ASSERT_EQUAL( HEADER_LENGTH + 300U, xSent[ 1 ].uxDataLength );
+    TEST_ASSERT_EQUAL( 0x1001U, xSent[ 1 ].usIdentification );
+    TEST_ASSERT_EQUAL( 5300U, xSent[ 1 ].ulSequenceNumber );
+    TEST_ASSERT_EQUAL_HEX8( tcpTCP_FLAG_ACK, xSent[ 1 ].ucTCPFlags );
+    TEST_ASSERT_EQUAL( 1U, xSent[ 1 ].ucFirstData );
+    TEST_ASSERT_EQUAL( pdFALSE, xSent[ 1 ].xReleaseAfterSend );
+
+    /* The last segment carries the FIN flag, and is padded. */
+    TEST_ASSERT_EQUAL( ipconfigETHERNET_MINIMUM_PACKET_BYTES, xSent[ 2 ].uxDataLength );
+    TEST_ASSERT_EQUAL( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + 100U, xSent[ 2 ].usIPLength );
+    TEST_ASSERT_EQUAL( 0x1002U, xSent[ 2 ].usIdentification );
+    TEST_ASSERT_EQUAL( 5600U, xSent[ 2 ].ulSequenceNumber );
+    TEST_ASSERT_EQUAL_HEX8( tcpTCP_FLAG_ACK | tcpTCP_FLAG_FIN, xSent[ 2 ].ucTCPFlags );
+    TEST_ASSERT_EQUAL( 2U, xSent[ 2 ].ucFirstData );
+    TEST_ASSERT_EQUAL( pdTRUE, xSent[ 2 ].xReleaseAfterSend );
+
+    /* The headers of the large send can be used again. */
+    TEST_ASSERT_EQUAL_HEX8( tcpTCP_FLAG_ACK | tcpTCP_FLAG_FIN, ( ( TCPPacket_t * ) ucLargeBuffer )->xTCPHeader.ucTCPFlags );
+}
+
+/* test for prvTCPSendSegmented function */
+void test_prvTCPSendSegmented_Release_After_Send( void )
+{
+    prvMakeLargeSend( 600U, 300U, tcpTCP_FLAG_ACK );
+
+    FreeRTOS_min_size_t_Stub( FreeRTOS_min_size_t_Real );
+    FreeRTOS_max_size_t_Stub( FreeRTOS_max_size_t_Real );
+    usGenerateChecksum_IgnoreAndReturn( 0x1234U );
+    usGenerateProtocolChecksum_IgnoreAndReturn( 0x2345U );
+    xNetworkInterfaceOutput_Stub( xNetworkInterfaceOutput_Record );
+
+    /* The large send belongs to the network interface: every segment gets a
+     * network buffer of its own. */
+    pxGetNetworkBufferWithDescriptor_ExpectAndReturn( HEADER_LENGTH + 300U, 0U, &xSegmentBuffer );
+    pxGetNetworkBufferWithDescriptor_ExpectAndReturn( HEADER_LENGTH + 300U, 0U, &xSegmentBuffer );
+    vReleaseNetworkBufferAndDescriptor_Expect( &xLargeBuffer );
+
+    prvTCPSendSegmented( &xLargeBuffer, pdTRUE );
+
+    TEST_ASSERT_EQUAL( 2, xSentCount );
+    TEST_ASSERT_EQUAL( 5000U, xSent[ 0 ].ulSequenceNumber );
+    TEST_ASSERT_EQUAL( 0U, xSent[ 0 ].ucFirstData );
+    TEST_ASSERT_EQUAL( pdTRUE, xSent[ 0 ].xReleaseAfterSend );
+    TEST_ASSERT_EQUAL( 5300U, xSent[ 1 ].ulSequenceNumber );
+    TEST_ASSERT_EQUAL( 1U, xSent[ 1 ].ucFirstData );
+    TEST_ASSERT_EQUAL( pdTRUE, xSent[ 1 ].xReleaseAfterSend );
+}
+
+/* test for prvTCPSendSegmented function */
+void test_prvTCPSendSegmented_No_Network_Buffer( void )
+{
+    prvMakeLargeSend( 600U, 300U, tcpTCP_FLAG_ACK );
+
+    FreeRTOS_min_size_t_Stub( FreeRTOS_min_size_t_Real );
+    FreeRTOS_max_size_t_Stub( FreeRTOS_max_size_t_Real );
+    pxGetNetworkBufferWithDescriptor_ExpectAndReturn( HEADER_LENGTH + 300U, 0U, NULL );
+    vReleaseNetworkBufferAndDescriptor_Expect( &xLargeBuffer );
+
+    prvTCPSendSegmented( &xLargeBuffer, pdTRUE );
+}
+
+/* test for prvTCPReturnPacket function */
+void test_prvTCPReturnPacket_Large_Send_Interface_Segments( void )
+{
+    prvMakeLargeSend( 3U * TEST_MSS, TEST_MSS, tcpTCP_FLAG_ACK );
+    pxSocket->u.xTCP.xTCPWindow.ulOurSequenceNumber = 7000U;
+
+    FreeRTOS_min_uint32_ExpectAnyArgsAndReturn( 500 );
+    eARPGetCacheEntry_ExpectAnyArgsAndReturn( eARPCacheHit );
+    uxNetworkInterfaceGetCapabilities_ExpectAndReturn( ipNETWORK_CAPABILITY_TCP_SEGMENTATION );
+    xNetworkInterfaceOutput_Stub( xNetworkInterfaceOutput_Record );
+
+    /* No checksums are calculated for a large send. */
+    prvTCPReturnPacket( pxSocket, &xLargeBuffer, ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + ( 3U * TEST_MSS ), pdFALSE );
+
+    TEST_ASSERT_EQUAL( 1, xSentCount );
+    TEST_ASSERT_EQUAL( HEADER_LENGTH + ( 3U * TEST_MSS ), xSent[ 0 ].uxDataLength );
+    TEST_ASSERT_EQUAL( 7000U, xSent[ 0 ].ulSequenceNumber );
+    TEST_ASSERT_EQUAL( 0U, xSent[ 0 ].usIdentification );
+
+    /* Every segment used an identification number. */
+    TEST_ASSERT_EQUAL( 3U, usPacketIdentifier );
+    TEST_ASSERT_EQUAL( 0U, xLargeBuffer.usSegmentSize );
+}
+
+/* test for prvTCPReturnPacket function */
+void test_prvTCPReturnPacket_Large_Send_Software_Segments( void )
+{
+    prvMakeLargeSend( 2U * TEST_MSS, TEST_MSS, tcpTCP_FLAG_ACK );
+    pxSocket->u.xTCP.xTCPWindow.ulOurSequenceNumber = 7000U;
+
+    FreeRTOS_min_uint32_ExpectAnyArgsAndReturn( 500 );
+    eARPGetCacheEntry_ExpectAnyArgsAndReturn( eARPCacheHit );
+    uxNetworkInterfaceGetCapabilities_ExpectAndReturn( 0U );
+    FreeRTOS_min_size_t_Stub( FreeRTOS_min_size_t_Real );
+    usGenerateChecksum_IgnoreAndReturn( 0x1234U );
+    usGenerateProtocolChecksum_IgnoreAndReturn( 0x2345U );
+    xNetworkInterfaceOutput_Stub( xNetworkInterfaceOutput_Record );
+
+    prvTCPReturnPacket( pxSocket, &xLargeBuffer, ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + ( 2U * TEST_MSS ), pdFALSE );
+
+    TEST_ASSERT_EQUAL( 2, xSentCount );
+    TEST_ASSERT_EQUAL( 7000U, xSent[ 0 ].ulSequenceNumber );
+    TEST_ASSERT_EQUAL( 0U, xSent[ 0 ].usIdentification );
+    TEST_ASSERT_EQUAL( 7000U + TEST_MSS, xSent[ 1 ].ulSequenceNumber );
+    TEST_ASSERT_EQUAL( 1U, xSent[ 1 ].usIdentification );
+    TEST_ASSERT_EQUAL( 2U, usPacketIdentifier );
+}
@@ -0,0 +1,42 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * heap_5.c built with its functions renamed, so the heap benchmark in
+ * main_benchmark.c can link it alongside the heap_3.c used by the rest of the
+ * demo.  The renamed functions are declared in benchmark_heaps.h.
+ */
+
+#define pvPortMalloc                       pvBenchmarkHeap5Malloc
+#define vPortFree                          vBenchmarkHeap5Free
+#define pvPortCalloc                       pvBenchmarkHeap5Calloc
+#define xPortGetFreeHeapSize               xBenchmarkHeap5GetFreeHeapSize
+#define xPortGetMinimumEverFreeHeapSize    xBenchmarkHeap5GetMinimumEverFreeHeapSize
+#define vPortDefineHeapRegions             vBenchmarkHeap5DefineHeapRegions
+#define vPortGetHeapStats                  vBenchmarkHeap5GetHeapStats
+#define vApplicationMallocFailedHook       vBenchmarkHeapMallocFailedHook
+
+#include "../../../Source/portable/MemMang/heap_5.c"
@@ -0,0 +1,48 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef BENCHMARK_HEAPS_H
+#define BENCHMARK_HEAPS_H
+
+/*
+ * The functions of heap_5.c and heap_6.c, as renamed by benchmark_heap_5.c
+ * and benchmark_heap_6.c.  Both call vBenchmarkHeapMallocFailedHook() in
+ * place of vApplicationMallocFailedHook().
+ */
+
+void * pvBenchmarkHeap5Malloc( size_t xWantedSize );
+void vBenchmarkHeap5Free( void * pv );
+void vBenchmarkHeap5DefineHeapRegions( const HeapRegion_t * const pxHeapRegions );
+void vBenchmarkHeap5GetHeapStats( HeapStats_t * pxHeapStats );
+
+void * pvBenchmarkHeap6Malloc( size_t xWantedSize );
+void vBenchmarkHeap6Free( void * pv );
+void vBenchmarkHeap6DefineHeapRegions( const HeapRegion_t * const pxHeapRegions );
+void vBenchmarkHeap6GetHeapStats( HeapStats_t * pxHeapStats );
+
+void vBenchmarkHeapMallocFailedHook( void );
+
+#endif /* BENCHMARK_HEAPS_H */
@@ -51,12 +51,21 @@
 #define configIDLE_SHOULD_YIELD                    1
 #define configUSE_MUTEXES                          1
 #define configCHECK_FOR_STACK_OVERFLOW             0
+#define configUSE_STACK_HIGH_WATER_TRACKING        1
+#define configSTACK_PRESSURE_THRESHOLD             2048 /* Words, so 16KB on this 64-bit port. */
+#define configSTACK_HIGH_WATER_SCAN_GAP            512  /* Signals are handled on the task stacks, and Linux does not write all of each signal frame. */
 #define configUSE_RECURSIVE_MUTEXES                1
 #define configQUEUE_REGISTRY_SIZE                  20
 #define configUSE_APPLICATION_TASK_TAG             1
 #define configUSE_COUNTING_SEMAPHORES              1
 #define configUSE_ALTERNATIVE_API                  0
 #define configUSE_QUEUE_SETS                       1
+#define configUSE_SPSC_QUEUES                      1
+#define configUSE_QUEUE_BATCHING                   1
+#define configUSE_QUEUE_RECEIVE_ANY                1
+#define configUSE_OBJECT_POOLS                     1
+#define configUSE_RW_LOCKS                         1
+#define configUSE_WORK_QUEUES                      1
 #define configUSE_TASK_NOTIFICATIONS               1
 #define configSUPPORT_STATIC_ALLOCATION            1
 
@@ -68,13 +77,40 @@
 #define configTIMER_TASK_PRIORITY                  ( configMAX_PRIORITIES - 1 )
 #define configTIMER_QUEUE_LENGTH                   20
 #define configTIMER_TASK_STACK_DEPTH               ( configMINIMAL_STACK_SIZE * 2 )
+#define configUSE_TIMER_COALESCING                 1
+#define configTIMER_COMMAND_BATCH_SIZE             8
 
 #define configMAX_PRIORITIES                       ( 7 )
 
+/* Multi-core configuration.  The SMP demo passes the number of cores on the
+ * command line (make USER_DEMO=SMP_DEMO SMP_CORES=n), otherwise the kernel is
+ * built for a single core. */
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES                  1
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+    #define configUSE_CORE_AFFINITY                1
+    #define configUSE_PASSIVE_IDLE_HOOK            0
+#endif
+
 /* Run time stats gathering configuration options. */
 unsigned long ulGetRunTimeCounterValue( void ); /* Prototype of function that returns run time counter. */
 void vConfigureTimerForRunTimeStats( void );    /* Prototype of function that initialises the run time counter. */
 #define configGENERATE_RUN_TIME_STATS             1
+#define configUSE_TASK_PERF_COUNTERS              1
+#define configLATENCY_HISTOGRAM_BUCKETS           24
+
+/* The run time counter of the port counts CPU time in clock ticks, which is far
+ * too coarse to time scheduling latencies, so builds with the latency histograms
+ * (make LATENCY_HISTOGRAMS=1) use the nanosecond counter implemented in
+ * run-time-stats-utils.c.  The last of the 24 buckets then counts latencies of
+ * 4ms or more. */
+#if defined( configUSE_LATENCY_HISTOGRAMS ) && ( configUSE_LATENCY_HISTOGRAMS == 1 )
+    #define configRUN_TIME_COUNTER_TYPE                 uint64_t
+    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    vConfigureTimerForRunTimeStats()
+    #define portGET_RUN_TIME_COUNTER_VALUE()            ulGetRunTimeCounterValue()
+#endif
 
 /* This demo can use of one or more example stats formatting functions.  These
  * format the raw data provided by the uxTaskGetSystemState() function in to human
@@ -123,6 +159,12 @@ extern void vAssertCalled( const char * const pcFileName,
     #error projCOVERAGE_TEST should be defined to 1 or 0 on the command line.
 #endif
 
+/* projENABLE_TRACE_RECORDER is also defined on the command line, as the trace
+ * recorder is not used by every demo. */
+#ifndef projENABLE_TRACE_RECORDER
+    #error projENABLE_TRACE_RECORDER should be defined to 1 or 0 on the command line.
+#endif
+
 #if ( projCOVERAGE_TEST == 1 )
 
 /* Insert NOPs in empty decision paths to ensure both true and false paths
@@ -148,10 +190,36 @@ extern void vAssertCalled( const char * const pcFileName,
 
     #define configUSE_MALLOC_FAILED_HOOK    1
 
-/* Include the FreeRTOS+Trace FreeRTOS trace macro definitions. */
-    #include "trcRecorder.h"
+/* Include the FreeRTOS+Trace FreeRTOS trace macro definitions if the recorder
+ * is used by the selected demo. */
+    #if ( projENABLE_TRACE_RECORDER == 1 )
+        #include "trcRecorder.h"
+    #endif
 #endif /* if ( projCOVERAGE_TEST == 1 ) */
 
+/* The benchmarks time sections of the kernel using the trace macros.  See
+ * main_benchmark.c. */
+#if ( projENABLE_BENCHMARK_TRACE == 1 )
+    void vBenchmarkTraceTaskDelay( void );
+    void vBenchmarkTraceEventGroupSetBits( void );
+    void vBenchmarkTraceTaskSwitchedIn( void );
+    void vBenchmarkTraceTaskSwitchedOut( void );
+    #define traceTASK_DELAY()           vBenchmarkTraceTaskDelay()
+    #define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )    vBenchmarkTraceEventGroupSetBits()
+    #define traceTASK_SWITCHED_IN()     vBenchmarkTraceTaskSwitchedIn()
+    #define traceTASK_SWITCHED_OUT()    vBenchmarkTraceTaskSwitchedOut()
+#endif
+
+/* Every allocation and free can be written to a file for replay by the heap
+ * benchmark.  See main.c and main_benchmark.c. */
+#if ( projRECORD_HEAP_TRACE == 1 )
+    void vHeapTraceRecordMalloc( void * pvAddress,
+                                 size_t xSize );
+    void vHeapTraceRecordFree( void * pvAddress );
+    #define traceMALLOC( pvAddress, uiSize )    vHeapTraceRecordMalloc( pvAddress, uiSize )
+    #define traceFREE( pvAddress, uiSize )      vHeapTraceRecordFree( pvAddress )
+#endif
+
 /* networking definitions */
 #define configMAC_ISR_SIMULATOR_PRIORITY    ( configMAX_PRIORITIES - 1 )
 
@@ -36,6 +36,17 @@
  * If mainSELECTED_APPLICATION = FULL_DEMO the more comprehensive test and demo
  * application built. This is implemented and described in main_full.c.
  *
+ * If mainSELECTED_APPLICATION = SMP_DEMO a multi-core scheduling demo is built
+ * with configNUMBER_OF_CORES cores. This is implemented and described in
+ * main_smp.c.
+ *
+ * If mainSELECTED_APPLICATION = BENCHMARK_DEMO a set of kernel benchmarks is
+ * built.  These are implemented and described in main_benchmark.c.
+ *
+ * If the project is built with RECORD_HEAP_TRACE=1 every allocation and free
+ * made by the selected demo is written to heap_trace.txt, in the format read
+ * by the heap benchmark in main_benchmark.c.
+ *
  * This file implements the code that is not demo specific, including the
  * hardware setup and FreeRTOS hook functions.
  *
@@ -68,12 +79,18 @@
 /* Local includes. */
 #include "console.h"
 
-#if ( projCOVERAGE_TEST != 1 )
+/* The trace recorder is not used by every demo. */
+#if ( projCOVERAGE_TEST != 1 ) && ( projENABLE_TRACE_RECORDER == 1 )
+    #define mainUSE_TRACE_RECORDER    1
     #include <trcRecorder.h>
+#else
+    #define mainUSE_TRACE_RECORDER    0
 #endif
 
-#define    BLINKY_DEMO    0
-#define    FULL_DEMO      1
+#define    BLINKY_DEMO       0
+#define    FULL_DEMO         1
+#define    SMP_DEMO          2
+#define    BENCHMARK_DEMO    3
 
 #ifdef BUILD_DIR
     #define BUILD         BUILD_DIR
@@ -93,6 +110,8 @@
 /*-----------------------------------------------------------*/
 extern void main_blinky( void );
 extern void main_full( void );
+extern void main_smp( void );
+extern void main_benchmark( void );
 static void traceOnEnter( void );
 
 /*
@@ -110,6 +129,8 @@ void vApplicationMallocFailedHook( void );
 void vApplicationIdleHook( void );
 void vApplicationStackOverflowHook( TaskHandle_t pxTask,
                                     char * pcTaskName );
+void vApplicationStackPressureHook( TaskHandle_t xTask,
+                                    configSTACK_DEPTH_TYPE uxFreeStack );
 void vApplicationTickHook( void );
 void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
                                     StackType_t ** ppxIdleTaskStackBuffer,
@@ -117,6 +138,12 @@ void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
 void vApplicationGetTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
                                      StackType_t ** ppxTimerTaskStackBuffer,
                                      uint32_t * pulTimerTaskStackSize );
+#if ( configNUMBER_OF_CORES > 1 )
+    void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                               StackType_t ** ppxIdleTaskStackBuffer,
+                                               uint32_t * pulIdleTaskStackSize,
+                                               BaseType_t xPassiveIdleTaskIndex );
+#endif
 
 /*
  * Writes trace data to a disk file when the trace recording is stopped.
@@ -130,6 +157,16 @@ static void prvSaveTraceFile( void );
  */
 static void handle_sigint( int signal );
 
+/*
+ * Called by the traceMALLOC() and traceFREE() macros defined in
+ * FreeRTOSConfig.h to write the heap trace.
+ */
+#if ( projRECORD_HEAP_TRACE == 1 )
+    void vHeapTraceRecordMalloc( void * pvAddress,
+                                 size_t xSize );
+    void vHeapTraceRecordFree( void * pvAddress );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* When configSUPPORT_STATIC_ALLOCATION is set to 1 the application writer can
@@ -140,7 +177,7 @@ static void handle_sigint( int signal );
 StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
 
 /* Notes if the trace is running or not. */
-#if ( projCOVERAGE_TEST == 1 )
+#if ( mainUSE_TRACE_RECORDER == 0 )
     static BaseType_t xTraceRunning = pdFALSE;
 #else
     static BaseType_t xTraceRunning = pdTRUE;
@@ -148,6 +185,19 @@ StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
 
 static clockid_t cid = CLOCK_THREAD_CPUTIME_ID;
 
+#if ( projRECORD_HEAP_TRACE == 1 )
+
+/* The heap trace file, and the blocks that are currently allocated.  A block
+ * is identified in the trace by the index it occupies in pvHeapTraceBlocks[],
+ * so the trace can be replayed without recording addresses.  Allocations made
+ * while all mainHEAP_TRACE_MAX_BLOCKS entries are in use are not recorded, but
+ * are counted in ulHeapTraceDroppedBlocks. */
+    #define mainHEAP_TRACE_MAX_BLOCKS    ( 4096 )
+    static FILE * pxHeapTraceFile = NULL;
+    static void * pvHeapTraceBlocks[ mainHEAP_TRACE_MAX_BLOCKS ];
+    static unsigned long ulHeapTraceDroppedBlocks = 0;
+#endif
+
 /*-----------------------------------------------------------*/
 
 int main( void )
@@ -156,7 +206,7 @@ int main( void )
     signal( SIGINT, handle_sigint );
 
     /* Do not include trace code when performing a code coverage analysis. */
-    #if ( projCOVERAGE_TEST != 1 )
+    #if ( mainUSE_TRACE_RECORDER == 1 )
         {
             /* Initialise the trace recorder.  Use of the trace recorder is optional.
              * See http://www.FreeRTOS.org/trace for more information. */
@@ -170,7 +220,7 @@ int main( void )
                 printf( "\r\nThe trace will be dumped to disk if Enter is hit.\r\n" );
             #endif
         }
-    #endif /* if ( projCOVERAGE_TEST != 1 ) */
+    #endif /* if ( mainUSE_TRACE_RECORDER == 1 ) */
 
     console_init();
     #if ( mainSELECTED_APPLICATION == BLINKY_DEMO )
@@ -183,6 +233,16 @@ int main( void )
             console_print( "Starting full demo\n" );
             main_full();
         }
+    #elif ( mainSELECTED_APPLICATION == SMP_DEMO )
+        {
+            console_print( "Starting SMP demo on %d cores\n", configNUMBER_OF_CORES );
+            main_smp();
+        }
+    #elif ( mainSELECTED_APPLICATION == BENCHMARK_DEMO )
+        {
+            console_print( "Starting benchmarks\n" );
+            main_benchmark();
+        }
     #else
         {
             #error "The selected demo is not valid"
@@ -223,8 +283,15 @@ void vApplicationIdleHook( void )
      * because it is the responsibility of the idle task to clean up memory
      * allocated by the kernel to any task that has since deleted itself. */
 
+    #if ( configPOSIX_VIRTUAL_TIME == 0 )
+        {
+            /* Let the host run other processes until the next tick.  In
+             * virtual time the idle task skips straight to the next timeout
+             * instead. */
+            usleep( 15000 );
+        }
+    #endif
 
-    usleep( 15000 );
     traceOnEnter();
 
     #if ( mainSELECTED_APPLICATION == FULL_DEMO )
@@ -252,6 +319,21 @@ void vApplicationStackOverflowHook( TaskHandle_t pxTask,
 }
 /*-----------------------------------------------------------*/
 
+void vApplicationStackPressureHook( TaskHandle_t xTask,
+                                    configSTACK_DEPTH_TYPE uxFreeStack )
+{
+    /* Called if configSTACK_PRESSURE_THRESHOLD is greater than zero when the
+     * stack high water mark of a task leaves that many words or fewer unused.
+     * The POSIX port does not save the stack pointer of a task when it is
+     * switched out, so the mark only moves when
+     * uxTaskGetStackHighWaterMarkIncremental() is called, and it is safe to
+     * print from here. */
+    console_print( "Stack pressure: task %s has %lu words of stack unused\n",
+                   pcTaskGetName( xTask ),
+                   ( unsigned long ) uxFreeStack );
+}
+/*-----------------------------------------------------------*/
+
 void vApplicationTickHook( void )
 {
     /* This function will be called by each tick interrupt if
@@ -356,7 +438,7 @@ void vAssertCalled( const char * const pcFileName,
 static void prvSaveTraceFile( void )
 {
     /* Tracing is not used when code coverage analysis is being performed. */
-    #if ( projCOVERAGE_TEST != 1 )
+    #if ( mainUSE_TRACE_RECORDER == 1 )
         {
             FILE * pxOutputFile;
 
@@ -375,10 +457,84 @@ static void prvSaveTraceFile( void )
                 printf( "\r\nFailed to create trace dump file\r\n" );
             }
         }
-    #endif /* if ( projCOVERAGE_TEST != 1 ) */
+    #endif /* if ( mainUSE_TRACE_RECORDER == 1 ) */
 }
 /*-----------------------------------------------------------*/
 
+#if ( projRECORD_HEAP_TRACE == 1 )
+
+    void vHeapTraceRecordMalloc( void * pvAddress,
+                                 size_t xSize )
+    {
+        unsigned long ulBlock;
+
+        /* Failed allocations are not recorded. */
+        if( pvAddress != NULL )
+        {
+            if( pxHeapTraceFile == NULL )
+            {
+                pxHeapTraceFile = fopen( "heap_trace.txt", "w" );
+            }
+
+            for( ulBlock = 0; ulBlock < mainHEAP_TRACE_MAX_BLOCKS; ulBlock++ )
+            {
+                if( pvHeapTraceBlocks[ ulBlock ] == NULL )
+                {
+                    pvHeapTraceBlocks[ ulBlock ] = pvAddress;
+
+                    if( pxHeapTraceFile != NULL )
+                    {
+                        fprintf( pxHeapTraceFile, "m %lu %lu\n", ulBlock, ( unsigned long ) xSize );
+                        fflush( pxHeapTraceFile );
+                    }
+
+                    break;
+                }
+            }
+
+            if( ulBlock == mainHEAP_TRACE_MAX_BLOCKS )
+            {
+                /* The trace is incomplete.  Report the first time this happens,
+                 * then each time the count doubles, as the scheduler may be
+                 * suspended and the console cannot be flooded.  The free of a
+                 * block that was not recorded is not recorded either. */
+                ulHeapTraceDroppedBlocks++;
+
+                if( ( ulHeapTraceDroppedBlocks & ( ulHeapTraceDroppedBlocks - 1UL ) ) == 0UL )
+                {
+                    printf( "\r\nHeap trace: %lu allocations not recorded, more than %d blocks allocated\r\n",
+                            ulHeapTraceDroppedBlocks,
+                            mainHEAP_TRACE_MAX_BLOCKS );
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceRecordFree( void * pvAddress )
+    {
+        unsigned long ulBlock;
+
+        for( ulBlock = 0; ulBlock < mainHEAP_TRACE_MAX_BLOCKS; ulBlock++ )
+        {
+            if( ( pvAddress != NULL ) && ( pvHeapTraceBlocks[ ulBlock ] == pvAddress ) )
+            {
+                pvHeapTraceBlocks[ ulBlock ] = NULL;
+
+                if( pxHeapTraceFile != NULL )
+                {
+                    fprintf( pxHeapTraceFile, "f %lu\n", ulBlock );
+                    fflush( pxHeapTraceFile );
+                }
+
+                break;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* projRECORD_HEAP_TRACE */
+
 /* configUSE_STATIC_ALLOCATION is set to 1, so the application must provide an
  * implementation of vApplicationGetIdleTaskMemory() to provide the memory that is
  * used by the Idle task. */
@@ -430,6 +586,27 @@ void vApplicationGetTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
      * configMINIMAL_STACK_SIZE is specified in words, not bytes. */
     *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
 }
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* configUSE_STATIC_ALLOCATION is set to 1 and there is more than one core, so
+ * the application must also provide the memory used by the idle tasks of cores
+ * 1 to ( configNUMBER_OF_CORES - 1 ). */
+    void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                               StackType_t ** ppxIdleTaskStackBuffer,
+                                               uint32_t * pulIdleTaskStackSize,
+                                               BaseType_t xPassiveIdleTaskIndex )
+    {
+        static StaticTask_t xIdleTaskTCBs[ configNUMBER_OF_CORES - 1 ];
+        static StackType_t uxIdleTaskStacks[ configNUMBER_OF_CORES - 1 ][ configMINIMAL_STACK_SIZE ];
+
+        *ppxIdleTaskTCBBuffer = &( xIdleTaskTCBs[ xPassiveIdleTaskIndex ] );
+        *ppxIdleTaskStackBuffer = &( uxIdleTaskStacks[ xPassiveIdleTaskIndex ][ 0 ] );
+        *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+    }
+
+#endif /* configNUMBER_OF_CORES */
 
 void handle_sigint( int signal )
 {
@@ -442,6 +619,15 @@ void handle_sigint( int signal )
         printf( "chdir into %s error is %d\n", BUILD, errno );
     }
 
+    #if ( projRECORD_HEAP_TRACE == 1 )
+        {
+            if( ulHeapTraceDroppedBlocks != 0UL )
+            {
+                printf( "\r\nHeap trace: %lu allocations were not recorded\r\n", ulHeapTraceDroppedBlocks );
+            }
+        }
+    #endif
+
     exit( 2 );
 }
 
@@ -0,0 +1,2872 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/******************************************************************************
+ * NOTE 1: The FreeRTOS demo threads will not be running continuously, so
+ * do not expect to get real time behaviour from the FreeRTOS Linux port, or
+ * this demo application.  The times measured are only meaningful when compared
+ * with the times measured by another build on the same machine.
+ *
+ * NOTE 2:  This file only contains the source code that is specific to the
+ * benchmarks.  Generic functions, such FreeRTOS hook functions, are defined in
+ * main.c.  Build it with:
+ *
+ *     make USER_DEMO=BENCHMARK_DEMO
+ *
+ * adding the options that select the kernel implementation to measure, for
+ * example TIMER_WHEEL=1, to compare the results of two builds.
+ ******************************************************************************
+ *
+ * main_benchmark() creates a single benchmark task that runs each benchmark in
+ * turn, prints the results, then ends the scheduler.
+ *
+ * The Delayed Task Benchmark:
+ * A probe task repeatedly calls vTaskDelay() and is removed from the Blocked
+ * state by xTaskAbortDelay(), while 10, 100 and 1000 sleeper tasks are also in
+ * the Blocked state with timeouts.  The probe's timeout is later than that of
+ * every sleeper, so when the delayed tasks are held in the sorted delayed lists
+ * the probe is inserted at the end of the list.  The time from the
+ * traceTASK_DELAY() macro to the traceTASK_SWITCHED_OUT() macro - the time the
+ * kernel takes to place the probe in the Blocked state and select the next
+ * task - is reported, along with the total time of each iteration, which is
+ * dominated by the Linux thread switches.  When configUSE_TIMER_WHEEL is 1 the
+ * kernel time should not depend on the number of sleepers.
+ *
+ * The Event Group Benchmark:
+ * 10, 100 and 1000 sleeper tasks wait on an event group, each for a single bit
+ * or for both of two bits, none of which is ever set.  A probe task waits for
+ * a bit no sleeper waits for, and the benchmark task repeatedly sets that bit,
+ * unblocking the probe, which waits again before this task continues.  The
+ * time from the traceEVENT_GROUP_SET_BITS() macro to the
+ * traceTASK_SWITCHED_OUT() macro - the time the kernel takes to find the tasks
+ * to unblock - is reported, along with the total time of each iteration.  Build
+ * with EVENT_BIT_LISTS=1 to set configUSE_EVENT_GROUP_BIT_LISTS to 1, so each
+ * waiting task is listed under a bit it waits for, and setting a bit should
+ * not depend on the number of sleepers waiting for other bits.  The kernel
+ * time includes switching out of this task, which takes longer as more Linux
+ * threads exist, so the difference is clearest in a build with UCONTEXT=1.
+ *
+ * The Queue Benchmark:
+ * The benchmark task sends items to, and receives items from, a queue created
+ * by xQueueCreate() and then a queue created by xQueueCreateSPSC(), without
+ * blocking.  The average time of each send and receive pair is reported.  The
+ * critical sections entered by the send and receive functions of the first
+ * queue are not entered for the second.
+ *
+ * The Kernel Copy Benchmark:
+ * Items of 4, 8, 16, 24 and 32 bytes are sent to, and received from, a queue
+ * created by xQueueCreate(), a queue created by xQueueCreateSPSC(), and a
+ * message buffer, without blocking.  The average time of each send and
+ * receive pair is reported.  Build with KERNEL_MEMCPY=1 to set
+ * configUSE_SIZED_KERNEL_MEMCPY to 1, so items of 4, 8, 16 and 32 bytes, and
+ * the length of each message, are copied by memcpy() calls of a constant size
+ * that the compiler replaces with a few instructions.  24 byte items are
+ * copied by the library memcpy() in both builds.  The SPSC queue enters no
+ * critical section, so shows the difference most clearly.
+ *
+ * The Context Switch Benchmark:
+ * Two tasks of equal priority switch between each other, first by each
+ * calling taskYIELD() in a loop, then by passing a task notification back and
+ * forth.  The number of task switches per second is reported.  Build with
+ * UCONTEXT=1 to set configPOSIX_USE_UCONTEXT to 1, so the port switches
+ * between tasks with swapcontext() on one Linux thread rather than by waking
+ * the thread of the next task and waiting for it to run.
+ *
+ * The Queue Batching Benchmark:
+ * Built when configUSE_QUEUE_BATCHING is 1.  For items of 4, 16 and 64 bytes
+ * the benchmark task moves items through a queue one at a time with
+ * xQueueSend() and xQueueReceive(), then in batches of 1, 4 and 16 items with
+ * xQueueSendMultiple() and xQueueReceiveMultiple().  The throughput of each is
+ * reported in items per second.  A batch enters one critical section and
+ * copies its items with at most two memcpy() calls, however many items it
+ * holds.
+ *
+ * The Receive Any Benchmark:
+ * Built when configUSE_QUEUE_RECEIVE_ANY is 1.  A task waits on four queues,
+ * first through a queue set and then with xQueueReceiveAny(), while the
+ * benchmark task sends to each queue in turn.  Every send unblocks the waiting
+ * task, which has the higher priority, so the time per item is the time to
+ * wake it and for it to receive the item and block again.  The time to send to
+ * and receive from a queue when no task is waiting is also reported for a
+ * queue that is a member of the set and for one that is not, as sending to a
+ * member of a queue set also sends its handle to the set.  Last, two tasks
+ * that wait on the same two queues are unblocked by sends made while the
+ * scheduler is suspended, suspended, and have their delays aborted, and the
+ * number of wrong results is reported.
+ *
+ * The Heap Benchmark:
+ * Replays a trace of the allocations and frees made by the full demo, recorded
+ * by building with RECORD_HEAP_TRACE=1 and read from heap_trace.txt (or the
+ * file named by HEAP_TRACE), through heap_3.c, heap_5.c and heap_6.c.  The
+ * trace is not part of the repository, so the benchmark is skipped until one
+ * has been recorded.  heap_5.c and heap_6.c are each given the same two
+ * non-contiguous regions.  The average, 99.9th percentile and worst case time
+ * of each pvPortMalloc() and vPortFree() call is reported, as is the
+ * fragmentation of the free space of heap_5.c and heap_6.c - one minus the
+ * ratio of the largest free block to the total free space - averaged over, and
+ * at worst during, the trace.  heap_6.c should have a lower worst case time,
+ * which does not depend on the number of free blocks.  The times include
+ * reading the clock, and suspending and resuming the scheduler, which on this
+ * port enters a critical section.
+ *
+ * The Object Pool Benchmark:
+ * Built when configUSE_OBJECT_POOLS is 1.  For objects of 32, 128 and 256
+ * bytes the benchmark task keeps eight objects allocated while repeatedly
+ * freeing the oldest and allocating a new one, first with pvPortMalloc() and
+ * vPortFree(), then with pvPoolAlloc() and vPoolFree().  The average time of
+ * each allocate and free pair is reported.  The pool neither suspends the
+ * scheduler nor enters a critical section.
+ *
+ * The Reader-Writer Lock Benchmark:
+ * Built when configUSE_RW_LOCKS is 1.  The benchmark task first takes and gives
+ * a mutex, then a reader-writer lock for reading, then for writing, with no
+ * other task using them, and reports the average time of each take and give
+ * pair.  Then four reader tasks repeatedly read two words of shared data,
+ * yielding between the two reads, while a writer task of higher priority
+ * updates both words every 5 ms.  They run for one second, first protecting
+ * the data with a mutex and then with a reader-writer lock, and the number of
+ * reads and writes per second are reported, along with the number of reads
+ * that saw the two words differ.  Every yield made while holding the mutex
+ * finds the other readers blocked on it, whereas the readers share the
+ * reader-writer lock.
+ *
+ * The Deferred Work Benchmark:
+ * Built when configUSE_WORK_QUEUES is 1.  The benchmark task defers a call to
+ * a higher priority task 100000 times, first with xTimerPendFunctionCall(),
+ * which copies the call into the timer command queue, then by submitting a
+ * work item to a work queue of the same priority as the timer service task,
+ * and reports the average time from deferring the call to the call starting.
+ * On this port waking a task with a notification costs more than waking it
+ * with a queue (see the context switch benchmark), so the work queue does not
+ * shorten a single deferred call.  It saves copying the call, never blocks
+ * the caller, and does not queue an item that is already pending.
+ * Then a timer submits one work item to a high priority lane and another to a
+ * low priority lane every tick for one second, while a task of a priority
+ * between the two lanes busies itself for 2 ms in every 3.  The number of
+ * times each item ran and the number of its submissions coalesced with one
+ * that was still pending are reported for each lane.  Builds with
+ * LATENCY_HISTOGRAMS=1 time the run time counter in nanoseconds, so also
+ * report the average and worst time the items of each lane waited.
+ *
+ * The Timer Service Benchmark:
+ * 100, 1000 and 2000 auto-reload timers, with periods from 20 to 219 ticks,
+ * are started, then left to run for one second.  The CPU time used by the
+ * timer service task - read from the Linux thread CPU clock each time the task
+ * is switched out - the number of times the task ran, and the number of
+ * callbacks are reported.  When configPOSIX_USE_UCONTEXT is 1 every task
+ * shares one Linux thread, so the CPU time is instead summed from the times
+ * the task is switched in and out.  The timers are then run again with a slack of 15
+ * ticks.  Build with TIMER_SERVICE_WHEEL=1 to hold the timers in a timer wheel
+ * rather than the sorted timer lists, so starting a timer does not depend on
+ * the number of active timers.  With slack, timers that are due on nearby
+ * ticks expire together, so the timer service task runs less often.
+ *
+ * The Task Stats Benchmark:
+ * Built when configUSE_TASK_PERF_COUNTERS is 1.  With 10, 100 and 1000 sleeper
+ * tasks in the Blocked state, the benchmark task repeatedly takes a snapshot
+ * of the run time of every task, first with uxTaskGetSystemState(), then by
+ * passing the handle of every task to vTaskGetPerfCounters().  The average
+ * time of each snapshot is reported.  uxTaskGetSystemState() suspends the
+ * scheduler for the whole snapshot and also measures the free stack space of
+ * each task, while vTaskGetPerfCounters() copies a few counters from each TCB
+ * without suspending the scheduler.  Both read the run time counter once, which
+ * on this port takes longer as more Linux threads exist.
+ *
+ * The Stack High Water Benchmark:
+ * Built when configUSE_STACK_HIGH_WATER_TRACKING is 1.  200 tasks, each with a
+ * stack of configMINIMAL_STACK_SIZE words, use between 1KB and 8KB of their
+ * stacks then block.  The benchmark task then repeatedly measures the free
+ * stack space of every task, first with uxTaskGetStackHighWaterMark2(), which
+ * scans all the unused stack of each task, then with
+ * uxTaskGetStackHighWaterMarkIncremental(), which only scans the stack used
+ * since it was last called.  The average time to poll every task with each
+ * function, the time of the first incremental poll, and the number of tasks
+ * for which both return the same value are reported.  One task then uses all
+ * but 12KB of its stack, which is within configSTACK_PRESSURE_THRESHOLD, so the
+ * next incremental poll calls vApplicationStackPressureHook().
+ *
+ * The Mutex Handoff Benchmark:
+ * Chains of 1, 2 and 4 nested mutexes are built.  The benchmark task holds the
+ * first mutex of the chain, and each chain task, at increasing priorities,
+ * holds the next mutex while blocked on the one before it, so the last chain
+ * task waits on every other.  The priority the benchmark task inherits is
+ * reported, then the benchmark task gives the first mutex and each chain task
+ * in turn takes its mutex and gives the next one.  The average and worst case
+ * time from the first give until the last chain task holds its mutex are
+ * reported.  Build with MUTEX_HANDOFF=1 to set both
+ * configUSE_TRANSITIVE_PRIORITY_INHERITANCE and configUSE_MUTEX_HANDOFF to 1,
+ * so the benchmark task inherits the priority of the last chain task rather
+ * than only that of the first, and each mutex is handed directly to the task
+ * waiting for it.
+ *
+ * The Idle Benchmark:
+ * The benchmark task blocks for 2 seconds with no other task ready to run.
+ * The ticks that passed, the wall clock time they took, and the CPU time the
+ * process used per second while it was idle are reported.  Build with
+ * TICKLESS=1 to set configUSE_TICKLESS_IDLE to 1, so the idle task stops the
+ * tick timer and sleeps until the benchmark task unblocks rather than taking
+ * a tick interrupt every millisecond.  The same number of ticks then pass in
+ * the same time, and the CPU time falls to almost nothing.
+ *
+ * The Virtual Time Benchmark:
+ * Four tasks, at different priorities, each repeatedly wake from a periodic
+ * delay, do some work, then fold the tick count at which the work ended into a
+ * hash of the schedule.  They run for 2 seconds of simulated time, or for an
+ * hour when configPOSIX_VIRTUAL_TIME is 1, twice.  The simulated time, the
+ * wall clock time it took, and the hash of each run are reported.  Build with
+ * VIRTUAL_TIME=1 to set configPOSIX_VIRTUAL_TIME and configUSE_TICKLESS_IDLE to
+ * 1, so time only passes while every task is blocked and the idle task skips
+ * straight to the next timeout.  The hour then takes seconds, and both runs
+ * have the same hash, as a tick never interrupts the work.
+ *
+ * The Latency Histograms:
+ * Built when configUSE_LATENCY_HISTOGRAMS is 1, for example with
+ * LATENCY_HISTOGRAMS=1.  The histograms are reset before the first benchmark
+ * runs.  Once the other benchmarks are complete, the average time of one
+ * vTaskGetLatencyHistogram() call is reported, followed by one line for each
+ * priority at which a ready to run or critical section latency was recorded.
+ * Each line gives the number of latencies, the longest, and the count in each
+ * bucket.  The run time counter of this demo counts nanoseconds, so bucket n
+ * counts latencies from 2^(n-1) ns.  Compare the context switch results with a
+ * build without LATENCY_HISTOGRAMS=1 to see the cost of the instrumentation.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "message_buffer.h"
+#include "pool.h"
+#include "rwlock.h"
+#include "workqueue.h"
+
+/* Local includes. */
+#include "console.h"
+#include "BenchmarkHeaps/benchmark_heaps.h"
+
+/* Priorities at which the tasks are created.  The probe and sleeper tasks run
+ * as soon as they are unblocked or created. */
+#define mainBENCHMARK_TASK_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+#define mainSLEEPER_TASK_PRIORITY      ( tskIDLE_PRIORITY + 2 )
+#define mainPROBE_TASK_PRIORITY        ( tskIDLE_PRIORITY + 3 )
+
+/* The sleepers block for long enough not to unblock during the benchmark, and
+ * each has a different wake time.  The probe blocks for longer still. */
+#define mainSLEEPER_BLOCK_TIME         pdMS_TO_TICKS( 100000UL )
+#define mainPROBE_BLOCK_TIME           ( mainSLEEPER_BLOCK_TIME * 2UL )
+
+/* The bit the probe of the event group benchmark waits for, and the number of
+ * other bits the sleepers wait for. */
+#define mainEVENT_PROBE_BIT            ( ( EventBits_t ) 0x01 )
+#define mainEVENT_SLEEPER_BITS         ( 22UL )
+
+/* The number of times the probe is blocked and unblocked for each
+ * measurement, and beforehand to warm up. */
+#define mainDELAY_ITERATIONS           ( 20000UL )
+#define mainWARM_UP_ITERATIONS         ( 1000UL )
+
+/* The length of the queues used by the queue benchmark, and the number of
+ * items sent to and received from each queue. */
+#define mainQUEUE_LENGTH               ( 16UL )
+#define mainQUEUE_ITERATIONS           ( 200000UL )
+
+/* The largest item copied by the kernel copy benchmark, and the number of
+ * items sent and received for each item size. */
+#define mainCOPY_MAX_ITEM_SIZE         ( 32UL )
+#define mainCOPY_ITERATIONS            ( 1000000UL )
+
+/* The number of times each task of the context switch benchmark switches to
+ * the other. */
+#define mainSWITCH_ITERATIONS          ( 100000UL )
+
+/* The largest item and batch used by the queue batching benchmark, and the
+ * number of items moved through the queue for each measurement.  The number
+ * of items is a multiple of every batch size. */
+#define mainBATCH_MAX_ITEM_SIZE        ( 64UL )
+#define mainBATCH_MAX_ITEMS            ( 16UL )
+#define mainBATCH_ITEMS                ( 480000UL )
+
+/* The number of queues waited on by the receive any benchmark, the number of
+ * items received from them for each measurement, and the number of times the
+ * checks that follow are repeated. */
+#define mainANY_QUEUES                 ( 4UL )
+#define mainANY_ITERATIONS             ( 100000UL )
+#define mainANY_CHECKS                 ( 1000UL )
+
+/* The largest object used by the object pool benchmark, the number of objects
+ * kept allocated, and the number of objects allocated and freed for each
+ * measurement. */
+#define mainPOOL_MAX_OBJECT_SIZE       ( 256UL )
+#define mainPOOL_LIVE_OBJECTS          ( 8UL )
+#define mainPOOL_ITERATIONS            ( 500000UL )
+
+/* The number of reader tasks used by the reader-writer lock benchmark, the
+ * period of its writer task, how long each run lasts, and the number of times
+ * each lock is taken and given when no other task uses it. */
+#define mainRW_READERS                 ( 4UL )
+#define mainRW_WRITE_PERIOD            pdMS_TO_TICKS( 5UL )
+#define mainRW_RUN_TIME                pdMS_TO_TICKS( 1000UL )
+#define mainRW_ITERATIONS              ( 1000000UL )
+
+/* The number of calls deferred by the deferred work benchmark, how long the
+ * work queue lanes run under load, and the time the task that loads them
+ * stays busy in each tick it runs. */
+#define mainWORK_ITERATIONS            ( 100000UL )
+#define mainWORK_RUN_TIME              pdMS_TO_TICKS( 1000UL )
+#define mainWORK_BUSY_NS               ( 2000000ULL )
+
+/* The largest number of timers used by the timer service benchmark, the range
+ * of their periods, the slack given to them in the second run, and how long
+ * each run lasts. */
+#define mainTIMER_MAX_TIMERS           ( 2000UL )
+#define mainTIMER_MIN_PERIOD           ( 20UL )
+#define mainTIMER_PERIOD_RANGE         ( 200UL )
+#define mainTIMER_SLACK                ( 15UL )
+#define mainTIMER_RUN_TIME             pdMS_TO_TICKS( 1000UL )
+
+/* The number of snapshots taken of the tasks by each method for each
+ * measurement of the task stats benchmark. */
+#define mainSTATS_ITERATIONS           ( 200UL )
+
+/* The number of tasks polled by the stack high water benchmark, the number of
+ * times each function polls them, the most stack each task uses at first, and
+ * the stack left unused by the task that then uses the rest. */
+#define mainSTACK_TASKS                ( 200UL )
+#define mainSTACK_POLLS                ( 20UL )
+#define mainSTACK_MAX_KB               ( 8UL )
+#define mainSTACK_PRESSURE_KB          ( 12UL )
+
+/* The longest chain of mutexes used by the mutex handoff benchmark, the
+ * priority of the first chain task, and the number of times each chain is
+ * released.  The last chain task has a lower priority than the timer service
+ * task. */
+#define mainHANDOFF_MAX_DEPTH          ( 4UL )
+#define mainHANDOFF_BASE_PRIORITY      ( mainBENCHMARK_TASK_PRIORITY + 1 )
+#define mainHANDOFF_ITERATIONS         ( 5000UL )
+
+/* How long the benchmark task blocks in the idle benchmark. */
+#define mainIDLE_RUN_TIME              pdMS_TO_TICKS( 2000UL )
+
+/* The periods of the tasks of the virtual time benchmark, which are spread so
+ * that their wake times rarely coincide, the number of loops of work each task
+ * does when it wakes, and how long each run lasts. */
+#define mainVIRTUAL_TASKS              ( 4UL )
+#define mainVIRTUAL_WORK               ( 100000UL )
+#if ( configPOSIX_VIRTUAL_TIME == 1 )
+    #define mainVIRTUAL_RUN_TIME       pdMS_TO_TICKS( 3600000UL )
+#else
+    #define mainVIRTUAL_RUN_TIME       pdMS_TO_TICKS( 2000UL )
+#endif
+
+/* The largest heap trace, and the most blocks it can hold at once, which
+ * matches the limit of the recorder in main.c.  The trace is replayed until at
+ * least mainHEAP_REPLAY_OPERATIONS operations have been timed. */
+#define mainHEAP_TRACE_MAX_OPERATIONS  ( 200000UL )
+#define mainHEAP_TRACE_MAX_BLOCKS      ( 4096UL )
+#define mainHEAP_REPLAY_OPERATIONS     ( 1000000UL )
+
+/* The sizes of the two regions given to heap_5.c and heap_6.c.  The trace of
+ * the full demo holds up to 12MB at once, mostly task stacks. */
+#define mainHEAP_REGION_1_SIZE         ( 16UL * 1024UL * 1024UL )
+#define mainHEAP_REGION_2_SIZE         ( 4UL * 1024UL * 1024UL )
+
+/* The resolution and range of the histograms of heap operation times. */
+#define mainHEAP_HISTOGRAM_NS          ( 10UL )
+#define mainHEAP_HISTOGRAM_BUCKETS     ( 10000UL )
+
+/* One allocation or free read from the heap trace. */
+typedef struct HeapTraceOperation
+{
+    uint32_t ulBlock;      /* The block allocated or freed. */
+    uint32_t ulSize;       /* The size of the allocation. */
+    BaseType_t xIsMalloc;  /* pdTRUE for an allocation, pdFALSE for a free. */
+} HeapTraceOperation_t;
+
+/* A heap measured by the heap benchmark.  vDefineHeapRegions and
+ * vGetHeapStats are NULL for heap_3.c. */
+typedef struct BenchmarkHeap
+{
+    const char * pcName;
+    void * ( *pvMalloc )( size_t xWantedSize );
+    void ( * vFree )( void * pv );
+    void ( * vDefineHeapRegions )( const HeapRegion_t * const pxHeapRegions );
+    void ( * vGetHeapStats )( HeapStats_t * pxHeapStats );
+} BenchmarkHeap_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The tasks as described in the comments at the top of this file.
+ */
+static void prvBenchmarkTask( void * pvParameters );
+static void prvProbeTask( void * pvParameters );
+static void prvSleeperTask( void * pvParameters );
+static void prvEventProbeTask( void * pvParameters );
+static void prvEventSleeperTask( void * pvParameters );
+static void prvMutexChainTask( void * pvParameters );
+static void prvYieldTask( void * pvParameters );
+static void prvPingPongTask( void * pvParameters );
+static void prvVirtualTimeTask( void * pvParameters );
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+    static void prvReceiveAnyTask( void * pvParameters );
+    static void prvReceiveAnyCheckTask( void * pvParameters );
+#endif
+
+#if ( configUSE_RW_LOCKS == 1 )
+    static void prvRWReaderTask( void * pvParameters );
+    static void prvRWWriterTask( void * pvParameters );
+#endif
+
+#if ( configUSE_WORK_QUEUES == 1 )
+    static void prvWorkLoadTask( void * pvParameters );
+#endif
+
+#if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 )
+    static void prvStackUserTask( void * pvParameters );
+#endif
+
+/*
+ * The benchmarks run by prvBenchmarkTask().
+ */
+static void prvDelayedTaskBenchmark( void );
+static void prvEventGroupBenchmark( void );
+static void prvQueueBenchmark( void );
+static void prvKernelCopyBenchmark( void );
+static void prvContextSwitchBenchmark( void );
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+    static void prvQueueBatchBenchmark( void );
+#endif
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+    static void prvReceiveAnyBenchmark( void );
+#endif
+
+#if ( configUSE_OBJECT_POOLS == 1 )
+    static void prvPoolBenchmark( void );
+#endif
+
+#if ( configUSE_RW_LOCKS == 1 )
+    static void prvRWLockBenchmark( void );
+#endif
+
+#if ( configUSE_WORK_QUEUES == 1 )
+    static void prvDeferredWorkBenchmark( void );
+
+/*
+ * The work done by the deferred work benchmark, deferred with a work queue and
+ * with xTimerPendFunctionCall() respectively.
+ */
+    static void prvDeferredWork( void * pvParameter );
+    static void prvPendedWork( void * pvParameter1,
+                               uint32_t ulParameter2 );
+
+/*
+ * The work done by the lanes, and the callback of the timer that submits it.
+ */
+    static void prvLaneWork( void * pvParameter );
+    static void prvLaneTimerCallback( TimerHandle_t xTimer );
+#endif
+
+#if ( configUSE_TASK_PERF_COUNTERS == 1 )
+    static void prvTaskStatsBenchmark( void );
+#endif
+
+#if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 )
+    static void prvStackHighWaterBenchmark( void );
+
+/*
+ * Uses ulKilobytes of stack, writing every byte of it.
+ */
+    static void prvUseStack( uint32_t ulKilobytes );
+#endif
+
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+    static void prvLatencyHistogramReport( void );
+#endif
+
+static void prvMutexHandoffBenchmark( void );
+static void prvTimerServiceBenchmark( void );
+static void prvIdleBenchmark( void );
+static void prvVirtualTimeBenchmark( void );
+static void prvHeapBenchmark( void );
+
+/*
+ * Reads the heap trace into xHeapTrace[], returning the number of operations
+ * read, or 0 if the trace cannot be read.
+ */
+static uint32_t prvReadHeapTrace( void );
+
+/*
+ * Frees every block of the heap trace still allocated from pxHeap.
+ */
+static void prvFreeHeapTraceBlocks( const BenchmarkHeap_t * pxHeap );
+
+/*
+ * Prints the average, 99.9th percentile and worst case of the times held in
+ * pulHistogram[].
+ */
+static void prvPrintHeapTimes( const char * pcName,
+                               const char * pcFunction,
+                               const uint32_t * pulHistogram,
+                               uint64_t ullTotal,
+                               uint64_t ullWorst,
+                               uint32_t ulCount );
+
+/*
+ * The callback of every timer started by the timer service benchmark.
+ */
+static void prvBenchmarkTimerCallback( TimerHandle_t xTimer );
+
+/*
+ * Returns the time in nanoseconds from the Linux monotonic clock.
+ */
+static uint64_t prvGetTimeNs( void );
+
+/*
+ * Returns the CPU time in nanoseconds used by the calling Linux thread.
+ */
+static uint64_t prvGetThreadTimeNs( void );
+
+/*
+ * Returns the CPU time in nanoseconds used by every thread of the process.
+ */
+static uint64_t prvGetProcessTimeNs( void );
+
+/*
+ * Called by the trace macros defined in FreeRTOSConfig.h to time the sections
+ * of the kernel executed by xTimedTask, and the timer service task.
+ */
+void vBenchmarkTraceTaskDelay( void );
+void vBenchmarkTraceEventGroupSetBits( void );
+void vBenchmarkTraceTaskSwitchedIn( void );
+void vBenchmarkTraceTaskSwitchedOut( void );
+
+/*-----------------------------------------------------------*/
+
+/* The number of sleeper tasks used in each run of the delayed task
+ * benchmark. */
+static const UBaseType_t uxSleeperCounts[] = { 10, 100, 1000 };
+
+/* The sleeper tasks, so they can be deleted after each run. */
+static TaskHandle_t xSleeperHandles[ 1000 ];
+
+/* The event group used by the event group benchmark. */
+static EventGroupHandle_t xBenchmarkEventGroup = NULL;
+
+/* The item sizes used by the kernel copy benchmark. */
+static const UBaseType_t uxCopyItemSizes[] = { 4, 8, 16, 24, mainCOPY_MAX_ITEM_SIZE };
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+/* The item and batch sizes used by the queue batching benchmark. */
+    static const UBaseType_t uxBatchItemSizes[] = { 4, 16, mainBATCH_MAX_ITEM_SIZE };
+    static const UBaseType_t uxBatchSizes[] = { 1, 4, mainBATCH_MAX_ITEMS };
+
+/* The items sent and received by the queue batching benchmark. */
+    static uint8_t ucBatchSendBuffer[ mainBATCH_MAX_ITEMS * mainBATCH_MAX_ITEM_SIZE ];
+    static uint8_t ucBatchReceiveBuffer[ mainBATCH_MAX_ITEMS * mainBATCH_MAX_ITEM_SIZE ];
+#endif
+
+#if ( configUSE_OBJECT_POOLS == 1 )
+
+/* The object sizes used by the object pool benchmark, and the pool. */
+    static const UBaseType_t uxPoolObjectSizes[] = { 32, 128, mainPOOL_MAX_OBJECT_SIZE };
+    static StaticPool_t xBenchmarkPoolBuffer;
+    static uint64_t ullBenchmarkPoolStorage[ ( mainPOOL_LIVE_OBJECTS * mainPOOL_MAX_OBJECT_SIZE ) / sizeof( uint64_t ) ];
+#endif
+
+/* The number of timers used in each run of the timer service benchmark, the
+ * timers, and the number of times their callbacks have been called. */
+static const UBaseType_t uxTimerCounts[] = { 100, 1000, mainTIMER_MAX_TIMERS };
+static TimerHandle_t xBenchmarkTimers[ mainTIMER_MAX_TIMERS ];
+static volatile uint32_t ulTimerCallbacks = 0;
+
+#if ( configUSE_TASK_PERF_COUNTERS == 1 )
+
+/* The snapshots taken by the task stats benchmark.  Room is left for the
+ * benchmark, idle and timer service tasks, and the tasks left by earlier
+ * benchmarks, such as the work queue workers, as well as the sleepers. */
+    #define mainSTATS_MAX_TASKS    ( 1000 + 16 )
+    static TaskStatus_t xStatsTaskStatus[ mainSTATS_MAX_TASKS ];
+    static TaskHandle_t xStatsTaskHandles[ mainSTATS_MAX_TASKS ];
+    static TaskPerfCounters_t xStatsPerfCounters[ mainSTATS_MAX_TASKS ];
+#endif
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+/* The queues and queue set used by the receive any benchmark, the benchmark
+ * task, which the waiting task notifies once it has received every item, and
+ * the number of items received and received wrongly. */
+    static QueueHandle_t xAnyQueues[ mainANY_QUEUES ];
+    static QueueSetHandle_t xAnyQueueSet = NULL;
+    static TaskHandle_t xAnyBenchmarkTask = NULL;
+    static volatile uint32_t ulAnyReceived = 0;
+    static volatile uint32_t ulAnyErrors = 0;
+#endif
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+/* The locks used by the reader-writer lock benchmark, whether the tasks use the
+ * reader-writer lock rather than the mutex, the data they protect, and the
+ * counts of reads, writes and inconsistent reads. */
+    static SemaphoreHandle_t xRWMutex = NULL;
+    static RWLockHandle_t xRWLock = NULL;
+    static StaticRWLock_t xRWLockBuffer;
+    static volatile BaseType_t xRWUseLock = pdFALSE;
+    static volatile BaseType_t xRWStop = pdFALSE;
+    static volatile uint32_t ulRWData[ 2 ] = { 0 };
+    static volatile uint32_t ulRWReads = 0;
+    static volatile uint32_t ulRWWrites = 0;
+    static volatile uint32_t ulRWErrors = 0;
+    static volatile uint32_t ulRWStopped = 0;
+#endif
+
+#if ( configUSE_WORK_QUEUES == 1 )
+
+/* The lanes used by the deferred work benchmark, their work items, their
+ * statistics before they were loaded, and the time at which the last call was
+ * deferred and the total time from deferring each call to it starting. */
+    static WorkQueueHandle_t xWorkLanes[ 2 ] = { NULL };
+    static StaticWorkItem_t xWorkItemBuffers[ 3 ];
+    static WorkItemHandle_t xDeferredWorkItem = NULL;
+    static WorkItemHandle_t xLaneWorkItems[ 2 ] = { NULL };
+    static WorkQueueStats_t xLaneStatsBefore[ 2 ];
+    static volatile uint64_t ullWorkDeferred = 0;
+    static volatile uint64_t ullWorkLatency = 0;
+#endif
+
+/* The tasks of the context switch benchmark, and the benchmark task, which
+ * they notify when they have finished. */
+static TaskHandle_t xSwitchTasks[ 2 ];
+static TaskHandle_t xSwitchBenchmarkTask = NULL;
+
+/* The chain lengths used by the mutex handoff benchmark, the mutexes and tasks
+ * of the current chain, and the time at which the last chain task took its
+ * mutex. */
+static const UBaseType_t uxHandoffDepths[] = { 1, 2, mainHANDOFF_MAX_DEPTH };
+static SemaphoreHandle_t xHandoffMutexes[ mainHANDOFF_MAX_DEPTH ];
+static TaskHandle_t xHandoffTasks[ mainHANDOFF_MAX_DEPTH ];
+static volatile UBaseType_t uxHandoffDepth = 0;
+static volatile uint64_t ullHandoffEnd = 0;
+
+/* The periods of the tasks of the virtual time benchmark, the tick at which
+ * the current run ends, the hash of its schedule, the number of times the
+ * tasks have woken, and the benchmark task, which the tasks notify when the run
+ * has ended. */
+static const TickType_t xVirtualTimePeriods[ mainVIRTUAL_TASKS ] = { 50, 130, 290, 610 };
+static TickType_t xVirtualTimeEnd = 0;
+static uint32_t ulVirtualTimeHash = 0;
+static uint32_t ulVirtualTimeWakes = 0;
+static TaskHandle_t xVirtualTimeBenchmarkTask = NULL;
+
+/* The heap trace, the blocks allocated while it is replayed, and the
+ * histograms of the times taken to allocate and free them. */
+static HeapTraceOperation_t xHeapTrace[ mainHEAP_TRACE_MAX_OPERATIONS ];
+static void * pvHeapTraceBlocks[ mainHEAP_TRACE_MAX_BLOCKS ];
+static uint32_t ulMallocHistogram[ mainHEAP_HISTOGRAM_BUCKETS ];
+static uint32_t ulFreeHistogram[ mainHEAP_HISTOGRAM_BUCKETS ];
+
+/* The regions given to heap_5.c and heap_6.c.  Each heap needs its own. */
+static uint8_t ucHeap5Region1[ mainHEAP_REGION_1_SIZE ];
+static uint8_t ucHeap5Region2[ mainHEAP_REGION_2_SIZE ];
+static uint8_t ucHeap6Region1[ mainHEAP_REGION_1_SIZE ];
+static uint8_t ucHeap6Region2[ mainHEAP_REGION_2_SIZE ];
+
+/* The heaps measured by the heap benchmark.  heap_3.c is the heap used by the
+ * rest of the demo, so is reached through pvPortMalloc() and vPortFree(). */
+static const BenchmarkHeap_t xBenchmarkHeaps[] =
+{
+    { "heap_3", pvPortMalloc,           vPortFree,           NULL,                             NULL                        },
+    { "heap_5", pvBenchmarkHeap5Malloc, vBenchmarkHeap5Free, vBenchmarkHeap5DefineHeapRegions, vBenchmarkHeap5GetHeapStats },
+    { "heap_6", pvBenchmarkHeap6Malloc, vBenchmarkHeap6Free, vBenchmarkHeap6DefineHeapRegions, vBenchmarkHeap6GetHeapStats }
+};
+
+/* The task whose time in the kernel is measured by the trace macros, the time
+ * at which the current timed section started, and the total time of all the
+ * timed sections. */
+static TaskHandle_t xTimedTask = NULL;
+static uint64_t ullTimedSectionStart = 0;
+static uint64_t ullTimedSectionTotal = 0;
+
+/* The timer service task, the CPU time it had used when it was last switched
+ * out, and the number of times it has been switched out.  When every task
+ * shares one thread, the CPU time is summed from the thread CPU time read when
+ * the task is switched in and out. */
+static TaskHandle_t xTimerServiceTask = NULL;
+static uint64_t ullTimerServiceCPUTime = 0;
+static uint32_t ulTimerServiceSwitches = 0;
+#if ( configPOSIX_USE_UCONTEXT == 1 )
+    static uint64_t ullTimerServiceSwitchedIn = 0;
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*** SEE THE COMMENTS AT THE TOP OF THIS FILE ***/
+void main_benchmark( void )
+{
+    xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE, NULL, mainBENCHMARK_TASK_PRIORITY, NULL );
+
+    /* Start the benchmark task running.  vTaskStartScheduler() returns when
+     * the benchmark task ends the scheduler. */
+    vTaskStartScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+    {
+        vTaskResetLatencyHistograms();
+    }
+    #endif
+
+    prvDelayedTaskBenchmark();
+    prvEventGroupBenchmark();
+    prvQueueBenchmark();
+    prvKernelCopyBenchmark();
+    prvContextSwitchBenchmark();
+
+    #if ( configUSE_QUEUE_BATCHING == 1 )
+    {
+        prvQueueBatchBenchmark();
+    }
+    #endif
+
+    #if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+    {
+        prvReceiveAnyBenchmark();
+    }
+    #endif
+
+    #if ( configUSE_OBJECT_POOLS == 1 )
+    {
+        prvPoolBenchmark();
+    }
+    #endif
+
+    #if ( configUSE_RW_LOCKS == 1 )
+    {
+        prvRWLockBenchmark();
+    }
+    #endif
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+    {
+        prvDeferredWorkBenchmark();
+    }
+    #endif
+
+    #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+    {
+        prvTaskStatsBenchmark();
+    }
+    #endif
+
+    #if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 )
+    {
+        prvStackHighWaterBenchmark();
+    }
+    #endif
+
+    prvMutexHandoffBenchmark();
+    prvTimerServiceBenchmark();
+    prvIdleBenchmark();
+    prvVirtualTimeBenchmark();
+    prvHeapBenchmark();
+
+    #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+    {
+        prvLatencyHistogramReport();
+    }
+    #endif
+
+    console_print( "Benchmarks complete\n" );
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvDelayedTaskBenchmark( void )
+{
+    TaskHandle_t xProbeHandle;
+    UBaseType_t uxRun, uxSleeper, uxSleepers;
+    uint32_t ulIteration;
+    uint64_t ullStart, ullElapsed, ullKernel;
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+        const char * const pcImplementation = "timer wheel";
+    #else
+        const char * const pcImplementation = "delayed lists";
+    #endif
+
+    xTaskCreate( prvProbeTask, "Probe", configMINIMAL_STACK_SIZE, NULL, mainPROBE_TASK_PRIORITY, &xProbeHandle );
+
+    for( uxRun = 0; uxRun < ( sizeof( uxSleeperCounts ) / sizeof( uxSleeperCounts[ 0 ] ) ); uxRun++ )
+    {
+        uxSleepers = uxSleeperCounts[ uxRun ];
+
+        /* Each sleeper enters the Blocked state as soon as it is created. */
+        for( uxSleeper = 0; uxSleeper < uxSleepers; uxSleeper++ )
+        {
+            xTaskCreate( prvSleeperTask, "Sleep", configMINIMAL_STACK_SIZE, ( void * ) uxSleeper, mainSLEEPER_TASK_PRIORITY, &( xSleeperHandles[ uxSleeper ] ) );
+        }
+
+        /* Each call to xTaskAbortDelay() runs the probe, which blocks again
+         * before this task continues. */
+        for( ulIteration = 0; ulIteration < mainWARM_UP_ITERATIONS; ulIteration++ )
+        {
+            xTaskAbortDelay( xProbeHandle );
+        }
+
+        ullTimedSectionTotal = 0;
+        xTimedTask = xProbeHandle;
+        ullStart = prvGetTimeNs();
+
+        for( ulIteration = 0; ulIteration < mainDELAY_ITERATIONS; ulIteration++ )
+        {
+            xTaskAbortDelay( xProbeHandle );
+        }
+
+        ullElapsed = prvGetTimeNs() - ullStart;
+        xTimedTask = NULL;
+        ullKernel = ullTimedSectionTotal;
+
+        console_print( "Delayed tasks (%s): %4lu blocked, %5lu ns in the kernel to block, %6lu ns per iteration\n",
+                       pcImplementation,
+                       ( unsigned long ) uxSleepers,
+                       ( unsigned long ) ( ullKernel / mainDELAY_ITERATIONS ),
+                       ( unsigned long ) ( ullElapsed / mainDELAY_ITERATIONS ) );
+
+        for( uxSleeper = 0; uxSleeper < uxSleepers; uxSleeper++ )
+        {
+            vTaskDelete( xSleeperHandles[ uxSleeper ] );
+        }
+
+        /* Allow the idle task to free the deleted sleepers. */
+        vTaskDelay( pdMS_TO_TICKS( 100UL ) );
+    }
+
+    vTaskDelete( xProbeHandle );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventGroupBenchmark( void )
+{
+    TaskHandle_t xProbeHandle;
+    UBaseType_t uxRun, uxSleeper, uxSleepers;
+    uint32_t ulIteration;
+    uint64_t ullStart, ullElapsed, ullKernel;
+
+    #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+        const char * const pcImplementation = "bit lists";
+    #else
+        const char * const pcImplementation = "one list";
+    #endif
+
+    xBenchmarkEventGroup = xEventGroupCreate();
+    configASSERT( xBenchmarkEventGroup );
+    xTaskCreate( prvEventProbeTask, "Probe", configMINIMAL_STACK_SIZE, NULL, mainPROBE_TASK_PRIORITY, &xProbeHandle );
+
+    for( uxRun = 0; uxRun < ( sizeof( uxSleeperCounts ) / sizeof( uxSleeperCounts[ 0 ] ) ); uxRun++ )
+    {
+        uxSleepers = uxSleeperCounts[ uxRun ];
+
+        /* Each sleeper waits on the event group as soon as it is created. */
+        for( uxSleeper = 0; uxSleeper < uxSleepers; uxSleeper++ )
+        {
+            xTaskCreate( prvEventSleeperTask, "Sleep", configMINIMAL_STACK_SIZE, ( void * ) uxSleeper, mainSLEEPER_TASK_PRIORITY, &( xSleeperHandles[ uxSleeper ] ) );
+        }
+
+        /* Each call to xEventGroupSetBits() runs the probe, which waits again
+         * before this task continues. */
+        for( ulIteration = 0; ulIteration < mainWARM_UP_ITERATIONS; ulIteration++ )
+        {
+            xEventGroupSetBits( xBenchmarkEventGroup, mainEVENT_PROBE_BIT );
+        }
+
+        ullTimedSectionTotal = 0;
+        xTimedTask = xTaskGetCurrentTaskHandle();
+        ullStart = prvGetTimeNs();
+
+        for( ulIteration = 0; ulIteration < mainDELAY_ITERATIONS; ulIteration++ )
+        {
+            xEventGroupSetBits( xBenchmarkEventGroup, mainEVENT_PROBE_BIT );
+        }
+
+        ullElapsed = prvGetTimeNs() - ullStart;
+        xTimedTask = NULL;
+        ullKernel = ullTimedSectionTotal;
+
+        console_print( "Event group (%s): %4lu waiting, %5lu ns in the kernel to set a bit, %6lu ns per iteration\n",
+                       pcImplementation,
+                       ( unsigned long ) uxSleepers,
+                       ( unsigned long ) ( ullKernel / mainDELAY_ITERATIONS ),
+                       ( unsigned long ) ( ullElapsed / mainDELAY_ITERATIONS ) );
+
+        for( uxSleeper = 0; uxSleeper < uxSleepers; uxSleeper++ )
+        {
+            vTaskDelete( xSleeperHandles[ uxSleeper ] );
+        }
+
+        /* Allow the idle task to free the deleted sleepers. */
+        vTaskDelay( pdMS_TO_TICKS( 100UL ) );
+    }
+
+    vTaskDelete( xProbeHandle );
+    vEventGroupDelete( xBenchmarkEventGroup );
+    xBenchmarkEventGroup = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueBenchmark( void )
+{
+    QueueHandle_t xQueues[ 2 ];
+    const char * const pcQueueNames[ 2 ] = { "xQueueCreate", "xQueueCreateSPSC" };
+    BaseType_t xQueue, xNumQueues = 1;
+    uint32_t ulIteration, ulValue, ulReceived;
+    uint64_t ullStart, ullElapsed;
+
+    xQueues[ 0 ] = xQueueCreate( mainQUEUE_LENGTH, sizeof( uint32_t ) );
+
+    #if ( configUSE_SPSC_QUEUES == 1 )
+    {
+        xQueues[ 1 ] = xQueueCreateSPSC( mainQUEUE_LENGTH, sizeof( uint32_t ) );
+        xNumQueues = 2;
+    }
+    #endif
+
+    for( xQueue = 0; xQueue < xNumQueues; xQueue++ )
+    {
+        /* Keep the queue half full so the indexes wrap. */
+        for( ulValue = 0; ulValue < ( mainQUEUE_LENGTH / 2UL ); ulValue++ )
+        {
+            xQueueSend( xQueues[ xQueue ], &ulValue, 0 );
+        }
+
+        ullStart = prvGetTimeNs();
+
+        for( ulIteration = 0; ulIteration < mainQUEUE_ITERATIONS; ulIteration++ )
+        {
+            xQueueSend( xQueues[ xQueue ], &ulIteration, 0 );
+            xQueueReceive( xQueues[ xQueue ], &ulReceived, 0 );
+        }
+
+        ullElapsed = prvGetTimeNs() - ullStart;
+
+        console_print( "Queue (%s): %5lu ns per send and receive\n",
+                       pcQueueNames[ xQueue ],
+                       ( unsigned long ) ( ullElapsed / mainQUEUE_ITERATIONS ) );
+
+        vQueueDelete( xQueues[ xQueue ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvKernelCopyBenchmark( void )
+{
+    QueueHandle_t xQueue;
+    MessageBufferHandle_t xMessageBuffer;
+    UBaseType_t uxSize, uxItemSize;
+    uint32_t ulIteration;
+    uint64_t ullStart, ullQueue, ullSPSCQueue = 0, ullMessageBuffer;
+    uint8_t ucSend[ mainCOPY_MAX_ITEM_SIZE ], ucReceive[ mainCOPY_MAX_ITEM_SIZE ];
+
+    ( void ) memset( ucSend, 0x5a, sizeof( ucSend ) );
+
+    for( uxSize = 0; uxSize < ( sizeof( uxCopyItemSizes ) / sizeof( uxCopyItemSizes[ 0 ] ) ); uxSize++ )
+    {
+        uxItemSize = uxCopyItemSizes[ uxSize ];
+
+        xQueue = xQueueCreate( mainQUEUE_LENGTH, uxItemSize );
+        ullStart = prvGetTimeNs();
+
+        for( ulIteration = 0; ulIteration < mainCOPY_ITERATIONS; ulIteration++ )
+        {
+            xQueueSend( xQueue, ucSend, 0 );
+            xQueueReceive( xQueue, ucReceive, 0 );
+        }
+
+        ullQueue = prvGetTimeNs() - ullStart;
+        vQueueDelete( xQueue );
+
+        #if ( configUSE_SPSC_QUEUES == 1 )
+        {
+            xQueue = xQueueCreateSPSC( mainQUEUE_LENGTH, uxItemSize );
+            ullStart = prvGetTimeNs();
+
+            for( ulIteration = 0; ulIteration < mainCOPY_ITERATIONS; ulIteration++ )
+            {
+                xQueueSend( xQueue, ucSend, 0 );
+                xQueueReceive( xQueue, ucReceive, 0 );
+            }
+
+            ullSPSCQueue = prvGetTimeNs() - ullStart;
+            vQueueDelete( xQueue );
+        }
+        #endif
+
+        /* Room for several messages and their lengths, so the data wraps. */
+        xMessageBuffer = xMessageBufferCreate( mainQUEUE_LENGTH * ( mainCOPY_MAX_ITEM_SIZE + sizeof( size_t ) ) + 1U );
+        ullStart = prvGetTimeNs();
+
+        for( ulIteration = 0; ulIteration < mainCOPY_ITERATIONS; ulIteration++ )
+        {
+            xMessageBufferSend( xMessageBuffer, ucSend, uxItemSize, 0 );
+            xMessageBufferReceive( xMessageBuffer, ucReceive, sizeof( ucReceive ), 0 );
+        }
+
+        ullMessageBuffer = prvGetTimeNs() - ullStart;
+        vMessageBufferDelete( xMessageBuffer );
+
+        console_print( "Kernel copy (%2lu byte items): %4lu ns xQueueCreate, %4lu ns xQueueCreateSPSC, %4lu ns message buffer, per send and receive\n",
+                       ( unsigned long ) uxItemSize,
+                       ( unsigned long ) ( ullQueue / mainCOPY_ITERATIONS ),
+                       ( unsigned long ) ( ullSPSCQueue / mainCOPY_ITERATIONS ),
+                       ( unsigned long ) ( ullMessageBuffer / mainCOPY_ITERATIONS ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvContextSwitchBenchmark( void )
+{
+    static const TaskFunction_t pxSwitchFunctions[] = { prvYieldTask, prvPingPongTask };
+    static const char * const pcSwitchNames[] = { "yield", "notify" };
+    UBaseType_t uxRun, uxTask;
+    uint64_t ullStart, ullElapsed;
+
+    #if ( configPOSIX_USE_UCONTEXT == 1 )
+        const char * const pcImplementation = "ucontext";
+    #else
+        const char * const pcImplementation = "threads";
+    #endif
+
+    xSwitchBenchmarkTask = xTaskGetCurrentTaskHandle();
+
+    for( uxRun = 0; uxRun < ( sizeof( pxSwitchFunctions ) / sizeof( pxSwitchFunctions[ 0 ] ) ); uxRun++ )
+    {
+        /* Create both tasks before either runs, so each can be given the
+         * handle of the other. */
+        vTaskSuspendAll();
+        {
+            for( uxTask = 0; uxTask < 2; uxTask++ )
+            {
+                xTaskCreate( pxSwitchFunctions[ uxRun ], "Switch", configMINIMAL_STACK_SIZE, ( void * ) uxTask, mainBENCHMARK_TASK_PRIORITY + 1, &( xSwitchTasks[ uxTask ] ) );
+            }
+
+            ullStart = prvGetTimeNs();
+        }
+        xTaskResumeAll();
+
+        /* The tasks have a higher priority than this task, which waits for
+         * both to finish. */
+        for( uxTask = 0; uxTask < 2; uxTask++ )
+        {
+            ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+        }
+
+        ullElapsed = prvGetTimeNs() - ullStart;
+
+        console_print( "Context switch (%s, %s): %8lu switches per second, %6lu ns per switch\n",
+                       pcImplementation,
+                       pcSwitchNames[ uxRun ],
+                       ( unsigned long ) ( ( 2ULL * mainSWITCH_ITERATIONS * 1000000000ULL ) / ullElapsed ),
+                       ( unsigned long ) ( ullElapsed / ( 2ULL * mainSWITCH_ITERATIONS ) ) );
+
+        for( uxTask = 0; uxTask < 2; uxTask++ )
+        {
+            vTaskDelete( xSwitchTasks[ uxTask ] );
+        }
+
+        /* Allow the idle task to free the deleted tasks. */
+        vTaskDelay( pdMS_TO_TICKS( 100UL ) );
+    }
+
+    xSwitchBenchmarkTask = NULL;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    static void prvQueueBatchBenchmark( void )
+    {
+        QueueHandle_t xQueue;
+        UBaseType_t uxSizeIndex, uxBatchIndex, uxItemSize, uxBatchSize;
+        uint32_t ulItem;
+        uint64_t ullStart, ullElapsed;
+
+        memset( ucBatchSendBuffer, 0xa5, sizeof( ucBatchSendBuffer ) );
+
+        for( uxSizeIndex = 0; uxSizeIndex < ( sizeof( uxBatchItemSizes ) / sizeof( uxBatchItemSizes[ 0 ] ) ); uxSizeIndex++ )
+        {
+            uxItemSize = uxBatchItemSizes[ uxSizeIndex ];
+            xQueue = xQueueCreate( mainBATCH_MAX_ITEMS, uxItemSize );
+            configASSERT( xQueue );
+
+            /* One item at a time with the single item API. */
+            ullStart = prvGetTimeNs();
+
+            for( ulItem = 0; ulItem < mainBATCH_ITEMS; ulItem++ )
+            {
+                xQueueSend( xQueue, ucBatchSendBuffer, 0 );
+                xQueueReceive( xQueue, ucBatchReceiveBuffer, 0 );
+            }
+
+            ullElapsed = prvGetTimeNs() - ullStart;
+
+            console_print( "Queue batching (%2lu byte items, xQueueSend):      %9lu items per second\n",
+                           ( unsigned long ) uxItemSize,
+                           ( unsigned long ) ( ( ( uint64_t ) mainBATCH_ITEMS * 1000000000ULL ) / ullElapsed ) );
+
+            /* Then a batch at a time with the batching API. */
+            for( uxBatchIndex = 0; uxBatchIndex < ( sizeof( uxBatchSizes ) / sizeof( uxBatchSizes[ 0 ] ) ); uxBatchIndex++ )
+            {
+                uxBatchSize = uxBatchSizes[ uxBatchIndex ];
+                ullStart = prvGetTimeNs();
+
+                for( ulItem = 0; ulItem < mainBATCH_ITEMS; ulItem += ( uint32_t ) uxBatchSize )
+                {
+                    ( void ) xQueueSendMultiple( xQueue, ucBatchSendBuffer, uxBatchSize, 0 );
+                    ( void ) xQueueReceiveMultiple( xQueue, ucBatchReceiveBuffer, uxBatchSize, 0 );
+                }
+
+                ullElapsed = prvGetTimeNs() - ullStart;
+
+                console_print( "Queue batching (%2lu byte items, %2lu item batches): %9lu items per second\n",
+                               ( unsigned long ) uxItemSize,
+                               ( unsigned long ) uxBatchSize,
+                               ( unsigned long ) ( ( ( uint64_t ) mainBATCH_ITEMS * 1000000000ULL ) / ullElapsed ) );
+            }
+
+            vQueueDelete( xQueue );
+        }
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+    static void prvReceiveAnyBenchmark( void )
+    {
+        static const char * const pcMethods[] = { "queue set", "xQueueReceiveAny" };
+        TaskHandle_t xWaitingTask, xCheckTasks[ 2 ];
+        UBaseType_t uxMethod, uxQueue;
+        uint32_t ulItem, ulCheck, ulExpected;
+        uint64_t ullStart, ullElapsed, ullNoWait;
+        BaseType_t xUseSet;
+
+        xAnyBenchmarkTask = xTaskGetCurrentTaskHandle();
+
+        for( uxMethod = 0; uxMethod < ( sizeof( pcMethods ) / sizeof( pcMethods[ 0 ] ) ); uxMethod++ )
+        {
+            /* A queue that is a member of a set cannot also be waited on with
+             * xQueueReceiveAny(), so each method has its own queues. */
+            xUseSet = ( uxMethod == 0 ) ? pdTRUE : pdFALSE;
+            xAnyQueueSet = ( xUseSet != pdFALSE ) ? xQueueCreateSet( mainANY_QUEUES ) : NULL;
+
+            for( uxQueue = 0; uxQueue < mainANY_QUEUES; uxQueue++ )
+            {
+                xAnyQueues[ uxQueue ] = xQueueCreate( 1, sizeof( uint32_t ) );
+                configASSERT( xAnyQueues[ uxQueue ] );
+
+                if( xUseSet != pdFALSE )
+                {
+                    xQueueAddToSet( xAnyQueues[ uxQueue ], xAnyQueueSet );
+                }
+            }
+
+            /* The cost of a send and receive when no task is waiting. */
+            ullStart = prvGetTimeNs();
+
+            for( ulItem = 0; ulItem < mainANY_ITERATIONS; ulItem++ )
+            {
+                xQueueSend( xAnyQueues[ 0 ], &ulItem, 0 );
+
+                if( xUseSet != pdFALSE )
+                {
+                    ( void ) xQueueSelectFromSet( xAnyQueueSet, 0 );
+                }
+
+                xQueueReceive( xAnyQueues[ 0 ], &ulCheck, 0 );
+            }
+
+            ullNoWait = prvGetTimeNs() - ullStart;
+
+            /* The cost of waking a task waiting on every queue. */
+            ulAnyReceived = 0;
+            ulAnyErrors = 0;
+            xTaskCreate( prvReceiveAnyTask, "Any", configMINIMAL_STACK_SIZE, ( void * ) xUseSet, mainBENCHMARK_TASK_PRIORITY + 1, &xWaitingTask );
+
+            ullStart = prvGetTimeNs();
+
+            for( ulItem = 0; ulItem < mainANY_ITERATIONS; ulItem++ )
+            {
+                xQueueSend( xAnyQueues[ ulItem % mainANY_QUEUES ], &ulItem, portMAX_DELAY );
+            }
+
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+            ullElapsed = prvGetTimeNs() - ullStart;
+
+            console_print( "Receive any (%-16s): %4lu ns per send and receive with no task waiting, %5lu ns per item to a waiting task, %lu errors\n",
+                           pcMethods[ uxMethod ],
+                           ( unsigned long ) ( ullNoWait / mainANY_ITERATIONS ),
+                           ( unsigned long ) ( ullElapsed / mainANY_ITERATIONS ),
+                           ( unsigned long ) ulAnyErrors );
+
+            vTaskDelete( xWaitingTask );
+
+            if( xUseSet == pdFALSE )
+            {
+                break;
+            }
+
+            for( uxQueue = 0; uxQueue < mainANY_QUEUES; uxQueue++ )
+            {
+                xQueueRemoveFromSet( xAnyQueues[ uxQueue ], xAnyQueueSet );
+                vQueueDelete( xAnyQueues[ uxQueue ] );
+            }
+
+            vQueueDelete( xAnyQueueSet );
+            xAnyQueueSet = NULL;
+        }
+
+        /* Two tasks, at different priorities, wait on the first two queues.
+         * Each send made while the scheduler is suspended unblocks one of them,
+         * and the second must skip the item left in its event list by the task
+         * the first unblocked. */
+        ulAnyReceived = 0;
+        ulAnyErrors = 0;
+        xTaskCreate( prvReceiveAnyCheckTask, "AnyLo", configMINIMAL_STACK_SIZE, NULL, mainBENCHMARK_TASK_PRIORITY + 1, &( xCheckTasks[ 0 ] ) );
+        xTaskCreate( prvReceiveAnyCheckTask, "AnyHi", configMINIMAL_STACK_SIZE, NULL, mainBENCHMARK_TASK_PRIORITY + 2, &( xCheckTasks[ 1 ] ) );
+        ulExpected = 0;
+
+        for( ulCheck = 0; ulCheck < mainANY_CHECKS; ulCheck++ )
+        {
+            vTaskSuspendAll();
+            {
+                xQueueSend( xAnyQueues[ 0 ], &ulCheck, 0 );
+                xQueueSend( xAnyQueues[ 1 ], &ulCheck, 0 );
+            }
+            xTaskResumeAll();
+            ulExpected += 2;
+
+            /* Only the lower priority task can receive from a queue while the
+             * other is suspended. */
+            vTaskSuspend( xCheckTasks[ 1 ] );
+            xQueueSend( xAnyQueues[ 1 ], &ulCheck, 0 );
+            vTaskResume( xCheckTasks[ 1 ] );
+            ulExpected++;
+
+            /* Both tasks return without an item when their delays are
+             * aborted. */
+            if( ( xTaskAbortDelay( xCheckTasks[ 0 ] ) == pdFAIL ) || ( xTaskAbortDelay( xCheckTasks[ 1 ] ) == pdFAIL ) )
+            {
+                ulAnyErrors++;
+            }
+
+            if( ( ulAnyReceived != ulExpected ) ||
+                ( uxQueueMessagesWaiting( xAnyQueues[ 0 ] ) != 0 ) ||
+                ( uxQueueMessagesWaiting( xAnyQueues[ 1 ] ) != 0 ) )
+            {
+                ulAnyErrors++;
+                ulExpected = ulAnyReceived;
+            }
+        }
+
+        /* A task deleted while it waits must leave no items in the event
+         * lists, so the sends that follow find no task to unblock. */
+        vTaskDelete( xCheckTasks[ 1 ] );
+        vTaskDelete( xCheckTasks[ 0 ] );
+        xQueueSend( xAnyQueues[ 0 ], &ulCheck, 0 );
+        xQueueSend( xAnyQueues[ 1 ], &ulCheck, 0 );
+
+        if( ( xQueueReceiveAny( xAnyQueues, mainANY_QUEUES, &ulItem, &uxQueue, 0 ) != pdPASS ) || ( uxQueue != 0 ) ||
+            ( xQueueReceiveAny( xAnyQueues, mainANY_QUEUES, &ulItem, &uxQueue, 0 ) != pdPASS ) || ( uxQueue != 1 ) ||
+            ( xQueueReceiveAny( xAnyQueues, mainANY_QUEUES, &ulItem, &uxQueue, 2 ) != errQUEUE_EMPTY ) )
+        {
+            ulAnyErrors++;
+        }
+
+        console_print( "Receive any (checks): %lu items received by tasks unblocked while the scheduler was suspended, %lu errors\n",
+                       ( unsigned long ) ulAnyReceived,
+                       ( unsigned long ) ulAnyErrors );
+
+        for( uxQueue = 0; uxQueue < mainANY_QUEUES; uxQueue++ )
+        {
+            vQueueDelete( xAnyQueues[ uxQueue ] );
+        }
+
+        xAnyBenchmarkTask = NULL;
+
+        /* Allow the idle task to free the deleted tasks. */
+        vTaskDelay( pdMS_TO_TICKS( 100UL ) );
+    }
+
+#endif /* configUSE_QUEUE_RECEIVE_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_OBJECT_POOLS == 1 )
+
+    static void prvPoolBenchmark( void )
+    {
+        PoolHandle_t xPool;
+        void * pvObjects[ mainPOOL_LIVE_OBJECTS ];
+        UBaseType_t uxSizeIndex, uxObjectSize;
+        uint32_t ulIteration, ulObject;
+        uint64_t ullStart, ullElapsed;
+
+        for( uxSizeIndex = 0; uxSizeIndex < ( sizeof( uxPoolObjectSizes ) / sizeof( uxPoolObjectSizes[ 0 ] ) ); uxSizeIndex++ )
+        {
+            uxObjectSize = uxPoolObjectSizes[ uxSizeIndex ];
+
+            /* With the heap. */
+            for( ulObject = 0; ulObject < mainPOOL_LIVE_OBJECTS; ulObject++ )
+            {
+                pvObjects[ ulObject ] = pvPortMalloc( uxObjectSize );
+            }
+
+            ullStart = prvGetTimeNs();
+
+            for( ulIteration = 0; ulIteration < mainPOOL_ITERATIONS; ulIteration++ )
+            {
+                ulObject = ulIteration % mainPOOL_LIVE_OBJECTS;
+                vPortFree( pvObjects[ ulObject ] );
+                pvObjects[ ulObject ] = pvPortMalloc( uxObjectSize );
+            }
+
+            ullElapsed = prvGetTimeNs() - ullStart;
+
+            console_print( "Object pool (%3lu byte objects, pvPortMalloc): %5lu ns per allocate and free\n",
+                           ( unsigned long ) uxObjectSize,
+                           ( unsigned long ) ( ullElapsed / mainPOOL_ITERATIONS ) );
+
+            for( ulObject = 0; ulObject < mainPOOL_LIVE_OBJECTS; ulObject++ )
+            {
+                vPortFree( pvObjects[ ulObject ] );
+            }
+
+            /* With a pool that holds just enough objects. */
+            xPool = xPoolCreateStatic( "Bench", uxObjectSize, mainPOOL_LIVE_OBJECTS, ( uint8_t * ) ullBenchmarkPoolStorage, &xBenchmarkPoolBuffer );
+            configASSERT( xPool );
+
+            for( ulObject = 0; ulObject < mainPOOL_LIVE_OBJECTS; ulObject++ )
+            {
+                pvObjects[ ulObject ] = pvPoolAlloc( xPool, 0 );
+            }
+
+            ullStart = prvGetTimeNs();
+
+            for( ulIteration = 0; ulIteration < mainPOOL_ITERATIONS; ulIteration++ )
+            {
+                ulObject = ulIteration % mainPOOL_LIVE_OBJECTS;
+                vPoolFree( xPool, pvObjects[ ulObject ] );
+                pvObjects[ ulObject ] = pvPoolAlloc( xPool, 0 );
+            }
+
+            ullElapsed = prvGetTimeNs() - ullStart;
+
+            console_print( "Object pool (%3lu byte objects, pvPoolAlloc):  %5lu ns per allocate and free\n",
+                           ( unsigned long ) uxObjectSize,
+                           ( unsigned long ) ( ullElapsed / mainPOOL_ITERATIONS ) );
+
+            for( ulObject = 0; ulObject < mainPOOL_LIVE_OBJECTS; ulObject++ )
+            {
+                vPoolFree( xPool, pvObjects[ ulObject ] );
+            }
+
+            vPoolDelete( xPool );
+        }
+    }
+
+#endif /* configUSE_OBJECT_POOLS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+    static void prvRWLockBenchmark( void )
+    {
+        static const char * const pcMethods[] = { "mutex", "reader-writer lock" };
+        TaskHandle_t xTasks[ mainRW_READERS + 1 ];
+        UBaseType_t uxMethod, uxTask;
+        uint32_t ulIteration;
+        uint64_t ullStart, ullElapsed[ 3 ];
+
+        xRWMutex = xSemaphoreCreateMutex();
+        xRWLock = xRWLockCreateStatic( &xRWLockBuffer );
+        configASSERT( xRWMutex );
+        configASSERT( xRWLock );
+
+        /* The cost of taking and giving each lock when no other task uses
+         * it. */
+        ullStart = prvGetTimeNs();
+
+        for( ulIteration = 0; ulIteration < mainRW_ITERATIONS; ulIteration++ )
+        {
+            xSemaphoreTake( xRWMutex, 0 );
+            xSemaphoreGive( xRWMutex );
+        }
+
+        ullElapsed[ 0 ] = prvGetTimeNs() - ullStart;
+        ullStart = prvGetTimeNs();
+
+        for( ulIteration = 0; ulIteration < mainRW_ITERATIONS; ulIteration++ )
+        {
+            xRWLockTakeRead( xRWLock, 0 );
+            xRWLockGiveRead( xRWLock );
+        }
+
+        ullElapsed[ 1 ] = prvGetTimeNs() - ullStart;
+        ullStart = prvGetTimeNs();
+
+        for( ulIteration = 0; ulIteration < mainRW_ITERATIONS; ulIteration++ )
+        {
+            xRWLockTakeWrite( xRWLock, 0 );
+            xRWLockGiveWrite( xRWLock );
+        }
+
+        ullElapsed[ 2 ] = prvGetTimeNs() - ullStart;
+
+        console_print( "Reader-writer lock (uncontended): %4lu ns per mutex take and give, %4lu ns per read take and give, %4lu ns per write take and give\n",
+                       ( unsigned long ) ( ullElapsed[ 0 ] / mainRW_ITERATIONS ),
+                       ( unsigned long ) ( ullElapsed[ 1 ] / mainRW_ITERATIONS ),
+                       ( unsigned long ) ( ullElapsed[ 2 ] / mainRW_ITERATIONS ) );
+
+        /* Read-mostly throughput with each lock. */
+        for( uxMethod = 0; uxMethod < ( sizeof( pcMethods ) / sizeof( pcMethods[ 0 ] ) ); uxMethod++ )
+        {
+            xRWUseLock = ( uxMethod == 0 ) ? pdFALSE : pdTRUE;
+            xRWStop = pdFALSE;
+            ulRWReads = 0;
+            ulRWWrites = 0;
+            ulRWErrors = 0;
+            ulRWStopped = 0;
+
+            for( uxTask = 0; uxTask < mainRW_READERS; uxTask++ )
+            {
+                xTaskCreate( prvRWReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, mainBENCHMARK_TASK_PRIORITY, &( xTasks[ uxTask ] ) );
+            }
+
+            xTaskCreate( prvRWWriterTask, "Writer", configMINIMAL_STACK_SIZE, NULL, mainBENCHMARK_TASK_PRIORITY + 1, &( xTasks[ mainRW_READERS ] ) );
+
+            ullStart = prvGetTimeNs();
+            vTaskDelay( mainRW_RUN_TIME );
+            xRWStop = pdTRUE;
+            ullElapsed[ 0 ] = prvGetTimeNs() - ullStart;
+
+            /* Wait for every task to give the lock and stop, so none is
+             * deleted while it holds the lock. */
+            while( ulRWStopped < ( mainRW_READERS + 1 ) )
+            {
+                vTaskDelay( 1 );
+            }
+
+            console_print( "Reader-writer lock (%-18s): %8lu reads per second, %4lu writes per second, %lu inconsistent reads\n",
+                           pcMethods[ uxMethod ],
+                           ( unsigned long ) ( ( ( uint64_t ) ulRWReads * 1000000000ULL ) / ullElapsed[ 0 ] ),
+                           ( unsigned long ) ( ( ( uint64_t ) ulRWWrites * 1000000000ULL ) / ullElapsed[ 0 ] ),
+                           ( unsigned long ) ulRWErrors );
+
+            for( uxTask = 0; uxTask < ( mainRW_READERS + 1 ); uxTask++ )
+            {
+                vTaskDelete( xTasks[ uxTask ] );
+            }
+        }
+
+        vRWLockDelete( xRWLock );
+        vSemaphoreDelete( xRWMutex );
+        xRWLock = NULL;
+        xRWMutex = NULL;
+
+        /* Allow the idle task to free the deleted tasks. */
+        vTaskDelay( pdMS_TO_TICKS( 100UL ) );
+    }
+
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WORK_QUEUES == 1 )
+
+    static void prvDeferredWorkBenchmark( void )
+    {
+        static const char * const pcLanes[] = { "high", "low" };
+        TaskHandle_t xLoadTask;
+        TimerHandle_t xLaneTimer;
+        WorkQueueStats_t xStats;
+        UBaseType_t uxLane;
+        uint32_t ulIteration;
+        uint64_t ullPended, ullSubmitted;
+
+        /* Work queues exist for the life of the application, so the lanes
+         * are only created once. */
+        if( xWorkLanes[ 0 ] == NULL )
+        {
+            xWorkLanes[ 0 ] = xWorkQueueCreate( "WorkHigh", configTIMER_TASK_PRIORITY, configMINIMAL_STACK_SIZE );
+            xWorkLanes[ 1 ] = xWorkQueueCreate( "WorkLow", mainBENCHMARK_TASK_PRIORITY + 1, configMINIMAL_STACK_SIZE );
+            xDeferredWorkItem = xWorkItemCreateStatic( prvDeferredWork, NULL, &( xWorkItemBuffers[ 0 ] ) );
+            xLaneWorkItems[ 0 ] = xWorkItemCreateStatic( prvLaneWork, NULL, &( xWorkItemBuffers[ 1 ] ) );
+            xLaneWorkItems[ 1 ] = xWorkItemCreateStatic( prvLaneWork, NULL, &( xWorkItemBuffers[ 2 ] ) );
+            configASSERT( xWorkLanes[ 0 ] );
+            configASSERT( xWorkLanes[ 1 ] );
+        }
+
+        /* Both the timer service task and the high priority lane preempt the
+         * benchmark task as soon as a call is deferred to them. */
+        ullWorkLatency = 0;
+
+        for( ulIteration = 0; ulIteration < mainWORK_ITERATIONS; ulIteration++ )
+        {
+            ullWorkDeferred = prvGetTimeNs();
+            xTimerPendFunctionCall( prvPendedWork, NULL, 0, portMAX_DELAY );
+        }
+
+        ullPended = ullWorkLatency;
+        ullWorkLatency = 0;
+
+        for( ulIteration = 0; ulIteration < mainWORK_ITERATIONS; ulIteration++ )
+        {
+            ullWorkDeferred = prvGetTimeNs();
+            xWorkQueueSubmit( xWorkLanes[ 0 ], xDeferredWorkItem );
+        }
+
+        ullSubmitted = ullWorkLatency;
+
+        console_print( "Deferred work (latency): %5lu ns from xTimerPendFunctionCall() to the call, %5lu ns from xWorkQueueSubmit() to the call\n",
+                       ( unsigned long ) ( ullPended / mainWORK_ITERATIONS ),
+                       ( unsigned long ) ( ullSubmitted / mainWORK_ITERATIONS ) );
+
+        /* Load the lanes.  Only the statistics of this run are reported. */
+        for( uxLane = 0; uxLane < ( sizeof( pcLanes ) / sizeof( pcLanes[ 0 ] ) ); uxLane++ )
+        {
+            vWorkQueueGetStats( xWorkLanes[ uxLane ], &( xLaneStatsBefore[ uxLane ] ) );
+        }
+
+        xTaskCreate( prvWorkLoadTask, "WorkLoad", configMINIMAL_STACK_SIZE, NULL, mainBENCHMARK_TASK_PRIORITY + 2, &xLoadTask );
+        xLaneTimer = xTimerCreate( "Lanes", 1, pdTRUE, NULL, prvLaneTimerCallback );
+        configASSERT( xLaneTimer );
+        xTimerStart( xLaneTimer, portMAX_DELAY );
+
+        vTaskDelay( mainWORK_RUN_TIME );
+
+        xTimerDelete( xLaneTimer, portMAX_DELAY );
+        vTaskDelete( xLoadTask );
+
+        /* Allow the low priority lane to run the item it still has pending,
+         * and the idle task to free the deleted task. */
+        vTaskDelay( pdMS_TO_TICKS( 100UL ) );
+
+        for( uxLane = 0; uxLane < ( sizeof( pcLanes ) / sizeof( pcLanes[ 0 ] ) ); uxLane++ )
+        {
+            vWorkQueueGetStats( xWorkLanes[ uxLane ], &xStats );
+            xStats.ulExecuted -= xLaneStatsBefore[ uxLane ].ulExecuted;
+            xStats.ulCoalesced -= xLaneStatsBefore[ uxLane ].ulCoalesced;
+
+            #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+            {
+                /* The worst wait includes that of the latency run, which is
+                 * far shorter. */
+                xStats.ulTotalLatency -= xLaneStatsBefore[ uxLane ].ulTotalLatency;
+
+                console_print( "Deferred work (%-4s lane): %5lu runs, %5lu coalesced submissions, %8lu ns average wait, %8lu ns worst wait\n",
+                               pcLanes[ uxLane ],
+                               ( unsigned long ) xStats.ulExecuted,
+                               ( unsigned long ) xStats.ulCoalesced,
+                               ( unsigned long ) ( ( xStats.ulExecuted > 0U ) ? ( xStats.ulTotalLatency / xStats.ulExecuted ) : 0U ),
+                               ( unsigned long ) xStats.ulMaximumLatency );
+            }
+            #else
+            {
+                console_print( "Deferred work (%-4s lane): %5lu runs, %5lu coalesced submissions\n",
+                               pcLanes[ uxLane ],
+                               ( unsigned long ) xStats.ulExecuted,
+                               ( unsigned long ) xStats.ulCoalesced );
+            }
+            #endif
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDeferredWork( void * pvParameter )
+    {
+        ( void ) pvParameter;
+
+        ullWorkLatency += prvGetTimeNs() - ullWorkDeferred;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPendedWork( void * pvParameter1,
+                               uint32_t ulParameter2 )
+    {
+        ( void ) ulParameter2;
+
+        prvDeferredWork( pvParameter1 );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvLaneWork( void * pvParameter )
+    {
+        /* The work queues count the runs. */
+        ( void ) pvParameter;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvLaneTimerCallback( TimerHandle_t xTimer )
+    {
+        ( void ) xTimer;
+
+        xWorkQueueSubmit( xWorkLanes[ 0 ], xLaneWorkItems[ 0 ] );
+        xWorkQueueSubmit( xWorkLanes[ 1 ], xLaneWorkItems[ 1 ] );
+    }
+
+#endif /* configUSE_WORK_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_PERF_COUNTERS == 1 )
+
+    static void prvTaskStatsBenchmark( void )
+    {
+        UBaseType_t uxRun, uxSleeper, uxSleepers, uxTasks;
+        uint32_t ulIteration;
+        uint64_t ullStart, ullSystemState, ullPerfCounters;
+        configRUN_TIME_COUNTER_TYPE ulTotalRunTime;
+
+        for( uxRun = 0; uxRun < ( sizeof( uxSleeperCounts ) / sizeof( uxSleeperCounts[ 0 ] ) ); uxRun++ )
+        {
+            uxSleepers = uxSleeperCounts[ uxRun ];
+
+            for( uxSleeper = 0; uxSleeper < uxSleepers; uxSleeper++ )
+            {
+                xTaskCreate( prvSleeperTask, "Sleep", configMINIMAL_STACK_SIZE, ( void * ) uxSleeper, mainSLEEPER_TASK_PRIORITY, &( xSleeperHandles[ uxSleeper ] ) );
+            }
+
+            uxTasks = uxTaskGetNumberOfTasks();
+            configASSERT( uxTasks <= ( sizeof( xStatsTaskStatus ) / sizeof( xStatsTaskStatus[ 0 ] ) ) );
+
+            /* The same tasks are passed to vTaskGetPerfCounters(). */
+            uxTasks = uxTaskGetSystemState( xStatsTaskStatus, uxTasks, &ulTotalRunTime );
+
+            for( uxSleeper = 0; uxSleeper < uxTasks; uxSleeper++ )
+            {
+                xStatsTaskHandles[ uxSleeper ] = xStatsTaskStatus[ uxSleeper ].xHandle;
+            }
+
+            ullStart = prvGetTimeNs();
+
+            for( ulIteration = 0; ulIteration < mainSTATS_ITERATIONS; ulIteration++ )
+            {
+                ( void ) uxTaskGetSystemState( xStatsTaskStatus, uxTasks, &ulTotalRunTime );
+            }
+
+            ullSystemState = prvGetTimeNs() - ullStart;
+
+            ullStart = prvGetTimeNs();
+
+            for( ulIteration = 0; ulIteration < mainSTATS_ITERATIONS; ulIteration++ )
+            {
+                vTaskGetPerfCounters( xStatsTaskHandles, xStatsPerfCounters, uxTasks );
+            }
+
+            ullPerfCounters = prvGetTimeNs() - ullStart;
+
+            console_print( "Task stats: %4lu tasks, %8lu ns per uxTaskGetSystemState() snapshot, %8lu ns per vTaskGetPerfCounters() snapshot\n",
+                           ( unsigned long ) uxTasks,
+                           ( unsigned long ) ( ullSystemState / mainSTATS_ITERATIONS ),
+                           ( unsigned long ) ( ullPerfCounters / mainSTATS_ITERATIONS ) );
+
+            for( uxSleeper = 0; uxSleeper < uxSleepers; uxSleeper++ )
+            {
+                vTaskDelete( xSleeperHandles[ uxSleeper ] );
+            }
+
+            /* Allow the idle task to free the deleted sleepers. */
+            vTaskDelay( pdMS_TO_TICKS( 100UL ) );
+        }
+    }
+
+#endif /* configUSE_TASK_PERF_COUNTERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+
+    static void prvLatencyHistogramReport( void )
+    {
+        static const char * const pcHistogramNames[] = { "Ready", "Critical" };
+        static char cLine[ 160 + ( configLATENCY_HISTOGRAM_BUCKETS * 11 ) ];
+        LatencyHistogram_t xHistogram;
+        UBaseType_t uxHistogram, uxPriority, uxBucket;
+        uint32_t ulIteration, ulLatencies;
+        uint64_t ullStart, ullElapsed;
+        int iLength;
+
+        ullStart = prvGetTimeNs();
+
+        for( ulIteration = 0; ulIteration < mainSTATS_ITERATIONS; ulIteration++ )
+        {
+            vTaskGetLatencyHistogram( eReadyLatency, mainPROBE_TASK_PRIORITY, &xHistogram );
+        }
+
+        ullElapsed = prvGetTimeNs() - ullStart;
+
+        console_print( "Latency histograms: %lu ns per vTaskGetLatencyHistogram() call, bucket n counts latencies from 2^(n-1) ns\n",
+                       ( unsigned long ) ( ullElapsed / mainSTATS_ITERATIONS ) );
+
+        for( uxHistogram = 0; uxHistogram < ( sizeof( pcHistogramNames ) / sizeof( pcHistogramNames[ 0 ] ) ); uxHistogram++ )
+        {
+            for( uxPriority = 0; uxPriority < configMAX_PRIORITIES; uxPriority++ )
+            {
+                vTaskGetLatencyHistogram( ( eLatencyHistogram ) uxHistogram, uxPriority, &xHistogram );
+
+                ulLatencies = 0;
+
+                for( uxBucket = 0; uxBucket < configLATENCY_HISTOGRAM_BUCKETS; uxBucket++ )
+                {
+                    ulLatencies += xHistogram.ulBuckets[ uxBucket ];
+                }
+
+                if( ulLatencies != 0 )
+                {
+                    iLength = snprintf( cLine, sizeof( cLine ), "%-8s latency, priority %lu: %8lu latencies, longest %9lu ns, buckets",
+                                        pcHistogramNames[ uxHistogram ],
+                                        ( unsigned long ) uxPriority,
+                                        ( unsigned long ) ulLatencies,
+                                        ( unsigned long ) xHistogram.ulMaximum );
+
+                    for( uxBucket = 0; uxBucket < configLATENCY_HISTOGRAM_BUCKETS; uxBucket++ )
+                    {
+                        iLength += snprintf( &( cLine[ iLength ] ), sizeof( cLine ) - ( size_t ) iLength, " %lu", ( unsigned long ) xHistogram.ulBuckets[ uxBucket ] );
+                    }
+
+                    console_print( "%s\n", cLine );
+                }
+            }
+        }
+    }
+
+#endif /* configUSE_LATENCY_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 )
+
+    static void prvStackHighWaterBenchmark( void )
+    {
+        UBaseType_t uxTask, uxMatching = 0;
+        uint32_t ulPoll, ulStackKilobytes;
+        uint64_t ullStart, ullFullScan, ullFirstIncremental, ullIncremental;
+        configSTACK_DEPTH_TYPE uxFree;
+        TaskHandle_t xPressureTask;
+
+        for( uxTask = 0; uxTask < mainSTACK_TASKS; uxTask++ )
+        {
+            xTaskCreate( prvStackUserTask, "Stack", configMINIMAL_STACK_SIZE, NULL, mainSLEEPER_TASK_PRIORITY, &( xSleeperHandles[ uxTask ] ) );
+
+            /* The task has the higher priority, so uses its stack and blocks
+             * again before this call returns. */
+            xTaskNotify( xSleeperHandles[ uxTask ], ( uint32_t ) ( uxTask % mainSTACK_MAX_KB ) + 1UL, eSetValueWithOverwrite );
+        }
+
+        ullStart = prvGetTimeNs();
+
+        for( ulPoll = 0; ulPoll < mainSTACK_POLLS; ulPoll++ )
+        {
+            for( uxTask = 0; uxTask < mainSTACK_TASKS; uxTask++ )
+            {
+                ( void ) uxTaskGetStackHighWaterMark2( xSleeperHandles[ uxTask ] );
+            }
+        }
+
+        ullFullScan = prvGetTimeNs() - ullStart;
+
+        /* The first poll scans the stack each task has used since it was
+         * created. */
+        ullStart = prvGetTimeNs();
+
+        for( uxTask = 0; uxTask < mainSTACK_TASKS; uxTask++ )
+        {
+            ( void ) uxTaskGetStackHighWaterMarkIncremental( xSleeperHandles[ uxTask ] );
+        }
+
+        ullFirstIncremental = prvGetTimeNs() - ullStart;
+
+        ullStart = prvGetTimeNs();
+
+        for( ulPoll = 0; ulPoll < mainSTACK_POLLS; ulPoll++ )
+        {
+            for( uxTask = 0; uxTask < mainSTACK_TASKS; uxTask++ )
+            {
+                ( void ) uxTaskGetStackHighWaterMarkIncremental( xSleeperHandles[ uxTask ] );
+            }
+        }
+
+        ullIncremental = prvGetTimeNs() - ullStart;
+
+        for( uxTask = 0; uxTask < mainSTACK_TASKS; uxTask++ )
+        {
+            if( uxTaskGetStackHighWaterMarkIncremental( xSleeperHandles[ uxTask ] ) == uxTaskGetStackHighWaterMark2( xSleeperHandles[ uxTask ] ) )
+            {
+                uxMatching++;
+            }
+        }
+
+        console_print( "Stack high water: %3lu tasks, %8lu ns per full scan poll, %8lu ns for the first incremental poll, %6lu ns per incremental poll, %3lu marks match\n",
+                       ( unsigned long ) mainSTACK_TASKS,
+                       ( unsigned long ) ( ullFullScan / mainSTACK_POLLS ),
+                       ( unsigned long ) ullFirstIncremental,
+                       ( unsigned long ) ( ullIncremental / mainSTACK_POLLS ),
+                       ( unsigned long ) uxMatching );
+
+        /* Use all but mainSTACK_PRESSURE_KB of one stack, which the next
+         * incremental poll reports to vApplicationStackPressureHook(). */
+        xPressureTask = xSleeperHandles[ mainSTACK_TASKS - 1UL ];
+        ulStackKilobytes = ( uint32_t ) ( ( configMINIMAL_STACK_SIZE * sizeof( StackType_t ) ) / 1024UL );
+        xTaskNotify( xPressureTask, ulStackKilobytes - mainSTACK_PRESSURE_KB, eSetValueWithOverwrite );
+
+        ullStart = prvGetTimeNs();
+        uxFree = uxTaskGetStackHighWaterMarkIncremental( xPressureTask );
+        ullIncremental = prvGetTimeNs() - ullStart;
+
+        console_print( "Stack high water: %lu of %lu words unused after a task used %luKB, found in %lu ns\n",
+                       ( unsigned long ) uxFree,
+                       ( unsigned long ) configMINIMAL_STACK_SIZE,
+                       ( unsigned long ) ( ulStackKilobytes - mainSTACK_PRESSURE_KB ),
+                       ( unsigned long ) ullIncremental );
+
+        for( uxTask = 0; uxTask < mainSTACK_TASKS; uxTask++ )
+        {
+            vTaskDelete( xSleeperHandles[ uxTask ] );
+        }
+
+        /* Allow the idle task to free the deleted tasks. */
+        vTaskDelay( pdMS_TO_TICKS( 100UL ) );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUseStack( uint32_t ulKilobytes )
+    {
+        volatile uint8_t ucKilobyte[ 1024 ];
+        uint32_t ulByte;
+
+        /* Written through the volatile array so the stores are not removed. */
+        for( ulByte = 0; ulByte < sizeof( ucKilobyte ); ulByte++ )
+        {
+            ucKilobyte[ ulByte ] = ( uint8_t ) ulByte;
+        }
+
+        if( ulKilobytes > 1UL )
+        {
+            prvUseStack( ulKilobytes - 1UL );
+        }
+
+        /* Reading the array after the call stops the compiler making it a
+         * tail call, which would reuse this frame. */
+        ( void ) ucKilobyte[ 0 ];
+    }
+
+#endif /* configUSE_STACK_HIGH_WATER_TRACKING */
+/*-----------------------------------------------------------*/
+
+static void prvMutexHandoffBenchmark( void )
+{
+    UBaseType_t uxRun, uxLink, uxInheritedPriority = 0;
+    uint32_t ulIteration;
+    uint64_t ullStart, ullElapsed, ullTotal, ullWorst;
+
+    for( uxRun = 0; uxRun < ( sizeof( uxHandoffDepths ) / sizeof( uxHandoffDepths[ 0 ] ) ); uxRun++ )
+    {
+        uxHandoffDepth = uxHandoffDepths[ uxRun ];
+
+        for( uxLink = 0; uxLink < uxHandoffDepth; uxLink++ )
+        {
+            xHandoffMutexes[ uxLink ] = xSemaphoreCreateMutex();
+            xTaskCreate( prvMutexChainTask, "Chain", configMINIMAL_STACK_SIZE, ( void * ) uxLink, mainHANDOFF_BASE_PRIORITY + uxLink, &( xHandoffTasks[ uxLink ] ) );
+        }
+
+        ullTotal = 0;
+        ullWorst = 0;
+
+        for( ulIteration = 0; ulIteration < mainHANDOFF_ITERATIONS; ulIteration++ )
+        {
+            xSemaphoreTake( xHandoffMutexes[ 0 ], portMAX_DELAY );
+
+            /* Each chain task has a higher priority than this task, so runs
+             * until it blocks on the mutex held by the task before it. */
+            for( uxLink = 0; uxLink < uxHandoffDepth; uxLink++ )
+            {
+                xTaskNotifyGive( xHandoffTasks[ uxLink ] );
+            }
+
+            uxInheritedPriority = uxTaskPriorityGet( NULL );
+
+            /* The chain runs to completion before this task runs again. */
+            ullStart = prvGetTimeNs();
+            xSemaphoreGive( xHandoffMutexes[ 0 ] );
+            ullElapsed = ullHandoffEnd - ullStart;
+
+            ullTotal += ullElapsed;
+
+            if( ullElapsed > ullWorst )
+            {
+                ullWorst = ullElapsed;
+            }
+        }
+
+        console_print( "Mutex handoff: %lu nested mutexes, inherited priority %lu of %lu, %6lu ns average, %6lu ns worst case\n",
+                       ( unsigned long ) uxHandoffDepth,
+                       ( unsigned long ) uxInheritedPriority,
+                       ( unsigned long ) ( mainHANDOFF_BASE_PRIORITY + uxHandoffDepth - 1 ),
+                       ( unsigned long ) ( ullTotal / mainHANDOFF_ITERATIONS ),
+                       ( unsigned long ) ullWorst );
+
+        for( uxLink = 0; uxLink < uxHandoffDepth; uxLink++ )
+        {
+            vTaskDelete( xHandoffTasks[ uxLink ] );
+            vSemaphoreDelete( xHandoffMutexes[ uxLink ] );
+        }
+
+        /* Allow the idle task to free the deleted chain tasks. */
+        vTaskDelay( pdMS_TO_TICKS( 100UL ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerServiceBenchmark( void )
+{
+    UBaseType_t uxRun, uxTimer, uxTimers;
+    BaseType_t xWithSlack;
+    uint64_t ullCPUTime;
+    uint32_t ulSwitches, ulCallbacks;
+    TickType_t xPeriod;
+
+    xTimerServiceTask = xTimerGetTimerDaemonTaskHandle();
+
+    for( uxRun = 0; uxRun < ( sizeof( uxTimerCounts ) / sizeof( uxTimerCounts[ 0 ] ) ); uxRun++ )
+    {
+        uxTimers = uxTimerCounts[ uxRun ];
+
+        for( xWithSlack = pdFALSE; xWithSlack <= pdTRUE; xWithSlack++ )
+        {
+            #if ( configUSE_TIMER_COALESCING == 0 )
+            {
+                if( xWithSlack != pdFALSE )
+                {
+                    break;
+                }
+            }
+            #endif
+
+            for( uxTimer = 0; uxTimer < uxTimers; uxTimer++ )
+            {
+                /* Spread the periods over the range so the timers do not
+                 * expire together without slack. */
+                xPeriod = ( TickType_t ) ( mainTIMER_MIN_PERIOD + ( ( uxTimer * 37UL ) % mainTIMER_PERIOD_RANGE ) );
+                xBenchmarkTimers[ uxTimer ] = xTimerCreate( "Bench", xPeriod, pdTRUE, NULL, prvBenchmarkTimerCallback );
+                configASSERT( xBenchmarkTimers[ uxTimer ] );
+
+                #if ( configUSE_TIMER_COALESCING == 1 )
+                {
+                    if( xWithSlack != pdFALSE )
+                    {
+                        vTimerSetSlack( xBenchmarkTimers[ uxTimer ], mainTIMER_SLACK );
+                    }
+                }
+                #endif
+
+                xTimerStart( xBenchmarkTimers[ uxTimer ], portMAX_DELAY );
+            }
+
+            /* Let the timers settle, then measure the timer service task for
+             * mainTIMER_RUN_TIME. */
+            vTaskDelay( mainTIMER_MIN_PERIOD );
+
+            ullCPUTime = ullTimerServiceCPUTime;
+            ulSwitches = ulTimerServiceSwitches;
+            ulCallbacks = ulTimerCallbacks;
+
+            vTaskDelay( mainTIMER_RUN_TIME );
+
+            ullCPUTime = ullTimerServiceCPUTime - ullCPUTime;
+            ulSwitches = ulTimerServiceSwitches - ulSwitches;
+            ulCallbacks = ulTimerCallbacks - ulCallbacks;
+
+            console_print( "Timer service (%4lu timers, %s): %6lu us CPU, %5lu runs, %6lu callbacks per second\n",
+                           ( unsigned long ) uxTimers,
+                           ( xWithSlack != pdFALSE ) ? "slack   " : "no slack",
+                           ( unsigned long ) ( ullCPUTime / 1000ULL ),
+                           ( unsigned long ) ulSwitches,
+                           ( unsigned long ) ulCallbacks );
+
+            /* The timer service task has a higher priority than this task, so
+             * processes each delete command as soon as it is sent. */
+            for( uxTimer = 0; uxTimer < uxTimers; uxTimer++ )
+            {
+                xTimerDelete( xBenchmarkTimers[ uxTimer ], portMAX_DELAY );
+            }
+        }
+    }
+
+    xTimerServiceTask = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdleBenchmark( void )
+{
+    TickType_t xStartTick, xTicks;
+    uint64_t ullStart, ullElapsed, ullCPUTime;
+
+    #if ( configPOSIX_VIRTUAL_TIME == 1 )
+        const char * const pcImplementation = "virtual time";
+    #elif ( configUSE_TICKLESS_IDLE == 1 )
+        const char * const pcImplementation = "tickless";
+    #else
+        const char * const pcImplementation = "ticking";
+    #endif
+
+    /* Start on a tick boundary. */
+    vTaskDelay( 1 );
+
+    xStartTick = xTaskGetTickCount();
+    ullStart = prvGetTimeNs();
+    ullCPUTime = prvGetProcessTimeNs();
+
+    vTaskDelay( mainIDLE_RUN_TIME );
+
+    ullCPUTime = prvGetProcessTimeNs() - ullCPUTime;
+    ullElapsed = prvGetTimeNs() - ullStart;
+    xTicks = xTaskGetTickCount() - xStartTick;
+
+    /* Virtual time passes without any wall clock time passing. */
+    if( ullElapsed < 1000000ULL )
+    {
+        ullElapsed = 1000000ULL;
+    }
+
+    console_print( "Idle (%-12s): %5lu ticks in %5lu ms, %7lu us of CPU time per second\n",
+                   pcImplementation,
+                   ( unsigned long ) xTicks,
+                   ( unsigned long ) ( ullElapsed / 1000000ULL ),
+                   ( unsigned long ) ( ( ullCPUTime * 1000000ULL ) / ullElapsed ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvVirtualTimeBenchmark( void )
+{
+    TaskHandle_t xTasks[ mainVIRTUAL_TASKS ];
+    uint32_t ulHashes[ 2 ];
+    UBaseType_t uxRun, uxTask;
+    TickType_t xStartTick;
+    uint64_t ullStart, ullElapsed;
+
+    #if ( configPOSIX_VIRTUAL_TIME == 1 )
+        const char * const pcImplementation = "virtual time";
+    #else
+        const char * const pcImplementation = "real time";
+    #endif
+
+    xVirtualTimeBenchmarkTask = xTaskGetCurrentTaskHandle();
+
+    for( uxRun = 0; uxRun < 2; uxRun++ )
+    {
+        /* FNV-1a offset basis. */
+        ulVirtualTimeHash = 2166136261UL;
+        ulVirtualTimeWakes = 0;
+
+        /* The tasks have higher priorities than this task, so start together
+         * when the scheduler is resumed. */
+        vTaskSuspendAll();
+        {
+            xStartTick = xTaskGetTickCount();
+            xVirtualTimeEnd = xStartTick + mainVIRTUAL_RUN_TIME;
+
+            for( uxTask = 0; uxTask < mainVIRTUAL_TASKS; uxTask++ )
+            {
+                xTaskCreate( prvVirtualTimeTask, "Virtual", configMINIMAL_STACK_SIZE, ( void * ) uxTask, mainBENCHMARK_TASK_PRIORITY + 1 + uxTask, &( xTasks[ uxTask ] ) );
+            }
+
+            ullStart = prvGetTimeNs();
+        }
+        xTaskResumeAll();
+
+        for( uxTask = 0; uxTask < mainVIRTUAL_TASKS; uxTask++ )
+        {
+            ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+        }
+
+        ullElapsed = prvGetTimeNs() - ullStart;
+        ulHashes[ uxRun ] = ulVirtualTimeHash;
+
+        console_print( "Virtual time (%s, run %lu): %5lu s simulated in %7lu ms, %7lu wakes, schedule hash %08lx\n",
+                       pcImplementation,
+                       ( unsigned long ) ( uxRun + 1 ),
+                       ( unsigned long ) ( ( xTaskGetTickCount() - xStartTick ) / configTICK_RATE_HZ ),
+                       ( unsigned long ) ( ullElapsed / 1000000ULL ),
+                       ( unsigned long ) ulVirtualTimeWakes,
+                       ( unsigned long ) ulHashes[ uxRun ] );
+
+        for( uxTask = 0; uxTask < mainVIRTUAL_TASKS; uxTask++ )
+        {
+            vTaskDelete( xTasks[ uxTask ] );
+        }
+
+        /* Allow the idle task to free the deleted tasks. */
+        vTaskDelay( pdMS_TO_TICKS( 100UL ) );
+    }
+
+    console_print( "Virtual time (%s): the schedules of the two runs %s\n",
+                   pcImplementation,
+                   ( ulHashes[ 0 ] == ulHashes[ 1 ] ) ? "match" : "differ" );
+
+    xVirtualTimeBenchmarkTask = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapBenchmark( void )
+{
+    HeapRegion_t xHeap5Regions[] =
+    {
+        { ucHeap5Region1, sizeof( ucHeap5Region1 ) },
+        { ucHeap5Region2, sizeof( ucHeap5Region2 ) },
+        { NULL,           0                        }
+    };
+    const HeapRegion_t xHeap6Regions[] =
+    {
+        /* heap_6.c does not require the regions to be in address order. */
+        { ucHeap6Region1, sizeof( ucHeap6Region1 ) },
+        { ucHeap6Region2, sizeof( ucHeap6Region2 ) },
+        { NULL,           0                        }
+    };
+    const BenchmarkHeap_t * pxHeap;
+    const HeapTraceOperation_t * pxOperation;
+    HeapStats_t xHeapStats;
+    uint32_t ulOperations, ulOperation, ulTimed, ulMallocs, ulFrees, ulFailures, ulBucket, ulFragmentation, ulWorstFragmentation;
+    uint64_t ullStart, ullElapsed, ullMallocTotal, ullFreeTotal, ullMallocWorst, ullFreeWorst, ullFragmentationTotal;
+    size_t x;
+
+    ulOperations = prvReadHeapTrace();
+
+    if( ulOperations == 0 )
+    {
+        console_print( "Heap: cannot read the heap trace %s\n", projHEAP_TRACE_FILE );
+        return;
+    }
+
+    /* heap_5.c requires its regions to be in address order. */
+    if( ucHeap5Region2 < ucHeap5Region1 )
+    {
+        xHeap5Regions[ 0 ].pucStartAddress = ucHeap5Region2;
+        xHeap5Regions[ 0 ].xSizeInBytes = sizeof( ucHeap5Region2 );
+        xHeap5Regions[ 1 ].pucStartAddress = ucHeap5Region1;
+        xHeap5Regions[ 1 ].xSizeInBytes = sizeof( ucHeap5Region1 );
+    }
+
+    vBenchmarkHeap5DefineHeapRegions( xHeap5Regions );
+    vBenchmarkHeap6DefineHeapRegions( xHeap6Regions );
+
+    for( x = 0; x < ( sizeof( xBenchmarkHeaps ) / sizeof( xBenchmarkHeaps[ 0 ] ) ); x++ )
+    {
+        pxHeap = &( xBenchmarkHeaps[ x ] );
+        ulFailures = 0;
+        ulWorstFragmentation = 0;
+        ullFragmentationTotal = 0;
+
+        /* Replay the trace once without timing it, to warm up and to measure
+         * the fragmentation after every operation. */
+        for( ulOperation = 0; ulOperation < ulOperations; ulOperation++ )
+        {
+            pxOperation = &( xHeapTrace[ ulOperation ] );
+
+            if( pxOperation->xIsMalloc != pdFALSE )
+            {
+                pvHeapTraceBlocks[ pxOperation->ulBlock ] = pxHeap->pvMalloc( pxOperation->ulSize );
+
+                if( pvHeapTraceBlocks[ pxOperation->ulBlock ] == NULL )
+                {
+                    ulFailures++;
+                }
+            }
+            else if( pvHeapTraceBlocks[ pxOperation->ulBlock ] != NULL )
+            {
+                pxHeap->vFree( pvHeapTraceBlocks[ pxOperation->ulBlock ] );
+                pvHeapTraceBlocks[ pxOperation->ulBlock ] = NULL;
+            }
+
+            if( pxHeap->vGetHeapStats != NULL )
+            {
+                pxHeap->vGetHeapStats( &xHeapStats );
+                ulFragmentation = ( uint32_t ) ( 1000U - ( ( ( uint64_t ) xHeapStats.xSizeOfLargestFreeBlockInBytes * 1000U ) / xHeapStats.xAvailableHeapSpaceInBytes ) );
+                ullFragmentationTotal += ulFragmentation;
+
+                if( ulFragmentation > ulWorstFragmentation )
+                {
+                    ulWorstFragmentation = ulFragmentation;
+                }
+            }
+        }
+
+        prvFreeHeapTraceBlocks( pxHeap );
+
+        /* Then replay it until enough operations have been timed. */
+        memset( ulMallocHistogram, 0, sizeof( ulMallocHistogram ) );
+        memset( ulFreeHistogram, 0, sizeof( ulFreeHistogram ) );
+        ullMallocTotal = 0;
+        ullFreeTotal = 0;
+        ullMallocWorst = 0;
+        ullFreeWorst = 0;
+        ulMallocs = 0;
+        ulFrees = 0;
+
+        for( ulTimed = 0; ulTimed < mainHEAP_REPLAY_OPERATIONS; ulTimed += ulOperations )
+        {
+            for( ulOperation = 0; ulOperation < ulOperations; ulOperation++ )
+            {
+                pxOperation = &( xHeapTrace[ ulOperation ] );
+
+                if( pxOperation->xIsMalloc != pdFALSE )
+                {
+                    ullStart = prvGetTimeNs();
+                    pvHeapTraceBlocks[ pxOperation->ulBlock ] = pxHeap->pvMalloc( pxOperation->ulSize );
+                    ullElapsed = prvGetTimeNs() - ullStart;
+
+                    ulBucket = ( uint32_t ) ( ullElapsed / mainHEAP_HISTOGRAM_NS );
+                    ulMallocHistogram[ ( ulBucket < mainHEAP_HISTOGRAM_BUCKETS ) ? ulBucket : ( mainHEAP_HISTOGRAM_BUCKETS - 1UL ) ]++;
+                    ullMallocTotal += ullElapsed;
+                    ulMallocs++;
+
+                    if( ullElapsed > ullMallocWorst )
+                    {
+                        ullMallocWorst = ullElapsed;
+                    }
+                }
+                else if( pvHeapTraceBlocks[ pxOperation->ulBlock ] != NULL )
+                {
+                    ullStart = prvGetTimeNs();
+                    pxHeap->vFree( pvHeapTraceBlocks[ pxOperation->ulBlock ] );
+                    ullElapsed = prvGetTimeNs() - ullStart;
+
+                    pvHeapTraceBlocks[ pxOperation->ulBlock ] = NULL;
+
+                    ulBucket = ( uint32_t ) ( ullElapsed / mainHEAP_HISTOGRAM_NS );
+                    ulFreeHistogram[ ( ulBucket < mainHEAP_HISTOGRAM_BUCKETS ) ? ulBucket : ( mainHEAP_HISTOGRAM_BUCKETS - 1UL ) ]++;
+                    ullFreeTotal += ullElapsed;
+                    ulFrees++;
+
+                    if( ullElapsed > ullFreeWorst )
+                    {
+                        ullFreeWorst = ullElapsed;
+                    }
+                }
+            }
+
+            prvFreeHeapTraceBlocks( pxHeap );
+        }
+
+        prvPrintHeapTimes( pxHeap->pcName, "pvPortMalloc", ulMallocHistogram, ullMallocTotal, ullMallocWorst, ulMallocs );
+        prvPrintHeapTimes( pxHeap->pcName, "vPortFree", ulFreeHistogram, ullFreeTotal, ullFreeWorst, ulFrees );
+
+        if( pxHeap->vGetHeapStats != NULL )
+        {
+            console_print( "Heap (%s): fragmentation %2lu.%lu%% average, %2lu.%lu%% worst, %lu failed allocations\n",
+                           pxHeap->pcName,
+                           ( unsigned long ) ( ( ullFragmentationTotal / ulOperations ) / 10U ),
+                           ( unsigned long ) ( ( ullFragmentationTotal / ulOperations ) % 10U ),
+                           ( unsigned long ) ( ulWorstFragmentation / 10U ),
+                           ( unsigned long ) ( ulWorstFragmentation % 10U ),
+                           ( unsigned long ) ulFailures );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvReadHeapTrace( void )
+{
+    FILE * pxFile;
+    char cOperation;
+    unsigned long ulBlock, ulSize;
+    uint32_t ulOperations = 0;
+    int iFields;
+
+    pxFile = fopen( projHEAP_TRACE_FILE, "r" );
+
+    if( pxFile != NULL )
+    {
+        /* Each line is "m <block> <size>" or "f <block>". */
+        while( ( ulOperations < mainHEAP_TRACE_MAX_OPERATIONS ) &&
+               ( fscanf( pxFile, " %c %lu", &cOperation, &ulBlock ) == 2 ) )
+        {
+            if( ulBlock >= mainHEAP_TRACE_MAX_BLOCKS )
+            {
+                ulOperations = 0;
+                break;
+            }
+
+            xHeapTrace[ ulOperations ].ulBlock = ( uint32_t ) ulBlock;
+
+            if( cOperation == 'm' )
+            {
+                iFields = fscanf( pxFile, " %lu", &ulSize );
+
+                if( iFields != 1 )
+                {
+                    ulOperations = 0;
+                    break;
+                }
+
+                xHeapTrace[ ulOperations ].ulSize = ( uint32_t ) ulSize;
+                xHeapTrace[ ulOperations ].xIsMalloc = pdTRUE;
+            }
+            else
+            {
+                xHeapTrace[ ulOperations ].ulSize = 0;
+                xHeapTrace[ ulOperations ].xIsMalloc = pdFALSE;
+            }
+
+            ulOperations++;
+        }
+
+        fclose( pxFile );
+    }
+
+    return ulOperations;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeHeapTraceBlocks( const BenchmarkHeap_t * pxHeap )
+{
+    uint32_t ulBlock;
+
+    for( ulBlock = 0; ulBlock < mainHEAP_TRACE_MAX_BLOCKS; ulBlock++ )
+    {
+        if( pvHeapTraceBlocks[ ulBlock ] != NULL )
+        {
+            pxHeap->vFree( pvHeapTraceBlocks[ ulBlock ] );
+            pvHeapTraceBlocks[ ulBlock ] = NULL;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintHeapTimes( const char * pcName,
+                               const char * pcFunction,
+                               const uint32_t * pulHistogram,
+                               uint64_t ullTotal,
+                               uint64_t ullWorst,
+                               uint32_t ulCount )
+{
+    uint32_t ulBucket, ulSeen = 0;
+
+    /* Find the bucket that holds the 99.9th percentile. */
+    for( ulBucket = 0; ulBucket < ( mainHEAP_HISTOGRAM_BUCKETS - 1UL ); ulBucket++ )
+    {
+        ulSeen += pulHistogram[ ulBucket ];
+
+        if( ( ( uint64_t ) ulSeen * 1000U ) >= ( ( uint64_t ) ulCount * 999U ) )
+        {
+            break;
+        }
+    }
+
+    console_print( "Heap (%s): %-12s %5lu ns average, %5lu ns 99.9%%, %7lu ns worst\n",
+                   pcName,
+                   pcFunction,
+                   ( unsigned long ) ( ( ulCount != 0 ) ? ( ullTotal / ulCount ) : 0 ),
+                   ( unsigned long ) ( ( ulBucket + 1UL ) * mainHEAP_HISTOGRAM_NS ),
+                   ( unsigned long ) ullWorst );
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkHeapMallocFailedHook( void )
+{
+    /* Failed allocations are counted by prvHeapBenchmark(). */
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+
+    ulTimerCallbacks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProbeTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Blocks until xTaskAbortDelay() is called by the benchmark task. */
+        vTaskDelay( mainPROBE_BLOCK_TIME );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSleeperTask( void * pvParameters )
+{
+    const TickType_t xBlockTime = mainSLEEPER_BLOCK_TIME + ( TickType_t ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelay( xBlockTime );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventProbeTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Blocks until the benchmark task sets the probe's bit. */
+        xEventGroupWaitBits( xBenchmarkEventGroup, mainEVENT_PROBE_BIT, pdTRUE, pdFALSE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventSleeperTask( void * pvParameters )
+{
+    const UBaseType_t uxSleeper = ( UBaseType_t ) pvParameters;
+    EventBits_t uxBits = mainEVENT_PROBE_BIT << ( 1UL + ( uxSleeper % mainEVENT_SLEEPER_BITS ) );
+    BaseType_t xWaitForAllBits = pdFALSE;
+
+    /* Every other sleeper waits for a second bit as well. */
+    if( ( uxSleeper & 1U ) != 0U )
+    {
+        uxBits |= mainEVENT_PROBE_BIT << ( 1UL + ( ( uxSleeper + 7UL ) % mainEVENT_SLEEPER_BITS ) );
+        xWaitForAllBits = pdTRUE;
+    }
+
+    for( ; ; )
+    {
+        /* None of the bits is ever set. */
+        xEventGroupWaitBits( xBenchmarkEventGroup, uxBits, pdFALSE, xWaitForAllBits, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMutexChainTask( void * pvParameters )
+{
+    const UBaseType_t uxLink = ( UBaseType_t ) pvParameters;
+    const BaseType_t xIsLast = ( uxLink == ( uxHandoffDepth - 1 ) ) ? pdTRUE : pdFALSE;
+
+    for( ; ; )
+    {
+        ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        /* Hold the mutex the next chain task will block on, then block on the
+         * mutex held by the task before this one. */
+        if( xIsLast == pdFALSE )
+        {
+            xSemaphoreTake( xHandoffMutexes[ uxLink + 1 ], portMAX_DELAY );
+        }
+
+        xSemaphoreTake( xHandoffMutexes[ uxLink ], portMAX_DELAY );
+
+        if( xIsLast != pdFALSE )
+        {
+            ullHandoffEnd = prvGetTimeNs();
+        }
+        else
+        {
+            xSemaphoreGive( xHandoffMutexes[ uxLink + 1 ] );
+        }
+
+        xSemaphoreGive( xHandoffMutexes[ uxLink ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldTask( void * pvParameters )
+{
+    uint32_t ulIteration;
+
+    ( void ) pvParameters;
+
+    /* The other task has the same priority, so is selected by every yield. */
+    for( ulIteration = 0; ulIteration < mainSWITCH_ITERATIONS; ulIteration++ )
+    {
+        taskYIELD();
+    }
+
+    xTaskNotifyGive( xSwitchBenchmarkTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPingPongTask( void * pvParameters )
+{
+    const UBaseType_t uxTask = ( UBaseType_t ) pvParameters;
+    const TaskHandle_t xOtherTask = xSwitchTasks[ 1 - uxTask ];
+    uint32_t ulIteration;
+
+    /* Giving the notification does not switch to the other task, as it has
+     * the same priority, but taking one blocks this task until the other has
+     * given it. */
+    for( ulIteration = 0; ulIteration < mainSWITCH_ITERATIONS; ulIteration++ )
+    {
+        if( uxTask == 0 )
+        {
+            xTaskNotifyGive( xOtherTask );
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        }
+        else
+        {
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+            xTaskNotifyGive( xOtherTask );
+        }
+    }
+
+    xTaskNotifyGive( xSwitchBenchmarkTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+    static void prvReceiveAnyTask( void * pvParameters )
+    {
+        const BaseType_t xUseSet = ( BaseType_t ) pvParameters;
+        QueueSetMemberHandle_t xMember;
+        UBaseType_t uxIndex = 0;
+        uint32_t ulItem = 0;
+
+        for( ; ; )
+        {
+            if( xUseSet != pdFALSE )
+            {
+                xMember = xQueueSelectFromSet( xAnyQueueSet, portMAX_DELAY );
+
+                for( uxIndex = 0; uxIndex < mainANY_QUEUES; uxIndex++ )
+                {
+                    if( xAnyQueues[ uxIndex ] == xMember )
+                    {
+                        break;
+                    }
+                }
+
+                xQueueReceive( xMember, &ulItem, 0 );
+            }
+            else
+            {
+                xQueueReceiveAny( xAnyQueues, mainANY_QUEUES, &ulItem, &uxIndex, portMAX_DELAY );
+            }
+
+            /* Item n is sent to queue n % mainANY_QUEUES. */
+            if( ( ulItem % mainANY_QUEUES ) != uxIndex )
+            {
+                ulAnyErrors++;
+            }
+
+            ulAnyReceived++;
+
+            if( ulAnyReceived == mainANY_ITERATIONS )
+            {
+                xTaskNotifyGive( xAnyBenchmarkTask );
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_RECEIVE_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+    static void prvReceiveAnyCheckTask( void * pvParameters )
+    {
+        uint32_t ulItem;
+
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            if( xQueueReceiveAny( xAnyQueues, 2, &ulItem, NULL, portMAX_DELAY ) == pdPASS )
+            {
+                ulAnyReceived++;
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_RECEIVE_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+    static void prvRWReaderTask( void * pvParameters )
+    {
+        uint32_t ulFirst;
+
+        ( void ) pvParameters;
+
+        while( xRWStop == pdFALSE )
+        {
+            if( xRWUseLock != pdFALSE )
+            {
+                xRWLockTakeRead( xRWLock, portMAX_DELAY );
+            }
+            else
+            {
+                xSemaphoreTake( xRWMutex, portMAX_DELAY );
+            }
+
+            /* Let the other readers run part way through the read, as a task
+             * that reads more data might be preempted. */
+            ulFirst = ulRWData[ 0 ];
+            taskYIELD();
+
+            if( ulRWData[ 1 ] != ulFirst )
+            {
+                ulRWErrors++;
+            }
+
+            if( xRWUseLock != pdFALSE )
+            {
+                xRWLockGiveRead( xRWLock );
+            }
+            else
+            {
+                xSemaphoreGive( xRWMutex );
+            }
+
+            ulRWReads++;
+        }
+
+        ulRWStopped++;
+        vTaskSuspend( NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRWWriterTask( void * pvParameters )
+    {
+        ( void ) pvParameters;
+
+        while( xRWStop == pdFALSE )
+        {
+            if( xRWUseLock != pdFALSE )
+            {
+                xRWLockTakeWrite( xRWLock, portMAX_DELAY );
+            }
+            else
+            {
+                xSemaphoreTake( xRWMutex, portMAX_DELAY );
+            }
+
+            ulRWData[ 0 ]++;
+            taskYIELD();
+            ulRWData[ 1 ] = ulRWData[ 0 ];
+
+            if( xRWUseLock != pdFALSE )
+            {
+                xRWLockGiveWrite( xRWLock );
+            }
+            else
+            {
+                xSemaphoreGive( xRWMutex );
+            }
+
+            ulRWWrites++;
+            vTaskDelay( mainRW_WRITE_PERIOD );
+        }
+
+        ulRWStopped++;
+        vTaskSuspend( NULL );
+    }
+
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WORK_QUEUES == 1 )
+
+    static void prvWorkLoadTask( void * pvParameters )
+    {
+        uint64_t ullStart;
+
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            ullStart = prvGetTimeNs();
+
+            while( ( prvGetTimeNs() - ullStart ) < mainWORK_BUSY_NS )
+            {
+            }
+
+            vTaskDelay( 1 );
+        }
+    }
+
+#endif /* configUSE_WORK_QUEUES */
+/*-----------------------------------------------------------*/
+
+static void prvVirtualTimeTask( void * pvParameters )
+{
+    const UBaseType_t uxTask = ( UBaseType_t ) pvParameters;
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    volatile uint32_t ulWork;
+    uint32_t ulLoop;
+    TickType_t xTick;
+
+    while( xLastWakeTime < xVirtualTimeEnd )
+    {
+        vTaskDelayUntil( &xLastWakeTime, xVirtualTimePeriods[ uxTask ] );
+
+        for( ulLoop = 0; ulLoop < mainVIRTUAL_WORK; ulLoop++ )
+        {
+            ulWork = ulLoop;
+        }
+
+        /* When the work ends depends on whether a tick interrupted it. */
+        taskENTER_CRITICAL();
+        {
+            xTick = xTaskGetTickCount();
+            ulVirtualTimeHash = ( ulVirtualTimeHash ^ ( uint32_t ) ( xTick - ( xVirtualTimeEnd - mainVIRTUAL_RUN_TIME ) ) ) * 16777619UL;
+            ulVirtualTimeHash = ( ulVirtualTimeHash ^ ( uint32_t ) uxTask ) * 16777619UL;
+            ulVirtualTimeWakes++;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    ( void ) ulWork;
+
+    xTaskNotifyGive( xVirtualTimeBenchmarkTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeNs( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetThreadTimeNs( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_THREAD_CPUTIME_ID, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetProcessTimeNs( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 )
+
+    static void prvStackUserTask( void * pvParameters )
+    {
+        uint32_t ulKilobytes;
+
+        ( void ) pvParameters;
+
+        for( ;; )
+        {
+            /* Use the amount of stack sent by the benchmark task. */
+            xTaskNotifyWait( 0UL, 0UL, &ulKilobytes, portMAX_DELAY );
+            prvUseStack( ulKilobytes );
+        }
+    }
+
+#endif /* configUSE_STACK_HIGH_WATER_TRACKING */
+/*-----------------------------------------------------------*/
+
+void vBenchmarkTraceTaskDelay( void )
+{
+    if( ( xTimedTask != NULL ) && ( xTaskGetCurrentTaskHandle() == xTimedTask ) )
+    {
+        ullTimedSectionStart = prvGetTimeNs();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkTraceEventGroupSetBits( void )
+{
+    if( ( xTimedTask != NULL ) && ( xTaskGetCurrentTaskHandle() == xTimedTask ) )
+    {
+        ullTimedSectionStart = prvGetTimeNs();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkTraceTaskSwitchedIn( void )
+{
+    #if ( configPOSIX_USE_UCONTEXT == 1 )
+    {
+        if( ( xTimerServiceTask != NULL ) && ( xTaskGetCurrentTaskHandle() == xTimerServiceTask ) )
+        {
+            ullTimerServiceSwitchedIn = prvGetThreadTimeNs();
+        }
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkTraceTaskSwitchedOut( void )
+{
+    if( ( ullTimedSectionStart != 0 ) && ( xTaskGetCurrentTaskHandle() == xTimedTask ) )
+    {
+        ullTimedSectionTotal += prvGetTimeNs() - ullTimedSectionStart;
+        ullTimedSectionStart = 0;
+    }
+
+    if( ( xTimerServiceTask != NULL ) && ( xTaskGetCurrentTaskHandle() == xTimerServiceTask ) )
+    {
+        #if ( configPOSIX_USE_UCONTEXT == 1 )
+        {
+            /* Every task shares this thread, so only the time since the task
+             * was switched in was used by the timer service task. */
+            ullTimerServiceCPUTime += prvGetThreadTimeNs() - ullTimerServiceSwitchedIn;
+        }
+        #else
+        {
+            /* The task is switched out on its own thread, so this is the CPU
+             * time used by the timer service task. */
+            ullTimerServiceCPUTime = prvGetThreadTimeNs();
+        }
+        #endif
+
+        ulTimerServiceSwitches++;
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,265 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/******************************************************************************
+ * NOTE 1: The FreeRTOS demo threads will not be running continuously, so
+ * do not expect to get real time behaviour from the FreeRTOS Linux port, or
+ * this demo application.  See the documentation page for the Linux port for
+ * further information:
+ * https://freertos.org/FreeRTOS-simulator-for-Linux.html
+ *
+ * NOTE 2:  This file only contains the source code that is specific to the
+ * multi-core demo.  Generic functions, such FreeRTOS hook functions, are
+ * defined in main.c.  Build it with:
+ *
+ *     make USER_DEMO=SMP_DEMO SMP_CORES=<number of cores>
+ ******************************************************************************
+ *
+ * main_smp() creates configNUMBER_OF_CORES spinner tasks, one low priority
+ * task, and a check task, then starts the scheduler on all cores.
+ *
+ * The Spinner Tasks:
+ * The spinner tasks run at mainSPINNER_TASK_PRIORITY and never block.  Each
+ * counts its iterations and records the cores it has executed on.  The last
+ * spinner is pinned to the last core with vTaskCoreAffinitySet(), and the
+ * others are kept off that core, so every core always has a spinner it can run.
+ *
+ * The Low Priority Task:
+ * Created at a priority below the spinners.  As there is always a spinner
+ * ready for every core, the scheduler must never select it.
+ *
+ * The Check Task:
+ * Runs every mainCHECK_PERIOD_MS at the highest priority and checks that:
+ * - every spinner has made progress, so configNUMBER_OF_CORES tasks are
+ *   sharing the cores;
+ * - every other core is running a spinner - not an idle task - at the moment
+ *   the check task runs;
+ * - the pinned spinner has only executed on the core it was pinned to;
+ * - the low priority task has never executed.
+ *
+ * Expected Behaviour:
+ * The check task prints "SMP OK" followed by the tick count each period.  If
+ * an error is found it instead prints the check that failed.
+ */
+
+#include <stdio.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Local includes. */
+#include "console.h"
+
+/* The demo is only built when configNUMBER_OF_CORES is greater than 1. */
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* Priorities at which the tasks are created. */
+#define mainCHECK_TASK_PRIORITY         ( tskIDLE_PRIORITY + 3 )
+#define mainSPINNER_TASK_PRIORITY       ( tskIDLE_PRIORITY + 2 )
+#define mainLOW_PRIORITY_TASK_PRIORITY  ( tskIDLE_PRIORITY + 1 )
+
+/* The period of the check task. */
+#define mainCHECK_PERIOD_MS             pdMS_TO_TICKS( 2000UL )
+
+/* The spinner that is pinned to the last core, and the core it is pinned to. */
+#define mainPINNED_SPINNER              ( configNUMBER_OF_CORES - 1 )
+#define mainPINNED_CORE_MASK            ( ( UBaseType_t ) 1 << ( configNUMBER_OF_CORES - 1 ) )
+
+/* The cores the other spinners can run on. */
+#define mainUNPINNED_CORE_MASK          ( mainPINNED_CORE_MASK - 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The tasks as described in the comments at the top of this file.
+ */
+static void prvSpinnerTask( void * pvParameters );
+static void prvLowPriorityTask( void * pvParameters );
+static void prvCheckTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* Incremented by each spinner on each iteration. */
+static volatile uint32_t ulSpinnerCounts[ configNUMBER_OF_CORES ] = { 0 };
+
+/* A bit for each core each spinner has executed on. */
+static volatile UBaseType_t uxSpinnerCores[ configNUMBER_OF_CORES ] = { 0 };
+
+/* Incremented by the low priority task, which should never run. */
+static volatile uint32_t ulLowPriorityCount = 0;
+
+/* Handles of the spinners, so the check task can recognise them. */
+static TaskHandle_t xSpinnerHandles[ configNUMBER_OF_CORES ] = { NULL };
+
+/*-----------------------------------------------------------*/
+
+/*** SEE THE COMMENTS AT THE TOP OF THIS FILE ***/
+void main_smp( void )
+{
+    BaseType_t x;
+    char cName[ configMAX_TASK_NAME_LEN ];
+
+    for( x = 0; x < configNUMBER_OF_CORES; x++ )
+    {
+        snprintf( cName, sizeof( cName ), "Spin%d", ( int ) x );
+        xTaskCreate( prvSpinnerTask, cName, configMINIMAL_STACK_SIZE, ( void * ) x, mainSPINNER_TASK_PRIORITY, &( xSpinnerHandles[ x ] ) );
+
+        /* Set the affinity before the scheduler starts so the pinned spinner
+         * never executes on another core.  Without keeping the other spinners
+         * off its core, an unpinned spinner could take the pinned core and
+         * leave another core with no eligible spinner. */
+        if( x == mainPINNED_SPINNER )
+        {
+            vTaskCoreAffinitySet( xSpinnerHandles[ x ], mainPINNED_CORE_MASK );
+        }
+        else
+        {
+            vTaskCoreAffinitySet( xSpinnerHandles[ x ], mainUNPINNED_CORE_MASK );
+        }
+    }
+
+    xTaskCreate( prvLowPriorityTask, "Low", configMINIMAL_STACK_SIZE, NULL, mainLOW_PRIORITY_TASK_PRIORITY, NULL );
+    xTaskCreate( prvCheckTask, "Check", configMINIMAL_STACK_SIZE, NULL, mainCHECK_TASK_PRIORITY, NULL );
+
+    /* Start the tasks running on all cores. */
+    vTaskStartScheduler();
+
+    /* If all is well, the scheduler will now be running, and the following
+     * line will never be reached.  If the following line does execute, then
+     * there was insufficient FreeRTOS heap memory available for the idle and/or
+     * timer tasks to be created.  See the memory management section on the
+     * FreeRTOS web site for more details. */
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSpinnerTask( void * pvParameters )
+{
+    const BaseType_t xSpinner = ( BaseType_t ) pvParameters;
+
+    for( ; ; )
+    {
+        /* The core can change between reading it and recording it, so a
+         * migrating spinner may record the core it just left.  The pinned
+         * spinner never migrates. */
+        uxSpinnerCores[ xSpinner ] |= ( ( UBaseType_t ) 1 << portGET_CORE_ID() );
+        ulSpinnerCounts[ xSpinner ]++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvLowPriorityTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ulLowPriorityCount++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTask( void * pvParameters )
+{
+    TickType_t xNextWakeTime;
+    uint32_t ulLastCounts[ configNUMBER_OF_CORES ] = { 0 };
+    const char * pcStatus;
+    TaskHandle_t xRunning;
+    BaseType_t x, xCore, xIsSpinner;
+
+    ( void ) pvParameters;
+
+    xNextWakeTime = xTaskGetTickCount();
+
+    for( ; ; )
+    {
+        vTaskDelayUntil( &xNextWakeTime, mainCHECK_PERIOD_MS );
+
+        pcStatus = NULL;
+
+        /* Every other core must be running a spinner, as the spinners are
+         * the highest priority ready tasks. */
+        for( xCore = 0; xCore < configNUMBER_OF_CORES; xCore++ )
+        {
+            xRunning = xTaskGetCurrentTaskHandleForCore( xCore );
+
+            if( xRunning != xTaskGetCurrentTaskHandle() )
+            {
+                xIsSpinner = pdFALSE;
+
+                for( x = 0; x < configNUMBER_OF_CORES; x++ )
+                {
+                    if( xRunning == xSpinnerHandles[ x ] )
+                    {
+                        xIsSpinner = pdTRUE;
+                    }
+                }
+
+                if( xIsSpinner == pdFALSE )
+                {
+                    pcStatus = "a core is not running a spinner";
+                }
+            }
+        }
+
+        /* Every spinner must have made progress since the last check. */
+        for( x = 0; x < configNUMBER_OF_CORES; x++ )
+        {
+            if( ulSpinnerCounts[ x ] == ulLastCounts[ x ] )
+            {
+                pcStatus = "a spinner did not make progress";
+            }
+
+            ulLastCounts[ x ] = ulSpinnerCounts[ x ];
+        }
+
+        if( ( uxSpinnerCores[ mainPINNED_SPINNER ] != mainPINNED_CORE_MASK ) ||
+            ( uxTaskCoreAffinityGet( xSpinnerHandles[ mainPINNED_SPINNER ] ) != mainPINNED_CORE_MASK ) )
+        {
+            pcStatus = "the pinned spinner ran on another core";
+        }
+
+        if( ulLowPriorityCount != 0 )
+        {
+            pcStatus = "the low priority task ran";
+        }
+
+        if( pcStatus == NULL )
+        {
+            console_print( "SMP OK: %lu\n", ( unsigned long ) xTaskGetTickCount() );
+        }
+        else
+        {
+            console_print( "SMP Error: %s\n", pcStatus );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configNUMBER_OF_CORES */
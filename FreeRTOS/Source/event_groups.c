@@ -61,11 +61,24 @@
     #define eventEVENT_BITS_CONTROL_BYTES    0xff000000UL
 #endif
 
+/* The number of event bits below the control bits, each of which has its own
+ * list of waiting tasks when configUSE_EVENT_GROUP_BIT_LISTS is 1.  The size of
+ * xDummy2b in StaticEventGroup_t must match. */
+#if configUSE_16_BIT_TICKS == 1
+    #define eventNUM_BIT_LISTS    8U
+#else
+    #define eventNUM_BIT_LISTS    24U
+#endif
+
 typedef struct EventGroupDef_t
 {
     EventBits_t uxEventBits;
     List_t xTasksWaitingForBits; /*< List of tasks waiting for a bit to be set. */
 
+    #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+        List_t xTasksWaitingForBit[ eventNUM_BIT_LISTS ]; /*< Tasks listed under one of the bits they wait for.  xTasksWaitingForBits then only holds the tasks waiting for any one of several bits. */
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxEventGroupNumber;
     #endif
@@ -89,6 +102,36 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                         const EventBits_t uxBitsToWaitFor,
                                         const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Unblock the tasks in pxList whose wait condition is met by the current event
+ * bits, and return the bits those tasks asked to be cleared on exit.  Must be
+ * called with the scheduler suspended.
+ */
+static EventBits_t prvUnblockWaitingTasks( EventGroup_t * pxEventBits,
+                                           List_t * pxList ) PRIVILEGED_FUNCTION;
+
+/*
+ * Initialise the lists of tasks waiting for the event bits of a new event
+ * group.
+ */
+static void prvInitialiseWaitLists( EventGroup_t * pxEventBits ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+
+/*
+ * Return the list a task waiting for uxBitsToWaitFor is placed in.  A task
+ * waiting for a single bit is listed under that bit, and a task waiting for
+ * all of several bits is listed under one of them that is not yet set, so in
+ * either case the task need only be tested when that bit is set.  A task
+ * waiting for any one of several bits could be unblocked by any of them, so is
+ * placed in xTasksWaitingForBits, which is tested whenever bits are set.
+ */
+    static List_t * prvGetWaitList( EventGroup_t * pxEventBits,
+                                    const EventBits_t uxBitsToWaitFor,
+                                    const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -116,7 +159,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
         if( pxEventBits != NULL )
         {
             pxEventBits->uxEventBits = 0;
-            vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+            prvInitialiseWaitLists( pxEventBits );
 
             #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
             {
@@ -167,7 +210,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
         if( pxEventBits != NULL )
         {
             pxEventBits->uxEventBits = 0;
-            vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+            prvInitialiseWaitLists( pxEventBits );
 
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
             {
@@ -235,7 +278,15 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+                {
+                    vTaskPlaceOnUnorderedEventList( prvGetWaitList( pxEventBits, uxBitsToWaitFor, pdTRUE ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                }
+                #else
+                {
+                    vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                }
+                #endif
 
                 /* This assignment is obsolete as uxReturn will get set after
                  * the task unblocks, but some compilers mistakenly generate a
@@ -394,7 +445,15 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
             /* Store the bits that the calling task is waiting for in the
              * task's event list item so the kernel knows when a match is
              * found.  Then enter the blocked state. */
-            vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+            #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+            {
+                vTaskPlaceOnUnorderedEventList( prvGetWaitList( pxEventBits, uxBitsToWaitFor, xWaitForAllBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+            }
+            #else
+            {
+                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+            }
+            #endif
 
             /* This is obsolete as it will get set after the task unblocks, but
              * some compilers mistakenly generate a warning about the variable
@@ -520,11 +579,11 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
     EventGroup_t const * const pxEventBits = xEventGroup;
     EventBits_t uxReturn;
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         uxReturn = pxEventBits->uxEventBits;
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return uxReturn;
 } /*lint !e818 EventGroupHandle_t is a typedef used in other functions to so can't be pointer to const. */
@@ -533,96 +592,156 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
                                 const EventBits_t uxBitsToSet )
 {
-    ListItem_t * pxListItem;
-    ListItem_t * pxNext;
-    ListItem_t const * pxListEnd;
-    List_t const * pxList;
-    EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+    EventBits_t uxBitsToClear = 0;
     EventGroup_t * pxEventBits = xEventGroup;
-    BaseType_t xMatchFound = pdFALSE;
+
+    #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+        UBaseType_t uxBit;
+    #endif
 
     /* Check the user is not attempting to set the bits used by the kernel
      * itself. */
     configASSERT( xEventGroup );
     configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-    pxList = &( pxEventBits->xTasksWaitingForBits );
-    pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
     vTaskSuspendAll();
     {
         traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-        pxListItem = listGET_HEAD_ENTRY( pxList );
-
         /* Set the bits. */
         pxEventBits->uxEventBits |= uxBitsToSet;
 
         /* See if the new bit value should unblock any tasks. */
-        while( pxListItem != pxListEnd )
+        #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
         {
-            pxNext = listGET_NEXT( pxListItem );
-            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-            xMatchFound = pdFALSE;
-
-            /* Split the bits waited for from the control bits. */
-            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
-
-            if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+            /* Only the tasks listed under the bits being set, and the tasks
+             * waiting for any one of several bits, can be unblocked. */
+            for( uxBit = 0; uxBit < eventNUM_BIT_LISTS; uxBit++ )
             {
-                /* Just looking for single bit being set. */
-                if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+                if( ( uxBitsToSet & ( ( EventBits_t ) 1 << uxBit ) ) != ( EventBits_t ) 0 )
                 {
-                    xMatchFound = pdTRUE;
+                    uxBitsToClear |= prvUnblockWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+        }
+        #endif /* configUSE_EVENT_GROUP_BIT_LISTS */
+
+        uxBitsToClear |= prvUnblockWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBits ) );
+
+        /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+         * bit was set in the control word. */
+        pxEventBits->uxEventBits &= ~uxBitsToClear;
+    }
+    ( void ) xTaskResumeAll();
+
+    return pxEventBits->uxEventBits;
+}
+/*-----------------------------------------------------------*/
+
+static EventBits_t prvUnblockWaitingTasks( EventGroup_t * pxEventBits,
+                                           List_t * pxList )
+{
+    ListItem_t * pxListItem;
+    ListItem_t * pxNext;
+    ListItem_t const * pxListEnd;
+    EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+    BaseType_t xMatchFound;
+
+    #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+        List_t * pxWaitList;
+    #endif
+
+    pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+    pxListItem = listGET_HEAD_ENTRY( pxList );
+
+    while( pxListItem != pxListEnd )
+    {
+        pxNext = listGET_NEXT( pxListItem );
+        uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+        xMatchFound = pdFALSE;
+
+        /* Split the bits waited for from the control bits. */
+        uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+        uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+        if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+        {
+            /* Just looking for single bit being set. */
+            if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
             {
-                /* All bits are set. */
                 xMatchFound = pdTRUE;
             }
             else
             {
-                /* Need all bits to be set, but not all the bits were set. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+        {
+            /* All bits are set. */
+            xMatchFound = pdTRUE;
+        }
+        else
+        {
+            /* Need all bits to be set, but not all the bits were set. */
+        }
+
+        if( xMatchFound != pdFALSE )
+        {
+            /* The bits match.  Should the bits be cleared on exit? */
+            if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+            {
+                uxBitsToClear |= uxBitsWaitedFor;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
 
-            if( xMatchFound != pdFALSE )
+            /* Store the actual event flag value in the task's event list
+             * item before removing the task from the event list.  The
+             * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+             * that is was unblocked due to its required bits matching, rather
+             * than because it timed out. */
+            vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+        }
+
+        #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+            else if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 )
             {
-                /* The bits match.  Should the bits be cleared on exit? */
-                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                /* The task waits for all of several bits, and the bit it was
+                 * listed under may now be set, so list it under one that is
+                 * not.  Clearing bits never sets the bit the task is listed
+                 * under. */
+                pxWaitList = prvGetWaitList( pxEventBits, uxBitsWaitedFor, pdTRUE );
+
+                if( pxWaitList != pxList )
                 {
-                    uxBitsToClear |= uxBitsWaitedFor;
+                    ( void ) uxListRemove( pxListItem );
+                    vListInsertEnd( pxWaitList, pxListItem );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-
-                /* Store the actual event flag value in the task's event list
-                 * item before removing the task from the event list.  The
-                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-                 * that is was unblocked due to its required bits matching, rather
-                 * than because it timed out. */
-                vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
             }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        #endif /* configUSE_EVENT_GROUP_BIT_LISTS */
 
-            /* Move onto the next list item.  Note pxListItem->pxNext is not
-             * used here as the list item may have been removed from the event list
-             * and inserted into the ready/pending reading list. */
-            pxListItem = pxNext;
-        }
-
-        /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-         * bit was set in the control word. */
-        pxEventBits->uxEventBits &= ~uxBitsToClear;
+        /* Move onto the next list item.  Note pxListItem->pxNext is not
+         * used here as the list item may have been removed from the event list
+         * and inserted into the ready/pending reading list. */
+        pxListItem = pxNext;
     }
-    ( void ) xTaskResumeAll();
 
-    return pxEventBits->uxEventBits;
+    return uxBitsToClear;
 }
 /*-----------------------------------------------------------*/
 
@@ -631,6 +750,10 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
     EventGroup_t * pxEventBits = xEventGroup;
     const List_t * pxTasksWaitingForBits;
 
+    #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+        UBaseType_t uxBit;
+    #endif
+
     configASSERT( pxEventBits );
 
     pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
@@ -639,6 +762,20 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
     {
         traceEVENT_GROUP_DELETE( xEventGroup );
 
+        #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+        {
+            /* Unblock the tasks listed under each bit, then those in
+             * xTasksWaitingForBits below. */
+            for( uxBit = 0; uxBit < eventNUM_BIT_LISTS; uxBit++ )
+            {
+                while( listCURRENT_LIST_LENGTH( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) ) > ( UBaseType_t ) 0 )
+                {
+                    vTaskRemoveFromUnorderedEventList( listGET_HEAD_ENTRY( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) ), eventUNBLOCKED_DUE_TO_BIT_SET );
+                }
+            }
+        }
+        #endif /* configUSE_EVENT_GROUP_BIT_LISTS */
+
         while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
         {
             /* Unblock the task, returning 0 as the event list is being deleted
@@ -727,6 +864,72 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
 }
 /*-----------------------------------------------------------*/
 
+static void prvInitialiseWaitLists( EventGroup_t * pxEventBits )
+{
+    #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+        UBaseType_t uxBit;
+    #endif
+
+    vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+
+    #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+    {
+        for( uxBit = 0; uxBit < eventNUM_BIT_LISTS; uxBit++ )
+        {
+            vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+        }
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+
+    static List_t * prvGetWaitList( EventGroup_t * pxEventBits,
+                                    const EventBits_t uxBitsToWaitFor,
+                                    const BaseType_t xWaitForAllBits )
+    {
+        List_t * pxList = &( pxEventBits->xTasksWaitingForBits );
+        EventBits_t uxKeyBits;
+        UBaseType_t uxBit;
+
+        if( xWaitForAllBits != pdFALSE )
+        {
+            /* Only a bit that is not yet set can complete the wait. */
+            uxKeyBits = uxBitsToWaitFor & ~( pxEventBits->uxEventBits );
+        }
+        else if( ( uxBitsToWaitFor & ( uxBitsToWaitFor - ( EventBits_t ) 1 ) ) == ( EventBits_t ) 0 )
+        {
+            /* Waiting for a single bit. */
+            uxKeyBits = uxBitsToWaitFor;
+        }
+        else
+        {
+            /* Waiting for any one of several bits. */
+            uxKeyBits = 0;
+        }
+
+        /* List the task under the lowest key bit.  Bits above the indexed
+         * bits, which can exist when TickType_t is 64 bits, have no list of
+         * their own. */
+        for( uxBit = 0; ( uxBit < eventNUM_BIT_LISTS ) && ( pxList == &( pxEventBits->xTasksWaitingForBits ) ); uxBit++ )
+        {
+            if( ( uxKeyBits & ( ( EventBits_t ) 1 << uxBit ) ) != ( EventBits_t ) 0 )
+            {
+                pxList = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return pxList;
+    }
+
+#endif /* configUSE_EVENT_GROUP_BIT_LISTS */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
@@ -58,6 +58,12 @@
 /* Application specific configuration options. */
 #include "FreeRTOSConfig.h"
 
+/* Must be defaulted before portable.h is included, as multi-core ports key
+ * their definitions off it. */
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES    1
+#endif
+
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
@@ -311,6 +317,74 @@
     #error configMAX_TASK_NAME_LEN must be set to a minimum of 1 in FreeRTOSConfig.h
 #endif
 
+#if configNUMBER_OF_CORES < 1
+    #error configNUMBER_OF_CORES must be set to a minimum of 1 in FreeRTOSConfig.h
+#endif
+
+#ifndef configUSE_CORE_AFFINITY
+    #define configUSE_CORE_AFFINITY    0
+#endif
+
+/* Set to 0 on a multi-core build to only run tasks of one priority at a time -
+ * a core with no task of the top ready priority to run runs its idle task. */
+#ifndef configRUN_MULTIPLE_PRIORITIES
+    #define configRUN_MULTIPLE_PRIORITIES    1
+#endif
+
+#ifndef configUSE_PASSIVE_IDLE_HOOK
+    #define configUSE_PASSIVE_IDLE_HOOK    0
+#endif
+
+#if ( configNUMBER_OF_CORES == 1 )
+
+/* A single core build always runs on core 0. */
+    #ifndef portGET_CORE_ID
+        #define portGET_CORE_ID()    0
+    #endif
+
+    #if ( configUSE_CORE_AFFINITY != 0 )
+        #error configUSE_CORE_AFFINITY can only be used when configNUMBER_OF_CORES is greater than 1.
+    #endif
+#else /* configNUMBER_OF_CORES */
+
+/* The SMP scheduler needs the port to identify the executing core, to
+ * interrupt other cores, and to provide two recursive spinlocks - the task lock
+ * (held while the scheduler is suspended or a task level critical section is
+ * active) and the ISR lock (held while the kernel data structures are being
+ * accessed).  The critical nesting count is maintained per core by the port. */
+    #ifndef portGET_CORE_ID
+        #error portGET_CORE_ID() must be defined by the port when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #ifndef portYIELD_CORE
+        #error portYIELD_CORE( xCoreID ) must be defined by the port when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if !defined( portGET_TASK_LOCK ) || !defined( portRELEASE_TASK_LOCK ) || !defined( portGET_ISR_LOCK ) || !defined( portRELEASE_ISR_LOCK )
+        #error portGET_TASK_LOCK(), portRELEASE_TASK_LOCK(), portGET_ISR_LOCK() and portRELEASE_ISR_LOCK() must be defined by the port when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if !defined( portGET_CRITICAL_NESTING_COUNT ) || !defined( portSET_CRITICAL_NESTING_COUNT ) || !defined( portINCREMENT_CRITICAL_NESTING_COUNT ) || !defined( portDECREMENT_CRITICAL_NESTING_COUNT )
+        #error The portXXX_CRITICAL_NESTING_COUNT() macros must be defined by the port when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+        #error configUSE_PORT_OPTIMISED_TASK_SELECTION is not supported when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_CO_ROUTINES == 1 )
+        #error Co-routines are not supported when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+        #error configUSE_TICKLESS_IDLE is not supported when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+        #error portCRITICAL_NESTING_IN_TCB is not supported when configNUMBER_OF_CORES is greater than 1 - the critical nesting count is held per core by the port.
+    #endif
+#endif /* configNUMBER_OF_CORES */
+
 #ifndef configASSERT
     #define configASSERT( x )
     #define configASSERT_DEFINED    0
@@ -493,6 +567,41 @@
     #define configRECORD_STACK_HIGH_ADDRESS    0
 #endif
 
+#ifndef configUSE_STACK_HIGH_WATER_TRACKING
+    #define configUSE_STACK_HIGH_WATER_TRACKING    0
+#endif
+
+/* The number of consecutive unused stack words
+ * uxTaskGetStackHighWaterMarkIncremental() must find before it stops scanning.
+ * A larger value tolerates larger areas of stack that a task reserves but never
+ * writes, at the cost of reading more words on each call. */
+#ifndef configSTACK_HIGH_WATER_SCAN_GAP
+    #define configSTACK_HIGH_WATER_SCAN_GAP    32
+#endif
+
+/* vApplicationStackPressureHook() is called when a task's stack high water
+ * mark leaves configSTACK_PRESSURE_THRESHOLD words or fewer unused.  0 disables
+ * the hook. */
+#ifndef configSTACK_PRESSURE_THRESHOLD
+    #define configSTACK_PRESSURE_THRESHOLD    0
+#endif
+
+#if ( ( configSTACK_PRESSURE_THRESHOLD > 0 ) && ( configUSE_STACK_HIGH_WATER_TRACKING != 1 ) )
+    #error configSTACK_PRESSURE_THRESHOLD is set but the hook is driven by the tracked high water mark, so configUSE_STACK_HIGH_WATER_TRACKING must also be set to 1 in FreeRTOSConfig.h.
+#endif
+
+#if ( configSTACK_HIGH_WATER_SCAN_GAP < 1 )
+    #error configSTACK_HIGH_WATER_SCAN_GAP must be at least 1.
+#endif
+
+/* Set to 1 if the port saves a task's stack pointer in pxTopOfStack before
+ * calling vTaskSwitchContext(), which is the case for ports that switch tasks by
+ * swapping stacks.  The stack high water mark is then also updated from the
+ * saved stack pointer each time a task is switched out. */
+#ifndef portSTACK_POINTER_SAVED_IN_TCB
+    #define portSTACK_POINTER_SAVED_IN_TCB    1
+#endif
+
 #ifndef configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H
     #define configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H    0
 #endif
@@ -595,6 +704,22 @@
     #define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )
 #endif
 
+#ifndef traceQUEUE_SEND_MULTIPLE
+    #define traceQUEUE_SEND_MULTIPLE( pxQueue, uxItemCount )
+#endif
+
+#ifndef traceQUEUE_SEND_MULTIPLE_FROM_ISR
+    #define traceQUEUE_SEND_MULTIPLE_FROM_ISR( pxQueue, uxItemCount )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_MULTIPLE
+    #define traceQUEUE_RECEIVE_MULTIPLE( pxQueue, uxItemCount )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR
+    #define traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR( pxQueue, uxItemCount )
+#endif
+
 #ifndef traceQUEUE_PEEK_FROM_ISR_FAILED
     #define traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue )
 #endif
@@ -603,6 +728,110 @@
     #define traceQUEUE_DELETE( pxQueue )
 #endif
 
+#ifndef tracePOOL_CREATE
+    #define tracePOOL_CREATE( pxPool )
+#endif
+
+#ifndef tracePOOL_DELETE
+    #define tracePOOL_DELETE( pxPool )
+#endif
+
+#ifndef tracePOOL_ALLOC
+    #define tracePOOL_ALLOC( pxPool, pvObject )
+#endif
+
+#ifndef tracePOOL_ALLOC_FAILED
+    #define tracePOOL_ALLOC_FAILED( pxPool )
+#endif
+
+#ifndef traceBLOCKING_ON_POOL_ALLOC
+    #define traceBLOCKING_ON_POOL_ALLOC( pxPool )
+#endif
+
+#ifndef tracePOOL_ALLOC_FROM_ISR
+    #define tracePOOL_ALLOC_FROM_ISR( pxPool, pvObject )
+#endif
+
+#ifndef tracePOOL_ALLOC_FROM_ISR_FAILED
+    #define tracePOOL_ALLOC_FROM_ISR_FAILED( pxPool )
+#endif
+
+#ifndef tracePOOL_FREE
+    #define tracePOOL_FREE( pxPool, pvObject )
+#endif
+
+#ifndef tracePOOL_FREE_FROM_ISR
+    #define tracePOOL_FREE_FROM_ISR( pxPool, pvObject )
+#endif
+
+#ifndef traceRWLOCK_CREATE
+    #define traceRWLOCK_CREATE( pxRWLock )
+#endif
+
+#ifndef traceRWLOCK_CREATE_FAILED
+    #define traceRWLOCK_CREATE_FAILED()
+#endif
+
+#ifndef traceRWLOCK_DELETE
+    #define traceRWLOCK_DELETE( pxRWLock )
+#endif
+
+#ifndef traceRWLOCK_TAKE_READ
+    #define traceRWLOCK_TAKE_READ( pxRWLock )
+#endif
+
+#ifndef traceRWLOCK_TAKE_READ_FAILED
+    #define traceRWLOCK_TAKE_READ_FAILED( pxRWLock )
+#endif
+
+#ifndef traceBLOCKING_ON_RWLOCK_READ
+    #define traceBLOCKING_ON_RWLOCK_READ( pxRWLock )
+#endif
+
+#ifndef traceRWLOCK_GIVE_READ
+    #define traceRWLOCK_GIVE_READ( pxRWLock )
+#endif
+
+#ifndef traceRWLOCK_TAKE_WRITE
+    #define traceRWLOCK_TAKE_WRITE( pxRWLock )
+#endif
+
+#ifndef traceRWLOCK_TAKE_WRITE_FAILED
+    #define traceRWLOCK_TAKE_WRITE_FAILED( pxRWLock )
+#endif
+
+#ifndef traceBLOCKING_ON_RWLOCK_WRITE
+    #define traceBLOCKING_ON_RWLOCK_WRITE( pxRWLock )
+#endif
+
+#ifndef traceRWLOCK_GIVE_WRITE
+    #define traceRWLOCK_GIVE_WRITE( pxRWLock )
+#endif
+
+#ifndef traceWORK_QUEUE_CREATE
+    #define traceWORK_QUEUE_CREATE( pxWorkQueue )
+#endif
+
+#ifndef traceWORK_QUEUE_CREATE_FAILED
+    #define traceWORK_QUEUE_CREATE_FAILED()
+#endif
+
+#ifndef traceWORK_QUEUE_SUBMIT
+    #define traceWORK_QUEUE_SUBMIT( pxWorkQueue, pxWorkItem )
+#endif
+
+#ifndef traceWORK_QUEUE_SUBMIT_FROM_ISR
+    #define traceWORK_QUEUE_SUBMIT_FROM_ISR( pxWorkQueue, pxWorkItem )
+#endif
+
+#ifndef traceWORK_QUEUE_COALESCE
+    #define traceWORK_QUEUE_COALESCE( pxWorkQueue, pxWorkItem )
+#endif
+
+#ifndef traceWORK_QUEUE_EXECUTE
+    #define traceWORK_QUEUE_EXECUTE( pxWorkQueue, pxWorkItem )
+#endif
+
 #ifndef traceTASK_CREATE
     #define traceTASK_CREATE( pxNewTCB )
 #endif
@@ -825,6 +1054,30 @@
 
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+#ifndef configUSE_TASK_PERF_COUNTERS
+    #define configUSE_TASK_PERF_COUNTERS    0
+#endif
+
+#if ( ( configUSE_TASK_PERF_COUNTERS == 1 ) && ( configGENERATE_RUN_TIME_STATS != 1 ) )
+    #error configUSE_TASK_PERF_COUNTERS is 1 but the perf counters are timed using the run time stats clock, so configGENERATE_RUN_TIME_STATS must also be set to 1 in FreeRTOSConfig.h.
+#endif
+
+#ifndef configUSE_LATENCY_HISTOGRAMS
+    #define configUSE_LATENCY_HISTOGRAMS    0
+#endif
+
+#if ( ( configUSE_LATENCY_HISTOGRAMS == 1 ) && ( configGENERATE_RUN_TIME_STATS != 1 ) )
+    #error configUSE_LATENCY_HISTOGRAMS is 1 but latencies are timed using the run time stats clock, so configGENERATE_RUN_TIME_STATS must also be set to 1 in FreeRTOSConfig.h.
+#endif
+
+#ifndef configLATENCY_HISTOGRAM_BUCKETS
+    #define configLATENCY_HISTOGRAM_BUCKETS    16
+#endif
+
+#if ( configLATENCY_HISTOGRAM_BUCKETS < 2 )
+    #error configLATENCY_HISTOGRAM_BUCKETS must be at least 2.
+#endif
+
 #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
     #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
@@ -838,19 +1091,30 @@
 #endif
 
 #ifndef portYIELD_WITHIN_API
-    #define portYIELD_WITHIN_API    portYIELD
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define portYIELD_WITHIN_API    portYIELD
+    #else
+        #define portYIELD_WITHIN_API    vTaskYieldWithinAPI
+    #endif
 #endif
 
 #ifndef portSUPPRESS_TICKS_AND_SLEEP
     #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
 #endif
 
+/* The shortest idle period portSUPPRESS_TICKS_AND_SLEEP() can handle.  Ports
+ * that program a hardware timer to end the idle period need at least two tick
+ * periods. */
+#ifndef portMIN_EXPECTED_IDLE_TIME_BEFORE_SLEEP
+    #define portMIN_EXPECTED_IDLE_TIME_BEFORE_SLEEP    2
+#endif
+
 #ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
-    #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2
+    #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    portMIN_EXPECTED_IDLE_TIME_BEFORE_SLEEP
 #endif
 
-#if configEXPECTED_IDLE_TIME_BEFORE_SLEEP < 2
-    #error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than 2
+#if configEXPECTED_IDLE_TIME_BEFORE_SLEEP < portMIN_EXPECTED_IDLE_TIME_BEFORE_SLEEP
+    #error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than portMIN_EXPECTED_IDLE_TIME_BEFORE_SLEEP, which is 2 unless the port defines it otherwise
 #endif
 
 #ifndef configUSE_TICKLESS_IDLE
@@ -873,6 +1137,78 @@
     #define configUSE_QUEUE_SETS    0
 #endif
 
+#ifndef configUSE_SPSC_QUEUES
+    #define configUSE_SPSC_QUEUES    0
+#endif
+
+#ifndef configUSE_QUEUE_BATCHING
+    #define configUSE_QUEUE_BATCHING    0
+#endif
+
+#ifndef configUSE_QUEUE_RECEIVE_ANY
+    #define configUSE_QUEUE_RECEIVE_ANY    0
+#endif
+
+/* The largest number of queues xQueueReceiveAny() can wait on at once.  The
+ * calling task needs one list item per queue on its stack while it is blocked. */
+#ifndef configQUEUE_RECEIVE_ANY_MAX_QUEUES
+    #define configQUEUE_RECEIVE_ANY_MAX_QUEUES    4
+#endif
+
+#if ( configQUEUE_RECEIVE_ANY_MAX_QUEUES < 1 )
+    #error configQUEUE_RECEIVE_ANY_MAX_QUEUES must be at least 1.
+#endif
+
+#ifndef configUSE_OBJECT_POOLS
+    #define configUSE_OBJECT_POOLS    0
+#endif
+
+#ifndef configUSE_RW_LOCKS
+    #define configUSE_RW_LOCKS    0
+#endif
+
+#if ( ( configUSE_RW_LOCKS == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use reader-writer locks
+#endif
+
+#ifndef configUSE_SIZED_KERNEL_MEMCPY
+    #define configUSE_SIZED_KERNEL_MEMCPY    0
+#endif
+
+/* configKERNEL_MEMCPY() copies data into and out of the storage of queues and
+ * stream buffers, often from within a critical section.  Define it in
+ * FreeRTOSConfig.h to use a copy routine other than memcpy().  Otherwise,
+ * when configUSE_SIZED_KERNEL_MEMCPY is 1, copies of 4, 8, 16 and 32 bytes are
+ * made by memcpy() calls of a constant size, which the compiler can replace with
+ * a few load and store instructions, and only other sizes call memcpy(). */
+#ifndef configKERNEL_MEMCPY
+    #if ( configUSE_SIZED_KERNEL_MEMCPY == 1 )
+        #define configKERNEL_MEMCPY( pvDest, pvSource, xBytes )                             \
+            do {                                                                            \
+                switch( xBytes )                                                            \
+                {                                                                           \
+                    case 4U:                                                                \
+                        ( void ) memcpy( ( pvDest ), ( pvSource ), 4U );                    \
+                        break;                                                              \
+                    case 8U:                                                                \
+                        ( void ) memcpy( ( pvDest ), ( pvSource ), 8U );                    \
+                        break;                                                              \
+                    case 16U:                                                               \
+                        ( void ) memcpy( ( pvDest ), ( pvSource ), 16U );                   \
+                        break;                                                              \
+                    case 32U:                                                               \
+                        ( void ) memcpy( ( pvDest ), ( pvSource ), 32U );                   \
+                        break;                                                              \
+                    default:                                                                \
+                        ( void ) memcpy( ( pvDest ), ( pvSource ), ( size_t ) ( xBytes ) ); \
+                        break;                                                              \
+                }                                                                           \
+            } while( 0 )
+    #else
+        #define configKERNEL_MEMCPY( pvDest, pvSource, xBytes )    ( void ) memcpy( ( pvDest ), ( pvSource ), ( xBytes ) )
+    #endif
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -889,6 +1225,36 @@
     #define configUSE_TIME_SLICING    1
 #endif
 
+#ifndef configUSE_TIMER_WHEEL
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+    #define configTIMER_WHEEL_SLOT_BITS    5
+#endif
+
+#ifndef configUSE_TIMER_SERVICE_WHEEL
+    #define configUSE_TIMER_SERVICE_WHEEL    0
+#endif
+
+#if ( ( configUSE_TIMER_WHEEL == 1 ) || ( configUSE_TIMER_SERVICE_WHEEL == 1 ) )
+    #if ( ( configTIMER_WHEEL_SLOT_BITS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS > 5 ) )
+        #error configTIMER_WHEEL_SLOT_BITS must be between 1 and 5 (the wheel has 2 to the power of configTIMER_WHEEL_SLOT_BITS slots per level).
+    #endif
+#endif
+
+#ifndef configUSE_TIMER_COALESCING
+    #define configUSE_TIMER_COALESCING    0
+#endif
+
+#ifndef configTIMER_COMMAND_BATCH_SIZE
+    #define configTIMER_COMMAND_BATCH_SIZE    1
+#endif
+
+#if ( ( configTIMER_COMMAND_BATCH_SIZE > 1 ) && ( configUSE_QUEUE_BATCHING != 1 ) )
+    #error configUSE_QUEUE_BATCHING must be set to 1 for the timer service task to receive more than one command at a time.
+#endif
+
 #ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
     #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS    0
 #endif
@@ -1003,6 +1369,38 @@
     #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#ifndef configUSE_TRANSITIVE_PRIORITY_INHERITANCE
+    #define configUSE_TRANSITIVE_PRIORITY_INHERITANCE    0
+#endif
+
+#if ( ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use transitive priority inheritance
+#endif
+
+#ifndef configUSE_MUTEX_HANDOFF
+    #define configUSE_MUTEX_HANDOFF    0
+#endif
+
+#if ( ( configUSE_MUTEX_HANDOFF == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use mutex handoff
+#endif
+
+#ifndef configUSE_EVENT_GROUP_BIT_LISTS
+    #define configUSE_EVENT_GROUP_BIT_LISTS    0
+#endif
+
+#ifndef configUSE_WORK_QUEUES
+    #define configUSE_WORK_QUEUES    0
+#endif
+
+#if ( ( configUSE_WORK_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
+    #error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use work queues
+#endif
+
+#if ( ( configUSE_WORK_QUEUES == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to use work queues
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
     #define configINITIAL_TICK_COUNT    0
 #endif
@@ -1301,6 +1699,31 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xDummy23;
+    #endif
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        UBaseType_t uxDummy24;
+    #endif
+    #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy25[ 4 ];
+        UBaseType_t uxDummy26[ 2 ];
+        uint8_t ucDummy27;
+    #endif
+    #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+        void * pvDummy28;
+    #endif
+    #if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 )
+        void * pxDummy29;
+    #endif
+    #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy30;
+        uint8_t ucDummy31;
+    #endif
+    #if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+        void * pvDummy32;
+        UBaseType_t uxDummy33;
+    #endif
 } StaticTask_t;
 
 /*
@@ -1343,6 +1766,11 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_SPSC_QUEUES == 1 )
+        UBaseType_t uxDummy10[ 2 ];
+        uint8_t ucDummy11;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1365,6 +1793,10 @@ typedef struct xSTATIC_EVENT_GROUP
     TickType_t xDummy1;
     StaticList_t xDummy2;
 
+    #if ( configUSE_EVENT_GROUP_BIT_LISTS == 1 )
+        StaticList_t xDummy2b[ ( configUSE_16_BIT_TICKS == 1 ) ? 8 : 24 ];
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy3;
     #endif
@@ -1395,6 +1827,9 @@ typedef struct xSTATIC_TIMER
     TickType_t xDummy3;
     void * pvDummy5;
     TaskFunction_t pvDummy6;
+    #if ( configUSE_TIMER_COALESCING == 1 )
+        TickType_t xDummy9[ 2 ];
+    #endif
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy7;
     #endif
@@ -1431,6 +1866,66 @@ typedef struct xSTATIC_STREAM_BUFFER
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the object pool structure used
+ * internally by FreeRTOS is not accessible to application code.  However, the
+ * application writer must provide the memory that holds an object pool, so
+ * the size of the object pool object needs to be known.  The StaticPool_t
+ * structure below is provided for this purpose.  Its size and alignment
+ * requirements are guaranteed to match those of the genuine structure, no
+ * matter which architecture is being used, and no matter how the values in
+ * FreeRTOSConfig.h are set.  Its contents are somewhat obfuscated in the hope
+ * users will recognise that it would be unwise to make direct use of the
+ * structure members.
+ */
+typedef struct xSTATIC_POOL
+{
+    uint32_t ulDummy1;
+    void * pvDummy2;
+    UBaseType_t uxDummy3[ 3 ];
+    StaticList_t xDummy4;
+    #if ( configUSE_TRACE_FACILITY == 1 )
+        uint32_t ulDummy5[ 4 ];
+        void * pvDummy6[ 2 ];
+    #endif
+} StaticPool_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real reader-writer lock structure is not
+ * accessible to application code.  The StaticRWLock_t structure below has the
+ * same size and alignment requirements as the real structure, so it can be used
+ * to provide the memory for a lock created with xRWLockCreateStatic().
+ */
+typedef struct xSTATIC_RWLOCK
+{
+    UBaseType_t uxDummy1;
+    void * pvDummy2;
+    StaticList_t xDummy3[ 2 ];
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucDummy4;
+    #endif
+} StaticRWLock_t;
+
+/*
+ * As with the other kernel objects, the work item structure is hidden from
+ * application code.  StaticWorkItem_t has the same size and alignment
+ * requirements as the real structure, so it can be used to provide the memory
+ * for a work item created with xWorkItemCreateStatic().
+ */
+typedef struct xSTATIC_WORK_ITEM
+{
+    void * pvDummy1;
+    uint32_t ulDummy2;
+    TaskFunction_t pvDummy3;
+    void * pvDummy4;
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy5;
+    #endif
+} StaticWorkItem_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
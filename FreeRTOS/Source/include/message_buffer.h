@@ -766,6 +766,163 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferNextLengthBytes( xMessageBuffer ) \
     xStreamBufferNextMessageLengthBytes( xMessageBuffer ) PRIVILEGED_FUNCTION;
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReserve( MessageBufferHandle_t xMessageBuffer, void ** ppvData );
+ * @endcode
+ *
+ * Obtains a pointer into a message buffer's storage area at which the next
+ * message can be written in place - for example by a DMA controller - instead
+ * of being copied in by xMessageBufferSend().  Room for the length of the
+ * message is left in front of the returned pointer, and the length is written
+ * when the message is published with xMessageBufferCommit() or
+ * xMessageBufferCommitFromISR().
+ *
+ * A message written in place cannot wrap around the end of the storage area,
+ * so the returned size can be smaller than the largest message
+ * xMessageBufferSend() would accept.  Only the writer moves the write position,
+ * so waiting for the reader to free more space does not help: the returned
+ * size stays the same until a message is written.  If it is too small for the
+ * message then the message must be sent with xMessageBufferSend() - for
+ * example from a bounce buffer the message was written to instead.  That
+ * message wraps around the end of the storage area, after which
+ * xMessageBufferReserve() returns the space at its start.
+ *
+ * xMessageBufferReserve() does not block, and can be called from a task or an
+ * interrupt.  There must only be one writer.
+ *
+ * @param xMessageBuffer The handle of the message buffer to write to.
+ *
+ * @param ppvData Set to where the message should be written, or to NULL if
+ * there is no space.
+ *
+ * @return The largest message that can be written at *ppvData.
+ *
+ * \defgroup xMessageBufferReserve xMessageBufferReserve
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReserve( xMessageBuffer, ppvData ) \
+    xStreamBufferReserve( ( xMessageBuffer ), ( ppvData ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferCommit( MessageBufferHandle_t xMessageBuffer, size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Publishes a message of xDataLengthBytes bytes that was written at the
+ * pointer returned by xMessageBufferReserve().  A task blocked waiting for a
+ * message is unblocked, exactly as if the message had been sent with
+ * xMessageBufferSend().
+ *
+ * @param xMessageBuffer The handle of the message buffer that was written to.
+ *
+ * @param xDataLengthBytes The length of the message.  Must not be more than
+ * the number returned by the preceding call to xMessageBufferReserve().
+ * Committing 0 bytes has no effect.
+ *
+ * @return The length of the message committed.
+ *
+ * \defgroup xMessageBufferCommit xMessageBufferCommit
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCommit( xMessageBuffer, xDataLengthBytes ) \
+    xStreamBufferCommit( ( xMessageBuffer ), ( xDataLengthBytes ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferCommitFromISR( MessageBufferHandle_t xMessageBuffer, size_t xDataLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * An interrupt safe version of xMessageBufferCommit().  See
+ * xStreamBufferCommitFromISR() for a description of
+ * pxHigherPriorityTaskWoken.
+ *
+ * \defgroup xMessageBufferCommitFromISR xMessageBufferCommitFromISR
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCommitFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) \
+    xStreamBufferCommitFromISR( ( xMessageBuffer ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferPeek( MessageBufferHandle_t xMessageBuffer, void ** ppvData );
+ * @endcode
+ *
+ * Obtains a pointer to the next message in a message buffer's storage area so
+ * the message can be parsed in place instead of being copied out by
+ * xMessageBufferReceive().  The message remains in the buffer until it is
+ * removed with xMessageBufferConsume() or xMessageBufferConsumeFromISR().
+ *
+ * A message that was sent with xMessageBufferSend() may wrap around the end of
+ * the storage area.  Such a message cannot be read in place, so its length is
+ * returned with *ppvData set to NULL, and it must be read with
+ * xMessageBufferReceive() instead.
+ *
+ * @param xMessageBuffer The handle of the message buffer to read from.
+ *
+ * @param ppvData Set to the start of the next message, or to NULL if the
+ * message buffer is empty or the message wraps.
+ *
+ * @return The length of the next message, or 0 if the message buffer is
+ * empty.
+ *
+ * \defgroup xMessageBufferPeek xMessageBufferPeek
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferPeek( xMessageBuffer, ppvData ) \
+    xStreamBufferPeekContiguous( ( xMessageBuffer ), ( ppvData ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferConsume( MessageBufferHandle_t xMessageBuffer, size_t xMessageLengthBytes );
+ * @endcode
+ *
+ * Removes the next message from a message buffer without copying it.  A task
+ * blocked waiting for space is unblocked, exactly as if the message had been
+ * read with xMessageBufferReceive().
+ *
+ * @param xMessageBuffer The handle of the message buffer to remove the message
+ * from.
+ *
+ * @param xMessageLengthBytes The length of the message, as returned by
+ * xMessageBufferPeek().  Messages are always removed whole.
+ *
+ * @return The length of the message removed, or 0 if the message buffer was
+ * empty.
+ *
+ * \defgroup xMessageBufferConsume xMessageBufferConsume
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferConsume( xMessageBuffer, xMessageLengthBytes ) \
+    xStreamBufferConsume( ( xMessageBuffer ), ( xMessageLengthBytes ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferConsumeFromISR( MessageBufferHandle_t xMessageBuffer, size_t xMessageLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * An interrupt safe version of xMessageBufferConsume().  See
+ * xStreamBufferConsumeFromISR() for a description of
+ * pxHigherPriorityTaskWoken.
+ *
+ * \defgroup xMessageBufferConsumeFromISR xMessageBufferConsumeFromISR
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferConsumeFromISR( xMessageBuffer, xMessageLengthBytes, pxHigherPriorityTaskWoken ) \
+    xStreamBufferConsumeFromISR( ( xMessageBuffer ), ( xMessageLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
 /**
  * message_buffer.h
  *
@@ -76,6 +76,7 @@ char * MPU_pcTaskGetName( TaskHandle_t xTaskToQuery ) FREERTOS_SYSTEM_CALL;
 TaskHandle_t MPU_xTaskGetHandle( const char * pcNameToQuery ) FREERTOS_SYSTEM_CALL;
 UBaseType_t MPU_uxTaskGetStackHighWaterMark( TaskHandle_t xTask ) FREERTOS_SYSTEM_CALL;
 configSTACK_DEPTH_TYPE MPU_uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) FREERTOS_SYSTEM_CALL;
+configSTACK_DEPTH_TYPE MPU_uxTaskGetStackHighWaterMarkIncremental( TaskHandle_t xTask ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskSetApplicationTaskTag( TaskHandle_t xTask,
                                      TaskHookFunction_t pxHookFunction ) FREERTOS_SYSTEM_CALL;
 TaskHookFunction_t MPU_xTaskGetApplicationTaskTag( TaskHandle_t xTask ) FREERTOS_SYSTEM_CALL;
@@ -92,6 +93,15 @@ UBaseType_t MPU_uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
                                       configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) FREERTOS_SYSTEM_CALL;
 configRUN_TIME_COUNTER_TYPE MPU_ulTaskGetIdleRunTimeCounter( void ) FREERTOS_SYSTEM_CALL;
 configRUN_TIME_COUNTER_TYPE MPU_ulTaskGetIdleRunTimePercent( void ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskGetPerfCounters( const TaskHandle_t * const pxTasks,
+                               TaskPerfCounters_t * const pxPerfCounters,
+                               UBaseType_t uxTaskCount ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskGetCorePerfCounters( BaseType_t xCoreID,
+                                   CorePerfCounters_t * pxPerfCounters ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskGetLatencyHistogram( eLatencyHistogram eHistogram,
+                                   UBaseType_t uxPriority,
+                                   LatencyHistogram_t * pxHistogram ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskResetLatencyHistograms( void ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskList( char * pcWriteBuffer ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskGetRunTimeStats( char * pcWriteBuffer ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify,
@@ -132,6 +142,19 @@ BaseType_t MPU_xQueueReceive( QueueHandle_t xQueue,
 BaseType_t MPU_xQueuePeek( QueueHandle_t xQueue,
                            void * const pvBuffer,
                            TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueSendMultiple( QueueHandle_t xQueue,
+                                   const void * const pvItemsToQueue,
+                                   const UBaseType_t uxItemCount,
+                                   TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                      void * const pvBuffer,
+                                      const UBaseType_t uxMaxItems,
+                                      TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueReceiveAny( QueueHandle_t const * pxQueues,
+                                 const UBaseType_t uxQueueCount,
+                                 void * const pvBuffer,
+                                 UBaseType_t * const puxIndex,
+                                 TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xQueueSemaphoreTake( QueueHandle_t xQueue,
                                     TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
 UBaseType_t MPU_uxQueueMessagesWaiting( const QueueHandle_t xQueue ) FREERTOS_SYSTEM_CALL;
@@ -202,6 +225,9 @@ void MPU_vTimerSetReloadMode( TimerHandle_t xTimer,
 UBaseType_t MPU_uxTimerGetReloadMode( TimerHandle_t xTimer ) FREERTOS_SYSTEM_CALL;
 TickType_t MPU_xTimerGetPeriod( TimerHandle_t xTimer ) FREERTOS_SYSTEM_CALL;
 TickType_t MPU_xTimerGetExpiryTime( TimerHandle_t xTimer ) FREERTOS_SYSTEM_CALL;
+void MPU_vTimerSetSlack( TimerHandle_t xTimer,
+                         const TickType_t xSlackInTicks ) FREERTOS_SYSTEM_CALL;
+TickType_t MPU_xTimerGetSlack( TimerHandle_t xTimer ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTimerCreateTimerTask( void ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTimerGenericCommand( TimerHandle_t xTimer,
                                      const BaseType_t xCommandID,
@@ -259,6 +285,47 @@ StreamBufferHandle_t MPU_xStreamBufferGenericCreateStatic( size_t xBufferSizeByt
                                                            StreamBufferCallbackFunction_t pxSendCompletedCallback,
                                                            StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) FREERTOS_SYSTEM_CALL;
 
+/* MPU versions of pool.h API functions. */
+PoolHandle_t MPU_xPoolCreateStatic( const char * const pcPoolName,
+                                    UBaseType_t uxObjectSize,
+                                    UBaseType_t uxNumberOfObjects,
+                                    uint8_t * const pucPoolStorage,
+                                    StaticPool_t * const pxPoolBuffer ) FREERTOS_SYSTEM_CALL;
+void MPU_vPoolDelete( PoolHandle_t xPool ) FREERTOS_SYSTEM_CALL;
+void * MPU_pvPoolAlloc( PoolHandle_t xPool,
+                        TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+void MPU_vPoolFree( PoolHandle_t xPool,
+                    void * pvObject ) FREERTOS_SYSTEM_CALL;
+void MPU_vPoolGetStatus( PoolHandle_t xPool,
+                         PoolStatus_t * pxPoolStatus ) FREERTOS_SYSTEM_CALL;
+
+/* MPU versions of rwlock.h API functions. */
+RWLockHandle_t MPU_xRWLockCreate( void ) FREERTOS_SYSTEM_CALL;
+RWLockHandle_t MPU_xRWLockCreateStatic( StaticRWLock_t * pxRWLockBuffer ) FREERTOS_SYSTEM_CALL;
+void MPU_vRWLockDelete( RWLockHandle_t xRWLock ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xRWLockTakeRead( RWLockHandle_t xRWLock,
+                                TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xRWLockGiveRead( RWLockHandle_t xRWLock ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xRWLockTakeWrite( RWLockHandle_t xRWLock,
+                                 TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xRWLockGiveWrite( RWLockHandle_t xRWLock ) FREERTOS_SYSTEM_CALL;
+UBaseType_t MPU_uxRWLockGetReaderCount( RWLockHandle_t xRWLock ) FREERTOS_SYSTEM_CALL;
+TaskHandle_t MPU_xRWLockGetWriteHolder( RWLockHandle_t xRWLock ) FREERTOS_SYSTEM_CALL;
+
+/* MPU versions of workqueue.h API functions. */
+WorkQueueHandle_t MPU_xWorkQueueCreate( const char * const pcName,
+                                        UBaseType_t uxPriority,
+                                        configSTACK_DEPTH_TYPE usStackDepth ) FREERTOS_SYSTEM_CALL;
+WorkItemHandle_t MPU_xWorkItemCreateStatic( WorkFunction_t pxFunction,
+                                            void * pvParameter,
+                                            StaticWorkItem_t * pxWorkItemBuffer ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                                 WorkItemHandle_t xWorkItem ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xWorkItemIsPending( WorkItemHandle_t xWorkItem ) FREERTOS_SYSTEM_CALL;
+TaskHandle_t MPU_xWorkQueueGetWorkerTask( WorkQueueHandle_t xWorkQueue ) FREERTOS_SYSTEM_CALL;
+void MPU_vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+                             WorkQueueStats_t * pxStats ) FREERTOS_SYSTEM_CALL;
+
 
 
 #endif /* MPU_PROTOTYPES_H */
@@ -67,6 +67,7 @@
         #define xTaskGetHandle                         MPU_xTaskGetHandle
         #define uxTaskGetStackHighWaterMark            MPU_uxTaskGetStackHighWaterMark
         #define uxTaskGetStackHighWaterMark2           MPU_uxTaskGetStackHighWaterMark2
+        #define uxTaskGetStackHighWaterMarkIncremental MPU_uxTaskGetStackHighWaterMarkIncremental
         #define vTaskSetApplicationTaskTag             MPU_vTaskSetApplicationTaskTag
         #define xTaskGetApplicationTaskTag             MPU_xTaskGetApplicationTaskTag
         #define vTaskSetThreadLocalStoragePointer      MPU_vTaskSetThreadLocalStoragePointer
@@ -78,6 +79,10 @@
         #define vTaskGetRunTimeStats                   MPU_vTaskGetRunTimeStats
         #define ulTaskGetIdleRunTimeCounter            MPU_ulTaskGetIdleRunTimeCounter
         #define ulTaskGetIdleRunTimePercent            MPU_ulTaskGetIdleRunTimePercent
+        #define vTaskGetPerfCounters                   MPU_vTaskGetPerfCounters
+        #define vTaskGetCorePerfCounters               MPU_vTaskGetCorePerfCounters
+        #define vTaskGetLatencyHistogram               MPU_vTaskGetLatencyHistogram
+        #define vTaskResetLatencyHistograms            MPU_vTaskResetLatencyHistograms
         #define xTaskGenericNotify                     MPU_xTaskGenericNotify
         #define xTaskGenericNotifyWait                 MPU_xTaskGenericNotifyWait
         #define ulTaskGenericNotifyTake                MPU_ulTaskGenericNotifyTake
@@ -94,6 +99,9 @@
         #define xQueueGenericSend                      MPU_xQueueGenericSend
         #define xQueueReceive                          MPU_xQueueReceive
         #define xQueuePeek                             MPU_xQueuePeek
+        #define xQueueSendMultiple                     MPU_xQueueSendMultiple
+        #define xQueueReceiveMultiple                  MPU_xQueueReceiveMultiple
+        #define xQueueReceiveAny                       MPU_xQueueReceiveAny
         #define xQueueSemaphoreTake                    MPU_xQueueSemaphoreTake
         #define uxQueueMessagesWaiting                 MPU_uxQueueMessagesWaiting
         #define uxQueueSpacesAvailable                 MPU_uxQueueSpacesAvailable
@@ -129,6 +137,8 @@
         #define uxTimerGetReloadMode                   MPU_uxTimerGetReloadMode
         #define xTimerGetPeriod                        MPU_xTimerGetPeriod
         #define xTimerGetExpiryTime                    MPU_xTimerGetExpiryTime
+        #define vTimerSetSlack                         MPU_vTimerSetSlack
+        #define xTimerGetSlack                         MPU_xTimerGetSlack
         #define xTimerGenericCommand                   MPU_xTimerGenericCommand
 
 /* Map standard event_group.h API functions to the MPU equivalents. */
@@ -155,6 +165,32 @@
         #define xStreamBufferGenericCreate             MPU_xStreamBufferGenericCreate
         #define xStreamBufferGenericCreateStatic       MPU_xStreamBufferGenericCreateStatic
 
+/* Map standard pool.h API functions to the MPU equivalents. */
+        #define xPoolCreateStatic                      MPU_xPoolCreateStatic
+        #define vPoolDelete                            MPU_vPoolDelete
+        #define pvPoolAlloc                            MPU_pvPoolAlloc
+        #define vPoolFree                              MPU_vPoolFree
+        #define vPoolGetStatus                         MPU_vPoolGetStatus
+
+/* Map standard rwlock.h API functions to the MPU equivalents. */
+        #define xRWLockCreate                          MPU_xRWLockCreate
+        #define xRWLockCreateStatic                    MPU_xRWLockCreateStatic
+        #define vRWLockDelete                          MPU_vRWLockDelete
+        #define xRWLockTakeRead                        MPU_xRWLockTakeRead
+        #define xRWLockGiveRead                        MPU_xRWLockGiveRead
+        #define xRWLockTakeWrite                       MPU_xRWLockTakeWrite
+        #define xRWLockGiveWrite                       MPU_xRWLockGiveWrite
+        #define uxRWLockGetReaderCount                 MPU_uxRWLockGetReaderCount
+        #define xRWLockGetWriteHolder                  MPU_xRWLockGetWriteHolder
+
+/* Map standard workqueue.h API functions to the MPU equivalents. */
+        #define xWorkQueueCreate                       MPU_xWorkQueueCreate
+        #define xWorkItemCreateStatic                  MPU_xWorkItemCreateStatic
+        #define xWorkQueueSubmit                       MPU_xWorkQueueSubmit
+        #define xWorkItemIsPending                     MPU_xWorkItemIsPending
+        #define xWorkQueueGetWorkerTask                MPU_xWorkQueueGetWorkerTask
+        #define vWorkQueueGetStats                     MPU_vWorkQueueGetStats
+
 
 /* Remove the privileged function macro, but keep the PRIVILEGED_DATA
  * macro so applications can place data in privileged access sections
@@ -0,0 +1,345 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include pool.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * An object pool holds a fixed number of objects of a fixed size in memory
+ * provided by the application.  Objects are allocated from, and returned to,
+ * a pool without calling pvPortMalloc() or vPortFree(), and without suspending
+ * the scheduler.  The free objects are held in a list that is updated with a
+ * compare-and-swap, so an object can be allocated or freed in the same, short,
+ * time whether or not other tasks or interrupts are using the same pool.  The
+ * compare-and-swap does not enter a critical section if the port defines
+ * portATOMIC_COMPARE_AND_SWAP_U32() in portmacro.h.  Otherwise the version in
+ * atomic.h is used, which masks interrupts for the duration of each swap.
+ * Multi-core ports must define it.  A critical section is also entered when a
+ * task has to block or be unblocked.
+ *
+ * A task that finds the pool empty can optionally enter the Blocked state to
+ * wait for an object to be freed.
+ *
+ * Object pools are only available when configUSE_OBJECT_POOLS is set to 1 in
+ * FreeRTOSConfig.h.
+ */
+
+/**
+ * pool.h
+ *
+ * Type by which object pools are referenced.  For example, a call to
+ * xPoolCreateStatic() returns a PoolHandle_t variable that can then be used as
+ * a parameter to pvPoolAlloc(), vPoolFree(), etc.
+ *
+ * \defgroup PoolHandle_t PoolHandle_t
+ * \ingroup ObjectPools
+ */
+struct PoolDefinition;
+typedef struct PoolDefinition * PoolHandle_t;
+
+/**
+ * pool.h
+ *
+ * Used with vPoolGetStatus() to obtain the state of an object pool.
+ *
+ * \defgroup PoolStatus_t PoolStatus_t
+ * \ingroup ObjectPools
+ */
+typedef struct xPOOL_STATUS
+{
+    const char * pcPoolName;             /* The name given to the pool when it was created. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    UBaseType_t uxObjectSize;            /* The size of each object in the pool, in bytes. */
+    UBaseType_t uxNumberOfObjects;       /* The number of objects the pool holds. */
+    UBaseType_t uxObjectsInUse;          /* The number of objects currently allocated. */
+    UBaseType_t uxMaximumObjectsInUse;   /* The largest number of objects that have been allocated at once. */
+    uint32_t ulAllocations;              /* The number of successful allocations. */
+    uint32_t ulFailedAllocations;        /* The number of allocations that returned NULL. */
+} PoolStatus_t;
+
+/**
+ * pool.h
+ * @code{c}
+ * PoolHandle_t xPoolCreateStatic( const char * const pcPoolName,
+ *                                 UBaseType_t uxObjectSize,
+ *                                 UBaseType_t uxNumberOfObjects,
+ *                                 uint8_t * const pucPoolStorage,
+ *                                 StaticPool_t * const pxPoolBuffer );
+ * @endcode
+ *
+ * Creates a new object pool using memory provided by the application.
+ *
+ * @param pcPoolName A text name for the pool, used by vPoolGetStatus() and
+ * vPoolGetRunTimeStats().
+ *
+ * @param uxObjectSize The size, in bytes, of each object in the pool.  While
+ * an object is free its first four bytes are used by the pool, so uxObjectSize
+ * must be at least 4.
+ *
+ * @param uxNumberOfObjects The number of objects in the pool.  A pool can hold
+ * at most 65534 objects.
+ *
+ * @param pucPoolStorage Must point to a buffer of at least
+ * ( uxObjectSize * uxNumberOfObjects ) bytes, aligned as required by the
+ * objects.  The easiest way to provide it is as an array of the object type.
+ *
+ * @param pxPoolBuffer Must point to a variable of type StaticPool_t, which
+ * will be used to hold the pool's data structure.
+ *
+ * @return If the pool is created then a handle to the created pool is
+ * returned.  If either pucPoolStorage or pxPoolBuffer is NULL then NULL is
+ * returned.
+ *
+ * Example usage:
+ * @code{c}
+ *  typedef struct Message
+ *  {
+ *      uint32_t ulId;
+ *      uint8_t ucData[ 60 ];
+ *  } Message_t;
+ *
+ *  static Message_t xMessages[ 16 ];
+ *  static StaticPool_t xMessagePoolBuffer;
+ *
+ *  void vAFunction( void )
+ *  {
+ *  PoolHandle_t xMessagePool;
+ *  Message_t * pxMessage;
+ *
+ *      xMessagePool = xPoolCreateStatic( "Messages",
+ *                                        sizeof( Message_t ),
+ *                                        16,
+ *                                        ( uint8_t * ) xMessages,
+ *                                        &xMessagePoolBuffer );
+ *
+ *      // Wait up to 10 ticks for a message to be free.
+ *      pxMessage = ( Message_t * ) pvPoolAlloc( xMessagePool, 10 );
+ *
+ *      if( pxMessage != NULL )
+ *      {
+ *          // Use the message, then return it to the pool.
+ *          vPoolFree( xMessagePool, pxMessage );
+ *      }
+ *  }
+ * @endcode
+ * \defgroup xPoolCreateStatic xPoolCreateStatic
+ * \ingroup ObjectPools
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    PoolHandle_t xPoolCreateStatic( const char * const pcPoolName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    UBaseType_t uxObjectSize,
+                                    UBaseType_t uxNumberOfObjects,
+                                    uint8_t * const pucPoolStorage,
+                                    StaticPool_t * const pxPoolBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * pool.h
+ * @code{c}
+ * void vPoolDelete( PoolHandle_t xPool );
+ * @endcode
+ *
+ * Deletes an object pool.  No task may be blocked waiting to allocate from
+ * the pool.  The memory provided to xPoolCreateStatic() can then be reused.
+ *
+ * @param xPool The handle of the pool to delete.
+ *
+ * \defgroup vPoolDelete vPoolDelete
+ * \ingroup ObjectPools
+ */
+void vPoolDelete( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * @code{c}
+ * void * pvPoolAlloc( PoolHandle_t xPool, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Allocates an object from an object pool.  The contents of the object are
+ * not initialised.
+ *
+ * Use pvPoolAlloc() to allocate from a task.  Use pvPoolAllocFromISR() to
+ * allocate from an interrupt service routine.
+ *
+ * @param xPool The handle of the pool from which to allocate.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in
+ * the Blocked state to wait for an object to be freed, should the pool be
+ * empty.  The time is specified in tick periods, so the constant
+ * portTICK_PERIOD_MS can be used to convert it to milliseconds.  Setting
+ * xTicksToWait to portMAX_DELAY causes the task to wait indefinitely (provided
+ * INCLUDE_vTaskSuspend is set to 1 in FreeRTOSConfig.h).  A task does not use
+ * any CPU time while it is in the Blocked state.
+ *
+ * @return A pointer to the allocated object, or NULL if the pool remained
+ * empty for xTicksToWait ticks.
+ *
+ * \defgroup pvPoolAlloc pvPoolAlloc
+ * \ingroup ObjectPools
+ */
+void * pvPoolAlloc( PoolHandle_t xPool,
+                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * @code{c}
+ * void * pvPoolAllocFromISR( PoolHandle_t xPool );
+ * @endcode
+ *
+ * A version of pvPoolAlloc() that can be called from an interrupt service
+ * routine.  It never blocks.
+ *
+ * @param xPool The handle of the pool from which to allocate.
+ *
+ * @return A pointer to the allocated object, or NULL if the pool is empty.
+ *
+ * \defgroup pvPoolAllocFromISR pvPoolAllocFromISR
+ * \ingroup ObjectPools
+ */
+void * pvPoolAllocFromISR( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * @code{c}
+ * void vPoolFree( PoolHandle_t xPool, void * pvObject );
+ * @endcode
+ *
+ * Returns an object to the object pool from which it was allocated.  If a
+ * task is blocked waiting to allocate from the pool then the highest priority
+ * such task is unblocked.
+ *
+ * @param xPool The handle of the pool from which pvObject was allocated.
+ *
+ * @param pvObject The object to free.  An object must not be freed twice.
+ *
+ * \defgroup vPoolFree vPoolFree
+ * \ingroup ObjectPools
+ */
+void vPoolFree( PoolHandle_t xPool,
+                void * pvObject ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * @code{c}
+ * void vPoolFreeFromISR( PoolHandle_t xPool,
+ *                        void * pvObject,
+ *                        BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vPoolFree() that can be called from an interrupt service
+ * routine.
+ *
+ * @param xPool The handle of the pool from which pvObject was allocated.
+ *
+ * @param pvObject The object to free.
+ *
+ * @param pxHigherPriorityTaskWoken vPoolFreeFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if freeing the object unblocked a task
+ * that has a priority higher than the currently running task.  If
+ * vPoolFreeFromISR() sets this value to pdTRUE then a context switch should be
+ * requested before the interrupt is exited.
+ *
+ * \defgroup vPoolFreeFromISR vPoolFreeFromISR
+ * \ingroup ObjectPools
+ */
+void vPoolFreeFromISR( PoolHandle_t xPool,
+                       void * pvObject,
+                       BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * @code{c}
+ * void vPoolGetStatus( PoolHandle_t xPool, PoolStatus_t * pxPoolStatus );
+ * @endcode
+ *
+ * configUSE_TRACE_FACILITY must be defined as 1 for this function to be
+ * available.
+ *
+ * Populates a PoolStatus_t structure with the size, usage and allocation
+ * counts of an object pool.  The counts are maintained with atomic operations,
+ * so the structure may describe a pool that is in use by other tasks at the
+ * same time.
+ *
+ * @param xPool The handle of the pool being queried.
+ *
+ * @param pxPoolStatus A pointer to the PoolStatus_t structure that will be
+ * filled.
+ *
+ * \defgroup vPoolGetStatus vPoolGetStatus
+ * \ingroup ObjectPools
+ */
+#if ( configUSE_TRACE_FACILITY == 1 )
+    void vPoolGetStatus( PoolHandle_t xPool,
+                         PoolStatus_t * pxPoolStatus ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * pool.h
+ * @code{c}
+ * void vPoolGetRunTimeStats( char *pcWriteBuffer );
+ * @endcode
+ *
+ * configUSE_TRACE_FACILITY and configUSE_STATS_FORMATTING_FUNCTIONS must
+ * both be defined as 1 for this function to be available.
+ *
+ * Writes a table of every object pool that exists, in the same format as the
+ * table written by vTaskGetRunTimeStats(): one line per pool, starting with
+ * the name of the pool padded to configMAX_TASK_NAME_LEN characters, followed
+ * by the number of objects in the pool, the number in use, the most that have
+ * been in use at once, the number of allocations and the number of failed
+ * allocations, separated by tabs.
+ *
+ * Like vTaskGetRunTimeStats() this function is provided for convenience only.
+ *
+ * @param pcWriteBuffer A buffer into which the table is written, in ASCII
+ * form.  The buffer is assumed to be large enough to contain the generated
+ * report.  Approximately 60 bytes per pool should be sufficient.
+ *
+ * \defgroup vPoolGetRunTimeStats vPoolGetRunTimeStats
+ * \ingroup ObjectPools
+ */
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+    void vPoolGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* POOL_H */
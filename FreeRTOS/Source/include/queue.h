@@ -76,6 +76,7 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE    ( ( uint8_t ) 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE      ( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX       ( ( uint8_t ) 4U )
+#define queueQUEUE_TYPE_SPSC                  ( ( uint8_t ) 5U )
 
 /**
  * queue. h
@@ -235,6 +236,101 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
     #define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer )    xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_BASE ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateSPSC(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize
+ *                        );
+ * @endcode
+ *
+ * Creates a queue that has exactly one producer and exactly one consumer - a
+ * single task or interrupt sends to the queue and a single task or interrupt
+ * receives from the queue.  configUSE_SPSC_QUEUES must be set to 1 in
+ * FreeRTOSConfig.h for xQueueCreateSPSC() to be available.
+ *
+ * The producer and the consumer each own one index into the queue storage
+ * area, so xQueueSend(), xQueueSendFromISR(), xQueueReceive() and
+ * xQueueReceiveFromISR() copy the item and update their own index without
+ * entering a critical section.  A critical section is only entered when the
+ * other side is blocked on the queue, or when the calling task has to block.
+ *
+ * Items can only be sent to the back of an SPSC queue, an SPSC queue cannot be
+ * peeked or added to a queue set, and uxItemSize must not be zero.  The queue
+ * is otherwise used as a queue created by xQueueCreate().
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ *
+ * @return If the queue is successfully create then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then 0 is
+ * returned.
+ *
+ * Example usage:
+ * @code{c}
+ * QueueHandle_t xSamples;
+ *
+ * void vADCInterruptHandler( void )
+ * {
+ * uint16_t usSample = ADC_DATA_REGISTER;
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  // The interrupt is the only producer.
+ *  xQueueSendFromISR( xSamples, &usSample, &xHigherPriorityTaskWoken );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vProcessingTask( void *pvParameters )
+ * {
+ * uint16_t usSample;
+ *
+ *  for( ;; )
+ *  {
+ *      // The task is the only consumer.
+ *      if( xQueueReceive( xSamples, &usSample, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          // Process usSample.
+ *      }
+ *  }
+ * }
+ *
+ * void vCreateSampleQueue( void )
+ * {
+ *  xSamples = xQueueCreateSPSC( 64, sizeof( uint16_t ) );
+ * }
+ * @endcode
+ * \defgroup xQueueCreateSPSC xQueueCreateSPSC
+ * \ingroup QueueManagement
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_SPSC_QUEUES == 1 ) )
+    #define xQueueCreateSPSC( uxQueueLength, uxItemSize )    xQueueGenericCreate( ( uxQueueLength ), ( uxItemSize ), ( queueQUEUE_TYPE_SPSC ) )
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateSPSCStatic(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            uint8_t *pucQueueStorage,
+ *                            StaticQueue_t *pxQueueBuffer
+ *                        );
+ * @endcode
+ *
+ * Creates a single producer single consumer queue, as described for
+ * xQueueCreateSPSC(), using memory provided by the caller as described for
+ * xQueueCreateStatic().  configUSE_SPSC_QUEUES must be set to 1 in
+ * FreeRTOSConfig.h for xQueueCreateSPSCStatic() to be available.
+ *
+ * \defgroup xQueueCreateSPSCStatic xQueueCreateSPSCStatic
+ * \ingroup QueueManagement
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_SPSC_QUEUES == 1 ) )
+    #define xQueueCreateSPSCStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer )    xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_SPSC ) )
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -885,6 +981,58 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveAny(
+ *                              QueueHandle_t const * pxQueues,
+ *                              const UBaseType_t uxQueueCount,
+ *                              void * const pvBuffer,
+ *                              UBaseType_t * const puxIndex,
+ *                              TickType_t xTicksToWait
+ *                         );
+ * @endcode
+ *
+ * Receive an item from whichever of several queues first holds data.
+ *
+ * If none of the queues holds data the calling task blocks on all of them at
+ * once, and the first queue to be sent to unblocks it.  Unlike a queue set no
+ * extra queue is needed and sending to the queues costs nothing extra when no
+ * task is waiting to receive.  If more than one queue holds data the item is
+ * received from the one that appears first in pxQueues.
+ *
+ * configUSE_QUEUE_RECEIVE_ANY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  At most configQUEUE_RECEIVE_ANY_MAX_QUEUES queues
+ * can be passed, and none of them can be a mutex, an SPSC queue, or a member
+ * of a queue set.  The calling task holds one list item per queue on its stack
+ * while it is blocked.
+ *
+ * @param pxQueues An array of uxQueueCount handles of the queues from which
+ * the item can be received.
+ *
+ * @param uxQueueCount The number of handles in pxQueues.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received item will be
+ * copied.  The buffer must be large enough to hold an item of any of the
+ * queues.
+ *
+ * @param puxIndex If not NULL, set to the index within pxQueues of the queue
+ * from which the item was received.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should all the queues be empty.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xQueueReceiveAny xQueueReceiveAny
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveAny( QueueHandle_t const * pxQueues,
+                             const UBaseType_t uxQueueCount,
+                             void * const pvBuffer,
+                             UBaseType_t * const puxIndex,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * @code{c}
@@ -1418,6 +1566,187 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                                  void * const pvBuffer,
                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendMultiple(
+ *                                QueueHandle_t xQueue,
+ *                                const void * const pvItemsToQueue,
+ *                                const UBaseType_t uxItemCount,
+ *                                TickType_t xTicksToWait
+ *                           );
+ * @endcode
+ *
+ * Post an array of items to the back of a queue.  The items are copied in
+ * as few critical sections as possible - one if there is space for them all -
+ * and one waiting task is woken for each item posted, rather than paying the
+ * cost of xQueueSend() per item.
+ *
+ * If there is not space for all the items then as many as fit are posted, and
+ * the calling task blocks for up to xTicksToWait ticks for space to post the
+ * rest.
+ *
+ * configUSE_QUEUE_BATCHING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It cannot be used with a queue that is a member
+ * of a queue set, an SPSC queue, or a semaphore.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to uxItemCount items, stored one after
+ * another, each the size defined when the queue was created.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space on the queue.
+ *
+ * @return The number of items posted, which is less than uxItemCount if the
+ * block time expired before there was space for all of them.
+ *
+ * Example usage:
+ * @code{c}
+ * struct ALogRecord
+ * {
+ *  uint32_t ulTimestamp;
+ *  uint32_t ulEvent;
+ * } xRecords[ 16 ];
+ *
+ * void vAFunction( QueueHandle_t xLogQueue )
+ * {
+ * BaseType_t xSent;
+ *
+ *  // ... fill xRecords ...
+ *
+ *  xSent = xQueueSendMultiple( xLogQueue, xRecords, 16, pdMS_TO_TICKS( 10 ) );
+ *
+ *  if( xSent < 16 )
+ *  {
+ *      // The queue stayed full for 10ms, so the remaining records were
+ *      // dropped.
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                               const void * const pvItemsToQueue,
+                               const UBaseType_t uxItemCount,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendMultipleFromISR(
+ *                                       QueueHandle_t xQueue,
+ *                                       const void * const pvItemsToQueue,
+ *                                       const UBaseType_t uxItemCount,
+ *                                       BaseType_t *pxHigherPriorityTaskWoken
+ *                                  );
+ * @endcode
+ *
+ * A version of xQueueSendMultiple() that can be used in an interrupt service
+ * routine.  As many of the items as there is space for are posted in a single
+ * critical section.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to uxItemCount items, stored one after
+ * another.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueSendMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if posting the items unblocked a task
+ * with a priority higher than the currently running task.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                      const void * const pvItemsToQueue,
+                                      const UBaseType_t uxItemCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveMultiple(
+ *                                   QueueHandle_t xQueue,
+ *                                   void * const pvBuffer,
+ *                                   const UBaseType_t uxMaxItems,
+ *                                   TickType_t xTicksToWait
+ *                              );
+ * @endcode
+ *
+ * Receive up to uxMaxItems items from a queue in a single critical section,
+ * waking one task that is waiting for space for each item received.
+ *
+ * The calling task only blocks, for up to xTicksToWait ticks, if the queue is
+ * empty.  Otherwise the items that are available are returned straight away.
+ *
+ * configUSE_QUEUE_BATCHING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It cannot be used with a queue that is a member
+ * of a queue set, an SPSC queue, or a semaphore.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty.
+ *
+ * @return The number of items received, or 0 if the queue remained empty for
+ * the block time.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                  void * const pvBuffer,
+                                  const UBaseType_t uxMaxItems,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveMultipleFromISR(
+ *                                          QueueHandle_t xQueue,
+ *                                          void * const pvBuffer,
+ *                                          const UBaseType_t uxMaxItems,
+ *                                          BaseType_t *pxHigherPriorityTaskWoken
+ *                                     );
+ * @endcode
+ *
+ * A version of xQueueReceiveMultiple() that can be used in an interrupt
+ * service routine.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueReceiveMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if receiving the items unblocked a task
+ * with a priority higher than the currently running task.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                         void * const pvBuffer,
+                                         const UBaseType_t uxMaxItems,
+                                         BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from within an ISR, or within a critical section.
@@ -0,0 +1,295 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include rwlock.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * A reader-writer lock can be held either by any number of readers at once,
+ * or by a single writer.  It suits data that is read far more often than it
+ * is written, where a mutex would make readers wait for each other.
+ *
+ * Writers are preferred.  Once a task is waiting to write, tasks that try to
+ * take the lock for reading block until the writer has taken and given the
+ * lock, even if other readers hold it.  So a task must never take a lock for
+ * reading that it already holds for reading, as a writer waiting between the
+ * two takes would deadlock it.
+ *
+ * A task that blocks on a lock held by a writer causes the writer to inherit
+ * its priority, as with a mutex.  Readers are not recorded, so a writer that
+ * blocks on a lock held by readers does not raise their priority.  When the
+ * write lock is given while other writers are waiting, it is passed straight
+ * to the highest priority of them, so a reader or writer that runs first
+ * cannot take it in between.
+ *
+ * Reader-writer locks must not be used from interrupts.  They are only
+ * available when configUSE_RW_LOCKS is set to 1 in FreeRTOSConfig.h.
+ */
+
+/**
+ * rwlock.h
+ *
+ * Type by which reader-writer locks are referenced.  For example, a call to
+ * xRWLockCreate() returns a RWLockHandle_t variable that can then be used as
+ * a parameter to xRWLockTakeRead(), xRWLockGiveRead(), etc.
+ *
+ * \defgroup RWLockHandle_t RWLockHandle_t
+ * \ingroup RWLocks
+ */
+struct RWLockDefinition;
+typedef struct RWLockDefinition * RWLockHandle_t;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * RWLockHandle_t xRWLockCreate( void );
+ * @endcode
+ *
+ * Creates a new reader-writer lock, using memory obtained from the FreeRTOS
+ * heap.  The lock is created free.
+ *
+ * @return If the lock is created then a handle to the created lock is
+ * returned.  If there was not enough heap memory then NULL is returned.
+ *
+ * \defgroup xRWLockCreate xRWLockCreate
+ * \ingroup RWLocks
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    RWLockHandle_t xRWLockCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rwlock.h
+ * @code{c}
+ * RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t * pxRWLockBuffer );
+ * @endcode
+ *
+ * Creates a new reader-writer lock using memory provided by the application.
+ * The lock is created free.
+ *
+ * @param pxRWLockBuffer Must point to a variable of type StaticRWLock_t,
+ * which will be used to hold the lock's data structure.
+ *
+ * @return If pxRWLockBuffer is not NULL then a handle to the created lock is
+ * returned.  Otherwise NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ *  static StaticRWLock_t xConfigLockBuffer;
+ *  static Config_t xConfig;
+ *  RWLockHandle_t xConfigLock;
+ *
+ *  void vSetup( void )
+ *  {
+ *      xConfigLock = xRWLockCreateStatic( &xConfigLockBuffer );
+ *  }
+ *
+ *  uint32_t ulReadRate( void )
+ *  {
+ *  uint32_t ulRate = 0;
+ *
+ *      // Any number of tasks can read the configuration at once.
+ *      if( xRWLockTakeRead( xConfigLock, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          ulRate = xConfig.ulRate;
+ *          xRWLockGiveRead( xConfigLock );
+ *      }
+ *
+ *      return ulRate;
+ *  }
+ *
+ *  void vWriteRate( uint32_t ulRate )
+ *  {
+ *      // Only one task can change it, and only while no task is reading it.
+ *      if( xRWLockTakeWrite( xConfigLock, pdMS_TO_TICKS( 10 ) ) == pdPASS )
+ *      {
+ *          xConfig.ulRate = ulRate;
+ *          xRWLockGiveWrite( xConfigLock );
+ *      }
+ *  }
+ * @endcode
+ * \defgroup xRWLockCreateStatic xRWLockCreateStatic
+ * \ingroup RWLocks
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t * pxRWLockBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rwlock.h
+ * @code{c}
+ * void vRWLockDelete( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Deletes a reader-writer lock.  The lock must be free, and no task may be
+ * waiting for it.
+ *
+ * @param xRWLock The handle of the lock to delete.
+ *
+ * \defgroup vRWLockDelete vRWLockDelete
+ * \ingroup RWLocks
+ */
+void vRWLockDelete( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a reader-writer lock for reading.  The lock can be taken for reading
+ * while no task holds it for writing and no task is waiting to write.
+ *
+ * @param xRWLock The handle of the lock to take.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in
+ * the Blocked state to wait for the lock, should it not be available
+ * immediately.  Setting xTicksToWait to portMAX_DELAY causes the task to wait
+ * indefinitely (provided INCLUDE_vTaskSuspend is set to 1 in
+ * FreeRTOSConfig.h).
+ *
+ * @return pdPASS if the lock was taken, otherwise pdFAIL.
+ *
+ * \defgroup xRWLockTakeRead xRWLockTakeRead
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Gives a reader-writer lock that was taken for reading.  If it was the last
+ * reader and a task is waiting to write then the lock is passed to that task.
+ *
+ * @param xRWLock The handle of the lock to give.
+ *
+ * @return pdPASS if the lock was given.  pdFAIL if the lock was not held for
+ * reading.
+ *
+ * \defgroup xRWLockGiveRead xRWLockGiveRead
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a reader-writer lock for writing.  The lock can be taken for writing
+ * while no task holds it.  The calling task must not already hold the lock.
+ *
+ * @param xRWLock The handle of the lock to take.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in
+ * the Blocked state to wait for the lock, as for xRWLockTakeRead().
+ *
+ * @return pdPASS if the lock was taken, otherwise pdFAIL.
+ *
+ * \defgroup xRWLockTakeWrite xRWLockTakeWrite
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Gives a reader-writer lock that was taken for writing.  If tasks are waiting
+ * to write then the lock is passed to the highest priority of them.  Otherwise
+ * all the tasks waiting to read are unblocked.
+ *
+ * @param xRWLock The handle of the lock to give.
+ *
+ * @return pdPASS if the lock was given.  pdFAIL if the calling task did not
+ * hold the lock for writing.
+ *
+ * \defgroup xRWLockGiveWrite xRWLockGiveWrite
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * @param xRWLock The handle of the lock being queried.
+ *
+ * @return The number of tasks that hold the lock for reading.
+ *
+ * \defgroup uxRWLockGetReaderCount uxRWLockGetReaderCount
+ * \ingroup RWLocks
+ */
+UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * TaskHandle_t xRWLockGetWriteHolder( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * @param xRWLock The handle of the lock being queried.
+ *
+ * @return The handle of the task that holds the lock for writing, or NULL if
+ * no task holds it for writing.
+ *
+ * \defgroup xRWLockGetWriteHolder xRWLockGetWriteHolder
+ * \ingroup RWLocks
+ */
+TaskHandle_t xRWLockGetWriteHolder( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* RWLOCK_H */
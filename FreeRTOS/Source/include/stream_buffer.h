@@ -633,6 +633,225 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
                                     size_t xBufferLengthBytes,
                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer, void ** ppvData );
+ * @endcode
+ *
+ * Obtains a pointer to free space inside a stream buffer's storage area so the
+ * data can be written in place - for example by a DMA controller - instead of
+ * being copied in by xStreamBufferSend().  Nothing is sent until the data is
+ * published with xStreamBufferCommit() or xStreamBufferCommitFromISR().
+ *
+ * Only the free space up to the end of the storage area is returned, so less
+ * space may be returned than xStreamBufferSpacesAvailable() reports.  Once the
+ * returned space has been committed the next call returns the space at the
+ * start of the storage area.
+ *
+ * xStreamBufferReserve() does not block, and can be called from a task or an
+ * interrupt.  As with xStreamBufferSend(), there must only be one writer.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param ppvData Set to the start of the free space, or to NULL if the
+ * stream buffer is full.
+ *
+ * @return The number of bytes that can be written at *ppvData.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( StreamBufferHandle_t xStreamBuffer )
+ * {
+ * void *pvSpace;
+ * size_t xSpace, xWritten;
+ *
+ *  xSpace = xStreamBufferReserve( xStreamBuffer, &pvSpace );
+ *
+ *  if( xSpace > 0 )
+ *  {
+ *      // Write up to xSpace bytes to pvSpace, then make them available to
+ *      // the reader.
+ *      xWritten = prvFillFromDevice( pvSpace, xSpace );
+ *      xStreamBufferCommit( xStreamBuffer, xWritten );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferReserve xStreamBufferReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+                             void ** ppvData ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Makes xDataLengthBytes bytes that were written at the pointer returned by
+ * xStreamBufferReserve() available to the reader.  If that takes the number
+ * of bytes in the buffer to the trigger level then a task blocked waiting for
+ * data is unblocked, exactly as if the bytes had been sent with
+ * xStreamBufferSend().
+ *
+ * Use xStreamBufferCommitFromISR() to commit from an interrupt service
+ * routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was written to.
+ *
+ * @param xDataLengthBytes The number of bytes written.  Must not be more than
+ * the number returned by the preceding call to xStreamBufferReserve().
+ * Committing 0 bytes has no effect.
+ *
+ * @return The number of bytes committed.
+ *
+ * \defgroup xStreamBufferCommit xStreamBufferCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+                            size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * An interrupt safe version of xStreamBufferCommit().
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was written to.
+ *
+ * @param xDataLengthBytes The number of bytes written.  Must not be more than
+ * the number returned by the preceding call to xStreamBufferReserve().
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if committing the data
+ * unblocked a task that has a priority above the currently executing task, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.  *pxHigherPriorityTaskWoken should be set to pdFALSE before it is
+ * passed into the function.
+ *
+ * @return The number of bytes committed.
+ *
+ * \defgroup xStreamBufferCommitFromISR xStreamBufferCommitFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                   size_t xDataLengthBytes,
+                                   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer, void ** ppvData );
+ * @endcode
+ *
+ * Obtains a pointer to the oldest data in a stream buffer's storage area so
+ * the data can be read in place instead of being copied out by
+ * xStreamBufferReceive().  The data remains in the buffer until it is removed
+ * with xStreamBufferConsume() or xStreamBufferConsumeFromISR().
+ *
+ * Only the data up to the end of the storage area is returned, so fewer bytes
+ * may be returned than xStreamBufferBytesAvailable() reports.  Once they have
+ * been consumed the next call returns the data at the start of the storage
+ * area.
+ *
+ * xStreamBufferPeekContiguous() does not block, and can be called from a task
+ * or an interrupt.  As with xStreamBufferReceive(), there must only be one
+ * reader.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param ppvData Set to the start of the data, or to NULL if the stream
+ * buffer is empty.
+ *
+ * @return The number of bytes that can be read at *ppvData.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( StreamBufferHandle_t xStreamBuffer )
+ * {
+ * void *pvData;
+ * size_t xBytes;
+ *
+ *  xBytes = xStreamBufferPeekContiguous( xStreamBuffer, &pvData );
+ *
+ *  if( xBytes > 0 )
+ *  {
+ *      // Parse the data where it is, then free the space it occupies.
+ *      prvParse( pvData, xBytes );
+ *      xStreamBufferConsume( xStreamBuffer, xBytes );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferPeekContiguous xStreamBufferPeekContiguous
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+                                    void ** ppvData ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytesToConsume );
+ * @endcode
+ *
+ * Removes bytes from the front of a stream buffer without copying them, so
+ * the space they occupied can be reused.  If a task was blocked waiting for
+ * space it is unblocked, exactly as if the bytes had been read with
+ * xStreamBufferReceive().
+ *
+ * Use xStreamBufferConsumeFromISR() to consume from an interrupt service
+ * routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to remove bytes from.
+ *
+ * @param xBytesToConsume The number of bytes to remove.  Normally this is the
+ * number returned by xStreamBufferPeekContiguous(), but bytes can be consumed
+ * across the end of the storage area.
+ *
+ * @return The number of bytes removed, which is less than xBytesToConsume if
+ * fewer bytes were available.
+ *
+ * \defgroup xStreamBufferConsume xStreamBufferConsume
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                             size_t xBytesToConsume ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer, size_t xBytesToConsume, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * An interrupt safe version of xStreamBufferConsume().
+ *
+ * @param xStreamBuffer The handle of the stream buffer to remove bytes from.
+ *
+ * @param xBytesToConsume The number of bytes to remove.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if consuming the data
+ * unblocked a task that has a priority above the currently executing task, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.  *pxHigherPriorityTaskWoken should be set to pdFALSE before it is
+ * passed into the function.
+ *
+ * @return The number of bytes removed.
+ *
+ * \defgroup xStreamBufferConsumeFromISR xStreamBufferConsumeFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xBytesToConsume,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -168,6 +168,43 @@ typedef struct xTASK_STATUS
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with vTaskGetPerfCounters() to return a snapshot of the time a task has
+ * spent in each scheduling state.  All times are in units of the run time stats
+ * clock. */
+typedef struct xTASK_PERF_COUNTERS
+{
+    configRUN_TIME_COUNTER_TYPE ulRunTime;     /* The time the task has spent in the Running state. */
+    configRUN_TIME_COUNTER_TYPE ulReadyTime;   /* The time the task has spent in the Ready state waiting for a core. */
+    configRUN_TIME_COUNTER_TYPE ulBlockedTime; /* The time the task has spent in the Blocked or Suspended state. */
+    configRUN_TIME_COUNTER_TYPE ulTimestamp;   /* The run time counter value at which the snapshot was taken. */
+    UBaseType_t uxSwitchesIn;                  /* The number of times the task has been switched in. */
+} TaskPerfCounters_t;
+
+/* Used with vTaskGetCorePerfCounters() to return a snapshot of the scheduling
+ * activity on one core. */
+typedef struct xCORE_PERF_COUNTERS
+{
+    configRUN_TIME_COUNTER_TYPE ulIdleTime;  /* The time the core has spent running an idle task. */
+    configRUN_TIME_COUNTER_TYPE ulTimestamp; /* The run time counter value at which the snapshot was taken. */
+    UBaseType_t uxContextSwitches;           /* The number of times the core has switched to a different task. */
+} CorePerfCounters_t;
+
+/* Selects the histogram returned by vTaskGetLatencyHistogram(). */
+typedef enum
+{
+    eReadyLatency = 0, /* The time from a task being added to a ready list to it being switched in. */
+    eCriticalLatency   /* The time interrupts are masked by the outermost taskENTER_CRITICAL(). */
+} eLatencyHistogram;
+
+/* Used with vTaskGetLatencyHistogram() to return a snapshot of the latencies
+ * recorded at one priority.  All times are in units of the run time stats
+ * clock. */
+typedef struct xLATENCY_HISTOGRAM
+{
+    uint32_t ulBuckets[ configLATENCY_HISTOGRAM_BUCKETS ]; /* ulBuckets[ 0 ] counts latencies of 0, ulBuckets[ n ] latencies from 2^(n-1) to (2^n)-1, and the last bucket every longer latency. */
+    configRUN_TIME_COUNTER_TYPE ulMaximum;                 /* The longest latency recorded. */
+} LatencyHistogram_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -185,6 +222,14 @@ typedef enum
  */
 #define tskIDLE_PRIORITY    ( ( UBaseType_t ) 0U )
 
+/**
+ * Defines the affinity mask that allows a task to run on any core.  Tasks are
+ * created with this affinity when configUSE_CORE_AFFINITY is set to 1.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskNO_AFFINITY      ( ( UBaseType_t ) -1 )
+
 /**
  * task. h
  *
@@ -208,7 +253,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskENTER_CRITICAL()               portENTER_CRITICAL()
-#define taskENTER_CRITICAL_FROM_ISR()      portSET_INTERRUPT_MASK_FROM_ISR()
+#if ( configNUMBER_OF_CORES == 1 )
+    #define taskENTER_CRITICAL_FROM_ISR()    portSET_INTERRUPT_MASK_FROM_ISR()
+#else
+    #define taskENTER_CRITICAL_FROM_ISR()    uxTaskEnterCriticalFromISR()
+#endif
 
 /**
  * task. h
@@ -223,7 +272,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskEXIT_CRITICAL()                portEXIT_CRITICAL()
-#define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#if ( configNUMBER_OF_CORES == 1 )
+    #define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#else
+    #define taskEXIT_CRITICAL_FROM_ISR( x )    vTaskExitCriticalFromISR( x )
+#endif
 
 /**
  * task. h
@@ -1088,6 +1141,57 @@ void vTaskGetInfo( TaskHandle_t xTask,
 void vTaskPrioritySet( TaskHandle_t xTask,
                        UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask );
+ * @endcode
+ *
+ * Sets the core affinity mask for a task.
+ *
+ * configUSE_CORE_AFFINITY must be defined as 1 and configNUMBER_OF_CORES must
+ * be greater than 1 for this function to be available.
+ *
+ * @param xTask The handle of the task to set the core affinity mask for.
+ * Passing NULL will set the core affinity mask for the calling task.
+ *
+ * @param uxCoreAffinityMask A bitwise value that indicates the cores on which
+ * the task can run.  Bit 0 set allows the task to run on core 0, bit 1 set
+ * allows it to run on core 1, and so on.  tskNO_AFFINITY allows the task to run
+ * on any core.  If the task is running on a core that is no longer allowed it
+ * is made to yield.
+ *
+ * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+ * \ingroup Tasks
+ */
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                               UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * Gets the core affinity mask for a task.
+ *
+ * configUSE_CORE_AFFINITY must be defined as 1 and configNUMBER_OF_CORES must
+ * be greater than 1 for this function to be available.
+ *
+ * @param xTask The handle of the task to get the core affinity mask for.
+ * Passing NULL will get the core affinity mask for the calling task.
+ *
+ * @return The core affinity mask of the task.
+ *
+ * \defgroup uxTaskCoreAffinityGet uxTaskCoreAffinityGet
+ * \ingroup Tasks
+ */
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+    UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1567,6 +1671,44 @@ UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask ) PRIVILEGED_FUNCTIO
  */
 configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * @code{c}
+ * configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMarkIncremental( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_STACK_HIGH_WATER_TRACKING must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Returns the same value as uxTaskGetStackHighWaterMark2(), but without
+ * scanning the whole of the unused stack.  The kernel keeps the deepest point
+ * each task's stack is known to have reached.  On ports that save the stack
+ * pointer in the TCB (portSTACK_POINTER_SAVED_IN_TCB) it is updated each time
+ * the task is switched out.  Each call to this function then checks the stack
+ * beyond that point for words that no longer hold the fill value, stopping
+ * once it finds configSTACK_HIGH_WATER_SCAN_GAP unused words in a row.  The
+ * cost of a call is therefore set by how much new stack the task has used
+ * since the last call rather than by the size of the stack, so it can be
+ * called periodically for every task in the system.
+ *
+ * Stack that a task reserves but does not write, such as an uninitialised
+ * array, is only seen if it is shorter than configSTACK_HIGH_WATER_SCAN_GAP
+ * words or the task is switched out while using the stack beyond it.  The
+ * returned value can therefore be larger than that of
+ * uxTaskGetStackHighWaterMark2().
+ *
+ * If configSTACK_PRESSURE_THRESHOLD is greater than zero then
+ * vApplicationStackPressureHook() is called each time the high water mark of a
+ * task moves and leaves configSTACK_PRESSURE_THRESHOLD words or fewer unused.
+ *
+ * @param xTask Handle of the task associated with the stack to be checked.
+ * Set xTask to NULL to check the stack of the calling task.
+ *
+ * @return The smallest amount of free stack space there is known to have been
+ * (in words) since the task referenced by xTask was created.
+ */
+configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMarkIncremental( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 /* When using trace macros it is sometimes necessary to include task.h before
  * FreeRTOS.h.  When this is done TaskHookFunction_t will not yet have been defined,
  * so the following two prototypes will cause a compilation error.  This can be
@@ -1649,6 +1791,29 @@ configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVIL
 
 #endif
 
+#if ( configSTACK_PRESSURE_THRESHOLD > 0 )
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationStackPressureHook( TaskHandle_t xTask, configSTACK_DEPTH_TYPE uxFreeStack );
+ * @endcode
+ *
+ * The application stack pressure hook is called when the stack high water mark
+ * of a task moves and leaves configSTACK_PRESSURE_THRESHOLD words or fewer
+ * unused.  It is called from vTaskSwitchContext() or from
+ * uxTaskGetStackHighWaterMarkIncremental(), whichever moved the mark, so must
+ * not call API functions that can block.
+ *
+ * @param xTask The task whose stack is running short.
+ * @param uxFreeStack The number of words of the task's stack that have not been
+ * used.
+ */
+    void vApplicationStackPressureHook( TaskHandle_t xTask,
+                                        configSTACK_DEPTH_TYPE uxFreeStack );
+
+#endif
+
 #if  ( configUSE_TICK_HOOK > 0 )
 
 /**
@@ -1681,7 +1846,31 @@ configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVIL
     void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
                                         StackType_t ** ppxIdleTaskStackBuffer,
                                         uint32_t * pulIdleTaskStackSize ); /*lint !e526 Symbol not defined as it is an application callback. */
-#endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer, StackType_t ** ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex )
+ * @endcode
+ *
+ * As vApplicationGetIdleTaskMemory(), but for the idle tasks of cores 1 to
+ * ( configNUMBER_OF_CORES - 1 ).  Required when configSUPPORT_STATIC_ALLOCATION
+ * is set and configNUMBER_OF_CORES is greater than 1.
+ *
+ * @param ppxIdleTaskTCBBuffer A handle to a statically allocated TCB buffer
+ * @param ppxIdleTaskStackBuffer A handle to a statically allocated Stack buffer for the idle task
+ * @param pulIdleTaskStackSize A pointer to the number of elements that will fit in the allocated stack buffer
+ * @param xPassiveIdleTaskIndex The index of the idle task being created, from 0
+ * to ( configNUMBER_OF_CORES - 2 ).  Each index needs its own buffers.
+ */
+        void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                                   StackType_t ** ppxIdleTaskStackBuffer,
+                                                   uint32_t * pulIdleTaskStackSize,
+                                                   BaseType_t xPassiveIdleTaskIndex ); /*lint !e526 Symbol not defined as it is an application callback. */
+    #endif /* configNUMBER_OF_CORES */
+#endif /* configSUPPORT_STATIC_ALLOCATION */
 
 /**
  * task.h
@@ -1708,6 +1897,19 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * xTaskGetIdleTaskHandleForCore() is only available if
+ * INCLUDE_xTaskGetIdleTaskHandle is set to 1 and configNUMBER_OF_CORES is
+ * greater than 1 in FreeRTOSConfig.h.
+ *
+ * Returns the handle of the idle task created for core xCoreID.  On a
+ * multi-core build xTaskGetIdleTaskHandle() returns the idle task created for
+ * core 0.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+    TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
  * uxTaskGetSystemState() to be available.
@@ -1957,6 +2159,132 @@ void vTaskGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetPerfCounters( const TaskHandle_t * const pxTasks, TaskPerfCounters_t * const pxPerfCounters, UBaseType_t uxTaskCount );
+ * void vTaskGetCorePerfCounters( BaseType_t xCoreID, CorePerfCounters_t * pxPerfCounters );
+ * @endcode
+ *
+ * configUSE_TASK_PERF_COUNTERS and configGENERATE_RUN_TIME_STATS must both be
+ * defined as 1 for these functions to be available.
+ *
+ * With configUSE_TASK_PERF_COUNTERS set to 1 the kernel keeps a small set of
+ * counters in each TCB, updated as the task moves between the Running, Ready
+ * and Blocked states, plus a context switch count and idle time for each core.
+ * vTaskGetPerfCounters() and vTaskGetCorePerfCounters() copy those counters
+ * out without suspending the scheduler or walking the task lists, so unlike
+ * uxTaskGetSystemState() and vTaskGetRunTimeStats() they can be called at a
+ * high rate to export metrics.  The application keeps the previous snapshot
+ * and subtracts it to obtain deltas - the ulTimestamp member gives the run
+ * time counter value each snapshot was taken at.
+ *
+ * vTaskGetPerfCounters() reads the run time counter once per call, so the
+ * snapshots of all the tasks passed to one call share the same ulTimestamp.
+ * The time each task has spent in its current state up to that timestamp is
+ * included, so successive snapshots never go backwards.  As with
+ * ulRunTimeCounter, no overflow protection is provided.
+ *
+ * @param pxTasks An array of uxTaskCount handles of the tasks to query.  A NULL
+ * entry queries the calling task.  The handles must refer to tasks that have not
+ * been deleted.
+ *
+ * @param pxPerfCounters An array of uxTaskCount structures into which the
+ * snapshot of each task in pxTasks is written.
+ *
+ * @param uxTaskCount The number of tasks to query.
+ *
+ * @param xCoreID The core to query.  Must be 0 on a single core build.
+ *
+ * Example usage:
+ * @code{c}
+ * // Export the run time of two tasks since the last call.
+ * void vExportMetrics( TaskHandle_t xTask1, TaskHandle_t xTask2 )
+ * {
+ * static TaskPerfCounters_t xLast[ 2 ];
+ * TaskPerfCounters_t xNow[ 2 ];
+ * const TaskHandle_t xTasks[ 2 ] = { xTask1, xTask2 };
+ *
+ *     vTaskGetPerfCounters( xTasks, xNow, 2 );
+ *     vSendMetric( 1, xNow[ 0 ].ulRunTime - xLast[ 0 ].ulRunTime );
+ *     vSendMetric( 2, xNow[ 1 ].ulRunTime - xLast[ 1 ].ulRunTime );
+ *     memcpy( xLast, xNow, sizeof( xNow ) );
+ * }
+ * @endcode
+ * \defgroup vTaskGetPerfCounters vTaskGetPerfCounters
+ * \ingroup TaskUtils
+ */
+void vTaskGetPerfCounters( const TaskHandle_t * const pxTasks,
+                           TaskPerfCounters_t * const pxPerfCounters,
+                           UBaseType_t uxTaskCount ) PRIVILEGED_FUNCTION;
+void vTaskGetCorePerfCounters( BaseType_t xCoreID,
+                               CorePerfCounters_t * pxPerfCounters ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetLatencyHistogram( eLatencyHistogram eHistogram, UBaseType_t uxPriority, LatencyHistogram_t * pxHistogram );
+ * void vTaskResetLatencyHistograms( void );
+ * @endcode
+ *
+ * configUSE_LATENCY_HISTOGRAMS and configGENERATE_RUN_TIME_STATS must both be
+ * defined as 1 for these functions to be available.
+ *
+ * With configUSE_LATENCY_HISTOGRAMS set to 1 the kernel keeps two histograms
+ * for each priority, each of configLATENCY_HISTOGRAM_BUCKETS buckets:
+ *
+ * eReadyLatency records, for a task of that priority, the time from the task
+ * being moved to the Ready state to it next being selected to run.  A task that
+ * is preempted while running stays in the Ready state, so the time it then
+ * waits to run again is not recorded.
+ *
+ * eCriticalLatency records the time from the outermost taskENTER_CRITICAL()
+ * to the matching taskEXIT_CRITICAL(), charged to the priority of the task that
+ * entered the critical section.  It is recorded by the port, so is only
+ * available on ports that call vTaskRecordCriticalEntry() and
+ * vTaskRecordCriticalExit(), and on multi-core builds.
+ *
+ * Bucket 0 counts latencies of 0, bucket n counts latencies from 2^(n-1) to
+ * (2^n)-1, and the last bucket counts every longer latency.
+ *
+ * vTaskGetLatencyHistogram() copies one histogram out without suspending the
+ * scheduler or entering a critical section, so it can be called while the
+ * system runs.  vTaskResetLatencyHistograms() clears every histogram.
+ *
+ * @param eHistogram The histogram to copy.
+ *
+ * @param uxPriority The priority to copy the histogram of.  Must be less than
+ * configMAX_PRIORITIES.
+ *
+ * @param pxHistogram The structure into which the histogram is written.
+ *
+ * Example usage:
+ * @code{c}
+ * // Report how often a priority 3 task waited longer than 2^10 counts to run.
+ * uint32_t ulSlowWakes( void )
+ * {
+ * LatencyHistogram_t xHistogram;
+ * uint32_t ulSlow = 0;
+ * UBaseType_t x;
+ *
+ *     vTaskGetLatencyHistogram( eReadyLatency, 3, &xHistogram );
+ *
+ *     for( x = 11; x < configLATENCY_HISTOGRAM_BUCKETS; x++ )
+ *     {
+ *         ulSlow += xHistogram.ulBuckets[ x ];
+ *     }
+ *
+ *     return ulSlow;
+ * }
+ * @endcode
+ * \defgroup vTaskGetLatencyHistogram vTaskGetLatencyHistogram
+ * \ingroup TaskUtils
+ */
+void vTaskGetLatencyHistogram( eLatencyHistogram eHistogram,
+                               UBaseType_t uxPriority,
+                               LatencyHistogram_t * pxHistogram ) PRIVILEGED_FUNCTION;
+void vTaskResetLatencyHistograms( void ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -2975,6 +3303,28 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
                                       TickType_t xTicksToWait,
                                       const BaseType_t xWaitIndefinitely ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.
+ *
+ * Places the calling task on every one of uxEventLists event lists, in task
+ * priority order, using one item from pxEventListItems per list in place of
+ * the event list item of the task.  The items must remain valid until the
+ * task runs again.  xTaskRemoveFromEventList() on any of the lists unblocks
+ * the task and removes it from the other lists.
+ *
+ * Unlike vTaskPlaceOnEventList() the task does not block indefinitely when
+ * xTicksToWait is portMAX_DELAY.
+ */
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+    void vTaskPlaceOnEventLists( List_t * const * ppxEventLists,
+                                 ListItem_t * pxEventListItems,
+                                 UBaseType_t uxEventLists,
+                                 const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -3011,7 +3361,11 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
  * Sets the pointer to the current TCB to the TCB of the highest priority task
  * that is ready to run.
  */
-portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+#if ( configNUMBER_OF_CORES == 1 )
+    portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+#else
+    portDONT_DISCARD void vTaskSwitchContext( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
 
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
@@ -3024,6 +3378,57 @@ TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t xTaskGetCurrentTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Return the handle of the task running on core xCoreID, or NULL if xCoreID is
+ * not a valid core.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A MULTI-CORE PORT OF THE SCHEDULER.
+ *
+ * The critical section implementations for a multi-core build, which take the
+ * task and ISR locks provided by the port in addition to masking interrupts.
+ * The port maps portENTER_CRITICAL() and portEXIT_CRITICAL() onto
+ * vTaskEnterCritical() and vTaskExitCritical().
+ */
+    void vTaskEnterCritical( void ) PRIVILEGED_FUNCTION;
+    void vTaskExitCritical( void ) PRIVILEGED_FUNCTION;
+    UBaseType_t uxTaskEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used in place of portYIELD() within the kernel.  Yields straight away if
+ * called outside of a critical section, otherwise holds the yield pending
+ * until the critical section is exited.
+ */
+    void vTaskYieldWithinAPI( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES */
+
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER.
+ *
+ * Record the duration of a critical section in the eCriticalLatency
+ * histograms.  A single core port calls vTaskRecordCriticalEntry() from
+ * vPortEnterCritical() after interrupts are masked by the outermost critical
+ * section, and vTaskRecordCriticalExit() from vPortExitCritical() before they
+ * are unmasked again.  The multi-core critical sections implemented by the
+ * kernel call them itself.
+ */
+    void vTaskRecordCriticalEntry( void ) PRIVILEGED_FUNCTION;
+    void vTaskRecordCriticalExit( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_LATENCY_HISTOGRAMS */
+
 /*
  * Shortcut used by the queue implementation to prevent unnecessary call to
  * taskYIELD();
@@ -3038,7 +3443,10 @@ BaseType_t xTaskGetSchedulerState( void ) PRIVILEGED_FUNCTION;
 
 /*
  * Raises the priority of the mutex holder to that of the calling task should
- * the mutex holder have a priority less than the calling task.
+ * the mutex holder have a priority less than the calling task.  When
+ * configUSE_TRANSITIVE_PRIORITY_INHERITANCE is 1 and the mutex holder is itself
+ * blocked on a mutex, the holder of that mutex is raised too, and so on along
+ * the chain.
  */
 BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
 
@@ -3103,6 +3511,23 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Record the address of the holder of the mutex the
+ * calling task is about to block on, or clear it by passing NULL, so priority
+ * inheritance can follow a chain of mutexes from one holder to the next.  Only
+ * available when configUSE_TRANSITIVE_PRIORITY_INHERITANCE is 1.
+ */
+void vTaskSetBlockingMutexHolder( TaskHandle_t * const pxMutexHolder ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Increment the mutex held count of the highest
+ * priority task waiting in pxEventList and return its handle, so a mutex or the
+ * write side of a reader-writer lock can be handed directly to that task before
+ * it is unblocked.  Only available when configUSE_MUTEX_HANDOFF or
+ * configUSE_RW_LOCKS is 1.
+ */
+TaskHandle_t pvTaskIncrementWaiterMutexHeldCount( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
@@ -1318,11 +1318,67 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  * @param xTimer The handle of the timer being queried.
  *
  * @return If the timer is running then the time in ticks at which the timer
- * will next expire is returned.  If the timer is not running then the return
- * value is undefined.
+ * will next expire is returned, which includes any delay allowed by
+ * vTimerSetSlack().  If the timer is not running then the return value is
+ * undefined.
  */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlackInTicks );
+ *
+ * Allows a timer to expire up to xSlackInTicks ticks after the time at which
+ * it is due to expire, so that timers that are due to expire at about the same
+ * time expire together and the timer service task is woken less often.  The
+ * slack used is xSlackInTicks rounded down to one less than a power of two,
+ * and the expiry time is rounded up to a multiple of that power of two, so
+ * timers with the same slack, or a larger slack, that are due within the same
+ * multiple expire on the same tick.  The
+ * period of an auto-reload timer is still measured from the time at which it
+ * was due to expire, so the timer does not drift.
+ *
+ * The slack is used from the next time the timer is started, reset or
+ * reloaded.  Timers are created with a slack of zero, so expire on the tick
+ * on which they are due.
+ *
+ * configUSE_TIMER_COALESCING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param xSlackInTicks The number of ticks the timer may be late by.
+ *
+ * Example usage:
+ * @code{c}
+ * // A timer that polls a sensor every 100ms, which does not mind being up to
+ * // 15ms late, so can expire on any tick that is a multiple of 16.
+ * vTimerSetSlack( xSensorTimer, pdMS_TO_TICKS( 15 ) );
+ * xTimerStart( xSensorTimer, 0 );
+ * @endcode
+ */
+#if ( configUSE_TIMER_COALESCING == 1 )
+    void vTimerSetSlack( TimerHandle_t xTimer,
+                         const TickType_t xSlackInTicks ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * TickType_t xTimerGetSlack( TimerHandle_t xTimer );
+ *
+ * Returns the slack of a timer, as set by vTimerSetSlack().
+ *
+ * configUSE_TIMER_COALESCING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @return The number of ticks the timer may expire after it is due, which is
+ * the slack passed to vTimerSetSlack() rounded down to one less than a power of
+ * two.
+ */
+#if ( configUSE_TIMER_COALESCING == 1 )
+    TickType_t xTimerGetSlack( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
@@ -0,0 +1,294 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef WORKQUEUE_H
+#define WORKQUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include workqueue.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * A work queue is a task, the worker, that runs work items submitted to it by
+ * other tasks and by interrupts.  It lets an interrupt defer the bulk of its
+ * processing to a task without sharing the timer service task and its command
+ * queue, as xTimerPendFunctionCallFromISR() does.  Create one work queue for
+ * each priority at which deferred work must run - each is a separate lane, so
+ * work submitted to a high priority work queue is not held up by work waiting
+ * in a lower priority one.
+ *
+ * Submitting a work item does not copy data into a queue.  The item, which is
+ * provided by the application, is linked into a list with a compare-and-swap,
+ * and the worker is notified only if the list was empty.  The compare-and-swap
+ * does not enter a critical section if the port defines
+ * portATOMIC_COMPARE_AND_SWAP_U32() and portATOMIC_COMPARE_AND_SWAP_POINTER()
+ * in portmacro.h.  Otherwise the versions in atomic.h are used, which mask
+ * interrupts for the duration of each swap.  Multi-core ports must define
+ * both.  A work item that has been submitted but has not yet started to
+ * run is not queued again, so an interrupt that fires repeatedly before its
+ * work has run only causes that work to run once.  The work item can be
+ * submitted again from the moment its function starts to run.
+ *
+ * Work queues exist for the life of the application, and are only available
+ * when configUSE_WORK_QUEUES is set to 1 in FreeRTOSConfig.h.
+ */
+
+/**
+ * workqueue.h
+ *
+ * Types by which work queues and work items are referenced.
+ *
+ * \defgroup WorkQueueHandle_t WorkQueueHandle_t
+ * \ingroup WorkQueues
+ */
+struct WorkQueueDefinition;
+typedef struct WorkQueueDefinition * WorkQueueHandle_t;
+
+struct WorkItemDefinition;
+typedef struct WorkItemDefinition * WorkItemHandle_t;
+
+/*
+ * Defines the prototype to which functions run by a work queue must conform.
+ */
+typedef void (* WorkFunction_t)( void * pvParameter );
+
+/**
+ * workqueue.h
+ *
+ * Used with vWorkQueueGetStats() to obtain the statistics of a work queue.
+ * The latencies are measured with the run time stats counter, so are only
+ * recorded when configGENERATE_RUN_TIME_STATS is 1.
+ *
+ * \defgroup WorkQueueStats_t WorkQueueStats_t
+ * \ingroup WorkQueues
+ */
+typedef struct xWORK_QUEUE_STATS
+{
+    uint32_t ulExecuted;                            /* The number of work items the worker has run. */
+    uint32_t ulCoalesced;                           /* The number of submissions of items that were already waiting to run. */
+    configRUN_TIME_COUNTER_TYPE ulTotalLatency;     /* The sum of the times from submission until each item started to run. */
+    configRUN_TIME_COUNTER_TYPE ulMaximumLatency;   /* The longest time from submission until an item started to run. */
+} WorkQueueStats_t;
+
+/**
+ * workqueue.h
+ * @code{c}
+ * WorkQueueHandle_t xWorkQueueCreate( const char * const pcName,
+ *                                     UBaseType_t uxPriority,
+ *                                     configSTACK_DEPTH_TYPE usStackDepth );
+ * @endcode
+ *
+ * Creates a work queue and the worker task that runs its work items.
+ *
+ * @param pcName The name given to the worker task.
+ *
+ * @param uxPriority The priority at which the worker task, and so every work
+ * item submitted to the work queue, runs.
+ *
+ * @param usStackDepth The size of the stack of the worker task, in words, as
+ * passed to xTaskCreate().
+ *
+ * @return A handle to the created work queue, or NULL if there was not
+ * enough heap memory to create it.
+ *
+ * Example usage:
+ * @code{c}
+ *  static WorkQueueHandle_t xRxWorkQueue;
+ *  static StaticWorkItem_t xRxWorkBuffer;
+ *  static WorkItemHandle_t xRxWork;
+ *
+ *  static void prvProcessRx( void * pvParameter )
+ *  {
+ *      // Empty the receive FIFO.
+ *  }
+ *
+ *  void vSetup( void )
+ *  {
+ *      xRxWorkQueue = xWorkQueueCreate( "RxWork", configMAX_PRIORITIES - 2, configMINIMAL_STACK_SIZE );
+ *      xRxWork = xWorkItemCreateStatic( prvProcessRx, NULL, &xRxWorkBuffer );
+ *  }
+ *
+ *  void vRxISR( void )
+ *  {
+ *  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *      // However often the interrupt fires before prvProcessRx() runs, it
+ *      // runs once.
+ *      xWorkQueueSubmitFromISR( xRxWorkQueue, xRxWork, &xHigherPriorityTaskWoken );
+ *      portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ *  }
+ * @endcode
+ * \defgroup xWorkQueueCreate xWorkQueueCreate
+ * \ingroup WorkQueues
+ */
+WorkQueueHandle_t xWorkQueueCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    UBaseType_t uxPriority,
+                                    configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ * @code{c}
+ * WorkItemHandle_t xWorkItemCreateStatic( WorkFunction_t pxFunction,
+ *                                         void * pvParameter,
+ *                                         StaticWorkItem_t * pxWorkItemBuffer );
+ * @endcode
+ *
+ * Creates a work item using memory provided by the application.  The work
+ * item can be submitted to any work queue, but to only one at a time.
+ *
+ * @param pxFunction The function the worker calls when it runs the item.
+ *
+ * @param pvParameter The value passed to pxFunction.
+ *
+ * @param pxWorkItemBuffer Must point to a variable of type StaticWorkItem_t,
+ * which will be used to hold the work item's data structure.
+ *
+ * @return A handle to the work item, or NULL if pxWorkItemBuffer is NULL.
+ *
+ * \defgroup xWorkItemCreateStatic xWorkItemCreateStatic
+ * \ingroup WorkQueues
+ */
+WorkItemHandle_t xWorkItemCreateStatic( WorkFunction_t pxFunction,
+                                        void * pvParameter,
+                                        StaticWorkItem_t * pxWorkItemBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ * @code{c}
+ * BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue, WorkItemHandle_t xWorkItem );
+ * @endcode
+ *
+ * Submits a work item to a work queue from a task.  Items submitted to the
+ * same work queue run in the order in which they were submitted.
+ *
+ * @param xWorkQueue The work queue that is to run the item.
+ *
+ * @param xWorkItem The work item to run.
+ *
+ * @return pdPASS if the item was queued.  pdFALSE if the item was already
+ * waiting to run, in which case it runs only once.
+ *
+ * \defgroup xWorkQueueSubmit xWorkQueueSubmit
+ * \ingroup WorkQueues
+ */
+BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                             WorkItemHandle_t xWorkItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ * @code{c}
+ * BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+ *                                     WorkItemHandle_t xWorkItem,
+ *                                     BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xWorkQueueSubmit() that can be called from an interrupt
+ * service routine.
+ *
+ * @param xWorkQueue The work queue that is to run the item.
+ *
+ * @param xWorkItem The work item to run.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if submitting the item
+ * unblocked a worker task with a priority above that of the interrupted task,
+ * in which case a context switch should be requested before the interrupt
+ * exits.  Can be NULL.
+ *
+ * @return pdPASS if the item was queued.  pdFALSE if the item was already
+ * waiting to run.
+ *
+ * \defgroup xWorkQueueSubmitFromISR xWorkQueueSubmitFromISR
+ * \ingroup WorkQueues
+ */
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+                                    WorkItemHandle_t xWorkItem,
+                                    BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ * @code{c}
+ * BaseType_t xWorkItemIsPending( WorkItemHandle_t xWorkItem );
+ * @endcode
+ *
+ * @param xWorkItem The work item being queried.
+ *
+ * @return pdTRUE if the work item has been submitted and has not yet started
+ * to run, otherwise pdFALSE.
+ *
+ * \defgroup xWorkItemIsPending xWorkItemIsPending
+ * \ingroup WorkQueues
+ */
+BaseType_t xWorkItemIsPending( WorkItemHandle_t xWorkItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ * @code{c}
+ * TaskHandle_t xWorkQueueGetWorkerTask( WorkQueueHandle_t xWorkQueue );
+ * @endcode
+ *
+ * @return The handle of the task that runs the work items of xWorkQueue.
+ *
+ * \defgroup xWorkQueueGetWorkerTask xWorkQueueGetWorkerTask
+ * \ingroup WorkQueues
+ */
+TaskHandle_t xWorkQueueGetWorkerTask( WorkQueueHandle_t xWorkQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ * @code{c}
+ * void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue, WorkQueueStats_t * pxStats );
+ * @endcode
+ *
+ * Reads the statistics gathered since a work queue was created.
+ *
+ * @param xWorkQueue The work queue being queried.
+ *
+ * @param pxStats Used to return the statistics.
+ *
+ * \defgroup vWorkQueueGetStats vWorkQueueGetStats
+ * \ingroup WorkQueues
+ */
+void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+                         WorkQueueStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* WORKQUEUE_H */
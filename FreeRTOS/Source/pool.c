@@ -0,0 +1,762 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "pool.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+/* Set configUSE_STATS_FORMATTING_FUNCTIONS to 2 to include the stats formatting
+ * function but without including stdio.h here. */
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 ) )
+
+/* vPoolGetRunTimeStats() formats its table with sprintf(), as the formatting
+ * functions in tasks.c do. */
+    #include <stdio.h>
+#endif
+
+/* This entire source file will be skipped if the application is not configured
+ * to include object pool functionality.  This #if is closed at the very bottom
+ * of this file.  If you want to include object pools then ensure
+ * configUSE_OBJECT_POOLS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_OBJECT_POOLS == 1 )
+
+/* The head of a pool's free list holds the index of the first free object in
+ * its low 16 bits.  Its high 16 bits hold a tag that is incremented each time
+ * the head changes, so a compare-and-swap cannot succeed if the head has been
+ * removed and put back since it was read (the ABA problem).  Each free object
+ * holds the index of the next free object in its first four bytes. */
+    #define poolINDEX_MASK          ( ( uint32_t ) 0x0000ffffUL )
+    #define poolTAG_MASK            ( ( uint32_t ) 0xffff0000UL )
+    #define poolTAG_INCREMENT       ( ( uint32_t ) 0x00010000UL )
+    #define poolEMPTY_INDEX         poolINDEX_MASK
+    #define poolMAX_OBJECTS         ( ( UBaseType_t ) poolEMPTY_INDEX - ( UBaseType_t ) 1U )
+
+/* A port that has a compare-and-swap instruction can define
+ * portATOMIC_COMPARE_AND_SWAP_U32() in portmacro.h.  Otherwise the version in
+ * atomic.h is used, which masks interrupts for the duration of the swap, so
+ * allocating and freeing are then not lock free.  Either must return
+ * ATOMIC_COMPARE_AND_SWAP_SUCCESS if the swap was made, and must act as a full
+ * memory barrier.  Masking interrupts does not stop another core taking the
+ * same free object, so a multi-core port must provide it. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        #if !defined( portATOMIC_COMPARE_AND_SWAP_U32 )
+            #error portATOMIC_COMPARE_AND_SWAP_U32() must be defined in portmacro.h to use object pools on a multi-core port.
+        #endif
+    #endif
+
+    #ifndef portATOMIC_COMPARE_AND_SWAP_U32
+        #define portATOMIC_COMPARE_AND_SWAP_U32( pulDestination, ulExchange, ulComparand )    Atomic_CompareAndSwap_u32( ( pulDestination ), ( ulExchange ), ( ulComparand ) )
+    #endif
+
+    #if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+        #define poolYIELD_IF_USING_PREEMPTION()
+    #else
+        #define poolYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+    #endif
+
+/*
+ * Definition of the object pool structure.  The xSTATIC_POOL structure in
+ * FreeRTOS.h must be kept in step with it.
+ */
+    typedef struct PoolDefinition /* The old naming convention is used to prevent breaking kernel aware debuggers. */
+    {
+        volatile uint32_t ulFreeListHead;     /*< The index of the first free object, and the tag described at the top of this file. */
+        uint8_t * pucStorage;                 /*< The objects. */
+        UBaseType_t uxObjectSize;             /*< The size of each object in bytes. */
+        UBaseType_t uxNumberOfObjects;        /*< The number of objects in pucStorage. */
+        volatile UBaseType_t uxTasksWaiting;  /*< The number of tasks that are blocked on, or about to block on, xTasksWaitingToAlloc. */
+        List_t xTasksWaitingToAlloc;          /*< List of tasks that are blocked waiting to allocate from this pool.  Stored in priority order. */
+
+        #if ( configUSE_TRACE_FACILITY == 1 )
+            volatile uint32_t ulAllocations;
+            volatile uint32_t ulFailedAllocations;
+            volatile uint32_t ulObjectsInUse;
+            volatile uint32_t ulMaximumObjectsInUse;
+            const char * pcPoolName;           /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+            struct PoolDefinition * pxNextPool; /*< The next pool in the list walked by vPoolGetRunTimeStats(). */
+        #endif
+    } Pool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Removes the first object from the free list of pxPool, returning NULL if
+ * the list is empty.
+ */
+    static void * prvPopObject( Pool_t * const pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Places pvObject at the start of the free list of pxPool.
+ */
+    static void prvPushObject( Pool_t * const pxPool,
+                               void * const pvObject ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TRACE_FACILITY == 1 )
+
+/*
+ * Atomically adds lDelta to *pulValue, returning the new value.
+ */
+        static uint32_t prvAtomicAdd( volatile uint32_t * const pulValue,
+                                      int32_t lDelta ) PRIVILEGED_FUNCTION;
+
+/*
+ * Updates the allocation counts of pxPool after a successful allocation.
+ */
+        static void prvRecordAllocation( Pool_t * const pxPool ) PRIVILEGED_FUNCTION;
+    #endif
+
+    #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+/*
+ * Writes pcPoolName to pcBuffer padded to configMAX_TASK_NAME_LEN characters,
+ * as the names of tasks are written by vTaskGetRunTimeStats().
+ */
+        static char * prvWriteNameToBuffer( char * pcBuffer,
+                                            const char * pcPoolName ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TRACE_FACILITY == 1 )
+
+/* The pools that exist, for vPoolGetRunTimeStats(). */
+        PRIVILEGED_DATA static Pool_t * pxPoolList = NULL;
+    #endif
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        PoolHandle_t xPoolCreateStatic( const char * const pcPoolName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        UBaseType_t uxObjectSize,
+                                        UBaseType_t uxNumberOfObjects,
+                                        uint8_t * const pucPoolStorage,
+                                        StaticPool_t * const pxPoolBuffer )
+        {
+            Pool_t * pxNewPool = NULL;
+            uint32_t ulIndex, ulNextIndex;
+
+            configASSERT( pucPoolStorage );
+            configASSERT( pxPoolBuffer );
+            configASSERT( uxObjectSize >= sizeof( uint32_t ) );
+            configASSERT( ( uxNumberOfObjects > ( UBaseType_t ) 0U ) && ( uxNumberOfObjects <= poolMAX_OBJECTS ) );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticPool_t equals the size of the real pool
+                 * structure. */
+                volatile size_t xSize = sizeof( StaticPool_t );
+
+                /* This assertion cannot be branch covered in unit tests */
+                configASSERT( xSize == sizeof( Pool_t ) ); /* LCOV_EXCL_BR_LINE */
+                ( void ) xSize;                            /* Keeps lint quiet when configASSERT() is not defined. */
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( ( pucPoolStorage != NULL ) && ( pxPoolBuffer != NULL ) )
+            {
+                /* The StaticPool_t structure is guaranteed to have the same size
+                 * and alignment requirements as the real pool structure. */
+                pxNewPool = ( Pool_t * ) pxPoolBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+
+                pxNewPool->pucStorage = pucPoolStorage;
+                pxNewPool->uxObjectSize = uxObjectSize;
+                pxNewPool->uxNumberOfObjects = uxNumberOfObjects;
+                pxNewPool->uxTasksWaiting = ( UBaseType_t ) 0U;
+                vListInitialise( &( pxNewPool->xTasksWaitingToAlloc ) );
+
+                /* Chain every object onto the free list in address order. */
+                for( ulIndex = 0U; ulIndex < ( uint32_t ) uxNumberOfObjects; ulIndex++ )
+                {
+                    ulNextIndex = ( ( ulIndex + 1U ) < ( uint32_t ) uxNumberOfObjects ) ? ( ulIndex + 1U ) : poolEMPTY_INDEX;
+                    ( void ) memcpy( &( pucPoolStorage[ ulIndex * uxObjectSize ] ), &ulNextIndex, sizeof( ulNextIndex ) );
+                }
+
+                pxNewPool->ulFreeListHead = 0U;
+
+                #if ( configUSE_TRACE_FACILITY == 1 )
+                {
+                    pxNewPool->ulAllocations = 0U;
+                    pxNewPool->ulFailedAllocations = 0U;
+                    pxNewPool->ulObjectsInUse = 0U;
+                    pxNewPool->ulMaximumObjectsInUse = 0U;
+                    pxNewPool->pcPoolName = pcPoolName;
+
+                    vTaskSuspendAll();
+                    {
+                        pxNewPool->pxNextPool = pxPoolList;
+                        pxPoolList = pxNewPool;
+                    }
+                    ( void ) xTaskResumeAll();
+                }
+                #else
+                {
+                    ( void ) pcPoolName;
+                }
+                #endif /* configUSE_TRACE_FACILITY */
+
+                tracePOOL_CREATE( pxNewPool );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxNewPool;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vPoolDelete( PoolHandle_t xPool )
+    {
+        Pool_t * const pxPool = xPool;
+
+        #if ( configUSE_TRACE_FACILITY == 1 )
+            Pool_t ** ppxPool;
+        #endif
+
+        configASSERT( pxPool );
+        configASSERT( listLIST_IS_EMPTY( &( pxPool->xTasksWaitingToAlloc ) ) != pdFALSE );
+
+        tracePOOL_DELETE( pxPool );
+
+        #if ( configUSE_TRACE_FACILITY == 1 )
+        {
+            vTaskSuspendAll();
+            {
+                for( ppxPool = &pxPoolList; *ppxPool != NULL; ppxPool = &( ( *ppxPool )->pxNextPool ) )
+                {
+                    if( *ppxPool == pxPool )
+                    {
+                        *ppxPool = pxPool->pxNextPool;
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+        #endif /* configUSE_TRACE_FACILITY */
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvPoolAlloc( PoolHandle_t xPool,
+                        TickType_t xTicksToWait )
+    {
+        Pool_t * const pxPool = xPool;
+        void * pvObject;
+        TimeOut_t xTimeOut;
+        BaseType_t xEntryTimeSet = pdFALSE;
+
+        configASSERT( pxPool );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            /* The fast path.  No critical section is entered. */
+            pvObject = prvPopObject( pxPool );
+
+            if( pvObject != NULL )
+            {
+                break;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                /* The pool is empty and either no block time was specified or
+                 * the block time has expired. */
+                break;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                /* The pool is empty and a block time was specified so configure
+                 * the timeout structure. */
+                vTaskInternalSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                /* Timed out.  Try once more before returning. */
+                xTicksToWait = ( TickType_t ) 0;
+                continue;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            taskENTER_CRITICAL();
+            {
+                /* Announce that a task is about to block before looking at the
+                 * free list a final time.  A task that frees an object reads
+                 * uxTasksWaiting after pushing the object, so either this task
+                 * sees the object or the freeing task sees this task and enters
+                 * the critical section to unblock it. */
+                pxPool->uxTasksWaiting++;
+                portMEMORY_BARRIER();
+
+                pvObject = prvPopObject( pxPool );
+
+                if( pvObject == NULL )
+                {
+                    traceBLOCKING_ON_POOL_ALLOC( pxPool );
+                    vTaskPlaceOnEventList( &( pxPool->xTasksWaitingToAlloc ), xTicksToWait );
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            taskENTER_CRITICAL();
+            {
+                pxPool->uxTasksWaiting--;
+            }
+            taskEXIT_CRITICAL();
+
+            if( pvObject != NULL )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( pvObject != NULL )
+        {
+            #if ( configUSE_TRACE_FACILITY == 1 )
+            {
+                prvRecordAllocation( pxPool );
+            }
+            #endif
+
+            tracePOOL_ALLOC( pxPool, pvObject );
+        }
+        else
+        {
+            #if ( configUSE_TRACE_FACILITY == 1 )
+            {
+                ( void ) prvAtomicAdd( &( pxPool->ulFailedAllocations ), 1 );
+            }
+            #endif
+
+            tracePOOL_ALLOC_FAILED( pxPool );
+        }
+
+        return pvObject;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvPoolAllocFromISR( PoolHandle_t xPool )
+    {
+        Pool_t * const pxPool = xPool;
+        void * pvObject;
+
+        configASSERT( pxPool );
+
+        /* RTOS ports that support interrupt nesting have the concept of a maximum
+         * system call (or maximum API call) interrupt priority.  Interrupts that are
+         * above the maximum system call priority are kept permanently enabled, even
+         * when the RTOS kernel is in a critical section, but cannot make any calls to
+         * FreeRTOS API functions. */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        pvObject = prvPopObject( pxPool );
+
+        if( pvObject != NULL )
+        {
+            #if ( configUSE_TRACE_FACILITY == 1 )
+            {
+                prvRecordAllocation( pxPool );
+            }
+            #endif
+
+            tracePOOL_ALLOC_FROM_ISR( pxPool, pvObject );
+        }
+        else
+        {
+            #if ( configUSE_TRACE_FACILITY == 1 )
+            {
+                ( void ) prvAtomicAdd( &( pxPool->ulFailedAllocations ), 1 );
+            }
+            #endif
+
+            tracePOOL_ALLOC_FROM_ISR_FAILED( pxPool );
+        }
+
+        return pvObject;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPoolFree( PoolHandle_t xPool,
+                    void * pvObject )
+    {
+        Pool_t * const pxPool = xPool;
+
+        configASSERT( pxPool );
+
+        tracePOOL_FREE( pxPool, pvObject );
+        prvPushObject( pxPool, pvObject );
+
+        #if ( configUSE_TRACE_FACILITY == 1 )
+        {
+            ( void ) prvAtomicAdd( &( pxPool->ulObjectsInUse ), -1 );
+        }
+        #endif
+
+        /* The compare-and-swap that pushed the object is a full memory barrier,
+         * so uxTasksWaiting is read after the object can be seen by a task that
+         * is about to block. */
+        if( pxPool->uxTasksWaiting > ( UBaseType_t ) 0U )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( listLIST_IS_EMPTY( &( pxPool->xTasksWaitingToAlloc ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxPool->xTasksWaitingToAlloc ) ) != pdFALSE )
+                    {
+                        /* The unblocked task has a priority higher than our own
+                         * so yield immediately. */
+                        poolYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPoolFreeFromISR( PoolHandle_t xPool,
+                           void * pvObject,
+                           BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        Pool_t * const pxPool = xPool;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxPool );
+
+        /* See the comment in pvPoolAllocFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        tracePOOL_FREE_FROM_ISR( pxPool, pvObject );
+        prvPushObject( pxPool, pvObject );
+
+        #if ( configUSE_TRACE_FACILITY == 1 )
+        {
+            ( void ) prvAtomicAdd( &( pxPool->ulObjectsInUse ), -1 );
+        }
+        #endif
+
+        if( pxPool->uxTasksWaiting > ( UBaseType_t ) 0U )
+        {
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                if( listLIST_IS_EMPTY( &( pxPool->xTasksWaitingToAlloc ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxPool->xTasksWaitingToAlloc ) ) != pdFALSE )
+                    {
+                        /* The task unblocked has a priority higher than the
+                         * task that was interrupted so record that a context
+                         * switch is required. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TRACE_FACILITY == 1 )
+
+        void vPoolGetStatus( PoolHandle_t xPool,
+                             PoolStatus_t * pxPoolStatus )
+        {
+            Pool_t * const pxPool = xPool;
+
+            configASSERT( pxPool );
+            configASSERT( pxPoolStatus );
+
+            pxPoolStatus->pcPoolName = pxPool->pcPoolName;
+            pxPoolStatus->uxObjectSize = pxPool->uxObjectSize;
+            pxPoolStatus->uxNumberOfObjects = pxPool->uxNumberOfObjects;
+            pxPoolStatus->uxObjectsInUse = ( UBaseType_t ) pxPool->ulObjectsInUse;
+            pxPoolStatus->uxMaximumObjectsInUse = ( UBaseType_t ) pxPool->ulMaximumObjectsInUse;
+            pxPoolStatus->ulAllocations = pxPool->ulAllocations;
+            pxPoolStatus->ulFailedAllocations = pxPool->ulFailedAllocations;
+        }
+
+    #endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+        void vPoolGetRunTimeStats( char * pcWriteBuffer )
+        {
+            Pool_t * pxPool;
+            PoolStatus_t xPoolStatus;
+
+            /*
+             * PLEASE NOTE:
+             *
+             * This function is provided for convenience only, in the same way
+             * as vTaskGetRunTimeStats().  It uses sprintf() and writes one line
+             * per pool, so the buffer must be large enough for every pool that
+             * exists.
+             */
+
+            /* Make sure the write buffer does not contain a string. */
+            *pcWriteBuffer = ( char ) 0x00;
+
+            vTaskSuspendAll();
+            {
+                for( pxPool = pxPoolList; pxPool != NULL; pxPool = pxPool->pxNextPool )
+                {
+                    vPoolGetStatus( pxPool, &xPoolStatus );
+
+                    /* Write the pool name to the string, padding with spaces so
+                     * it can be printed in tabular form more easily. */
+                    pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, ( xPoolStatus.pcPoolName != NULL ) ? xPoolStatus.pcPoolName : "" );
+
+                    sprintf( pcWriteBuffer, "\t%u\t%u\t%u\t%u\t%u\r\n",
+                             ( unsigned int ) xPoolStatus.uxNumberOfObjects,
+                             ( unsigned int ) xPoolStatus.uxObjectsInUse,
+                             ( unsigned int ) xPoolStatus.uxMaximumObjectsInUse,
+                             ( unsigned int ) xPoolStatus.ulAllocations,
+                             ( unsigned int ) xPoolStatus.ulFailedAllocations ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                    pcWriteBuffer += strlen( pcWriteBuffer );                    /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+
+    #endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+/*-----------------------------------------------------------*/
+
+    static void * prvPopObject( Pool_t * const pxPool )
+    {
+        uint32_t ulHead, ulNewHead, ulIndex, ulNextIndex;
+        void * pvObject;
+
+        for( ; ; )
+        {
+            ulHead = pxPool->ulFreeListHead;
+            ulIndex = ulHead & poolINDEX_MASK;
+
+            if( ulIndex == poolEMPTY_INDEX )
+            {
+                pvObject = NULL;
+                break;
+            }
+
+            /* The object may be allocated and overwritten by another task
+             * before the swap below, in which case the tag will have changed
+             * and the swap will fail. */
+            pvObject = &( pxPool->pucStorage[ ulIndex * pxPool->uxObjectSize ] );
+            ( void ) memcpy( &ulNextIndex, pvObject, sizeof( ulNextIndex ) );
+            ulNewHead = ( ( ulHead + poolTAG_INCREMENT ) & poolTAG_MASK ) | ( ulNextIndex & poolINDEX_MASK );
+
+            if( portATOMIC_COMPARE_AND_SWAP_U32( &( pxPool->ulFreeListHead ), ulNewHead, ulHead ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return pvObject;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPushObject( Pool_t * const pxPool,
+                               void * const pvObject )
+    {
+        uint32_t ulHead, ulNewHead, ulIndex, ulNextIndex;
+        size_t xOffset;
+
+        configASSERT( pvObject );
+        configASSERT( ( uint8_t * ) pvObject >= pxPool->pucStorage );
+
+        xOffset = ( size_t ) ( ( uint8_t * ) pvObject - pxPool->pucStorage );
+        ulIndex = ( uint32_t ) ( xOffset / pxPool->uxObjectSize );
+
+        /* The object must be one of the objects in the pool. */
+        configASSERT( ( xOffset % pxPool->uxObjectSize ) == 0U );
+        configASSERT( ulIndex < ( uint32_t ) pxPool->uxNumberOfObjects );
+
+        for( ; ; )
+        {
+            ulHead = pxPool->ulFreeListHead;
+            ulNextIndex = ulHead & poolINDEX_MASK;
+            ( void ) memcpy( pvObject, &ulNextIndex, sizeof( ulNextIndex ) );
+            ulNewHead = ( ( ulHead + poolTAG_INCREMENT ) & poolTAG_MASK ) | ulIndex;
+
+            if( portATOMIC_COMPARE_AND_SWAP_U32( &( pxPool->ulFreeListHead ), ulNewHead, ulHead ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TRACE_FACILITY == 1 )
+
+        static uint32_t prvAtomicAdd( volatile uint32_t * const pulValue,
+                                      int32_t lDelta )
+        {
+            uint32_t ulCurrent, ulNew;
+
+            do
+            {
+                ulCurrent = *pulValue;
+                ulNew = ulCurrent + ( uint32_t ) lDelta;
+            } while( portATOMIC_COMPARE_AND_SWAP_U32( pulValue, ulNew, ulCurrent ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+
+            return ulNew;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvRecordAllocation( Pool_t * const pxPool )
+        {
+            uint32_t ulInUse, ulMaximum;
+
+            ( void ) prvAtomicAdd( &( pxPool->ulAllocations ), 1 );
+            ulInUse = prvAtomicAdd( &( pxPool->ulObjectsInUse ), 1 );
+
+            /* Raise the maximum unless another task has already raised it
+             * further. */
+            do
+            {
+                ulMaximum = pxPool->ulMaximumObjectsInUse;
+            } while( ( ulInUse > ulMaximum ) &&
+                     ( portATOMIC_COMPARE_AND_SWAP_U32( &( pxPool->ulMaximumObjectsInUse ), ulInUse, ulMaximum ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS ) );
+        }
+
+    #endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+        static char * prvWriteNameToBuffer( char * pcBuffer,
+                                            const char * pcPoolName )
+        {
+            size_t x;
+
+            /* Start by copying the entire string. */
+            strcpy( pcBuffer, pcPoolName );
+
+            /* Pad the end of the string with spaces to ensure columns line up
+             * when printed out. */
+            for( x = strlen( pcBuffer ); x < ( size_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
+            {
+                pcBuffer[ x ] = ' ';
+            }
+
+            /* Terminate. */
+            pcBuffer[ x ] = ( char ) 0x00;
+
+            /* Return the new end of string. */
+            return &( pcBuffer[ x ] );
+        }
+
+    #endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include object pool functionality.  If you want to include object pools
+ * then ensure configUSE_OBJECT_POOLS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_OBJECT_POOLS == 1 */
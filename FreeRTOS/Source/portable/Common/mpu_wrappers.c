@@ -43,6 +43,9 @@
 #include "timers.h"
 #include "event_groups.h"
 #include "stream_buffer.h"
+#include "pool.h"
+#include "rwlock.h"
+#include "workqueue.h"
 #include "mpu_prototypes.h"
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
@@ -597,6 +600,99 @@
     #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+        void MPU_vTaskGetPerfCounters( const TaskHandle_t * const pxTasks,
+                                       TaskPerfCounters_t * const pxPerfCounters,
+                                       UBaseType_t uxTaskCount ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vTaskGetPerfCounters( pxTasks, pxPerfCounters, uxTaskCount );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTaskGetPerfCounters( pxTasks, pxPerfCounters, uxTaskCount );
+            }
+        }
+    #endif /* if ( configUSE_TASK_PERF_COUNTERS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+        void MPU_vTaskGetCorePerfCounters( BaseType_t xCoreID,
+                                           CorePerfCounters_t * pxPerfCounters ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vTaskGetCorePerfCounters( xCoreID, pxPerfCounters );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTaskGetCorePerfCounters( xCoreID, pxPerfCounters );
+            }
+        }
+    #endif /* if ( configUSE_TASK_PERF_COUNTERS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+        void MPU_vTaskGetLatencyHistogram( eLatencyHistogram eHistogram,
+                                           UBaseType_t uxPriority,
+                                           LatencyHistogram_t * pxHistogram ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vTaskGetLatencyHistogram( eHistogram, uxPriority, pxHistogram );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTaskGetLatencyHistogram( eHistogram, uxPriority, pxHistogram );
+            }
+        }
+    #endif /* if ( configUSE_LATENCY_HISTOGRAMS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+        void MPU_vTaskResetLatencyHistograms( void ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vTaskResetLatencyHistograms();
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTaskResetLatencyHistograms();
+            }
+        }
+    #endif /* if ( configUSE_LATENCY_HISTOGRAMS == 1 ) */
+/*-----------------------------------------------------------*/
+
     #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
         configRUN_TIME_COUNTER_TYPE MPU_ulTaskGetIdleRunTimeCounter( void ) /* FREERTOS_SYSTEM_CALL */
         {
@@ -854,6 +950,32 @@
     #endif /* if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 )
+        configSTACK_DEPTH_TYPE MPU_uxTaskGetStackHighWaterMarkIncremental( TaskHandle_t xTask ) /* FREERTOS_SYSTEM_CALL */
+        {
+            configSTACK_DEPTH_TYPE uxReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                uxReturn = uxTaskGetStackHighWaterMarkIncremental( xTask );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                uxReturn = uxTaskGetStackHighWaterMarkIncremental( xTask );
+            }
+
+            return uxReturn;
+        }
+    #endif /* if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 ) */
+/*-----------------------------------------------------------*/
+
     #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
         TaskHandle_t MPU_xTaskGetCurrentTaskHandle( void ) /* FREERTOS_SYSTEM_CALL */
         {
@@ -1277,6 +1399,94 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_QUEUE_BATCHING == 1 )
+        BaseType_t MPU_xQueueSendMultiple( QueueHandle_t xQueue,
+                                           const void * const pvItemsToQueue,
+                                           const UBaseType_t uxItemCount,
+                                           TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_QUEUE_BATCHING == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_BATCHING == 1 )
+        BaseType_t MPU_xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                              void * const pvBuffer,
+                                              const UBaseType_t uxMaxItems,
+                                              TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_QUEUE_BATCHING == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+        BaseType_t MPU_xQueueReceiveAny( QueueHandle_t const * pxQueues,
+                                         const UBaseType_t uxQueueCount,
+                                         void * const pvBuffer,
+                                         UBaseType_t * const puxIndex,
+                                         TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueReceiveAny( pxQueues, uxQueueCount, pvBuffer, puxIndex, xTicksToWait );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueReceiveAny( pxQueues, uxQueueCount, pvBuffer, puxIndex, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_QUEUE_RECEIVE_ANY == 1 ) */
+/*-----------------------------------------------------------*/
+
     BaseType_t MPU_xQueuePeek( QueueHandle_t xQueue,
                                void * const pvBuffer,
                                TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
@@ -1942,6 +2152,55 @@
     #endif /* if ( configUSE_TIMERS == 1 ) */
 /*-----------------------------------------------------------*/
 
+    #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_COALESCING == 1 ) )
+        void MPU_vTimerSetSlack( TimerHandle_t xTimer,
+                                 const TickType_t xSlackInTicks ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vTimerSetSlack( xTimer, xSlackInTicks );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTimerSetSlack( xTimer, xSlackInTicks );
+            }
+        }
+    #endif /* if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_COALESCING == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_COALESCING == 1 ) )
+        TickType_t MPU_xTimerGetSlack( TimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            TickType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xTimerGetSlack( xTimer );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xTimerGetSlack( xTimer );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_COALESCING == 1 ) ) */
+/*-----------------------------------------------------------*/
+
     #if ( configUSE_TIMERS == 1 )
         BaseType_t MPU_xTimerGenericCommand( TimerHandle_t xTimer,
                                              const BaseType_t xCommandID,
@@ -2505,6 +2764,521 @@
     #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+    #if ( ( configUSE_OBJECT_POOLS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        PoolHandle_t MPU_xPoolCreateStatic( const char * const pcPoolName,
+                                            UBaseType_t uxObjectSize,
+                                            UBaseType_t uxNumberOfObjects,
+                                            uint8_t * const pucPoolStorage,
+                                            StaticPool_t * const pxPoolBuffer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            PoolHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xPoolCreateStatic( pcPoolName, uxObjectSize, uxNumberOfObjects, pucPoolStorage, pxPoolBuffer );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xPoolCreateStatic( pcPoolName, uxObjectSize, uxNumberOfObjects, pucPoolStorage, pxPoolBuffer );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_OBJECT_POOLS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_OBJECT_POOLS == 1 )
+        void MPU_vPoolDelete( PoolHandle_t xPool ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vPoolDelete( xPool );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vPoolDelete( xPool );
+            }
+        }
+    #endif /* if ( configUSE_OBJECT_POOLS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_OBJECT_POOLS == 1 )
+        void * MPU_pvPoolAlloc( PoolHandle_t xPool,
+                                TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+        {
+            void * pvReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                pvReturn = pvPoolAlloc( xPool, xTicksToWait );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                pvReturn = pvPoolAlloc( xPool, xTicksToWait );
+            }
+
+            return pvReturn;
+        }
+    #endif /* if ( configUSE_OBJECT_POOLS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_OBJECT_POOLS == 1 )
+        void MPU_vPoolFree( PoolHandle_t xPool,
+                            void * pvObject ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vPoolFree( xPool, pvObject );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vPoolFree( xPool, pvObject );
+            }
+        }
+    #endif /* if ( configUSE_OBJECT_POOLS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_OBJECT_POOLS == 1 ) && ( configUSE_TRACE_FACILITY == 1 ) )
+        void MPU_vPoolGetStatus( PoolHandle_t xPool,
+                                 PoolStatus_t * pxPoolStatus ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vPoolGetStatus( xPool, pxPoolStatus );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vPoolGetStatus( xPool, pxPoolStatus );
+            }
+        }
+    #endif /* if ( ( configUSE_OBJECT_POOLS == 1 ) && ( configUSE_TRACE_FACILITY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        RWLockHandle_t MPU_xRWLockCreate( void ) /* FREERTOS_SYSTEM_CALL */
+        {
+            RWLockHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xRWLockCreate();
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xRWLockCreate();
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        RWLockHandle_t MPU_xRWLockCreateStatic( StaticRWLock_t * pxRWLockBuffer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            RWLockHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xRWLockCreateStatic( pxRWLockBuffer );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xRWLockCreateStatic( pxRWLockBuffer );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RW_LOCKS == 1 )
+        void MPU_vRWLockDelete( RWLockHandle_t xRWLock ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vRWLockDelete( xRWLock );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vRWLockDelete( xRWLock );
+            }
+        }
+    #endif /* if ( configUSE_RW_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RW_LOCKS == 1 )
+        BaseType_t MPU_xRWLockTakeRead( RWLockHandle_t xRWLock,
+                                        TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xRWLockTakeRead( xRWLock, xTicksToWait );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xRWLockTakeRead( xRWLock, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_RW_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RW_LOCKS == 1 )
+        BaseType_t MPU_xRWLockGiveRead( RWLockHandle_t xRWLock ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xRWLockGiveRead( xRWLock );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xRWLockGiveRead( xRWLock );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_RW_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RW_LOCKS == 1 )
+        BaseType_t MPU_xRWLockTakeWrite( RWLockHandle_t xRWLock,
+                                         TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xRWLockTakeWrite( xRWLock, xTicksToWait );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xRWLockTakeWrite( xRWLock, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_RW_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RW_LOCKS == 1 )
+        BaseType_t MPU_xRWLockGiveWrite( RWLockHandle_t xRWLock ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xRWLockGiveWrite( xRWLock );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xRWLockGiveWrite( xRWLock );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_RW_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RW_LOCKS == 1 )
+        UBaseType_t MPU_uxRWLockGetReaderCount( RWLockHandle_t xRWLock ) /* FREERTOS_SYSTEM_CALL */
+        {
+            UBaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = uxRWLockGetReaderCount( xRWLock );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = uxRWLockGetReaderCount( xRWLock );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_RW_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RW_LOCKS == 1 )
+        TaskHandle_t MPU_xRWLockGetWriteHolder( RWLockHandle_t xRWLock ) /* FREERTOS_SYSTEM_CALL */
+        {
+            TaskHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xRWLockGetWriteHolder( xRWLock );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xRWLockGetWriteHolder( xRWLock );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_RW_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+        WorkQueueHandle_t MPU_xWorkQueueCreate( const char * const pcName,
+                                                UBaseType_t uxPriority,
+                                                configSTACK_DEPTH_TYPE usStackDepth ) /* FREERTOS_SYSTEM_CALL */
+        {
+            WorkQueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xWorkQueueCreate( pcName, uxPriority, usStackDepth );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xWorkQueueCreate( pcName, uxPriority, usStackDepth );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_WORK_QUEUES == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+        WorkItemHandle_t MPU_xWorkItemCreateStatic( WorkFunction_t pxFunction,
+                                                    void * pvParameter,
+                                                    StaticWorkItem_t * pxWorkItemBuffer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            WorkItemHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xWorkItemCreateStatic( pxFunction, pvParameter, pxWorkItemBuffer );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xWorkItemCreateStatic( pxFunction, pvParameter, pxWorkItemBuffer );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_WORK_QUEUES == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+        BaseType_t MPU_xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                                         WorkItemHandle_t xWorkItem ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xWorkQueueSubmit( xWorkQueue, xWorkItem );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xWorkQueueSubmit( xWorkQueue, xWorkItem );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_WORK_QUEUES == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+        BaseType_t MPU_xWorkItemIsPending( WorkItemHandle_t xWorkItem ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xWorkItemIsPending( xWorkItem );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xWorkItemIsPending( xWorkItem );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_WORK_QUEUES == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+        TaskHandle_t MPU_xWorkQueueGetWorkerTask( WorkQueueHandle_t xWorkQueue ) /* FREERTOS_SYSTEM_CALL */
+        {
+            TaskHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xWorkQueueGetWorkerTask( xWorkQueue );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xWorkQueueGetWorkerTask( xWorkQueue );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_WORK_QUEUES == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+        void MPU_vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+                                     WorkQueueStats_t * pxStats ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vWorkQueueGetStats( xWorkQueue, pxStats );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vWorkQueueGetStats( xWorkQueue, pxStats );
+            }
+        }
+    #endif /* if ( configUSE_WORK_QUEUES == 1 ) */
+/*-----------------------------------------------------------*/
+
 
 /* Functions that the application writer wants to execute in privileged mode
  * can be defined in application_defined_privileged_functions.h.  The functions
@@ -64,6 +64,7 @@ typedef unsigned long UBaseType_t;
 
 /* Hardware specifics. */
 #define portSTACK_GROWTH			( -1 )
+#define portSTACK_POINTER_SAVED_IN_TCB	( 0 )	/* Tasks run on their own threads, so pxTopOfStack is never updated. */
 #define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
 #define portINLINE __inline
 
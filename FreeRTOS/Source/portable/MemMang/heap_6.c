@@ -0,0 +1,873 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that uses a two
+ * level segregated fit (TLSF) allocator, so both execute in a bounded time
+ * that does not depend on the number of free blocks.  Like heap_5.c, the heap
+ * can be defined across multiple non-contiguous blocks of memory, and adjacent
+ * blocks are combined (coalesced) as they are freed.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ *
+ * Free blocks are held in a two dimensional array of lists.  The first level
+ * divides the sizes into powers of two, and the second level divides each power
+ * of two into heapSL_INDEX_COUNT equal ranges.  A bitmap records which lists
+ * are not empty, so the smallest list that is guaranteed to contain a large
+ * enough block is found with a couple of bit scans instead of a search.  Each
+ * block also records the block that precedes it in memory, so a block being
+ * freed is merged with its neighbours without walking a list.  The scheduler
+ * is suspended while the heap is updated, as it is by heap_4.c and heap_5.c,
+ * but only for a bounded time.
+ *
+ * Usage notes:
+ *
+ * vPortDefineHeapRegions() ***must*** be called before pvPortMalloc(), exactly
+ * as when heap_5.c is used.  pvPortMalloc() will be called if any task objects
+ * (tasks, queues, event groups, etc.) are created, therefore
+ * vPortDefineHeapRegions() ***must*** be called before any other objects are
+ * defined.
+ *
+ * vPortDefineHeapRegions() takes a single parameter.  The parameter is an array
+ * of HeapRegion_t structures.  HeapRegion_t is defined in portable.h as
+ *
+ * typedef struct HeapRegion
+ * {
+ *  uint8_t *pucStartAddress; << Start address of a block of memory that will be part of the heap.
+ *  size_t xSizeInBytes;      << Size of the block of memory.
+ * } HeapRegion_t;
+ *
+ * The array is terminated using a NULL zero sized region definition.  Unlike
+ * heap_5.c the regions do not need to appear in address order, but they must
+ * not overlap.  For example:
+ *
+ * HeapRegion_t xHeapRegions[] =
+ * {
+ *  { ( uint8_t * ) 0x80000000UL, 0x10000 }, << Defines a block of 0x10000 bytes starting at address 0x80000000
+ *  { ( uint8_t * ) 0x90000000UL, 0xa0000 }, << Defines a block of 0xa0000 bytes starting at address of 0x90000000
+ *  { NULL, 0 }                << Terminates the array.
+ * };
+ *
+ * vPortDefineHeapRegions( xHeapRegions ); << Pass the array into vPortDefineHeapRegions().
+ *
+ * A single block can be no larger than heapMAX_BLOCK_SIZE bytes, so any region
+ * larger than that is truncated.
+ *
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )         ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* MSB of the xBlockSize member of an BlockLink_t structure is used to track
+ * the allocation status of a block.  When MSB of the xBlockSize member of
+ * an BlockLink_t structure is set then the block belongs to the application.
+ * When the bit is free the block is still part of the free heap space. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_SIZE_IS_VALID( xBlockSize )    ( ( ( xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) == 0 )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
+#define heapBLOCK_SIZE( pxBlock )                ( ( pxBlock->xBlockSize ) & ~heapBLOCK_ALLOCATED_BITMASK )
+
+/* The block that follows pxBlock in memory. */
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock )       ( ( BlockLink_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/* Each power of two is divided into 2 ^ heapSL_INDEX_COUNT_LOG2 second level
+ * lists.  More lists waste less memory by rounding requests up to the bottom of
+ * the next list, but use more RAM for the list heads. */
+#define heapSL_INDEX_COUNT_LOG2    ( 4U )
+#define heapSL_INDEX_COUNT         ( 1U << heapSL_INDEX_COUNT_LOG2 )
+
+/* Every block size is a multiple of heapBLOCK_GRANULARITY.  Blocks smaller than
+ * heapSMALL_BLOCK_SIZE are held in lists that each hold a single size, and so
+ * share the first first level list. */
+#define heapALIGN_SIZE_LOG2        ( 3U )
+#define heapFL_INDEX_SHIFT         ( heapSL_INDEX_COUNT_LOG2 + heapALIGN_SIZE_LOG2 )
+#define heapSMALL_BLOCK_SIZE       ( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+#if ( portBYTE_ALIGNMENT > 8 )
+    #define heapBLOCK_GRANULARITY    ( ( size_t ) portBYTE_ALIGNMENT )
+#else
+    #define heapBLOCK_GRANULARITY    ( ( size_t ) 1 << heapALIGN_SIZE_LOG2 )
+#endif
+
+/* Blocks must be smaller than 2 ^ heapFL_INDEX_MAX bytes.  The bitmaps are 32
+ * bits, and the MSB of the size is used as the allocated bit. */
+#define heapFL_INDEX_MAX           ( ( sizeof( size_t ) >= 4U ) ? 31U : 15U )
+#define heapFL_INDEX_COUNT         ( heapFL_INDEX_MAX - heapFL_INDEX_SHIFT + 1U )
+#define heapMAX_BLOCK_SIZE         ( ( ( size_t ) 1 << heapFL_INDEX_MAX ) - heapBLOCK_GRANULARITY )
+
+/* Block sizes must not get too small - a free block must be able to hold the
+ * free list links. */
+#define heapMINIMUM_BLOCK_SIZE     ( ( sizeof( BlockLink_t ) + ( heapBLOCK_GRANULARITY - 1 ) ) & ~( heapBLOCK_GRANULARITY - 1 ) )
+
+/*-----------------------------------------------------------*/
+
+/* The header placed at the start of every block.  The free list links are only
+ * used while the block is free, and are overwritten by the application's data
+ * while it is allocated. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxPrevPhysicalBlock; /*<< The block before this one in memory, or NULL if this is the first block in its region. */
+    size_t xBlockSize;                         /*<< The size of the block, including its header. */
+    struct A_BLOCK_LINK * pxNextFreeBlock;     /*<< The next block in the same free list. */
+    struct A_BLOCK_LINK * pxPrevFreeBlock;     /*<< The previous block in the same free list. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the index of the most significant set bit in ulValue, which must not
+ * be zero.
+ */
+static UBaseType_t prvFindLastSet( uint32_t ulValue );
+
+/*
+ * Returns the index of the least significant set bit in ulValue, which must
+ * not be zero.
+ */
+static UBaseType_t prvFindFirstSet( uint32_t ulValue );
+
+/*
+ * Calculate the free list that holds blocks of xSize bytes.
+ */
+static void prvMappingInsert( size_t xSize,
+                              UBaseType_t * puxFLIndex,
+                              UBaseType_t * puxSLIndex );
+
+/*
+ * Find a non-empty free list, starting at the one selected by *puxFLIndex and
+ * *puxSLIndex, and return the first block in it.  Every block in the list
+ * selected on entry must be large enough.  *puxFLIndex and *puxSLIndex are
+ * updated to the list the block was found in.  Returns NULL if every suitable
+ * list is empty.
+ */
+static BlockLink_t * prvFindSuitableBlock( UBaseType_t * puxFLIndex,
+                                           UBaseType_t * puxSLIndex );
+
+/*
+ * Add a free block to, or remove a free block from, the free list that holds
+ * blocks of its size.
+ */
+static void prvInsertFreeBlock( BlockLink_t * pxBlock );
+static void prvRemoveFreeBlock( BlockLink_t * pxBlock,
+                                UBaseType_t uxFLIndex,
+                                UBaseType_t uxSLIndex );
+
+/*
+ * Merge a block that is being freed with the free blocks, if any, immediately
+ * before and after it in memory.  Returns the start of the merged block.
+ */
+static BlockLink_t * prvMergeWithNeighbours( BlockLink_t * pxBlock );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+ * block must by correctly byte aligned.  Only the members before the free list
+ * links are needed by an allocated block. */
+static const size_t xHeapStructSize = ( ( sizeof( BlockLink_t * ) + sizeof( size_t ) ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The free lists, and bitmaps that indicate which of them are not empty.  Bit n
+ * of ulFLBitmap is set if any bit of ulSLBitmaps[ n ] is set, and bit m of
+ * ulSLBitmaps[ n ] is set if pxFreeLists[ n ][ m ] is not empty. */
+static BlockLink_t * pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+static uint32_t ulFLBitmap = 0U;
+static uint32_t ulSLBitmaps[ heapFL_INDEX_COUNT ];
+
+/* Set once vPortDefineHeapRegions() has been called. */
+static BaseType_t xHeapHasBeenInitialised = pdFALSE;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, and the number of free blocks those bytes are
+ * divided into. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+static size_t xNumberOfFreeBlocks = 0;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+    UBaseType_t uxFLIndex, uxSLIndex;
+
+    /* The heap must be initialised before the first call to
+     * prvPortMalloc(). */
+    configASSERT( xHeapHasBeenInitialised != pdFALSE );
+
+    vTaskSuspendAll();
+    {
+        if( xWantedSize > 0 )
+        {
+            /* The wanted size must be increased so it can contain the block
+             * header in addition to the requested amount of bytes, then
+             * rounded up so every block is a multiple of the granularity. */
+            xAdditionalRequiredSize = xHeapStructSize + ( heapBLOCK_GRANULARITY - 1 );
+
+            if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+            {
+                xWantedSize = ( xWantedSize + xAdditionalRequiredSize ) & ~( heapBLOCK_GRANULARITY - 1 );
+
+                if( xWantedSize < heapMINIMUM_BLOCK_SIZE )
+                {
+                    xWantedSize = heapMINIMUM_BLOCK_SIZE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xWantedSize = 0;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Blocks larger than heapMAX_BLOCK_SIZE cannot exist, which also
+         * ensures the top bit of the size, which is used to determine who owns
+         * the block, is free. */
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= heapMAX_BLOCK_SIZE ) && ( xWantedSize <= xFreeBytesRemaining ) )
+        {
+            /* Round the size up to the start of the next free list, so every
+             * block in the list selected is large enough.  Sizes below
+             * heapSMALL_BLOCK_SIZE have a list of their own. */
+            if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+            {
+                prvMappingInsert( xWantedSize + ( ( ( size_t ) 1 << ( prvFindLastSet( ( uint32_t ) xWantedSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - 1 ), &uxFLIndex, &uxSLIndex );
+            }
+            else
+            {
+                prvMappingInsert( xWantedSize, &uxFLIndex, &uxSLIndex );
+            }
+
+            pxBlock = prvFindSuitableBlock( &uxFLIndex, &uxSLIndex );
+
+            if( pxBlock != NULL )
+            {
+                /* This block is being returned for use so must be taken out
+                 * of its free list. */
+                prvRemoveFreeBlock( pxBlock, uxFLIndex, uxSLIndex );
+
+                /* If the block is larger than required it can be split into
+                 * two. */
+                if( ( pxBlock->xBlockSize - xWantedSize ) >= heapMINIMUM_BLOCK_SIZE )
+                {
+                    /* This block is to be split into two.  Create a new
+                     * block following the number of bytes requested. The void
+                     * cast is used to prevent byte alignment warnings from the
+                     * compiler. */
+                    pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+
+                    /* Calculate the sizes of two blocks split from the
+                     * single block, and link the new block in between this
+                     * block and the one after it. */
+                    pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                    pxNewBlockLink->pxPrevPhysicalBlock = pxBlock;
+                    heapNEXT_PHYSICAL_BLOCK( pxNewBlockLink )->pxPrevPhysicalBlock = pxNewBlockLink;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    /* The block after the new block is allocated, otherwise it
+                     * would have been merged with the block being split, so the
+                     * new block can go straight into a free list. */
+                    prvInsertFreeBlock( pxNewBlockLink );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The block is being returned - it is allocated and owned by
+                 * the application.  Return the memory space pointed to -
+                 * jumping over the block header at its start. */
+                heapALLOCATE_BLOCK( pxBlock );
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                xNumberOfSuccessfulAllocations++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have a block header immediately before
+         * it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+
+        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        {
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                /* The block is still marked as allocated, so no other task
+                 * can merge with it while it is cleared. */
+                ( void ) memset( puc + xHeapStructSize, 0, heapBLOCK_SIZE( pxLink ) - xHeapStructSize );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                /* The block is being returned to the heap - it is no longer
+                 * allocated.  This must happen with the scheduler suspended,
+                 * as prvMergeWithNeighbours() relies on the allocated bit of
+                 * the neighbouring blocks. */
+                heapFREE_BLOCK( pxLink );
+
+                /* Add this block, merged with any free neighbours, to the free
+                 * lists. */
+                xFreeBytesRemaining += pxLink->xBlockSize;
+                traceFREE( pv, pxLink->xBlockSize );
+                prvInsertFreeBlock( prvMergeWithNeighbours( pxLink ) );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( uint32_t ulValue )
+{
+    UBaseType_t uxBit;
+
+    #if defined( __GNUC__ )
+    {
+        uxBit = ( UBaseType_t ) ( 31 - __builtin_clz( ulValue ) );
+    }
+    #else
+    {
+        /* A binary search, so the time taken does not depend on the value. */
+        uxBit = 0;
+
+        if( ( ulValue & 0xffff0000UL ) != 0UL )
+        {
+            ulValue >>= 16;
+            uxBit += 16;
+        }
+
+        if( ( ulValue & 0xff00UL ) != 0UL )
+        {
+            ulValue >>= 8;
+            uxBit += 8;
+        }
+
+        if( ( ulValue & 0xf0UL ) != 0UL )
+        {
+            ulValue >>= 4;
+            uxBit += 4;
+        }
+
+        if( ( ulValue & 0xcUL ) != 0UL )
+        {
+            ulValue >>= 2;
+            uxBit += 2;
+        }
+
+        if( ( ulValue & 0x2UL ) != 0UL )
+        {
+            uxBit += 1;
+        }
+    }
+    #endif /* if defined( __GNUC__ ) */
+
+    return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindFirstSet( uint32_t ulValue )
+{
+    /* Isolate the least significant set bit. */
+    return prvFindLastSet( ulValue & ( ~ulValue + 1UL ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xSize,
+                              UBaseType_t * puxFLIndex,
+                              UBaseType_t * puxSLIndex )
+{
+    UBaseType_t uxFLIndex, uxSLIndex;
+
+    if( xSize < heapSMALL_BLOCK_SIZE )
+    {
+        /* Small blocks share the first first level list, divided linearly. */
+        uxFLIndex = 0;
+        uxSLIndex = ( UBaseType_t ) ( xSize >> heapALIGN_SIZE_LOG2 );
+    }
+    else
+    {
+        /* The second level index is the heapSL_INDEX_COUNT_LOG2 bits below
+         * the most significant set bit. */
+        uxFLIndex = prvFindLastSet( ( uint32_t ) xSize );
+        uxSLIndex = ( UBaseType_t ) ( ( xSize >> ( uxFLIndex - heapSL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT );
+        uxFLIndex -= ( heapFL_INDEX_SHIFT - 1U );
+    }
+
+    *puxFLIndex = uxFLIndex;
+    *puxSLIndex = uxSLIndex;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvFindSuitableBlock( UBaseType_t * puxFLIndex,
+                                           UBaseType_t * puxSLIndex )
+{
+    UBaseType_t uxFLIndex = *puxFLIndex;
+    uint32_t ulSLMap, ulFLMap;
+    BlockLink_t * pxBlock = NULL;
+
+    /* Rounding up the size of a request close to heapMAX_BLOCK_SIZE can take
+     * it past the last list. */
+    if( uxFLIndex < heapFL_INDEX_COUNT )
+    {
+        /* Look for a non-empty list in the same first level list first. */
+        ulSLMap = ulSLBitmaps[ uxFLIndex ] & ( ~( uint32_t ) 0U << *puxSLIndex );
+
+        if( ulSLMap == 0UL )
+        {
+            /* There isn't one, so use the smallest non-empty list in the next
+             * larger first level list that has one. */
+            ulFLMap = ulFLBitmap & ( ~( uint32_t ) 0U << ( uxFLIndex + 1U ) );
+
+            if( ulFLMap != 0UL )
+            {
+                uxFLIndex = prvFindFirstSet( ulFLMap );
+                ulSLMap = ulSLBitmaps[ uxFLIndex ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulSLMap != 0UL )
+        {
+            *puxFLIndex = uxFLIndex;
+            *puxSLIndex = prvFindFirstSet( ulSLMap );
+            pxBlock = pxFreeLists[ uxFLIndex ][ *puxSLIndex ];
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockLink_t * pxBlock )
+{
+    UBaseType_t uxFLIndex, uxSLIndex;
+    BlockLink_t * pxHead;
+
+    prvMappingInsert( pxBlock->xBlockSize, &uxFLIndex, &uxSLIndex );
+
+    /* Add the block to the front of its list, and mark the list as not
+     * empty. */
+    pxHead = pxFreeLists[ uxFLIndex ][ uxSLIndex ];
+    pxBlock->pxNextFreeBlock = pxHead;
+    pxBlock->pxPrevFreeBlock = NULL;
+
+    if( pxHead != NULL )
+    {
+        pxHead->pxPrevFreeBlock = pxBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFLIndex ][ uxSLIndex ] = pxBlock;
+    ulFLBitmap |= ( ( uint32_t ) 1U << uxFLIndex );
+    ulSLBitmaps[ uxFLIndex ] |= ( ( uint32_t ) 1U << uxSLIndex );
+    xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockLink_t * pxBlock,
+                                UBaseType_t uxFLIndex,
+                                UBaseType_t uxSLIndex )
+{
+    BlockLink_t * const pxNext = pxBlock->pxNextFreeBlock;
+    BlockLink_t * const pxPrev = pxBlock->pxPrevFreeBlock;
+
+    if( pxNext != NULL )
+    {
+        pxNext->pxPrevFreeBlock = pxPrev;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxPrev != NULL )
+    {
+        pxPrev->pxNextFreeBlock = pxNext;
+    }
+    else
+    {
+        /* The block was at the head of its list. */
+        pxFreeLists[ uxFLIndex ][ uxSLIndex ] = pxNext;
+
+        if( pxNext == NULL )
+        {
+            /* The list is now empty. */
+            ulSLBitmaps[ uxFLIndex ] &= ~( ( uint32_t ) 1U << uxSLIndex );
+
+            if( ulSLBitmaps[ uxFLIndex ] == 0UL )
+            {
+                ulFLBitmap &= ~( ( uint32_t ) 1U << uxFLIndex );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    xNumberOfFreeBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvMergeWithNeighbours( BlockLink_t * pxBlock )
+{
+    BlockLink_t * pxNeighbour;
+    UBaseType_t uxFLIndex, uxSLIndex;
+
+    /* Is the block before this one in memory free?  The first block in a
+     * region has no block before it. */
+    pxNeighbour = pxBlock->pxPrevPhysicalBlock;
+
+    if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 ) )
+    {
+        prvMappingInsert( pxNeighbour->xBlockSize, &uxFLIndex, &uxSLIndex );
+        prvRemoveFreeBlock( pxNeighbour, uxFLIndex, uxSLIndex );
+        pxNeighbour->xBlockSize += pxBlock->xBlockSize;
+        pxBlock = pxNeighbour;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Is the block after this one in memory free?  The last block in a region
+     * is followed by a zero sized block that is marked as allocated. */
+    pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxBlock );
+
+    if( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 )
+    {
+        prvMappingInsert( pxNeighbour->xBlockSize, &uxFLIndex, &uxSLIndex );
+        prvRemoveFreeBlock( pxNeighbour, uxFLIndex, uxSLIndex );
+        pxBlock->xBlockSize += pxNeighbour->xBlockSize;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* The block after the merged block must point back to it. */
+    heapNEXT_PHYSICAL_BLOCK( pxBlock )->pxPrevPhysicalBlock = pxBlock;
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+    BlockLink_t * pxFirstFreeBlockInRegion;
+    BlockLink_t * pxEnd;
+    size_t xTotalRegionSize, xTotalHeapSize = 0;
+    BaseType_t xDefinedRegions = 0;
+    portPOINTER_SIZE_TYPE xAddress, xAlignedHeap;
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( xHeapHasBeenInitialised == pdFALSE );
+
+    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+    while( pxHeapRegion->xSizeInBytes > 0 )
+    {
+        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+        /* Ensure the heap region starts on a boundary that is a multiple of
+         * the block granularity, so every block is correctly aligned. */
+        xAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+
+        if( ( xAddress & ( heapBLOCK_GRANULARITY - 1 ) ) != 0 )
+        {
+            xAddress += ( heapBLOCK_GRANULARITY - 1 );
+            xAddress &= ~( ( portPOINTER_SIZE_TYPE ) heapBLOCK_GRANULARITY - 1 );
+
+            /* Adjust the size for the bytes lost to alignment. */
+            xTotalRegionSize -= ( size_t ) ( xAddress - ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress );
+        }
+
+        xAlignedHeap = xAddress;
+
+        /* A single block cannot be larger than heapMAX_BLOCK_SIZE.  The end
+         * marker takes xHeapStructSize bytes. */
+        if( xTotalRegionSize > ( heapMAX_BLOCK_SIZE + xHeapStructSize ) )
+        {
+            xTotalRegionSize = heapMAX_BLOCK_SIZE + xHeapStructSize;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* pxEnd marks the end of the region.  It is a zero sized block that is
+         * always allocated, so the last real block is never merged with the
+         * memory beyond the region. */
+        xAddress = xAlignedHeap + xTotalRegionSize;
+        xAddress -= xHeapStructSize;
+        xAddress &= ~( ( portPOINTER_SIZE_TYPE ) heapBLOCK_GRANULARITY - 1 );
+
+        /* Regions too small to hold a block are ignored. */
+        if( ( xAddress > xAlignedHeap ) && ( ( size_t ) ( xAddress - xAlignedHeap ) >= heapMINIMUM_BLOCK_SIZE ) )
+        {
+            /* To start with there is a single free block in this region that
+             * is sized to take up the entire heap region minus the space taken
+             * by the end marker. */
+            pxFirstFreeBlockInRegion = ( BlockLink_t * ) xAlignedHeap;
+            pxFirstFreeBlockInRegion->xBlockSize = ( size_t ) ( xAddress - xAlignedHeap );
+            pxFirstFreeBlockInRegion->pxPrevPhysicalBlock = NULL;
+
+            pxEnd = ( BlockLink_t * ) xAddress;
+            pxEnd->xBlockSize = 0;
+            pxEnd->pxPrevPhysicalBlock = pxFirstFreeBlockInRegion;
+            heapALLOCATE_BLOCK( pxEnd );
+
+            prvInsertFreeBlock( pxFirstFreeBlockInRegion );
+            xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Move onto the next HeapRegion_t structure. */
+        xDefinedRegions++;
+        pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+    }
+
+    xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+    xFreeBytesRemaining = xTotalHeapSize;
+    xHeapHasBeenInitialised = pdTRUE;
+
+    /* Check something was actually defined before it is accessed. */
+    configASSERT( xTotalHeapSize );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    UBaseType_t uxFLIndex, uxSLIndex;
+    size_t xBlocks, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        xBlocks = xNumberOfFreeBlocks;
+
+        if( ulFLBitmap != 0UL )
+        {
+            /* The largest free block is in the largest non-empty list, and
+             * the smallest in the smallest, so only those two lists need to be
+             * searched. */
+            uxFLIndex = prvFindLastSet( ulFLBitmap );
+            uxSLIndex = prvFindLastSet( ulSLBitmaps[ uxFLIndex ] );
+
+            for( pxBlock = pxFreeLists[ uxFLIndex ][ uxSLIndex ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( pxBlock->xBlockSize > xMaxSize )
+                {
+                    xMaxSize = pxBlock->xBlockSize;
+                }
+            }
+
+            uxFLIndex = prvFindFirstSet( ulFLBitmap );
+            uxSLIndex = prvFindFirstSet( ulSLBitmaps[ uxFLIndex ] );
+
+            for( pxBlock = pxFreeLists[ uxFLIndex ][ uxSLIndex ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( pxBlock->xBlockSize < xMinSize )
+                {
+                    xMinSize = pxBlock->xBlockSize;
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
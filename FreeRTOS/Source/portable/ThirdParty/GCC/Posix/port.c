@@ -48,11 +48,44 @@
 * stdio (printf() and friends) should be called from a single task
 * only or serialized with a FreeRTOS primitive such as a binary
 * semaphore or mutex.
+*
+* When configNUMBER_OF_CORES is greater than 1 each simulated core is a
+* slot held by the thread of the task running on it, so that many task
+* threads run at once.  A thread learns which core it holds when it is
+* resumed.  Other cores are interrupted with SIG_YIELD, and the kernel's
+* task and ISR locks are recursive spinlocks owned by a core.
+*
+* When configPOSIX_USE_UCONTEXT is 1 there are no task threads.  Every task
+* runs on the thread that started the scheduler, on its own FreeRTOS stack,
+* and a task switch is a swapcontext() from the context of one task to that
+* of the next, so it does not wait for the Linux scheduler to run another
+* thread.  Task switches are only made with all signals blocked, so the
+* signal mask saved and restored by swapcontext() is the same for every
+* task.  A task that blocks in a system call stops every task, as it would on
+* a single core.  The tick timer is one-shot and is re-armed by every tick
+* interrupt for the end of the next tick period, or sooner while ticks are
+* owed, so ticks delayed while signals were blocked are caught up one
+* interrupt at a time and the tick count follows the monotonic clock.
+*
+* When configUSE_TICKLESS_IDLE is 1 the idle task stops the tick timer when
+* every other task is blocked, arms it once for the time at which the next
+* task unblocks, and waits for it in sigwait() with signals blocked.  The tick
+* count is then stepped by the number of tick periods that passed on the
+* monotonic clock, and the tick timer restarted on the tick boundary it would
+* have kept to.  Nothing in the simulator other than a timeout can end an idle
+* period, so the process takes no signals and uses no CPU while it is idle.
+*
+* When configPOSIX_VIRTUAL_TIME is 1 there is no tick timer.  The tick count
+* only changes when the idle task finds every other task blocked, and
+* portSUPPRESS_TICKS_AND_SLEEP() then steps it straight to the time at which
+* the next task unblocks, so idle time takes no time at all.  Tasks are only
+* switched by the kernel calls they make, so a run always follows the same
+* schedule, but a task that waits for time to pass without blocking waits
+* forever, and tasks of equal priority are not time sliced.
 *----------------------------------------------------------*/
-#include "portmacro.h"
-
 #include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -61,6 +94,10 @@
 #include <sys/times.h>
 #include <time.h>
 
+#if ( configPOSIX_USE_UCONTEXT == 1 )
+    #include <ucontext.h>
+#endif
+
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "task.h"
@@ -68,15 +105,49 @@
 #include "utils/wait_for_event.h"
 /*-----------------------------------------------------------*/
 
+#if ( ( configPOSIX_VIRTUAL_TIME == 1 ) && ( configUSE_TICKLESS_IDLE == 0 ) )
+    #error configUSE_TICKLESS_IDLE must be 1 when configPOSIX_VIRTUAL_TIME is 1, as the idle task moves the tick count on.
+#endif
+/*-----------------------------------------------------------*/
+
 #define SIG_RESUME    SIGUSR1
 
+#if ( configNUMBER_OF_CORES > 1 )
+    #define SIG_YIELD    SIGUSR2
+#endif
+
+#if ( configPOSIX_USE_UCONTEXT == 1 )
+
+/* The shortest time between two tick interrupts while the tick count is
+ * behind the monotonic clock, leaving tasks unblocked by one tick time to run
+ * before the next. */
+    #define portMIN_TICK_INTERVAL_MICROSECONDS    ( portTICK_RATE_MICROSECONDS / 4U )
+#endif
+
+#if ( ( configUSE_TICKLESS_IDLE == 1 ) && ( configPOSIX_VIRTUAL_TIME == 0 ) )
+
+/* The longest idle period for which the tick is suppressed.  When no task is
+ * waiting for a timeout the idle task sleeps for this long, then sleeps
+ * again. */
+    #define portMAX_SUPPRESSED_TICKS    ( ( TickType_t ) configTICK_RATE_HZ * 60U )
+#endif
+
 typedef struct THREAD
 {
-    pthread_t pthread;
+    #if ( configPOSIX_USE_UCONTEXT == 1 )
+        ucontext_t xContext; /* Saved when the task is switched out. */
+    #else
+        pthread_t pthread;
+    #endif
     pdTASK_CODE pxCode;
     void * pvParams;
     BaseType_t xDying;
-    struct event * ev;
+    #if ( configPOSIX_USE_UCONTEXT == 0 )
+        struct event * ev;
+    #endif
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xCoreID; /* The simulated core the thread was last resumed on. */
+    #endif
 } Thread_t;
 
 /*
@@ -96,7 +167,34 @@ static pthread_once_t hSigSetupThread = PTHREAD_ONCE_INIT;
 static sigset_t xAllSignals;
 static sigset_t xSchedulerOriginalSignalMask;
 static pthread_t hMainThread = ( pthread_t ) NULL;
-static volatile portBASE_TYPE uxCriticalNesting;
+
+#if ( configPOSIX_USE_UCONTEXT == 1 )
+
+/* The context of xPortStartScheduler(), resumed by vPortEndScheduler(). */
+    static ucontext_t xSchedulerContext;
+
+/* The number of tick periods processed since the scheduler started. */
+    static uint64_t ullTicksProcessed = 0;
+#elif ( ( configUSE_TICKLESS_IDLE == 1 ) && ( configPOSIX_VIRTUAL_TIME == 0 ) )
+
+/* The time at which the last tick was processed, from which the time spent in
+ * a tickless idle period is measured. */
+    static uint64_t ullLastTickNs = 0;
+#endif
+
+#if ( configNUMBER_OF_CORES == 1 )
+    static volatile portBASE_TYPE uxCriticalNesting;
+#else
+    volatile UBaseType_t uxPortCriticalNestings[ configNUMBER_OF_CORES ] = { 0 };
+
+/* The core owning each of the kernel's locks (-1 if free), and the number of
+ * times the owner has taken it.  Indexed by portTASK_LOCK and portISR_LOCK. */
+    static BaseType_t xLockOwners[ 2 ] = { -1, -1 };
+    static UBaseType_t uxLockCounts[ 2 ] = { 0 };
+
+/* The Thread_t of the calling task thread, NULL in the main thread. */
+    static __thread Thread_t * pxThreadSelf = NULL;
+#endif
 /*-----------------------------------------------------------*/
 
 static portBASE_TYPE xSchedulerEnd = pdFALSE;
@@ -104,14 +202,28 @@ static portBASE_TYPE xSchedulerEnd = pdFALSE;
 
 static void prvSetupSignalsAndSchedulerPolicy( void );
 static void prvSetupTimerInterrupt( void );
-static void * prvWaitForStart( void * pvParams );
+#if ( configPOSIX_USE_UCONTEXT == 1 )
+    static void prvArmTickTimer( void );
+#endif
+#if ( ( configUSE_TICKLESS_IDLE == 1 ) && ( configPOSIX_VIRTUAL_TIME == 0 ) )
+    static void prvSetTickTimer( uint64_t ullDelayUs,
+                                 uint64_t ullIntervalUs );
+#endif
 static void prvSwitchThread( Thread_t * xThreadToResume,
                              Thread_t * xThreadToSuspend );
-static void prvSuspendSelf( Thread_t * thread );
-static void prvResumeThread( Thread_t * xThreadId );
+#if ( configPOSIX_USE_UCONTEXT == 1 )
+    static void prvStartTask( void );
+#else
+    static void * prvWaitForStart( void * pvParams );
+    static void prvSuspendSelf( Thread_t * thread );
+    static void prvResumeThread( Thread_t * xThreadId );
+#endif
 static void vPortSystemTickHandler( int sig );
 static void vPortStartFirstTask( void );
 static void prvPortYieldFromISR( void );
+#if ( configNUMBER_OF_CORES > 1 )
+    static void prvPortYieldHandler( int sig );
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvFatalError( const char * pcCall,
@@ -130,9 +242,12 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
                                         void * pvParameters )
 {
     Thread_t * thread;
-    pthread_attr_t xThreadAttributes;
     size_t ulStackSize;
-    int iRet;
+
+    #if ( configPOSIX_USE_UCONTEXT == 0 )
+        pthread_attr_t xThreadAttributes;
+        int iRet;
+    #endif
 
     ( void ) pthread_once( &hSigSetupThread, prvSetupSignalsAndSchedulerPolicy );
 
@@ -147,6 +262,25 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
     thread->pvParams = pvParameters;
     thread->xDying = pdFALSE;
 
+    #if ( configPOSIX_USE_UCONTEXT == 1 )
+    {
+        /* The task starts running on its own stack the first time it is
+         * switched to, with all signals blocked as a new thread would be. */
+        if( getcontext( &( thread->xContext ) ) == -1 )
+        {
+            prvFatalError( "getcontext", errno );
+        }
+
+        thread->xContext.uc_stack.ss_sp = pxEndOfStack;
+        thread->xContext.uc_stack.ss_size = ulStackSize;
+        thread->xContext.uc_link = NULL;
+        thread->xContext.uc_sigmask = xAllSignals;
+        makecontext( &( thread->xContext ), prvStartTask, 0 );
+
+        return pxTopOfStack;
+    }
+    #else /* configPOSIX_USE_UCONTEXT */
+
     pthread_attr_init( &xThreadAttributes );
     iRet = pthread_attr_setstack( &xThreadAttributes, pxEndOfStack, ulStackSize );
     if( iRet != 0 )
@@ -157,28 +291,81 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
 
     thread->ev = event_create();
 
-    vPortEnterCritical();
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        vPortEnterCritical();
 
-    iRet = pthread_create( &thread->pthread, &xThreadAttributes,
-                           prvWaitForStart, thread );
+        iRet = pthread_create( &thread->pthread, &xThreadAttributes,
+                               prvWaitForStart, thread );
 
-    if( iRet != 0 )
-    {
-        prvFatalError( "pthread_create", iRet );
+        if( iRet != 0 )
+        {
+            prvFatalError( "pthread_create", iRet );
+        }
+
+        vPortExitCritical();
     }
+    #else
+    {
+        portBASE_TYPE xMask;
+
+        /* The new thread must inherit a mask with all signals blocked, but
+         * the kernel's locks are not needed to create it. */
+        thread->xCoreID = 0;
+        xMask = xPortSetInterruptMask();
+
+        iRet = pthread_create( &thread->pthread, &xThreadAttributes,
+                               prvWaitForStart, thread );
+
+        if( iRet != 0 )
+        {
+            prvFatalError( "pthread_create", iRet );
+        }
 
-    vPortExitCritical();
+        vPortClearInterruptMask( xMask );
+    }
+    #endif /* configNUMBER_OF_CORES */
 
     return pxTopOfStack;
+    #endif /* configPOSIX_USE_UCONTEXT */
 }
 /*-----------------------------------------------------------*/
 
 void vPortStartFirstTask( void )
 {
-    Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
-    /* Start the first task. */
-    prvResumeThread( pxFirstThread );
+        /* Start the first task. */
+        #if ( configPOSIX_USE_UCONTEXT == 1 )
+        {
+            /* Returns when vPortEndScheduler() switches back. */
+            if( swapcontext( &xSchedulerContext, &( pxFirstThread->xContext ) ) == -1 )
+            {
+                prvFatalError( "swapcontext", errno );
+            }
+        }
+        #else
+        {
+            prvResumeThread( pxFirstThread );
+        }
+        #endif
+    }
+    #else
+    {
+        Thread_t * pxFirstThread;
+        BaseType_t xCoreID;
+
+        /* Start the first task on each core. */
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+            pxFirstThread->xCoreID = xCoreID;
+            prvResumeThread( pxFirstThread );
+        }
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -208,7 +395,8 @@ portBASE_TYPE xPortStartScheduler( void )
     /* Start the first task. */
     vPortStartFirstTask();
 
-    /* Wait until signaled by vPortEndScheduler(). */
+    /* Wait until signaled by vPortEndScheduler().  When the tasks run on this
+     * thread the scheduler has already ended. */
     while( xSchedulerEnd != pdTRUE )
     {
         sigwait( &xSignals, &iSignal );
@@ -216,7 +404,18 @@ portBASE_TYPE xPortStartScheduler( void )
 
     /* Cancel the Idle task and free its resources */
     #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
-        vPortCancelThread( xTaskGetIdleTaskHandle() );
+        #if ( configNUMBER_OF_CORES == 1 )
+            vPortCancelThread( xTaskGetIdleTaskHandle() );
+        #else
+        {
+            BaseType_t xCoreID;
+
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                vPortCancelThread( xTaskGetIdleTaskHandleForCore( xCoreID ) );
+            }
+        }
+        #endif /* configNUMBER_OF_CORES */
     #endif
 
     #if ( configUSE_TIMERS == 1 )
@@ -253,34 +452,68 @@ void vPortEndScheduler( void )
 
     /* Signal the scheduler to exit its loop. */
     xSchedulerEnd = pdTRUE;
-    ( void ) pthread_kill( hMainThread, SIG_RESUME );
 
     xCurrentThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
-    prvSuspendSelf( xCurrentThread );
+
+    #if ( configPOSIX_USE_UCONTEXT == 1 )
+    {
+        /* Return to xPortStartScheduler().  The task is never resumed. */
+        if( swapcontext( &( xCurrentThread->xContext ), &xSchedulerContext ) == -1 )
+        {
+            prvFatalError( "swapcontext", errno );
+        }
+    }
+    #else
+    {
+        ( void ) pthread_kill( hMainThread, SIG_RESUME );
+
+        prvSuspendSelf( xCurrentThread );
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
-void vPortEnterCritical( void )
-{
-    if( uxCriticalNesting == 0 )
+#if ( configNUMBER_OF_CORES == 1 )
+
+    void vPortEnterCritical( void )
     {
-        vPortDisableInterrupts();
+        if( uxCriticalNesting == 0 )
+        {
+            vPortDisableInterrupts();
+
+            #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+            {
+                vTaskRecordCriticalEntry();
+            }
+            #endif
+        }
+
+        uxCriticalNesting++;
     }
 
-    uxCriticalNesting++;
-}
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
-void vPortExitCritical( void )
-{
-    uxCriticalNesting--;
+#if ( configNUMBER_OF_CORES == 1 )
 
-    /* If we have reached 0 then re-enable the interrupts. */
-    if( uxCriticalNesting == 0 )
+    void vPortExitCritical( void )
     {
-        vPortEnableInterrupts();
+        uxCriticalNesting--;
+
+        /* If we have reached 0 then re-enable the interrupts. */
+        if( uxCriticalNesting == 0 )
+        {
+            #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+            {
+                vTaskRecordCriticalExit();
+            }
+            #endif
+
+            vPortEnableInterrupts();
+        }
     }
-}
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 static void prvPortYieldFromISR( void )
@@ -288,11 +521,29 @@ static void prvPortYieldFromISR( void )
     Thread_t * xThreadToSuspend;
     Thread_t * xThreadToResume;
 
-    xThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        xThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
-    vTaskSwitchContext();
+        vTaskSwitchContext();
 
-    xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+        xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    }
+    #else
+    {
+        /* Read the core once - as soon as the context switch has selected a
+         * new task this thread can be resumed on another core, which updates
+         * its xCoreID. */
+        BaseType_t xCoreID = portGET_CORE_ID();
+
+        xThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+
+        vTaskSwitchContext( xCoreID );
+
+        xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+        xThreadToResume->xCoreID = xCoreID;
+    }
+    #endif /* configNUMBER_OF_CORES */
 
     prvSwitchThread( xThreadToResume, xThreadToSuspend );
 }
@@ -300,11 +551,27 @@ static void prvPortYieldFromISR( void )
 
 void vPortYield( void )
 {
-    vPortEnterCritical();
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        vPortEnterCritical();
+
+        prvPortYieldFromISR();
+
+        vPortExitCritical();
+    }
+    #else
+    {
+        portBASE_TYPE xMask;
 
-    prvPortYieldFromISR();
+        /* The kernel only yields outside of critical sections, so only the
+         * signals need masking while the context switch is performed. */
+        xMask = xPortSetInterruptMask();
 
-    vPortExitCritical();
+        prvPortYieldFromISR();
+
+        vPortClearInterruptMask( xMask );
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -322,18 +589,128 @@ void vPortEnableInterrupts( void )
 
 portBASE_TYPE xPortSetInterruptMask( void )
 {
-    /* Interrupts are always disabled inside ISRs (signals
-     * handlers). */
-    return pdTRUE;
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* Interrupts are always disabled inside ISRs (signals
+         * handlers). */
+        return pdTRUE;
+    }
+    #else
+    {
+        sigset_t xPreviousSignals;
+
+        /* Also used from task code in a multi-core build, so report whether
+         * interrupts were already disabled. */
+        ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignals );
+
+        return ( sigismember( &xPreviousSignals, SIGALRM ) == 1 ) ? pdTRUE : pdFALSE;
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
 void vPortClearInterruptMask( portBASE_TYPE xMask )
 {
-    ( void ) xMask;
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        ( void ) xMask;
+    }
+    #else
+    {
+        if( xMask == pdFALSE )
+        {
+            vPortEnableInterrupts();
+        }
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+    BaseType_t xPortGetCoreID( void )
+    {
+        BaseType_t xCoreID = 0;
+
+        /* The main thread starts the scheduler as core 0. */
+        if( pxThreadSelf != NULL )
+        {
+            xCoreID = pxThreadSelf->xCoreID;
+        }
+
+        return xCoreID;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vPortYieldCore( BaseType_t xCoreID )
+    {
+        Thread_t * pxThread;
+
+        /* Called with the ISR lock held, so the task on the core cannot
+         * change.  If that task is switched out before the signal is delivered
+         * the signal is taken when it next runs, which only costs an
+         * unnecessary reschedule. */
+        pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+        ( void ) pthread_kill( pxThread->pthread, SIG_YIELD );
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vPortGetLock( BaseType_t xLock )
+    {
+        BaseType_t xCoreID = portGET_CORE_ID();
+        BaseType_t xFree;
+
+        /* The locks are recursive - only spin if another core owns it. */
+        if( __atomic_load_n( &xLockOwners[ xLock ], __ATOMIC_ACQUIRE ) != xCoreID )
+        {
+            for( ; ; )
+            {
+                xFree = -1;
+
+                if( __atomic_compare_exchange_n( &xLockOwners[ xLock ], &xFree, xCoreID,
+                                                 pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+                {
+                    break;
+                }
+
+                /* The owner is another thread of this process, so give it the
+                 * processor rather than burning the time slice. */
+                ( void ) sched_yield();
+            }
+        }
+
+        uxLockCounts[ xLock ]++;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vPortReleaseLock( BaseType_t xLock )
+    {
+        configASSERT( xLockOwners[ xLock ] == portGET_CORE_ID() );
+        configASSERT( uxLockCounts[ xLock ] > 0U );
+
+        uxLockCounts[ xLock ]--;
+
+        if( uxLockCounts[ xLock ] == 0U )
+        {
+            __atomic_store_n( &xLockOwners[ xLock ], -1, __ATOMIC_RELEASE );
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 static uint64_t prvGetTimeNs( void )
 {
     struct timespec t;
@@ -366,24 +743,84 @@ void prvSetupTimerInterrupt( void )
         prvFatalError( "getitimer", errno );
     }
 
-    /* Set the interval between timer events. */
-    itimer.it_interval.tv_sec = 0;
-    itimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+    #if ( configPOSIX_VIRTUAL_TIME == 1 )
+    {
+        /* The tick count is only moved on by vPortSuppressTicksAndSleep(). */
+        prvStartTimeNs = prvGetTimeNs();
+    }
+    #elif ( configPOSIX_USE_UCONTEXT == 1 )
+    {
+        /* Every tick interrupt arms the next. */
+        prvStartTimeNs = prvGetTimeNs();
+        prvArmTickTimer();
+    }
+    #else
+    {
+        /* Set the interval between timer events. */
+        itimer.it_interval.tv_sec = 0;
+        itimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
 
-    /* Set the current count-down. */
-    itimer.it_value.tv_sec = 0;
-    itimer.it_value.tv_usec = portTICK_RATE_MICROSECONDS;
+        /* Set the current count-down. */
+        itimer.it_value.tv_sec = 0;
+        itimer.it_value.tv_usec = portTICK_RATE_MICROSECONDS;
 
-    /* Set-up the timer interrupt. */
-    iRet = setitimer( ITIMER_REAL, &itimer, NULL );
+        /* Set-up the timer interrupt. */
+        iRet = setitimer( ITIMER_REAL, &itimer, NULL );
 
-    if( iRet == -1 )
+        if( iRet == -1 )
+        {
+            prvFatalError( "setitimer", errno );
+        }
+
+        prvStartTimeNs = prvGetTimeNs();
+
+        #if ( configUSE_TICKLESS_IDLE == 1 )
+        {
+            ullLastTickNs = prvStartTimeNs;
+        }
+        #endif
+    }
+    #endif /* configPOSIX_USE_UCONTEXT */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configPOSIX_USE_UCONTEXT == 1 )
+
+    static void prvArmTickTimer( void )
     {
-        prvFatalError( "setitimer", errno );
+        struct itimerval itimer;
+        uint64_t ullNextTickNs;
+        uint64_t ullNowNs;
+        uint64_t ullDelayUs;
+
+        /* The next tick is due at the end of the tick period after the last
+         * one processed.  If that has already passed, because signals were
+         * blocked or the process was not running, fire again shortly so the
+         * missed ticks are processed one per interrupt. */
+        ullNextTickNs = prvStartTimeNs + ( ( ullTicksProcessed + 1ULL ) * portTICK_RATE_MICROSECONDS * 1000ULL );
+        ullNowNs = prvGetTimeNs();
+
+        if( ullNextTickNs > ( ullNowNs + ( portMIN_TICK_INTERVAL_MICROSECONDS * 1000ULL ) ) )
+        {
+            ullDelayUs = ( ullNextTickNs - ullNowNs ) / 1000ULL;
+        }
+        else
+        {
+            ullDelayUs = portMIN_TICK_INTERVAL_MICROSECONDS;
+        }
+
+        itimer.it_interval.tv_sec = 0;
+        itimer.it_interval.tv_usec = 0;
+        itimer.it_value.tv_sec = ( time_t ) ( ullDelayUs / 1000000ULL );
+        itimer.it_value.tv_usec = ( suseconds_t ) ( ullDelayUs % 1000000ULL );
+
+        if( setitimer( ITIMER_REAL, &itimer, NULL ) == -1 )
+        {
+            prvFatalError( "setitimer", errno );
+        }
     }
 
-    prvStartTimeNs = prvGetTimeNs();
-}
+#endif /* configPOSIX_USE_UCONTEXT */
 /*-----------------------------------------------------------*/
 
 static void vPortSystemTickHandler( int sig )
@@ -395,12 +832,48 @@ static void vPortSystemTickHandler( int sig )
 
 /* uint64_t xExpectedTicks; */
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        BaseType_t xSwitchRequired;
+
+        ( void ) pxThreadToSuspend;
+        ( void ) pxThreadToResume;
+
+        /* The tick is taken by whichever core has signals unblocked.  Other
+         * cores that need to reschedule are sent SIG_YIELD by the kernel. */
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            xSwitchRequired = xTaskIncrementTick();
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        #if ( configUSE_PREEMPTION == 1 )
+            if( xSwitchRequired != pdFALSE )
+            {
+                prvPortYieldFromISR();
+            }
+        #else
+            ( void ) xSwitchRequired;
+        #endif
+    }
+    #else /* configNUMBER_OF_CORES */
     uxCriticalNesting++; /* Signals are blocked in this signal handler. */
 
     #if ( configUSE_PREEMPTION == 1 )
         pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
     #endif
 
+    #if ( configPOSIX_USE_UCONTEXT == 1 )
+    {
+        /* Exactly one tick per interrupt, then arm the timer for the next,
+         * which fires early if the tick count is behind the clock. */
+        xTaskIncrementTick();
+        ullTicksProcessed++;
+        prvArmTickTimer();
+    }
+    #else /* configPOSIX_USE_UCONTEXT */
+
     /* Tick Increment, accounting for any lost signals or drift in
      * the timer. */
 
@@ -411,9 +884,16 @@ static void vPortSystemTickHandler( int sig )
  * do { */
     xTaskIncrementTick();
 
+    #if ( ( configUSE_TICKLESS_IDLE == 1 ) && ( configPOSIX_VIRTUAL_TIME == 0 ) )
+    {
+        ullLastTickNs = prvGetTimeNs();
+    }
+    #endif
+
 /*        prvTickCount++;
  *    } while (prvTickCount < xExpectedTicks);
  */
+    #endif /* configPOSIX_USE_UCONTEXT */
 
     #if ( configUSE_PREEMPTION == 1 )
         /* Select Next Task. */
@@ -425,9 +905,25 @@ static void vPortSystemTickHandler( int sig )
     #endif
 
     uxCriticalNesting--;
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvPortYieldHandler( int sig )
+    {
+        ( void ) sig;
+
+        /* Another core asked this core to reschedule.  Signals are only
+         * unblocked outside of critical sections, so the switch can be
+         * performed immediately. */
+        prvPortYieldFromISR();
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 void vPortThreadDying( void * pxTaskToDelete,
                        volatile BaseType_t * pxPendYield )
 {
@@ -442,43 +938,85 @@ void vPortCancelThread( void * pxTaskToDelete )
 {
     Thread_t * pxThreadToCancel = prvGetThreadFromTask( pxTaskToDelete );
 
-    /*
-     * The thread has already been suspended so it can be safely cancelled.
-     */
-    pthread_cancel( pxThreadToCancel->pthread );
-    pthread_join( pxThreadToCancel->pthread, NULL );
-    event_delete( pxThreadToCancel->ev );
+    #if ( configPOSIX_USE_UCONTEXT == 1 )
+    {
+        /* The task is not running, and has no thread, so freeing its stack
+         * is all that is needed. */
+        ( void ) pxThreadToCancel;
+    }
+    #else
+    {
+        /*
+         * The thread has already been suspended so it can be safely cancelled.
+         */
+        pthread_cancel( pxThreadToCancel->pthread );
+        pthread_join( pxThreadToCancel->pthread, NULL );
+        event_delete( pxThreadToCancel->ev );
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
-static void * prvWaitForStart( void * pvParams )
-{
-    Thread_t * pxThread = pvParams;
+#if ( configPOSIX_USE_UCONTEXT == 1 )
 
-    prvSuspendSelf( pxThread );
+    static void prvStartTask( void )
+    {
+        Thread_t * pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
-    /* Resumed for the first time, unblocks all signals. */
-    uxCriticalNesting = 0;
-    vPortEnableInterrupts();
+        /* Switched to for the first time, unblocks all signals. */
+        uxCriticalNesting = 0;
+        vPortEnableInterrupts();
 
-    /* Call the task's entry point. */
-    pxThread->pxCode( pxThread->pvParams );
+        /* Call the task's entry point. */
+        pxThread->pxCode( pxThread->pvParams );
 
-    /* A function that implements a task must not exit or attempt to return to
-     * its caller as there is nothing to return to. If a task wants to exit it
-     * should instead call vTaskDelete( NULL ). Artificially force an assert()
-     * to be triggered if configASSERT() is defined, so application writers can
-     * catch the error. */
-    configASSERT( pdFALSE );
+        /* A function that implements a task must not exit or attempt to return
+         * to its caller as there is nothing to return to. */
+        configASSERT( pdFALSE );
+    }
 
-    return NULL;
-}
+#else /* configPOSIX_USE_UCONTEXT */
+
+    static void * prvWaitForStart( void * pvParams )
+    {
+        Thread_t * pxThread = pvParams;
+
+        #if ( configNUMBER_OF_CORES > 1 )
+            pxThreadSelf = pxThread;
+        #endif
+
+        prvSuspendSelf( pxThread );
+
+        /* Resumed for the first time, unblocks all signals. */
+        #if ( configNUMBER_OF_CORES == 1 )
+            uxCriticalNesting = 0;
+        #else
+            portSET_CRITICAL_NESTING_COUNT( 0 );
+        #endif
+        vPortEnableInterrupts();
+
+        /* Call the task's entry point. */
+        pxThread->pxCode( pxThread->pvParams );
+
+        /* A function that implements a task must not exit or attempt to return to
+         * its caller as there is nothing to return to. If a task wants to exit it
+         * should instead call vTaskDelete( NULL ). Artificially force an assert()
+         * to be triggered if configASSERT() is defined, so application writers can
+         * catch the error. */
+        configASSERT( pdFALSE );
+
+        return NULL;
+    }
+
+#endif /* configPOSIX_USE_UCONTEXT */
 /*-----------------------------------------------------------*/
 
 static void prvSwitchThread( Thread_t * pxThreadToResume,
                              Thread_t * pxThreadToSuspend )
 {
-    BaseType_t uxSavedCriticalNesting;
+    #if ( configNUMBER_OF_CORES == 1 )
+        BaseType_t uxSavedCriticalNesting;
+    #endif
 
     if( pxThreadToSuspend != pxThreadToResume )
     {
@@ -487,51 +1025,75 @@ static void prvSwitchThread( Thread_t * pxThreadToResume,
          *
          * The critical section nesting is per-task, so save it on the
          * stack of the current (suspending thread), restoring it when
-         * we switch back to this task.
+         * we switch back to this task.  In a multi-core build the kernel
+         * only switches context with a nesting count of zero, so there is
+         * nothing to save - and the core this thread resumes on may not be
+         * the one it is leaving.
          */
-        uxSavedCriticalNesting = uxCriticalNesting;
-
-        prvResumeThread( pxThreadToResume );
+        #if ( configNUMBER_OF_CORES == 1 )
+            uxSavedCriticalNesting = uxCriticalNesting;
+        #endif
 
-        if( pxThreadToSuspend->xDying == pdTRUE )
+        #if ( configPOSIX_USE_UCONTEXT == 1 )
         {
-            pthread_exit( NULL );
+            /* A dying task is never switched back to, so its stack can be
+             * freed once another task is running. */
+            if( swapcontext( &( pxThreadToSuspend->xContext ), &( pxThreadToResume->xContext ) ) == -1 )
+            {
+                prvFatalError( "swapcontext", errno );
+            }
         }
+        #else
+        {
+            prvResumeThread( pxThreadToResume );
 
-        prvSuspendSelf( pxThreadToSuspend );
+            if( pxThreadToSuspend->xDying == pdTRUE )
+            {
+                pthread_exit( NULL );
+            }
 
-        uxCriticalNesting = uxSavedCriticalNesting;
+            prvSuspendSelf( pxThreadToSuspend );
+        }
+        #endif /* configPOSIX_USE_UCONTEXT */
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            uxCriticalNesting = uxSavedCriticalNesting;
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
 
-static void prvSuspendSelf( Thread_t * thread )
-{
-    /*
-     * Suspend this thread by waiting for a pthread_cond_signal event.
-     *
-     * A suspended thread must not handle signals (interrupts) so
-     * all signals must be blocked by calling this from:
-     *
-     * - Inside a critical section (vPortEnterCritical() /
-     *   vPortExitCritical()).
-     *
-     * - From a signal handler that has all signals masked.
-     *
-     * - A thread with all signals blocked with pthread_sigmask().
-     */
-    event_wait( thread->ev );
-}
+#if ( configPOSIX_USE_UCONTEXT == 0 )
+
+    static void prvSuspendSelf( Thread_t * thread )
+    {
+        /*
+         * Suspend this thread by waiting for a pthread_cond_signal event.
+         *
+         * A suspended thread must not handle signals (interrupts) so
+         * all signals must be blocked by calling this from:
+         *
+         * - Inside a critical section (vPortEnterCritical() /
+         *   vPortExitCritical()).
+         *
+         * - From a signal handler that has all signals masked.
+         *
+         * - A thread with all signals blocked with pthread_sigmask().
+         */
+        event_wait( thread->ev );
+    }
 
 /*-----------------------------------------------------------*/
 
-static void prvResumeThread( Thread_t * xThreadId )
-{
-    if( pthread_self() != xThreadId->pthread )
+    static void prvResumeThread( Thread_t * xThreadId )
     {
-        event_signal( xThreadId->ev );
+        if( pthread_self() != xThreadId->pthread )
+        {
+            event_signal( xThreadId->ev );
+        }
     }
-}
+
+#endif /* configPOSIX_USE_UCONTEXT */
 /*-----------------------------------------------------------*/
 
 static void prvSetupSignalsAndSchedulerPolicy( void )
@@ -569,9 +1131,167 @@ static void prvSetupSignalsAndSchedulerPolicy( void )
     {
         prvFatalError( "sigaction", errno );
     }
+
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        struct sigaction sigyield;
+
+        sigyield.sa_flags = 0;
+        sigyield.sa_handler = prvPortYieldHandler;
+        sigfillset( &sigyield.sa_mask );
+
+        iRet = sigaction( SIG_YIELD, &sigyield, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
+#if ( configPOSIX_VIRTUAL_TIME == 1 )
+
+    void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+    {
+        struct timespec xSleepTime;
+
+        /* Called by the idle task, with the scheduler suspended, when no other
+         * task can run.  Without a tick interrupt only a timeout can end the
+         * idle period, so the tick count is moved straight to the next one. */
+        if( ( xTaskGetTickCount() + xExpectedIdleTime ) != portMAX_DELAY )
+        {
+            vTaskStepTick( xExpectedIdleTime );
+        }
+        else
+        {
+            /* No task has a timeout, so nothing in the kernel can end the
+             * idle period.  Sleep for a tick period rather than spin. */
+            xSleepTime.tv_sec = 0;
+            xSleepTime.tv_nsec = ( long ) portTICK_RATE_MICROSECONDS * 1000L;
+            ( void ) nanosleep( &xSleepTime, NULL );
+        }
+    }
+
+#elif ( configUSE_TICKLESS_IDLE == 1 )
+
+    void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+    {
+        const uint64_t ullTickPeriodNs = ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL;
+        TickType_t xModifiableIdleTime, xCompleteTickPeriods = 0;
+        uint64_t ullLastTickBoundaryNs, ullNowNs, ullNextTickNs;
+        sigset_t xTickSignal;
+        int iSignal;
+
+        if( xExpectedIdleTime > portMAX_SUPPRESSED_TICKS )
+        {
+            xExpectedIdleTime = portMAX_SUPPRESSED_TICKS;
+        }
+
+        /* Stop the tick timer with signals blocked.  A tick that is already
+         * pending is then either taken by the tick handler when the sleep is
+         * abandoned, or ends the sleep at once and is counted below. */
+        vPortDisableInterrupts();
+        prvSetTickTimer( 0, 0 );
+
+        #if ( configPOSIX_USE_UCONTEXT == 1 )
+            ullLastTickBoundaryNs = prvStartTimeNs + ( ullTicksProcessed * ullTickPeriodNs );
+        #else
+            ullLastTickBoundaryNs = ullLastTickNs;
+        #endif
+
+        if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+        {
+            /* A task was readied, or a context switch pended, since the idle
+             * task decided to sleep.  Restart the tick timer from where it
+             * was stopped. */
+            xModifiableIdleTime = 0;
+        }
+        else
+        {
+            xModifiableIdleTime = xExpectedIdleTime;
+            configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+
+            if( xModifiableIdleTime > 0 )
+            {
+                /* Arm the timer once, for the end of the last tick period of
+                 * the idle time, and wait for it to fire. */
+                ullNextTickNs = ullLastTickBoundaryNs + ( ( uint64_t ) xModifiableIdleTime * ullTickPeriodNs );
+                ullNowNs = prvGetTimeNs();
+                prvSetTickTimer( ( ullNextTickNs > ullNowNs ) ? ( ( ullNextTickNs - ullNowNs ) / 1000ULL ) : 1ULL, 0 );
+
+                sigemptyset( &xTickSignal );
+                sigaddset( &xTickSignal, SIGALRM );
+                ( void ) sigwait( &xTickSignal, &iSignal );
+            }
+
+            configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+            /* Count the tick periods that have passed on the clock, which may
+             * be more than were asked for if the process was not run on time.
+             * vTaskStepTick() cannot move the tick count past the time at
+             * which the next task unblocks, so any further periods are left
+             * for the tick timer to catch up on or to drop, as it does for
+             * ticks missed while the scheduler runs. */
+            xCompleteTickPeriods = ( TickType_t ) ( ( prvGetTimeNs() - ullLastTickBoundaryNs ) / ullTickPeriodNs );
+
+            if( xCompleteTickPeriods > xExpectedIdleTime )
+            {
+                xCompleteTickPeriods = xExpectedIdleTime;
+            }
+
+            ullLastTickBoundaryNs += ( uint64_t ) xCompleteTickPeriods * ullTickPeriodNs;
+        }
+
+        /* Restart the tick timer on the tick boundary it kept to before the
+         * idle period. */
+        #if ( configPOSIX_USE_UCONTEXT == 1 )
+        {
+            ullTicksProcessed += xCompleteTickPeriods;
+            prvArmTickTimer();
+        }
+        #else
+        {
+            ullLastTickNs = ullLastTickBoundaryNs;
+            ullNextTickNs = ullLastTickBoundaryNs + ullTickPeriodNs;
+            ullNowNs = prvGetTimeNs();
+            prvSetTickTimer( ( ullNextTickNs > ullNowNs ) ? ( ( ullNextTickNs - ullNowNs ) / 1000ULL ) : 1ULL, portTICK_RATE_MICROSECONDS );
+        }
+        #endif
+
+        vPortEnableInterrupts();
+
+        /* vTaskStepTick() enters a critical section, which would unblock
+         * signals again on exit, so is called once they are unblocked.  The
+         * scheduler is still suspended, so a tick taken first is held
+         * pending until the ticks stepped here have been counted. */
+        if( xCompleteTickPeriods > 0 )
+        {
+            vTaskStepTick( xCompleteTickPeriods );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSetTickTimer( uint64_t ullDelayUs,
+                                 uint64_t ullIntervalUs )
+    {
+        struct itimerval itimer;
+
+        itimer.it_interval.tv_sec = ( time_t ) ( ullIntervalUs / 1000000ULL );
+        itimer.it_interval.tv_usec = ( suseconds_t ) ( ullIntervalUs % 1000000ULL );
+        itimer.it_value.tv_sec = ( time_t ) ( ullDelayUs / 1000000ULL );
+        itimer.it_value.tv_usec = ( suseconds_t ) ( ullDelayUs % 1000000ULL );
+
+        if( setitimer( ITIMER_REAL, &itimer, NULL ) == -1 )
+        {
+            prvFatalError( "setitimer", errno );
+        }
+    }
+
+#endif /* configPOSIX_VIRTUAL_TIME */
+/*-----------------------------------------------------------*/
+
 unsigned long ulPortGetRunTime( void )
 {
     struct tms xTimes;
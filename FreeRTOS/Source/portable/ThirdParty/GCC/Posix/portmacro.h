@@ -67,9 +67,41 @@ typedef unsigned long TickType_t;
 
 /*-----------------------------------------------------------*/
 
+/* Set configPOSIX_USE_UCONTEXT to 1 in FreeRTOSConfig.h to run every task on
+ * the thread that starts the scheduler, switching between tasks with
+ * swapcontext() rather than by waking one thread per task. */
+#ifndef configPOSIX_USE_UCONTEXT
+	#define configPOSIX_USE_UCONTEXT	0
+#endif
+
+#if ( ( configPOSIX_USE_UCONTEXT == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+	#error configPOSIX_USE_UCONTEXT can only be 1 when configNUMBER_OF_CORES is 1, as every simulated core needs its own thread.
+#endif
+
+/* Set configPOSIX_VIRTUAL_TIME to 1 in FreeRTOSConfig.h to stop the tick
+ * following the wall clock.  Time then only passes when every task is
+ * blocked, at which point the idle task moves the tick count straight to the
+ * time at which the next task unblocks.  configUSE_TICKLESS_IDLE must also be
+ * 1. */
+#ifndef configPOSIX_VIRTUAL_TIME
+	#define configPOSIX_VIRTUAL_TIME	0
+#endif
+
+/* Tickless idle.  The tick is suppressed when configUSE_TICKLESS_IDLE is 1,
+ * whether or not configPOSIX_VIRTUAL_TIME is 1. */
+extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+
+#if ( configPOSIX_VIRTUAL_TIME == 1 )
+	/* No timer has to be programmed, so even a single idle tick is skipped. */
+	#define portMIN_EXPECTED_IDLE_TIME_BEFORE_SLEEP	1
+#endif
+/*-----------------------------------------------------------*/
+
 /* Architecture specifics. */
 #define portSTACK_GROWTH			( -1 )
 #define portHAS_STACK_OVERFLOW_CHECKING	( 1 )
+#define portSTACK_POINTER_SAVED_IN_TCB	( 0 )	/* Tasks run on their own threads or contexts, so pxTopOfStack is never updated. */
 #define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
 #define portTICK_RATE_MICROSECONDS	( ( portTickType ) 1000000 / configTICK_RATE_HZ )
 #define portBYTE_ALIGNMENT			8
@@ -87,12 +119,14 @@ extern void vPortYield( void );
 /* Critical section management. */
 extern void vPortDisableInterrupts( void );
 extern void vPortEnableInterrupts( void );
-#define portSET_INTERRUPT_MASK()        ( vPortDisableInterrupts() )
-#define portCLEAR_INTERRUPT_MASK()      ( vPortEnableInterrupts() )
 
 extern portBASE_TYPE xPortSetInterruptMask( void );
 extern void vPortClearInterruptMask( portBASE_TYPE xMask );
 
+#if ( configNUMBER_OF_CORES == 1 )
+#define portSET_INTERRUPT_MASK()        ( vPortDisableInterrupts() )
+#define portCLEAR_INTERRUPT_MASK()      ( vPortEnableInterrupts() )
+
 extern void vPortEnterCritical( void );
 extern void vPortExitCritical( void );
 #define portSET_INTERRUPT_MASK_FROM_ISR()		xPortSetInterruptMask()
@@ -101,6 +135,53 @@ extern void vPortExitCritical( void );
 #define portENABLE_INTERRUPTS()					portCLEAR_INTERRUPT_MASK()
 #define portENTER_CRITICAL()					vPortEnterCritical()
 #define portEXIT_CRITICAL()						vPortExitCritical()
+#else
+/*
+ * Multi-core simulation.  Each simulated core is a slot occupied by the
+ * thread of the task running on it, so configNUMBER_OF_CORES task threads can
+ * execute at the same time.  Masking interrupts blocks signals in the calling
+ * thread only, which matches the per-core interrupt masking of real hardware.
+ * xPortSetInterruptMask() returns whether signals were already blocked so that
+ * vPortClearInterruptMask() can restore the previous state.
+ */
+#define portSET_INTERRUPT_MASK()				xPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK(x)				vPortClearInterruptMask(x)
+#define portSET_INTERRUPT_MASK_FROM_ISR()		xPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
+#define portDISABLE_INTERRUPTS()				vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()					vPortEnableInterrupts()
+
+/* The kernel implements the multi-core critical sections. */
+extern void vTaskEnterCritical( void );
+extern void vTaskExitCritical( void );
+#define portENTER_CRITICAL()					vTaskEnterCritical()
+#define portEXIT_CRITICAL()						vTaskExitCritical()
+
+/* The simulated core the calling thread is running on. */
+extern BaseType_t xPortGetCoreID( void );
+#define portGET_CORE_ID()						xPortGetCoreID()
+
+/* Interrupt another simulated core so it reschedules. */
+extern void vPortYieldCore( BaseType_t xCoreID );
+#define portYIELD_CORE( xCoreID )				vPortYieldCore( xCoreID )
+
+/* Recursive spinlocks, owned by the simulated core that took them. */
+#define portTASK_LOCK							( 0 )
+#define portISR_LOCK							( 1 )
+extern void vPortGetLock( BaseType_t xLock );
+extern void vPortReleaseLock( BaseType_t xLock );
+#define portGET_TASK_LOCK()						vPortGetLock( portTASK_LOCK )
+#define portRELEASE_TASK_LOCK()					vPortReleaseLock( portTASK_LOCK )
+#define portGET_ISR_LOCK()						vPortGetLock( portISR_LOCK )
+#define portRELEASE_ISR_LOCK()					vPortReleaseLock( portISR_LOCK )
+
+/* The critical nesting count of each simulated core. */
+extern volatile UBaseType_t uxPortCriticalNestings[ configNUMBER_OF_CORES ];
+#define portGET_CRITICAL_NESTING_COUNT()		( uxPortCriticalNestings[ portGET_CORE_ID() ] )
+#define portSET_CRITICAL_NESTING_COUNT(x)		( uxPortCriticalNestings[ portGET_CORE_ID() ] = ( x ) )
+#define portINCREMENT_CRITICAL_NESTING_COUNT()	( uxPortCriticalNestings[ portGET_CORE_ID() ]++ )
+#define portDECREMENT_CRITICAL_NESTING_COUNT()	( uxPortCriticalNestings[ portGET_CORE_ID() ]-- )
+#endif /* configNUMBER_OF_CORES */
 
 /*-----------------------------------------------------------*/
 
@@ -120,13 +201,30 @@ extern void vPortCancelThread( void *pxTaskToDelete );
  * which also imply a full memory barrier.
  *
  * Thus, only a compilier barrier is needed to prevent the compiler
- * reordering.
+ * reordering - unless there are multiple simulated cores, in which case
+ * the threads of the running tasks execute concurrently.
  */
-#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+#if ( configNUMBER_OF_CORES == 1 )
+    #define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+#else
+    #define portMEMORY_BARRIER() __sync_synchronize()
+#endif
 
-extern unsigned long ulPortGetRunTime( void );
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() /* no-op */
-#define portGET_RUN_TIME_COUNTER_VALUE()         ulPortGetRunTime()
+/* Used by the object pools and work queues in place of the compare-and-swap
+ * functions in atomic.h, which would mask signals with two system calls. */
+#define portATOMIC_COMPARE_AND_SWAP_U32( pulDestination, ulExchange, ulComparand ) \
+    ( ( uint32_t ) __sync_bool_compare_and_swap( ( pulDestination ), ( ulComparand ), ( ulExchange ) ) )
+#define portATOMIC_COMPARE_AND_SWAP_POINTER( ppvDestination, pvExchange, pvComparand ) \
+    ( ( uint32_t ) __sync_bool_compare_and_swap( ( ppvDestination ), ( pvComparand ), ( pvExchange ) ) )
+
+/* The run time counter counts the user CPU time of the process, in clock
+ * ticks.  An application that needs a finer counter can define both macros in
+ * FreeRTOSConfig.h. */
+#ifndef portGET_RUN_TIME_COUNTER_VALUE
+    extern unsigned long ulPortGetRunTime( void );
+    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() /* no-op */
+    #define portGET_RUN_TIME_COUNTER_VALUE()         ulPortGetRunTime()
+#endif
 
 #ifdef __cplusplus
 }
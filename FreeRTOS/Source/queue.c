@@ -130,6 +130,12 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_SPSC_QUEUES == 1 )
+        volatile UBaseType_t uxSPSCWriteIndex; /*< Only written by the producer of an SPSC queue.  Counts from 0 to ( 2 * uxLength ) - 1 so a full queue can be distinguished from an empty queue. */
+        volatile UBaseType_t uxSPSCReadIndex;  /*< Only written by the consumer of an SPSC queue.  Counts from 0 to ( 2 * uxLength ) - 1. */
+        uint8_t ucIsSPSC;                      /*< Set to pdTRUE if the queue was created with xQueueCreateSPSC() or xQueueCreateSPSCStatic(). */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -212,6 +218,87 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
     static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_SPSC_QUEUES == 1 )
+
+/*
+ * An SPSC queue has exactly one producer and one consumer, each of which owns
+ * one index into the queue storage area.  Items are copied to and from the
+ * storage area and the indexes are updated without a critical section.  The
+ * event lists are only accessed, from within a critical section, when a task
+ * is or might be blocked on the queue.
+ */
+    static BaseType_t prvSPSCSend( Queue_t * const pxQueue,
+                                   const void * const pvItemToQueue,
+                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvSPSCSendFromISR( Queue_t * const pxQueue,
+                                          const void * const pvItemToQueue,
+                                          BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvSPSCReceive( Queue_t * const pxQueue,
+                                      void * const pvBuffer,
+                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvSPSCReceiveFromISR( Queue_t * const pxQueue,
+                                             void * const pvBuffer,
+                                             BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy an item into, or out of, an SPSC queue and publish the new index.
+ * Return pdFALSE without copying if the queue is full or empty respectively.
+ */
+    static BaseType_t prvSPSCCopyDataToQueue( Queue_t * const pxQueue,
+                                              const void * pvItemToQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvSPSCCopyDataFromQueue( Queue_t * const pxQueue,
+                                                void * const pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of items in an SPSC queue, calculated from the two indexes.
+ */
+    static UBaseType_t prvSPSCMessagesWaiting( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/* The number of items in any queue. */
+    #define queueMESSAGES_WAITING( pxQueue ) \
+    ( ( ( pxQueue )->ucIsSPSC != pdFALSE ) ? prvSPSCMessagesWaiting( pxQueue ) : ( pxQueue )->uxMessagesWaiting )
+#else
+    #define queueMESSAGES_WAITING( pxQueue )    ( ( pxQueue )->uxMessagesWaiting )
+#endif /* configUSE_SPSC_QUEUES */
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+/*
+ * Copy up to uxItemCount items into, or out of, a queue with at most two
+ * calls to memcpy() and update uxMessagesWaiting.  Return the number of items
+ * copied, which is limited by the space or the items available.  Called from
+ * within a critical section.
+ */
+    static UBaseType_t prvCopyMultipleToQueue( Queue_t * const pxQueue,
+                                               const uint8_t * pucItems,
+                                               UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+    static UBaseType_t prvCopyMultipleFromQueue( Queue_t * const pxQueue,
+                                                 uint8_t * pucBuffer,
+                                                 UBaseType_t uxMaxItems ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove up to uxCount tasks from an event list, one for each item that was
+ * sent or received.  Returns pdTRUE if a removed task has a priority above
+ * the calling task.  Called from within a critical section.
+ */
+    static BaseType_t prvRemoveMultipleFromEventList( List_t * const pxEventList,
+                                                      UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+#endif /* configUSE_QUEUE_BATCHING */
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+/*
+ * Lock, or unlock, each of uxQueueCount queues.  The queues are locked, and
+ * those that were not modified while locked are unlocked, within a single
+ * critical section, where prvLockQueue() and prvUnlockQueue() would enter one
+ * or two for each queue.
+ */
+    static void prvLockQueues( QueueHandle_t const * pxQueues,
+                               UBaseType_t uxQueueCount ) PRIVILEGED_FUNCTION;
+    static void prvUnlockQueues( QueueHandle_t const * pxQueues,
+                                 UBaseType_t uxQueueCount ) PRIVILEGED_FUNCTION;
+#endif /* configUSE_QUEUE_RECEIVE_ANY */
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -242,6 +329,16 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
  */
     static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if ( configUSE_MUTEX_HANDOFF == 1 )
+
+/*
+ * Called when a mutex is given while tasks are waiting for it.  Makes the
+ * highest priority waiting task the holder of the mutex, leaving the count at
+ * zero, before that task is unblocked.
+ */
+    static void prvHandOffMutex( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -315,6 +412,13 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_SPSC_QUEUES == 1 )
+            {
+                pxQueue->uxSPSCWriteIndex = ( UBaseType_t ) 0U;
+                pxQueue->uxSPSCReadIndex = ( UBaseType_t ) 0U;
+            }
+            #endif /* configUSE_SPSC_QUEUES */
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -521,6 +625,23 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     pxNewQueue->uxItemSize = uxItemSize;
     ( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
 
+    #if ( configUSE_SPSC_QUEUES == 1 )
+    {
+        if( ucQueueType == queueQUEUE_TYPE_SPSC )
+        {
+            /* SPSC queues hold data, and the indexes count to twice the
+             * queue length. */
+            configASSERT( uxItemSize != ( UBaseType_t ) 0 );
+            configASSERT( uxQueueLength <= ( ( ( UBaseType_t ) ~( ( UBaseType_t ) 0 ) ) / ( UBaseType_t ) 2 ) );
+            pxNewQueue->ucIsSPSC = pdTRUE;
+        }
+        else
+        {
+            pxNewQueue->ucIsSPSC = pdFALSE;
+        }
+    }
+    #endif /* configUSE_SPSC_QUEUES */
+
     #if ( configUSE_TRACE_FACILITY == 1 )
     {
         pxNewQueue->ucQueueType = ucQueueType;
@@ -850,6 +971,17 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
     }
     #endif
 
+    #if ( configUSE_SPSC_QUEUES == 1 )
+    {
+        if( pxQueue->ucIsSPSC != pdFALSE )
+        {
+            /* Items can only be added to the back of an SPSC queue. */
+            configASSERT( xCopyPosition == queueSEND_TO_BACK );
+            return prvSPSCSend( pxQueue, pvItemToQueue, xTicksToWait );
+        }
+    }
+    #endif /* configUSE_SPSC_QUEUES */
+
     /*lint -save -e904 This function relaxes the coding standard somewhat to
      * allow return statements within the function itself.  This is done in the
      * interest of execution time efficiency. */
@@ -898,6 +1030,12 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                          * queue then unblock it now. */
                         if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
+                            #if ( configUSE_MUTEX_HANDOFF == 1 )
+                            {
+                                prvHandOffMutex( pxQueue );
+                            }
+                            #endif
+
                             if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                             {
                                 /* The unblocked task has a priority higher than
@@ -933,6 +1071,12 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                      * queue then unblock it now. */
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
+                        #if ( configUSE_MUTEX_HANDOFF == 1 )
+                        {
+                            prvHandOffMutex( pxQueue );
+                        }
+                        #endif
+
                         if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
                             /* The unblocked task has a priority higher than
@@ -1073,12 +1217,22 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
+    #if ( configUSE_SPSC_QUEUES == 1 )
+    {
+        if( pxQueue->ucIsSPSC != pdFALSE )
+        {
+            configASSERT( xCopyPosition == queueSEND_TO_BACK );
+            return prvSPSCSendFromISR( pxQueue, pvItemToQueue, pxHigherPriorityTaskWoken );
+        }
+    }
+    #endif /* configUSE_SPSC_QUEUES */
+
     /* Similar to xQueueGenericSend, except without blocking if there is no room
      * in the queue.  Also don't directly wake a task that was blocked on a queue
      * read, instead return a flag to say whether a context switch is required or
      * not (i.e. has a task with a higher priority than us been woken by this
      * post). */
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
         {
@@ -1203,7 +1357,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
             xReturn = errQUEUE_FULL;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1249,7 +1403,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1369,7 +1523,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
             xReturn = errQUEUE_FULL;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1397,6 +1551,15 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
     }
     #endif
 
+    #if ( configUSE_SPSC_QUEUES == 1 )
+    {
+        if( pxQueue->ucIsSPSC != pdFALSE )
+        {
+            return prvSPSCReceive( pxQueue, pvBuffer, xTicksToWait );
+        }
+    }
+    #endif /* configUSE_SPSC_QUEUES */
+
     /*lint -save -e904  This function relaxes the coding standard somewhat to
      * allow return statements within the function itself.  This is done in the
      * interest of execution time efficiency. */
@@ -1518,6 +1681,298 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+    static void prvLockQueues( QueueHandle_t const * pxQueues,
+                               UBaseType_t uxQueueCount )
+    {
+        UBaseType_t x;
+
+        Queue_t * pxQueue;
+
+        taskENTER_CRITICAL();
+        {
+            for( x = 0; x < uxQueueCount; x++ )
+            {
+                pxQueue = pxQueues[ x ];
+
+                if( pxQueue->cRxLock == queueUNLOCKED )
+                {
+                    pxQueue->cRxLock = queueLOCKED_UNMODIFIED;
+                }
+
+                if( pxQueue->cTxLock == queueUNLOCKED )
+                {
+                    pxQueue->cTxLock = queueLOCKED_UNMODIFIED;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_QUEUE_RECEIVE_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+    static void prvUnlockQueues( QueueHandle_t const * pxQueues,
+                                 UBaseType_t uxQueueCount )
+    {
+        UBaseType_t x;
+        Queue_t * pxQueue;
+        BaseType_t xModified[ configQUEUE_RECEIVE_ANY_MAX_QUEUES ];
+
+        /* Queues that were not sent to or received from by an interrupt while
+         * they were locked have no tasks to unblock, so are unlocked together. */
+        taskENTER_CRITICAL();
+        {
+            for( x = 0; x < uxQueueCount; x++ )
+            {
+                pxQueue = pxQueues[ x ];
+
+                if( ( pxQueue->cTxLock == queueLOCKED_UNMODIFIED ) && ( pxQueue->cRxLock == queueLOCKED_UNMODIFIED ) )
+                {
+                    pxQueue->cTxLock = queueUNLOCKED;
+                    pxQueue->cRxLock = queueUNLOCKED;
+                    xModified[ x ] = pdFALSE;
+                }
+                else
+                {
+                    xModified[ x ] = pdTRUE;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        for( x = 0; x < uxQueueCount; x++ )
+        {
+            if( xModified[ x ] != pdFALSE )
+            {
+                prvUnlockQueue( pxQueues[ x ] );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_RECEIVE_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+    BaseType_t xQueueReceiveAny( QueueHandle_t const * pxQueues,
+                                 const UBaseType_t uxQueueCount,
+                                 void * const pvBuffer,
+                                 UBaseType_t * const puxIndex,
+                                 TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * pxQueue;
+        UBaseType_t x;
+        BaseType_t xAllEmpty;
+        List_t * pxEventLists[ configQUEUE_RECEIVE_ANY_MAX_QUEUES ];
+        ListItem_t xEventListItems[ configQUEUE_RECEIVE_ANY_MAX_QUEUES ];
+
+        configASSERT( pxQueues );
+        configASSERT( ( uxQueueCount > ( UBaseType_t ) 0U ) && ( uxQueueCount <= ( UBaseType_t ) configQUEUE_RECEIVE_ANY_MAX_QUEUES ) );
+
+        for( x = 0; x < uxQueueCount; x++ )
+        {
+            pxQueue = pxQueues[ x ];
+
+            configASSERT( pxQueue );
+            configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+            /* A mutex holder cannot be recorded for more than one queue at a
+             * time, and members of a queue set and SPSC queues do not wake the
+             * tasks waiting to receive from them in the usual way. */
+            configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+            #if ( configUSE_QUEUE_SETS == 1 )
+            {
+                configASSERT( pxQueue->pxQueueSetContainer == NULL );
+            }
+            #endif
+
+            #if ( configUSE_SPSC_QUEUES == 1 )
+            {
+                configASSERT( pxQueue->ucIsSPSC == pdFALSE );
+            }
+            #endif
+
+            pxEventLists[ x ] = &( pxQueue->xTasksWaitingToReceive );
+        }
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Receive from the first queue, in array order, that holds
+                 * data. */
+                for( x = 0; x < uxQueueCount; x++ )
+                {
+                    pxQueue = pxQueues[ x ];
+
+                    if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+                    {
+                        prvCopyDataFromQueue( pxQueue, pvBuffer );
+                        traceQUEUE_RECEIVE( pxQueue );
+                        pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1;
+
+                        /* There is now space in the queue, were any tasks
+                         * waiting to post to the queue?  If so, unblock the
+                         * highest priority waiting task. */
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                            {
+                                queueYIELD_IF_USING_PREEMPTION();
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        taskEXIT_CRITICAL();
+
+                        if( puxIndex != NULL )
+                        {
+                            *puxIndex = x;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        return pdPASS;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* All the queues were empty and no block time is specified
+                     * (or the block time has expired) so leave now. */
+                    taskEXIT_CRITICAL();
+
+                    for( x = 0; x < uxQueueCount; x++ )
+                    {
+                        traceQUEUE_RECEIVE_FAILED( pxQueues[ x ] );
+                    }
+
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            /* Interrupts and other tasks can send to the queues now the
+             * critical section has been exited.  Locking every queue stops an
+             * interrupt from changing any of the event lists while the task is
+             * being placed on them. */
+            vTaskSuspendAll();
+            prvLockQueues( pxQueues, uxQueueCount );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                /* The timeout has not expired.  If every queue is still empty
+                 * place the task on the list of tasks waiting to receive from
+                 * each.  The queues are checked in one critical section rather
+                 * than in one each, as prvIsQueueEmpty() would. */
+                xAllEmpty = pdTRUE;
+
+                taskENTER_CRITICAL();
+                {
+                    for( x = 0; x < uxQueueCount; x++ )
+                    {
+                        if( pxQueues[ x ]->uxMessagesWaiting != ( UBaseType_t ) 0 )
+                        {
+                            xAllEmpty = pdFALSE;
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( xAllEmpty != pdFALSE )
+                {
+                    for( x = 0; x < uxQueueCount; x++ )
+                    {
+                        traceBLOCKING_ON_QUEUE_RECEIVE( pxQueues[ x ] );
+                    }
+
+                    /* The first queue to receive data unblocks the task and
+                     * removes it from the event lists of the others. */
+                    vTaskPlaceOnEventLists( pxEventLists, xEventListItems, uxQueueCount, xTicksToWait );
+
+                    prvUnlockQueues( pxQueues, uxQueueCount );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* A queue contains data again.  Loop back to try and read
+                     * the data. */
+                    prvUnlockQueues( pxQueues, uxQueueCount );
+
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  Loop back once more, without blocking, to read
+                 * any data that arrived and leave. */
+                xTicksToWait = ( TickType_t ) 0;
+                prvUnlockQueues( pxQueues, uxQueueCount );
+
+                ( void ) xTaskResumeAll();
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_QUEUE_RECEIVE_ANY */
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                                 TickType_t xTicksToWait )
 {
@@ -1529,6 +1984,10 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
         BaseType_t xInheritanceOccurred = pdFALSE;
     #endif
 
+    #if ( configUSE_MUTEX_HANDOFF == 1 )
+        BaseType_t xHandOffPossible = pdFALSE;
+    #endif
+
     /* Check the queue pointer is not NULL. */
     configASSERT( ( pxQueue ) );
 
@@ -1649,6 +2108,22 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                     {
                         taskENTER_CRITICAL();
                         {
+                            #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                            {
+                                /* Let tasks that later block on a mutex held by
+                                 * this task find the holder of this mutex. */
+                                vTaskSetBlockingMutexHolder( &( pxQueue->u.xSemaphore.xMutexHolder ) );
+                            }
+                            #endif
+
+                            #if ( configUSE_MUTEX_HANDOFF == 1 )
+                            {
+                                /* A task that blocks on a mutex it already holds
+                                 * cannot have the mutex handed to it. */
+                                xHandOffPossible = ( pxQueue->u.xSemaphore.xMutexHolder != xTaskGetCurrentTaskHandle() ) ? pdTRUE : pdFALSE;
+                            }
+                            #endif
+
                             xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
                         }
                         taskEXIT_CRITICAL();
@@ -1671,25 +2146,65 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-            }
-            else
-            {
-                /* There was no timeout and the semaphore count was not 0, so
-                 * attempt to take the semaphore again. */
-                prvUnlockQueue( pxQueue );
-                ( void ) xTaskResumeAll();
-            }
-        }
-        else
-        {
-            /* Timed out. */
-            prvUnlockQueue( pxQueue );
-            ( void ) xTaskResumeAll();
 
-            /* If the semaphore count is 0 exit now as the timeout has
-             * expired.  Otherwise return to attempt to take the semaphore that is
-             * known to be available.  As semaphores are implemented by queues the
-             * queue being empty is equivalent to the semaphore count being 0. */
+                #if ( ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 ) || ( configUSE_MUTEX_HANDOFF == 1 ) )
+                {
+                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            /* This task is running again, so is no longer
+                             * blocked on the mutex. */
+                            #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                            {
+                                vTaskSetBlockingMutexHolder( NULL );
+                            }
+                            #endif
+
+                            #if ( configUSE_MUTEX_HANDOFF == 1 )
+                            {
+                                /* If the task giving the mutex handed it to this
+                                 * task then this task already holds it. */
+                                if( ( xHandOffPossible != pdFALSE ) && ( pxQueue->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() ) )
+                                {
+                                    traceQUEUE_RECEIVE( pxQueue );
+                                    taskEXIT_CRITICAL();
+                                    return pdPASS;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            #endif
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* if ( ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 ) || ( configUSE_MUTEX_HANDOFF == 1 ) ) */
+            }
+            else
+            {
+                /* There was no timeout and the semaphore count was not 0, so
+                 * attempt to take the semaphore again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            /* If the semaphore count is 0 exit now as the timeout has
+             * expired.  Otherwise return to attempt to take the semaphore that is
+             * known to be available.  As semaphores are implemented by queues the
+             * queue being empty is equivalent to the semaphore count being 0. */
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 #if ( configUSE_MUTEXES == 1 )
@@ -1751,6 +2266,13 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
     }
     #endif
 
+    #if ( configUSE_SPSC_QUEUES == 1 )
+    {
+        /* Only the consumer of an SPSC queue may read from it. */
+        configASSERT( pxQueue->ucIsSPSC == pdFALSE );
+    }
+    #endif /* configUSE_SPSC_QUEUES */
+
     /*lint -save -e904  This function relaxes the coding standard somewhat to
      * allow return statements within the function itself.  This is done in the
      * interest of execution time efficiency. */
@@ -1906,7 +2428,16 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    #if ( configUSE_SPSC_QUEUES == 1 )
+    {
+        if( pxQueue->ucIsSPSC != pdFALSE )
+        {
+            return prvSPSCReceiveFromISR( pxQueue, pvBuffer, pxHigherPriorityTaskWoken );
+        }
+    }
+    #endif /* configUSE_SPSC_QUEUES */
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1966,7 +2497,7 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
             traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1984,6 +2515,12 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
     configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
     configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
 
+    #if ( configUSE_SPSC_QUEUES == 1 )
+    {
+        configASSERT( pxQueue->ucIsSPSC == pdFALSE );
+    }
+    #endif /* configUSE_SPSC_QUEUES */
+
     /* RTOS ports that support interrupt nesting have the concept of a maximum
      * system call (or maximum API call) interrupt priority.  Interrupts that are
      * above the maximum system call priority are kept permanently enabled, even
@@ -2000,7 +2537,7 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         /* Cannot block in an ISR, so check there is data available. */
         if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
@@ -2021,7 +2558,7 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
             traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -2035,7 +2572,7 @@ UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
 
     taskENTER_CRITICAL();
     {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+        uxReturn = queueMESSAGES_WAITING( ( ( Queue_t * ) xQueue ) );
     }
     taskEXIT_CRITICAL();
 
@@ -2052,7 +2589,7 @@ UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
 
     taskENTER_CRITICAL();
     {
-        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+        uxReturn = pxQueue->uxLength - queueMESSAGES_WAITING( pxQueue );
     }
     taskEXIT_CRITICAL();
 
@@ -2066,7 +2603,7 @@ UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
     Queue_t * const pxQueue = xQueue;
 
     configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
+    uxReturn = queueMESSAGES_WAITING( pxQueue );
 
     return uxReturn;
 } /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
@@ -2172,6 +2709,30 @@ void vQueueDelete( QueueHandle_t xQueue )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_HANDOFF == 1 )
+
+    static void prvHandOffMutex( Queue_t * const pxQueue )
+    {
+        /* This function is called from a critical section, after
+         * prvCopyDataToQueue() has released the mutex and incremented the count.
+         * Rather than leave the mutex free for whichever task runs next, so the
+         * woken task might find it taken again, pass it straight to the task at
+         * the head of the list of waiting tasks, which the caller then unblocks.
+         * That task finds it already holds the mutex when it runs. */
+        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+        {
+            pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementWaiterMutexHeldCount( &( pxQueue->xTasksWaitingToReceive ) );
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_MUTEX_HANDOFF */
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
                                       const void * pvItemToQueue,
                                       const BaseType_t xPosition )
@@ -2202,7 +2763,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
     else if( xPosition == queueSEND_TO_BACK )
     {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        configKERNEL_MEMCPY( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
         pxQueue->pcWriteTo += pxQueue->uxItemSize;                                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 
         if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                                             /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
@@ -2216,7 +2777,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
     else
     {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
+        configKERNEL_MEMCPY( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
         pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 
         if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
@@ -2271,7 +2832,7 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
             mtCOVERAGE_TEST_MARKER();
         }
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        configKERNEL_MEMCPY( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
     }
 }
 /*-----------------------------------------------------------*/
@@ -2402,7 +2963,7 @@ static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue )
 
     taskENTER_CRITICAL();
     {
-        if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+        if( queueMESSAGES_WAITING( pxQueue ) == ( UBaseType_t ) 0 )
         {
             xReturn = pdTRUE;
         }
@@ -2424,7 +2985,7 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
 
     configASSERT( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+    if( queueMESSAGES_WAITING( pxQueue ) == ( UBaseType_t ) 0 )
     {
         xReturn = pdTRUE;
     }
@@ -2443,7 +3004,7 @@ static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
 
     taskENTER_CRITICAL();
     {
-        if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+        if( queueMESSAGES_WAITING( pxQueue ) == pxQueue->uxLength )
         {
             xReturn = pdTRUE;
         }
@@ -2465,7 +3026,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
     configASSERT( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+    if( queueMESSAGES_WAITING( pxQueue ) == pxQueue->uxLength )
     {
         xReturn = pdTRUE;
     }
@@ -2613,7 +3174,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 }
 
                 --( pxQueue->uxMessagesWaiting );
-                ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+                configKERNEL_MEMCPY( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
 
                 xReturn = pdPASS;
 
@@ -2727,7 +3288,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             }
 
             --( pxQueue->uxMessagesWaiting );
-            ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+            configKERNEL_MEMCPY( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
 
             if( ( *pxCoRoutineWoken ) == pdFALSE )
             {
@@ -2950,6 +3511,14 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                  * items in the queue/semaphore. */
                 xReturn = pdFAIL;
             }
+
+            #if ( configUSE_SPSC_QUEUES == 1 )
+                else if( ( ( Queue_t * ) xQueueOrSemaphore )->ucIsSPSC != pdFALSE )
+                {
+                    /* The SPSC send functions do not notify a queue set. */
+                    xReturn = pdFAIL;
+                }
+            #endif /* configUSE_SPSC_QUEUES */
             else
             {
                 ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
@@ -3049,8 +3618,22 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
             traceQUEUE_SET_SEND( pxQueueSetContainer );
 
-            /* The data copied is the handle of the queue that contains data. */
-            xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+            /* The data copied is the handle of the queue that contains data.
+             * A queue set only holds handles, so the copy is made with a
+             * constant size rather than through prvCopyDataToQueue(). */
+            configKERNEL_MEMCPY( ( void * ) pxQueueSetContainer->pcWriteTo, ( const void * ) &pxQueue, sizeof( Queue_t * ) ); /*lint !e9087 Cast to void required by function signature. */
+            pxQueueSetContainer->pcWriteTo += sizeof( Queue_t * );                                                          /*lint !e9016 Pointer arithmetic on char types ok. */
+
+            if( pxQueueSetContainer->pcWriteTo >= pxQueueSetContainer->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+            {
+                pxQueueSetContainer->pcWriteTo = pxQueueSetContainer->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            ( pxQueueSetContainer->uxMessagesWaiting )++;
 
             if( cTxLock == queueUNLOCKED )
             {
@@ -3085,3 +3668,1122 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     }
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SPSC_QUEUES == 1 )
+
+    static UBaseType_t prvSPSCMessagesWaiting( const Queue_t * const pxQueue )
+    {
+        const UBaseType_t uxWriteIndex = pxQueue->uxSPSCWriteIndex;
+        const UBaseType_t uxReadIndex = pxQueue->uxSPSCReadIndex;
+        UBaseType_t uxReturn;
+
+        /* Both indexes count to twice the queue length, so the write index is
+         * never more than uxLength ahead of the read index. */
+        if( uxWriteIndex >= uxReadIndex )
+        {
+            uxReturn = uxWriteIndex - uxReadIndex;
+        }
+        else
+        {
+            uxReturn = ( uxWriteIndex + ( ( UBaseType_t ) 2 * pxQueue->uxLength ) ) - uxReadIndex;
+        }
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SPSC_QUEUES == 1 )
+
+    static BaseType_t prvSPSCCopyDataToQueue( Queue_t * const pxQueue,
+                                              const void * pvItemToQueue )
+    {
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t uxWriteIndex = pxQueue->uxSPSCWriteIndex;
+        UBaseType_t uxSlot;
+
+        if( prvSPSCMessagesWaiting( pxQueue ) < pxQueue->uxLength )
+        {
+            /* Do not write to the slot until the consumer's read index, and so
+             * the consumer's copy out of the slot, has been observed. */
+            portMEMORY_BARRIER();
+
+            if( uxWriteIndex < pxQueue->uxLength )
+            {
+                uxSlot = uxWriteIndex;
+            }
+            else
+            {
+                uxSlot = uxWriteIndex - pxQueue->uxLength;
+            }
+
+            configKERNEL_MEMCPY( ( void * ) ( pxQueue->pcHead + ( uxSlot * pxQueue->uxItemSize ) ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+
+            uxWriteIndex++;
+
+            if( uxWriteIndex == ( ( UBaseType_t ) 2 * pxQueue->uxLength ) )
+            {
+                uxWriteIndex = ( UBaseType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The item must be in the storage area before the consumer can see
+             * the new write index, and the new write index must be visible
+             * before the caller checks for a blocked consumer. */
+            portMEMORY_BARRIER();
+            pxQueue->uxSPSCWriteIndex = uxWriteIndex;
+            portMEMORY_BARRIER();
+
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SPSC_QUEUES == 1 )
+
+    static BaseType_t prvSPSCCopyDataFromQueue( Queue_t * const pxQueue,
+                                                void * const pvBuffer )
+    {
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t uxReadIndex = pxQueue->uxSPSCReadIndex;
+        UBaseType_t uxSlot;
+
+        if( prvSPSCMessagesWaiting( pxQueue ) > ( UBaseType_t ) 0 )
+        {
+            /* Do not read the slot until the producer's write index, and so the
+             * producer's copy into the slot, has been observed. */
+            portMEMORY_BARRIER();
+
+            if( uxReadIndex < pxQueue->uxLength )
+            {
+                uxSlot = uxReadIndex;
+            }
+            else
+            {
+                uxSlot = uxReadIndex - pxQueue->uxLength;
+            }
+
+            configKERNEL_MEMCPY( ( void * ) pvBuffer, ( void * ) ( pxQueue->pcHead + ( uxSlot * pxQueue->uxItemSize ) ), ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+
+            uxReadIndex++;
+
+            if( uxReadIndex == ( ( UBaseType_t ) 2 * pxQueue->uxLength ) )
+            {
+                uxReadIndex = ( UBaseType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The item must be copied out before the producer can see the
+             * slot is free, and the new read index must be visible before the
+             * caller checks for a blocked producer. */
+            portMEMORY_BARRIER();
+            pxQueue->uxSPSCReadIndex = uxReadIndex;
+            portMEMORY_BARRIER();
+
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SPSC_QUEUES == 1 )
+
+    static BaseType_t prvSPSCSend( Queue_t * const pxQueue,
+                                   const void * const pvItemToQueue,
+                                   TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+
+        /* Only used by the trace macros. */
+        const BaseType_t xCopyPosition = queueSEND_TO_BACK;
+
+        ( void ) xCopyPosition;
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            if( prvSPSCCopyDataToQueue( pxQueue, pvItemToQueue ) != pdFALSE )
+            {
+                traceQUEUE_SEND( pxQueue );
+
+                /* A consumer that is blocked, or that has locked the queue to
+                 * block, must be unblocked.  Locking the queue also prevents
+                 * this task from accessing the event list until the consumer
+                 * has finished with it. */
+                if( ( pxQueue->cTxLock != queueUNLOCKED ) ||
+                    ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                queueYIELD_IF_USING_PREEMPTION();
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                return pdPASS;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                traceQUEUE_SEND_FAILED( pxQueue );
+                return errQUEUE_FULL;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                taskENTER_CRITICAL();
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                }
+                taskEXIT_CRITICAL();
+                xEntryTimeSet = pdTRUE;
+            }
+            else
+            {
+                /* Entry time was already set. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The queue was full, so block exactly as xQueueGenericSend()
+             * does.  The consumer checks the event list after updating the read
+             * index, so space created after the queue is locked below cannot be
+             * missed. */
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                return errQUEUE_FULL;
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SPSC_QUEUES == 1 )
+
+    static BaseType_t prvSPSCSendFromISR( Queue_t * const pxQueue,
+                                          const void * const pvItemToQueue,
+                                          BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* Only used by the trace macros. */
+        const BaseType_t xCopyPosition = queueSEND_TO_BACK;
+
+        ( void ) xCopyPosition;
+
+        if( prvSPSCCopyDataToQueue( pxQueue, pvItemToQueue ) != pdFALSE )
+        {
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+            if( ( pxQueue->cTxLock != queueUNLOCKED ) ||
+                ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+            {
+                uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+                {
+                    const int8_t cTxLock = pxQueue->cTxLock;
+
+                    /* The event list is not altered if the queue is locked.
+                     * This will be done when the queue is unlocked later. */
+                    if( cTxLock == queueUNLOCKED )
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                if( pxHigherPriorityTaskWoken != NULL )
+                                {
+                                    *pxHigherPriorityTaskWoken = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        prvIncrementQueueTxLock( pxQueue, cTxLock );
+                    }
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            xReturn = errQUEUE_FULL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SPSC_QUEUES == 1 )
+
+    static BaseType_t prvSPSCReceive( Queue_t * const pxQueue,
+                                      void * const pvBuffer,
+                                      TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            if( prvSPSCCopyDataFromQueue( pxQueue, pvBuffer ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE( pxQueue );
+
+                /* A producer that is blocked, or that has locked the queue to
+                 * block, must be unblocked. */
+                if( ( pxQueue->cRxLock != queueUNLOCKED ) ||
+                    ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                            {
+                                queueYIELD_IF_USING_PREEMPTION();
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                return pdPASS;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                return errQUEUE_EMPTY;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                taskENTER_CRITICAL();
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                }
+                taskEXIT_CRITICAL();
+                xEntryTimeSet = pdTRUE;
+            }
+            else
+            {
+                /* Entry time was already set. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The queue was empty, so block exactly as xQueueReceive() does. */
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SPSC_QUEUES == 1 )
+
+    static BaseType_t prvSPSCReceiveFromISR( Queue_t * const pxQueue,
+                                             void * const pvBuffer,
+                                             BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        if( prvSPSCCopyDataFromQueue( pxQueue, pvBuffer ) != pdFALSE )
+        {
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+            if( ( pxQueue->cRxLock != queueUNLOCKED ) ||
+                ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+            {
+                uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+                {
+                    const int8_t cRxLock = pxQueue->cRxLock;
+
+                    /* If the queue is locked the event list will not be
+                     * modified.  Instead update the lock count so the task that
+                     * unlocks the queue will know that an ISR has removed data
+                     * while the queue was locked. */
+                    if( cRxLock == queueUNLOCKED )
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                            {
+                                if( pxHigherPriorityTaskWoken != NULL )
+                                {
+                                    *pxHigherPriorityTaskWoken = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    }
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_SPSC_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    BaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                                   const void * const pvItemsToQueue,
+                                   const UBaseType_t uxItemCount,
+                                   TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+        const uint8_t * const pucItems = ( const uint8_t * ) pvItemsToQueue;
+        UBaseType_t uxItemsSent = 0, uxItemsCopied;
+
+        /* The trace macros expect the position the item was copied to. */
+        const BaseType_t xCopyPosition = queueSEND_TO_BACK;
+
+        ( void ) xCopyPosition;
+
+        configASSERT( pxQueue );
+        configASSERT( pvItemsToQueue );
+
+        /* Semaphores and mutexes do not hold items. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        /* A queue set holds one handle per item, and an SPSC queue is not
+         * protected by critical sections, so neither can be batched. */
+        #if ( configUSE_QUEUE_SETS == 1 )
+        {
+            configASSERT( pxQueue->pxQueueSetContainer == NULL );
+        }
+        #endif
+
+        #if ( configUSE_SPSC_QUEUES == 1 )
+        {
+            configASSERT( pxQueue->ucIsSPSC == pdFALSE );
+        }
+        #endif
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Copy as many of the remaining items as there is space for,
+                 * then wake one waiting task for each item copied. */
+                uxItemsCopied = prvCopyMultipleToQueue( pxQueue, &( pucItems[ ( size_t ) uxItemsSent * ( size_t ) pxQueue->uxItemSize ] ), uxItemCount - uxItemsSent );
+
+                if( uxItemsCopied > ( UBaseType_t ) 0 )
+                {
+                    traceQUEUE_SEND_MULTIPLE( pxQueue, uxItemsCopied );
+                    uxItemsSent += uxItemsCopied;
+
+                    if( prvRemoveMultipleFromEventList( &( pxQueue->xTasksWaitingToReceive ), uxItemsCopied ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( uxItemsSent == uxItemCount )
+                {
+                    taskEXIT_CRITICAL();
+                    return ( BaseType_t ) uxItemsSent;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue is full and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    return ( BaseType_t ) uxItemsSent;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  Loop back once more, without blocking, to send
+                 * whatever fits and leave. */
+                xTicksToWait = ( TickType_t ) 0;
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                          const void * const pvItemsToQueue,
+                                          const UBaseType_t uxItemCount,
+                                          BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+        UBaseType_t uxItemsSent, ux;
+
+        /* The trace macros expect the position the item was copied to. */
+        const BaseType_t xCopyPosition = queueSEND_TO_BACK;
+
+        ( void ) xCopyPosition;
+
+        configASSERT( pxQueue );
+        configASSERT( pvItemsToQueue );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+        {
+            configASSERT( pxQueue->pxQueueSetContainer == NULL );
+        }
+        #endif
+
+        #if ( configUSE_SPSC_QUEUES == 1 )
+        {
+            configASSERT( pxQueue->ucIsSPSC == pdFALSE );
+        }
+        #endif
+
+        /* See the comments in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            int8_t cTxLock = pxQueue->cTxLock;
+
+            uxItemsSent = prvCopyMultipleToQueue( pxQueue, ( const uint8_t * ) pvItemsToQueue, uxItemCount );
+
+            if( uxItemsSent > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_SEND_MULTIPLE_FROM_ISR( pxQueue, uxItemsSent );
+
+                /* The event list is not altered if the queue is locked.  This
+                 * can be done when the queue is unlocked later. */
+                if( cTxLock == queueUNLOCKED )
+                {
+                    if( prvRemoveMultipleFromEventList( &( pxQueue->xTasksWaitingToReceive ), uxItemsSent ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Increment the lock count once per item so the task
+                     * that unlocks the queue knows how many items were posted
+                     * while it was locked. */
+                    for( ux = 0; ux < uxItemsSent; ux++ )
+                    {
+                        prvIncrementQueueTxLock( pxQueue, cTxLock );
+                        cTxLock = pxQueue->cTxLock;
+                    }
+                }
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        return ( BaseType_t ) uxItemsSent;
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                      void * const pvBuffer,
+                                      const UBaseType_t uxMaxItems,
+                                      TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+        UBaseType_t uxItemsReceived;
+
+        configASSERT( pxQueue );
+        configASSERT( pvBuffer );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+        {
+            configASSERT( pxQueue->pxQueueSetContainer == NULL );
+        }
+        #endif
+
+        #if ( configUSE_SPSC_QUEUES == 1 )
+        {
+            configASSERT( pxQueue->ucIsSPSC == pdFALSE );
+        }
+        #endif
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Remove as many items as are available, up to uxMaxItems,
+                 * then wake one waiting task for each space freed. */
+                uxItemsReceived = prvCopyMultipleFromQueue( pxQueue, ( uint8_t * ) pvBuffer, uxMaxItems );
+
+                if( uxItemsReceived > ( UBaseType_t ) 0 )
+                {
+                    traceQUEUE_RECEIVE_MULTIPLE( pxQueue, uxItemsReceived );
+
+                    if( prvRemoveMultipleFromEventList( &( pxQueue->xTasksWaitingToSend ), uxItemsReceived ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    taskEXIT_CRITICAL();
+                    return ( BaseType_t ) uxItemsReceived;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return 0;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue contains data again.  Loop back to try and
+                     * read the data. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  Loop back once more, without blocking, to read
+                 * any data that arrived and leave. */
+                xTicksToWait = ( TickType_t ) 0;
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                             void * const pvBuffer,
+                                             const UBaseType_t uxMaxItems,
+                                             BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+        UBaseType_t uxItemsReceived, ux;
+
+        configASSERT( pxQueue );
+        configASSERT( pvBuffer );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+        {
+            configASSERT( pxQueue->pxQueueSetContainer == NULL );
+        }
+        #endif
+
+        #if ( configUSE_SPSC_QUEUES == 1 )
+        {
+            configASSERT( pxQueue->ucIsSPSC == pdFALSE );
+        }
+        #endif
+
+        /* See the comments in xQueueReceiveFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            int8_t cRxLock = pxQueue->cRxLock;
+
+            uxItemsReceived = prvCopyMultipleFromQueue( pxQueue, ( uint8_t * ) pvBuffer, uxMaxItems );
+
+            if( uxItemsReceived > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR( pxQueue, uxItemsReceived );
+
+                /* If the queue is locked the event list will not be modified.
+                 * Instead update the lock count so the task that unlocks the
+                 * queue will know that an ISR has removed data while the queue
+                 * was locked. */
+                if( cRxLock == queueUNLOCKED )
+                {
+                    if( prvRemoveMultipleFromEventList( &( pxQueue->xTasksWaitingToSend ), uxItemsReceived ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    for( ux = 0; ux < uxItemsReceived; ux++ )
+                    {
+                        prvIncrementQueueRxLock( pxQueue, cRxLock );
+                        cRxLock = pxQueue->cRxLock;
+                    }
+                }
+            }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        return ( BaseType_t ) uxItemsReceived;
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    static UBaseType_t prvCopyMultipleToQueue( Queue_t * const pxQueue,
+                                               const uint8_t * pucItems,
+                                               UBaseType_t uxItemCount )
+    {
+        const UBaseType_t uxSpaces = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+        UBaseType_t uxFirstItems;
+        size_t xFirstBytes, xRemainingBytes;
+
+        if( uxItemCount > uxSpaces )
+        {
+            uxItemCount = uxSpaces;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( uxItemCount > ( UBaseType_t ) 0 )
+        {
+            /* Copy the items that fit before the end of the storage area, then
+             * wrap back to the start for the rest. */
+            uxFirstItems = ( UBaseType_t ) ( ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ) / ( size_t ) pxQueue->uxItemSize ); /*lint !e946 !e947 MISRA exception justified as the pointers are into the same array. */
+            uxFirstItems = configMIN( uxFirstItems, uxItemCount );
+            xFirstBytes = ( size_t ) uxFirstItems * ( size_t ) pxQueue->uxItemSize;
+
+            configKERNEL_MEMCPY( ( void * ) pxQueue->pcWriteTo, ( const void * ) pucItems, xFirstBytes ); /*lint !e9087 Cast to void required by function signature. */
+
+            if( uxItemCount > uxFirstItems )
+            {
+                xRemainingBytes = ( size_t ) ( uxItemCount - uxFirstItems ) * ( size_t ) pxQueue->uxItemSize;
+                configKERNEL_MEMCPY( ( void * ) pxQueue->pcHead, ( const void * ) &( pucItems[ xFirstBytes ] ), xRemainingBytes ); /*lint !e9087 Cast to void required by function signature. */
+                pxQueue->pcWriteTo = pxQueue->pcHead + xRemainingBytes;
+            }
+            else
+            {
+                pxQueue->pcWriteTo += xFirstBytes;
+
+                if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+                {
+                    pxQueue->pcWriteTo = pxQueue->pcHead;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            pxQueue->uxMessagesWaiting += uxItemCount;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxItemCount;
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    static UBaseType_t prvCopyMultipleFromQueue( Queue_t * const pxQueue,
+                                                 uint8_t * pucBuffer,
+                                                 UBaseType_t uxMaxItems )
+    {
+        int8_t * pcNextRead;
+        UBaseType_t uxFirstItems;
+        size_t xFirstBytes, xRemainingBytes;
+
+        if( uxMaxItems > pxQueue->uxMessagesWaiting )
+        {
+            uxMaxItems = pxQueue->uxMessagesWaiting;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( uxMaxItems > ( UBaseType_t ) 0 )
+        {
+            /* pcReadFrom points to the last item read, so the first item to
+             * read is the one after it. */
+            pcNextRead = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+
+            if( pcNextRead >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+            {
+                pcNextRead = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxFirstItems = ( UBaseType_t ) ( ( size_t ) ( pxQueue->u.xQueue.pcTail - pcNextRead ) / ( size_t ) pxQueue->uxItemSize ); /*lint !e946 !e947 MISRA exception justified as the pointers are into the same array. */
+            uxFirstItems = configMIN( uxFirstItems, uxMaxItems );
+            xFirstBytes = ( size_t ) uxFirstItems * ( size_t ) pxQueue->uxItemSize;
+
+            configKERNEL_MEMCPY( ( void * ) pucBuffer, ( void * ) pcNextRead, xFirstBytes ); /*lint !e9087 Cast to void required by function signature. */
+
+            if( uxMaxItems > uxFirstItems )
+            {
+                xRemainingBytes = ( size_t ) ( uxMaxItems - uxFirstItems ) * ( size_t ) pxQueue->uxItemSize;
+                configKERNEL_MEMCPY( ( void * ) &( pucBuffer[ xFirstBytes ] ), ( void * ) pxQueue->pcHead, xRemainingBytes ); /*lint !e9087 Cast to void required by function signature. */
+                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + xRemainingBytes - pxQueue->uxItemSize;
+            }
+            else
+            {
+                pxQueue->u.xQueue.pcReadFrom = pcNextRead + xFirstBytes - pxQueue->uxItemSize;
+            }
+
+            pxQueue->uxMessagesWaiting -= uxMaxItems;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxMaxItems;
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    static BaseType_t prvRemoveMultipleFromEventList( List_t * const pxEventList,
+                                                      UBaseType_t uxCount )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        while( ( uxCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+        {
+            if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxCount--;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
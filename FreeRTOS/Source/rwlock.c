@@ -0,0 +1,756 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rwlock.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include reader-writer lock functionality.  This #if is closed at the very
+ * bottom of this file.  If you want to include reader-writer locks then ensure
+ * configUSE_RW_LOCKS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_RW_LOCKS == 1 )
+
+    #if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+        #define rwlockYIELD_IF_USING_PREEMPTION()
+    #else
+        #define rwlockYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+    #endif
+
+/*
+ * Definition of the reader-writer lock structure.  The xSTATIC_RWLOCK
+ * structure in FreeRTOS.h must be kept in step with it.
+ */
+    typedef struct RWLockDefinition /* The old naming convention is used to prevent breaking kernel aware debuggers. */
+    {
+        volatile UBaseType_t uxReaders; /*< The number of tasks that hold the lock for reading. */
+        volatile TaskHandle_t xWriter;  /*< The task that holds the lock for writing, or NULL. */
+        List_t xTasksWaitingToRead;     /*< List of tasks that are blocked waiting to take the lock for reading.  Stored in priority order. */
+        List_t xTasksWaitingToWrite;    /*< List of tasks that are blocked waiting to take the lock for writing.  Stored in priority order. */
+
+        #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+            uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the lock is statically allocated to ensure no attempt is made to free the memory. */
+        #endif
+    } RWLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialises a newly allocated lock as free.
+ */
+    static void prvInitialiseNewRWLock( RWLock_t * const pxRWLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks every task waiting to take pxRWLock for reading.  The woken tasks
+ * take the lock themselves when they run.  Must be called from a critical
+ * section.  Returns pdTRUE if a woken task has a priority above that of the
+ * calling task.
+ */
+    static BaseType_t prvUnblockReaders( RWLock_t * const pxRWLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Makes the highest priority task waiting to write the holder of pxRWLock,
+ * then unblocks it.  Must be called from a critical section.  Returns pdTRUE
+ * if that task has a priority above that of the calling task.
+ */
+    static BaseType_t prvHandOffToWriter( RWLock_t * const pxRWLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * If a task waiting for a lock causes the writer to inherit a priority, but
+ * the waiting task times out, then the writer should disinherit the priority -
+ * but only down to the highest priority of any other tasks that are waiting for
+ * the same lock.  This function returns that priority.
+ */
+    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const RWLock_t * const pxRWLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called after a task waiting for pxRWLock has timed out.  Undoes any priority
+ * the writer inherited from the task, and, if the task was the last task
+ * waiting to write, unblocks the readers that were only waiting because of it.
+ */
+    static void prvCleanUpAfterTimeout( RWLock_t * const pxRWLock,
+                                        BaseType_t xInheritanceOccurred ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        RWLockHandle_t xRWLockCreate( void )
+        {
+            RWLock_t * pxNewRWLock;
+
+            pxNewRWLock = ( RWLock_t * ) pvPortMalloc( sizeof( RWLock_t ) ); /*lint !e9087 !e9079 pvPortMalloc() always returns memory aligned for any kernel structure. */
+
+            if( pxNewRWLock != NULL )
+            {
+                prvInitialiseNewRWLock( pxNewRWLock );
+
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    /* Both static and dynamic allocation can be used, so note this
+                     * lock was allocated dynamically in case it is later deleted. */
+                    pxNewRWLock->ucStaticallyAllocated = pdFALSE;
+                }
+                #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+                traceRWLOCK_CREATE( pxNewRWLock );
+            }
+            else
+            {
+                traceRWLOCK_CREATE_FAILED(); /*lint !e9063 Else branch only exists to allow tracing and does not generate code if trace macros are not defined. */
+            }
+
+            return pxNewRWLock;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t * pxRWLockBuffer )
+        {
+            RWLock_t * pxNewRWLock = NULL;
+
+            configASSERT( pxRWLockBuffer );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticRWLock_t equals the size of the real
+                 * lock structure. */
+                volatile size_t xSize = sizeof( StaticRWLock_t );
+
+                /* This assertion cannot be branch covered in unit tests */
+                configASSERT( xSize == sizeof( RWLock_t ) ); /* LCOV_EXCL_BR_LINE */
+                ( void ) xSize;                              /* Keeps lint quiet when configASSERT() is not defined. */
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( pxRWLockBuffer != NULL )
+            {
+                /* The StaticRWLock_t structure is guaranteed to have the same size
+                 * and alignment requirements as the real lock structure. */
+                pxNewRWLock = ( RWLock_t * ) pxRWLockBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+                prvInitialiseNewRWLock( pxNewRWLock );
+
+                #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                {
+                    /* Both static and dynamic allocation can be used, so note that
+                     * this lock was created statically in case it is later
+                     * deleted. */
+                    pxNewRWLock->ucStaticallyAllocated = pdTRUE;
+                }
+                #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+                traceRWLOCK_CREATE( pxNewRWLock );
+            }
+            else
+            {
+                traceRWLOCK_CREATE_FAILED(); /*lint !e9063 Else branch only exists to allow tracing and does not generate code if trace macros are not defined. */
+            }
+
+            return pxNewRWLock;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewRWLock( RWLock_t * const pxRWLock )
+    {
+        pxRWLock->uxReaders = ( UBaseType_t ) 0U;
+        pxRWLock->xWriter = NULL;
+        vListInitialise( &( pxRWLock->xTasksWaitingToRead ) );
+        vListInitialise( &( pxRWLock->xTasksWaitingToWrite ) );
+    }
+/*-----------------------------------------------------------*/
+
+    void vRWLockDelete( RWLockHandle_t xRWLock )
+    {
+        RWLock_t * const pxRWLock = xRWLock;
+
+        configASSERT( pxRWLock );
+        configASSERT( pxRWLock->uxReaders == ( UBaseType_t ) 0U );
+        configASSERT( pxRWLock->xWriter == NULL );
+        configASSERT( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToRead ) ) != pdFALSE );
+        configASSERT( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToWrite ) ) != pdFALSE );
+
+        traceRWLOCK_DELETE( pxRWLock );
+
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+        {
+            /* The lock can only have been allocated dynamically - free it
+             * again. */
+            vPortFree( pxRWLock );
+        }
+        #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        {
+            /* The lock could have been allocated statically or dynamically, so
+             * check before attempting to free the memory. */
+            if( pxRWLock->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            {
+                vPortFree( pxRWLock );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock,
+                                TickType_t xTicksToWait )
+    {
+        RWLock_t * const pxRWLock = xRWLock;
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t xEntryTimeSet = pdFALSE;
+        BaseType_t xInheritanceOccurred = pdFALSE;
+        TimeOut_t xTimeOut;
+
+        configASSERT( pxRWLock );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Readers share the lock, but do not take it while a task is
+                 * waiting to write, so a steady stream of readers cannot keep a
+                 * writer out. */
+                if( ( pxRWLock->xWriter == NULL ) && ( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToWrite ) ) != pdFALSE ) )
+                {
+                    ( pxRWLock->uxReaders )++;
+                    xReturn = pdPASS;
+                }
+                else if( xTicksToWait != ( TickType_t ) 0 )
+                {
+                    if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( pxRWLock->xWriter != NULL )
+                    {
+                        #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                        {
+                            /* Let tasks that later block on a mutex held by this
+                             * task find the writer. */
+                            vTaskSetBlockingMutexHolder( ( TaskHandle_t * ) &( pxRWLock->xWriter ) );
+                        }
+                        #endif
+
+                        if( xTaskPriorityInherit( pxRWLock->xWriter ) != pdFALSE )
+                        {
+                            xInheritanceOccurred = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceBLOCKING_ON_RWLOCK_READ( pxRWLock );
+                    vTaskPlaceOnEventList( &( pxRWLock->xTasksWaitingToRead ), xTicksToWait );
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( ( xReturn != pdFAIL ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+            {
+                /* This task is running again, so is no longer blocked on the
+                 * lock. */
+                taskENTER_CRITICAL();
+                {
+                    vTaskSetBlockingMutexHolder( NULL );
+                }
+                taskEXIT_CRITICAL();
+            }
+            #endif
+
+            /* The task that gave the lock unblocked this task without taking
+             * the lock for it, so try again, but only once more if the block
+             * time has expired. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xTicksToWait = ( TickType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( xReturn != pdFAIL )
+        {
+            traceRWLOCK_TAKE_READ( pxRWLock );
+        }
+        else
+        {
+            if( xEntryTimeSet != pdFALSE )
+            {
+                prvCleanUpAfterTimeout( pxRWLock, xInheritanceOccurred );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRWLOCK_TAKE_READ_FAILED( pxRWLock );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock )
+    {
+        RWLock_t * const pxRWLock = xRWLock;
+        BaseType_t xReturn = pdFAIL;
+
+        configASSERT( pxRWLock );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxRWLock->uxReaders > ( UBaseType_t ) 0U )
+            {
+                ( pxRWLock->uxReaders )--;
+                xReturn = pdPASS;
+                traceRWLOCK_GIVE_READ( pxRWLock );
+
+                if( ( pxRWLock->uxReaders == ( UBaseType_t ) 0U ) && ( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToWrite ) ) == pdFALSE ) )
+                {
+                    if( prvHandOffToWriter( pxRWLock ) != pdFALSE )
+                    {
+                        rwlockYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock,
+                                 TickType_t xTicksToWait )
+    {
+        RWLock_t * const pxRWLock = xRWLock;
+        TaskHandle_t const xCurrentTask = xTaskGetCurrentTaskHandle();
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t xEntryTimeSet = pdFALSE;
+        BaseType_t xInheritanceOccurred = pdFALSE;
+        TimeOut_t xTimeOut;
+
+        configASSERT( pxRWLock );
+
+        /* The lock is not recursive. */
+        configASSERT( pxRWLock->xWriter != xCurrentTask );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( pxRWLock->xWriter == xCurrentTask )
+                {
+                    /* The task that gave the lock passed it straight to this
+                     * task, and has already counted it as a held mutex. */
+                    xReturn = pdPASS;
+                }
+                else if( ( pxRWLock->xWriter == NULL ) && ( pxRWLock->uxReaders == ( UBaseType_t ) 0U ) )
+                {
+                    /* Counting the lock as a held mutex lets the writer
+                     * inherit the priority of tasks that block on it. */
+                    pxRWLock->xWriter = pvTaskIncrementMutexHeldCount();
+                    xReturn = pdPASS;
+                }
+                else if( xTicksToWait != ( TickType_t ) 0 )
+                {
+                    if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( pxRWLock->xWriter != NULL )
+                    {
+                        #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                        {
+                            vTaskSetBlockingMutexHolder( ( TaskHandle_t * ) &( pxRWLock->xWriter ) );
+                        }
+                        #endif
+
+                        if( xTaskPriorityInherit( pxRWLock->xWriter ) != pdFALSE )
+                        {
+                            xInheritanceOccurred = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        /* The lock is held by readers, which are not recorded,
+                         * so no priority can be inherited. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceBLOCKING_ON_RWLOCK_WRITE( pxRWLock );
+                    vTaskPlaceOnEventList( &( pxRWLock->xTasksWaitingToWrite ), xTicksToWait );
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( ( xReturn != pdFAIL ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+            {
+                taskENTER_CRITICAL();
+                {
+                    vTaskSetBlockingMutexHolder( NULL );
+                }
+                taskEXIT_CRITICAL();
+            }
+            #endif
+
+            /* A task that was handed the lock finds it holds it on the next
+             * pass, even if its block time expired in the meantime. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xTicksToWait = ( TickType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( xReturn != pdFAIL )
+        {
+            traceRWLOCK_TAKE_WRITE( pxRWLock );
+        }
+        else
+        {
+            if( xEntryTimeSet != pdFALSE )
+            {
+                prvCleanUpAfterTimeout( pxRWLock, xInheritanceOccurred );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRWLOCK_TAKE_WRITE_FAILED( pxRWLock );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock )
+    {
+        RWLock_t * const pxRWLock = xRWLock;
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t xYieldRequired;
+
+        configASSERT( pxRWLock );
+
+        /* Only the writer can change xWriter from its own handle, so it can be
+         * checked outside the critical section. */
+        if( pxRWLock->xWriter == xTaskGetCurrentTaskHandle() )
+        {
+            taskENTER_CRITICAL();
+            {
+                traceRWLOCK_GIVE_WRITE( pxRWLock );
+
+                /* Return to the base priority, if a priority was inherited
+                 * while the lock was held. */
+                xYieldRequired = xTaskPriorityDisinherit( pxRWLock->xWriter );
+                pxRWLock->xWriter = NULL;
+
+                if( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToWrite ) ) == pdFALSE )
+                {
+                    if( prvHandOffToWriter( pxRWLock ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( prvUnblockReaders( pxRWLock ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xYieldRequired != pdFALSE )
+                {
+                    rwlockYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock )
+    {
+        const RWLock_t * const pxRWLock = xRWLock;
+
+        configASSERT( pxRWLock );
+
+        return pxRWLock->uxReaders;
+    }
+/*-----------------------------------------------------------*/
+
+    TaskHandle_t xRWLockGetWriteHolder( RWLockHandle_t xRWLock )
+    {
+        const RWLock_t * const pxRWLock = xRWLock;
+
+        configASSERT( pxRWLock );
+
+        return pxRWLock->xWriter;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvUnblockReaders( RWLock_t * const pxRWLock )
+    {
+        BaseType_t xYieldRequired = pdFALSE;
+
+        /* Each woken task is removed from the list, so the loop ends. */
+        while( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToRead ) ) == pdFALSE )
+        {
+            if( xTaskRemoveFromEventList( &( pxRWLock->xTasksWaitingToRead ) ) != pdFALSE )
+            {
+                xYieldRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xYieldRequired;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvHandOffToWriter( RWLock_t * const pxRWLock )
+    {
+        /* Rather than leave the lock free for whichever task runs next, so the
+         * woken writer might find it taken again, pass it straight to the task
+         * at the head of the list of waiting writers.  That task finds it already
+         * holds the lock when it runs. */
+        pxRWLock->xWriter = pvTaskIncrementWaiterMutexHeldCount( &( pxRWLock->xTasksWaitingToWrite ) );
+
+        return xTaskRemoveFromEventList( &( pxRWLock->xTasksWaitingToWrite ) );
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const RWLock_t * const pxRWLock )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+        UBaseType_t uxPriority;
+
+        /* Both lists are stored in priority order, so the task at the head of
+         * each is the highest priority task waiting in it. */
+        if( listCURRENT_LIST_LENGTH( &( pxRWLock->xTasksWaitingToRead ) ) > 0U )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xTasksWaitingToRead ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( listCURRENT_LIST_LENGTH( &( pxRWLock->xTasksWaitingToWrite ) ) > 0U )
+        {
+            uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xTasksWaitingToWrite ) );
+
+            if( uxPriority > uxHighestPriorityOfWaitingTasks )
+            {
+                uxHighestPriorityOfWaitingTasks = uxPriority;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxHighestPriorityOfWaitingTasks;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCleanUpAfterTimeout( RWLock_t * const pxRWLock,
+                                        BaseType_t xInheritanceOccurred )
+    {
+        taskENTER_CRITICAL();
+        {
+            if( xInheritanceOccurred != pdFALSE )
+            {
+                /* This task blocking on the lock caused the writer to inherit
+                 * this task's priority.  Now this task has timed out the priority
+                 * should be disinherited again, but only as low as the next
+                 * highest priority task that is waiting for the same lock. */
+                vTaskPriorityDisinheritAfterTimeout( pxRWLock->xWriter, prvGetDisinheritPriorityAfterTimeout( pxRWLock ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Readers that arrived while this task was waiting to write blocked
+             * to let it in first.  If it was the last writer waiting and the lock
+             * is held by readers, they can now share the lock. */
+            if( ( pxRWLock->xWriter == NULL ) && ( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToWrite ) ) != pdFALSE ) )
+            {
+                if( prvUnblockReaders( pxRWLock ) != pdFALSE )
+                {
+                    rwlockYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+/* This entire source file will be skipped if the application is not configured
+ * to include reader-writer lock functionality.  If you want to include
+ * reader-writer locks then ensure configUSE_RW_LOCKS is set to 1 in
+ * FreeRTOSConfig.h. */
+#endif /* configUSE_RW_LOCKS == 1 */
@@ -98,7 +98,7 @@
     {                                                                                \
         UBaseType_t uxSavedInterruptStatus;                                          \
                                                                                      \
-        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();  \
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();      \
         {                                                                            \
             if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )                     \
             {                                                                        \
@@ -109,7 +109,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToSend = NULL;                       \
             }                                                                        \
         }                                                                            \
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );                 \
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                        \
     }
 #endif /* sbRECEIVE_COMPLETED_FROM_ISR */
 
@@ -175,7 +175,7 @@
     {                                                                                   \
         UBaseType_t uxSavedInterruptStatus;                                             \
                                                                                         \
-        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();     \
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();         \
         {                                                                               \
             if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )                     \
             {                                                                           \
@@ -186,7 +186,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;                       \
             }                                                                           \
         }                                                                               \
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );                    \
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                           \
     }
 #endif /* sbSEND_COMPLETE_FROM_ISR */
 
@@ -304,6 +304,24 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                       size_t xCount,
                                       size_t xTail ) PRIVILEGED_FUNCTION;
 
+/*
+ * Publishes xDataLengthBytes bytes the caller has already written in place at
+ * the location returned by xStreamBufferReserve().  If the stream buffer is
+ * being used as a message buffer then the length of the message is written in
+ * front of the data first.  Returns the number of data bytes published.
+ */
+static size_t prvCommitReservedBytes( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves the tail past bytes the caller has already read in place.  If the
+ * stream buffer is being used as a message buffer then the next message,
+ * including its length, is removed whole.  Returns the number of data bytes
+ * removed.
+ */
+static size_t prvConsumeBytes( StreamBuffer_t * const pxStreamBuffer,
+                               size_t xBytesToConsume ) PRIVILEGED_FUNCTION;
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -1124,6 +1142,351 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+                             void ** ppvData )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xSpace, xNextHead, xReturn;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( ppvData );
+
+    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+    xNextHead = pxStreamBuffer->xHead;
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        /* Leave room in front of the data for the length of the message,
+         * which is not written until the message is committed. */
+        if( xSpace > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+        {
+            xSpace -= sbBYTES_TO_STORE_MESSAGE_LENGTH;
+            xNextHead += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+            if( xNextHead >= pxStreamBuffer->xLength )
+            {
+                xNextHead -= pxStreamBuffer->xLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xSpace = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* The caller writes straight into the storage area, so only the space up
+     * to the point at which the buffer wraps can be handed out.  A stream is
+     * written in more than one piece, but a message cannot be split, so a
+     * message that does not fit must be sent with xStreamBufferSend() to move
+     * the head past the end of the storage area. */
+    xReturn = configMIN( xSpace, pxStreamBuffer->xLength - xNextHead );
+
+    if( xReturn != ( size_t ) 0 )
+    {
+        *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ xNextHead ] );
+    }
+    else
+    {
+        *ppvData = NULL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+                            size_t xDataLengthBytes )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvCommitReservedBytes( pxStreamBuffer, xDataLengthBytes );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                   size_t xDataLengthBytes,
+                                   BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvCommitReservedBytes( pxStreamBuffer, xDataLengthBytes );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCommitReservedBytes( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xDataLengthBytes )
+{
+    size_t xNextHead = pxStreamBuffer->xHead;
+    configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
+
+    if( xDataLengthBytes != ( size_t ) 0 )
+    {
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* Ensure the data length given fits within
+             * configMESSAGE_BUFFER_LENGTH_TYPE, and that the message and its
+             * length were reserved. */
+            xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+            configASSERT( ( size_t ) xMessageLength == xDataLengthBytes );
+            configASSERT( ( xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH ) <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+            /* The data is already in place, so the length is written into the
+             * bytes that were left in front of it. */
+            xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+        }
+        else
+        {
+            configASSERT( xDataLengthBytes <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+        }
+
+        /* xStreamBufferReserve() never hands out space that wraps. */
+        configASSERT( ( xNextHead + xDataLengthBytes ) <= pxStreamBuffer->xLength );
+
+        xNextHead += xDataLengthBytes;
+
+        if( xNextHead >= pxStreamBuffer->xLength )
+        {
+            xNextHead -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Only now does the reader see the new data. */
+        pxStreamBuffer->xHead = xNextHead;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+                                    void ** ppvData )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn, xBytesAvailable;
+    size_t xNextTail;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( ppvData );
+
+    *ppvData = NULL;
+    xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+    xNextTail = pxStreamBuffer->xTail;
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+        {
+            xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+            xReturn = ( size_t ) xTempNextMessageLength;
+
+            /* A message that was written across the end of the storage area
+             * cannot be read in place, so is reported with a NULL pointer and
+             * must be read with xMessageBufferReceive() instead. */
+            if( ( xNextTail + xReturn ) <= pxStreamBuffer->xLength )
+            {
+                *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ xNextTail ] );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xReturn = 0;
+        }
+    }
+    else
+    {
+        /* Only the bytes up to the point at which the buffer wraps can be
+         * read in place. */
+        xReturn = configMIN( xBytesAvailable, pxStreamBuffer->xLength - xNextTail );
+
+        if( xReturn != ( size_t ) 0 )
+        {
+            *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ xNextTail ] );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                             size_t xBytesToConsume )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvConsumeBytes( pxStreamBuffer, xBytesToConsume );
+
+    /* Was a task waiting for space in the buffer? */
+    if( xReturn != ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReturn );
+        prvRECEIVE_COMPLETED( xStreamBuffer );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xBytesToConsume,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvConsumeBytes( pxStreamBuffer, xBytesToConsume );
+
+    /* Was a task waiting for space in the buffer? */
+    if( xReturn != ( size_t ) 0 )
+    {
+        prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvConsumeBytes( StreamBuffer_t * const pxStreamBuffer,
+                               size_t xBytesToConsume )
+{
+    size_t xBytesAvailable, xNextTail = pxStreamBuffer->xTail;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+
+    xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+        {
+            /* Messages are only ever removed whole, so the length consumed
+             * must be the length returned by xStreamBufferPeekContiguous(). */
+            xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+            configASSERT( xBytesToConsume == ( size_t ) xTempNextMessageLength );
+            xBytesToConsume = ( size_t ) xTempNextMessageLength;
+        }
+        else
+        {
+            xBytesToConsume = 0;
+        }
+    }
+    else
+    {
+        /* A stream of bytes can be consumed across the end of the storage
+         * area, but not past the data that is available. */
+        xBytesToConsume = configMIN( xBytesToConsume, xBytesAvailable );
+    }
+
+    if( xBytesToConsume != ( size_t ) 0 )
+    {
+        xNextTail += xBytesToConsume;
+
+        if( xNextTail >= pxStreamBuffer->xLength )
+        {
+            xNextTail -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Only now does the writer see the space as free. */
+        pxStreamBuffer->xTail = xNextTail;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xBytesToConsume;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
 {
     const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
@@ -1192,7 +1555,7 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 
     configASSERT( pxStreamBuffer );
 
-    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
         if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
         {
@@ -1208,7 +1571,7 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
             xReturn = pdFALSE;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1223,7 +1586,7 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 
     configASSERT( pxStreamBuffer );
 
-    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
         if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
         {
@@ -1239,7 +1602,7 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
             xReturn = pdFALSE;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1261,7 +1624,7 @@ static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
 
     /* Write as many bytes as can be written in the first write. */
     configASSERT( ( xHead + xFirstLength ) <= pxStreamBuffer->xLength );
-    ( void ) memcpy( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    configKERNEL_MEMCPY( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
 
     /* If the number of bytes written was less than the number that could be
      * written in the first write... */
@@ -1269,7 +1632,7 @@ static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
     {
         /* ...then write the remaining bytes to the start of the buffer. */
         configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
-        ( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+        configKERNEL_MEMCPY( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
     }
     else
     {
@@ -1309,14 +1672,14 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
      * read.  Asserts check bounds of read and write. */
     configASSERT( xFirstLength <= xCount );
     configASSERT( ( xTail + xFirstLength ) <= pxStreamBuffer->xLength );
-    ( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    configKERNEL_MEMCPY( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
 
     /* If the total number of wanted bytes is greater than the number
      * that could be read in the first read... */
     if( xCount > xFirstLength )
     {
         /* ...then read the remaining bytes from the start of the buffer. */
-        ( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+        configKERNEL_MEMCPY( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
     }
     else
     {
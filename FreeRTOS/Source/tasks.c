@@ -67,6 +67,52 @@
     #define taskYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
 #endif
 
+#if ( configNUMBER_OF_CORES == 1 )
+    #define taskTASK_IS_RUNNING( pxTCB )    ( ( ( pxTCB ) == pxCurrentTCB ) ? pdTRUE : pdFALSE )
+#else
+
+/* Values that can be assigned to the xTaskRunState member of the TCB.  A
+ * running task holds the index of the core it is running on instead. */
+    #define taskTASK_NOT_RUNNING            ( ( BaseType_t ) -1 )
+    #define taskTASK_SCHEDULED_TO_YIELD     ( ( BaseType_t ) -2 )
+
+    #define taskVALID_CORE_ID( xCoreID )    ( ( ( xCoreID ) >= ( BaseType_t ) 0 ) && ( ( xCoreID ) < ( BaseType_t ) configNUMBER_OF_CORES ) )
+    #define taskTASK_IS_RUNNING( pxTCB )    taskVALID_CORE_ID( ( pxTCB )->xTaskRunState )
+
+/* Ask whichever core is best placed to run pxTCB to reschedule.  When the
+ * cooperative scheduler is being used a newly ready task waits for a core to
+ * yield of its own accord. */
+    #if ( configUSE_PREEMPTION == 0 )
+        #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB )
+        #define taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB )
+    #else
+        #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB )     prvYieldForTask( pxTCB )
+        #define taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB )    prvYieldCore( ( pxTCB )->xTaskRunState )
+    #endif
+
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        #define taskCORE_IS_ALLOWED( pxTCB, xCoreID )    ( ( ( pxTCB )->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) ( xCoreID ) ) ) != 0U )
+    #else
+        #define taskCORE_IS_ALLOWED( pxTCB, xCoreID )    ( pdTRUE )
+    #endif
+#endif /* configNUMBER_OF_CORES */
+
+#if ( ( configNUMBER_OF_CORES == 1 ) || ( configASSERT_DEFINED == 0 ) )
+    #define taskASSERT_SCHEDULER_NOT_SUSPENDED()    configASSERT( uxSchedulerSuspended == 0 )
+#else
+
+/* Another core may legitimately have the scheduler suspended at the time of
+ * the check.  That core holds the task lock while the scheduler is suspended so
+ * the check is made from a critical section, where only a suspension made by
+ * the calling core can be observed. */
+    #define taskASSERT_SCHEDULER_NOT_SUSPENDED()        \
+    {                                                   \
+        taskENTER_CRITICAL();                           \
+        configASSERT( uxSchedulerSuspended == 0U );     \
+        taskEXIT_CRITICAL();                            \
+    }
+#endif
+
 /* Values that can be assigned to the ucNotifyState member of the TCB. */
 #define taskNOT_WAITING_NOTIFICATION              ( ( uint8_t ) 0 ) /* Must be zero as it is the initialised value. */
 #define taskWAITING_NOTIFICATION                  ( ( uint8_t ) 1 )
@@ -78,6 +124,9 @@
  */
 #define tskSTACK_FILL_BYTE                        ( 0xa5U )
 
+/* tskSTACK_FILL_BYTE repeated across a whole stack word. */
+#define tskSTACK_FILL_WORD                        ( ( StackType_t ) ( ( ( StackType_t ) ~( StackType_t ) 0U ) / ( StackType_t ) 0xffU ) * ( StackType_t ) tskSTACK_FILL_BYTE )
+
 /* Bits used to record how a task's stack and TCB were allocated. */
 #define tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB    ( ( uint8_t ) 0 )
 #define tskSTATICALLY_ALLOCATED_STACK_ONLY        ( ( uint8_t ) 1 )
@@ -86,7 +135,7 @@
 /* If any of the following are set then task stacks are filled with a known
  * value so the high water mark can be determined.  If none of the following are
  * set then don't fill the stack so there is no unnecessary dependency on memset. */
-#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) || ( configUSE_STACK_HIGH_WATER_TRACKING == 1 ) )
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    1
 #else
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    0
@@ -133,6 +182,12 @@
 
 /*-----------------------------------------------------------*/
 
+    #if ( configNUMBER_OF_CORES > 1 )
+
+/* Each core selects for itself, skipping tasks that are already running
+ * elsewhere, so the selection is done by a function rather than a macro. */
+        #define taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID )    prvSelectHighestPriorityTask( xCoreID )
+    #else
     #define taskSELECT_HIGHEST_PRIORITY_TASK()                                \
     {                                                                         \
         UBaseType_t uxTopPriority = uxTopReadyPriority;                       \
@@ -149,6 +204,7 @@
         listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
         uxTopReadyPriority = uxTopPriority;                                                   \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK */
+    #endif /* configNUMBER_OF_CORES */
 
 /*-----------------------------------------------------------*/
 
@@ -196,21 +252,101 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 0 )
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
-#define taskSWITCH_DELAYED_LISTS()                                                \
-    {                                                                             \
-        List_t * pxTemp;                                                          \
-                                                                                  \
-        /* The delayed tasks list should be empty when the lists are switched. */ \
-        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );               \
-                                                                                  \
-        pxTemp = pxDelayedTaskList;                                               \
-        pxDelayedTaskList = pxOverflowDelayedTaskList;                            \
-        pxOverflowDelayedTaskList = pxTemp;                                       \
-        xNumOfOverflows++;                                                        \
-        prvResetNextTaskUnblockTime();                                            \
+    #define taskSWITCH_DELAYED_LISTS()                                                \
+    {                                                                                 \
+        List_t * pxTemp;                                                              \
+                                                                                      \
+        /* The delayed tasks list should be empty when the lists are switched. */     \
+        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );                   \
+                                                                                      \
+        pxTemp = pxDelayedTaskList;                                                   \
+        pxDelayedTaskList = pxOverflowDelayedTaskList;                                \
+        pxOverflowDelayedTaskList = pxTemp;                                           \
+        xNumOfOverflows++;                                                            \
+        prvResetNextTaskUnblockTime();                                                \
+    }
+
+/* Delayed tasks are held in wake time order.  pxDelayedList is either
+ * pxDelayedTaskList or, if the wake time has overflowed,
+ * pxOverflowDelayedTaskList. */
+    #define taskADD_TO_DELAYED_LIST( pxDelayedList, pxListItem )    vListInsert( ( pxDelayedList ), ( pxListItem ) )
+
+#else /* configUSE_TIMER_WHEEL */
+
+/* The timer wheel is indexed by wake time modulo the size of each level so has
+ * no overflow list, but xNextTaskUnblockTime never holds a wake time that is
+ * beyond a tick count overflow so must be recalculated when one occurs. */
+    #define taskSWITCH_DELAYED_LISTS()     \
+    {                                      \
+        xNumOfOverflows++;                 \
+        prvResetNextTaskUnblockTime();     \
+    }
+
+/* Delayed tasks are held in the timer wheel slot for their wake time, whether
+ * or not the wake time has overflowed, so pxDelayedList is not used. */
+    #define taskADD_TO_DELAYED_LIST( pxDelayedList, pxListItem )    prvTimerWheelInsert( ( pxListItem ), xTickCount + ( TickType_t ) 1 )
+
+/* Each level of the wheel has a slot for each of 2 ^ configTIMER_WHEEL_SLOT_BITS
+ * consecutive time spans.  A slot on level 0 spans one tick, and a slot on
+ * level n spans a complete revolution of level n - 1.  There are enough levels
+ * to hold any block time a TickType_t can represent. */
+    #define taskTIMER_WHEEL_SLOTS                 ( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+    #define taskTIMER_WHEEL_SLOT_MASK             ( ( TickType_t ) taskTIMER_WHEEL_SLOTS - ( TickType_t ) 1 )
+    #define taskTIMER_WHEEL_LEVELS                ( ( UBaseType_t ) ( ( ( sizeof( TickType_t ) * 8U ) + configTIMER_WHEEL_SLOT_BITS - 1U ) / configTIMER_WHEEL_SLOT_BITS ) )
+    #define taskTIMER_WHEEL_SLOT_TICKS( uxLevel )    ( ( TickType_t ) 1 << ( configTIMER_WHEEL_SLOT_BITS * ( uxLevel ) ) )
+    #define taskTIMER_WHEEL_SLOT_INDEX( xTime, uxLevel )    ( ( UBaseType_t ) ( ( ( xTime ) >> ( configTIMER_WHEEL_SLOT_BITS * ( uxLevel ) ) ) & taskTIMER_WHEEL_SLOT_MASK ) )
+
+#endif /* configUSE_TIMER_WHEEL */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_PERF_COUNTERS == 1 )
+
+/* The scheduling state a task's perf counters are currently accumulating
+ * time against.  Suspended tasks are counted as Blocked. */
+    #define taskPERF_STATE_BLOCKED    ( ( uint8_t ) 0 )
+    #define taskPERF_STATE_READY      ( ( uint8_t ) 1 )
+    #define taskPERF_STATE_RUNNING    ( ( uint8_t ) 2 )
+
+    #define taskPERF_TASK_READY( pxTCB )    prvPerfTaskReady( pxTCB )
+#else
+    #define taskPERF_TASK_READY( pxTCB )
+#endif /* configUSE_TASK_PERF_COUNTERS */
+
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+    #define taskLATENCY_TASK_READY( pxTCB )    prvLatencyTaskReady( pxTCB )
+#else
+    #define taskLATENCY_TASK_READY( pxTCB )
+#endif /* configUSE_LATENCY_HISTOGRAMS */
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+/* Remove a task that is leaving the Blocked state from any event lists it was
+ * placed on by vTaskPlaceOnEventLists().  Must only be used where no event list
+ * can be part way through an update, so not from an interrupt while the
+ * scheduler is suspended. */
+    #define taskREMOVE_FROM_EVENT_LISTS( pxTCB )          \
+    {                                                     \
+        if( ( pxTCB )->pxEventListItems != NULL )         \
+        {                                                 \
+            prvRemoveFromEventLists( pxTCB );             \
+        }                                                 \
     }
+#else
+    #define taskREMOVE_FROM_EVENT_LISTS( pxTCB )
+#endif /* configUSE_QUEUE_RECEIVE_ANY */
+
+/*-----------------------------------------------------------*/
+
+#if ( configSTACK_PRESSURE_THRESHOLD > 0 )
+    #define taskSTACK_PRESSURE_HOOK( pxTCB, uxFreeStack )    vApplicationStackPressureHook( ( TaskHandle_t ) ( pxTCB ), ( uxFreeStack ) )
+#else
+    #define taskSTACK_PRESSURE_HOOK( pxTCB, uxFreeStack )
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -222,6 +358,8 @@
     traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
     taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
     listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+    taskPERF_TASK_READY( pxTCB );                                                                      \
+    taskLATENCY_TASK_READY( pxTCB );                                                                   \
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 /*-----------------------------------------------------------*/
 
@@ -318,6 +456,42 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        volatile BaseType_t xTaskRunState; /*< Set to the index of the core the task is running on, taskTASK_NOT_RUNNING, or taskTASK_SCHEDULED_TO_YIELD. */
+    #endif
+
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        UBaseType_t uxCoreAffinityMask; /*< Bit N is set if the task is allowed to run on core N. */
+    #endif
+
+    #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulPerfRunTime;     /*< Time spent in the Running state, charged when the task leaves that state. */
+        configRUN_TIME_COUNTER_TYPE ulPerfReadyTime;   /*< Time spent in the Ready state, charged when the task leaves that state. */
+        configRUN_TIME_COUNTER_TYPE ulPerfBlockedTime; /*< Time spent Blocked or Suspended, charged when the task leaves that state. */
+        configRUN_TIME_COUNTER_TYPE ulPerfStateTime;   /*< The run time counter value when the task entered ucPerfState. */
+        UBaseType_t uxPerfSwitchesIn;                  /*< The number of times the task has been switched in. */
+        volatile UBaseType_t uxPerfSequence;           /*< Odd while the members above are being updated so readers can detect a torn copy. */
+        uint8_t ucPerfState;                           /*< One of the taskPERF_STATE_ values. */
+    #endif
+
+    #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+        TaskHandle_t * pxBlockingMutexHolder; /*< Points to the holder of the mutex the task is blocked on, or NULL if the task is not waiting for a mutex. */
+    #endif
+
+    #if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 )
+        StackType_t * pxStackHighWater; /*< The deepest stack word the task is known to have used.  Only ever moves towards the end of the stack. */
+    #endif
+
+    #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulLatencyReadyTime; /*< The run time counter value when the task was last moved to the Ready state. */
+        uint8_t ucLatencyPending;                       /*< pdTRUE from the task being moved to the Ready state until it is next switched in. */
+    #endif
+
+    #if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+        ListItem_t * pxEventListItems; /*< While the task is blocked by vTaskPlaceOnEventLists(), the items that reference it from each event list.  NULL otherwise. */
+        UBaseType_t uxEventListItems;  /*< The number of items pxEventListItems points to. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -326,17 +500,30 @@ typedef tskTCB TCB_t;
 
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
-portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if ( configNUMBER_OF_CORES == 1 )
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#else
+
+/* The task running on each core.  Within this file pxCurrentTCB refers to the
+ * task running on the calling core. */
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ];
+    #define pxCurrentTCB    xTaskGetCurrentTaskHandle()
+#endif
 
 /* Lists for ready and blocked tasks. --------------------
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if ( configUSE_TIMER_WHEEL == 0 )
+    PRIVILEGED_DATA static List_t xDelayedTaskList1;                     /*< Delayed tasks. */
+    PRIVILEGED_DATA static List_t xDelayedTaskList2;                     /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+    PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;  /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#else
+    PRIVILEGED_DATA static List_t xTimerWheel[ taskTIMER_WHEEL_LEVELS ][ taskTIMER_WHEEL_SLOTS ]; /*< Delayed tasks, in the slot for their wake time on the lowest level that can hold it. */
+    PRIVILEGED_DATA static uint32_t ulTimerWheelOccupied[ taskTIMER_WHEEL_LEVELS ];                /*< A bit for each slot that may hold a task.  Bits are only cleared when the slot is found to be empty. */
+#endif
+PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used, or with the timer wheel, to the slot holding the tasks due to unblock on the current tick. */
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -364,11 +551,19 @@ PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINI
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#if ( configNUMBER_OF_CORES == 1 )
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#else
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ] = { pdFALSE };
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows = ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                          /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#if ( configNUMBER_OF_CORES == 1 )
+    PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                      /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#else
+    PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ]; /*< Holds the handle of the idle task of each core.  The idle tasks are created automatically when the scheduler is started. */
+#endif
 
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
@@ -389,11 +584,57 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 /* Do not move these variables to function scope as doing so prevents the
  * code working with debuggers that need to remove the static qualifier. */
-    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;    /*< Holds the value of a timer/counter the last time a task was switched in. */
+    #if ( configNUMBER_OF_CORES == 1 )
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;                                 /*< Holds the value of a timer/counter the last time a task was switched in. */
+    #else
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime[ configNUMBER_OF_CORES ] = { 0UL }; /*< Holds the value of a timer/counter the last time a task was switched in on each core. */
+    #endif
     PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL; /*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
 
+#if ( configUSE_TASK_PERF_COUNTERS == 1 )
+
+/* The per core counters returned by vTaskGetCorePerfCounters().  Written
+ * only by the core itself from vTaskSwitchContext(), and guarded by the same
+ * sequence scheme as the per task counters. */
+    typedef struct xCORE_PERF_STATE
+    {
+        configRUN_TIME_COUNTER_TYPE ulIdleTime;       /*< Idle time up to ulLastSwitchTime. */
+        configRUN_TIME_COUNTER_TYPE ulLastSwitchTime; /*< The run time counter value at the last context switch. */
+        UBaseType_t uxContextSwitches;
+        volatile UBaseType_t uxSequence;
+        BaseType_t xIdleRunning;                      /*< pdTRUE if the task switched in at ulLastSwitchTime is an idle task. */
+    } CorePerfState_t;
+
+    PRIVILEGED_DATA static CorePerfState_t xCorePerfStates[ configNUMBER_OF_CORES ];
+
+#endif
+
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+
+/* The histograms returned by vTaskGetLatencyHistogram(), indexed by
+ * eLatencyHistogram then by priority.  A histogram is only written with the
+ * kernel data structures locked against other writers, and is guarded by the
+ * same sequence scheme as the perf counters so it can be read at any time. */
+    typedef struct xLATENCY_HISTOGRAM_STATE
+    {
+        LatencyHistogram_t xHistogram;
+        volatile UBaseType_t uxSequence;
+    } LatencyHistogramState_t;
+
+    PRIVILEGED_DATA static LatencyHistogramState_t xLatencyHistograms[ 2 ][ configMAX_PRIORITIES ];
+
+/* The run time counter value at which the outermost critical section on each
+ * core was entered, and the priority of the task that entered it.
+ * xCriticalEntryRecorded is pdFALSE if the entry was not recorded because the
+ * scheduler was not running. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulCriticalEntryTime[ configNUMBER_OF_CORES ];
+    PRIVILEGED_DATA static UBaseType_t uxCriticalEntryPriority[ configNUMBER_OF_CORES ];
+    PRIVILEGED_DATA static BaseType_t xCriticalEntryRecorded[ configNUMBER_OF_CORES ];
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -430,6 +671,65 @@ static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
  */
 static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * The idle task created for each core other than core 0.  Only the idle task
+ * of core 0 frees deleted tasks and calls the idle hook, the others just keep
+ * their core occupied until there is something better for it to do.
+ */
+    static portTASK_FUNCTION_PROTO( prvPassiveIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Selects the highest priority ready task that is not already running on
+ * another core, and that is allowed to run on core xCoreID, as the task to run
+ * on core xCoreID.
+ */
+    static void prvSelectHighestPriorityTask( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when pxTCB becomes able to run.  Requests a yield on the core that is
+ * running the lowest priority task that pxTCB could preempt, if any.  Must be
+ * called from a critical section.
+ */
+    static void prvYieldForTask( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Requests that core xCoreID reschedules.  The yield is held pending if
+ * xCoreID is the calling core, as this is always called with the ISR lock held,
+ * otherwise the core is interrupted.
+ */
+    static void prvYieldCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called on entry to a critical section, and when the scheduler is suspended,
+ * to let a pending yield request from another core take effect before the
+ * calling task - which may have been deleted or suspended by that core -
+ * continues.
+ */
+    static void prvCheckForRunStateChange( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pxTCB is the idle task of one of the cores, otherwise
+ * pdFALSE.
+ */
+    static BaseType_t prvIsIdleTask( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the priority of pxTCB as seen by the core selection logic.  Idle
+ * tasks are treated as running one level below tskIDLE_PRIORITY so any other
+ * ready task, even one at the idle priority, preempts them first.
+ */
+    static BaseType_t prvGetSchedulingPriority( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Creates one idle task per core - the idle task for core 0 and a passive idle
+ * task for each of the other cores.
+ */
+    static BaseType_t prvCreateIdleTasks( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES */
+
 /*
  * Utility to free all memory allocated by the scheduler to hold a TCB,
  * including the stack pointed to by the TCB.
@@ -495,6 +795,25 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+#if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 )
+
+/*
+ * Move the stack high water mark of pxTCB to pxStackUsed if pxStackUsed is
+ * deeper into the stack.  Returns pdTRUE if the mark moved and now leaves
+ * configSTACK_PRESSURE_THRESHOLD words or fewer unused, in which case the
+ * caller must call vApplicationStackPressureHook().  Must be called from a
+ * critical section or from vTaskSwitchContext().
+ */
+    static BaseType_t prvStackHighWaterUpdate( TCB_t * pxTCB,
+                                               StackType_t * pxStackUsed ) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of stack words beyond the stack high water mark of pxTCB.
+ */
+    static configSTACK_DEPTH_TYPE prvStackHighWaterFree( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Return the amount of time, in ticks, that will pass before the kernel will
  * next move a task from the Blocked state to the Running state.
@@ -516,6 +835,38 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Place a delayed task's state list item, which holds the task's wake time, in
+ * the timer wheel.  xNextTick is the first tick that has not yet been processed
+ * by xTaskIncrementTick().
+ */
+    static void prvTimerWheelInsert( ListItem_t * const pxListItem,
+                                     const TickType_t xNextTick ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by xTaskIncrementTick() for each tick.  Moves tasks down from the
+ * higher levels of the timer wheel as the lower levels complete a revolution,
+ * then sets pxDelayedTaskList to the slot holding the tasks that are due to
+ * unblock on xTick.
+ */
+    static void prvTimerWheelAdvance( const TickType_t xTick ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+
+/*
+ * Called by vTaskStepTick() in place of calling prvTimerWheelAdvance() for each
+ * tick after xFromTick up to and including xToTick.  No task unblocks on those
+ * ticks, so only the tasks that would have been moved down from the higher
+ * levels of the wheel are moved, each once.
+ */
+        static void prvTimerWheelStep( const TickType_t xFromTick,
+                                       const TickType_t xToTick ) PRIVILEGED_FUNCTION;
+    #endif
+
+#endif
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -527,6 +878,117 @@ static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( ( configUSE_TASK_PERF_COUNTERS == 1 ) || ( configUSE_LATENCY_HISTOGRAMS == 1 ) )
+
+/*
+ * Returns the current value of the run time stats clock.
+ */
+    static configRUN_TIME_COUNTER_TYPE prvPerfGetTime( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_PERF_COUNTERS == 1 )
+
+/*
+ * Charge the time pxTCB has spent in its current perf state to the matching
+ * counter, then move the task to ucNewState.  Must be called with the kernel
+ * data structures locked against other writers.
+ */
+    static void prvPerfSetTaskState( TCB_t * pxTCB,
+                                     uint8_t ucNewState,
+                                     configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when a task is added to a ready list.  A task that is already
+ * running, for example one whose priority is being changed, stays Running.
+ */
+    static void prvPerfTaskReady( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from vTaskSwitchContext() after a new task has been selected to run
+ * on xCoreID.
+ */
+    static void prvPerfRecordSwitch( BaseType_t xCoreID,
+                                     TCB_t * pxOldTCB,
+                                     TCB_t * pxNewTCB,
+                                     configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+
+/*
+ * Called when a task is added to a ready list.  Notes the time, unless the task
+ * is running or is already waiting to run.
+ */
+    static void prvLatencyTaskReady( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from vTaskSwitchContext() after pxTCB has been selected to run.
+ * Records the time it waited in the Ready state, if it was moved to the Ready
+ * state since it last ran.
+ */
+    static void prvLatencyTaskSwitchedIn( TCB_t * pxTCB,
+                                          configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Count ulLatency in the bucket of pxState that covers it.  Must be called with
+ * the kernel data structures locked against other writers.
+ */
+    static void prvLatencyRecord( LatencyHistogramState_t * pxState,
+                                  configRUN_TIME_COUNTER_TYPE ulLatency ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+/*
+ * Remove the items placed by vTaskPlaceOnEventLists() from whichever event lists
+ * still contain them.
+ */
+    static void prvRemoveFromEventLists( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by xTaskRemoveFromEventList() when the head of pxEventList is an item
+ * placed by vTaskPlaceOnEventLists().  Removes the head item and returns its
+ * task, skipping the items of tasks that have already been unblocked.  Returns
+ * NULL if pxEventList only held the items of tasks already unblocked.
+ */
+    static TCB_t * prvRemoveEventListsHead( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_MUTEXES == 1 )
+
+/*
+ * Raises the priority of pxTCB, which holds a mutex, to the priority of the
+ * calling task.
+ */
+    static void prvInheritPriority( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Performs vTaskPriorityDisinheritAfterTimeout() for one mutex holder.  When
+ * configUSE_TRANSITIVE_PRIORITY_INHERITANCE is 1 and the priority of pxTCB was
+ * lowered while pxTCB is itself blocked on a mutex, returns the holder of that
+ * mutex and sets *puxNextHighestPriorityWaitingTask to the priority that holder
+ * may need to keep.  Otherwise returns NULL.
+ */
+    static TCB_t * prvDisinheritPriorityAfterTimeout( TCB_t * const pxTCB,
+                                                      UBaseType_t uxHighestPriorityWaitingTask,
+                                                      UBaseType_t * const puxNextHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+/*
+ * Moves the event list item of pxTCB, which is blocked on a mutex, to the
+ * position in the mutex's list of waiting tasks that matches its priority.
+ */
+    static void prvResortMutexWaiter( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Called after a Task_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -559,64 +1021,522 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
 /*-----------------------------------------------------------*/
 
-#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    TaskHandle_t xTaskCreateStatic( TaskFunction_t pxTaskCode,
-                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                                    const uint32_t ulStackDepth,
-                                    void * const pvParameters,
-                                    UBaseType_t uxPriority,
-                                    StackType_t * const puxStackBuffer,
-                                    StaticTask_t * const pxTaskBuffer )
+    static void prvCheckForRunStateChange( void )
     {
-        TCB_t * pxNewTCB;
-        TaskHandle_t xReturn;
+        UBaseType_t uxPrevCriticalNesting;
+        const TCB_t * pxThisTCB;
 
-        configASSERT( puxStackBuffer != NULL );
-        configASSERT( pxTaskBuffer != NULL );
+        /* This must only be called from within a task. */
+        portASSERT_IF_IN_ISR();
 
-        #if ( configASSERT_DEFINED == 1 )
-        {
-            /* Sanity check that the size of the structure used to declare a
-             * variable of type StaticTask_t equals the size of the real task
-             * structure. */
-            volatile size_t xSize = sizeof( StaticTask_t );
-            configASSERT( xSize == sizeof( TCB_t ) );
-            ( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
-        }
-        #endif /* configASSERT_DEFINED */
+        /* This function is always called with interrupts disabled so the
+         * calling task cannot move between cores. */
+        pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
 
-        if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
+        while( pxThisTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD )
         {
-            /* The memory used for the task's TCB and stack are passed into this
-             * function - use them. */
-            pxNewTCB = ( TCB_t * ) pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
-            memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
-            pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
+            /* Another core asked this task to yield just before it entered a
+             * critical section or suspended the scheduler.  Give up the locks,
+             * and the critical nesting count, long enough for the yield
+             * interrupt to be taken, then take everything back.  Repeat if the
+             * state changed again while the locks were being retaken. */
+            uxPrevCriticalNesting = portGET_CRITICAL_NESTING_COUNT();
 
-            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+            if( uxPrevCriticalNesting > 0U )
             {
-                /* Tasks can be created statically or dynamically, so note this
-                 * task was created statically in case the task is later deleted. */
-                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+                portSET_CRITICAL_NESTING_COUNT( 0U );
+                portRELEASE_ISR_LOCK();
+            }
+            else
+            {
+                /* The scheduler is being suspended, so only the task lock is
+                 * held. */
+                mtCOVERAGE_TEST_MARKER();
             }
-            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
-            prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL );
-            prvAddNewTaskToReadyList( pxNewTCB );
+            portRELEASE_TASK_LOCK();
+            portMEMORY_BARRIER();
+            configASSERT( pxThisTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD );
+
+            portENABLE_INTERRUPTS();
+
+            /* Enabling interrupts must have caused the pending yield to be
+             * taken. */
+            configASSERT( pxThisTCB->xTaskRunState != taskTASK_SCHEDULED_TO_YIELD );
+
+            portDISABLE_INTERRUPTS();
+            portGET_TASK_LOCK();
+            portGET_ISR_LOCK();
+
+            portSET_CRITICAL_NESTING_COUNT( uxPrevCriticalNesting );
+
+            if( uxPrevCriticalNesting == 0U )
+            {
+                portRELEASE_ISR_LOCK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvYieldCore( BaseType_t xCoreID )
+    {
+        /* This must be called with the ISR lock held.  A task that is not
+         * running has no core to yield, so invalid core IDs are ignored. */
+        if( ( xSchedulerRunning != pdFALSE ) && ( taskVALID_CORE_ID( xCoreID ) != pdFALSE ) )
+        {
+            if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+            {
+                /* The calling core is in a critical section so the yield is
+                 * taken when the critical section is exited. */
+                xYieldPendings[ xCoreID ] = pdTRUE;
+            }
+            else if( pxCurrentTCBs[ xCoreID ]->xTaskRunState != taskTASK_SCHEDULED_TO_YIELD )
+            {
+                /* Interrupt the other core, unless it has already been asked
+                 * to yield and has not done so yet. */
+                portYIELD_CORE( xCoreID );
+                pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_SCHEDULED_TO_YIELD;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
-            xReturn = NULL;
+            mtCOVERAGE_TEST_MARKER();
         }
-
-        return xReturn;
     }
 
-#endif /* SUPPORT_STATIC_ALLOCATION */
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
-#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static BaseType_t prvIsIdleTask( const TCB_t * pxTCB )
+    {
+        BaseType_t xReturn = pdFALSE;
+        BaseType_t xCoreID;
+
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            if( pxTCB == xIdleTaskHandles[ xCoreID ] )
+            {
+                xReturn = pdTRUE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static BaseType_t prvGetSchedulingPriority( const TCB_t * pxTCB )
+    {
+        BaseType_t xPriority = ( BaseType_t ) pxTCB->uxPriority;
+
+        if( prvIsIdleTask( pxTCB ) != pdFALSE )
+        {
+            xPriority--;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xPriority;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvYieldForTask( const TCB_t * pxTCB )
+    {
+        BaseType_t xLowestPriorityToPreempt;
+        BaseType_t xCurrentCoreTaskPriority;
+        BaseType_t xLowestPriorityCore = ( BaseType_t ) -1;
+        BaseType_t xCoreID;
+
+        /* This must be called from a critical section. */
+        configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+        /* A task that is already running, or is still on a core pending a
+         * yield, does not need another core.  When only one priority may run
+         * at a time a task below the top ready priority cannot take a core
+         * either, even one that is running its idle task. */
+        #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+            if( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) && ( pxTCB->uxPriority >= uxTopReadyPriority ) )
+        #else
+            if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+        #endif
+        {
+            /* Look for the core running the lowest priority task that pxTCB
+             * can preempt.  The search starts one below pxTCB's priority, which
+             * is -1 for a task at the idle priority - the idle tasks themselves
+             * are treated as running at -1 so they are always preempted. */
+            xLowestPriorityToPreempt = ( BaseType_t ) pxTCB->uxPriority;
+            --xLowestPriorityToPreempt;
+
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                xCurrentCoreTaskPriority = prvGetSchedulingPriority( pxCurrentTCBs[ xCoreID ] );
+
+                /* Cores that are already switching context are skipped as they
+                 * will pick up pxTCB anyway if it is the best choice. */
+                if( ( taskTASK_IS_RUNNING( pxCurrentTCBs[ xCoreID ] ) != pdFALSE ) &&
+                    ( xYieldPendings[ xCoreID ] == pdFALSE ) &&
+                    ( xCurrentCoreTaskPriority <= xLowestPriorityToPreempt ) &&
+                    ( taskCORE_IS_ALLOWED( pxTCB, xCoreID ) != pdFALSE ) )
+                {
+                    xLowestPriorityToPreempt = xCurrentCoreTaskPriority;
+                    xLowestPriorityCore = xCoreID;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( xLowestPriorityCore >= 0 )
+            {
+                prvYieldCore( xLowestPriorityCore );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
+    {
+        UBaseType_t uxCurrentPriority = uxTopReadyPriority;
+        BaseType_t xTaskScheduled = pdFALSE;
+        BaseType_t xDecrementTopPriority = pdTRUE;
+        TCB_t * pxTCB;
+
+        #if ( configUSE_CORE_AFFINITY == 1 )
+            const TCB_t * pxPreviousTCB = NULL;
+        #endif
+
+        #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+            const UBaseType_t uxTopPriorityOnEntry = uxTopReadyPriority;
+        #endif
+
+        /* A running task that yields is still in its ready list, and ahead of
+         * any task of equal priority added to the list since it started to run.
+         * Move it to the end of its ready list first so equal priority tasks
+         * take it in turns. */
+        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ),
+                                     &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) ) != pdFALSE )
+        {
+            ( void ) uxListRemove( &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) );
+            vListInsertEnd( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ),
+                            &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        while( xTaskScheduled == pdFALSE )
+        {
+            #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+            {
+                /* Only tasks of the top ready priority may run.  If they are
+                 * all running already, or not allowed on this core, the core
+                 * runs its idle task instead. */
+                if( uxCurrentPriority < uxTopReadyPriority )
+                {
+                    uxCurrentPriority = tskIDLE_PRIORITY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configRUN_MULTIPLE_PRIORITIES */
+
+            if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxCurrentPriority ] ) ) == pdFALSE )
+            {
+                const List_t * const pxReadyList = &( pxReadyTasksLists[ uxCurrentPriority ] );
+                const ListItem_t * pxEndMarker = listGET_END_MARKER( pxReadyList );
+                ListItem_t * pxIterator;
+
+                /* The ready list for uxCurrentPriority is not empty, so
+                 * uxTopReadyPriority must not be decremented any further. */
+                xDecrementTopPriority = pdFALSE;
+
+                for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+                {
+                    pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                    if( taskCORE_IS_ALLOWED( pxTCB, xCoreID ) == pdFALSE )
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+                        else if( ( uxCurrentPriority < uxTopReadyPriority ) && ( prvIsIdleTask( pxTCB ) == pdFALSE ) )
+                        {
+                            /* Fallen back to the idle priority - skip the
+                             * application tasks that share it. */
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    #endif
+                    else if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+                    {
+                        /* The task is not running on any core - swap it in. */
+                        pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+
+                        #if ( configUSE_CORE_AFFINITY == 1 )
+                            pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+                        #endif
+
+                        pxTCB->xTaskRunState = xCoreID;
+                        pxCurrentTCBs[ xCoreID ] = pxTCB;
+                        xTaskScheduled = pdTRUE;
+                    }
+                    else if( pxTCB == pxCurrentTCBs[ xCoreID ] )
+                    {
+                        /* The task is already running on this core, and may
+                         * have been asked to yield - keep it running. */
+                        configASSERT( ( pxTCB->xTaskRunState == xCoreID ) || ( pxTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD ) );
+                        pxTCB->xTaskRunState = xCoreID;
+                        xTaskScheduled = pdTRUE;
+                    }
+                    else
+                    {
+                        /* The task is running on another core. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xTaskScheduled != pdFALSE )
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else
+            {
+                if( xDecrementTopPriority != pdFALSE )
+                {
+                    uxTopReadyPriority--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            /* There is an idle task for every core so a task is always found by
+             * the time tskIDLE_PRIORITY is reached - the check just stops
+             * uxCurrentPriority wrapping if this is called before the idle
+             * tasks exist. */
+            if( uxCurrentPriority > tskIDLE_PRIORITY )
+            {
+                uxCurrentPriority--;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        configASSERT( xTaskScheduled != pdFALSE );
+
+        #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+        {
+            BaseType_t x;
+
+            /* Evict any application task running below the top ready priority
+             * from the other cores.  If the top ready priority dropped while
+             * selecting, the cores that were held on their idle task may now
+             * run the tasks of the new top priority, so reschedule those too. */
+            for( x = 0; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
+            {
+                if( ( x != xCoreID ) &&
+                    ( taskTASK_IS_RUNNING( pxCurrentTCBs[ x ] ) != pdFALSE ) &&
+                    ( xYieldPendings[ x ] == pdFALSE ) )
+                {
+                    if( prvIsIdleTask( pxCurrentTCBs[ x ] ) == pdFALSE )
+                    {
+                        if( pxCurrentTCBs[ x ]->uxPriority < uxTopReadyPriority )
+                        {
+                            prvYieldCore( x );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else if( uxTopReadyPriority < uxTopPriorityOnEntry )
+                    {
+                        prvYieldCore( x );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        #endif /* configRUN_MULTIPLE_PRIORITIES */
+
+        #if ( configUSE_CORE_AFFINITY == 1 )
+        {
+            if( ( pxPreviousTCB != NULL ) &&
+                ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                /* A ready task was just evicted from this core.  It can only
+                 * displace a task on a core that the task that evicted it is
+                 * not allowed to run on - all the other cores are already
+                 * running tasks at least as important as the evicting task. */
+                UBaseType_t uxCoreMap = pxPreviousTCB->uxCoreAffinityMask & ~( pxCurrentTCBs[ xCoreID ]->uxCoreAffinityMask );
+                BaseType_t xLowestPriority = prvGetSchedulingPriority( pxPreviousTCB );
+                BaseType_t xLowestPriorityCore = ( BaseType_t ) -1;
+                BaseType_t xTaskPriority;
+                BaseType_t x;
+
+                for( x = 0; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
+                {
+                    if( ( uxCoreMap & ( ( UBaseType_t ) 1U << ( UBaseType_t ) x ) ) != 0U )
+                    {
+                        xTaskPriority = prvGetSchedulingPriority( pxCurrentTCBs[ x ] );
+
+                        if( ( xTaskPriority < xLowestPriority ) &&
+                            ( taskTASK_IS_RUNNING( pxCurrentTCBs[ x ] ) != pdFALSE ) &&
+                            ( xYieldPendings[ x ] == pdFALSE ) )
+                        {
+                            xLowestPriority = xTaskPriority;
+                            xLowestPriorityCore = x;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( xLowestPriorityCore >= 0 )
+                {
+                    prvYieldCore( xLowestPriorityCore );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_CORE_AFFINITY */
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    TaskHandle_t xTaskCreateStatic( TaskFunction_t pxTaskCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const uint32_t ulStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    StackType_t * const puxStackBuffer,
+                                    StaticTask_t * const pxTaskBuffer )
+    {
+        TCB_t * pxNewTCB;
+        TaskHandle_t xReturn;
+
+        configASSERT( puxStackBuffer != NULL );
+        configASSERT( pxTaskBuffer != NULL );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticTask_t equals the size of the real task
+             * structure. */
+            volatile size_t xSize = sizeof( StaticTask_t );
+            configASSERT( xSize == sizeof( TCB_t ) );
+            ( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
+        }
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
+        {
+            /* The memory used for the task's TCB and stack are passed into this
+             * function - use them. */
+            pxNewTCB = ( TCB_t * ) pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+            memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+            pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
+
+            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+            {
+                /* Tasks can be created statically or dynamically, so note this
+                 * task was created statically in case the task is later deleted. */
+                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+            }
+            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+            prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL );
+            prvAddNewTaskToReadyList( pxNewTCB );
+        }
+        else
+        {
+            xReturn = NULL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* SUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
     BaseType_t xTaskCreateRestrictedStatic( const TaskParameters_t * const pxTaskDefinition,
                                             TaskHandle_t * pxCreatedTask )
@@ -929,6 +1849,28 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     }
     #endif /* configUSE_MUTEXES */
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+    }
+    #endif /* configNUMBER_OF_CORES */
+
+    #if ( configUSE_CORE_AFFINITY == 1 )
+    {
+        pxNewTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+    }
+    #endif /* configUSE_CORE_AFFINITY */
+
+    #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+    {
+        /* The counters were zeroed with the rest of the TCB.  Start the task
+         * in the Ready state so no blocked time is charged before it is first
+         * added to a ready list. */
+        pxNewTCB->ulPerfStateTime = prvPerfGetTime();
+        pxNewTCB->ucPerfState = taskPERF_STATE_READY;
+    }
+    #endif /* configUSE_TASK_PERF_COUNTERS */
+
     vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
     vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -1010,6 +1952,13 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     }
     #endif /* portUSING_MPU_WRAPPERS */
 
+    #if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 )
+    {
+        /* The initial context is the only part of the stack known to be used. */
+        pxNewTCB->pxStackHighWater = ( StackType_t * ) pxNewTCB->pxTopOfStack;
+    }
+    #endif /* configUSE_STACK_HIGH_WATER_TRACKING */
+
     if( pxCreatedTask != NULL )
     {
         /* Pass the handle out in an anonymous way.  The handle can be used to
@@ -1031,6 +1980,20 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         uxCurrentNumberOfTasks++;
 
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            /* Each core starts by running its own idle task, so there is no
+             * current task to track before the scheduler is started. */
+            if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+            {
+                prvInitialiseTaskLists();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* configNUMBER_OF_CORES */
         if( pxCurrentTCB == NULL )
         {
             /* There are no other tasks, or all the other tasks are in
@@ -1070,6 +2033,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
         }
+        #endif /* configNUMBER_OF_CORES */
 
         uxTaskNumber++;
 
@@ -1084,26 +2048,45 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         prvAddTaskToReadyList( pxNewTCB );
 
         portSETUP_TCB( pxNewTCB );
+
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            /* If the created task is of a higher priority than a task running
+             * on any core it can use then that core should run it now. */
+            if( xSchedulerRunning != pdFALSE )
+            {
+                taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxNewTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configNUMBER_OF_CORES */
     }
     taskEXIT_CRITICAL();
 
-    if( xSchedulerRunning != pdFALSE )
+    #if ( configNUMBER_OF_CORES == 1 )
     {
-        /* If the created task is of a higher priority than the current task
-         * then it should run now. */
-        if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+        if( xSchedulerRunning != pdFALSE )
         {
-            taskYIELD_IF_USING_PREEMPTION();
+            /* If the created task is of a higher priority than the current task
+             * then it should run now. */
+            if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+            {
+                taskYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
     }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -1112,6 +2095,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     void vTaskDelete( TaskHandle_t xTaskToDelete )
     {
         TCB_t * pxTCB;
+        BaseType_t xTaskIsRunning;
 
         taskENTER_CRITICAL();
         {
@@ -1139,13 +2123,27 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            taskREMOVE_FROM_EVENT_LISTS( pxTCB );
+
             /* Increment the uxTaskNumber also so kernel aware debuggers can
              * detect that the task lists need re-generating.  This is done before
              * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
              * not return. */
             uxTaskNumber++;
 
-            if( pxTCB == pxCurrentTCB )
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                xTaskIsRunning = ( pxTCB == pxCurrentTCB ) ? pdTRUE : pdFALSE;
+            }
+            #else
+            {
+                /* A task that has been asked to yield is still executing on its
+                 * core until the yield is taken, so cannot be freed yet either. */
+                xTaskIsRunning = ( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING ) ? pdTRUE : pdFALSE;
+            }
+            #endif /* configNUMBER_OF_CORES */
+
+            if( xTaskIsRunning != pdFALSE )
             {
                 /* A task is deleting itself.  This cannot complete within the
                  * task itself, as a context switch to another task is required.
@@ -1168,7 +2166,28 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * after which it is not possible to yield away from this task -
                  * hence xYieldPending is used to latch that a context switch is
                  * required. */
-                portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+                }
+                #else
+                {
+                    portPRE_TASK_DELETE_HOOK( pxTCB, &( xYieldPendings[ portGET_CORE_ID() ] ) );
+
+                    /* Force a reschedule of the core running the deleted task.
+                     * If that is this core the yield is taken when the critical
+                     * section is exited. */
+                    if( ( xSchedulerRunning != pdFALSE ) && ( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE ) )
+                    {
+                        configASSERT( ( pxTCB->xTaskRunState != ( BaseType_t ) portGET_CORE_ID() ) || ( uxSchedulerSuspended == 0U ) );
+                        prvYieldCore( pxTCB->xTaskRunState );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configNUMBER_OF_CORES */
             }
             else
             {
@@ -1185,25 +2204,29 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         /* If the task is not deleting itself, call prvDeleteTCB from outside of
          * critical section. If a task deletes itself, prvDeleteTCB is called
          * from prvCheckTasksWaitingTermination which is called from Idle task. */
-        if( pxTCB != pxCurrentTCB )
+        if( xTaskIsRunning == pdFALSE )
         {
             prvDeleteTCB( pxTCB );
         }
 
-        /* Force a reschedule if it is the currently running task that has just
-         * been deleted. */
-        if( xSchedulerRunning != pdFALSE )
+        #if ( configNUMBER_OF_CORES == 1 )
         {
-            if( pxTCB == pxCurrentTCB )
-            {
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
-            }
-            else
+            /* Force a reschedule if it is the currently running task that has just
+             * been deleted. */
+            if( xSchedulerRunning != pdFALSE )
             {
-                mtCOVERAGE_TEST_MARKER();
+                if( xTaskIsRunning != pdFALSE )
+                {
+                    configASSERT( uxSchedulerSuspended == 0 );
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
+        #endif /* configNUMBER_OF_CORES */
     }
 
 #endif /* INCLUDE_vTaskDelete */
@@ -1219,7 +2242,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
         configASSERT( pxPreviousWakeTime );
         configASSERT( ( xTimeIncrement > 0U ) );
-        configASSERT( uxSchedulerSuspended == 0 );
+        taskASSERT_SCHEDULER_NOT_SUSPENDED();
 
         vTaskSuspendAll();
         {
@@ -1305,7 +2328,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         /* A delay time of zero just forces a reschedule. */
         if( xTicksToDelay > ( TickType_t ) 0U )
         {
-            configASSERT( uxSchedulerSuspended == 0 );
+            taskASSERT_SCHEDULER_NOT_SUSPENDED();
             vTaskSuspendAll();
             {
                 traceTASK_DELAY();
@@ -1347,8 +2370,10 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         eTaskState eReturn;
         List_t const * pxStateList;
-        List_t const * pxDelayedList;
-        List_t const * pxOverflowedDelayedList;
+        #if ( configUSE_TIMER_WHEEL == 0 )
+            List_t const * pxDelayedList;
+            List_t const * pxOverflowedDelayedList;
+        #endif
         const TCB_t * const pxTCB = xTask;
 
         configASSERT( pxTCB );
@@ -1363,12 +2388,20 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             taskENTER_CRITICAL();
             {
                 pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                #if ( configUSE_TIMER_WHEEL == 0 )
+                {
+                    pxDelayedList = pxDelayedTaskList;
+                    pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                }
+                #endif
             }
             taskEXIT_CRITICAL();
 
-            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            #if ( configUSE_TIMER_WHEEL == 0 )
+                if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            #else
+                if( ( pxStateList >= &( xTimerWheel[ 0 ][ 0 ] ) ) && ( pxStateList <= &( xTimerWheel[ taskTIMER_WHEEL_LEVELS - 1U ][ taskTIMER_WHEEL_SLOTS - 1U ] ) ) )
+            #endif
             {
                 /* The task being queried is referenced from one of the Blocked
                  * lists. */
@@ -1431,6 +2464,20 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 /* If the task is not in any other state, it must be in the
                  * Ready (including pending ready) state. */
                 eReturn = eReady;
+
+                #if ( configNUMBER_OF_CORES > 1 )
+                {
+                    /* ...or running on another core. */
+                    if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+                    {
+                        eReturn = eRunning;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configNUMBER_OF_CORES */
             }
         }
 
@@ -1487,14 +2534,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
          * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
         portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
         {
             /* If null is passed in here then it is the priority of the calling
              * task that is being queried. */
             pxTCB = prvGetTCBFromHandle( xTask );
             uxReturn = pxTCB->uxPriority;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptState );
 
         return uxReturn;
     }
@@ -1543,44 +2590,68 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
             if( uxCurrentBasePriority != uxNewPriority )
             {
-                /* The priority change may have readied a task of higher
-                 * priority than the calling task. */
-                if( uxNewPriority > uxCurrentBasePriority )
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB != pxCurrentTCB )
+                    /* The priority change may have readied a task of higher
+                     * priority than the calling task. */
+                    if( uxNewPriority > uxCurrentBasePriority )
                     {
-                        /* The priority of a task other than the currently
-                         * running task is being raised.  Is the priority being
-                         * raised above that of the running task? */
-                        if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                        if( pxTCB != pxCurrentTCB )
                         {
-                            xYieldRequired = pdTRUE;
+                            /* The priority of a task other than the currently
+                             * running task is being raised.  Is the priority being
+                             * raised above that of the running task? */
+                            if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                            {
+                                xYieldRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
                         }
                         else
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            /* The priority of the running task is being raised,
+                             * but the running task must already be the highest
+                             * priority task able to run so no yield is required. */
                         }
                     }
+                    else if( pxTCB == pxCurrentTCB )
+                    {
+                        /* Setting the priority of the running task down means
+                         * there may now be another task of higher priority that
+                         * is ready to execute. */
+                        xYieldRequired = pdTRUE;
+                    }
                     else
                     {
-                        /* The priority of the running task is being raised,
-                         * but the running task must already be the highest
-                         * priority task able to run so no yield is required. */
+                        /* Setting the priority of any other task down does not
+                         * require a yield as the running task must be above the
+                         * new priority of the task being modified. */
                     }
                 }
-                else if( pxTCB == pxCurrentTCB )
+                #else /* configNUMBER_OF_CORES */
                 {
-                    /* Setting the priority of the running task down means
-                     * there may now be another task of higher priority that
-                     * is ready to execute. */
-                    xYieldRequired = pdTRUE;
-                }
-                else
-                {
-                    /* Setting the priority of any other task down does not
-                     * require a yield as the running task must be above the
-                     * new priority of the task being modified. */
+                    /* Setting the priority of a task that is running on any
+                     * core down means there may now be another task of higher
+                     * priority that is ready to execute on that core.  Raising
+                     * the priority of a ready task is dealt with once it has
+                     * been moved to its new ready list below.  When only one
+                     * priority may run at a time, raising the priority of a
+                     * running task also reschedules its core, which then
+                     * evicts the lower priority tasks from the other cores. */
+                    if( ( ( uxNewPriority < uxCurrentBasePriority ) || ( configRUN_MULTIPLE_PRIORITIES == 0 ) ) &&
+                        ( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE ) )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
+                #endif /* configNUMBER_OF_CORES */
 
                 /* Remember the ready list the task might be referenced from
                  * before its uxPriority member is changed so the
@@ -1642,30 +2713,128 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     }
 
                     prvAddTaskToReadyList( pxTCB );
+
+                    #if ( configNUMBER_OF_CORES > 1 )
+                    {
+                        if( uxNewPriority > uxCurrentBasePriority )
+                        {
+                            taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configNUMBER_OF_CORES */
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-
-                if( xYieldRequired != pdFALSE )
+
+                if( xYieldRequired != pdFALSE )
+                {
+                    #if ( configNUMBER_OF_CORES == 1 )
+                    {
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    #else
+                    {
+                        taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB );
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Remove compiler warning about unused variables when the port
+                 * optimised task selection is not being used. */
+                ( void ) uxPriorityUsedOnEntry;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* INCLUDE_vTaskPrioritySet */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CORE_AFFINITY == 1 )
+
+    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                               UBaseType_t uxCoreAffinityMask )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xCoreID;
+        UBaseType_t uxPrevCoreAffinityMask;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the affinity of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            uxPrevCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+            pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+            if( xSchedulerRunning != pdFALSE )
+            {
+                if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+                {
+                    xCoreID = pxTCB->xTaskRunState;
+
+                    /* Move the task off its core if it is no longer allowed
+                     * to run there. */
+                    if( taskCORE_IS_ALLOWED( pxTCB, xCoreID ) == pdFALSE )
+                    {
+                        prvYieldCore( xCoreID );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( ( ~uxPrevCoreAffinityMask & uxCoreAffinityMask ) != 0U )
                 {
-                    taskYIELD_IF_USING_PREEMPTION();
+                    /* The task is allowed on cores it could not use before,
+                     * where it might preempt a lower priority task. */
+                    taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-
-                /* Remove compiler warning about unused variables when the port
-                 * optimised task selection is not being used. */
-                ( void ) uxPriorityUsedOnEntry;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
         }
         taskEXIT_CRITICAL();
     }
 
-#endif /* INCLUDE_vTaskPrioritySet */
+#endif /* configUSE_CORE_AFFINITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CORE_AFFINITY == 1 )
+
+    UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        UBaseType_t uxCoreAffinityMask;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxCoreAffinityMask;
+    }
+
+#endif /* configUSE_CORE_AFFINITY */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_vTaskSuspend == 1 )
@@ -1703,8 +2872,33 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            taskREMOVE_FROM_EVENT_LISTS( pxTCB );
+
             vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
 
+            #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+            {
+                /* A running task is accounted for when it is switched out, but
+                 * a Ready task stops accruing ready time here. */
+                if( pxTCB->ucPerfState == taskPERF_STATE_READY )
+                {
+                    prvPerfSetTaskState( pxTCB, taskPERF_STATE_BLOCKED, prvPerfGetTime() );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
+            #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+            {
+                /* A Ready task that is suspended before it runs did not wait
+                 * for the time until it is next resumed. */
+                pxTCB->ucLatencyPending = pdFALSE;
+            }
+            #endif
+
             #if ( configUSE_TASK_NOTIFICATIONS == 1 )
             {
                 BaseType_t x;
@@ -1730,6 +2924,23 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             taskENTER_CRITICAL();
             {
                 prvResetNextTaskUnblockTime();
+
+                #if ( configNUMBER_OF_CORES > 1 )
+                {
+                    /* Force a reschedule of the core running the suspended
+                     * task.  If that is this core the yield is taken when the
+                     * critical section is exited. */
+                    if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+                    {
+                        configASSERT( ( pxTCB->xTaskRunState != ( BaseType_t ) portGET_CORE_ID() ) || ( uxSchedulerSuspended == 0U ) );
+                        prvYieldCore( pxTCB->xTaskRunState );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configNUMBER_OF_CORES */
             }
             taskEXIT_CRITICAL();
         }
@@ -1738,6 +2949,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configNUMBER_OF_CORES == 1 )
         if( pxTCB == pxCurrentTCB )
         {
             if( xSchedulerRunning != pdFALSE )
@@ -1769,6 +2981,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         {
             mtCOVERAGE_TEST_MARKER();
         }
+        #endif /* configNUMBER_OF_CORES */
     }
 
 #endif /* INCLUDE_vTaskSuspend */
@@ -1845,17 +3058,25 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     prvAddTaskToReadyList( pxTCB );
 
                     /* A higher priority task may have just been resumed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        /* This yield may not cause the task just resumed to run,
-                         * but will leave the lists in the correct state for the
-                         * next yield. */
-                        taskYIELD_IF_USING_PREEMPTION();
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            /* This yield may not cause the task just resumed to run,
+                             * but will leave the lists in the correct state for the
+                             * next yield. */
+                            taskYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
-                    else
+                    #else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
                     }
+                    #endif /* configNUMBER_OF_CORES */
                 }
                 else
                 {
@@ -1902,7 +3123,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
          * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
         portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
             {
@@ -1913,22 +3134,43 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 {
                     /* Ready lists can be accessed so move the task from the
                      * suspended list to the ready list directly. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        xYieldRequired = pdTRUE;
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            xYieldRequired = pdTRUE;
 
-                        /* Mark that a yield is pending in case the user is not
-                         * using the return value to initiate a context switch
-                         * from the ISR using portYIELD_FROM_ISR. */
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
+                            /* Mark that a yield is pending in case the user is not
+                             * using the return value to initiate a context switch
+                             * from the ISR using portYIELD_FROM_ISR. */
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
+                    #endif /* configNUMBER_OF_CORES */
 
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
                     prvAddTaskToReadyList( pxTCB );
+
+                    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+                    {
+                        /* The yield is held pending on this core if this core
+                         * is the one that should run the resumed task. */
+                        prvYieldForTask( pxTCB );
+
+                        if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configNUMBER_OF_CORES */
                 }
                 else
                 {
@@ -1943,7 +3185,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xYieldRequired;
     }
@@ -1951,48 +3193,158 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 #endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static BaseType_t prvCreateIdleTasks( void )
+    {
+        BaseType_t xReturn = pdPASS;
+        BaseType_t xCoreID;
+        BaseType_t x;
+        TaskFunction_t pxIdleTaskFunction;
+        char cIdleName[ configMAX_TASK_NAME_LEN ];
+
+        for( xCoreID = 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+        {
+            /* Each idle task is named configIDLE_TASK_NAME with the number of
+             * the core it was created for appended, space permitting. */
+            for( x = 0; x < ( BaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+            {
+                cIdleName[ x ] = configIDLE_TASK_NAME[ x ];
+
+                if( cIdleName[ x ] == ( char ) 0x00 )
+                {
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( x < ( ( BaseType_t ) configMAX_TASK_NAME_LEN - 1 ) )
+            {
+                cIdleName[ x ] = ( char ) ( xCoreID + '0' );
+                cIdleName[ x + 1 ] = ( char ) 0x00;
+            }
+            else
+            {
+                cIdleName[ configMAX_TASK_NAME_LEN - 1 ] = ( char ) 0x00;
+            }
+
+            if( xCoreID == 0 )
+            {
+                pxIdleTaskFunction = prvIdleTask;
+            }
+            else
+            {
+                pxIdleTaskFunction = prvPassiveIdleTask;
+            }
+
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+                StackType_t * pxIdleTaskStackBuffer = NULL;
+                uint32_t ulIdleTaskStackSize;
+
+                /* The idle tasks are created using user provided RAM - obtain
+                 * the address of the RAM then create the idle task. */
+                if( xCoreID == 0 )
+                {
+                    vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+                }
+                else
+                {
+                    vApplicationGetPassiveIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize, xCoreID - 1 );
+                }
+
+                xIdleTaskHandles[ xCoreID ] = xTaskCreateStatic( pxIdleTaskFunction,
+                                                                 cIdleName,
+                                                                 ulIdleTaskStackSize,
+                                                                 ( void * ) NULL,
+                                                                 portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                                                 pxIdleTaskStackBuffer,
+                                                                 pxIdleTaskTCBBuffer );
+
+                if( xIdleTaskHandles[ xCoreID ] != NULL )
+                {
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+            }
+            #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+            {
+                /* The idle tasks are being created using dynamically allocated
+                 * RAM. */
+                xReturn = xTaskCreate( pxIdleTaskFunction,
+                                       cIdleName,
+                                       configMINIMAL_STACK_SIZE,
+                                       ( void * ) NULL,
+                                       portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                       &( xIdleTaskHandles[ xCoreID ] ) );
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+        }
+
+        return xReturn;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 void vTaskStartScheduler( void )
 {
     BaseType_t xReturn;
 
     /* Add the idle task at the lowest priority. */
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    #if ( configNUMBER_OF_CORES == 1 )
     {
-        StaticTask_t * pxIdleTaskTCBBuffer = NULL;
-        StackType_t * pxIdleTaskStackBuffer = NULL;
-        uint32_t ulIdleTaskStackSize;
-
-        /* The Idle task is created using user provided RAM - obtain the
-         * address of the RAM then create the idle task. */
-        vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
-        xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
-                                             configIDLE_TASK_NAME,
-                                             ulIdleTaskStackSize,
-                                             ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
-                                             portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                                             pxIdleTaskStackBuffer,
-                                             pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
-
-        if( xIdleTaskHandle != NULL )
-        {
-            xReturn = pdPASS;
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        {
+            StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+            StackType_t * pxIdleTaskStackBuffer = NULL;
+            uint32_t ulIdleTaskStackSize;
+
+            /* The Idle task is created using user provided RAM - obtain the
+             * address of the RAM then create the idle task. */
+            vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+            xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
+                                                 configIDLE_TASK_NAME,
+                                                 ulIdleTaskStackSize,
+                                                 ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
+                                                 portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                                 pxIdleTaskStackBuffer,
+                                                 pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+            if( xIdleTaskHandle != NULL )
+            {
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
         }
-        else
+        #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
         {
-            xReturn = pdFAIL;
+            /* The Idle task is being created using dynamically allocated RAM. */
+            xReturn = xTaskCreate( prvIdleTask,
+                                   configIDLE_TASK_NAME,
+                                   configMINIMAL_STACK_SIZE,
+                                   ( void * ) NULL,
+                                   portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                   &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
         }
+        #endif /* configSUPPORT_STATIC_ALLOCATION */
     }
-    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+    #else
     {
-        /* The Idle task is being created using dynamically allocated RAM. */
-        xReturn = xTaskCreate( prvIdleTask,
-                               configIDLE_TASK_NAME,
-                               configMINIMAL_STACK_SIZE,
-                               ( void * ) NULL,
-                               portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                               &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+        /* One idle task is required per core. */
+        xReturn = prvCreateIdleTasks();
     }
-    #endif /* configSUPPORT_STATIC_ALLOCATION */
+    #endif /* configNUMBER_OF_CORES */
 
     #if ( configUSE_TIMERS == 1 )
     {
@@ -2033,6 +3385,25 @@ void vTaskStartScheduler( void )
         }
         #endif
 
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            BaseType_t xCoreID;
+
+            /* Each core starts out running its own idle task, then the
+             * highest priority tasks that have been created displace them. */
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                pxCurrentTCBs[ xCoreID ] = xIdleTaskHandles[ xCoreID ];
+                pxCurrentTCBs[ xCoreID ]->xTaskRunState = xCoreID;
+            }
+
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                prvSelectHighestPriorityTask( xCoreID );
+            }
+        }
+        #endif /* configNUMBER_OF_CORES */
+
         xNextTaskUnblockTime = portMAX_DELAY;
         xSchedulerRunning = pdTRUE;
         xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
@@ -2045,6 +3416,24 @@ void vTaskStartScheduler( void )
          * FreeRTOSConfig.h file. */
         portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+        #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+        {
+            BaseType_t xCoreID;
+            configRUN_TIME_COUNTER_TYPE ulNow = prvPerfGetTime();
+
+            /* The tasks about to be started are switched in without passing
+             * through vTaskSwitchContext(). */
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                #if ( configNUMBER_OF_CORES == 1 )
+                    prvPerfRecordSwitch( xCoreID, NULL, pxCurrentTCB, ulNow );
+                #else
+                    prvPerfRecordSwitch( xCoreID, NULL, pxCurrentTCBs[ xCoreID ], ulNow );
+                #endif
+            }
+        }
+        #endif /* configUSE_TASK_PERF_COUNTERS */
+
         traceTASK_SWITCHED_IN();
 
         /* Setting up the timer tick is hardware specific and thus in the
@@ -2068,7 +3457,11 @@ void vTaskStartScheduler( void )
 
     /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
      * meaning xIdleTaskHandle is not used anywhere else. */
-    ( void ) xIdleTaskHandle;
+    #if ( configNUMBER_OF_CORES == 1 )
+        ( void ) xIdleTaskHandle;
+    #else
+        ( void ) xIdleTaskHandles;
+    #endif
 
     /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
      * from getting optimized out as it is no longer used by the kernel. */
@@ -2089,22 +3482,73 @@ void vTaskEndScheduler( void )
 
 void vTaskSuspendAll( void )
 {
-    /* A critical section is not required as the variable is of type
-     * BaseType_t.  Please read Richard Barry's reply in the following link to a
-     * post in the FreeRTOS support forum before reporting this as a bug! -
-     * https://goo.gl/wu4acr */
-
-    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
-     * do not otherwise exhibit real time behaviour. */
-    portSOFTWARE_BARRIER();
-
-    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
-     * is used to allow calls to vTaskSuspendAll() to nest. */
-    ++uxSchedulerSuspended;
-
-    /* Enforces ordering for ports and optimised compilers that may otherwise place
-     * the above increment elsewhere. */
-    portMEMORY_BARRIER();
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* A critical section is not required as the variable is of type
+         * BaseType_t.  Please read Richard Barry's reply in the following link to a
+         * post in the FreeRTOS support forum before reporting this as a bug! -
+         * https://goo.gl/wu4acr */
+
+        /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
+         * do not otherwise exhibit real time behaviour. */
+        portSOFTWARE_BARRIER();
+
+        /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
+         * is used to allow calls to vTaskSuspendAll() to nest. */
+        ++uxSchedulerSuspended;
+
+        /* Enforces ordering for ports and optimised compilers that may otherwise place
+         * the above increment elsewhere. */
+        portMEMORY_BARRIER();
+    }
+    #else /* if ( configNUMBER_OF_CORES == 1 ) */
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Interrupts are masked before the locks are taken so the calling
+             * task cannot be switched out between taking the task lock and
+             * incrementing uxSchedulerSuspended.  Once uxSchedulerSuspended is
+             * non-zero no context switch can occur on this core, so interrupts
+             * can be unmasked again while the task lock is held. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+
+            /* This must never be called from inside a critical section. */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() == 0U );
+
+            portSOFTWARE_BARRIER();
+
+            /* The task lock is held until the matching xTaskResumeAll(), which
+             * is what stops the other cores from switching context while the
+             * scheduler is suspended. */
+            portGET_TASK_LOCK();
+
+            /* Another core may have asked this task to yield before the lock was
+             * obtained - let that yield happen first. */
+            if( uxSchedulerSuspended == 0U )
+            {
+                prvCheckForRunStateChange();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* uxSchedulerSuspended is also read by interrupts, so is written
+             * while holding the ISR lock too. */
+            portGET_ISR_LOCK();
+            ++uxSchedulerSuspended;
+            portRELEASE_ISR_LOCK();
+
+            portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*----------------------------------------------------------*/
 
@@ -2176,68 +3620,56 @@ BaseType_t xTaskResumeAll( void )
     TCB_t * pxTCB = NULL;
     BaseType_t xAlreadyYielded = pdFALSE;
 
-    /* If uxSchedulerSuspended is zero then this function does not match a
-     * previous call to vTaskSuspendAll(). */
-    configASSERT( uxSchedulerSuspended );
-
-    /* It is possible that an ISR caused a task to be removed from an event
-     * list while the scheduler was suspended.  If this was the case then the
-     * removed task will have been added to the xPendingReadyList.  Once the
-     * scheduler has been resumed it is safe to move all the pending ready
-     * tasks from this list into their appropriate ready list. */
-    taskENTER_CRITICAL();
+    /* vTaskSuspendAll() does nothing on a multi-core build before the
+     * scheduler is started. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        if( xSchedulerRunning != pdFALSE )
+    #endif
     {
-        --uxSchedulerSuspended;
-
-        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        /* If uxSchedulerSuspended is zero then this function does not match a
+         * previous call to vTaskSuspendAll(). */
+        configASSERT( uxSchedulerSuspended );
+
+        /* It is possible that an ISR caused a task to be removed from an event
+         * list while the scheduler was suspended.  If this was the case then the
+         * removed task will have been added to the xPendingReadyList.  Once the
+         * scheduler has been resumed it is safe to move all the pending ready
+         * tasks from this list into their appropriate ready list. */
+        taskENTER_CRITICAL();
         {
-            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
-            {
-                /* Move any readied tasks from the pending list into the
-                 * appropriate ready list. */
-                while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
-                {
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    portMEMORY_BARRIER();
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+            --uxSchedulerSuspended;
 
-                    /* If the moved task has a priority higher than or equal to
-                     * the current task then a yield must be performed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-                    {
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* Drop the hold on the task lock taken by vTaskSuspendAll().  It is
+                 * still held by the critical section. */
+                portRELEASE_TASK_LOCK();
+            }
+            #endif /* configNUMBER_OF_CORES */
 
-                if( pxTCB != NULL )
+            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+            {
+                if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
                 {
-                    /* A task was unblocked while the scheduler was suspended,
-                     * which may have prevented the next unblock time from being
-                     * re-calculated, in which case re-calculate it now.  Mainly
-                     * important for low power tickless implementations, where
-                     * this can prevent an unnecessary exit from low power
-                     * state. */
-                    prvResetNextTaskUnblockTime();
-                }
+                    /* Move any readied tasks from the pending list into the
+                     * appropriate ready list. */
+                    while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
+                    {
+                        pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                        portMEMORY_BARRIER();
+                        listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
 
-                /* If any ticks occurred while the scheduler was suspended then
-                 * they should be processed now.  This ensures the tick count does
-                 * not  slip, and that any delayed tasks are resumed at the correct
-                 * time. */
-                {
-                    TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+                        /* A task unblocked by an interrupt while the scheduler
+                         * was suspended may still be in other event lists. */
+                        taskREMOVE_FROM_EVENT_LISTS( pxTCB );
+                        prvAddTaskToReadyList( pxTCB );
 
-                    if( xPendedCounts > ( TickType_t ) 0U )
-                    {
-                        do
+                        #if ( configNUMBER_OF_CORES == 1 )
                         {
-                            if( xTaskIncrementTick() != pdFALSE )
+                            /* If the moved task has a priority higher than or equal to
+                             * the current task then a yield must be performed. */
+                            if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
                             {
                                 xYieldPending = pdTRUE;
                             }
@@ -2245,39 +3677,97 @@ BaseType_t xTaskResumeAll( void )
                             {
                                 mtCOVERAGE_TEST_MARKER();
                             }
+                        }
+                        #else
+                        {
+                            /* The moved task may be able to preempt a task running
+                             * on any core. */
+                            taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                        }
+                        #endif /* configNUMBER_OF_CORES */
+                    }
+
+                    if( pxTCB != NULL )
+                    {
+                        /* A task was unblocked while the scheduler was suspended,
+                         * which may have prevented the next unblock time from being
+                         * re-calculated, in which case re-calculate it now.  Mainly
+                         * important for low power tickless implementations, where
+                         * this can prevent an unnecessary exit from low power
+                         * state. */
+                        prvResetNextTaskUnblockTime();
+                    }
+
+                    /* If any ticks occurred while the scheduler was suspended then
+                     * they should be processed now.  This ensures the tick count does
+                     * not  slip, and that any delayed tasks are resumed at the correct
+                     * time. */
+                    {
+                        TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+
+                        if( xPendedCounts > ( TickType_t ) 0U )
+                        {
+                            do
+                            {
+                                if( xTaskIncrementTick() != pdFALSE )
+                                {
+                                    #if ( configNUMBER_OF_CORES == 1 )
+                                        xYieldPending = pdTRUE;
+                                    #else
+                                        /* Other cores are interrupted from within
+                                         * xTaskIncrementTick(). */
+                                        xYieldPendings[ portGET_CORE_ID() ] = pdTRUE;
+                                    #endif
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+
+                                --xPendedCounts;
+                            } while( xPendedCounts > ( TickType_t ) 0U );
+
+                            xPendedTicks = 0;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
 
-                            --xPendedCounts;
-                        } while( xPendedCounts > ( TickType_t ) 0U );
+                    #if ( configNUMBER_OF_CORES == 1 )
+                        if( xYieldPending != pdFALSE )
+                    #else
+                        if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                    #endif
+                    {
+                        #if ( configUSE_PREEMPTION != 0 )
+                        {
+                            xAlreadyYielded = pdTRUE;
+                        }
+                        #endif
 
-                        xPendedTicks = 0;
+                        /* On a multi-core build the pending yield is taken when the
+                         * critical section below is exited. */
+                        #if ( configNUMBER_OF_CORES == 1 )
+                        {
+                            taskYIELD_IF_USING_PREEMPTION();
+                        }
+                        #endif
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-
-                if( xYieldPending != pdFALSE )
-                {
-                    #if ( configUSE_PREEMPTION != 0 )
-                    {
-                        xAlreadyYielded = pdTRUE;
-                    }
-                    #endif
-                    taskYIELD_IF_USING_PREEMPTION();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        taskEXIT_CRITICAL();
     }
-    taskEXIT_CRITICAL();
 
     return xAlreadyYielded;
 }
@@ -2446,15 +3936,31 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
             } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
             /* Search the delayed lists. */
-            if( pxTCB == NULL )
+            #if ( configUSE_TIMER_WHEEL == 0 )
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
-            }
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+                }
 
-            if( pxTCB == NULL )
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                }
+            }
+            #else
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                UBaseType_t uxLevel, uxSlot;
+
+                for( uxLevel = 0U; ( uxLevel < taskTIMER_WHEEL_LEVELS ) && ( pxTCB == NULL ); uxLevel++ )
+                {
+                    for( uxSlot = 0U; ( uxSlot < taskTIMER_WHEEL_SLOTS ) && ( pxTCB == NULL ); uxSlot++ )
+                    {
+                        pxTCB = prvSearchForNameWithinSingleList( &( xTimerWheel[ uxLevel ][ uxSlot ] ), pcNameToQuery );
+                    }
+                }
             }
+            #endif /* configUSE_TIMER_WHEEL */
 
             #if ( INCLUDE_vTaskSuspend == 1 )
             {
@@ -2507,8 +4013,24 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Blocked state. */
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+                #if ( configUSE_TIMER_WHEEL == 0 )
+                {
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+                }
+                #else
+                {
+                    UBaseType_t uxLevel, uxSlot;
+
+                    for( uxLevel = 0U; uxLevel < taskTIMER_WHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = 0U; uxSlot < taskTIMER_WHEEL_SLOTS; uxSlot++ )
+                        {
+                            uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xTimerWheel[ uxLevel ][ uxSlot ] ), eBlocked );
+                        }
+                    }
+                }
+                #endif /* configUSE_TIMER_WHEEL */
 
                 #if ( INCLUDE_vTaskDelete == 1 )
                 {
@@ -2561,13 +4083,31 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
-    TaskHandle_t xTaskGetIdleTaskHandle( void )
-    {
-        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-         * started, then xIdleTaskHandle will be NULL. */
-        configASSERT( ( xIdleTaskHandle != NULL ) );
-        return xIdleTaskHandle;
-    }
+    #if ( configNUMBER_OF_CORES == 1 )
+        TaskHandle_t xTaskGetIdleTaskHandle( void )
+        {
+            /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+             * started, then xIdleTaskHandle will be NULL. */
+            configASSERT( ( xIdleTaskHandle != NULL ) );
+            return xIdleTaskHandle;
+        }
+    #else /* if ( configNUMBER_OF_CORES == 1 ) */
+        TaskHandle_t xTaskGetIdleTaskHandle( void )
+        {
+            /* The idle task created for core 0 is the one that runs the idle
+             * hook and frees deleted tasks. */
+            return xTaskGetIdleTaskHandleForCore( 0 );
+        }
+
+        TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID )
+        {
+            /* If xTaskGetIdleTaskHandleForCore() is called before the scheduler
+             * has been started, then the handles will be NULL. */
+            configASSERT( taskVALID_CORE_ID( xCoreID ) != pdFALSE );
+            configASSERT( ( xIdleTaskHandles[ xCoreID ] != NULL ) );
+            return xIdleTaskHandles[ xCoreID ];
+        }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
 
 #endif /* INCLUDE_xTaskGetIdleTaskHandle */
 /*----------------------------------------------------------*/
@@ -2606,6 +4146,14 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            /* The stepped ticks are not passed to prvTimerWheelAdvance(), so
+             * move down the tasks it would have moved on any of them. */
+            prvTimerWheelStep( xTickCount, xTickCount + xTicksToJump );
+        }
+        #endif
+
         xTickCount += xTicksToJump;
         traceINCREASE_TICK_COUNT( xTicksToJump );
     }
@@ -2619,7 +4167,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 
     /* Must not be called with the scheduler suspended as the implementation
      * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-    configASSERT( uxSchedulerSuspended == 0 );
+    taskASSERT_SCHEDULER_NOT_SUSPENDED();
 
     /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
      * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
@@ -2678,6 +4226,20 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
+
+                    #if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+                    {
+                        if( pxTCB->pxEventListItems != NULL )
+                        {
+                            prvRemoveFromEventLists( pxTCB );
+                            pxTCB->ucDelayAborted = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif
                 }
                 taskEXIT_CRITICAL();
 
@@ -2691,16 +4253,28 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                     /* Preemption is on, but a context switch should only be
                      * performed if the unblocked task has a priority that is
                      * higher than the currently executing task. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        /* Pend the yield to be performed when the scheduler
-                         * is unsuspended. */
-                        xYieldPending = pdTRUE;
+                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        {
+                            /* Pend the yield to be performed when the scheduler
+                             * is unsuspended. */
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
-                    else
+                    #else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        taskENTER_CRITICAL();
+                        {
+                            prvYieldForTask( pxTCB );
+                        }
+                        taskEXIT_CRITICAL();
                     }
+                    #endif /* configNUMBER_OF_CORES */
                 }
                 #endif /* configUSE_PREEMPTION */
             }
@@ -2723,9 +4297,15 @@ BaseType_t xTaskIncrementTick( void )
     TickType_t xItemValue;
     BaseType_t xSwitchRequired = pdFALSE;
 
+    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+        BaseType_t xYieldRequiredForCore[ configNUMBER_OF_CORES ] = { pdFALSE };
+    #endif
+
     /* Called by the portable layer each time a tick interrupt occurs.
      * Increments the tick then checks to see if the new tick value will cause any
-     * tasks to be unblocked. */
+     * tasks to be unblocked.  On a multi-core build the tick is processed by a
+     * single core, from within taskENTER_CRITICAL_FROM_ISR(), and the other
+     * cores are interrupted if they need to switch context. */
     traceTASK_INCREMENT_TICK( xTickCount );
 
     if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
@@ -2738,6 +4318,15 @@ BaseType_t xTaskIncrementTick( void )
          * delayed lists if it wraps to 0. */
         xTickCount = xConstTickCount;
 
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            /* The timer wheel must be advanced on every tick, even if no task
+             * is due to unblock, so tasks are moved down from the higher levels
+             * of the wheel at the right time. */
+            prvTimerWheelAdvance( xConstTickCount );
+        }
+        #endif
+
         if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
         {
             taskSWITCH_DELAYED_LISTS();
@@ -2757,12 +4346,22 @@ BaseType_t xTaskIncrementTick( void )
             {
                 if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
                 {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    #if ( configUSE_TIMER_WHEEL == 0 )
+                    {
+                        /* The delayed list is empty.  Set xNextTaskUnblockTime
+                         * to the maximum possible value so it is extremely
+                         * unlikely that the
+                         * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                         * next time through. */
+                        xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    }
+                    #else
+                    {
+                        /* No more tasks are due to unblock on this tick.  Find
+                         * the next slot of the wheel that holds a task. */
+                        prvResetNextTaskUnblockTime();
+                    }
+                    #endif
                     break;
                 }
                 else
@@ -2803,6 +4402,8 @@ BaseType_t xTaskIncrementTick( void )
                         mtCOVERAGE_TEST_MARKER();
                     }
 
+                    taskREMOVE_FROM_EVENT_LISTS( pxTCB );
+
                     /* Place the unblocked task into the appropriate ready
                      * list. */
                     prvAddTaskToReadyList( pxTCB );
@@ -2819,14 +4420,24 @@ BaseType_t xTaskIncrementTick( void )
                          * processing time (which happens when both
                          * preemption and time slicing are on) is
                          * handled below.*/
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        #if ( configNUMBER_OF_CORES == 1 )
                         {
-                            xSwitchRequired = pdTRUE;
+                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
                         }
-                        else
+                        #else
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            /* Any core running a lower priority task is
+                             * flagged, the flags are acted on below. */
+                            prvYieldForTask( pxTCB );
                         }
+                        #endif /* configNUMBER_OF_CORES */
                     }
                     #endif /* configUSE_PREEMPTION */
                 }
@@ -2838,14 +4449,36 @@ BaseType_t xTaskIncrementTick( void )
          * writer has not explicitly turned time slicing off. */
         #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
         {
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                xSwitchRequired = pdTRUE;
+                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            else
+            #else
             {
-                mtCOVERAGE_TEST_MARKER();
+                BaseType_t xCoreID;
+
+                /* Time slice every core whose task shares its priority with
+                 * another ready task. */
+                for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                    {
+                        xYieldRequiredForCore[ xCoreID ] = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
             }
+            #endif /* configNUMBER_OF_CORES */
         }
         #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
@@ -2866,14 +4499,44 @@ BaseType_t xTaskIncrementTick( void )
 
         #if ( configUSE_PREEMPTION == 1 )
         {
-            if( xYieldPending != pdFALSE )
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                xSwitchRequired = pdTRUE;
+                if( xYieldPending != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            else
+            #else
             {
-                mtCOVERAGE_TEST_MARKER();
+                BaseType_t xCoreID;
+                const BaseType_t xCurrentCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+                /* The calling core switches context on return from the tick
+                 * interrupt, the other cores are interrupted. */
+                for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    if( ( xYieldRequiredForCore[ xCoreID ] != pdFALSE ) || ( xYieldPendings[ xCoreID ] != pdFALSE ) )
+                    {
+                        if( xCoreID == xCurrentCoreID )
+                        {
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            prvYieldCore( xCoreID );
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
             }
+            #endif /* configNUMBER_OF_CORES */
         }
         #endif /* configUSE_PREEMPTION */
     }
@@ -2961,11 +4624,11 @@ BaseType_t xTaskIncrementTick( void )
 
         /* Save the hook function in the TCB.  A critical section is required as
          * the value can be accessed from an interrupt. */
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             xReturn = pxTCB->pxTaskTag;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xReturn;
     }
@@ -3006,78 +4669,234 @@ BaseType_t xTaskIncrementTick( void )
 #endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
-{
-    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+#if ( configNUMBER_OF_CORES == 1 )
+    void vTaskSwitchContext( void )
     {
-        /* The scheduler is currently suspended - do not allow a context
-         * switch. */
-        xYieldPending = pdTRUE;
-    }
-    else
-    {
-        xYieldPending = pdFALSE;
-        traceTASK_SWITCHED_OUT();
+        #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+            TCB_t * pxPreviousTCB;
+        #endif
 
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
         {
-            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-            #else
-                ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+            /* The scheduler is currently suspended - do not allow a context
+             * switch. */
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            xYieldPending = pdFALSE;
+            traceTASK_SWITCHED_OUT();
+
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+                #else
+                    ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+
+                /* Add the amount of time the task has been running to the
+                 * accumulated time so far.  The time the task started running was
+                 * stored in ulTaskSwitchedInTime.  Note that there is no overflow
+                 * protection here so count values are only valid until the timer
+                 * overflows.  The guard against negative values is to protect
+                 * against suspect run time stat counter implementations - which
+                 * are provided by the application, not the kernel. */
+                if( ulTotalRunTime > ulTaskSwitchedInTime )
+                {
+                    pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ulTaskSwitchedInTime = ulTotalRunTime;
+            }
+            #endif /* configGENERATE_RUN_TIME_STATS */
+
+            /* Check for stack overflow, if configured. */
+            taskCHECK_FOR_STACK_OVERFLOW();
+
+            #if ( ( configUSE_STACK_HIGH_WATER_TRACKING == 1 ) && ( portSTACK_POINTER_SAVED_IN_TCB == 1 ) )
+            {
+                /* The stack pointer the port just saved is as deep as the
+                 * task's stack is known to have reached. */
+                if( prvStackHighWaterUpdate( pxCurrentTCB, ( StackType_t * ) pxCurrentTCB->pxTopOfStack ) != pdFALSE )
+                {
+                    taskSTACK_PRESSURE_HOOK( pxCurrentTCB, prvStackHighWaterFree( pxCurrentTCB ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
             #endif
 
-            /* Add the amount of time the task has been running to the
-             * accumulated time so far.  The time the task started running was
-             * stored in ulTaskSwitchedInTime.  Note that there is no overflow
-             * protection here so count values are only valid until the timer
-             * overflows.  The guard against negative values is to protect
-             * against suspect run time stat counter implementations - which
-             * are provided by the application, not the kernel. */
-            if( ulTotalRunTime > ulTaskSwitchedInTime )
+            /* Before the currently running task is switched out, save its errno. */
+            #if ( configUSE_POSIX_ERRNO == 1 )
             {
-                pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
             }
-            else
+            #endif
+
+            #if ( configUSE_TASK_PERF_COUNTERS == 1 )
             {
-                mtCOVERAGE_TEST_MARKER();
+                pxPreviousTCB = pxCurrentTCB;
             }
+            #endif
 
-            ulTaskSwitchedInTime = ulTotalRunTime;
-        }
-        #endif /* configGENERATE_RUN_TIME_STATS */
+            /* Select a new task to run using either the generic C or port
+             * optimised asm code. */
+            taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            traceTASK_SWITCHED_IN();
+
+            #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+            {
+                prvPerfRecordSwitch( 0, pxPreviousTCB, pxCurrentTCB, ulTotalRunTime );
+            }
+            #endif
 
-        /* Check for stack overflow, if configured. */
-        taskCHECK_FOR_STACK_OVERFLOW();
+            #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+            {
+                prvLatencyTaskSwitchedIn( pxCurrentTCB, ulTotalRunTime );
+            }
+            #endif
 
-        /* Before the currently running task is switched out, save its errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
-        {
-            pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+            /* After the new task is switched in, update the global errno. */
+            #if ( configUSE_POSIX_ERRNO == 1 )
+            {
+                FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+            }
+            #endif
+
+            #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+            {
+                /* Switch C-Runtime's TLS Block to point to the TLS
+                 * Block specific to this task. */
+                configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+            }
+            #endif
         }
+    }
+#else /* if ( configNUMBER_OF_CORES == 1 ) */
+    void vTaskSwitchContext( BaseType_t xCoreID )
+    {
+        #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+            TCB_t * pxPreviousTCB;
         #endif
 
-        /* Select a new task to run using either the generic C or port
-         * optimised asm code. */
-        taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-        traceTASK_SWITCHED_IN();
-
-        /* After the new task is switched in, update the global errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
+        /* Both locks are taken.  The ISR lock protects the ready lists from
+         * other cores and interrupts.  The task lock is taken as well so a core
+         * waits here while another core has the scheduler suspended, rather than
+         * just latching a yield that might then never be taken. */
+        portGET_TASK_LOCK();
+        portGET_ISR_LOCK();
         {
-            FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
-        }
-        #endif
+            /* vTaskSwitchContext() must not be called from within a critical
+             * section on a multi-core build. */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() == 0U );
+
+            if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+            {
+                /* The scheduler is currently suspended by this core - do not
+                 * allow a context switch. */
+                xYieldPendings[ xCoreID ] = pdTRUE;
+            }
+            else
+            {
+                xYieldPendings[ xCoreID ] = pdFALSE;
+                traceTASK_SWITCHED_OUT();
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                        portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+                    #else
+                        ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                    #endif
+
+                    /* As the single core version, but the switched in time is
+                     * recorded per core. */
+                    if( ulTotalRunTime > ulTaskSwitchedInTime[ xCoreID ] )
+                    {
+                        pxCurrentTCBs[ xCoreID ]->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime[ xCoreID ] );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    ulTaskSwitchedInTime[ xCoreID ] = ulTotalRunTime;
+                }
+                #endif /* configGENERATE_RUN_TIME_STATS */
+
+                /* Check for stack overflow, if configured. */
+                taskCHECK_FOR_STACK_OVERFLOW();
+
+                #if ( ( configUSE_STACK_HIGH_WATER_TRACKING == 1 ) && ( portSTACK_POINTER_SAVED_IN_TCB == 1 ) )
+                {
+                    /* As the single core version. */
+                    if( prvStackHighWaterUpdate( pxCurrentTCBs[ xCoreID ], ( StackType_t * ) pxCurrentTCBs[ xCoreID ]->pxTopOfStack ) != pdFALSE )
+                    {
+                        taskSTACK_PRESSURE_HOOK( pxCurrentTCBs[ xCoreID ], prvStackHighWaterFree( pxCurrentTCBs[ xCoreID ] ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
+
+                /* Before the currently running task is switched out, save its errno. */
+                #if ( configUSE_POSIX_ERRNO == 1 )
+                {
+                    pxCurrentTCBs[ xCoreID ]->iTaskErrno = FreeRTOS_errno;
+                }
+                #endif
+
+                #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+                {
+                    pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+                }
+                #endif
+
+                /* Select a new task to run. */
+                taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID );
+                traceTASK_SWITCHED_IN();
+
+                #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+                {
+                    prvPerfRecordSwitch( xCoreID, pxPreviousTCB, pxCurrentTCBs[ xCoreID ], ulTotalRunTime );
+                }
+                #endif
+
+                #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+                {
+                    prvLatencyTaskSwitchedIn( pxCurrentTCBs[ xCoreID ], ulTotalRunTime );
+                }
+                #endif
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
-        {
-            /* Switch C-Runtime's TLS Block to point to the TLS
-             * Block specific to this task. */
-            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+                /* After the new task is switched in, update the global errno. */
+                #if ( configUSE_POSIX_ERRNO == 1 )
+                {
+                    FreeRTOS_errno = pxCurrentTCBs[ xCoreID ]->iTaskErrno;
+                }
+                #endif
+
+                #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+                {
+                    /* Switch C-Runtime's TLS Block to point to the TLS
+                     * Block specific to this task. */
+                    configSET_TLS_BLOCK( pxCurrentTCBs[ xCoreID ]->xTLSBlock );
+                }
+                #endif
+            }
         }
-        #endif
+        portRELEASE_ISR_LOCK();
+        portRELEASE_TASK_LOCK();
     }
-}
+#endif /* if ( configNUMBER_OF_CORES == 1 ) */
 /*-----------------------------------------------------------*/
 
 void vTaskPlaceOnEventList( List_t * const pxEventList,
@@ -3131,6 +4950,131 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+    void vTaskPlaceOnEventLists( List_t * const * ppxEventLists,
+                                 ListItem_t * pxEventListItems,
+                                 UBaseType_t uxEventLists,
+                                 const TickType_t xTicksToWait )
+    {
+        UBaseType_t x;
+
+        configASSERT( ppxEventLists );
+        configASSERT( pxEventListItems );
+        configASSERT( uxEventLists > ( UBaseType_t ) 0U );
+
+        /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED AND THE
+         * QUEUES BEING ACCESSED LOCKED. */
+
+        /* The task is referenced from each event list by one of the items
+         * provided by the caller, which are ordered by priority in the same way
+         * as the event list item of the TCB.  The event list item of the TCB is
+         * not used, so it is free to hold the task in the pending ready list if
+         * an interrupt unblocks it while the scheduler is suspended. */
+        for( x = 0; x < uxEventLists; x++ )
+        {
+            vListInitialiseItem( &( pxEventListItems[ x ] ) );
+            listSET_LIST_ITEM_OWNER( &( pxEventListItems[ x ] ), pxCurrentTCB );
+            listSET_LIST_ITEM_VALUE( &( pxEventListItems[ x ] ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            vListInsert( ppxEventLists[ x ], &( pxEventListItems[ x ] ) );
+        }
+
+        pxCurrentTCB->pxEventListItems = pxEventListItems;
+        pxCurrentTCB->uxEventListItems = uxEventLists;
+
+        /* A task that is only referenced from the Suspended list by its state
+         * list item would look suspended rather than blocked, so the task is
+         * always placed in a delayed list.  A caller that waits indefinitely
+         * wakes after portMAX_DELAY ticks and blocks again. */
+        prvAddCurrentTaskToDelayedList( xTicksToWait, pdFALSE );
+    }
+
+#endif /* configUSE_QUEUE_RECEIVE_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+    static void prvRemoveFromEventLists( TCB_t * pxTCB )
+    {
+        UBaseType_t x;
+        ListItem_t * pxEventListItem;
+
+        for( x = 0; x < pxTCB->uxEventListItems; x++ )
+        {
+            pxEventListItem = &( pxTCB->pxEventListItems[ x ] );
+
+            if( listLIST_ITEM_CONTAINER( pxEventListItem ) != NULL )
+            {
+                ( void ) uxListRemove( pxEventListItem );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        /* The items are on the stack of the task, so must not be referenced
+         * once the task runs again. */
+        pxTCB->pxEventListItems = NULL;
+        pxTCB->uxEventListItems = ( UBaseType_t ) 0U;
+    }
+
+#endif /* configUSE_QUEUE_RECEIVE_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+
+    static TCB_t * prvRemoveEventListsHead( const List_t * const pxEventList )
+    {
+        TCB_t * pxTCB = NULL;
+        ListItem_t * pxHeadItem;
+
+        while( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
+        {
+            pxHeadItem = listGET_HEAD_ENTRY( pxEventList );
+            pxTCB = listGET_LIST_ITEM_OWNER( pxHeadItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            if( pxTCB->pxEventListItems == NULL )
+            {
+                /* An ordinary waiter. */
+                listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                break;
+            }
+            else
+            {
+                listREMOVE_ITEM( pxHeadItem );
+            }
+
+            if( listIS_CONTAINED_WITHIN( &xPendingReadyList, &( pxTCB->xEventListItem ) ) == pdFALSE )
+            {
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    prvRemoveFromEventLists( pxTCB );
+                }
+                else
+                {
+                    /* Another event list may be in the middle of being updated,
+                     * so its item is left in place until the task is moved out
+                     * of the pending ready list by xTaskResumeAll(). */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                break;
+            }
+            else
+            {
+                /* The task was already unblocked by another of its event lists
+                 * while the scheduler was suspended, so this item is stale. */
+                pxTCB = NULL;
+            }
+        }
+
+        return pxTCB;
+    }
+
+#endif /* configUSE_QUEUE_RECEIVE_ANY */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TIMERS == 1 )
 
     void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
@@ -3186,7 +5130,32 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
      * pxEventList is not empty. */
     pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
     configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+
+    #if ( configUSE_QUEUE_RECEIVE_ANY == 1 )
+    {
+        if( pxUnblockedTCB->pxEventListItems != NULL )
+        {
+            pxUnblockedTCB = prvRemoveEventListsHead( pxEventList );
+
+            if( pxUnblockedTCB == NULL )
+            {
+                return pdFALSE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+        }
+    }
+    #else /* configUSE_QUEUE_RECEIVE_ANY */
+    {
+        listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+    }
+    #endif /* configUSE_QUEUE_RECEIVE_ANY */
 
     if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
     {
@@ -3214,21 +5183,46 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #if ( configNUMBER_OF_CORES == 1 )
     {
-        /* Return true if the task removed from the event list has a higher
-         * priority than the calling task.  This allows the calling task to know if
-         * it should force a context switch now. */
-        xReturn = pdTRUE;
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        {
+            /* Return true if the task removed from the event list has a higher
+             * priority than the calling task.  This allows the calling task to know if
+             * it should force a context switch now. */
+            xReturn = pdTRUE;
 
-        /* Mark that a yield is pending in case the user is not using the
-         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-        xYieldPending = pdTRUE;
+            /* Mark that a yield is pending in case the user is not using the
+             * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
     }
-    else
+    #else /* if ( configNUMBER_OF_CORES == 1 ) */
     {
         xReturn = pdFALSE;
+
+        #if ( configUSE_PREEMPTION == 1 )
+        {
+            /* The unblocked task may preempt a task on any core.  Only return
+             * true if it is the calling core that has to switch context. */
+            prvYieldForTask( pxUnblockedTCB );
+
+            if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_PREEMPTION */
     }
+    #endif /* configNUMBER_OF_CORES */
 
     return xReturn;
 }
@@ -3272,14 +5266,33 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
     listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
     prvAddTaskToReadyList( pxUnblockedTCB );
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #if ( configNUMBER_OF_CORES == 1 )
     {
-        /* The unblocked task has a priority above that of the calling task, so
-         * a context switch is required.  This function is called with the
-         * scheduler suspended so xYieldPending is set so the context switch
-         * occurs immediately that the scheduler is resumed (unsuspended). */
-        xYieldPending = pdTRUE;
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        {
+            /* The unblocked task has a priority above that of the calling task, so
+             * a context switch is required.  This function is called with the
+             * scheduler suspended so xYieldPending is set so the context switch
+             * occurs immediately that the scheduler is resumed (unsuspended). */
+            xYieldPending = pdTRUE;
+        }
+    }
+    #else
+    {
+        #if ( configUSE_PREEMPTION == 1 )
+        {
+            /* prvYieldForTask() must be called from a critical section.  A
+             * yield of the calling core is held pending until the scheduler is
+             * resumed. */
+            taskENTER_CRITICAL();
+            {
+                prvYieldForTask( pxUnblockedTCB );
+            }
+            taskEXIT_CRITICAL();
+        }
+        #endif /* configUSE_PREEMPTION */
     }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -3370,7 +5383,11 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
 
 void vTaskMissedYield( void )
 {
-    xYieldPending = pdTRUE;
+    #if ( configNUMBER_OF_CORES == 1 )
+        xYieldPending = pdTRUE;
+    #else
+        xYieldPendings[ portGET_CORE_ID() ] = pdTRUE;
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -3462,9 +5479,10 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
              *
              * A critical region is not required here as we are just reading from
              * the list, and an occasional incorrect value will not matter.  If
-             * the ready list at the idle priority contains more than one task
-             * then a task other than the idle task is ready to execute. */
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+             * the ready list at the idle priority contains more tasks than there
+             * are idle tasks then a task other than an idle task is ready to
+             * execute. */
+            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
             {
                 taskYIELD();
             }
@@ -3541,6 +5559,52 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static portTASK_FUNCTION( prvPassiveIdleTask, pvParameters )
+    {
+        /* Stop warnings. */
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            #if ( configUSE_PREEMPTION == 0 )
+            {
+                /* As in prvIdleTask(), force a task switch to see if any other
+                 * task has become available. */
+                taskYIELD();
+            }
+            #endif /* configUSE_PREEMPTION */
+
+            #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+            {
+                /* See the equivalent comment in prvIdleTask(). */
+                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+                {
+                    taskYIELD();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+            #if ( configUSE_PASSIVE_IDLE_HOOK == 1 )
+            {
+                extern void vApplicationPassiveIdleHook( void );
+
+                /* Same rules as vApplicationIdleHook() - it MUST NOT, UNDER ANY
+                 * CIRCUMSTANCES, CALL A FUNCTION THAT MIGHT BLOCK. */
+                vApplicationPassiveIdleHook();
+            }
+            #endif /* configUSE_PASSIVE_IDLE_HOOK */
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TICKLESS_IDLE != 0 )
 
     eSleepModeStatus eTaskConfirmSleepModeStatus( void )
@@ -3663,8 +5727,27 @@ static void prvInitialiseTaskLists( void )
         vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
     }
 
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
+    #if ( configUSE_TIMER_WHEEL == 0 )
+    {
+        vListInitialise( &xDelayedTaskList1 );
+        vListInitialise( &xDelayedTaskList2 );
+    }
+    #else
+    {
+        UBaseType_t uxLevel, uxSlot;
+
+        for( uxLevel = 0U; uxLevel < taskTIMER_WHEEL_LEVELS; uxLevel++ )
+        {
+            for( uxSlot = 0U; uxSlot < taskTIMER_WHEEL_SLOTS; uxSlot++ )
+            {
+                vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+            }
+
+            ulTimerWheelOccupied[ uxLevel ] = 0UL;
+        }
+    }
+    #endif /* configUSE_TIMER_WHEEL */
+
     vListInitialise( &xPendingReadyList );
 
     #if ( INCLUDE_vTaskDelete == 1 )
@@ -3679,10 +5762,19 @@ static void prvInitialiseTaskLists( void )
     }
     #endif /* INCLUDE_vTaskSuspend */
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    #if ( configUSE_TIMER_WHEEL == 0 )
+    {
+        /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+         * using list2. */
+        pxDelayedTaskList = &xDelayedTaskList1;
+        pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    }
+    #else
+    {
+        /* pxDelayedTaskList is set by prvTimerWheelAdvance() on each tick. */
+        pxDelayedTaskList = &( xTimerWheel[ 0 ][ taskTIMER_WHEEL_SLOT_INDEX( xTickCount, 0U ) ] );
+    }
+    #endif /* configUSE_TIMER_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
@@ -3698,16 +5790,51 @@ static void prvCheckTasksWaitingTermination( void )
          * being called too often in the idle task. */
         while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
         {
-            taskENTER_CRITICAL();
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                --uxCurrentNumberOfTasks;
-                --uxDeletedTasksWaitingCleanUp;
+                taskENTER_CRITICAL();
+                {
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    --uxCurrentNumberOfTasks;
+                    --uxDeletedTasksWaitingCleanUp;
+                }
+                taskEXIT_CRITICAL();
+
+                prvDeleteTCB( pxTCB );
             }
-            taskEXIT_CRITICAL();
+            #else /* if ( configNUMBER_OF_CORES == 1 ) */
+            {
+                taskENTER_CRITICAL();
+                {
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-            prvDeleteTCB( pxTCB );
+                    /* A task deleted while running on another core remains on
+                     * that core until the core has switched it out. */
+                    if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+                    {
+                        ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                        --uxCurrentNumberOfTasks;
+                        --uxDeletedTasksWaitingCleanUp;
+                    }
+                    else
+                    {
+                        pxTCB = NULL;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( pxTCB != NULL )
+                {
+                    prvDeleteTCB( pxTCB );
+                }
+                else
+                {
+                    /* Try again next time through the idle loop. */
+                    break;
+                }
+            }
+            #endif /* configNUMBER_OF_CORES */
         }
     }
     #endif /* INCLUDE_vTaskDelete */
@@ -3761,7 +5888,7 @@ static void prvCheckTasksWaitingTermination( void )
          * state is just set to whatever is passed in. */
         if( eState != eInvalid )
         {
-            if( pxTCB == pxCurrentTCB )
+            if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
             {
                 pxTaskStatus->eCurrentState = eRunning;
             }
@@ -3901,44 +6028,165 @@ static void prvCheckTasksWaitingTermination( void )
         }
         #else
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+        }
+        #endif
+
+        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+
+    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        UBaseType_t uxReturn;
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        #if portSTACK_GROWTH < 0
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+        }
+        #else
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+        }
+        #endif
+
+        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 )
+
+    static BaseType_t prvStackHighWaterUpdate( TCB_t * pxTCB,
+                                               StackType_t * pxStackUsed )
+    {
+        BaseType_t xDeeper;
+        BaseType_t xUnderPressure = pdFALSE;
+
+        /* A saved stack pointer outside the stack is left to the stack
+         * overflow checks. */
+        #if ( portSTACK_GROWTH < 0 )
+        {
+            xDeeper = ( ( pxStackUsed < pxTCB->pxStackHighWater ) && ( pxStackUsed >= pxTCB->pxStack ) ) ? pdTRUE : pdFALSE;
+        }
+        #else
+        {
+            xDeeper = ( ( pxStackUsed > pxTCB->pxStackHighWater ) && ( pxStackUsed <= pxTCB->pxEndOfStack ) ) ? pdTRUE : pdFALSE;
         }
         #endif
 
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+        if( xDeeper != pdFALSE )
+        {
+            pxTCB->pxStackHighWater = pxStackUsed;
 
-        return uxReturn;
-    }
+            #if ( configSTACK_PRESSURE_THRESHOLD > 0 )
+            {
+                if( prvStackHighWaterFree( pxTCB ) <= ( configSTACK_DEPTH_TYPE ) configSTACK_PRESSURE_THRESHOLD )
+                {
+                    xUnderPressure = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
+        return xUnderPressure;
+    }
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+    static configSTACK_DEPTH_TYPE prvStackHighWaterFree( const TCB_t * pxTCB )
+    {
+        #if ( portSTACK_GROWTH < 0 )
+        {
+            return ( configSTACK_DEPTH_TYPE ) ( pxTCB->pxStackHighWater - pxTCB->pxStack );
+        }
+        #else
+        {
+            return ( configSTACK_DEPTH_TYPE ) ( pxTCB->pxEndOfStack - pxTCB->pxStackHighWater );
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
 
-    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMarkIncremental( TaskHandle_t xTask )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        UBaseType_t uxReturn;
+        StackType_t * pxStackWord;
+        StackType_t * pxDeepestUsed;
+        configSTACK_DEPTH_TYPE uxWordsLeft;
+        configSTACK_DEPTH_TYPE uxReturn;
+        UBaseType_t uxUnusedRun = 0U;
+        BaseType_t xUnderPressure;
 
         pxTCB = prvGetTCBFromHandle( xTask );
 
-        #if portSTACK_GROWTH < 0
+        /* Everything up to the high water mark is known to have been used, so
+         * only the words beyond it need to be checked for the fill value.  The
+         * scan stops after configSTACK_HIGH_WATER_SCAN_GAP unused words in a row
+         * instead of at the end of the stack, so a call that finds no new use
+         * reads a fixed number of words whatever the size of the stack.  The
+         * mark cannot move back, so the scan is not synchronised with the task
+         * using its stack. */
+        pxDeepestUsed = pxTCB->pxStackHighWater;
+        pxStackWord = pxDeepestUsed;
+        uxWordsLeft = prvStackHighWaterFree( pxTCB );
+
+        while( ( uxWordsLeft > ( configSTACK_DEPTH_TYPE ) 0 ) && ( uxUnusedRun < ( UBaseType_t ) configSTACK_HIGH_WATER_SCAN_GAP ) )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            pxStackWord += portSTACK_GROWTH;
+            uxWordsLeft--;
+
+            if( *pxStackWord == tskSTACK_FILL_WORD )
+            {
+                uxUnusedRun++;
+            }
+            else
+            {
+                pxDeepestUsed = pxStackWord;
+                uxUnusedRun = 0U;
+            }
         }
-        #else
+
+        taskENTER_CRITICAL();
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            xUnderPressure = prvStackHighWaterUpdate( pxTCB, pxDeepestUsed );
+            uxReturn = prvStackHighWaterFree( pxTCB );
         }
-        #endif
+        taskEXIT_CRITICAL();
 
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+        if( xUnderPressure != pdFALSE )
+        {
+            taskSTACK_PRESSURE_HOOK( pxTCB, uxReturn );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
         return uxReturn;
     }
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+#endif /* configUSE_STACK_HIGH_WATER_TRACKING */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -3996,42 +6244,306 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+    static void prvResetNextTaskUnblockTime( void )
     {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
+        if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+        {
+            /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+             * the maximum possible value so it is  extremely unlikely that the
+             * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+             * there is an item in the delayed list. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            /* The new current delayed list is not empty, get the value of
+             * the item at the head of the delayed list.  This is the time at
+             * which the task at the head of the delayed list should be removed
+             * from the Blocked state. */
+            xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        }
     }
-    else
+
+#else /* configUSE_TIMER_WHEEL */
+
+    static void prvResetNextTaskUnblockTime( void )
     {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        const TickType_t xConstTickCount = xTickCount;
+        TickType_t xTicksToWake = portMAX_DELAY;
+        TickType_t xFirstTick, xTicks, xTimeToWake;
+        UBaseType_t uxLevel, uxFirstSlot, uxSlot, uxOffset;
+        uint32_t ulSlotBit;
+
+        /* The tasks in a slot on level 0 unblock on the tick of the slot.  The
+         * tasks in a slot on a higher level cannot unblock before they are moved
+         * down from that slot, so the time at which the first occupied slot on
+         * each level is reached gives a time at or before which the next task
+         * will unblock.  xNextTaskUnblockTime is set to the earliest such time -
+         * if no task unblocks then the next slot is searched for again. */
+        for( uxLevel = 0U; uxLevel < taskTIMER_WHEEL_LEVELS; uxLevel++ )
+        {
+            if( uxLevel == 0U )
+            {
+                /* Level 0 has not yet been processed for the current tick if
+                 * this is called from within xTaskIncrementTick(). */
+                xFirstTick = xConstTickCount;
+            }
+            else
+            {
+                /* The first tick after the current tick on which the level
+                 * below completes a revolution. */
+                xFirstTick = ( xConstTickCount + taskTIMER_WHEEL_SLOT_TICKS( uxLevel ) ) & ~( taskTIMER_WHEEL_SLOT_TICKS( uxLevel ) - ( TickType_t ) 1 );
+            }
+
+            if( ( TickType_t ) ( xFirstTick - xConstTickCount ) >= xTicksToWake )
+            {
+                /* The remaining levels cannot be reached any sooner. */
+                break;
+            }
+
+            uxFirstSlot = taskTIMER_WHEEL_SLOT_INDEX( xFirstTick, uxLevel );
+
+            for( uxOffset = 0U; ( uxOffset < taskTIMER_WHEEL_SLOTS ) && ( ulTimerWheelOccupied[ uxLevel ] != 0UL ); uxOffset++ )
+            {
+                uxSlot = ( uxFirstSlot + uxOffset ) & ( UBaseType_t ) taskTIMER_WHEEL_SLOT_MASK;
+                ulSlotBit = 1UL << uxSlot;
+
+                if( ( ulTimerWheelOccupied[ uxLevel ] & ulSlotBit ) != 0UL )
+                {
+                    if( listLIST_IS_EMPTY( &( xTimerWheel[ uxLevel ][ uxSlot ] ) ) != pdFALSE )
+                    {
+                        /* The tasks that were in the slot have already left the
+                         * Blocked state. */
+                        ulTimerWheelOccupied[ uxLevel ] &= ~ulSlotBit;
+                    }
+                    else
+                    {
+                        xTicks = ( xFirstTick - xConstTickCount ) + ( ( TickType_t ) uxOffset * taskTIMER_WHEEL_SLOT_TICKS( uxLevel ) );
+
+                        if( xTicks < xTicksToWake )
+                        {
+                            xTicksToWake = xTicks;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        break;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+
+        xTimeToWake = xConstTickCount + xTicksToWake;
+
+        if( ( xTicksToWake == portMAX_DELAY ) || ( xTimeToWake < xConstTickCount ) )
+        {
+            /* No task is blocked, or the next task to unblock does so after the
+             * tick count overflows - in which case this function is called
+             * again when the tick count overflows.  Set xNextTaskUnblockTime to
+             * the maximum possible value, as is done for the delayed lists. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            xNextTaskUnblockTime = xTimeToWake;
+        }
     }
-}
-/*-----------------------------------------------------------*/
+    /*-----------------------------------------------------------*/
+
+    static void prvTimerWheelInsert( ListItem_t * const pxListItem,
+                                     const TickType_t xNextTick )
+    {
+        TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( pxListItem );
+        TickType_t xTicksToWake;
+        UBaseType_t uxLevel = 0U;
+        UBaseType_t uxSlot;
+
+        if( xTimeToWake == ( TickType_t ) ( xNextTick - ( TickType_t ) 1 ) )
+        {
+            /* A wake time of the tick that has already been processed, which
+             * can only result from a zero block time, is treated as the next
+             * tick - just as it would be with the delayed lists. */
+            xTimeToWake = xNextTick;
+            listSET_LIST_ITEM_VALUE( pxListItem, xTimeToWake );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Use the lowest level on which the wake time is less than one
+         * revolution away. */
+        xTicksToWake = xTimeToWake - xNextTick;
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+        while( ( uxLevel < ( taskTIMER_WHEEL_LEVELS - 1U ) ) && ( xTicksToWake >= taskTIMER_WHEEL_SLOT_TICKS( uxLevel + 1U ) ) )
+        {
+            uxLevel++;
+        }
+
+        uxSlot = taskTIMER_WHEEL_SLOT_INDEX( xTimeToWake, uxLevel );
+        listINSERT_END( &( xTimerWheel[ uxLevel ][ uxSlot ] ), pxListItem );
+        ulTimerWheelOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+    }
+    /*-----------------------------------------------------------*/
 
-    TaskHandle_t xTaskGetCurrentTaskHandle( void )
+    static void prvTimerWheelAdvance( const TickType_t xTick )
     {
-        TaskHandle_t xReturn;
+        UBaseType_t uxLevel, uxSlot;
+        List_t * pxSlot;
+        ListItem_t * pxListItem;
+
+        /* Each time level n - 1 completes a revolution the tasks in the next
+         * slot of level n are within one revolution of a lower level, so are
+         * moved down.  None of them can be moved back into the same slot. */
+        for( uxLevel = 1U; uxLevel < taskTIMER_WHEEL_LEVELS; uxLevel++ )
+        {
+            if( ( xTick & ( taskTIMER_WHEEL_SLOT_TICKS( uxLevel ) - ( TickType_t ) 1 ) ) != ( TickType_t ) 0 )
+            {
+                break;
+            }
 
-        /* A critical section is not required as this is not called from
-         * an interrupt and the current TCB will always be the same for any
-         * individual execution thread. */
-        xReturn = pxCurrentTCB;
+            uxSlot = taskTIMER_WHEEL_SLOT_INDEX( xTick, uxLevel );
+            pxSlot = &( xTimerWheel[ uxLevel ][ uxSlot ] );
 
-        return xReturn;
+            while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+            {
+                pxListItem = listGET_HEAD_ENTRY( pxSlot );
+                listREMOVE_ITEM( pxListItem );
+                prvTimerWheelInsert( pxListItem, xTick );
+            }
+
+            ulTimerWheelOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+        }
+
+        /* All the tasks in the level 0 slot for xTick are due to unblock. */
+        pxDelayedTaskList = &( xTimerWheel[ 0 ][ taskTIMER_WHEEL_SLOT_INDEX( xTick, 0U ) ] );
     }
+    /*-----------------------------------------------------------*/
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+
+        static void prvTimerWheelStep( const TickType_t xFromTick,
+                                       const TickType_t xToTick )
+        {
+            UBaseType_t uxLevel, uxFirstSlot, uxSlot;
+            TickType_t xRevolutions, xRevolution;
+            List_t * pxSlot;
+            ListItem_t * pxListItem;
+
+            /* Every task is due to unblock after xToTick, so is inserted again
+             * on the level it would have reached at xToTick.  That is always a
+             * lower level, so the levels are visited from the lowest up to
+             * avoid visiting a task twice. */
+            for( uxLevel = 1U; uxLevel < taskTIMER_WHEEL_LEVELS; uxLevel++ )
+            {
+                /* The number of times level uxLevel - 1 completed a revolution
+                 * during the step, each of which empties the next slot of this
+                 * level. */
+                xRevolutions = ( xToTick >> ( configTIMER_WHEEL_SLOT_BITS * uxLevel ) ) - ( xFromTick >> ( configTIMER_WHEEL_SLOT_BITS * uxLevel ) );
+
+                if( xRevolutions == ( TickType_t ) 0 )
+                {
+                    /* The higher levels cannot have completed a revolution
+                     * either. */
+                    break;
+                }
+
+                if( xRevolutions > ( TickType_t ) taskTIMER_WHEEL_SLOTS )
+                {
+                    xRevolutions = ( TickType_t ) taskTIMER_WHEEL_SLOTS;
+                }
+
+                uxFirstSlot = taskTIMER_WHEEL_SLOT_INDEX( xFromTick, uxLevel ) + 1U;
+
+                for( xRevolution = 0U; ( xRevolution < xRevolutions ) && ( ulTimerWheelOccupied[ uxLevel ] != 0UL ); xRevolution++ )
+                {
+                    uxSlot = ( uxFirstSlot + ( UBaseType_t ) xRevolution ) & ( UBaseType_t ) taskTIMER_WHEEL_SLOT_MASK;
+
+                    if( ( ulTimerWheelOccupied[ uxLevel ] & ( 1UL << uxSlot ) ) != 0UL )
+                    {
+                        pxSlot = &( xTimerWheel[ uxLevel ][ uxSlot ] );
+
+                        while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                        {
+                            pxListItem = listGET_HEAD_ENTRY( pxSlot );
+                            listREMOVE_ITEM( pxListItem );
+                            prvTimerWheelInsert( pxListItem, xToTick + ( TickType_t ) 1 );
+                        }
+
+                        ulTimerWheelOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+
+            pxDelayedTaskList = &( xTimerWheel[ 0 ][ taskTIMER_WHEEL_SLOT_INDEX( xToTick, 0U ) ] );
+        }
+
+    #endif /* configUSE_TICKLESS_IDLE */
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) )
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        TaskHandle_t xTaskGetCurrentTaskHandle( void )
+        {
+            TaskHandle_t xReturn;
+
+            /* A critical section is not required as this is not called from
+             * an interrupt and the current TCB will always be the same for any
+             * individual execution thread. */
+            xReturn = pxCurrentTCB;
+
+            return xReturn;
+        }
+    #else /* if ( configNUMBER_OF_CORES == 1 ) */
+        TaskHandle_t xTaskGetCurrentTaskHandle( void )
+        {
+            TaskHandle_t xReturn;
+            UBaseType_t uxSavedInterruptStatus;
+
+            /* Interrupts are masked so the calling task cannot be moved to
+             * another core between reading the core ID and reading the TCB. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+            {
+                xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+            }
+            portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+
+            return xReturn;
+        }
+
+        TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+        {
+            TaskHandle_t xReturn = NULL;
+
+            if( taskVALID_CORE_ID( xCoreID ) != pdFALSE )
+            {
+                xReturn = pxCurrentTCBs[ xCoreID ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
@@ -4046,14 +6558,25 @@ static void prvResetNextTaskUnblockTime( void )
         }
         else
         {
-            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-            {
-                xReturn = taskSCHEDULER_RUNNING;
-            }
-            else
+            /* On a multi-core build the critical section waits out any other
+             * core that has the scheduler suspended, so only a suspension by
+             * the calling task is reported. */
+            #if ( configNUMBER_OF_CORES > 1 )
+                taskENTER_CRITICAL();
+            #endif
             {
-                xReturn = taskSCHEDULER_SUSPENDED;
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    xReturn = taskSCHEDULER_RUNNING;
+                }
+                else
+                {
+                    xReturn = taskSCHEDULER_SUSPENDED;
+                }
             }
+            #if ( configNUMBER_OF_CORES > 1 )
+                taskEXIT_CRITICAL();
+            #endif
         }
 
         return xReturn;
@@ -4064,9 +6587,53 @@ static void prvResetNextTaskUnblockTime( void )
 
 #if ( configUSE_MUTEXES == 1 )
 
+    static void prvInheritPriority( TCB_t * const pxTCB )
+    {
+        /* Adjust the mutex holder state to account for its new
+         * priority.  Only reset the event list item value if the value is
+         * not being used for anything else. */
+        if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+        {
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* If the task being modified is in the ready state it will need
+         * to be moved into a new list. */
+        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+        {
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                /* It is known that the task is in its ready list so
+                 * there is no need to check again and the port level
+                 * reset macro can be called directly. */
+                portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Inherit the priority before being moved into the new list. */
+            pxTCB->uxPriority = pxCurrentTCB->uxPriority;
+            prvAddTaskToReadyList( pxTCB );
+        }
+        else
+        {
+            /* Just inherit the priority. */
+            pxTCB->uxPriority = pxCurrentTCB->uxPriority;
+        }
+
+        traceTASK_PRIORITY_INHERIT( pxTCB, pxCurrentTCB->uxPriority );
+    }
+/*-----------------------------------------------------------*/
+
     BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
     {
-        TCB_t * const pxMutexHolderTCB = pxMutexHolder;
+        TCB_t * pxMutexHolderTCB = pxMutexHolder;
         BaseType_t xReturn = pdFALSE;
 
         /* If the mutex was given back by an interrupt while the queue was
@@ -4076,48 +6643,42 @@ static void prvResetNextTaskUnblockTime( void )
         {
             /* If the holder of the mutex has a priority below the priority of
              * the task attempting to obtain the mutex then it will temporarily
-             * inherit the priority of the task attempting to obtain the mutex. */
-            if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
-            {
-                /* Adjust the mutex holder state to account for its new
-                 * priority.  Only reset the event list item value if the value is
-                 * not being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                {
-                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                /* If the task being modified is in the ready state it will need
-                 * to be moved into a new list. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
-                {
-                    if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
-                         * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+             * inherit the priority of the task attempting to obtain the mutex. */
+            if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+            {
+                prvInheritPriority( pxMutexHolderTCB );
 
-                    /* Inherit the priority before being moved into the new list. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-                    prvAddTaskToReadyList( pxMutexHolderTCB );
-                }
-                else
+                #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
                 {
-                    /* Just inherit the priority. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-                }
+                    /* If the mutex holder is itself blocked on a mutex then the
+                     * holder of that mutex must also inherit the priority, or
+                     * it can still delay the calling task indefinitely.  Follow
+                     * the chain until a holder is found that is not blocked on
+                     * a mutex or already has at least the calling task's
+                     * priority.  Every task on a chain has a priority no lower
+                     * than the task before it, as each inherited along the chain
+                     * when it blocked, so the walk can stop there - which also
+                     * ends it if the chain loops back on itself in a deadlock. */
+                    while( ( pxMutexHolderTCB->pxBlockingMutexHolder != NULL ) &&
+                           ( listLIST_ITEM_CONTAINER( &( pxMutexHolderTCB->xEventListItem ) ) != NULL ) )
+                    {
+                        /* Keep the mutex's waiting tasks in priority order, so
+                         * the task that inherited is the next to be woken. */
+                        prvResortMutexWaiter( pxMutexHolderTCB );
+
+                        pxMutexHolderTCB = *( pxMutexHolderTCB->pxBlockingMutexHolder );
 
-                traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+                        if( ( pxMutexHolderTCB == NULL ) || ( pxMutexHolderTCB->uxPriority >= pxCurrentTCB->uxPriority ) )
+                        {
+                            break;
+                        }
+                        else
+                        {
+                            prvInheritPriority( pxMutexHolderTCB );
+                        }
+                    }
+                }
+                #endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
 
                 /* Inheritance occurred. */
                 xReturn = pdTRUE;
@@ -4234,17 +6795,18 @@ static void prvResetNextTaskUnblockTime( void )
 
 #if ( configUSE_MUTEXES == 1 )
 
-    void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
-                                              UBaseType_t uxHighestPriorityWaitingTask )
+    static TCB_t * prvDisinheritPriorityAfterTimeout( TCB_t * const pxTCB,
+                                                      UBaseType_t uxHighestPriorityWaitingTask,
+                                                      UBaseType_t * const puxNextHighestPriorityWaitingTask )
     {
-        TCB_t * const pxTCB = pxMutexHolder;
+        TCB_t * pxNextTCB = NULL;
         UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
         const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
 
-        if( pxMutexHolder != NULL )
+        if( pxTCB != NULL )
         {
-            /* If pxMutexHolder is not NULL then the holder must hold at least
-             * one mutex. */
+            /* If pxTCB is not NULL then the holder must hold at least one
+             * mutex. */
             configASSERT( pxTCB->uxMutexesHeld );
 
             /* Determine the priority to which the priority of the task that
@@ -4274,45 +6836,344 @@ static void prvResetNextTaskUnblockTime( void )
                      * its own priority. */
                     configASSERT( pxTCB != pxCurrentTCB );
 
-                    /* Disinherit the priority, remembering the previous
-                     * priority to facilitate determining the subject task's
-                     * state. */
-                    traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
-                    uxPriorityUsedOnEntry = pxTCB->uxPriority;
-                    pxTCB->uxPriority = uxPriorityToUse;
+                    /* Disinherit the priority, remembering the previous
+                     * priority to facilitate determining the subject task's
+                     * state. */
+                    traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
+                    uxPriorityUsedOnEntry = pxTCB->uxPriority;
+                    pxTCB->uxPriority = uxPriorityToUse;
+
+                    #if ( configNUMBER_OF_CORES > 1 )
+                    {
+                        /* The mutex holder may be running on another core at
+                         * what is now too high a priority - reschedule that
+                         * core. */
+                        if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+                        {
+                            prvYieldCore( pxTCB->xTaskRunState );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configNUMBER_OF_CORES */
+
+                    /* Only reset the event list item value if the value is not
+                     * being used for anything else. */
+                    if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                    {
+                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* If the running task is not the task that holds the mutex
+                     * then the task that holds the mutex could be in either the
+                     * Ready, Blocked or Suspended states.  Only remove the task
+                     * from its current state list if it is in the Ready state as
+                     * the task's priority is going to change and there is one
+                     * Ready list per priority. */
+                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    {
+                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                        {
+                            /* It is known that the task is in its ready list so
+                             * there is no need to check again and the port level
+                             * reset macro can be called directly. */
+                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        prvAddTaskToReadyList( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                    {
+                        /* If the task is itself blocked on a mutex then the
+                         * holder of that mutex may have inherited the priority
+                         * just given up.  Move the task to its new place among
+                         * the tasks waiting for that mutex, then let the caller
+                         * recalculate the priority of that mutex's holder from
+                         * the task now at the head of the list.  The calling
+                         * task has timed out so is not blocked, but a chain that
+                         * loops back to it ends there. */
+                        if( ( uxPriorityToUse < uxPriorityUsedOnEntry ) &&
+                            ( pxTCB->pxBlockingMutexHolder != NULL ) &&
+                            ( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL ) )
+                        {
+                            prvResortMutexWaiter( pxTCB );
+
+                            if( *( pxTCB->pxBlockingMutexHolder ) != pxCurrentTCB )
+                            {
+                                pxNextTCB = *( pxTCB->pxBlockingMutexHolder );
+                                *puxNextHighestPriorityWaitingTask = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #else /* if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 ) */
+                    {
+                        ( void ) puxNextHighestPriorityWaitingTask;
+                    }
+                    #endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxNextTCB;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
+                                              UBaseType_t uxHighestPriorityWaitingTask )
+    {
+        TCB_t * pxTCB = pxMutexHolder;
+        UBaseType_t uxHighestPriority = uxHighestPriorityWaitingTask;
+
+        /* Without transitive priority inheritance only the holder of the mutex
+         * the calling task timed out on is considered.  With it, the walk moves
+         * along the chain of mutexes for as long as priorities are lowered, so
+         * it ends even if the chain loops. */
+        do
+        {
+            pxTCB = prvDisinheritPriorityAfterTimeout( pxTCB, uxHighestPriority, &uxHighestPriority );
+        } while( pxTCB != NULL );
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+    static void prvResortMutexWaiter( TCB_t * const pxTCB )
+    {
+        List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+        /* Only re-sort if the event list item value holds the task's
+         * priority. */
+        if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+        {
+            ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+            vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskSetBlockingMutexHolder( TaskHandle_t * const pxMutexHolder )
+    {
+        /* Called from a critical section by the task that is about to block
+         * on, or has stopped waiting for, a mutex. */
+        pxCurrentTCB->pxBlockingMutexHolder = pxMutexHolder;
+    }
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+    void vTaskEnterCritical( void )
+    {
+        portDISABLE_INTERRUPTS();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            ( pxCurrentTCB->uxCriticalNesting )++;
+
+            /* This is not the interrupt safe version of the enter critical
+             * function so  assert() if it is being called from an interrupt
+             * context.  Only API functions that end in "FromISR" can be used in an
+             * interrupt.  Only assert if the critical nesting count is 1 to
+             * protect against recursive calls if the assert function also uses a
+             * critical section. */
+            if( pxCurrentTCB->uxCriticalNesting == 1 )
+            {
+                portASSERT_IF_IN_ISR();
+
+                #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+                {
+                    vTaskRecordCriticalEntry();
+                }
+                #endif
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+    void vTaskExitCritical( void )
+    {
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( pxCurrentTCB->uxCriticalNesting > 0U )
+            {
+                ( pxCurrentTCB->uxCriticalNesting )--;
+
+                if( pxCurrentTCB->uxCriticalNesting == 0U )
+                {
+                    #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+                    {
+                        vTaskRecordCriticalExit();
+                    }
+                    #endif
+
+                    portENABLE_INTERRUPTS();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskEnterCritical( void )
+    {
+        portDISABLE_INTERRUPTS();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+            {
+                portGET_TASK_LOCK();
+                portGET_ISR_LOCK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            portINCREMENT_CRITICAL_NESTING_COUNT();
+
+            /* This is not the interrupt safe version of the enter critical
+             * function so  assert() if it is being called from an interrupt
+             * context.  Only API functions that end in "FromISR" can be used in an
+             * interrupt.  Only assert if the critical nesting count is 1 to
+             * protect against recursive calls if the assert function also uses a
+             * critical section. */
+            if( portGET_CRITICAL_NESTING_COUNT() == 1U )
+            {
+                portASSERT_IF_IN_ISR();
+
+                if( uxSchedulerSuspended == 0U )
+                {
+                    /* Another core may have asked this task to yield, for
+                     * example because it deleted or suspended it, before the
+                     * locks were obtained. */
+                    prvCheckForRunStateChange();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+                {
+                    vTaskRecordCriticalEntry();
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskExitCritical( void )
+    {
+        BaseType_t xYieldCurrentTask;
 
-                    /* Only reset the event list item value if the value is not
-                     * being used for anything else. */
-                    if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                    {
-                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    }
-                    else
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* If critical nesting count is zero then this function does not
+             * match a previous call to vTaskEnterCritical(). */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+            if( portGET_CRITICAL_NESTING_COUNT() > 0U )
+            {
+                portDECREMENT_CRITICAL_NESTING_COUNT();
+
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    /* Yields requested while in the critical section were
+                     * held pending - take them now. */
+                    xYieldCurrentTask = xYieldPendings[ portGET_CORE_ID() ];
+
+                    #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        vTaskRecordCriticalExit();
                     }
+                    #endif
 
-                    /* If the running task is not the task that holds the mutex
-                     * then the task that holds the mutex could be in either the
-                     * Ready, Blocked or Suspended states.  Only remove the task
-                     * from its current state list if it is in the Ready state as
-                     * the task's priority is going to change and there is one
-                     * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
-                    {
-                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                        {
-                            /* It is known that the task is in its ready list so
-                             * there is no need to check again and the port level
-                             * reset macro can be called directly. */
-                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                    portRELEASE_ISR_LOCK();
+                    portRELEASE_TASK_LOCK();
+                    portENABLE_INTERRUPTS();
 
-                        prvAddTaskToReadyList( pxTCB );
+                    if( xYieldCurrentTask != pdFALSE )
+                    {
+                        portYIELD();
                     }
                     else
                     {
@@ -4335,52 +7196,59 @@ static void prvResetNextTaskUnblockTime( void )
         }
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    void vTaskEnterCritical( void )
+    UBaseType_t uxTaskEnterCriticalFromISR( void )
     {
-        portDISABLE_INTERRUPTS();
+        UBaseType_t uxSavedInterruptStatus = 0;
 
         if( xSchedulerRunning != pdFALSE )
         {
-            ( pxCurrentTCB->uxCriticalNesting )++;
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 
-            /* This is not the interrupt safe version of the enter critical
-             * function so  assert() if it is being called from an interrupt
-             * context.  Only API functions that end in "FromISR" can be used in an
-             * interrupt.  Only assert if the critical nesting count is 1 to
-             * protect against recursive calls if the assert function also uses a
-             * critical section. */
-            if( pxCurrentTCB->uxCriticalNesting == 1 )
+            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
             {
-                portASSERT_IF_IN_ISR();
+                portGET_ISR_LOCK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
+
+            portINCREMENT_CRITICAL_NESTING_COUNT();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        return uxSavedInterruptStatus;
     }
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    void vTaskExitCritical( void )
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
     {
         if( xSchedulerRunning != pdFALSE )
         {
-            if( pxCurrentTCB->uxCriticalNesting > 0U )
+            /* If critical nesting count is zero then this function does not
+             * match a previous call to uxTaskEnterCriticalFromISR(). */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+            if( portGET_CRITICAL_NESTING_COUNT() > 0U )
             {
-                ( pxCurrentTCB->uxCriticalNesting )--;
+                portDECREMENT_CRITICAL_NESTING_COUNT();
 
-                if( pxCurrentTCB->uxCriticalNesting == 0U )
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
                 {
-                    portENABLE_INTERRUPTS();
+                    portRELEASE_ISR_LOCK();
+                    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
                 }
                 else
                 {
@@ -4398,7 +7266,32 @@ static void prvResetNextTaskUnblockTime( void )
         }
     }
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskYieldWithinAPI( void )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+        {
+            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+            {
+                portYIELD();
+            }
+            else
+            {
+                /* The kernel yields from within critical sections in places.
+                 * The yield is taken when the critical section is exited. */
+                xYieldPendings[ portGET_CORE_ID() ] = pdTRUE;
+            }
+        }
+        portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+    }
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
@@ -4686,6 +7579,22 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEX_HANDOFF == 1 ) || ( configUSE_RW_LOCKS == 1 ) )
+
+    TaskHandle_t pvTaskIncrementWaiterMutexHeldCount( const List_t * const pxEventList )
+    {
+        TCB_t * const pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+        /* Called from a critical section with the task at the head of
+         * pxEventList about to be unblocked holding the mutex. */
+        ( pxTCB->uxMutexesHeld )++;
+
+        return pxTCB;
+    }
+
+#endif /* if ( ( configUSE_MUTEX_HANDOFF == 1 ) || ( configUSE_RW_LOCKS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait,
@@ -4943,23 +7852,194 @@ TickType_t uxTaskResetEventItemValue( void )
                 }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else
+                {
+                    /* The notified task may preempt a task on any core. */
+                    taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                }
+                #endif /* configNUMBER_OF_CORES */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
+                                          UBaseType_t uxIndexToNotify,
+                                          uint32_t ulValue,
+                                          eNotifyAction eAction,
+                                          uint32_t * pulPreviousNotificationValue,
+                                          BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        TCB_t * pxTCB;
+        uint8_t ucOriginalNotifyState;
+        BaseType_t xReturn = pdPASS;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xTaskToNotify );
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        pxTCB = xTaskToNotify;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( pulPreviousNotificationValue != NULL )
+            {
+                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
+            }
+
+            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+
+            switch( eAction )
+            {
+                case eSetBits:
+                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
+                    break;
+
+                case eIncrement:
+                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+                    break;
+
+                case eSetValueWithOverwrite:
+                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                    break;
+
+                case eSetValueWithoutOverwrite:
+
+                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+                    {
+                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                    }
+                    else
+                    {
+                        /* The value could not be written to the task. */
+                        xReturn = pdFAIL;
+                    }
+
+                    break;
+
+                case eNoAction:
+
+                    /* The task is being notified without its notify value being
+                     * updated. */
+                    break;
+
+                default:
+
+                    /* Should not get here if all enums are handled.
+                     * Artificially force an assert by testing a value the
+                     * compiler can't assume is const. */
+                    configASSERT( xTickCount == ( TickType_t ) 0 );
+                    break;
+            }
+
+            traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify );
+
+            /* If the task is in the blocked state specifically to wait for a
+             * notification then unblock it now. */
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            {
+                /* The task should not have been on an event list. */
+                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    taskYIELD_IF_USING_PREEMPTION();
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The delayed and ready lists cannot be accessed, so hold
+                     * this task pending until the scheduler is resumed. */
+                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                }
+
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+
+                        /* Mark that a yield is pending in case the user is not
+                         * using the "xHigherPriorityTaskWoken" parameter to an ISR
+                         * safe FreeRTOS function. */
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* if ( configNUMBER_OF_CORES == 1 ) */
+                {
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        /* Other cores are interrupted directly, a yield of
+                         * the interrupted core is reported as usual. */
+                        prvYieldForTask( pxTCB );
+
+                        if( ( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_PREEMPTION */
                 }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
+                #endif /* configNUMBER_OF_CORES */
             }
         }
-        taskEXIT_CRITICAL();
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xReturn;
     }
@@ -4969,16 +8049,12 @@ TickType_t uxTaskResetEventItemValue( void )
 
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
-                                          UBaseType_t uxIndexToNotify,
-                                          uint32_t ulValue,
-                                          eNotifyAction eAction,
-                                          uint32_t * pulPreviousNotificationValue,
-                                          BaseType_t * pxHigherPriorityTaskWoken )
+    void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify,
+                                        UBaseType_t uxIndexToNotify,
+                                        BaseType_t * pxHigherPriorityTaskWoken )
     {
         TCB_t * pxTCB;
         uint8_t ucOriginalNotifyState;
-        BaseType_t xReturn = pdPASS;
         UBaseType_t uxSavedInterruptStatus;
 
         configASSERT( xTaskToNotify );
@@ -5004,294 +8080,674 @@ TickType_t uxTaskResetEventItemValue( void )
 
         pxTCB = xTaskToNotify;
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
-            if( pulPreviousNotificationValue != NULL )
-            {
-                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
-            }
-
             ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
             pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
-            switch( eAction )
-            {
-                case eSetBits:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
-                    break;
+            /* 'Giving' is equivalent to incrementing a count in a counting
+             * semaphore. */
+            ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
-                case eIncrement:
-                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
-                    break;
+            traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
 
-                case eSetValueWithOverwrite:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    break;
+            /* If the task is in the blocked state specifically to wait for a
+             * notification then unblock it now. */
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            {
+                /* The task should not have been on an event list. */
+                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
 
-                case eSetValueWithoutOverwrite:
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    /* The delayed and ready lists cannot be accessed, so hold
+                     * this task pending until the scheduler is resumed. */
+                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                }
 
-                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
                     {
-                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+
+                        /* Mark that a yield is pending in case the user is not
+                         * using the "xHigherPriorityTaskWoken" parameter in an ISR
+                         * safe FreeRTOS function. */
+                        xYieldPending = pdTRUE;
                     }
                     else
                     {
-                        /* The value could not be written to the task. */
-                        xReturn = pdFAIL;
+                        mtCOVERAGE_TEST_MARKER();
                     }
+                }
+                #else /* if ( configNUMBER_OF_CORES == 1 ) */
+                {
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        /* Other cores are interrupted directly, a yield of
+                         * the interrupted core is reported as usual. */
+                        prvYieldForTask( pxTCB );
 
-                    break;
+                        if( ( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_PREEMPTION */
+                }
+                #endif /* configNUMBER_OF_CORES */
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
 
-                case eNoAction:
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
 
-                    /* The task is being notified without its notify value being
-                     * updated. */
-                    break;
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-                default:
+    BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask,
+                                             UBaseType_t uxIndexToClear )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xReturn;
 
-                    /* Should not get here if all enums are handled.
-                     * Artificially force an assert by testing a value the
-                     * compiler can't assume is const. */
-                    configASSERT( xTickCount == ( TickType_t ) 0 );
-                    break;
+        configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        /* If null is passed in here then it is the calling task that is having
+         * its notification state cleared. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
+            {
+                pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
             }
+        }
+        taskEXIT_CRITICAL();
 
-            traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify );
+        return xReturn;
+    }
 
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
+                                            UBaseType_t uxIndexToClear,
+                                            uint32_t ulBitsToClear )
+    {
+        TCB_t * pxTCB;
+        uint32_t ulReturn;
+
+        /* If null is passed in here then it is the calling task that is having
+         * its notification state cleared. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            /* Return the notification as it was before the bits were cleared,
+             * then clear the bit mask. */
+            ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
+            pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
+        }
+        taskEXIT_CRITICAL();
+
+        return ulReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
+    {
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            return xIdleTaskHandle->ulRunTimeCounter;
+        }
+        #else
+        {
+            configRUN_TIME_COUNTER_TYPE ulReturn = 0;
+            BaseType_t xCoreID;
+
+            /* The time spent idle is summed across all the cores. */
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
             {
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+                ulReturn += xIdleTaskHandles[ xCoreID ]->ulRunTimeCounter;
+            }
 
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+            return ulReturn;
+        }
+        #endif /* configNUMBER_OF_CORES */
+    }
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
+
+        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+
+        /* For percentage calculations. */
+        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
+
+        /* Every core contributes to the idle time. */
+        #if ( configNUMBER_OF_CORES > 1 )
+            ulTotalTime *= ( configRUN_TIME_COUNTER_TYPE ) configNUMBER_OF_CORES;
+        #endif
+
+        /* Avoid divide by zero errors. */
+        if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
+        {
+            ulReturn = ulTaskGetIdleRunTimeCounter() / ulTotalTime;
+        }
+        else
+        {
+            ulReturn = 0;
+        }
+
+        return ulReturn;
+    }
+
+#endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TASK_PERF_COUNTERS == 1 ) || ( configUSE_LATENCY_HISTOGRAMS == 1 ) )
+
+    static configRUN_TIME_COUNTER_TYPE prvPerfGetTime( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow;
+
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+        #else
+            ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        return ulNow;
+    }
+
+#endif /* ( configUSE_TASK_PERF_COUNTERS == 1 ) || ( configUSE_LATENCY_HISTOGRAMS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_PERF_COUNTERS == 1 )
+
+    static void prvPerfSetTaskState( TCB_t * pxTCB,
+                                     uint8_t ucNewState,
+                                     configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        configRUN_TIME_COUNTER_TYPE ulElapsed = 0;
+
+        /* As in vTaskSwitchContext(), guard against a run time counter that
+         * appears to go backwards. */
+        if( ulNow > pxTCB->ulPerfStateTime )
+        {
+            ulElapsed = ulNow - pxTCB->ulPerfStateTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Readers copy the counters without taking any lock, so bracket the
+         * update with increments of the sequence number.  A reader that sees
+         * an odd number, or a number that changed during its copy, retries. */
+        pxTCB->uxPerfSequence++;
+        portMEMORY_BARRIER();
+
+        if( pxTCB->ucPerfState == taskPERF_STATE_RUNNING )
+        {
+            pxTCB->ulPerfRunTime += ulElapsed;
+        }
+        else if( pxTCB->ucPerfState == taskPERF_STATE_READY )
+        {
+            pxTCB->ulPerfReadyTime += ulElapsed;
+        }
+        else
+        {
+            pxTCB->ulPerfBlockedTime += ulElapsed;
+        }
+
+        if( ucNewState == taskPERF_STATE_RUNNING )
+        {
+            pxTCB->uxPerfSwitchesIn++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTCB->ucPerfState = ucNewState;
+        pxTCB->ulPerfStateTime = ulNow;
+
+        portMEMORY_BARRIER();
+        pxTCB->uxPerfSequence++;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPerfTaskReady( TCB_t * pxTCB )
+    {
+        if( pxTCB->ucPerfState != taskPERF_STATE_RUNNING )
+        {
+            prvPerfSetTaskState( pxTCB, taskPERF_STATE_READY, prvPerfGetTime() );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPerfRecordSwitch( BaseType_t xCoreID,
+                                     TCB_t * pxOldTCB,
+                                     TCB_t * pxNewTCB,
+                                     configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        CorePerfState_t * const pxCore = &( xCorePerfStates[ xCoreID ] );
+        BaseType_t xIdleRunning = pdFALSE;
+
+        if( pxOldTCB != pxNewTCB )
+        {
+            if( pxOldTCB != NULL )
+            {
+                /* A task that was preempted or yielded is still referenced from
+                 * its ready list.  Otherwise it blocked, suspended or deleted
+                 * itself. */
+                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxOldTCB->uxPriority ] ), &( pxOldTCB->xStateListItem ) ) != pdFALSE )
                 {
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                    prvPerfSetTaskState( pxOldTCB, taskPERF_STATE_READY, ulNow );
                 }
                 else
                 {
-                    /* The delayed and ready lists cannot be accessed, so hold
-                     * this task pending until the scheduler is resumed. */
-                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    prvPerfSetTaskState( pxOldTCB, taskPERF_STATE_BLOCKED, ulNow );
                 }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvPerfSetTaskState( pxNewTCB, taskPERF_STATE_RUNNING, ulNow );
+
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                xIdleRunning = ( pxNewTCB == xIdleTaskHandle ) ? pdTRUE : pdFALSE;
+            }
+            #else
+            {
+                BaseType_t x;
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                for( x = 0; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    if( pxHigherPriorityTaskWoken != NULL )
+                    if( pxNewTCB == xIdleTaskHandles[ x ] )
                     {
-                        *pxHigherPriorityTaskWoken = pdTRUE;
+                        xIdleRunning = pdTRUE;
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
                     }
-
-                    /* Mark that a yield is pending in case the user is not
-                     * using the "xHigherPriorityTaskWoken" parameter to an ISR
-                     * safe FreeRTOS function. */
-                    xYieldPending = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
                 }
             }
-        }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+            #endif /* configNUMBER_OF_CORES */
 
-        return xReturn;
-    }
+            pxCore->uxSequence++;
+            portMEMORY_BARRIER();
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
-/*-----------------------------------------------------------*/
+            if( ( pxCore->xIdleRunning != pdFALSE ) && ( ulNow > pxCore->ulLastSwitchTime ) )
+            {
+                pxCore->ulIdleTime += ulNow - pxCore->ulLastSwitchTime;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+            pxCore->uxContextSwitches++;
+            pxCore->ulLastSwitchTime = ulNow;
+            pxCore->xIdleRunning = xIdleRunning;
 
-    void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify,
-                                        UBaseType_t uxIndexToNotify,
-                                        BaseType_t * pxHigherPriorityTaskWoken )
-    {
-        TCB_t * pxTCB;
-        uint8_t ucOriginalNotifyState;
-        UBaseType_t uxSavedInterruptStatus;
+            portMEMORY_BARRIER();
+            pxCore->uxSequence++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
 
-        configASSERT( xTaskToNotify );
-        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+    void vTaskGetPerfCounters( const TaskHandle_t * const pxTasks,
+                               TaskPerfCounters_t * const pxPerfCounters,
+                               UBaseType_t uxTaskCount )
+    {
+        const TCB_t * pxTCB;
+        TaskPerfCounters_t * pxCounters;
+        UBaseType_t uxTask, uxSequence;
+        uint8_t ucState;
+        configRUN_TIME_COUNTER_TYPE ulNow, ulStateTime;
 
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+        configASSERT( pxTasks );
+        configASSERT( pxPerfCounters );
 
-        pxTCB = xTaskToNotify;
+        /* The clock is read once, before any counters are copied, so every
+         * snapshot shares the same timestamp.  A state change that completes
+         * after the clock is read is stamped no earlier than ulNow, so adding
+         * the time spent in the current state up to ulNow never makes a later
+         * snapshot appear to go backwards. */
+        ulNow = prvPerfGetTime();
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        for( uxTask = 0; uxTask < uxTaskCount; uxTask++ )
         {
-            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+            pxTCB = prvGetTCBFromHandle( pxTasks[ uxTask ] );
+            pxCounters = &( pxPerfCounters[ uxTask ] );
 
-            /* 'Giving' is equivalent to incrementing a count in a counting
-             * semaphore. */
-            ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+            /* The counters are copied without suspending the scheduler.  Retry
+             * if a writer was part way through an update. */
+            do
+            {
+                uxSequence = pxTCB->uxPerfSequence;
+                portMEMORY_BARRIER();
 
-            traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
+                pxCounters->ulRunTime = pxTCB->ulPerfRunTime;
+                pxCounters->ulReadyTime = pxTCB->ulPerfReadyTime;
+                pxCounters->ulBlockedTime = pxTCB->ulPerfBlockedTime;
+                pxCounters->uxSwitchesIn = pxTCB->uxPerfSwitchesIn;
+                ucState = pxTCB->ucPerfState;
+                ulStateTime = pxTCB->ulPerfStateTime;
 
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
-            {
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+                portMEMORY_BARRIER();
+            } while( ( ( uxSequence & ( UBaseType_t ) 1U ) != 0U ) || ( uxSequence != pxTCB->uxPerfSequence ) );
 
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-                {
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
-                }
-                else
+            pxCounters->ulTimestamp = ulNow;
+
+            /* Include the time spent in the current state so far. */
+            if( ulNow > ulStateTime )
+            {
+                if( ucState == taskPERF_STATE_RUNNING )
                 {
-                    /* The delayed and ready lists cannot be accessed, so hold
-                     * this task pending until the scheduler is resumed. */
-                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    pxCounters->ulRunTime += ulNow - ulStateTime;
                 }
-
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                else if( ucState == taskPERF_STATE_READY )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    if( pxHigherPriorityTaskWoken != NULL )
-                    {
-                        *pxHigherPriorityTaskWoken = pdTRUE;
-                    }
-
-                    /* Mark that a yield is pending in case the user is not
-                     * using the "xHigherPriorityTaskWoken" parameter in an ISR
-                     * safe FreeRTOS function. */
-                    xYieldPending = pdTRUE;
+                    pxCounters->ulReadyTime += ulNow - ulStateTime;
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    pxCounters->ulBlockedTime += ulNow - ulStateTime;
                 }
             }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
     }
+/*-----------------------------------------------------------*/
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+    void vTaskGetCorePerfCounters( BaseType_t xCoreID,
+                                   CorePerfCounters_t * pxPerfCounters )
+    {
+        const CorePerfState_t * pxCore;
+        UBaseType_t uxSequence;
+        BaseType_t xIdleRunning;
+        configRUN_TIME_COUNTER_TYPE ulLastSwitchTime;
+
+        configASSERT( pxPerfCounters );
+        configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+
+        pxCore = &( xCorePerfStates[ xCoreID ] );
+
+        /* As vTaskGetPerfCounters(). */
+        pxPerfCounters->ulTimestamp = prvPerfGetTime();
+
+        do
+        {
+            uxSequence = pxCore->uxSequence;
+            portMEMORY_BARRIER();
+
+            pxPerfCounters->ulIdleTime = pxCore->ulIdleTime;
+            pxPerfCounters->uxContextSwitches = pxCore->uxContextSwitches;
+            xIdleRunning = pxCore->xIdleRunning;
+            ulLastSwitchTime = pxCore->ulLastSwitchTime;
+
+            portMEMORY_BARRIER();
+        } while( ( ( uxSequence & ( UBaseType_t ) 1U ) != 0U ) || ( uxSequence != pxCore->uxSequence ) );
+
+        if( ( xIdleRunning != pdFALSE ) && ( pxPerfCounters->ulTimestamp > ulLastSwitchTime ) )
+        {
+            pxPerfCounters->ulIdleTime += pxPerfCounters->ulTimestamp - ulLastSwitchTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_TASK_PERF_COUNTERS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
 
-    BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask,
-                                             UBaseType_t uxIndexToClear )
+    static void prvLatencyTaskReady( TCB_t * pxTCB )
     {
-        TCB_t * pxTCB;
-        BaseType_t xReturn;
-
-        configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        /* Tasks created before the scheduler starts are not timed, and a task
+         * that is moved between ready lists by a priority change keeps the
+         * time it was first moved to the Ready state. */
+        if( ( xSchedulerRunning != pdFALSE ) &&
+            ( pxTCB->ucLatencyPending == pdFALSE ) &&
+            ( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE ) )
+        {
+            pxTCB->ulLatencyReadyTime = prvPerfGetTime();
+            pxTCB->ucLatencyPending = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
 
-        /* If null is passed in here then it is the calling task that is having
-         * its notification state cleared. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+    static void prvLatencyTaskSwitchedIn( TCB_t * pxTCB,
+                                          configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        configRUN_TIME_COUNTER_TYPE ulLatency = 0;
 
-        taskENTER_CRITICAL();
+        if( pxTCB->ucLatencyPending != pdFALSE )
         {
-            if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
+            pxTCB->ucLatencyPending = pdFALSE;
+
+            /* As in vTaskSwitchContext(), guard against a run time counter
+             * that appears to go backwards. */
+            if( ulNow > pxTCB->ulLatencyReadyTime )
             {
-                pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
-                xReturn = pdPASS;
+                ulLatency = ulNow - pxTCB->ulLatencyReadyTime;
             }
             else
             {
-                xReturn = pdFAIL;
+                mtCOVERAGE_TEST_MARKER();
             }
-        }
-        taskEXIT_CRITICAL();
 
-        return xReturn;
+            prvLatencyRecord( &( xLatencyHistograms[ eReadyLatency ][ pxTCB->uxPriority ] ), ulLatency );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-
-    uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
-                                            UBaseType_t uxIndexToClear,
-                                            uint32_t ulBitsToClear )
+    static void prvLatencyRecord( LatencyHistogramState_t * pxState,
+                                  configRUN_TIME_COUNTER_TYPE ulLatency )
     {
-        TCB_t * pxTCB;
-        uint32_t ulReturn;
+        configRUN_TIME_COUNTER_TYPE ulRemaining = ulLatency;
+        UBaseType_t uxBucket = 0;
 
-        /* If null is passed in here then it is the calling task that is having
-         * its notification state cleared. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+        /* Bucket n counts the latencies that need n bits, apart from the last
+         * bucket, which also counts every longer latency. */
+        while( ( ulRemaining != ( configRUN_TIME_COUNTER_TYPE ) 0 ) &&
+               ( uxBucket < ( UBaseType_t ) ( configLATENCY_HISTOGRAM_BUCKETS - 1 ) ) )
+        {
+            ulRemaining >>= 1;
+            uxBucket++;
+        }
 
-        taskENTER_CRITICAL();
+        /* As prvPerfSetTaskState(). */
+        pxState->uxSequence++;
+        portMEMORY_BARRIER();
+
+        pxState->xHistogram.ulBuckets[ uxBucket ]++;
+
+        if( ulLatency > pxState->xHistogram.ulMaximum )
         {
-            /* Return the notification as it was before the bits were cleared,
-             * then clear the bit mask. */
-            ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
-            pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
+            pxState->xHistogram.ulMaximum = ulLatency;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        taskEXIT_CRITICAL();
 
-        return ulReturn;
+        portMEMORY_BARRIER();
+        pxState->uxSequence++;
     }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
-
-    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
+    void vTaskRecordCriticalEntry( void )
     {
-        return xIdleTaskHandle->ulRunTimeCounter;
-    }
+        const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
 
-#endif
-/*-----------------------------------------------------------*/
+        /* Called with interrupts masked, so the core cannot change. */
+        if( xSchedulerRunning != pdFALSE )
+        {
+            ulCriticalEntryTime[ xCoreID ] = prvPerfGetTime();
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
+            #if ( configNUMBER_OF_CORES == 1 )
+                uxCriticalEntryPriority[ xCoreID ] = pxCurrentTCB->uxPriority;
+            #else
+                uxCriticalEntryPriority[ xCoreID ] = pxCurrentTCBs[ xCoreID ]->uxPriority;
+            #endif
 
-    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void )
+            xCriticalEntryRecorded[ xCoreID ] = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskRecordCriticalExit( void )
     {
-        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
+        const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+        configRUN_TIME_COUNTER_TYPE ulNow, ulLatency = 0;
 
-        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+        if( xCriticalEntryRecorded[ xCoreID ] != pdFALSE )
+        {
+            xCriticalEntryRecorded[ xCoreID ] = pdFALSE;
+            ulNow = prvPerfGetTime();
 
-        /* For percentage calculations. */
-        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
+            if( ulNow > ulCriticalEntryTime[ xCoreID ] )
+            {
+                ulLatency = ulNow - ulCriticalEntryTime[ xCoreID ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        /* Avoid divide by zero errors. */
-        if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
-        {
-            ulReturn = xIdleTaskHandle->ulRunTimeCounter / ulTotalTime;
+            prvLatencyRecord( &( xLatencyHistograms[ eCriticalLatency ][ uxCriticalEntryPriority[ xCoreID ] ] ), ulLatency );
         }
         else
         {
-            ulReturn = 0;
+            mtCOVERAGE_TEST_MARKER();
         }
+    }
+/*-----------------------------------------------------------*/
 
-        return ulReturn;
+    void vTaskGetLatencyHistogram( eLatencyHistogram eHistogram,
+                                   UBaseType_t uxPriority,
+                                   LatencyHistogram_t * pxHistogram )
+    {
+        const LatencyHistogramState_t * pxState;
+        UBaseType_t uxSequence;
+
+        configASSERT( pxHistogram );
+        configASSERT( ( eHistogram == eReadyLatency ) || ( eHistogram == eCriticalLatency ) );
+        configASSERT( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        pxState = &( xLatencyHistograms[ eHistogram ][ uxPriority ] );
+
+        /* As vTaskGetPerfCounters(). */
+        do
+        {
+            uxSequence = pxState->uxSequence;
+            portMEMORY_BARRIER();
+
+            *pxHistogram = pxState->xHistogram;
+
+            portMEMORY_BARRIER();
+        } while( ( ( uxSequence & ( UBaseType_t ) 1U ) != 0U ) || ( uxSequence != pxState->uxSequence ) );
     }
+/*-----------------------------------------------------------*/
 
-#endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
+    void vTaskResetLatencyHistograms( void )
+    {
+        LatencyHistogramState_t * pxState;
+        UBaseType_t uxHistogram, uxPriority;
+
+        /* The critical section excludes the writers, and the sequence number
+         * stops a reader copying a partly cleared histogram. */
+        taskENTER_CRITICAL();
+        {
+            for( uxHistogram = 0; uxHistogram < ( UBaseType_t ) 2U; uxHistogram++ )
+            {
+                for( uxPriority = 0; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+                {
+                    pxState = &( xLatencyHistograms[ uxHistogram ][ uxPriority ] );
+
+                    pxState->uxSequence++;
+                    portMEMORY_BARRIER();
+
+                    ( void ) memset( ( void * ) &( pxState->xHistogram ), 0x00, sizeof( LatencyHistogram_t ) );
+
+                    portMEMORY_BARRIER();
+                    pxState->uxSequence++;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_LATENCY_HISTOGRAMS */
 /*-----------------------------------------------------------*/
 
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
@@ -5345,13 +8801,13 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             {
                 /* Wake time has overflowed.  Place this item in the overflow
                  * list. */
-                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                taskADD_TO_DELAYED_LIST( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
             }
             else
             {
                 /* The wake time has not overflowed, so the current block list
                  * is used. */
-                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                taskADD_TO_DELAYED_LIST( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 
                 /* If the task entering the blocked state was placed at the
                  * head of the list of blocked tasks then xNextTaskUnblockTime
@@ -5380,12 +8836,12 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         if( xTimeToWake < xConstTickCount )
         {
             /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            taskADD_TO_DELAYED_LIST( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
         }
         else
         {
             /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            taskADD_TO_DELAYED_LIST( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 
             /* If the task entering the blocked state was placed at the head of the
              * list of blocked tasks then xNextTaskUnblockTime needs to be updated
@@ -71,6 +71,44 @@
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
 
+    #if ( configUSE_TIMER_SERVICE_WHEEL == 1 )
+
+/* Each level of the timer wheel has a slot for each of
+ * 2 ^ configTIMER_WHEEL_SLOT_BITS consecutive time spans.  A slot on level 0
+ * spans one tick, and a slot on level n spans a complete revolution of level
+ * n - 1.  There are enough levels to hold any period a TickType_t can
+ * represent. */
+        #define tmrTIMER_WHEEL_SLOTS                    ( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+        #define tmrTIMER_WHEEL_SLOT_MASK                ( ( TickType_t ) tmrTIMER_WHEEL_SLOTS - ( TickType_t ) 1 )
+        #define tmrTIMER_WHEEL_LEVELS                   ( ( UBaseType_t ) ( ( ( sizeof( TickType_t ) * 8U ) + configTIMER_WHEEL_SLOT_BITS - 1U ) / configTIMER_WHEEL_SLOT_BITS ) )
+        #define tmrTIMER_WHEEL_SLOT_TICKS( uxLevel )    ( ( TickType_t ) 1 << ( configTIMER_WHEEL_SLOT_BITS * ( uxLevel ) ) )
+        #define tmrTIMER_WHEEL_SLOT_INDEX( xTime, uxLevel )    ( ( UBaseType_t ) ( ( ( xTime ) >> ( configTIMER_WHEEL_SLOT_BITS * ( uxLevel ) ) ) & tmrTIMER_WHEEL_SLOT_MASK ) )
+
+    #endif /* configUSE_TIMER_SERVICE_WHEEL */
+
+    #if ( configUSE_TIMER_COALESCING == 1 )
+
+/* A timer is due to expire at xTimerDueTime, but is placed in the active
+ * timers by the later time at which it will expire - xTimerDueTime rounded up
+ * to the next multiple of one more than its slack, which is always one less
+ * than a power of two.  If rounding up overflows the tick count the timer
+ * expires when it is due. */
+        #define tmrSET_EXPIRY_TIME( pxTimer, xDueTime )                                                                        \
+    {                                                                                                                          \
+        TickType_t xCoalescedTime = ( ( xDueTime ) + ( pxTimer )->xTimerSlackInTicks ) & ~( ( pxTimer )->xTimerSlackInTicks ); \
+                                                                                                                               \
+        if( xCoalescedTime < ( xDueTime ) )                                                                                    \
+        {                                                                                                                      \
+            xCoalescedTime = ( xDueTime );                                                                                     \
+        }                                                                                                                      \
+                                                                                                                               \
+        ( pxTimer )->xTimerDueTime = ( xDueTime );                                                                             \
+        listSET_LIST_ITEM_VALUE( &( ( pxTimer )->xTimerListItem ), xCoalescedTime );                                           \
+    }
+    #else
+        #define tmrSET_EXPIRY_TIME( pxTimer, xDueTime )    listSET_LIST_ITEM_VALUE( &( ( pxTimer )->xTimerListItem ), ( xDueTime ) )
+    #endif /* configUSE_TIMER_COALESCING */
+
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                  /* The old naming convention is used to prevent breaking kernel aware debuggers. */
     {
@@ -79,6 +117,10 @@
         TickType_t xTimerPeriodInTicks;             /*<< How quickly and often the timer expires. */
         void * pvTimerID;                           /*<< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
         TimerCallbackFunction_t pxCallbackFunction; /*<< The function that will be called when the timer expires. */
+        #if ( configUSE_TIMER_COALESCING == 1 )
+            TickType_t xTimerSlackInTicks;          /*<< How many ticks late the timer may expire so it expires together with other timers.  Always one less than a power of two. */
+            TickType_t xTimerDueTime;               /*<< The time at which the timer is due to expire, from which its next period is measured. */
+        #endif
         #if ( configUSE_TRACE_FACILITY == 1 )
             UBaseType_t uxTimerNumber;              /*<< An ID assigned by trace tools such as FreeRTOS+Trace */
         #endif
@@ -128,16 +170,34 @@
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
 
+    #if ( configUSE_TIMER_SERVICE_WHEEL == 0 )
+
 /* The list in which active timers are stored.  Timers are referenced in expire
  * time order, with the nearest expiry time at the front of the list.  Only the
  * timer service task is allowed to access these lists.
  * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
  * breaks some kernel aware debuggers, and debuggers that reply on removing the
  * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
-    PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
-    PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+        PRIVILEGED_DATA static List_t xActiveTimerList1;
+        PRIVILEGED_DATA static List_t xActiveTimerList2;
+        PRIVILEGED_DATA static List_t * pxCurrentTimerList;
+        PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+
+    #else /* configUSE_TIMER_SERVICE_WHEEL */
+
+/* Active timers are stored in the timer wheel slot for their expiry time on
+ * the lowest level that can hold it, and are moved down a level each time the
+ * level below completes a revolution.  xTimerWheelTime is the last tick for
+ * which the wheel has been processed - the timers in the level 0 slot for a
+ * tick are expired once the timer service task has processed the wheel up to
+ * that tick, which it points pxCurrentTimerList at while doing so.  Only the
+ * timer service task is allowed to access the wheel. */
+        PRIVILEGED_DATA static List_t xActiveTimerWheel[ tmrTIMER_WHEEL_LEVELS ][ tmrTIMER_WHEEL_SLOTS ];
+        PRIVILEGED_DATA static uint32_t ulActiveTimerWheelOccupied[ tmrTIMER_WHEEL_LEVELS ]; /*< A bit for each slot that may hold a timer.  Bits are only cleared when the slot is found to be empty. */
+        PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+        PRIVILEGED_DATA static List_t * pxCurrentTimerList;
+
+    #endif /* configUSE_TIMER_SERVICE_WHEEL */
 
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -161,14 +221,22 @@
     static portTASK_FUNCTION_PROTO( prvTimerTask, pvParameters ) PRIVILEGED_FUNCTION;
 
 /*
- * Called by the timer service task to interpret and process a command it
- * received on the timer queue.
+ * Called by the timer service task to receive and process the commands on the
+ * timer queue, configTIMER_COMMAND_BATCH_SIZE commands at a time.
  */
     static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Called by prvProcessReceivedCommands() to interpret and process a command
+ * received on the timer queue.
+ */
+    static void prvProcessReceivedCommand( const DaemonTaskMessage_t * const pxMessage ) PRIVILEGED_FUNCTION;
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * depending on if the expire time causes a timer counter overflow - or into
+ * the timer wheel if configUSE_TIMER_SERVICE_WHEEL is 1.  Returns pdTRUE,
+ * without inserting the timer, if the expiry time has already been reached.
  */
     static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
                                                   const TickType_t xNextExpiryTime,
@@ -191,11 +259,38 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
+    #if ( configUSE_TIMER_SERVICE_WHEEL == 0 )
+
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
  * current timer list does not still reference some timers.
  */
-    static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+        static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+
+    #else
+
+/*
+ * Place an active timer in the timer wheel slot for the expiry time held in
+ * its list item.  xNextTick is the first tick for which the wheel has not yet
+ * been processed.
+ */
+        static void prvTimerWheelInsert( Timer_t * const pxTimer,
+                                         const TickType_t xNextTick ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the number of ticks after xTimerWheelTime at which a timer may next
+ * expire, or a slot on a higher level of the wheel must next be moved down, or
+ * portMAX_DELAY if the wheel is empty.
+ */
+        static TickType_t prvTimerWheelTicksToNextEvent( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Process the timer wheel from xTimerWheelTime up to xTimeNow, expiring every
+ * timer that is due by xTimeNow in expiry time order.
+ */
+        static void prvTimerWheelProcess( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_SERVICE_WHEEL */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -374,6 +469,12 @@
         pxNewTimer->pxCallbackFunction = pxCallbackFunction;
         vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
 
+        #if ( configUSE_TIMER_COALESCING == 1 )
+        {
+            pxNewTimer->xTimerSlackInTicks = ( TickType_t ) 0U;
+        }
+        #endif
+
         if( xAutoReload != pdFALSE )
         {
             pxNewTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
@@ -519,6 +620,54 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_COALESCING == 1 )
+
+        void vTimerSetSlack( TimerHandle_t xTimer,
+                             const TickType_t xSlackInTicks )
+        {
+            Timer_t * pxTimer = xTimer;
+            TickType_t xSlack = ( TickType_t ) 0U;
+
+            configASSERT( xTimer );
+
+            /* Round the slack down to one less than a power of two, so the
+             * timer service task only has to round expiry times up to a
+             * multiple of one more than the slack. */
+            while( ( xSlack != portMAX_DELAY ) && ( ( ( xSlack << 1 ) | ( TickType_t ) 1 ) <= xSlackInTicks ) )
+            {
+                xSlack = ( xSlack << 1 ) | ( TickType_t ) 1;
+            }
+
+            taskENTER_CRITICAL();
+            {
+                pxTimer->xTimerSlackInTicks = xSlack;
+            }
+            taskEXIT_CRITICAL();
+        }
+
+    #endif /* configUSE_TIMER_COALESCING */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_COALESCING == 1 )
+
+        TickType_t xTimerGetSlack( TimerHandle_t xTimer )
+        {
+            Timer_t * pxTimer = xTimer;
+            TickType_t xReturn;
+
+            configASSERT( xTimer );
+            taskENTER_CRITICAL();
+            {
+                xReturn = pxTimer->xTimerSlackInTicks;
+            }
+            taskEXIT_CRITICAL();
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_TIMER_COALESCING */
+/*-----------------------------------------------------------*/
+
     static void prvReloadTimer( Timer_t * const pxTimer,
                                 TickType_t xExpiredTime,
                                 const TickType_t xTimeNow )
@@ -552,7 +701,18 @@
          * expiry time and re-insert the timer in the list of active timers. */
         if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
         {
-            prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+            #if ( configUSE_TIMER_COALESCING == 1 )
+            {
+                /* The next period is measured from the time at which the timer
+                 * was due, not the later time at which it expired, so the
+                 * timer does not drift. */
+                prvReloadTimer( pxTimer, pxTimer->xTimerDueTime, xTimeNow );
+            }
+            #else
+            {
+                prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+            }
+            #endif
         }
         else
         {
@@ -601,42 +761,131 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
-                                            BaseType_t xListWasEmpty )
-    {
-        TickType_t xTimeNow;
-        BaseType_t xTimerListsWereSwitched;
+    #if ( configUSE_TIMER_SERVICE_WHEEL == 0 )
 
-        vTaskSuspendAll();
+        static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+                                                BaseType_t xListWasEmpty )
         {
-            /* Obtain the time now to make an assessment as to whether the timer
-             * has expired or not.  If obtaining the time causes the lists to switch
-             * then don't process this timer as any timers that remained in the list
-             * when the lists were switched will have been processed within the
-             * prvSampleTimeNow() function. */
-            xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+            TickType_t xTimeNow;
+            BaseType_t xTimerListsWereSwitched;
 
-            if( xTimerListsWereSwitched == pdFALSE )
+            vTaskSuspendAll();
             {
-                /* The tick count has not overflowed, has the timer expired? */
-                if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+                /* Obtain the time now to make an assessment as to whether the timer
+                 * has expired or not.  If obtaining the time causes the lists to switch
+                 * then don't process this timer as any timers that remained in the list
+                 * when the lists were switched will have been processed within the
+                 * prvSampleTimeNow() function. */
+                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+
+                if( xTimerListsWereSwitched == pdFALSE )
+                {
+                    /* The tick count has not overflowed, has the timer expired? */
+                    if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+                    {
+                        ( void ) xTaskResumeAll();
+                        prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+                    }
+                    else
+                    {
+                        /* The tick count has not overflowed, and the next expire
+                         * time has not been reached yet.  This task should therefore
+                         * block to wait for the next expire time or a command to be
+                         * received - whichever comes first.  The following line cannot
+                         * be reached unless xNextExpireTime > xTimeNow, except in the
+                         * case when the current timer list is empty. */
+                        if( xListWasEmpty != pdFALSE )
+                        {
+                            /* The current timer list is empty - is the overflow list
+                             * also empty? */
+                            xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        }
+
+                        vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+
+                        if( xTaskResumeAll() == pdFALSE )
+                        {
+                            /* Yield to wait for either a command to arrive, or the
+                             * block time to expire.  If a command arrived between the
+                             * critical section being exited and this yield then the yield
+                             * will not cause the task to block. */
+                            portYIELD_WITHIN_API();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                else
                 {
                     ( void ) xTaskResumeAll();
-                    prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
+        {
+            TickType_t xNextExpireTime;
+
+            /* Timers are listed in expiry time order, with the head of the list
+             * referencing the task that will expire first.  Obtain the time at which
+             * the timer with the nearest expiry time will expire.  If there are no
+             * active timers then just set the next expire time to 0.  That will cause
+             * this task to unblock when the tick count overflows, at which point the
+             * timer lists will be switched and the next expiry time can be
+             * re-assessed.  */
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
+
+            return xNextExpireTime;
+        }
+
+    #else /* configUSE_TIMER_SERVICE_WHEEL */
+
+        static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+                                                BaseType_t xListWasEmpty )
+        {
+            TickType_t xTimeNow;
+
+            vTaskSuspendAll();
+            {
+                /* The timer wheel is indexed by expiry time modulo the size of
+                 * each level, so does not have to be switched when the tick
+                 * count overflows.  Times are instead compared by how far they
+                 * are beyond the last tick for which the wheel was processed. */
+                xTimeNow = xTaskGetTickCount();
+
+                if( ( xListWasEmpty == pdFALSE ) && ( ( TickType_t ) ( xNextExpireTime - xTimerWheelTime ) <= ( TickType_t ) ( xTimeNow - xTimerWheelTime ) ) )
+                {
+                    /* Expire every timer that is due, in one pass, rather than
+                     * one timer each time this function is called. */
+                    ( void ) xTaskResumeAll();
+                    prvTimerWheelProcess( xTimeNow );
                 }
                 else
                 {
-                    /* The tick count has not overflowed, and the next expire
-                     * time has not been reached yet.  This task should therefore
-                     * block to wait for the next expire time or a command to be
-                     * received - whichever comes first.  The following line cannot
-                     * be reached unless xNextExpireTime > xTimeNow, except in the
-                     * case when the current timer list is empty. */
                     if( xListWasEmpty != pdFALSE )
                     {
-                        /* The current timer list is empty - is the overflow list
-                         * also empty? */
-                        xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        /* There is nothing in the wheel to process, so it can
+                         * be moved straight to the current time.  Timers that
+                         * are started while this task is blocked are then
+                         * placed in the wheel relative to a recent time. */
+                        xTimerWheelTime = xTimeNow;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
                     }
 
                     vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
@@ -644,9 +893,9 @@
                     if( xTaskResumeAll() == pdFALSE )
                     {
                         /* Yield to wait for either a command to arrive, or the
-                         * block time to expire.  If a command arrived between the
-                         * critical section being exited and this yield then the yield
-                         * will not cause the task to block. */
+                         * block time to expire.  If a command arrived between
+                         * the critical section being exited and this yield then
+                         * the yield will not cause the task to block. */
                         portYIELD_WITHIN_API();
                     }
                     else
@@ -655,279 +904,507 @@
                     }
                 }
             }
-            else
-            {
-                ( void ) xTaskResumeAll();
-            }
         }
-    }
 /*-----------------------------------------------------------*/
 
-    static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
-    {
-        TickType_t xNextExpireTime;
-
-        /* Timers are listed in expiry time order, with the head of the list
-         * referencing the task that will expire first.  Obtain the time at which
-         * the timer with the nearest expiry time will expire.  If there are no
-         * active timers then just set the next expire time to 0.  That will cause
-         * this task to unblock when the tick count overflows, at which point the
-         * timer lists will be switched and the next expiry time can be
-         * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-
-        if( *pxListWasEmpty == pdFALSE )
+        static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
-        }
-        else
-        {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            TickType_t xTicksToNextEvent;
+            TickType_t xNextExpireTime;
+
+            /* The returned time is either the time at which a timer may next
+             * expire, or a slot on a higher level of the wheel must be moved
+             * down, whichever is sooner, so the timer service task can be
+             * unblocked at a time at which no timer expires.  If there are no
+             * active timers then *pxListWasEmpty is set to pdTRUE so the timer
+             * service task blocks until it receives a command. */
+            xTicksToNextEvent = prvTimerWheelTicksToNextEvent();
+
+            if( xTicksToNextEvent != portMAX_DELAY )
+            {
+                *pxListWasEmpty = pdFALSE;
+                xNextExpireTime = xTimerWheelTime + xTicksToNextEvent;
+            }
+            else
+            {
+                *pxListWasEmpty = pdTRUE;
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
+
+            return xNextExpireTime;
         }
 
-        return xNextExpireTime;
-    }
+    #endif /* configUSE_TIMER_SERVICE_WHEEL */
 /*-----------------------------------------------------------*/
 
     static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
     {
         TickType_t xTimeNow;
-        PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
         xTimeNow = xTaskGetTickCount();
 
-        if( xTimeNow < xLastTime )
+        #if ( configUSE_TIMER_SERVICE_WHEEL == 0 )
         {
-            prvSwitchTimerLists();
-            *pxTimerListsWereSwitched = pdTRUE;
+            PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
+
+            if( xTimeNow < xLastTime )
+            {
+                prvSwitchTimerLists();
+                *pxTimerListsWereSwitched = pdTRUE;
+            }
+            else
+            {
+                *pxTimerListsWereSwitched = pdFALSE;
+            }
+
+            xLastTime = xTimeNow;
         }
-        else
+        #else
         {
+            /* The timer wheel does not have to be switched when the tick count
+             * overflows. */
             *pxTimerListsWereSwitched = pdFALSE;
         }
-
-        xLastTime = xTimeNow;
+        #endif /* configUSE_TIMER_SERVICE_WHEEL */
 
         return xTimeNow;
     }
 /*-----------------------------------------------------------*/
 
-    static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
-                                                  const TickType_t xNextExpiryTime,
-                                                  const TickType_t xTimeNow,
-                                                  const TickType_t xCommandTime )
-    {
-        BaseType_t xProcessTimerNow = pdFALSE;
-
-        listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
-        listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+    #if ( configUSE_TIMER_SERVICE_WHEEL == 0 )
 
-        if( xNextExpiryTime <= xTimeNow )
+        static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
+                                                      const TickType_t xNextExpiryTime,
+                                                      const TickType_t xTimeNow,
+                                                      const TickType_t xCommandTime )
         {
-            /* Has the expiry time elapsed between the command to start/reset a
-             * timer was issued, and the time the command was processed? */
-            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            BaseType_t xProcessTimerNow = pdFALSE;
+
+            tmrSET_EXPIRY_TIME( pxTimer, xNextExpiryTime );
+            listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+            if( xNextExpiryTime <= xTimeNow )
             {
-                /* The time between a command being issued and the command being
-                 * processed actually exceeds the timers period.  */
-                xProcessTimerNow = pdTRUE;
+                /* Has the expiry time elapsed between the command to start/reset a
+                 * timer was issued, and the time the command was processed? */
+                if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                {
+                    /* The time between a command being issued and the command being
+                     * processed actually exceeds the timers period.  */
+                    xProcessTimerNow = pdTRUE;
+                }
+                else
+                {
+                    vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                }
             }
             else
             {
-                vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+                {
+                    /* If, since the command was issued, the tick count has overflowed
+                     * but the expiry time has not, then the timer must have already passed
+                     * its expiry time and should be processed immediately. */
+                    xProcessTimerNow = pdTRUE;
+                }
+                else
+                {
+                    vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                }
             }
+
+            return xProcessTimerNow;
         }
-        else
+
+    #else /* configUSE_TIMER_SERVICE_WHEEL */
+
+        static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
+                                                      const TickType_t xNextExpiryTime,
+                                                      const TickType_t xTimeNow,
+                                                      const TickType_t xCommandTime )
         {
-            if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+            BaseType_t xProcessTimerNow = pdFALSE;
+
+            tmrSET_EXPIRY_TIME( pxTimer, xNextExpiryTime );
+            listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+            /* Times are compared by how long after xCommandTime they are, so
+             * the comparison holds when the tick count has overflowed since the
+             * command was issued. */
+            if( ( TickType_t ) ( xTimeNow - xCommandTime ) >= ( TickType_t ) ( xNextExpiryTime - xCommandTime ) ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
             {
-                /* If, since the command was issued, the tick count has overflowed
-                 * but the expiry time has not, then the timer must have already passed
-                 * its expiry time and should be processed immediately. */
+                /* The expiry time elapsed between the command to start/reset
+                 * the timer being issued and the command being processed. */
                 xProcessTimerNow = pdTRUE;
             }
             else
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                prvTimerWheelInsert( pxTimer, xTimerWheelTime + ( TickType_t ) 1 );
             }
+
+            return xProcessTimerNow;
         }
 
-        return xProcessTimerNow;
-    }
+    #endif /* configUSE_TIMER_SERVICE_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvProcessReceivedCommands( void )
     {
-        DaemonTaskMessage_t xMessage;
+        #if ( configTIMER_COMMAND_BATCH_SIZE > 1 )
+        {
+            DaemonTaskMessage_t xMessages[ configTIMER_COMMAND_BATCH_SIZE ];
+            BaseType_t xMessageCount, xMessageIndex;
+
+            /* Receive as many of the waiting commands as fit in xMessages from
+             * the queue at once, rather than entering a critical section to
+             * receive each one. */
+            while( ( xMessageCount = xQueueReceiveMultiple( xTimerQueue, xMessages, ( UBaseType_t ) configTIMER_COMMAND_BATCH_SIZE, tmrNO_DELAY ) ) > ( BaseType_t ) 0 )
+            {
+                for( xMessageIndex = 0; xMessageIndex < xMessageCount; xMessageIndex++ )
+                {
+                    prvProcessReceivedCommand( &( xMessages[ xMessageIndex ] ) );
+                }
+            }
+        }
+        #else /* if ( configTIMER_COMMAND_BATCH_SIZE > 1 ) */
+        {
+            DaemonTaskMessage_t xMessage;
+
+            while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+            {
+                prvProcessReceivedCommand( &xMessage );
+            }
+        }
+        #endif /* configTIMER_COMMAND_BATCH_SIZE */
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvProcessReceivedCommand( const DaemonTaskMessage_t * const pxMessage )
+    {
         Timer_t * pxTimer;
         BaseType_t xTimerListsWereSwitched;
         TickType_t xTimeNow;
 
-        while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+        #if ( INCLUDE_xTimerPendFunctionCall == 1 )
         {
-            #if ( INCLUDE_xTimerPendFunctionCall == 1 )
+            /* Negative commands are pended function calls rather than timer
+             * commands. */
+            if( pxMessage->xMessageID < ( BaseType_t ) 0 )
             {
-                /* Negative commands are pended function calls rather than timer
-                 * commands. */
-                if( xMessage.xMessageID < ( BaseType_t ) 0 )
-                {
-                    const CallbackParameters_t * const pxCallback = &( xMessage.u.xCallbackParameters );
+                const CallbackParameters_t * const pxCallback = &( pxMessage->u.xCallbackParameters );
 
-                    /* The timer uses the xCallbackParameters member to request a
-                     * callback be executed.  Check the callback is not NULL. */
-                    configASSERT( pxCallback );
+                /* The timer uses the xCallbackParameters member to request a
+                 * callback be executed.  Check the callback is not NULL. */
+                configASSERT( pxCallback );
 
-                    /* Call the function. */
-                    pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                /* Call the function. */
+                pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
             }
-            #endif /* INCLUDE_xTimerPendFunctionCall */
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* INCLUDE_xTimerPendFunctionCall */
+
+        /* Commands that are positive are timer commands rather than pended
+         * function calls. */
+        if( pxMessage->xMessageID >= ( BaseType_t ) 0 )
+        {
+            /* The messages uses the xTimerParameters member to work on a
+             * software timer. */
+            pxTimer = pxMessage->u.xTimerParameters.pxTimer;
+
+            if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+            {
+                /* The timer is in a list, remove it. */
+                ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, pxMessage->u.xTimerParameters.xMessageValue );
+
+            /* In this case the xTimerListsWereSwitched parameter is not used, but
+             *  it must be present in the function call.  prvSampleTimeNow() must be
+             *  called after the message is received from xTimerQueue so there is no
+             *  possibility of a higher priority task adding a message to the message
+             *  queue with a time that is ahead of the timer daemon task (because it
+             *  pre-empted the timer daemon task after the xTimeNow value was set). */
+            xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+
+            switch( pxMessage->xMessageID )
+            {
+                case tmrCOMMAND_START:
+                case tmrCOMMAND_START_FROM_ISR:
+                case tmrCOMMAND_RESET:
+                case tmrCOMMAND_RESET_FROM_ISR:
+                    /* Start or restart a timer. */
+                    pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+
+                    if( prvInsertTimerInActiveList( pxTimer, pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, pxMessage->u.xTimerParameters.xMessageValue ) != pdFALSE )
+                    {
+                        /* The timer expired before it was added to the active
+                         * timer list.  Process it now. */
+                        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+                        {
+                            prvReloadTimer( pxTimer, pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
+                        }
+                        else
+                        {
+                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        }
+
+                        /* Call the timer callback. */
+                        traceTIMER_EXPIRED( pxTimer );
+                        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    break;
+
+                case tmrCOMMAND_STOP:
+                case tmrCOMMAND_STOP_FROM_ISR:
+                    /* The timer has already been removed from the active list. */
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    break;
+
+                case tmrCOMMAND_CHANGE_PERIOD:
+                case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                    pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                    pxTimer->xTimerPeriodInTicks = pxMessage->u.xTimerParameters.xMessageValue;
+                    configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+                    /* The new period does not really have a reference, and can
+                     * be longer or shorter than the old one.  The command time is
+                     * therefore set to the current time, and as the period cannot
+                     * be zero the next expiry time can only be in the future,
+                     * meaning (unlike for the xTimerStart() case above) there is
+                     * no fail case that needs to be handled here. */
+                    ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+                    break;
+
+                case tmrCOMMAND_DELETE:
+                    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                    {
+                        /* The timer has already been removed from the active list,
+                         * just free up the memory if the memory was dynamically
+                         * allocated. */
+                        if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                        {
+                            vPortFree( pxTimer );
+                        }
+                        else
+                        {
+                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        }
+                    }
+                    #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+                    {
+                        /* If dynamic allocation is not enabled, the memory
+                         * could not have been dynamically allocated. So there is
+                         * no need to free the memory - just mark the timer as
+                         * "not active". */
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+                    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                    break;
+
+                default:
+                    /* Don't expect to get here. */
+                    break;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_SERVICE_WHEEL == 0 )
+
+        static void prvSwitchTimerLists( void )
+        {
+            TickType_t xNextExpireTime;
+            List_t * pxTemp;
+
+            /* The tick count has overflowed.  The timer lists must be switched.
+             * If there are any timers still referenced from the current timer list
+             * then they must have expired and should be processed before the lists
+             * are switched. */
+            while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+
+                /* Process the expired timer.  For auto-reload timers, be careful to
+                 * process only expirations that occur on the current list.  Further
+                 * expirations must wait until after the lists are switched. */
+                prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
+
+            pxTemp = pxCurrentTimerList;
+            pxCurrentTimerList = pxOverflowTimerList;
+            pxOverflowTimerList = pxTemp;
+        }
+
+    #else /* configUSE_TIMER_SERVICE_WHEEL */
+
+        static void prvTimerWheelInsert( Timer_t * const pxTimer,
+                                         const TickType_t xNextTick )
+        {
+            const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+            TickType_t xTicksToExpiry;
+            UBaseType_t uxLevel = 0U;
+            UBaseType_t uxSlot;
 
-            /* Commands that are positive are timer commands rather than pended
-             * function calls. */
-            if( xMessage.xMessageID >= ( BaseType_t ) 0 )
+            /* Use the lowest level on which the expiry time is less than one
+             * revolution away. */
+            xTicksToExpiry = xExpiryTime - xNextTick;
+
+            while( ( uxLevel < ( tmrTIMER_WHEEL_LEVELS - 1U ) ) && ( xTicksToExpiry >= tmrTIMER_WHEEL_SLOT_TICKS( uxLevel + 1U ) ) )
             {
-                /* The messages uses the xTimerParameters member to work on a
-                 * software timer. */
-                pxTimer = xMessage.u.xTimerParameters.pxTimer;
+                uxLevel++;
+            }
+
+            uxSlot = tmrTIMER_WHEEL_SLOT_INDEX( xExpiryTime, uxLevel );
+            vListInsertEnd( &( xActiveTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+            ulActiveTimerWheelOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+        }
+/*-----------------------------------------------------------*/
 
-                if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+        static TickType_t prvTimerWheelTicksToNextEvent( void )
+        {
+            TickType_t xTicksToNextEvent = portMAX_DELAY;
+            TickType_t xFirstTick, xTicks;
+            UBaseType_t uxLevel, uxFirstSlot, uxSlot, uxOffset;
+            uint32_t ulSlotBit;
+
+            /* The timers in a slot on level 0 expire on the tick of the slot.
+             * The timers in a slot on a higher level cannot expire before they
+             * are moved down from that slot, so the earliest time at which the
+             * first occupied slot on any level is reached is the next time at
+             * which the wheel has to be processed. */
+            for( uxLevel = 0U; uxLevel < tmrTIMER_WHEEL_LEVELS; uxLevel++ )
+            {
+                if( uxLevel == 0U )
                 {
-                    /* The timer is in a list, remove it. */
-                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    xFirstTick = xTimerWheelTime + ( TickType_t ) 1;
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The first tick after xTimerWheelTime on which the level
+                     * below completes a revolution. */
+                    xFirstTick = ( xTimerWheelTime + tmrTIMER_WHEEL_SLOT_TICKS( uxLevel ) ) & ~( tmrTIMER_WHEEL_SLOT_TICKS( uxLevel ) - ( TickType_t ) 1 );
                 }
 
-                traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+                if( ( TickType_t ) ( xFirstTick - xTimerWheelTime ) >= xTicksToNextEvent )
+                {
+                    /* The remaining levels cannot be reached any sooner. */
+                    break;
+                }
 
-                /* In this case the xTimerListsWereSwitched parameter is not used, but
-                 *  it must be present in the function call.  prvSampleTimeNow() must be
-                 *  called after the message is received from xTimerQueue so there is no
-                 *  possibility of a higher priority task adding a message to the message
-                 *  queue with a time that is ahead of the timer daemon task (because it
-                 *  pre-empted the timer daemon task after the xTimeNow value was set). */
-                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+                uxFirstSlot = tmrTIMER_WHEEL_SLOT_INDEX( xFirstTick, uxLevel );
 
-                switch( xMessage.xMessageID )
+                for( uxOffset = 0U; ( uxOffset < tmrTIMER_WHEEL_SLOTS ) && ( ulActiveTimerWheelOccupied[ uxLevel ] != 0UL ); uxOffset++ )
                 {
-                    case tmrCOMMAND_START:
-                    case tmrCOMMAND_START_FROM_ISR:
-                    case tmrCOMMAND_RESET:
-                    case tmrCOMMAND_RESET_FROM_ISR:
-                        /* Start or restart a timer. */
-                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-
-                        if( prvInsertTimerInActiveList( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
-                        {
-                            /* The timer expired before it was added to the active
-                             * timer list.  Process it now. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-                            {
-                                prvReloadTimer( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
-                            }
-                            else
-                            {
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            }
+                    uxSlot = ( uxFirstSlot + uxOffset ) & ( UBaseType_t ) tmrTIMER_WHEEL_SLOT_MASK;
+                    ulSlotBit = 1UL << uxSlot;
 
-                            /* Call the timer callback. */
-                            traceTIMER_EXPIRED( pxTimer );
-                            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                    if( ( ulActiveTimerWheelOccupied[ uxLevel ] & ulSlotBit ) != 0UL )
+                    {
+                        if( listLIST_IS_EMPTY( &( xActiveTimerWheel[ uxLevel ][ uxSlot ] ) ) != pdFALSE )
+                        {
+                            /* The timers that were in the slot have since been
+                             * stopped or reset. */
+                            ulActiveTimerWheelOccupied[ uxLevel ] &= ~ulSlotBit;
                         }
                         else
                         {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                            xTicks = ( xFirstTick - xTimerWheelTime ) + ( ( TickType_t ) uxOffset * tmrTIMER_WHEEL_SLOT_TICKS( uxLevel ) );
 
-                        break;
-
-                    case tmrCOMMAND_STOP:
-                    case tmrCOMMAND_STOP_FROM_ISR:
-                        /* The timer has already been removed from the active list. */
-                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                        break;
-
-                    case tmrCOMMAND_CHANGE_PERIOD:
-                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
-                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-                        pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-                        /* The new period does not really have a reference, and can
-                         * be longer or shorter than the old one.  The command time is
-                         * therefore set to the current time, and as the period cannot
-                         * be zero the next expiry time can only be in the future,
-                         * meaning (unlike for the xTimerStart() case above) there is
-                         * no fail case that needs to be handled here. */
-                        ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-                        break;
-
-                    case tmrCOMMAND_DELETE:
-                        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-                        {
-                            /* The timer has already been removed from the active list,
-                             * just free up the memory if the memory was dynamically
-                             * allocated. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                            if( xTicks < xTicksToNextEvent )
                             {
-                                vPortFree( pxTimer );
+                                xTicksToNextEvent = xTicks;
                             }
                             else
                             {
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                                mtCOVERAGE_TEST_MARKER();
                             }
-                        }
-                        #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
-                        {
-                            /* If dynamic allocation is not enabled, the memory
-                             * could not have been dynamically allocated. So there is
-                             * no need to free the memory - just mark the timer as
-                             * "not active". */
-                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                        }
-                        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-                        break;
 
-                    default:
-                        /* Don't expect to get here. */
-                        break;
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
             }
+
+            return xTicksToNextEvent;
         }
-    }
 /*-----------------------------------------------------------*/
 
-    static void prvSwitchTimerLists( void )
-    {
-        TickType_t xNextExpireTime;
-        List_t * pxTemp;
-
-        /* The tick count has overflowed.  The timer lists must be switched.
-         * If there are any timers still referenced from the current timer list
-         * then they must have expired and should be processed before the lists
-         * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        static void prvTimerWheelProcess( const TickType_t xTimeNow )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            TickType_t xTicksToNextEvent;
+            UBaseType_t uxLevel, uxSlot;
+            List_t * pxSlot;
+            Timer_t * pxTimer;
+
+            for( ; ; )
+            {
+                xTicksToNextEvent = prvTimerWheelTicksToNextEvent();
+
+                if( ( xTicksToNextEvent == portMAX_DELAY ) || ( xTicksToNextEvent > ( TickType_t ) ( xTimeNow - xTimerWheelTime ) ) )
+                {
+                    /* Nothing else is due by xTimeNow. */
+                    break;
+                }
+
+                /* Ticks on which nothing happens are skipped. */
+                xTimerWheelTime += xTicksToNextEvent;
+
+                /* Each time level n - 1 completes a revolution the timers in
+                 * the next slot of level n are within one revolution of a lower
+                 * level, so are moved down. */
+                for( uxLevel = 1U; uxLevel < tmrTIMER_WHEEL_LEVELS; uxLevel++ )
+                {
+                    if( ( xTimerWheelTime & ( tmrTIMER_WHEEL_SLOT_TICKS( uxLevel ) - ( TickType_t ) 1 ) ) != ( TickType_t ) 0 )
+                    {
+                        break;
+                    }
+
+                    uxSlot = tmrTIMER_WHEEL_SLOT_INDEX( xTimerWheelTime, uxLevel );
+                    pxSlot = &( xActiveTimerWheel[ uxLevel ][ uxSlot ] );
+
+                    while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                    {
+                        pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                        prvTimerWheelInsert( pxTimer, xTimerWheelTime );
+                    }
 
-            /* Process the expired timer.  For auto-reload timers, be careful to
-             * process only expirations that occur on the current list.  Further
-             * expirations must wait until after the lists are switched. */
-            prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+                    ulActiveTimerWheelOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+                }
+
+                /* Every timer in the level 0 slot for xTimerWheelTime expires
+                 * now, other than any auto-reload timer that is placed back in
+                 * the same slot one revolution later by its own expiry. */
+                pxCurrentTimerList = &( xActiveTimerWheel[ 0 ][ tmrTIMER_WHEEL_SLOT_INDEX( xTimerWheelTime, 0U ) ] );
+
+                while( ( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE ) && ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList ) == xTimerWheelTime ) )
+                {
+                    prvProcessExpiredTimer( xTimerWheelTime, xTimeNow );
+                }
+            }
+
+            xTimerWheelTime = xTimeNow;
         }
 
-        pxTemp = pxCurrentTimerList;
-        pxCurrentTimerList = pxOverflowTimerList;
-        pxOverflowTimerList = pxTemp;
-    }
+    #endif /* configUSE_TIMER_SERVICE_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvCheckForValidListAndQueue( void )
@@ -939,10 +1416,30 @@
         {
             if( xTimerQueue == NULL )
             {
-                vListInitialise( &xActiveTimerList1 );
-                vListInitialise( &xActiveTimerList2 );
-                pxCurrentTimerList = &xActiveTimerList1;
-                pxOverflowTimerList = &xActiveTimerList2;
+                #if ( configUSE_TIMER_SERVICE_WHEEL == 0 )
+                {
+                    vListInitialise( &xActiveTimerList1 );
+                    vListInitialise( &xActiveTimerList2 );
+                    pxCurrentTimerList = &xActiveTimerList1;
+                    pxOverflowTimerList = &xActiveTimerList2;
+                }
+                #else
+                {
+                    UBaseType_t uxLevel, uxSlot;
+
+                    for( uxLevel = 0U; uxLevel < tmrTIMER_WHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = 0U; uxSlot < tmrTIMER_WHEEL_SLOTS; uxSlot++ )
+                        {
+                            vListInitialise( &( xActiveTimerWheel[ uxLevel ][ uxSlot ] ) );
+                        }
+
+                        ulActiveTimerWheelOccupied[ uxLevel ] = 0UL;
+                    }
+
+                    pxCurrentTimerList = &( xActiveTimerWheel[ 0 ][ 0 ] );
+                }
+                #endif /* configUSE_TIMER_SERVICE_WHEEL */
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
@@ -0,0 +1,498 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "workqueue.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include work queue functionality.  This #if is closed at the very bottom
+ * of this file.  If you want to include work queues then ensure
+ * configUSE_WORK_QUEUES is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_WORK_QUEUES == 1 )
+
+/* Values of the ulState member of a work item. */
+    #define workqueueITEM_IDLE       ( ( uint32_t ) 0UL )
+    #define workqueueITEM_PENDING    ( ( uint32_t ) 1UL )
+
+/* A port that has compare-and-swap instructions can define
+ * portATOMIC_COMPARE_AND_SWAP_U32() and portATOMIC_COMPARE_AND_SWAP_POINTER()
+ * in portmacro.h.  Otherwise the versions in atomic.h are used, which mask
+ * interrupts for the duration of the swap, so submitting is then not lock
+ * free.  Either must return ATOMIC_COMPARE_AND_SWAP_SUCCESS if the swap was
+ * made, and must act as a full memory barrier.  Masking interrupts does not
+ * stop another core accessing the list, so a multi-core port must provide
+ * both. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        #if !defined( portATOMIC_COMPARE_AND_SWAP_U32 ) || !defined( portATOMIC_COMPARE_AND_SWAP_POINTER )
+            #error portATOMIC_COMPARE_AND_SWAP_U32() and portATOMIC_COMPARE_AND_SWAP_POINTER() must be defined in portmacro.h to use work queues on a multi-core port.
+        #endif
+    #endif
+
+    #ifndef portATOMIC_COMPARE_AND_SWAP_U32
+        #define portATOMIC_COMPARE_AND_SWAP_U32( pulDestination, ulExchange, ulComparand )    Atomic_CompareAndSwap_u32( ( pulDestination ), ( ulExchange ), ( ulComparand ) )
+    #endif
+
+    #ifndef portATOMIC_COMPARE_AND_SWAP_POINTER
+        #define portATOMIC_COMPARE_AND_SWAP_POINTER( ppvDestination, pvExchange, pvComparand )    Atomic_CompareAndSwapPointers_p32( ( ppvDestination ), ( pvExchange ), ( pvComparand ) )
+    #endif
+
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            #define workqueueGET_RUN_TIME_COUNTER_VALUE( ulTime )    portALT_GET_RUN_TIME_COUNTER_VALUE( ( ulTime ) )
+        #else
+            #define workqueueGET_RUN_TIME_COUNTER_VALUE( ulTime )    ( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+        #endif
+    #endif
+
+/*
+ * Definition of the work item structure.  The xSTATIC_WORK_ITEM structure in
+ * FreeRTOS.h must be kept in step with it.
+ */
+    typedef struct WorkItemDefinition /* The old naming convention is used to prevent breaking kernel aware debuggers. */
+    {
+        struct WorkItemDefinition * volatile pxNext; /*< The next item in the list of the work queue the item was submitted to. */
+        volatile uint32_t ulState;                   /*< workqueueITEM_PENDING from submission until the item starts to run. */
+        WorkFunction_t pxFunction;                   /*< The function run by the worker. */
+        void * pvParameter;                          /*< The value passed to pxFunction. */
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            configRUN_TIME_COUNTER_TYPE ulSubmitTime; /*< The run time counter value when the item was submitted. */
+        #endif
+    } WorkItem_t;
+
+/*
+ * Definition of the work queue structure.
+ */
+    typedef struct WorkQueueDefinition
+    {
+        WorkItem_t * volatile pxSubmitted; /*< The items submitted since the worker last emptied the list, most recent first. */
+        TaskHandle_t xWorker;              /*< The task that runs the items. */
+        volatile uint32_t ulCoalesced;     /*< Updated by the submitting tasks and interrupts. */
+        uint32_t ulExecuted;               /*< This and the latencies are only updated by the worker, from within a critical section. */
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            configRUN_TIME_COUNTER_TYPE ulTotalLatency;
+            configRUN_TIME_COUNTER_TYPE ulMaximumLatency;
+        #endif
+    } WorkQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that runs the items submitted to the work queue passed in
+ * pvParameters.
+ */
+    static portTASK_FUNCTION_PROTO( prvWorkerTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Marks pxWorkItem as pending and links it into the list of pxWorkQueue.
+ * Returns pdFALSE if the item was already pending.  Sets *pxNotifyWorker to
+ * pdTRUE if the list was empty, so the worker must be notified.
+ */
+    static BaseType_t prvSubmit( WorkQueue_t * const pxWorkQueue,
+                                 WorkItem_t * const pxWorkItem,
+                                 BaseType_t * const pxNotifyWorker ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes every item from the list of pxWorkQueue, returning them in the
+ * order in which they were submitted.
+ */
+    static WorkItem_t * prvTakeSubmitted( WorkQueue_t * const pxWorkQueue ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    WorkQueueHandle_t xWorkQueueCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        UBaseType_t uxPriority,
+                                        configSTACK_DEPTH_TYPE usStackDepth )
+    {
+        WorkQueue_t * pxNewWorkQueue;
+
+        pxNewWorkQueue = ( WorkQueue_t * ) pvPortMalloc( sizeof( WorkQueue_t ) ); /*lint !e9087 !e9079 pvPortMalloc() always returns memory aligned for any kernel structure. */
+
+        if( pxNewWorkQueue != NULL )
+        {
+            pxNewWorkQueue->pxSubmitted = NULL;
+            pxNewWorkQueue->ulCoalesced = 0U;
+            pxNewWorkQueue->ulExecuted = 0U;
+
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                pxNewWorkQueue->ulTotalLatency = 0U;
+                pxNewWorkQueue->ulMaximumLatency = 0U;
+            }
+            #endif
+
+            if( xTaskCreate( prvWorkerTask, pcName, usStackDepth, ( void * ) pxNewWorkQueue, uxPriority, &( pxNewWorkQueue->xWorker ) ) == pdPASS )
+            {
+                traceWORK_QUEUE_CREATE( pxNewWorkQueue );
+            }
+            else
+            {
+                vPortFree( pxNewWorkQueue );
+                pxNewWorkQueue = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxNewWorkQueue == NULL )
+        {
+            traceWORK_QUEUE_CREATE_FAILED(); /*lint !e9063 Else branch only exists to allow tracing and does not generate code if trace macros are not defined. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxNewWorkQueue;
+    }
+/*-----------------------------------------------------------*/
+
+    WorkItemHandle_t xWorkItemCreateStatic( WorkFunction_t pxFunction,
+                                            void * pvParameter,
+                                            StaticWorkItem_t * pxWorkItemBuffer )
+    {
+        WorkItem_t * pxNewWorkItem = NULL;
+
+        configASSERT( pxFunction );
+        configASSERT( pxWorkItemBuffer );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticWorkItem_t equals the size of the real work
+             * item structure. */
+            volatile size_t xSize = sizeof( StaticWorkItem_t );
+
+            /* This assertion cannot be branch covered in unit tests */
+            configASSERT( xSize == sizeof( WorkItem_t ) ); /* LCOV_EXCL_BR_LINE */
+            ( void ) xSize;                                /* Keeps lint quiet when configASSERT() is not defined. */
+        }
+        #endif /* configASSERT_DEFINED */
+
+        if( pxWorkItemBuffer != NULL )
+        {
+            /* The StaticWorkItem_t structure is guaranteed to have the same size
+             * and alignment requirements as the real work item structure. */
+            pxNewWorkItem = ( WorkItem_t * ) pxWorkItemBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+            pxNewWorkItem->pxNext = NULL;
+            pxNewWorkItem->ulState = workqueueITEM_IDLE;
+            pxNewWorkItem->pxFunction = pxFunction;
+            pxNewWorkItem->pvParameter = pvParameter;
+
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                pxNewWorkItem->ulSubmitTime = 0U;
+            }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxNewWorkItem;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                                 WorkItemHandle_t xWorkItem )
+    {
+        WorkQueue_t * const pxWorkQueue = xWorkQueue;
+        BaseType_t xReturn, xNotifyWorker = pdFALSE;
+
+        configASSERT( pxWorkQueue );
+        configASSERT( xWorkItem );
+
+        traceWORK_QUEUE_SUBMIT( pxWorkQueue, xWorkItem );
+        xReturn = prvSubmit( pxWorkQueue, xWorkItem, &xNotifyWorker );
+
+        if( xNotifyWorker != pdFALSE )
+        {
+            /* Yields if the worker has a priority above that of this task. */
+            ( void ) xTaskNotifyGive( pxWorkQueue->xWorker );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+                                        WorkItemHandle_t xWorkItem,
+                                        BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        WorkQueue_t * const pxWorkQueue = xWorkQueue;
+        BaseType_t xReturn, xNotifyWorker = pdFALSE;
+
+        configASSERT( pxWorkQueue );
+        configASSERT( xWorkItem );
+
+        /* RTOS ports that support interrupt nesting have the concept of a maximum
+         * system call (or maximum API call) interrupt priority.  Interrupts that are
+         * above the maximum system call priority are kept permanently enabled, even
+         * when the RTOS kernel is in a critical section, but cannot make any calls to
+         * FreeRTOS API functions. */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        traceWORK_QUEUE_SUBMIT_FROM_ISR( pxWorkQueue, xWorkItem );
+        xReturn = prvSubmit( pxWorkQueue, xWorkItem, &xNotifyWorker );
+
+        if( xNotifyWorker != pdFALSE )
+        {
+            vTaskNotifyGiveFromISR( pxWorkQueue->xWorker, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWorkItemIsPending( WorkItemHandle_t xWorkItem )
+    {
+        const WorkItem_t * const pxWorkItem = xWorkItem;
+
+        configASSERT( pxWorkItem );
+
+        return ( pxWorkItem->ulState == workqueueITEM_PENDING ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    TaskHandle_t xWorkQueueGetWorkerTask( WorkQueueHandle_t xWorkQueue )
+    {
+        const WorkQueue_t * const pxWorkQueue = xWorkQueue;
+
+        configASSERT( pxWorkQueue );
+
+        return pxWorkQueue->xWorker;
+    }
+/*-----------------------------------------------------------*/
+
+    void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+                             WorkQueueStats_t * pxStats )
+    {
+        const WorkQueue_t * const pxWorkQueue = xWorkQueue;
+
+        configASSERT( pxWorkQueue );
+        configASSERT( pxStats );
+
+        /* The worker, which may be running on another core, cannot update the
+         * statistics part way through them being read. */
+        taskENTER_CRITICAL();
+        {
+            pxStats->ulExecuted = pxWorkQueue->ulExecuted;
+            pxStats->ulCoalesced = pxWorkQueue->ulCoalesced;
+
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                pxStats->ulTotalLatency = pxWorkQueue->ulTotalLatency;
+                pxStats->ulMaximumLatency = pxWorkQueue->ulMaximumLatency;
+            }
+            #else
+            {
+                pxStats->ulTotalLatency = 0U;
+                pxStats->ulMaximumLatency = 0U;
+            }
+            #endif
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSubmit( WorkQueue_t * const pxWorkQueue,
+                                 WorkItem_t * const pxWorkItem,
+                                 BaseType_t * const pxNotifyWorker )
+    {
+        WorkItem_t * pxHead;
+        uint32_t ulCoalesced;
+        BaseType_t xReturn;
+
+        /* Only the submitter that moves the item from idle to pending links it
+         * into a list, so an item is never in a list twice. */
+        if( portATOMIC_COMPARE_AND_SWAP_U32( &( pxWorkItem->ulState ), workqueueITEM_PENDING, workqueueITEM_IDLE ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+        {
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                workqueueGET_RUN_TIME_COUNTER_VALUE( pxWorkItem->ulSubmitTime );
+            }
+            #endif
+
+            /* Push the item onto the head of the list.  Items are only ever
+             * removed by taking the whole list, so a head that is freed and
+             * submitted again between the read and the swap cannot corrupt
+             * the list. */
+            do
+            {
+                pxHead = pxWorkQueue->pxSubmitted;
+                pxWorkItem->pxNext = pxHead;
+            } while( portATOMIC_COMPARE_AND_SWAP_POINTER( ( void * volatile * ) &( pxWorkQueue->pxSubmitted ), pxWorkItem, pxHead ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+
+            /* If the list was not empty then the worker has already been
+             * notified of the item at its tail, and has not yet taken it. */
+            *pxNotifyWorker = ( pxHead == NULL ) ? pdTRUE : pdFALSE;
+            xReturn = pdPASS;
+        }
+        else
+        {
+            traceWORK_QUEUE_COALESCE( pxWorkQueue, pxWorkItem );
+
+            do
+            {
+                ulCoalesced = pxWorkQueue->ulCoalesced;
+            } while( portATOMIC_COMPARE_AND_SWAP_U32( &( pxWorkQueue->ulCoalesced ), ulCoalesced + 1U, ulCoalesced ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static WorkItem_t * prvTakeSubmitted( WorkQueue_t * const pxWorkQueue )
+    {
+        WorkItem_t * pxItem;
+        WorkItem_t * pxNext;
+        WorkItem_t * pxInOrder = NULL;
+
+        do
+        {
+            pxItem = pxWorkQueue->pxSubmitted;
+        } while( portATOMIC_COMPARE_AND_SWAP_POINTER( ( void * volatile * ) &( pxWorkQueue->pxSubmitted ), NULL, pxItem ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+
+        /* The list holds the most recently submitted item first, so reverse
+         * it. */
+        while( pxItem != NULL )
+        {
+            pxNext = pxItem->pxNext;
+            pxItem->pxNext = pxInOrder;
+            pxInOrder = pxItem;
+            pxItem = pxNext;
+        }
+
+        return pxInOrder;
+    }
+/*-----------------------------------------------------------*/
+
+    static portTASK_FUNCTION( prvWorkerTask, pvParameters )
+    {
+        WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) pvParameters;
+        WorkItem_t * pxItem;
+        WorkItem_t * pxNext;
+        WorkFunction_t pxFunction;
+        void * pvParameter;
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            configRUN_TIME_COUNTER_TYPE ulNow, ulLatency;
+        #endif
+
+        for( ; ; )
+        {
+            /* Wait until an item is submitted to an empty list. */
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            pxItem = prvTakeSubmitted( pxWorkQueue );
+
+            while( pxItem != NULL )
+            {
+                /* Read everything needed from the item before marking it idle,
+                 * as from then on it can be submitted again. */
+                pxNext = pxItem->pxNext;
+                pxFunction = pxItem->pxFunction;
+                pvParameter = pxItem->pvParameter;
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    workqueueGET_RUN_TIME_COUNTER_VALUE( ulNow );
+                    ulLatency = ulNow - pxItem->ulSubmitTime;
+                }
+                #endif /* configGENERATE_RUN_TIME_STATS */
+
+                portMEMORY_BARRIER();
+                pxItem->ulState = workqueueITEM_IDLE;
+                portMEMORY_BARRIER();
+
+                traceWORK_QUEUE_EXECUTE( pxWorkQueue, pxItem );
+                pxFunction( pvParameter );
+
+                /* Update the statistics together so vWorkQueueGetStats() does
+                 * not read them part way through. */
+                taskENTER_CRITICAL();
+                {
+                    pxWorkQueue->ulExecuted++;
+
+                    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                    {
+                        pxWorkQueue->ulTotalLatency += ulLatency;
+
+                        if( ulLatency > pxWorkQueue->ulMaximumLatency )
+                        {
+                            pxWorkQueue->ulMaximumLatency = ulLatency;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configGENERATE_RUN_TIME_STATS */
+                }
+                taskEXIT_CRITICAL();
+
+                pxItem = pxNext;
+            }
+        }
+    }
+
+/* This entire source file will be skipped if the application is not configured
+ * to include work queue functionality.  If you want to include work queues
+ * then ensure configUSE_WORK_QUEUES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_WORK_QUEUES == 1 */
@@ -47,4 +47,14 @@ void vPortCurrentTaskDying( void * pxTaskToDelete,
 void portSetupTCB_CB( void * tcb );
 void vFakePortAssertIfISR();
 
+/* Only used by the tests of multi-core builds. */
+BaseType_t xFakePortGetCoreID( void );
+void vFakePortYieldCore( BaseType_t xCoreID );
+void vFakePortGetTaskLock( void );
+void vFakePortReleaseTaskLock( void );
+void vFakePortGetISRLock( void );
+void vFakePortReleaseISRLock( void );
+UBaseType_t uxFakePortGetCriticalNesting( void );
+void vFakePortSetCriticalNesting( UBaseType_t uxCriticalNesting );
+
 #endif /* FAKE_PORT_H */
@@ -147,30 +147,44 @@ typedef unsigned long    UBaseType_t;
 #define  portASSERT_IF_IN_ISR()          vFakePortAssertIfISR();
 
 
-static uint8_t ucPortCountLeadingZeros( uint32_t ulBitmap )
-{
-    uint8_t ucReturn;
-
-    ucReturn = __builtin_clz( ulBitmap );
-    return ucReturn;
-}
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+    static uint8_t ucPortCountLeadingZeros( uint32_t ulBitmap )
+    {
+        uint8_t ucReturn;
 
+        ucReturn = __builtin_clz( ulBitmap );
+        return ucReturn;
+    }
 
-#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) \
+    #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) \
     ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
-#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) \
+    #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) \
     ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
-#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) \
+    #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) \
     uxTopPriority = ( 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( uxReadyPriorities ) ) )
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 /* Task function macros as described on the FreeRTOS.org WEB site. */
-#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) \
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* A multi-core build defines a second task function in tasks.c, the passive
+ * idle task, so the variables are named after the function. */
+    #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) \
+    volatile int fool_static_ ## vFunction = 0;            \
+    void vFunction( void * ( pvParameters ) )
+
+    #define portTASK_FUNCTION( vFunction, pvParameters ) \
+    volatile int fool_static2_ ## vFunction = 0;     \
+    void vFunction( void * ( pvParameters ) )
+#else
+    #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) \
     volatile int fool_static = 0;                          \
     void vFunction( void * ( pvParameters ) )
 
-#define portTASK_FUNCTION( vFunction, pvParameters ) \
+    #define portTASK_FUNCTION( vFunction, pvParameters ) \
     volatile int fool_static2 = 0;                   \
     void vFunction( void * ( pvParameters ) )
+#endif /* configNUMBER_OF_CORES */
 
 /*-----------------------------------------------------------*/
 
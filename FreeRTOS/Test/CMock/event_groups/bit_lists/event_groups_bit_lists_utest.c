@@ -0,0 +1,385 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file event_groups_bit_lists_utest.c */
+
+/* The event group is built with configUSE_EVENT_GROUP_BIT_LISTS set to 1.  The
+ * list functions are the real ones.  A task blocks by calling
+ * xEventGroupWaitBits() or xEventGroupSync(), and the stubbed
+ * vTaskPlaceOnUnorderedEventList() leaves the task's event list item in the
+ * wait list after the call returns, so the tests can check which list the task
+ * is held in and which tasks a later call to xEventGroupSetBits() unblocks. */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Event group includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "event_groups.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "unity_memory.h"
+
+/* Mock includes. */
+#include "mock_task.h"
+#include "mock_timers.h"
+#include "mock_fake_assert.h"
+#include "mock_fake_port.h"
+
+
+/* ===========================  DEFINES CONSTANTS  ========================== */
+#define BIT_0                         ( 1 << 0 )
+#define BIT_2                         ( 1 << 2 )
+#define BIT_4                         ( 1 << 4 )
+
+#define NUM_WAITERS                   4
+#define WAIT_TICKS                    ( ( TickType_t ) 10 )
+
+/* Matches eventUNBLOCKED_DUE_TO_BIT_SET in event_groups.c. */
+#define UNBLOCKED_DUE_TO_BIT_SET      0x02000000UL
+#define EVENT_BITS_CONTROL_BYTES      0xff000000UL
+
+/* ===========================  GLOBAL VARIABLES  =========================== */
+
+/**
+ * @brief A simulated task, blocked on the event group while its event list item
+ * is in one of the wait lists.
+ */
+typedef struct Waiter
+{
+    ListItem_t xEventListItem;
+    bool xUnblocked;
+    EventBits_t uxUnblockedValue;
+} Waiter_t;
+
+static StaticEventGroup_t xEventGroupBuffer;
+static EventGroupHandle_t xEventGroupHandle;
+static Waiter_t xWaiters[ NUM_WAITERS ];
+static Waiter_t * pxRunningWaiter;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+void * pvPortMalloc( size_t xSize )
+{
+    return unity_malloc( xSize );
+}
+void vPortFree( void * pv )
+{
+    return unity_free( pv );
+}
+
+static void vFakeAssertStub( bool x,
+                             char * file,
+                             int line,
+                             int cmock_num_calls )
+{
+    ( void ) file;
+    ( void ) line;
+    ( void ) cmock_num_calls;
+
+    TEST_ASSERT_TRUE_MESSAGE( x, "configASSERT() failed" );
+}
+
+static void vTaskPlaceOnUnorderedEventListStub( List_t * pxEventList,
+                                                const TickType_t xItemValue,
+                                                const TickType_t xTicksToWait,
+                                                int cmock_num_calls )
+{
+    ListItem_t * pxItem = &( pxRunningWaiter->xEventListItem );
+
+    ( void ) xTicksToWait;
+    ( void ) cmock_num_calls;
+
+    listSET_LIST_ITEM_VALUE( pxItem, xItemValue );
+    vListInsertEnd( pxEventList, pxItem );
+}
+
+static void vTaskRemoveFromUnorderedEventListStub( ListItem_t * pxEventListItem,
+                                                   const TickType_t xItemValue,
+                                                   int cmock_num_calls )
+{
+    Waiter_t * pxWaiter = ( Waiter_t * ) listGET_LIST_ITEM_OWNER( pxEventListItem );
+
+    ( void ) cmock_num_calls;
+
+    ( void ) uxListRemove( pxEventListItem );
+    pxWaiter->xUnblocked = true;
+    pxWaiter->uxUnblockedValue = xItemValue;
+}
+
+/* The waiting task runs again before it is unblocked, as if its block time
+ * expired, so it returns the value it blocked with. */
+static TickType_t uxTaskResetEventItemValueStub( int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return listGET_LIST_ITEM_VALUE( &( pxRunningWaiter->xEventListItem ) );
+}
+
+/* ============================  Unity Fixtures  ============================ */
+/*! called before each testcase */
+void setUp( void )
+{
+    UBaseType_t uxWaiter;
+
+    memset( xWaiters, 0x00, sizeof( xWaiters ) );
+
+    for( uxWaiter = 0; uxWaiter < NUM_WAITERS; uxWaiter++ )
+    {
+        vListInitialiseItem( &( xWaiters[ uxWaiter ].xEventListItem ) );
+        listSET_LIST_ITEM_OWNER( &( xWaiters[ uxWaiter ].xEventListItem ), &( xWaiters[ uxWaiter ] ) );
+    }
+
+    pxRunningWaiter = NULL;
+
+    vFakeAssert_StubWithCallback( vFakeAssertStub );
+    vFakePortEnterCriticalSection_Ignore();
+    vFakePortExitCriticalSection_Ignore();
+    vFakePortYieldWithinAPI_Ignore();
+    xTaskGetSchedulerState_IgnoreAndReturn( taskSCHEDULER_RUNNING );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+    vTaskPlaceOnUnorderedEventList_Stub( vTaskPlaceOnUnorderedEventListStub );
+    vTaskRemoveFromUnorderedEventList_Stub( vTaskRemoveFromUnorderedEventListStub );
+    uxTaskResetEventItemValue_Stub( uxTaskResetEventItemValueStub );
+
+    memset( &xEventGroupBuffer, 0x00, sizeof( xEventGroupBuffer ) );
+    xEventGroupHandle = xEventGroupCreateStatic( &xEventGroupBuffer );
+
+    /* Track calls to malloc / free */
+    UnityMalloc_StartTest();
+}
+
+/*! called after each testcase */
+void tearDown( void )
+{
+    vEventGroupDelete( xEventGroupHandle );
+    UnityMalloc_EndTest();
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ===========================  Static Functions  =========================== */
+
+static void prvWaitBits( UBaseType_t uxWaiter,
+                         const EventBits_t uxBitsToWaitFor,
+                         const BaseType_t xClearOnExit,
+                         const BaseType_t xWaitForAllBits )
+{
+    pxRunningWaiter = &( xWaiters[ uxWaiter ] );
+    ( void ) xEventGroupWaitBits( xEventGroupHandle, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits, WAIT_TICKS );
+    pxRunningWaiter = NULL;
+}
+
+static List_t * prvBitList( UBaseType_t uxBit )
+{
+    return ( List_t * ) &( xEventGroupBuffer.xDummy2b[ uxBit ] );
+}
+
+static List_t * prvAnyBitList( void )
+{
+    return ( List_t * ) &( xEventGroupBuffer.xDummy2 );
+}
+
+static List_t * prvWaitList( UBaseType_t uxWaiter )
+{
+    return listLIST_ITEM_CONTAINER( &( xWaiters[ uxWaiter ].xEventListItem ) );
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/*!
+ * @brief A task waiting for a single bit is listed under that bit, and is only
+ * unblocked when that bit is set.
+ * @coverage xEventGroupWaitBits xEventGroupSetBits prvGetWaitList
+ */
+void test_xEventGroupWaitBits_SingleBit( void )
+{
+    prvWaitBits( 0, BIT_2, pdFALSE, pdFALSE );
+    TEST_ASSERT_EQUAL_PTR( prvBitList( 2 ), prvWaitList( 0 ) );
+
+    ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_0 | BIT_4 );
+    TEST_ASSERT_FALSE( xWaiters[ 0 ].xUnblocked );
+    TEST_ASSERT_EQUAL_PTR( prvBitList( 2 ), prvWaitList( 0 ) );
+
+    ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_2 );
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblocked );
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_2 | BIT_4 | UNBLOCKED_DUE_TO_BIT_SET, xWaiters[ 0 ].uxUnblockedValue );
+    TEST_ASSERT_EQUAL_PTR( NULL, prvWaitList( 0 ) );
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_2 | BIT_4, xEventGroupGetBits( xEventGroupHandle ) );
+}
+
+/*!
+ * @brief A task waiting for any one of several bits is held in the list that is
+ * tested whenever any bit is set.
+ * @coverage xEventGroupWaitBits xEventGroupSetBits prvGetWaitList
+ */
+void test_xEventGroupWaitBits_AnyOfSeveralBits( void )
+{
+    prvWaitBits( 0, BIT_0 | BIT_4, pdFALSE, pdFALSE );
+    TEST_ASSERT_EQUAL_PTR( prvAnyBitList(), prvWaitList( 0 ) );
+
+    ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_2 );
+    TEST_ASSERT_FALSE( xWaiters[ 0 ].xUnblocked );
+
+    ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_4 );
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblocked );
+    TEST_ASSERT_EQUAL( BIT_2 | BIT_4 | UNBLOCKED_DUE_TO_BIT_SET, xWaiters[ 0 ].uxUnblockedValue );
+}
+
+/*!
+ * @brief A task waiting for all of several bits is listed under the lowest bit
+ * that is not set, and moves to the next unset bit each time the bit it is
+ * listed under is set, until all the bits are set.
+ * @coverage xEventGroupWaitBits xEventGroupSetBits prvGetWaitList prvUnblockWaitingTasks
+ */
+void test_xEventGroupWaitBits_WaitForAll_MovesBetweenBitLists( void )
+{
+    prvWaitBits( 0, BIT_0 | BIT_2 | BIT_4, pdFALSE, pdTRUE );
+    TEST_ASSERT_EQUAL_PTR( prvBitList( 0 ), prvWaitList( 0 ) );
+
+    /* Setting a bit the task is not listed under does not test the task. */
+    ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_4 );
+    TEST_ASSERT_FALSE( xWaiters[ 0 ].xUnblocked );
+    TEST_ASSERT_EQUAL_PTR( prvBitList( 0 ), prvWaitList( 0 ) );
+
+    ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_0 );
+    TEST_ASSERT_FALSE( xWaiters[ 0 ].xUnblocked );
+    TEST_ASSERT_EQUAL_PTR( prvBitList( 2 ), prvWaitList( 0 ) );
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( prvBitList( 0 ) ) );
+
+    ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_2 );
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblocked );
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_2 | BIT_4 | UNBLOCKED_DUE_TO_BIT_SET, xWaiters[ 0 ].uxUnblockedValue );
+}
+
+/*!
+ * @brief A task waiting for all of several bits, some of which are already set
+ * when it blocks, is listed under a bit that is not set.  Clearing a bit the
+ * task is not listed under does not move it.
+ * @coverage xEventGroupWaitBits xEventGroupClearBits prvGetWaitList
+ */
+void test_xEventGroupWaitBits_WaitForAll_SomeBitsAlreadySet( void )
+{
+    ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_0 );
+
+    prvWaitBits( 0, BIT_0 | BIT_4, pdFALSE, pdTRUE );
+    TEST_ASSERT_EQUAL_PTR( prvBitList( 4 ), prvWaitList( 0 ) );
+
+    ( void ) xEventGroupClearBits( xEventGroupHandle, BIT_0 );
+    ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_4 );
+    TEST_ASSERT_FALSE( xWaiters[ 0 ].xUnblocked );
+    TEST_ASSERT_EQUAL_PTR( prvBitList( 0 ), prvWaitList( 0 ) );
+
+    ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_0 );
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblocked );
+}
+
+/*!
+ * @brief Bits waited for with xClearOnExit set are cleared after every task
+ * waiting on them, in a bit list or in the any bit list, has been tested.
+ * @coverage xEventGroupWaitBits xEventGroupSetBits prvUnblockWaitingTasks
+ */
+void test_xEventGroupWaitBits_ClearOnExit( void )
+{
+    prvWaitBits( 0, BIT_0, pdTRUE, pdFALSE );
+    prvWaitBits( 1, BIT_0, pdFALSE, pdFALSE );
+    prvWaitBits( 2, BIT_0 | BIT_2, pdFALSE, pdFALSE );
+    prvWaitBits( 3, BIT_2 | BIT_4, pdTRUE, pdTRUE );
+    TEST_ASSERT_EQUAL_PTR( prvBitList( 0 ), prvWaitList( 0 ) );
+    TEST_ASSERT_EQUAL_PTR( prvBitList( 0 ), prvWaitList( 1 ) );
+    TEST_ASSERT_EQUAL_PTR( prvAnyBitList(), prvWaitList( 2 ) );
+    TEST_ASSERT_EQUAL_PTR( prvBitList( 2 ), prvWaitList( 3 ) );
+
+    ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_0 | BIT_4 );
+
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblocked );
+    TEST_ASSERT_TRUE( xWaiters[ 1 ].xUnblocked );
+    TEST_ASSERT_TRUE( xWaiters[ 2 ].xUnblocked );
+    TEST_ASSERT_FALSE( xWaiters[ 3 ].xUnblocked );
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_4, xWaiters[ 1 ].uxUnblockedValue & ~EVENT_BITS_CONTROL_BYTES );
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_4, xWaiters[ 2 ].uxUnblockedValue & ~EVENT_BITS_CONTROL_BYTES );
+    TEST_ASSERT_EQUAL( BIT_4, xEventGroupGetBits( xEventGroupHandle ) );
+
+    ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_2 );
+
+    TEST_ASSERT_TRUE( xWaiters[ 3 ].xUnblocked );
+    TEST_ASSERT_EQUAL( 0, xEventGroupGetBits( xEventGroupHandle ) );
+}
+
+/*!
+ * @brief A task that reaches a rendezvous first is listed under a bit that the
+ * other tasks have not yet set, and the rendezvous bits are cleared when the
+ * last task arrives.
+ * @coverage xEventGroupSync prvGetWaitList
+ */
+void test_xEventGroupSync_ListedUnderUnsetBit( void )
+{
+    EventBits_t uxReturn;
+
+    pxRunningWaiter = &( xWaiters[ 0 ] );
+    ( void ) xEventGroupSync( xEventGroupHandle, BIT_0, BIT_0 | BIT_2, WAIT_TICKS );
+    pxRunningWaiter = NULL;
+    TEST_ASSERT_EQUAL_PTR( prvBitList( 2 ), prvWaitList( 0 ) );
+
+    uxReturn = xEventGroupSync( xEventGroupHandle, BIT_2, BIT_0 | BIT_2, WAIT_TICKS );
+
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_2, uxReturn );
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblocked );
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_2 | UNBLOCKED_DUE_TO_BIT_SET, xWaiters[ 0 ].uxUnblockedValue );
+    TEST_ASSERT_EQUAL( 0, xEventGroupGetBits( xEventGroupHandle ) );
+}
+
+/*!
+ * @brief Deleting the event group unblocks the tasks in every wait list.
+ * @coverage vEventGroupDelete
+ */
+void test_vEventGroupDelete_UnblocksAllLists( void )
+{
+    prvWaitBits( 0, BIT_2, pdFALSE, pdFALSE );
+    prvWaitBits( 1, BIT_0 | BIT_4, pdFALSE, pdFALSE );
+    prvWaitBits( 2, BIT_0 | BIT_4, pdFALSE, pdTRUE );
+
+    vEventGroupDelete( xEventGroupHandle );
+
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblocked );
+    TEST_ASSERT_TRUE( xWaiters[ 1 ].xUnblocked );
+    TEST_ASSERT_TRUE( xWaiters[ 2 ].xUnblocked );
+
+    /* tearDown() deletes the event group again, which finds no tasks. */
+}
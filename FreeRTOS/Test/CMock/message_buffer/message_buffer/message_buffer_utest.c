@@ -28,6 +28,7 @@
 /* C runtime includes. */
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 
 /* Message Buffer includes */
 #include "FreeRTOS.h"
@@ -798,3 +799,191 @@ void test_xMessageBufferReceiveFromISR_success( void )
 
     vStreamBufferDelete( xMessageBuffer );
 }
+
+/**
+ * @brief Validates that a message written in place is received after it is committed, and can be read in place.
+ */
+void test_xMessageBufferReserve_commit_peek_consume( void )
+{
+    uint8_t message[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    void * pvSpace = NULL, * pvMessage = NULL;
+    size_t space = 0, length = 0;
+
+    vTaskSetTimeOutState_Ignore();
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    /* Create a message buffer of sample size. */
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    /* Nothing to read in an empty message buffer. */
+    TEST_ASSERT_EQUAL( 0, xMessageBufferPeek( xMessageBuffer, &pvMessage ) );
+    TEST_ASSERT_NULL( pvMessage );
+    TEST_ASSERT_EQUAL( 0, xMessageBufferConsume( xMessageBuffer, 0 ) );
+
+    /* Room is left for the length of the message. */
+    space = xMessageBufferReserve( xMessageBuffer, &pvSpace );
+    TEST_ASSERT_EQUAL( TEST_MAX_MESSAGE_SIZE, space );
+    TEST_ASSERT_NOT_NULL( pvSpace );
+
+    memset( pvSpace, 0xC3, 10U );
+    TEST_ASSERT_EQUAL( pdTRUE, xMessageBufferIsEmpty( xMessageBuffer ) );
+    TEST_ASSERT_EQUAL( 10U, xMessageBufferCommit( xMessageBuffer, 10U ) );
+    length = xMessageBufferNextLengthBytes( xMessageBuffer );
+    TEST_ASSERT_EQUAL( 10U, length );
+    TEST_ASSERT_EQUAL( TEST_MESSAGE_BUFFER_SIZE - 10U - TEST_MESSAGE_METADATA_SIZE, xMessageBufferSpacesAvailable( xMessageBuffer ) );
+
+    /* The message is read in place at the location it was written. */
+    length = xMessageBufferPeek( xMessageBuffer, &pvMessage );
+    TEST_ASSERT_EQUAL( 10U, length );
+    TEST_ASSERT_EQUAL_PTR( pvSpace, pvMessage );
+    TEST_ASSERT_EQUAL( 10U, xMessageBufferConsume( xMessageBuffer, length ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xMessageBufferIsEmpty( xMessageBuffer ) );
+
+    /* A message committed in place can also be copied out. */
+    space = xMessageBufferReserve( xMessageBuffer, &pvSpace );
+    memset( pvSpace, 0x3C, 5U );
+    TEST_ASSERT_EQUAL( 5U, xMessageBufferCommit( xMessageBuffer, 5U ) );
+    TEST_ASSERT_EQUAL( 5U, xMessageBufferReceive( xMessageBuffer, message, TEST_MAX_MESSAGE_SIZE, 0 ) );
+    TEST_ASSERT_EACH_EQUAL_HEX8( 0x3C, message, 5U );
+
+    vMessageBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that messages are never handed out across the end of the storage area.
+ */
+void test_xMessageBufferReserve_WrapOver( void )
+{
+    uint8_t message[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    void * pvSpace = NULL, * pvMessage = NULL;
+    size_t space = 0;
+
+    vTaskSetTimeOutState_Ignore();
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    /* Create a message buffer of sample size. */
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    /* Move the head and tail close to the end of the storage area. */
+    TEST_ASSERT_EQUAL( 40U, xMessageBufferSend( xMessageBuffer, message, 40U, 0 ) );
+    TEST_ASSERT_EQUAL( 40U, xMessageBufferReceive( xMessageBuffer, message, TEST_MAX_MESSAGE_SIZE, 0 ) );
+
+    /* Only the space up to the end of the storage area can be reserved. */
+    space = xMessageBufferReserve( xMessageBuffer, &pvSpace );
+    TEST_ASSERT_NOT_NULL( pvSpace );
+    TEST_ASSERT_LESS_THAN( TEST_MAX_MESSAGE_SIZE - 40U, space );
+
+    /* A copied message that does not fit there wraps, so cannot be read in place. */
+    TEST_ASSERT_EQUAL( space + 1U, xMessageBufferSend( xMessageBuffer, message, space + 1U, 0 ) );
+    TEST_ASSERT_EQUAL( space + 1U, xMessageBufferPeek( xMessageBuffer, &pvMessage ) );
+    TEST_ASSERT_NULL( pvMessage );
+
+    /* It can still be discarded without being copied out. */
+    TEST_ASSERT_EQUAL( space + 1U, xMessageBufferConsume( xMessageBuffer, space + 1U ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xMessageBufferIsEmpty( xMessageBuffer ) );
+
+    vMessageBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that a writer that only reserves space stops at the end of the storage area, however much the reader
+ * frees, until a message is sent that wraps around it.
+ */
+void test_xMessageBufferReserve_fill_to_wrap_point( void )
+{
+    uint8_t message[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    void * pvSpace = NULL, * pvMessage = NULL;
+    size_t space = 0, written = 0, received = 0;
+
+    vTaskSetTimeOutState_Ignore();
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    /* Create a message buffer of sample size. */
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    /* Write messages in place until the space left before the end of the storage area is too small for another. */
+    for( ; ; )
+    {
+        space = xMessageBufferReserve( xMessageBuffer, &pvSpace );
+
+        if( space < 10U )
+        {
+            break;
+        }
+
+        memset( pvSpace, ( int ) written, 10U );
+        TEST_ASSERT_EQUAL( 10U, xMessageBufferCommit( xMessageBuffer, 10U ) );
+        written++;
+    }
+
+    TEST_ASSERT_GREATER_THAN( 0U, written );
+
+    /* Drain the buffer. */
+    while( xMessageBufferIsEmpty( xMessageBuffer ) == pdFALSE )
+    {
+        TEST_ASSERT_EQUAL( 10U, xMessageBufferReceive( xMessageBuffer, message, TEST_MAX_MESSAGE_SIZE, 0 ) );
+        TEST_ASSERT_EACH_EQUAL_HEX8( ( uint8_t ) received, message, 10U );
+        received++;
+    }
+
+    TEST_ASSERT_EQUAL( written, received );
+    TEST_ASSERT_EQUAL( TEST_MESSAGE_BUFFER_SIZE, xMessageBufferSpacesAvailable( xMessageBuffer ) );
+
+    /* Although the whole buffer is free, the space that can be reserved still ends at the end of the storage area, so
+     * is too small for the message. */
+    space = xMessageBufferReserve( xMessageBuffer, &pvSpace );
+    TEST_ASSERT_LESS_THAN( 10U, space );
+
+    /* A message sent by copy wraps around the end of the storage area. */
+    memset( message, 0xA5, 10U );
+    TEST_ASSERT_EQUAL( 10U, xMessageBufferSend( xMessageBuffer, message, 10U, 0 ) );
+    memset( message, 0x00, 10U );
+    TEST_ASSERT_EQUAL( 10U, xMessageBufferReceive( xMessageBuffer, message, TEST_MAX_MESSAGE_SIZE, 0 ) );
+    TEST_ASSERT_EACH_EQUAL_HEX8( 0xA5, message, 10U );
+
+    /* So space at the start of the storage area can be reserved again. */
+    space = xMessageBufferReserve( xMessageBuffer, &pvSpace );
+    TEST_ASSERT_GREATER_OR_EQUAL( 10U, space );
+    memset( pvSpace, 0x5A, 10U );
+    TEST_ASSERT_EQUAL( 10U, xMessageBufferCommit( xMessageBuffer, 10U ) );
+    TEST_ASSERT_EQUAL( 10U, xMessageBufferPeek( xMessageBuffer, &pvMessage ) );
+    TEST_ASSERT_EQUAL_PTR( pvSpace, pvMessage );
+    TEST_ASSERT_EACH_EQUAL_HEX8( 0x5A, pvMessage, 10U );
+    TEST_ASSERT_EQUAL( 10U, xMessageBufferConsume( xMessageBuffer, 10U ) );
+
+    vMessageBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that consuming a message with the wrong length fails an assertion.
+ */
+void test_xMessageBufferConsume_wrong_length( void )
+{
+    uint8_t message[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    size_t length = 0;
+
+    vTaskSetTimeOutState_Ignore();
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    /* Create a message buffer of sample size. */
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    TEST_ASSERT_EQUAL( 10U, xMessageBufferSend( xMessageBuffer, message, 10U, 0 ) );
+    EXPECT_ASSERT_BREAK( ( void ) xMessageBufferConsume( xMessageBuffer, 5U ) );
+    TEST_ASSERT_EQUAL( 1, assertionFailed );
+    assertionFailed = 0;
+
+    /* The message is left in the buffer. */
+    length = xMessageBufferNextLengthBytes( xMessageBuffer );
+    TEST_ASSERT_EQUAL( 10U, length );
+
+    vMessageBufferDelete( xMessageBuffer );
+}
@@ -0,0 +1,600 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file pool_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Pool includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "pool.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "unity_memory.h"
+#include "CException.h"
+
+/* Mock includes. */
+#include "mock_task.h"
+#include "mock_fake_assert.h"
+#include "mock_fake_port.h"
+
+/* ===========================  DEFINES CONSTANTS  ========================== */
+#define POOL_OBJECT_SIZE     ( 16U )
+#define POOL_OBJECT_COUNT    ( 4U )
+#define POOL_ASSERT_E        ( 0xAA55 )
+
+/* Expect call to fail a configASSERT(), and stop it at that point. */
+#define EXPECT_ASSERT_BREAK( call )               \
+    do                                            \
+    {                                             \
+        CEXCEPTION_T e = CEXCEPTION_NONE;         \
+        xAbortOnAssert = true;                    \
+        Try                                       \
+        {                                         \
+            call;                                 \
+            TEST_FAIL();                          \
+        }                                         \
+        Catch( e )                                \
+        TEST_ASSERT_EQUAL( POOL_ASSERT_E, e );    \
+        xAbortOnAssert = false;                   \
+    } while( 0 )
+
+/* ===========================  GLOBAL VARIABLES  =========================== */
+
+/**
+ * @brief The pool under test, the memory that holds it, and its objects.
+ */
+static PoolHandle_t xPool = NULL;
+static StaticPool_t xPoolBuffer;
+static uint32_t ulPoolStorage[ POOL_OBJECT_COUNT * POOL_OBJECT_SIZE / sizeof( uint32_t ) ];
+
+/**
+ * @brief A second pool, for the stats formatting tests.
+ */
+static PoolHandle_t xSecondPool = NULL;
+static StaticPool_t xSecondPoolBuffer;
+static uint32_t ulSecondPoolStorage[ 2 ];
+
+/**
+ * @brief The number of failed configASSERT() calls, and whether a failed
+ * configASSERT() throws.
+ */
+static int iAssertFailures = 0;
+static bool xAbortOnAssert = false;
+
+/**
+ * @brief A list item that stands in for a task blocked on the pool, and the
+ * event list it was placed on.
+ */
+static ListItem_t xBlockedTaskItem;
+static List_t * pxWaitingList = NULL;
+
+/**
+ * @brief The object freed by the vTaskPlaceOnEventList() callbacks, and the
+ * value returned by the xTaskRemoveFromEventList() callback.
+ */
+static void * pvObjectToFree = NULL;
+static BaseType_t xRemoveReturn = pdFALSE;
+static BaseType_t xWokenByISR = pdFALSE;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+static void vFakeAssertStub( bool x,
+                             char * file,
+                             int line,
+                             int cmock_num_calls )
+{
+    ( void ) file;
+    ( void ) line;
+    ( void ) cmock_num_calls;
+
+    if( !x )
+    {
+        iAssertFailures++;
+
+        if( xAbortOnAssert )
+        {
+            Throw( POOL_ASSERT_E );
+        }
+    }
+}
+
+/* Another task frees an object while the calling task is blocked. */
+static void vPlaceOnEventListFreeStub( List_t * const pxEventList,
+                                       const TickType_t xTicksToWait,
+                                       int cmock_num_calls )
+{
+    ( void ) xTicksToWait;
+    ( void ) cmock_num_calls;
+
+    pxWaitingList = pxEventList;
+    vListInsert( pxEventList, &xBlockedTaskItem );
+    vPoolFree( xPool, pvObjectToFree );
+}
+
+/* As vPlaceOnEventListFreeStub(), but the object is freed by an interrupt. */
+static void vPlaceOnEventListFreeFromISRStub( List_t * const pxEventList,
+                                              const TickType_t xTicksToWait,
+                                              int cmock_num_calls )
+{
+    ( void ) xTicksToWait;
+    ( void ) cmock_num_calls;
+
+    pxWaitingList = pxEventList;
+    vListInsert( pxEventList, &xBlockedTaskItem );
+    vPoolFreeFromISR( xPool, pvObjectToFree, &xWokenByISR );
+}
+
+/* The calling task blocks, then times out without an object being freed. */
+static void vPlaceOnEventListTimeoutStub( List_t * const pxEventList,
+                                          const TickType_t xTicksToWait,
+                                          int cmock_num_calls )
+{
+    ( void ) xTicksToWait;
+    ( void ) cmock_num_calls;
+
+    pxWaitingList = pxEventList;
+}
+
+static BaseType_t xRemoveFromEventListStub( const List_t * const pxEventList,
+                                            int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    TEST_ASSERT_EQUAL_PTR( pxWaitingList, pxEventList );
+    ( void ) uxListRemove( &xBlockedTaskItem );
+
+    return xRemoveReturn;
+}
+
+/* ============================  Unity Fixtures  ============================ */
+/*! called before each testcase */
+void setUp( void )
+{
+    xPool = NULL;
+    xSecondPool = NULL;
+    iAssertFailures = 0;
+    xAbortOnAssert = false;
+    pxWaitingList = NULL;
+    pvObjectToFree = NULL;
+    xRemoveReturn = pdFALSE;
+    xWokenByISR = pdFALSE;
+    vListInitialiseItem( &xBlockedTaskItem );
+
+    vFakeAssert_StubWithCallback( vFakeAssertStub );
+    vFakePortEnterCriticalSection_Ignore();
+    vFakePortExitCriticalSection_Ignore();
+    ulFakePortSetInterruptMaskFromISR_IgnoreAndReturn( 0U );
+    vFakePortClearInterruptMaskFromISR_Ignore();
+    vFakePortAssertIfInterruptPriorityInvalid_Ignore();
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdFALSE );
+    xTaskGetSchedulerState_IgnoreAndReturn( taskSCHEDULER_RUNNING );
+
+    /* Track calls to malloc / free */
+    UnityMalloc_StartTest();
+}
+
+/*! called after each testcase */
+void tearDown( void )
+{
+    if( xPool != NULL )
+    {
+        vPoolDelete( xPool );
+    }
+
+    if( xSecondPool != NULL )
+    {
+        vPoolDelete( xSecondPool );
+    }
+
+    UnityMalloc_EndTest();
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ===========================  Static Functions  =========================== */
+
+static void prvCreatePool( void )
+{
+    xPool = xPoolCreateStatic( "Pool",
+                               POOL_OBJECT_SIZE,
+                               POOL_OBJECT_COUNT,
+                               ( uint8_t * ) ulPoolStorage,
+                               &xPoolBuffer );
+    TEST_ASSERT_NOT_NULL( xPool );
+}
+
+static uint8_t * prvObject( UBaseType_t uxIndex )
+{
+    return &( ( ( uint8_t * ) ulPoolStorage )[ uxIndex * POOL_OBJECT_SIZE ] );
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/*!
+ * @brief validate statically creating a pool, and the status of a new pool
+ * @coverage xPoolCreateStatic vPoolGetStatus
+ */
+void test_xPoolCreateStatic_Success( void )
+{
+    PoolStatus_t xStatus;
+
+    prvCreatePool();
+    vPoolGetStatus( xPool, &xStatus );
+
+    TEST_ASSERT_EQUAL_STRING( "Pool", xStatus.pcPoolName );
+    TEST_ASSERT_EQUAL( POOL_OBJECT_SIZE, xStatus.uxObjectSize );
+    TEST_ASSERT_EQUAL( POOL_OBJECT_COUNT, xStatus.uxNumberOfObjects );
+    TEST_ASSERT_EQUAL( 0, xStatus.uxObjectsInUse );
+    TEST_ASSERT_EQUAL( 0, xStatus.uxMaximumObjectsInUse );
+    TEST_ASSERT_EQUAL( 0, xStatus.ulAllocations );
+    TEST_ASSERT_EQUAL( 0, xStatus.ulFailedAllocations );
+    TEST_ASSERT_EQUAL( 0, iAssertFailures );
+}
+
+/*!
+ * @brief validate a pool is not created without memory to hold it
+ * @coverage xPoolCreateStatic
+ */
+void test_xPoolCreateStatic_NullBuffers( void )
+{
+    TEST_ASSERT_NULL( xPoolCreateStatic( "Pool", POOL_OBJECT_SIZE, POOL_OBJECT_COUNT, NULL, &xPoolBuffer ) );
+    TEST_ASSERT_NULL( xPoolCreateStatic( "Pool", POOL_OBJECT_SIZE, POOL_OBJECT_COUNT, ( uint8_t * ) ulPoolStorage, NULL ) );
+    TEST_ASSERT_EQUAL( 2, iAssertFailures );
+}
+
+/*!
+ * @brief validate objects smaller than the free list link are rejected
+ * @coverage xPoolCreateStatic
+ */
+void test_xPoolCreateStatic_ObjectTooSmall( void )
+{
+    xPool = xPoolCreateStatic( "Pool", 2, POOL_OBJECT_COUNT, ( uint8_t * ) ulPoolStorage, &xPoolBuffer );
+    TEST_ASSERT_EQUAL( 1, iAssertFailures );
+}
+
+/*!
+ * @brief validate every object can be allocated once, in address order, and
+ * that an empty pool returns NULL without blocking when no block time is given
+ * @coverage pvPoolAlloc
+ */
+void test_pvPoolAlloc_UntilEmpty( void )
+{
+    PoolStatus_t xStatus;
+    UBaseType_t x;
+
+    prvCreatePool();
+
+    for( x = 0; x < POOL_OBJECT_COUNT; x++ )
+    {
+        TEST_ASSERT_EQUAL_PTR( prvObject( x ), pvPoolAlloc( xPool, 0 ) );
+    }
+
+    TEST_ASSERT_NULL( pvPoolAlloc( xPool, 0 ) );
+
+    vPoolGetStatus( xPool, &xStatus );
+    TEST_ASSERT_EQUAL( POOL_OBJECT_COUNT, xStatus.uxObjectsInUse );
+    TEST_ASSERT_EQUAL( POOL_OBJECT_COUNT, xStatus.uxMaximumObjectsInUse );
+    TEST_ASSERT_EQUAL( POOL_OBJECT_COUNT, xStatus.ulAllocations );
+    TEST_ASSERT_EQUAL( 1, xStatus.ulFailedAllocations );
+}
+
+/*!
+ * @brief validate a freed object is the next one allocated, and that the
+ * contents of an allocated object are left alone by the pool
+ * @coverage pvPoolAlloc vPoolFree
+ */
+void test_vPoolFree_ObjectReused( void )
+{
+    PoolStatus_t xStatus;
+    uint8_t * pucFirst, * pucSecond;
+
+    prvCreatePool();
+
+    pucFirst = pvPoolAlloc( xPool, 0 );
+    pucSecond = pvPoolAlloc( xPool, 0 );
+    memset( pucFirst, 0xa5, POOL_OBJECT_SIZE );
+    memset( pucSecond, 0x5a, POOL_OBJECT_SIZE );
+
+    vPoolFree( xPool, pucFirst );
+    TEST_ASSERT_EACH_EQUAL_HEX8( 0x5a, pucSecond, POOL_OBJECT_SIZE );
+    TEST_ASSERT_EQUAL_PTR( pucFirst, pvPoolAlloc( xPool, 0 ) );
+
+    vPoolGetStatus( xPool, &xStatus );
+    TEST_ASSERT_EQUAL( 2, xStatus.uxObjectsInUse );
+    TEST_ASSERT_EQUAL( 2, xStatus.uxMaximumObjectsInUse );
+    TEST_ASSERT_EQUAL( 3, xStatus.ulAllocations );
+}
+
+/*!
+ * @brief validate every object can be freed and allocated again
+ * @coverage pvPoolAlloc vPoolFree
+ */
+void test_vPoolFree_AllObjects( void )
+{
+    void * pvObjects[ POOL_OBJECT_COUNT ];
+    PoolStatus_t xStatus;
+    UBaseType_t x;
+
+    prvCreatePool();
+
+    for( x = 0; x < POOL_OBJECT_COUNT; x++ )
+    {
+        pvObjects[ x ] = pvPoolAlloc( xPool, 0 );
+    }
+
+    for( x = 0; x < POOL_OBJECT_COUNT; x++ )
+    {
+        vPoolFree( xPool, pvObjects[ x ] );
+    }
+
+    /* Freed objects are allocated last in, first out. */
+    for( x = POOL_OBJECT_COUNT; x > 0; x-- )
+    {
+        TEST_ASSERT_EQUAL_PTR( pvObjects[ x - 1 ], pvPoolAlloc( xPool, 0 ) );
+    }
+
+    TEST_ASSERT_NULL( pvPoolAlloc( xPool, 0 ) );
+
+    vPoolGetStatus( xPool, &xStatus );
+    TEST_ASSERT_EQUAL( POOL_OBJECT_COUNT, xStatus.uxObjectsInUse );
+    TEST_ASSERT_EQUAL( 2 * POOL_OBJECT_COUNT, xStatus.ulAllocations );
+}
+
+/*!
+ * @brief validate an object that is not in the pool cannot be freed
+ * @coverage vPoolFree
+ */
+void test_vPoolFree_ForeignObject( void )
+{
+    uint32_t ulForeign[ POOL_OBJECT_SIZE / sizeof( uint32_t ) ];
+
+    prvCreatePool();
+
+    /* Not an object of this pool at all. */
+    EXPECT_ASSERT_BREAK( vPoolFree( xPool, ulForeign ) );
+
+    /* Misaligned within the pool. */
+    EXPECT_ASSERT_BREAK( vPoolFree( xPool, prvObject( 1 ) + 1 ) );
+
+    /* Past the end of the pool. */
+    EXPECT_ASSERT_BREAK( vPoolFree( xPool, prvObject( POOL_OBJECT_COUNT ) ) );
+
+    /* The pool is unchanged. */
+    TEST_ASSERT_EQUAL_PTR( prvObject( 0 ), pvPoolAlloc( xPool, 0 ) );
+}
+
+/*!
+ * @brief validate allocating and freeing from an interrupt
+ * @coverage pvPoolAllocFromISR vPoolFreeFromISR
+ */
+void test_pvPoolAllocFromISR_Success( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    PoolStatus_t xStatus;
+    UBaseType_t x;
+    void * pvObject;
+
+    prvCreatePool();
+
+    for( x = 0; x < POOL_OBJECT_COUNT; x++ )
+    {
+        TEST_ASSERT_EQUAL_PTR( prvObject( x ), pvPoolAllocFromISR( xPool ) );
+    }
+
+    TEST_ASSERT_NULL( pvPoolAllocFromISR( xPool ) );
+
+    pvObject = prvObject( 2 );
+    vPoolFreeFromISR( xPool, pvObject, &xHigherPriorityTaskWoken );
+    TEST_ASSERT_EQUAL( pdFALSE, xHigherPriorityTaskWoken );
+    TEST_ASSERT_EQUAL_PTR( pvObject, pvPoolAllocFromISR( xPool ) );
+
+    vPoolGetStatus( xPool, &xStatus );
+    TEST_ASSERT_EQUAL( POOL_OBJECT_COUNT, xStatus.uxObjectsInUse );
+    TEST_ASSERT_EQUAL( POOL_OBJECT_COUNT + 1, xStatus.ulAllocations );
+    TEST_ASSERT_EQUAL( 1, xStatus.ulFailedAllocations );
+}
+
+/*!
+ * @brief validate a task blocked on an empty pool is unblocked by a task
+ * freeing an object, and then allocates it
+ * @coverage pvPoolAlloc vPoolFree
+ */
+void test_pvPoolAlloc_BlockUntilFreed( void )
+{
+    UBaseType_t x;
+    void * pvObject;
+
+    prvCreatePool();
+
+    for( x = 0; x < POOL_OBJECT_COUNT; x++ )
+    {
+        ( void ) pvPoolAlloc( xPool, 0 );
+    }
+
+    pvObjectToFree = prvObject( 1 );
+    xRemoveReturn = pdTRUE;
+
+    vTaskInternalSetTimeOutState_ExpectAnyArgs();
+    vTaskPlaceOnEventList_Stub( vPlaceOnEventListFreeStub );
+    xTaskRemoveFromEventList_Stub( xRemoveFromEventListStub );
+    vFakePortYieldWithinAPI_Expect(); /* Yield to the unblocked task. */
+    vFakePortYieldWithinAPI_Expect(); /* Block. */
+
+    pvObject = pvPoolAlloc( xPool, 10 );
+
+    TEST_ASSERT_EQUAL_PTR( prvObject( 1 ), pvObject );
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( pxWaitingList ) );
+
+    /* No task is waiting, so freeing does not look at the event list. */
+    vPoolFree( xPool, pvObject );
+}
+
+/*!
+ * @brief validate an interrupt freeing an object unblocks a task waiting on
+ * the pool, and reports that a context switch is required
+ * @coverage pvPoolAlloc vPoolFreeFromISR
+ */
+void test_vPoolFreeFromISR_UnblocksTask( void )
+{
+    UBaseType_t x;
+
+    prvCreatePool();
+
+    for( x = 0; x < POOL_OBJECT_COUNT; x++ )
+    {
+        ( void ) pvPoolAlloc( xPool, 0 );
+    }
+
+    pvObjectToFree = prvObject( 3 );
+    xRemoveReturn = pdTRUE;
+
+    vTaskInternalSetTimeOutState_ExpectAnyArgs();
+    vTaskPlaceOnEventList_Stub( vPlaceOnEventListFreeFromISRStub );
+    xTaskRemoveFromEventList_Stub( xRemoveFromEventListStub );
+    vFakePortYieldWithinAPI_Expect();
+
+    TEST_ASSERT_EQUAL_PTR( prvObject( 3 ), pvPoolAlloc( xPool, portMAX_DELAY ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xWokenByISR );
+}
+
+/*!
+ * @brief validate waking a task of lower priority does not yield
+ * @coverage vPoolFree
+ */
+void test_vPoolFree_UnblocksLowerPriorityTask( void )
+{
+    UBaseType_t x;
+
+    prvCreatePool();
+
+    for( x = 0; x < POOL_OBJECT_COUNT; x++ )
+    {
+        ( void ) pvPoolAlloc( xPool, 0 );
+    }
+
+    pvObjectToFree = prvObject( 0 );
+    xRemoveReturn = pdFALSE;
+
+    vTaskInternalSetTimeOutState_ExpectAnyArgs();
+    vTaskPlaceOnEventList_Stub( vPlaceOnEventListFreeStub );
+    xTaskRemoveFromEventList_Stub( xRemoveFromEventListStub );
+    vFakePortYieldWithinAPI_Expect(); /* Block only. */
+
+    TEST_ASSERT_EQUAL_PTR( prvObject( 0 ), pvPoolAlloc( xPool, 10 ) );
+}
+
+/*!
+ * @brief validate a task blocked on an empty pool returns NULL when its block
+ * time expires
+ * @coverage pvPoolAlloc
+ */
+void test_pvPoolAlloc_Timeout( void )
+{
+    PoolStatus_t xStatus;
+    UBaseType_t x;
+
+    prvCreatePool();
+
+    for( x = 0; x < POOL_OBJECT_COUNT; x++ )
+    {
+        ( void ) pvPoolAlloc( xPool, 0 );
+    }
+
+    vTaskInternalSetTimeOutState_ExpectAnyArgs();
+    vTaskPlaceOnEventList_Stub( vPlaceOnEventListTimeoutStub );
+    vFakePortYieldWithinAPI_Expect();
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdTRUE );
+
+    TEST_ASSERT_NULL( pvPoolAlloc( xPool, 10 ) );
+
+    vPoolGetStatus( xPool, &xStatus );
+    TEST_ASSERT_EQUAL( 1, xStatus.ulFailedAllocations );
+}
+
+/*!
+ * @brief validate the pool table is written in the format used by
+ * vTaskGetRunTimeStats()
+ * @coverage vPoolGetRunTimeStats
+ */
+void test_vPoolGetRunTimeStats_Format( void )
+{
+    char cBuffer[ 200 ];
+    void * pvObject;
+
+    prvCreatePool();
+    xSecondPool = xPoolCreateStatic( "Second", sizeof( ulSecondPoolStorage ), 1, ( uint8_t * ) ulSecondPoolStorage, &xSecondPoolBuffer );
+
+    ( void ) pvPoolAlloc( xPool, 0 );
+    pvObject = pvPoolAlloc( xPool, 0 );
+    vPoolFree( xPool, pvObject );
+    ( void ) pvPoolAlloc( xSecondPool, 0 );
+    ( void ) pvPoolAlloc( xSecondPool, 0 );
+
+    vPoolGetRunTimeStats( cBuffer );
+
+    /* The most recently created pool is listed first. */
+    TEST_ASSERT_EQUAL_STRING( "Second     \t1\t1\t1\t1\t1\r\n"
+                              "Pool       \t4\t1\t2\t2\t0\r\n", cBuffer );
+}
+
+/*!
+ * @brief validate a deleted pool is no longer listed
+ * @coverage vPoolDelete vPoolGetRunTimeStats
+ */
+void test_vPoolDelete_RemovedFromStats( void )
+{
+    char cBuffer[ 200 ];
+
+    prvCreatePool();
+    xSecondPool = xPoolCreateStatic( "Second", sizeof( ulSecondPoolStorage ), 1, ( uint8_t * ) ulSecondPoolStorage, &xSecondPoolBuffer );
+
+    vPoolDelete( xPool );
+    xPool = NULL;
+
+    vPoolGetRunTimeStats( cBuffer );
+    TEST_ASSERT_EQUAL_STRING( "Second     \t1\t0\t0\t0\t0\r\n", cBuffer );
+
+    vPoolDelete( xSecondPool );
+    xSecondPool = NULL;
+
+    vPoolGetRunTimeStats( cBuffer );
+    TEST_ASSERT_EQUAL_STRING( "", cBuffer );
+}
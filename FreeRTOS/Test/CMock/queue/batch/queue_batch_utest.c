@@ -0,0 +1,442 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file queue_batch_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../queue_utest_common.h"
+
+/* Queue includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "queue.h"
+#include "mock_fake_port.h"
+
+/* ===============================  CONSTANTS =============================== */
+
+#define BATCH_QUEUE_LENGTH    5
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/* Counts kept by td_port.c. */
+extern uint32_t ulNumEnterCriticalSection;
+extern uint32_t ulNumCallsSetInterruptMaskFromISR;
+
+/* Queue used by the xTaskCheckForTimeOut callbacks. */
+static QueueHandle_t xQueueHandleStatic = NULL;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+/* ============================= Unity Fixtures ============================= */
+
+void setUp( void )
+{
+    commonSetUp();
+    vFakePortAssertIfInterruptPriorityInvalid_Ignore();
+}
+
+void tearDown( void )
+{
+    commonTearDown();
+}
+
+void suiteSetUp()
+{
+    commonSuiteSetUp();
+}
+
+int suiteTearDown( int numFailures )
+{
+    return commonSuiteTearDown( numFailures );
+}
+
+/* ==========================  Helper functions =========================== */
+
+/**
+ * @brief Fill an array with sequential test values.
+ */
+static void prvFillBatch( uint32_t * pulItems,
+                          uint32_t ulCount )
+{
+    uint32_t i;
+
+    for( i = 0; i < ulCount; i++ )
+    {
+        pulItems[ i ] = getNextMonotonicTestValue();
+    }
+}
+
+/* =============================  Test Cases ============================== */
+
+/**
+ * @brief Items sent and received in batches stay in FIFO order while the
+ * read and write positions wrap.
+ * @details Each call must take a single critical section however many items
+ * it moves.
+ * @coverage xQueueSendMultiple xQueueReceiveMultiple prvCopyMultipleToQueue prvCopyMultipleFromQueue
+ */
+void test_xQueueSendMultiple_xQueueReceiveMultiple_fifo_wrap( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( BATCH_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t sendVals[ 2 * BATCH_QUEUE_LENGTH ];
+    uint32_t checkVals[ 2 * BATCH_QUEUE_LENGTH ];
+    uint32_t ulNumCriticalSections;
+    uint32_t i;
+
+    TEST_ASSERT_NOT_NULL( xQueue );
+
+    prvFillBatch( sendVals, 2 * BATCH_QUEUE_LENGTH );
+
+    ulNumCriticalSections = ulNumEnterCriticalSection;
+    TEST_ASSERT_EQUAL( 3, xQueueSendMultiple( xQueue, &sendVals[ 0 ], 3, 0 ) );
+    TEST_ASSERT_EQUAL( ulNumCriticalSections + 1, ulNumEnterCriticalSection );
+
+    ulNumCriticalSections = ulNumEnterCriticalSection;
+    TEST_ASSERT_EQUAL( 2, xQueueReceiveMultiple( xQueue, checkVals, 2, 0 ) );
+    TEST_ASSERT_EQUAL( ulNumCriticalSections + 1, ulNumEnterCriticalSection );
+    TEST_ASSERT_EQUAL_UINT32_ARRAY( &sendVals[ 0 ], checkVals, 2 );
+
+    /* The write position wraps part way through this batch. */
+    TEST_ASSERT_EQUAL( 4, xQueueSendMultiple( xQueue, &sendVals[ 3 ], 4, 0 ) );
+    TEST_ASSERT_EQUAL( BATCH_QUEUE_LENGTH, uxQueueMessagesWaiting( xQueue ) );
+
+    /* The read position wraps part way through this batch, and fewer items
+     * are available than requested. */
+    TEST_ASSERT_EQUAL( BATCH_QUEUE_LENGTH, xQueueReceiveMultiple( xQueue, checkVals, 2 * BATCH_QUEUE_LENGTH, 0 ) );
+    TEST_ASSERT_EQUAL_UINT32_ARRAY( &sendVals[ 2 ], checkVals, BATCH_QUEUE_LENGTH );
+    TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+
+    /* Single item operations interleave correctly with batched ones. */
+    for( i = 0; i < ( 3 * BATCH_QUEUE_LENGTH ); i++ )
+    {
+        prvFillBatch( sendVals, 3 );
+
+        TEST_ASSERT_EQUAL( 2, xQueueSendMultiple( xQueue, sendVals, 2, 0 ) );
+        TEST_ASSERT_EQUAL( pdPASS, xQueueSend( xQueue, &sendVals[ 2 ], 0 ) );
+
+        checkVals[ 0 ] = INVALID_UINT32;
+        TEST_ASSERT_EQUAL( pdPASS, xQueueReceive( xQueue, &checkVals[ 0 ], 0 ) );
+        TEST_ASSERT_EQUAL( 2, xQueueReceiveMultiple( xQueue, &checkVals[ 1 ], 3, 0 ) );
+        TEST_ASSERT_EQUAL_UINT32_ARRAY( sendVals, checkVals, 3 );
+    }
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief A non-blocking batched send to a nearly full queue sends what fits.
+ * @coverage xQueueSendMultiple prvCopyMultipleToQueue
+ */
+void test_xQueueSendMultiple_partial_no_wait( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( BATCH_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t sendVals[ BATCH_QUEUE_LENGTH ];
+    uint32_t checkVals[ BATCH_QUEUE_LENGTH ];
+
+    queue_common_add_sequential_to_queue( xQueue, BATCH_QUEUE_LENGTH - 2 );
+    prvFillBatch( sendVals, BATCH_QUEUE_LENGTH );
+
+    TEST_ASSERT_EQUAL( 2, xQueueSendMultiple( xQueue, sendVals, BATCH_QUEUE_LENGTH, 0 ) );
+    TEST_ASSERT_EQUAL( 0, xQueueSendMultiple( xQueue, sendVals, BATCH_QUEUE_LENGTH, 0 ) );
+    TEST_ASSERT_EQUAL( 0, xQueueSendMultipleFromISR( xQueue, sendVals, BATCH_QUEUE_LENGTH, NULL ) );
+
+    TEST_ASSERT_EQUAL( BATCH_QUEUE_LENGTH, xQueueReceiveMultiple( xQueue, checkVals, BATCH_QUEUE_LENGTH, 0 ) );
+    TEST_ASSERT_EQUAL_UINT32_ARRAY( sendVals, &checkVals[ BATCH_QUEUE_LENGTH - 2 ], 2 );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief A non-blocking batched receive from an empty queue returns zero.
+ * @coverage xQueueReceiveMultiple xQueueReceiveMultipleFromISR
+ */
+void test_xQueueReceiveMultiple_empty_no_wait( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( BATCH_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t checkVals[ BATCH_QUEUE_LENGTH ] = { INVALID_UINT32 };
+
+    TEST_ASSERT_EQUAL( 0, xQueueReceiveMultiple( xQueue, checkVals, BATCH_QUEUE_LENGTH, 0 ) );
+    TEST_ASSERT_EQUAL( 0, xQueueReceiveMultipleFromISR( xQueue, checkVals, BATCH_QUEUE_LENGTH, NULL ) );
+    TEST_ASSERT_EQUAL( INVALID_UINT32, checkVals[ 0 ] );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Batched operations are not supported on semaphores, SPSC queues or
+ * queue set members.
+ * @coverage xQueueSendMultiple xQueueReceiveMultiple xQueueSendMultipleFromISR xQueueReceiveMultipleFromISR
+ */
+void test_batch_unsupported_queues( void )
+{
+    QueueHandle_t xSemaphore = xQueueCreate( BATCH_QUEUE_LENGTH, 0 );
+    QueueHandle_t xSPSCQueue = xQueueCreateSPSC( BATCH_QUEUE_LENGTH, sizeof( uint32_t ) );
+    QueueHandle_t xQueue = xQueueCreate( BATCH_QUEUE_LENGTH, sizeof( uint32_t ) );
+    QueueSetHandle_t xQueueSet = xQueueCreateSet( BATCH_QUEUE_LENGTH );
+    uint32_t vals[ BATCH_QUEUE_LENGTH ];
+
+    prvFillBatch( vals, BATCH_QUEUE_LENGTH );
+
+    EXPECT_ASSERT_BREAK( xQueueSendMultiple( xSemaphore, vals, 1, 0 ) );
+    EXPECT_ASSERT_BREAK( xQueueReceiveMultiple( xSemaphore, vals, 1, 0 ) );
+    EXPECT_ASSERT_BREAK( xQueueSendMultiple( xSPSCQueue, vals, 1, 0 ) );
+    EXPECT_ASSERT_BREAK( xQueueReceiveMultipleFromISR( xSPSCQueue, vals, 1, NULL ) );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueAddToSet( xQueue, xQueueSet ) );
+    EXPECT_ASSERT_BREAK( xQueueSendMultipleFromISR( xQueue, vals, 1, NULL ) );
+    EXPECT_ASSERT_BREAK( xQueueReceiveMultiple( xQueue, vals, 1, 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xQueueRemoveFromSet( xQueue, xQueueSet ) );
+
+    vQueueDelete( xQueueSet );
+    vQueueDelete( xQueue );
+    vQueueDelete( xSPSCQueue );
+    vQueueDelete( xSemaphore );
+}
+
+/**
+ * @brief A batched send unblocks a higher priority waiting receiver.
+ * @coverage xQueueSendMultiple prvRemoveMultipleFromEventList
+ */
+void test_xQueueSendMultiple_unblock_receiver( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( BATCH_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t sendVals[ 3 ];
+
+    prvFillBatch( sendVals, 3 );
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToReceiveFromQueue( xQueue );
+
+    TEST_ASSERT_EQUAL( 3, xQueueSendMultiple( xQueue, sendVals, 3, 0 ) );
+
+    /* One receiver is woken and the sender yields once. */
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( pdTRUE, listLIST_IS_EMPTY( pxGetTasksWaitingToReceiveFromQueue( xQueue ) ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief A batched receive from an ISR unblocks a higher priority waiting
+ * sender.
+ * @coverage xQueueReceiveMultipleFromISR prvRemoveMultipleFromEventList
+ */
+void test_xQueueReceiveMultipleFromISR_unblock_sender( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( BATCH_QUEUE_LENGTH, sizeof( uint32_t ) );
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t checkVals[ BATCH_QUEUE_LENGTH ];
+    uint32_t ulNumCallsSetInterruptMask;
+
+    queue_common_add_sequential_to_queue( xQueue, BATCH_QUEUE_LENGTH );
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToSendToQueue( xQueue );
+
+    ulNumCallsSetInterruptMask = ulNumCallsSetInterruptMaskFromISR;
+
+    TEST_ASSERT_EQUAL( 2, xQueueReceiveMultipleFromISR( xQueue, checkVals, 2, &xHigherPriorityTaskWoken ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xHigherPriorityTaskWoken );
+    TEST_ASSERT_EQUAL( pdTRUE, td_task_getYieldPending() );
+    TEST_ASSERT_EQUAL( ulNumCallsSetInterruptMask + 1, ulNumCallsSetInterruptMaskFromISR );
+    TEST_ASSERT_EQUAL( pdTRUE, listLIST_IS_EMPTY( pxGetTasksWaitingToSendToQueue( xQueue ) ) );
+    TEST_ASSERT_EQUAL( BATCH_QUEUE_LENGTH - 2, uxQueueMessagesWaiting( xQueue ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Batched ISR operations on a locked queue increment the lock count
+ * once per item moved.
+ * @coverage xQueueSendMultipleFromISR xQueueReceiveMultipleFromISR
+ */
+void test_batch_from_isr_locked( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( BATCH_QUEUE_LENGTH, sizeof( uint32_t ) );
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t vals[ 3 ];
+
+    prvFillBatch( vals, 3 );
+
+    vSetQueueTxLock( xQueue, queueLOCKED_UNMODIFIED );
+    vSetQueueRxLock( xQueue, queueLOCKED_UNMODIFIED );
+    uxTaskGetNumberOfTasks_IgnoreAndReturn( 5 );
+
+    TEST_ASSERT_EQUAL( 3, xQueueSendMultipleFromISR( xQueue, vals, 3, &xHigherPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL( queueLOCKED_UNMODIFIED + 3, cGetQueueTxLock( xQueue ) );
+
+    TEST_ASSERT_EQUAL( 2, xQueueReceiveMultipleFromISR( xQueue, vals, 2, &xHigherPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL( queueLOCKED_UNMODIFIED + 2, cGetQueueRxLock( xQueue ) );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xHigherPriorityTaskWoken );
+    TEST_ASSERT_EQUAL( 1, uxQueueMessagesWaiting( xQueue ) );
+
+    vSetQueueTxLock( xQueue, queueUNLOCKED );
+    vSetQueueRxLock( xQueue, queueUNLOCKED );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ *  @brief Callback that sends two items to the queue from an ISR while the
+ *  receiving task is blocked.
+ */
+static BaseType_t batch_send_xTaskCheckForTimeOutCB( TimeOut_t * const pxTimeOut,
+                                                     TickType_t * const pxTicksToWait,
+                                                     int cmock_num_calls )
+{
+    BaseType_t xReturnValue = td_task_xTaskCheckForTimeOutStub( pxTimeOut, pxTicksToWait, cmock_num_calls );
+
+    if( cmock_num_calls == NUM_CALLS_TO_INTERCEPT )
+    {
+        uint32_t vals[ 2 ];
+
+        prvFillBatch( vals, 2 );
+        TEST_ASSERT_EQUAL( 2, xQueueSendMultipleFromISR( xQueueHandleStatic, vals, 2, NULL ) );
+    }
+
+    return xReturnValue;
+}
+
+/**
+ * @brief A blocking batched receive returns the items that arrive while it
+ * is blocked.
+ * @coverage xQueueReceiveMultiple
+ */
+void test_xQueueReceiveMultiple_blocking_success( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( BATCH_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t checkVals[ BATCH_QUEUE_LENGTH ] = { INVALID_UINT32 };
+
+    xQueueHandleStatic = xQueue;
+    xTaskCheckForTimeOut_Stub( &batch_send_xTaskCheckForTimeOutCB );
+    uxTaskGetNumberOfTasks_IgnoreAndReturn( 1 );
+
+    TEST_ASSERT_EQUAL( 2, xQueueReceiveMultiple( xQueue, checkVals, BATCH_QUEUE_LENGTH, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( getLastMonotonicTestValue() - 1, checkVals[ 0 ] );
+    TEST_ASSERT_EQUAL( getLastMonotonicTestValue(), checkVals[ 1 ] );
+    TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief A blocking batched receive from an empty queue times out.
+ * @coverage xQueueReceiveMultiple
+ */
+void test_xQueueReceiveMultiple_blocking_timeout( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( BATCH_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t checkVals[ BATCH_QUEUE_LENGTH ] = { INVALID_UINT32 };
+
+    TEST_ASSERT_EQUAL( 0, xQueueReceiveMultiple( xQueue, checkVals, BATCH_QUEUE_LENGTH, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( INVALID_UINT32, checkVals[ 0 ] );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ *  @brief Callback that receives two items from the queue in an ISR while the
+ *  sending task is blocked.
+ */
+static BaseType_t batch_receive_xTaskCheckForTimeOutCB( TimeOut_t * const pxTimeOut,
+                                                        TickType_t * const pxTicksToWait,
+                                                        int cmock_num_calls )
+{
+    BaseType_t xReturnValue = td_task_xTaskCheckForTimeOutStub( pxTimeOut, pxTicksToWait, cmock_num_calls );
+
+    if( cmock_num_calls == NUM_CALLS_TO_INTERCEPT )
+    {
+        uint32_t vals[ 2 ];
+
+        TEST_ASSERT_EQUAL( 2, xQueueReceiveMultipleFromISR( xQueueHandleStatic, vals, 2, NULL ) );
+    }
+
+    return xReturnValue;
+}
+
+/**
+ * @brief A blocking batched send keeps sending as space is freed and returns
+ * once every item has been sent.
+ * @coverage xQueueSendMultiple
+ */
+void test_xQueueSendMultiple_blocking_success( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( BATCH_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t sendVals[ 3 ];
+    uint32_t checkVals[ BATCH_QUEUE_LENGTH ];
+
+    queue_common_add_sequential_to_queue( xQueue, BATCH_QUEUE_LENGTH - 1 );
+    prvFillBatch( sendVals, 3 );
+
+    xQueueHandleStatic = xQueue;
+    xTaskCheckForTimeOut_Stub( &batch_receive_xTaskCheckForTimeOutCB );
+    uxTaskGetNumberOfTasks_IgnoreAndReturn( 1 );
+
+    /* One item fits immediately, the other two once the ISR has run. */
+    TEST_ASSERT_EQUAL( 3, xQueueSendMultiple( xQueue, sendVals, 3, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getCount_vPortYieldWithinAPI() );
+
+    TEST_ASSERT_EQUAL( BATCH_QUEUE_LENGTH, xQueueReceiveMultiple( xQueue, checkVals, BATCH_QUEUE_LENGTH, 0 ) );
+    TEST_ASSERT_EQUAL_UINT32_ARRAY( sendVals, &checkVals[ BATCH_QUEUE_LENGTH - 3 ], 3 );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief A blocking batched send to a nearly full queue times out and
+ * returns the number of items that were sent.
+ * @coverage xQueueSendMultiple
+ */
+void test_xQueueSendMultiple_blocking_timeout( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( BATCH_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t sendVals[ 3 ];
+
+    queue_common_add_sequential_to_queue( xQueue, BATCH_QUEUE_LENGTH - 1 );
+    prvFillBatch( sendVals, 3 );
+
+    TEST_ASSERT_EQUAL( 1, xQueueSendMultiple( xQueue, sendVals, 3, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( BATCH_QUEUE_LENGTH, uxQueueMessagesWaiting( xQueue ) );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vQueueDelete( xQueue );
+}
@@ -0,0 +1,300 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file queue_handoff_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../queue_utest_common.h"
+
+/* Queue includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "semphr.h"
+#include "mock_fake_port.h"
+
+/* ===============================  CONSTANTS =============================== */
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/* Mutex given by the xTaskResumeAll callback. */
+static SemaphoreHandle_t xSemaphoreHandleStatic = NULL;
+
+/* Handle returned for the task calling the API under test. */
+static TaskHandle_t xCurrentTask = NULL;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+/* ============================= Unity Fixtures ============================= */
+
+void setUp( void )
+{
+    commonSetUp();
+    vFakePortAssertIfInterruptPriorityInvalid_Ignore();
+    xSemaphoreHandleStatic = NULL;
+    xCurrentTask = ( TaskHandle_t ) ( ( uint64_t ) 0 + getNextMonotonicTestValue() );
+}
+
+void tearDown( void )
+{
+    commonTearDown();
+}
+
+void suiteSetUp()
+{
+    commonSuiteSetUp();
+}
+
+int suiteTearDown( int numFailures )
+{
+    return commonSuiteTearDown( numFailures );
+}
+
+/* ==========================  Helper functions =========================== */
+
+/**
+ * @brief Create a mutex and take it on behalf of another task.
+ */
+static SemaphoreHandle_t prvCreateMutexHeldBy( TaskHandle_t xHolder )
+{
+    SemaphoreHandle_t xSemaphore;
+
+    xTaskPriorityDisinherit_ExpectAndReturn( NULL, pdFALSE );
+    xSemaphore = xSemaphoreCreateMutex();
+    TEST_ASSERT_NOT_NULL( xSemaphore );
+
+    pvTaskIncrementMutexHeldCount_ExpectAndReturn( xHolder );
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, 0 ) );
+
+    return xSemaphore;
+}
+
+/* =============================  Test Cases ============================== */
+
+/**
+ * @brief Giving a mutex that a task is waiting for makes that task the holder.
+ * @details The mutex count must stay at zero so no other task can take the
+ * mutex before the waiting task runs.
+ * @coverage xQueueGenericSend prvHandOffMutex
+ */
+void test_xSemaphoreGive_mutex_handoff_to_waiter( void )
+{
+    TaskHandle_t xHolder = ( TaskHandle_t ) ( ( uint64_t ) 0 + getNextMonotonicTestValue() );
+    TaskHandle_t xWaiter = ( TaskHandle_t ) ( ( uint64_t ) 0 + getNextMonotonicTestValue() );
+    SemaphoreHandle_t xSemaphore = prvCreateMutexHeldBy( xHolder );
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToReceiveFromQueue( xSemaphore );
+
+    xTaskPriorityDisinherit_ExpectAndReturn( xHolder, pdFALSE );
+    pvTaskIncrementWaiterMutexHeldCount_ExpectAnyArgsAndReturn( xWaiter );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreGive( xSemaphore ) );
+
+    TEST_ASSERT_EQUAL( B_SEMPHR_TAKEN, uxSemaphoreGetCount( xSemaphore ) );
+    TEST_ASSERT_EQUAL_PTR( xWaiter, xSemaphoreGetMutexHolder( xSemaphore ) );
+
+    /* The waiting task has a higher priority so the give yields to it. */
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Giving a mutex nobody is waiting for leaves it available.
+ * @coverage xQueueGenericSend
+ */
+void test_xSemaphoreGive_mutex_no_waiter( void )
+{
+    TaskHandle_t xHolder = ( TaskHandle_t ) ( ( uint64_t ) 0 + getNextMonotonicTestValue() );
+    SemaphoreHandle_t xSemaphore = prvCreateMutexHeldBy( xHolder );
+
+    xTaskPriorityDisinherit_ExpectAndReturn( xHolder, pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreGive( xSemaphore ) );
+
+    TEST_ASSERT_EQUAL( B_SEMPHR_AVAILABLE, uxSemaphoreGetCount( xSemaphore ) );
+    TEST_ASSERT_NULL( xSemaphoreGetMutexHolder( xSemaphore ) );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief A binary semaphore is never handed off.
+ * @coverage xQueueGenericSend prvHandOffMutex
+ */
+void test_xSemaphoreGive_binary_no_handoff( void )
+{
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateBinary();
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY - 1 );
+    td_task_addFakeTaskWaitingToReceiveFromQueue( xSemaphore );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreGive( xSemaphore ) );
+
+    TEST_ASSERT_EQUAL( B_SEMPHR_AVAILABLE, uxSemaphoreGetCount( xSemaphore ) );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief A mutex that is a member of a queue set is not handed off.
+ * @details Tasks blocked on the set rather than the mutex must still find the
+ * mutex available when the set reports it.
+ * @coverage xQueueGenericSend
+ */
+void test_xSemaphoreGive_mutex_in_set_no_handoff( void )
+{
+    TaskHandle_t xHolder = ( TaskHandle_t ) ( ( uint64_t ) 0 + getNextMonotonicTestValue() );
+    SemaphoreHandle_t xSemaphore = prvCreateMutexHeldBy( xHolder );
+    QueueSetHandle_t xQueueSet = xQueueCreateSet( 1 );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueAddToSet( xSemaphore, xQueueSet ) );
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY - 1 );
+    td_task_addFakeTaskWaitingToReceiveFromQueue( xSemaphore );
+
+    xTaskPriorityDisinherit_ExpectAndReturn( xHolder, pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreGive( xSemaphore ) );
+
+    TEST_ASSERT_EQUAL( B_SEMPHR_AVAILABLE, uxSemaphoreGetCount( xSemaphore ) );
+    TEST_ASSERT_NULL( xSemaphoreGetMutexHolder( xSemaphore ) );
+
+    TEST_ASSERT_EQUAL_PTR( xSemaphore, xQueueSelectFromSet( xQueueSet, 0 ) );
+
+    vQueueDelete( xQueueSet );
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Callback for test_xSemaphoreTake_blocking_mutex_handoff that gives
+ * the mutex while the calling task is blocked on it.
+ */
+static BaseType_t xSemaphoreTake_handoff_xTaskResumeAllStub( int cmock_num_calls )
+{
+    BaseType_t xReturnValue;
+
+    if( cmock_num_calls == NUM_CALLS_TO_INTERCEPT )
+    {
+        xTaskPriorityDisinherit_ExpectAnyArgsAndReturn( pdFALSE );
+        pvTaskIncrementWaiterMutexHeldCount_ExpectAnyArgsAndReturn( xCurrentTask );
+        TEST_ASSERT_TRUE( xSemaphoreGive( xSemaphoreHandleStatic ) );
+    }
+
+    xReturnValue = td_task_xTaskResumeAllStub( cmock_num_calls );
+
+    return xReturnValue;
+}
+
+/**
+ * @brief A task blocked on a mutex returns holding it once it is handed off.
+ * @details The task must record which mutex it is blocked on while blocked,
+ * clear that record each time it runs, and must not take the mutex count or
+ * increment its held count a second time.
+ * @coverage xQueueSemaphoreTake prvHandOffMutex
+ */
+void test_xSemaphoreTake_blocking_mutex_handoff( void )
+{
+    TaskHandle_t xHolder = ( TaskHandle_t ) ( ( uint64_t ) 0 + getNextMonotonicTestValue() );
+    SemaphoreHandle_t xSemaphore = prvCreateMutexHeldBy( xHolder );
+
+    xSemaphoreHandleStatic = xSemaphore;
+
+    xTaskResumeAll_Stub( &xSemaphoreTake_handoff_xTaskResumeAllStub );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( xCurrentTask );
+    vTaskSetBlockingMutexHolder_Ignore();
+    xTaskPriorityInherit_IgnoreAndReturn( pdTRUE );
+
+    TEST_ASSERT_EQUAL( pdPASS, xSemaphoreTake( xSemaphore, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( B_SEMPHR_TAKEN, uxSemaphoreGetCount( xSemaphore ) );
+    TEST_ASSERT_EQUAL_PTR( xCurrentTask, xSemaphoreGetMutexHolder( xSemaphore ) );
+
+    /* The calling task yielded once each time it blocked. */
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT + 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT + 1, td_task_getCount_vPortYieldWithinAPI() );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief A task that blocks on a mutex records the mutex holder for
+ * transitive priority inheritance, then clears it when it runs again.
+ * @coverage xQueueSemaphoreTake
+ */
+void test_xSemaphoreTake_blocking_mutex_sets_blocking_holder( void )
+{
+    TaskHandle_t xHolder = ( TaskHandle_t ) ( ( uint64_t ) 0 + getNextMonotonicTestValue() );
+    SemaphoreHandle_t xSemaphore = prvCreateMutexHeldBy( xHolder );
+    int i;
+
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( xCurrentTask );
+
+    for( i = 0; i < TICKS_TO_WAIT; i++ )
+    {
+        vTaskSetBlockingMutexHolder_ExpectAnyArgs();
+        xTaskPriorityInherit_ExpectAndReturn( xHolder, pdTRUE );
+        vTaskSetBlockingMutexHolder_Expect( NULL );
+    }
+
+    vTaskPriorityDisinheritAfterTimeout_Expect( xHolder, tskIDLE_PRIORITY );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xSemaphoreTake( xSemaphore, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL_PTR( xHolder, xSemaphoreGetMutexHolder( xSemaphore ) );
+
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief A task blocked on a mutex it already holds is not treated as having
+ * been handed the mutex.
+ * @coverage xQueueSemaphoreTake
+ */
+void test_xSemaphoreTake_blocking_mutex_held_by_self_times_out( void )
+{
+    SemaphoreHandle_t xSemaphore = prvCreateMutexHeldBy( xCurrentTask );
+
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( xCurrentTask );
+    vTaskSetBlockingMutexHolder_Ignore();
+    xTaskPriorityInherit_IgnoreAndReturn( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xSemaphoreTake( xSemaphore, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL_PTR( xCurrentTask, xSemaphoreGetMutexHolder( xSemaphore ) );
+
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vSemaphoreDelete( xSemaphore );
+}
@@ -0,0 +1,211 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file queue_memcpy_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../queue_utest_common.h"
+
+/* Queue includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "queue.h"
+#include "mock_fake_port.h"
+
+/* ===============================  CONSTANTS =============================== */
+
+#define MEMCPY_QUEUE_LENGTH    3
+#define MEMCPY_MAX_ITEM_SIZE   40
+#define MEMCPY_GUARD_BYTE      0x5AU
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/* The item sizes copied by the tests: each size copied by a constant size
+ * memcpy(), and sizes either side of them that take the default path. */
+static const size_t xItemSizes[] = { 1, 3, 4, 7, 8, 12, 16, 24, 32, 33, MEMCPY_MAX_ITEM_SIZE };
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+/* ============================= Unity Fixtures ============================= */
+
+void setUp( void )
+{
+    commonSetUp();
+    vFakePortAssertIfInterruptPriorityInvalid_Ignore();
+}
+
+void tearDown( void )
+{
+    commonTearDown();
+}
+
+void suiteSetUp()
+{
+    commonSuiteSetUp();
+}
+
+int suiteTearDown( int numFailures )
+{
+    return commonSuiteTearDown( numFailures );
+}
+
+/* ==========================  Helper functions =========================== */
+
+/**
+ * @brief Fill an item with test values.
+ */
+static void prvFillItem( uint8_t * pucItem,
+                         size_t xSize )
+{
+    size_t i;
+
+    for( i = 0; i < xSize; i++ )
+    {
+        pucItem[ i ] = ( uint8_t ) getNextMonotonicTestValue();
+    }
+}
+
+/**
+ * @brief Check an item received into pucBuffer matches pucExpected, and that
+ * the rest of pucBuffer still holds the guard value.
+ */
+static void prvCheckItem( const uint8_t * pucExpected,
+                          const uint8_t * pucBuffer,
+                          size_t xSize )
+{
+    size_t i;
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( pucExpected, pucBuffer, xSize );
+
+    for( i = xSize; i < ( MEMCPY_MAX_ITEM_SIZE + 1 ); i++ )
+    {
+        TEST_ASSERT_EQUAL_HEX8( MEMCPY_GUARD_BYTE, pucBuffer[ i ] );
+    }
+}
+
+/* =============================  Test Cases ============================== */
+
+/**
+ * @brief Items of every size are copied intact, and no more than the item
+ * size is written, when sent to the back and front of a queue, peeked and
+ * received.
+ * @coverage xQueueGenericSend xQueuePeek xQueueReceive prvCopyDataToQueue prvCopyDataFromQueue
+ */
+void test_xQueueSend_xQueueReceive_sized_copies( void )
+{
+    uint8_t ucBack[ MEMCPY_MAX_ITEM_SIZE ];
+    uint8_t ucFront[ MEMCPY_MAX_ITEM_SIZE ];
+    uint8_t ucBuffer[ MEMCPY_MAX_ITEM_SIZE + 1 ];
+    QueueHandle_t xQueue;
+    size_t xSize;
+    uint32_t i;
+
+    for( i = 0; i < ( sizeof( xItemSizes ) / sizeof( xItemSizes[ 0 ] ) ); i++ )
+    {
+        xSize = xItemSizes[ i ];
+
+        xQueue = xQueueCreate( MEMCPY_QUEUE_LENGTH, xSize );
+        TEST_ASSERT_NOT_NULL( xQueue );
+
+        prvFillItem( ucBack, xSize );
+        prvFillItem( ucFront, xSize );
+
+        TEST_ASSERT_EQUAL( pdTRUE, xQueueSendToBack( xQueue, ucBack, 0 ) );
+        TEST_ASSERT_EQUAL( pdTRUE, xQueueSendToFront( xQueue, ucFront, 0 ) );
+
+        ( void ) memset( ucBuffer, MEMCPY_GUARD_BYTE, sizeof( ucBuffer ) );
+        TEST_ASSERT_EQUAL( pdTRUE, xQueuePeek( xQueue, ucBuffer, 0 ) );
+        prvCheckItem( ucFront, ucBuffer, xSize );
+
+        ( void ) memset( ucBuffer, MEMCPY_GUARD_BYTE, sizeof( ucBuffer ) );
+        TEST_ASSERT_EQUAL( pdTRUE, xQueueReceive( xQueue, ucBuffer, 0 ) );
+        prvCheckItem( ucFront, ucBuffer, xSize );
+
+        ( void ) memset( ucBuffer, MEMCPY_GUARD_BYTE, sizeof( ucBuffer ) );
+        TEST_ASSERT_EQUAL( pdTRUE, xQueueReceive( xQueue, ucBuffer, 0 ) );
+        prvCheckItem( ucBack, ucBuffer, xSize );
+
+        TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+
+        vQueueDelete( xQueue );
+    }
+}
+
+/**
+ * @brief An overwritten item of a size copied by a constant size memcpy()
+ * replaces the item held by a queue of length one.
+ * @coverage xQueueOverwrite prvCopyDataToQueue
+ */
+void test_xQueueOverwrite_sized_copy( void )
+{
+    uint64_t ullFirst = 0x0102030405060708ULL;
+    uint64_t ullSecond = 0x1112131415161718ULL;
+    uint64_t ullReceived = 0;
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint64_t ) );
+
+    TEST_ASSERT_NOT_NULL( xQueue );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueOverwrite( xQueue, &ullFirst ) );
+    TEST_ASSERT_EQUAL( pdPASS, xQueueOverwrite( xQueue, &ullSecond ) );
+    TEST_ASSERT_EQUAL( 1, uxQueueMessagesWaiting( xQueue ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueReceive( xQueue, &ullReceived, 0 ) );
+    TEST_ASSERT_EQUAL_HEX64( ullSecond, ullReceived );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Batches of one item, copied by a constant size memcpy(), and of
+ * several items, copied by the default path, stay in order as the queue
+ * positions wrap.
+ * @coverage xQueueSendMultiple xQueueReceiveMultiple prvCopyMultipleToQueue prvCopyMultipleFromQueue
+ */
+void test_xQueueSendMultiple_xQueueReceiveMultiple_sized_copies( void )
+{
+    uint32_t sendVals[ 4 * MEMCPY_QUEUE_LENGTH ][ 4 ];
+    uint32_t checkVals[ 4 * MEMCPY_QUEUE_LENGTH ][ 4 ];
+    QueueHandle_t xQueue = xQueueCreate( MEMCPY_QUEUE_LENGTH, sizeof( sendVals[ 0 ] ) );
+    uint32_t i;
+
+    TEST_ASSERT_NOT_NULL( xQueue );
+
+    prvFillItem( ( uint8_t * ) sendVals, sizeof( sendVals ) );
+
+    for( i = 0; i < ( 4 * MEMCPY_QUEUE_LENGTH ); i += 2 )
+    {
+        TEST_ASSERT_EQUAL( 1, xQueueSendMultiple( xQueue, sendVals[ i ], 1, 0 ) );
+        TEST_ASSERT_EQUAL( 1, xQueueSendMultiple( xQueue, sendVals[ i + 1 ], 1, 0 ) );
+        TEST_ASSERT_EQUAL( 2, xQueueReceiveMultiple( xQueue, checkVals[ i ], 2, 0 ) );
+    }
+
+    TEST_ASSERT_EQUAL_UINT32_ARRAY( sendVals, checkVals, 4 * 4 * MEMCPY_QUEUE_LENGTH );
+
+    vQueueDelete( xQueue );
+}
@@ -0,0 +1,385 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file queue_receive_any_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../queue_utest_common.h"
+
+/* Queue includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "queue.h"
+#include "semphr.h"
+#include "mock_task.h"
+#include "mock_fake_port.h"
+
+/* ===============================  CONSTANTS =============================== */
+
+#define ANY_QUEUE_LENGTH    3
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/* Counts kept by td_port.c. */
+extern uint32_t ulNumEnterCriticalSection;
+
+/* Queues used by the callbacks. */
+static QueueHandle_t xQueues[ configQUEUE_RECEIVE_ANY_MAX_QUEUES ];
+static UBaseType_t uxQueueCount = 0;
+
+/* The index of the queue the xTaskCheckForTimeOut callback sends to. */
+static UBaseType_t uxSendIndex = 0;
+
+/* State recorded by the vTaskPlaceOnEventLists callback. */
+static ListItem_t * pxPlacedItems = NULL;
+static UBaseType_t uxPlacedItems = 0;
+static uint32_t ulPlaceCount = 0;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+/**
+ *  @brief Callback that places the calling task on each event list using the
+ *  items provided, as the kernel would.
+ */
+static void vTaskPlaceOnEventListsCB( List_t * const * ppxEventLists,
+                                      ListItem_t * pxEventListItems,
+                                      UBaseType_t uxEventLists,
+                                      const TickType_t xTicksToWait,
+                                      int cmock_num_calls )
+{
+    UBaseType_t x;
+
+    TEST_ASSERT_EQUAL( uxQueueCount, uxEventLists );
+    TEST_ASSERT_EQUAL( taskSCHEDULER_SUSPENDED, xTaskGetSchedulerState() );
+
+    for( x = 0; x < uxEventLists; x++ )
+    {
+        /* Every queue must be locked while the task is placed on its list. */
+        TEST_ASSERT_EQUAL( queueLOCKED_UNMODIFIED, cGetQueueRxLock( xQueues[ x ] ) );
+        TEST_ASSERT_EQUAL_PTR( pxGetTasksWaitingToReceiveFromQueue( xQueues[ x ] ), ppxEventLists[ x ] );
+
+        vListInitialiseItem( &( pxEventListItems[ x ] ) );
+        listSET_LIST_ITEM_VALUE( &( pxEventListItems[ x ] ), configMAX_PRIORITIES - DEFAULT_PRIORITY );
+        vListInsert( ppxEventLists[ x ], &( pxEventListItems[ x ] ) );
+    }
+
+    pxPlacedItems = pxEventListItems;
+    uxPlacedItems = uxEventLists;
+    ulPlaceCount++;
+}
+
+/**
+ *  @brief Callback that removes the items of the unblocked task from the
+ *  event lists, as the kernel would when it next runs the task.
+ */
+static BaseType_t xTaskResumeAllCB( int cmock_num_calls )
+{
+    UBaseType_t x;
+
+    for( x = 0; x < uxPlacedItems; x++ )
+    {
+        if( listLIST_ITEM_CONTAINER( &( pxPlacedItems[ x ] ) ) != NULL )
+        {
+            ( void ) uxListRemove( &( pxPlacedItems[ x ] ) );
+        }
+    }
+
+    uxPlacedItems = 0;
+
+    return td_task_xTaskResumeAllStub( cmock_num_calls );
+}
+
+/**
+ *  @brief Callback that sends an item to one of the queues from an ISR while
+ *  the receiving task is blocked.
+ */
+static BaseType_t any_send_xTaskCheckForTimeOutCB( TimeOut_t * const pxTimeOut,
+                                                   TickType_t * const pxTicksToWait,
+                                                   int cmock_num_calls )
+{
+    BaseType_t xReturnValue = td_task_xTaskCheckForTimeOutStub( pxTimeOut, pxTicksToWait, cmock_num_calls );
+
+    if( cmock_num_calls == NUM_CALLS_TO_INTERCEPT )
+    {
+        uint32_t ulVal = getNextMonotonicTestValue();
+
+        TEST_ASSERT_EQUAL( pdPASS, xQueueSendFromISR( xQueues[ uxSendIndex ], &ulVal, NULL ) );
+    }
+
+    return xReturnValue;
+}
+
+/* ============================= Unity Fixtures ============================= */
+
+void setUp( void )
+{
+    commonSetUp();
+    vFakePortAssertIfInterruptPriorityInvalid_Ignore();
+    vTaskPlaceOnEventLists_Stub( &vTaskPlaceOnEventListsCB );
+    xTaskResumeAll_Stub( &xTaskResumeAllCB );
+    pxPlacedItems = NULL;
+    uxPlacedItems = 0;
+    ulPlaceCount = 0;
+    uxQueueCount = 0;
+    uxSendIndex = 0;
+}
+
+void tearDown( void )
+{
+    commonTearDown();
+}
+
+void suiteSetUp()
+{
+    commonSuiteSetUp();
+}
+
+int suiteTearDown( int numFailures )
+{
+    return commonSuiteTearDown( numFailures );
+}
+
+/* ==========================  Helper functions =========================== */
+
+/**
+ * @brief Create uxCount queues of uint32_t items for a test.
+ */
+static void prvCreateQueues( UBaseType_t uxCount )
+{
+    UBaseType_t x;
+
+    for( x = 0; x < uxCount; x++ )
+    {
+        xQueues[ x ] = xQueueCreate( ANY_QUEUE_LENGTH, sizeof( uint32_t ) );
+        TEST_ASSERT_NOT_NULL( xQueues[ x ] );
+    }
+
+    uxQueueCount = uxCount;
+}
+
+/**
+ * @brief Delete the queues created by prvCreateQueues(), checking no task was
+ * left waiting on any of them.
+ */
+static void prvDeleteQueues( void )
+{
+    UBaseType_t x;
+
+    for( x = 0; x < uxQueueCount; x++ )
+    {
+        TEST_ASSERT_EQUAL( pdTRUE, listLIST_IS_EMPTY( pxGetTasksWaitingToReceiveFromQueue( xQueues[ x ] ) ) );
+        vQueueDelete( xQueues[ x ] );
+    }
+
+    uxQueueCount = 0;
+}
+
+/* =============================  Test Cases ============================== */
+
+/**
+ * @brief An item is received from the first queue in the array that holds
+ * data, in a single critical section.
+ * @coverage xQueueReceiveAny
+ */
+void test_xQueueReceiveAny_first_non_empty( void )
+{
+    uint32_t ulSent1, ulSent2, ulReceived = INVALID_UINT32;
+    UBaseType_t uxIndex = INVALID_UINT32;
+    uint32_t ulNumCriticalSections;
+
+    prvCreateQueues( 3 );
+
+    ulSent2 = getNextMonotonicTestValue();
+    TEST_ASSERT_EQUAL( pdPASS, xQueueSend( xQueues[ 2 ], &ulSent2, 0 ) );
+    ulSent1 = getNextMonotonicTestValue();
+    TEST_ASSERT_EQUAL( pdPASS, xQueueSend( xQueues[ 1 ], &ulSent1, 0 ) );
+
+    ulNumCriticalSections = ulNumEnterCriticalSection;
+    TEST_ASSERT_EQUAL( pdPASS, xQueueReceiveAny( xQueues, 3, &ulReceived, &uxIndex, 0 ) );
+    TEST_ASSERT_EQUAL( ulNumCriticalSections + 1, ulNumEnterCriticalSection );
+    TEST_ASSERT_EQUAL( 1, uxIndex );
+    TEST_ASSERT_EQUAL( ulSent1, ulReceived );
+
+    /* The index is optional. */
+    TEST_ASSERT_EQUAL( pdPASS, xQueueReceiveAny( xQueues, 3, &ulReceived, NULL, 0 ) );
+    TEST_ASSERT_EQUAL( ulSent2, ulReceived );
+
+    prvDeleteQueues();
+}
+
+/**
+ * @brief Receiving from empty queues without a block time fails straight
+ * away.
+ * @coverage xQueueReceiveAny
+ */
+void test_xQueueReceiveAny_empty_no_wait( void )
+{
+    uint32_t ulReceived = INVALID_UINT32;
+    UBaseType_t uxIndex = INVALID_UINT32;
+
+    prvCreateQueues( 2 );
+
+    TEST_ASSERT_EQUAL( errQUEUE_EMPTY, xQueueReceiveAny( xQueues, 2, &ulReceived, &uxIndex, 0 ) );
+    TEST_ASSERT_EQUAL( INVALID_UINT32, ulReceived );
+    TEST_ASSERT_EQUAL( INVALID_UINT32, uxIndex );
+    TEST_ASSERT_EQUAL( 0, ulPlaceCount );
+
+    prvDeleteQueues();
+}
+
+/**
+ * @brief A receive from a queue that holds data unblocks a higher priority
+ * task waiting to send to it.
+ * @coverage xQueueReceiveAny
+ */
+void test_xQueueReceiveAny_unblock_sender( void )
+{
+    uint32_t ulReceived = INVALID_UINT32;
+    UBaseType_t uxIndex = INVALID_UINT32;
+
+    prvCreateQueues( 2 );
+    queue_common_add_sequential_to_queue( xQueues[ 1 ], ANY_QUEUE_LENGTH );
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToSendToQueue( xQueues[ 1 ] );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueReceiveAny( xQueues, 2, &ulReceived, &uxIndex, 0 ) );
+
+    TEST_ASSERT_EQUAL( 1, uxIndex );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( pdTRUE, listLIST_IS_EMPTY( pxGetTasksWaitingToSendToQueue( xQueues[ 1 ] ) ) );
+
+    prvDeleteQueues();
+}
+
+/**
+ * @brief Semaphores, which have no data to copy, can be waited on without a
+ * buffer.
+ * @coverage xQueueReceiveAny
+ */
+void test_xQueueReceiveAny_semaphores( void )
+{
+    SemaphoreHandle_t xSemaphores[ 2 ];
+    UBaseType_t uxIndex = INVALID_UINT32;
+
+    xSemaphores[ 0 ] = xSemaphoreCreateBinary();
+    xSemaphores[ 1 ] = xSemaphoreCreateCounting( 2, 1 );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueReceiveAny( xSemaphores, 2, NULL, &uxIndex, 0 ) );
+    TEST_ASSERT_EQUAL( 1, uxIndex );
+    TEST_ASSERT_EQUAL( errQUEUE_EMPTY, xQueueReceiveAny( xSemaphores, 2, NULL, &uxIndex, 0 ) );
+
+    vSemaphoreDelete( xSemaphores[ 1 ] );
+    vSemaphoreDelete( xSemaphores[ 0 ] );
+}
+
+/**
+ * @brief Invalid arguments, and queues that cannot be waited on alongside
+ * others, are rejected.
+ * @coverage xQueueReceiveAny
+ */
+void test_xQueueReceiveAny_invalid( void )
+{
+    QueueHandle_t xInvalid[ 2 ];
+    QueueSetHandle_t xQueueSet = xQueueCreateSet( ANY_QUEUE_LENGTH );
+    uint32_t ulReceived;
+
+    prvCreateQueues( 2 );
+
+    EXPECT_ASSERT_BREAK( xQueueReceiveAny( xQueues, 0, &ulReceived, NULL, 0 ) );
+    EXPECT_ASSERT_BREAK( xQueueReceiveAny( xQueues, configQUEUE_RECEIVE_ANY_MAX_QUEUES + 1, &ulReceived, NULL, 0 ) );
+    EXPECT_ASSERT_BREAK( xQueueReceiveAny( xQueues, 2, NULL, NULL, 0 ) );
+
+    xInvalid[ 0 ] = xQueues[ 0 ];
+    xTaskPriorityDisinherit_IgnoreAndReturn( pdFALSE );
+    xInvalid[ 1 ] = xSemaphoreCreateMutex();
+    EXPECT_ASSERT_BREAK( xQueueReceiveAny( xInvalid, 2, &ulReceived, NULL, 0 ) );
+    vSemaphoreDelete( xInvalid[ 1 ] );
+
+    xInvalid[ 1 ] = xQueueCreateSPSC( ANY_QUEUE_LENGTH, sizeof( uint32_t ) );
+    EXPECT_ASSERT_BREAK( xQueueReceiveAny( xInvalid, 2, &ulReceived, NULL, 0 ) );
+    vQueueDelete( xInvalid[ 1 ] );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueAddToSet( xQueues[ 1 ], xQueueSet ) );
+    EXPECT_ASSERT_BREAK( xQueueReceiveAny( xQueues, 2, &ulReceived, NULL, 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xQueueRemoveFromSet( xQueues[ 1 ], xQueueSet ) );
+
+    vQueueDelete( xQueueSet );
+    prvDeleteQueues();
+}
+
+/**
+ * @brief A task blocked on several queues is unblocked by an item sent to
+ * any one of them, and is removed from the event lists of all of them.
+ * @coverage xQueueReceiveAny
+ */
+void test_xQueueReceiveAny_blocking_success( void )
+{
+    uint32_t ulReceived = INVALID_UINT32;
+    UBaseType_t uxIndex = INVALID_UINT32;
+
+    prvCreateQueues( 3 );
+    uxSendIndex = 2;
+    xTaskCheckForTimeOut_Stub( &any_send_xTaskCheckForTimeOutCB );
+    uxTaskGetNumberOfTasks_IgnoreAndReturn( 1 );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueReceiveAny( xQueues, 3, &ulReceived, &uxIndex, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( 2, uxIndex );
+    TEST_ASSERT_EQUAL( getLastMonotonicTestValue(), ulReceived );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, ulPlaceCount );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getCount_vPortYieldWithinAPI() );
+
+    prvDeleteQueues();
+}
+
+/**
+ * @brief A blocking receive from queues that stay empty times out and leaves
+ * the task on none of their event lists.
+ * @coverage xQueueReceiveAny
+ */
+void test_xQueueReceiveAny_blocking_timeout( void )
+{
+    uint32_t ulReceived = INVALID_UINT32;
+    UBaseType_t uxIndex = INVALID_UINT32;
+
+    prvCreateQueues( configQUEUE_RECEIVE_ANY_MAX_QUEUES );
+
+    TEST_ASSERT_EQUAL( errQUEUE_EMPTY, xQueueReceiveAny( xQueues, configQUEUE_RECEIVE_ANY_MAX_QUEUES, &ulReceived, &uxIndex, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( INVALID_UINT32, ulReceived );
+    TEST_ASSERT_EQUAL( INVALID_UINT32, uxIndex );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, ulPlaceCount );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+
+    prvDeleteQueues();
+}
@@ -0,0 +1,369 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file queue_spsc_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../queue_utest_common.h"
+
+/* Queue includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "queue.h"
+#include "mock_fake_port.h"
+
+/* ===============================  CONSTANTS =============================== */
+
+#define SPSC_QUEUE_LENGTH    3
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/* Counts kept by td_port.c. */
+extern uint32_t ulNumEnterCriticalSection;
+extern uint32_t ulNumCallsSetInterruptMaskFromISR;
+
+/* Queue used by the xTaskCheckForTimeOut callbacks. */
+static QueueHandle_t xQueueHandleStatic = NULL;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+/* ============================= Unity Fixtures ============================= */
+
+void setUp( void )
+{
+    commonSetUp();
+    vFakePortAssertIfInterruptPriorityInvalid_Ignore();
+}
+
+void tearDown( void )
+{
+    commonTearDown();
+}
+
+void suiteSetUp()
+{
+    commonSuiteSetUp();
+}
+
+int suiteTearDown( int numFailures )
+{
+    return commonSuiteTearDown( numFailures );
+}
+
+/* ==========================  Helper functions =========================== */
+
+/* =============================  Test Cases ============================== */
+
+/**
+ * @brief Test xQueueCreateSPSCStatic with an item size of zero.
+ * @details SPSC queues must hold data, so cannot be used as semaphores.
+ * @coverage xQueueGenericCreateStatic prvInitialiseNewQueue
+ */
+void test_macro_xQueueCreateSPSCStatic_zero_item_size( void )
+{
+    StaticQueue_t queueBuffer;
+
+    EXPECT_ASSERT_BREAK( xQueueCreateSPSCStatic( SPSC_QUEUE_LENGTH, 0, NULL, &queueBuffer ) );
+}
+
+/**
+ * @brief Test xQueueCreateSPSCStatic and use the resulting queue.
+ * @coverage xQueueGenericCreateStatic prvSPSCSend prvSPSCReceive
+ */
+void test_macro_xQueueCreateSPSCStatic_send_receive( void )
+{
+    StaticQueue_t queueBuffer;
+    uint32_t queueStorage[ SPSC_QUEUE_LENGTH ];
+    uint32_t testVal = getNextMonotonicTestValue();
+    uint32_t checkVal = INVALID_UINT32;
+
+    QueueHandle_t xQueue = xQueueCreateSPSCStatic( SPSC_QUEUE_LENGTH, sizeof( uint32_t ), ( uint8_t * ) queueStorage, &queueBuffer );
+
+    TEST_ASSERT_NOT_NULL( xQueue );
+    TEST_ASSERT_EQUAL( pdPASS, xQueueSend( xQueue, &testVal, 0 ) );
+    TEST_ASSERT_EQUAL( testVal, queueStorage[ 0 ] );
+    TEST_ASSERT_EQUAL( pdPASS, xQueueReceive( xQueue, &checkVal, 0 ) );
+    TEST_ASSERT_EQUAL( testVal, checkVal );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Items are received in the order they are sent while the indexes wrap.
+ * @details The non-blocking paths must not enter a critical section when no
+ * task is blocked on the queue.
+ * @coverage prvSPSCSend prvSPSCReceive prvSPSCCopyDataToQueue prvSPSCCopyDataFromQueue
+ */
+void test_xQueueSend_xQueueReceive_spsc_fifo_wrap( void )
+{
+    QueueHandle_t xQueue = xQueueCreateSPSC( SPSC_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t ulNumCriticalSections;
+    uint32_t checkVal;
+    uint32_t i;
+
+    TEST_ASSERT_NOT_NULL( xQueue );
+
+    ulNumCriticalSections = ulNumEnterCriticalSection;
+
+    /* Enough items for both indexes to wrap several times. */
+    for( i = 0; i < ( 5 * SPSC_QUEUE_LENGTH ); i++ )
+    {
+        uint32_t testVal = getNextMonotonicTestValue();
+
+        TEST_ASSERT_EQUAL( pdPASS, xQueueSend( xQueue, &testVal, 0 ) );
+        TEST_ASSERT_EQUAL( pdPASS, xQueueSendToBack( xQueue, &testVal, 0 ) );
+
+        checkVal = INVALID_UINT32;
+        TEST_ASSERT_EQUAL( pdPASS, xQueueReceive( xQueue, &checkVal, 0 ) );
+        TEST_ASSERT_EQUAL( testVal, checkVal );
+        TEST_ASSERT_EQUAL( pdPASS, xQueueReceive( xQueue, &checkVal, 0 ) );
+        TEST_ASSERT_EQUAL( testVal, checkVal );
+    }
+
+    TEST_ASSERT_EQUAL( ulNumCriticalSections, ulNumEnterCriticalSection );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Test the status functions of a full and an empty SPSC queue.
+ * @coverage prvSPSCMessagesWaiting uxQueueMessagesWaiting uxQueueSpacesAvailable
+ * uxQueueMessagesWaitingFromISR xQueueIsQueueEmptyFromISR xQueueIsQueueFullFromISR
+ */
+void test_spsc_status_full_empty( void )
+{
+    QueueHandle_t xQueue = xQueueCreateSPSC( SPSC_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t checkVal = INVALID_UINT32;
+
+    TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+    TEST_ASSERT_EQUAL( SPSC_QUEUE_LENGTH, uxQueueSpacesAvailable( xQueue ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueIsQueueEmptyFromISR( xQueue ) );
+    TEST_ASSERT_EQUAL( errQUEUE_EMPTY, xQueueReceive( xQueue, &checkVal, 0 ) );
+
+    queue_common_add_sequential_to_queue( xQueue, SPSC_QUEUE_LENGTH );
+
+    TEST_ASSERT_EQUAL( SPSC_QUEUE_LENGTH, uxQueueMessagesWaiting( xQueue ) );
+    TEST_ASSERT_EQUAL( SPSC_QUEUE_LENGTH, uxQueueMessagesWaitingFromISR( xQueue ) );
+    TEST_ASSERT_EQUAL( 0, uxQueueSpacesAvailable( xQueue ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueIsQueueFullFromISR( xQueue ) );
+
+    uint32_t testVal = getNextMonotonicTestValue();
+    TEST_ASSERT_EQUAL( errQUEUE_FULL, xQueueSend( xQueue, &testVal, 0 ) );
+    TEST_ASSERT_EQUAL( errQUEUE_FULL, xQueueSendFromISR( xQueue, &testVal, NULL ) );
+
+    /* Partially drain the queue so the indexes no longer start at 0. */
+    TEST_ASSERT_EQUAL( pdPASS, xQueueReceive( xQueue, &checkVal, 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xQueueSend( xQueue, &testVal, 0 ) );
+    TEST_ASSERT_EQUAL( SPSC_QUEUE_LENGTH, uxQueueMessagesWaiting( xQueue ) );
+
+    /* Resetting the queue empties it. */
+    xQueueReset( xQueue );
+    TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueIsQueueEmptyFromISR( xQueue ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Operations that are not supported on an SPSC queue.
+ * @coverage xQueueGenericSend xQueueGenericSendFromISR xQueuePeek xQueuePeekFromISR xQueueAddToSet
+ */
+void test_spsc_unsupported_operations( void )
+{
+    QueueHandle_t xQueue = xQueueCreateSPSC( SPSC_QUEUE_LENGTH, sizeof( uint32_t ) );
+    QueueSetHandle_t xQueueSet = xQueueCreateSet( SPSC_QUEUE_LENGTH );
+    uint32_t testVal = getNextMonotonicTestValue();
+    uint32_t checkVal = INVALID_UINT32;
+
+    EXPECT_ASSERT_BREAK( xQueueSendToFront( xQueue, &testVal, 0 ) );
+    EXPECT_ASSERT_BREAK( xQueueSendToFrontFromISR( xQueue, &testVal, NULL ) );
+    EXPECT_ASSERT_BREAK( xQueuePeek( xQueue, &checkVal, 0 ) );
+    EXPECT_ASSERT_BREAK( xQueuePeekFromISR( xQueue, &checkVal ) );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xQueueAddToSet( xQueue, xQueueSet ) );
+
+    vQueueDelete( xQueueSet );
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Sending to an SPSC queue unblocks a higher priority waiting receiver.
+ * @coverage prvSPSCSend
+ */
+void test_xQueueSend_spsc_unblock_receiver( void )
+{
+    QueueHandle_t xQueue = xQueueCreateSPSC( SPSC_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t testVal = getNextMonotonicTestValue();
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToReceiveFromQueue( xQueue );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueSend( xQueue, &testVal, 0 ) );
+
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( pdTRUE, listLIST_IS_EMPTY( pxGetTasksWaitingToReceiveFromQueue( xQueue ) ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Receiving from an SPSC queue in an ISR unblocks a waiting sender.
+ * @coverage prvSPSCReceiveFromISR
+ */
+void test_xQueueReceiveFromISR_spsc_unblock_sender( void )
+{
+    QueueHandle_t xQueue = xQueueCreateSPSC( SPSC_QUEUE_LENGTH, sizeof( uint32_t ) );
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t checkVal = INVALID_UINT32;
+
+    queue_common_add_sequential_to_queue( xQueue, SPSC_QUEUE_LENGTH );
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToSendToQueue( xQueue );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueReceiveFromISR( xQueue, &checkVal, &xHigherPriorityTaskWoken ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xHigherPriorityTaskWoken );
+    TEST_ASSERT_EQUAL( pdTRUE, td_task_getYieldPending() );
+    TEST_ASSERT_EQUAL( 1, ulNumCallsSetInterruptMaskFromISR );
+    TEST_ASSERT_EQUAL( pdTRUE, listLIST_IS_EMPTY( pxGetTasksWaitingToSendToQueue( xQueue ) ) );
+    TEST_ASSERT_EQUAL( SPSC_QUEUE_LENGTH - 1, uxQueueMessagesWaiting( xQueue ) );
+
+    /* The sender is no longer blocked, so the next receive does not enter a
+     * critical section. */
+    TEST_ASSERT_EQUAL( pdPASS, xQueueReceiveFromISR( xQueue, &checkVal, NULL ) );
+    TEST_ASSERT_EQUAL( 1, ulNumCallsSetInterruptMaskFromISR );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Sending to a locked SPSC queue from an ISR increments the Tx lock.
+ * @coverage prvSPSCSendFromISR
+ */
+void test_xQueueSendFromISR_spsc_locked( void )
+{
+    QueueHandle_t xQueue = xQueueCreateSPSC( SPSC_QUEUE_LENGTH, sizeof( uint32_t ) );
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t testVal = getNextMonotonicTestValue();
+
+    vSetQueueTxLock( xQueue, queueLOCKED_UNMODIFIED );
+    uxTaskGetNumberOfTasks_IgnoreAndReturn( 2 );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueSendFromISR( xQueue, &testVal, &xHigherPriorityTaskWoken ) );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xHigherPriorityTaskWoken );
+    TEST_ASSERT_EQUAL( queueLOCKED_UNMODIFIED + 1, cGetQueueTxLock( xQueue ) );
+    TEST_ASSERT_EQUAL( 1, uxQueueMessagesWaiting( xQueue ) );
+
+    vSetQueueTxLock( xQueue, queueUNLOCKED );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ *  @brief Callback that sends to the queue from an ISR while the receiving
+ *  task is blocked.
+ */
+static BaseType_t spsc_xTaskCheckForTimeOutCB( TimeOut_t * const pxTimeOut,
+                                               TickType_t * const pxTicksToWait,
+                                               int cmock_num_calls )
+{
+    BaseType_t xReturnValue = td_task_xTaskCheckForTimeOutStub( pxTimeOut, pxTicksToWait, cmock_num_calls );
+
+    if( cmock_num_calls == NUM_CALLS_TO_INTERCEPT )
+    {
+        uint32_t testVal = getNextMonotonicTestValue();
+        TEST_ASSERT_EQUAL( pdPASS, xQueueSendFromISR( xQueueHandleStatic, &testVal, NULL ) );
+    }
+
+    return xReturnValue;
+}
+
+/**
+ * @brief Test a blocking receive from an SPSC queue that succeeds.
+ * @coverage prvSPSCReceive
+ */
+void test_xQueueReceive_spsc_blocking_success( void )
+{
+    QueueHandle_t xQueue = xQueueCreateSPSC( SPSC_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t checkVal = INVALID_UINT32;
+
+    xQueueHandleStatic = xQueue;
+    xTaskCheckForTimeOut_Stub( &spsc_xTaskCheckForTimeOutCB );
+    uxTaskGetNumberOfTasks_IgnoreAndReturn( 1 );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueReceive( xQueue, &checkVal, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( getLastMonotonicTestValue(), checkVal );
+    TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Test a blocking receive from an SPSC queue that times out.
+ * @coverage prvSPSCReceive
+ */
+void test_xQueueReceive_spsc_blocking_timeout( void )
+{
+    QueueHandle_t xQueue = xQueueCreateSPSC( SPSC_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t checkVal = INVALID_UINT32;
+
+    TEST_ASSERT_EQUAL( errQUEUE_EMPTY, xQueueReceive( xQueue, &checkVal, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( INVALID_UINT32, checkVal );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Test a blocking send to a full SPSC queue that times out.
+ * @coverage prvSPSCSend
+ */
+void test_xQueueSend_spsc_blocking_timeout( void )
+{
+    QueueHandle_t xQueue = xQueueCreateSPSC( SPSC_QUEUE_LENGTH, sizeof( uint32_t ) );
+    uint32_t testVal = getNextMonotonicTestValue();
+
+    queue_common_add_sequential_to_queue( xQueue, SPSC_QUEUE_LENGTH );
+
+    TEST_ASSERT_EQUAL( errQUEUE_FULL, xQueueSend( xQueue, &testVal, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( SPSC_QUEUE_LENGTH, uxQueueMessagesWaiting( xQueue ) );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vQueueDelete( xQueue );
+}
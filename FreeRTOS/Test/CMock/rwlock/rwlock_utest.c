@@ -0,0 +1,562 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file rwlock_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Reader-writer lock includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "rwlock.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "unity_memory.h"
+#include "CException.h"
+
+/* Mock includes. */
+#include "mock_task.h"
+#include "mock_fake_assert.h"
+#include "mock_fake_port.h"
+
+/* ===========================  DEFINES CONSTANTS  ========================== */
+#define RWLOCK_ASSERT_E     ( 0xAA55 )
+#define RWLOCK_BLOCKED_E    ( 0x55AA )
+
+/* Expect call to fail a configASSERT(), and stop it at that point. */
+#define EXPECT_ASSERT_BREAK( call )               \
+    do                                            \
+    {                                             \
+        CEXCEPTION_T e = CEXCEPTION_NONE;         \
+        xAbortOnAssert = true;                    \
+        Try                                       \
+        {                                         \
+            call;                                 \
+            TEST_FAIL();                          \
+        }                                         \
+        Catch( e )                                \
+        TEST_ASSERT_EQUAL( RWLOCK_ASSERT_E, e );  \
+        xAbortOnAssert = false;                   \
+    } while( 0 )
+
+/* ===========================  GLOBAL VARIABLES  =========================== */
+
+/**
+ * @brief The lock under test, and the memory that holds it.
+ */
+static RWLockHandle_t xRWLock = NULL;
+static StaticRWLock_t xRWLockBuffer;
+
+/**
+ * @brief Stand-ins for the handles of two tasks, and the task that
+ * xTaskGetCurrentTaskHandle() reports as running.
+ */
+static uint32_t ulTaskA;
+static uint32_t ulTaskB;
+#define TASK_A    ( ( TaskHandle_t ) &ulTaskA )
+#define TASK_B    ( ( TaskHandle_t ) &ulTaskB )
+static TaskHandle_t xCurrentTask = NULL;
+
+/**
+ * @brief The number of failed configASSERT() calls, and whether a failed
+ * configASSERT() throws.
+ */
+static int iAssertFailures = 0;
+static bool xAbortOnAssert = false;
+
+/**
+ * @brief List items that stand in for tasks blocked on the lock.
+ */
+static ListItem_t xBlockedReaderItem;
+static ListItem_t xBlockedWriterItem;
+
+/**
+ * @brief Results recorded by the callbacks, which run while the task under
+ * test is blocked.
+ */
+static BaseType_t xReadWhileWriterWaiting = pdPASS;
+static BaseType_t xRemoveReturn = pdFALSE;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+void * pvPortMalloc( size_t xSize )
+{
+    return unity_malloc( xSize );
+}
+
+void vPortFree( void * pv )
+{
+    unity_free( pv );
+}
+
+static void vFakeAssertStub( bool x,
+                             char * file,
+                             int line,
+                             int cmock_num_calls )
+{
+    ( void ) file;
+    ( void ) line;
+    ( void ) cmock_num_calls;
+
+    if( !x )
+    {
+        iAssertFailures++;
+
+        if( xAbortOnAssert )
+        {
+            Throw( RWLOCK_ASSERT_E );
+        }
+    }
+}
+
+static TaskHandle_t xGetCurrentTaskHandleStub( int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return xCurrentTask;
+}
+
+static TaskHandle_t xIncrementMutexHeldCountStub( int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return xCurrentTask;
+}
+
+static TaskHandle_t xIncrementWaiterMutexHeldCountStub( const List_t * const pxEventList,
+                                                        int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return listGET_OWNER_OF_HEAD_ENTRY( pxEventList );
+}
+
+static BaseType_t xRemoveFromEventListStub( const List_t * const pxEventList,
+                                            int cmock_num_calls )
+{
+    ListItem_t * pxItem = listGET_HEAD_ENTRY( pxEventList );
+
+    ( void ) cmock_num_calls;
+
+    ( void ) uxListRemove( pxItem );
+
+    return xRemoveReturn;
+}
+
+/* Task B blocks to write while task A holds the lock for reading.  A task
+ * trying to read now must wait for B, then A gives the lock. */
+static void vPlaceWriterThenGiveReadStub( List_t * const pxEventList,
+                                          const TickType_t xTicksToWait,
+                                          int cmock_num_calls )
+{
+    ( void ) xTicksToWait;
+    ( void ) cmock_num_calls;
+
+    listSET_LIST_ITEM_OWNER( &xBlockedWriterItem, TASK_B );
+    listSET_LIST_ITEM_VALUE( &xBlockedWriterItem, configMAX_PRIORITIES - 2 );
+    vListInsert( pxEventList, &xBlockedWriterItem );
+
+    xReadWhileWriterWaiting = xRWLockTakeRead( xRWLock, 0 );
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockGiveRead( xRWLock ) );
+}
+
+/* Task B blocks to read while task A holds the lock for writing, then A gives
+ * the lock. */
+static void vPlaceReaderThenGiveWriteStub( List_t * const pxEventList,
+                                           const TickType_t xTicksToWait,
+                                           int cmock_num_calls )
+{
+    ( void ) xTicksToWait;
+    ( void ) cmock_num_calls;
+
+    listSET_LIST_ITEM_OWNER( &xBlockedReaderItem, TASK_B );
+    listSET_LIST_ITEM_VALUE( &xBlockedReaderItem, configMAX_PRIORITIES - 3 );
+    vListInsert( pxEventList, &xBlockedReaderItem );
+
+    xCurrentTask = TASK_A;
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockGiveWrite( xRWLock ) );
+    xCurrentTask = TASK_B;
+}
+
+/* A task trying to read blocks behind the waiting writer.  Throwing stops the
+ * call at the point the task would be switched out. */
+static void vPlaceReaderStub( List_t * const pxEventList,
+                              const TickType_t xTicksToWait,
+                              int cmock_num_calls )
+{
+    ( void ) xTicksToWait;
+    ( void ) cmock_num_calls;
+
+    listSET_LIST_ITEM_OWNER( &xBlockedReaderItem, TASK_A );
+    listSET_LIST_ITEM_VALUE( &xBlockedReaderItem, configMAX_PRIORITIES - 1 );
+    vListInsert( pxEventList, &xBlockedReaderItem );
+
+    Throw( RWLOCK_BLOCKED_E );
+}
+
+/* Task B blocks to write while the lock is held for reading, a second reader
+ * blocks behind it, then B times out. */
+static void vPlaceWriterThenQueueReaderStub( List_t * const pxEventList,
+                                             const TickType_t xTicksToWait,
+                                             int cmock_num_calls )
+{
+    CEXCEPTION_T e = CEXCEPTION_NONE;
+
+    ( void ) xTicksToWait;
+    ( void ) cmock_num_calls;
+
+    listSET_LIST_ITEM_OWNER( &xBlockedWriterItem, TASK_B );
+    listSET_LIST_ITEM_VALUE( &xBlockedWriterItem, configMAX_PRIORITIES - 2 );
+    vListInsert( pxEventList, &xBlockedWriterItem );
+
+    vTaskPlaceOnEventList_Stub( vPlaceReaderStub );
+
+    Try
+    {
+        ( void ) xRWLockTakeRead( xRWLock, 10 );
+        TEST_FAIL();
+    }
+    Catch( e )
+    TEST_ASSERT_EQUAL( RWLOCK_BLOCKED_E, e );
+
+    /* The tick interrupt removes a task from the event list when it times
+     * out. */
+    ( void ) uxListRemove( &xBlockedWriterItem );
+}
+
+/* Task B blocks to write while task A holds the lock for writing.  Another
+ * task of priority 3 is already waiting to write. */
+static void vPlaceSecondWriterStub( List_t * const pxEventList,
+                                    const TickType_t xTicksToWait,
+                                    int cmock_num_calls )
+{
+    ( void ) xTicksToWait;
+    ( void ) cmock_num_calls;
+
+    listSET_LIST_ITEM_OWNER( &xBlockedWriterItem, NULL );
+    listSET_LIST_ITEM_VALUE( &xBlockedWriterItem, configMAX_PRIORITIES - 3 );
+    vListInsert( pxEventList, &xBlockedWriterItem );
+}
+
+/* ============================  Unity Fixtures  ============================ */
+/*! called before each testcase */
+void setUp( void )
+{
+    xRWLock = NULL;
+    xCurrentTask = TASK_A;
+    iAssertFailures = 0;
+    xAbortOnAssert = false;
+    xReadWhileWriterWaiting = pdPASS;
+    xRemoveReturn = pdFALSE;
+    vListInitialiseItem( &xBlockedReaderItem );
+    vListInitialiseItem( &xBlockedWriterItem );
+
+    vFakeAssert_StubWithCallback( vFakeAssertStub );
+    vFakePortEnterCriticalSection_Ignore();
+    vFakePortExitCriticalSection_Ignore();
+    xTaskGetSchedulerState_IgnoreAndReturn( taskSCHEDULER_RUNNING );
+    xTaskGetCurrentTaskHandle_Stub( xGetCurrentTaskHandleStub );
+    pvTaskIncrementMutexHeldCount_Stub( xIncrementMutexHeldCountStub );
+    pvTaskIncrementWaiterMutexHeldCount_Stub( xIncrementWaiterMutexHeldCountStub );
+    xTaskRemoveFromEventList_Stub( xRemoveFromEventListStub );
+
+    /* Track calls to malloc / free */
+    UnityMalloc_StartTest();
+}
+
+/*! called after each testcase */
+void tearDown( void )
+{
+    UnityMalloc_EndTest();
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ===========================  Static Functions  =========================== */
+
+static void prvCreateRWLock( void )
+{
+    xRWLock = xRWLockCreateStatic( &xRWLockBuffer );
+    TEST_ASSERT_NOT_NULL( xRWLock );
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/*!
+ * @brief validate statically creating a lock, and the state of a new lock
+ * @coverage xRWLockCreateStatic uxRWLockGetReaderCount xRWLockGetWriteHolder
+ */
+void test_xRWLockCreateStatic_Success( void )
+{
+    prvCreateRWLock();
+
+    TEST_ASSERT_EQUAL( 0, uxRWLockGetReaderCount( xRWLock ) );
+    TEST_ASSERT_NULL( xRWLockGetWriteHolder( xRWLock ) );
+    TEST_ASSERT_EQUAL( 0, iAssertFailures );
+
+    vRWLockDelete( xRWLock );
+}
+
+/*!
+ * @brief validate a lock is not created without memory to hold it
+ * @coverage xRWLockCreateStatic
+ */
+void test_xRWLockCreateStatic_NullBuffer( void )
+{
+    TEST_ASSERT_NULL( xRWLockCreateStatic( NULL ) );
+    TEST_ASSERT_EQUAL( 1, iAssertFailures );
+}
+
+/*!
+ * @brief validate dynamically creating a lock, and that deleting it frees the
+ * memory
+ * @coverage xRWLockCreate vRWLockDelete
+ */
+void test_xRWLockCreate_Success( void )
+{
+    xRWLock = xRWLockCreate();
+
+    TEST_ASSERT_NOT_NULL( xRWLock );
+    TEST_ASSERT_EQUAL( 0, uxRWLockGetReaderCount( xRWLock ) );
+
+    /* UnityMalloc_EndTest() fails the test if the lock is not freed. */
+    vRWLockDelete( xRWLock );
+}
+
+/*!
+ * @brief validate a lock cannot be deleted while it is held
+ * @coverage vRWLockDelete
+ */
+void test_vRWLockDelete_WhileHeld( void )
+{
+    prvCreateRWLock();
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeRead( xRWLock, 0 ) );
+
+    EXPECT_ASSERT_BREAK( vRWLockDelete( xRWLock ) );
+}
+
+/*!
+ * @brief validate any number of tasks can hold the lock for reading, and that
+ * it cannot be given more times than it was taken
+ * @coverage xRWLockTakeRead xRWLockGiveRead
+ */
+void test_xRWLockTakeRead_Shared( void )
+{
+    prvCreateRWLock();
+
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeRead( xRWLock, 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeRead( xRWLock, 0 ) );
+    TEST_ASSERT_EQUAL( 2, uxRWLockGetReaderCount( xRWLock ) );
+
+    /* The lock cannot be taken for writing while it is held for reading. */
+    TEST_ASSERT_EQUAL( pdFAIL, xRWLockTakeWrite( xRWLock, 0 ) );
+
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockGiveRead( xRWLock ) );
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockGiveRead( xRWLock ) );
+    TEST_ASSERT_EQUAL( pdFAIL, xRWLockGiveRead( xRWLock ) );
+    TEST_ASSERT_EQUAL( 0, uxRWLockGetReaderCount( xRWLock ) );
+}
+
+/*!
+ * @brief validate a lock held for writing excludes readers and other writers,
+ * and can only be given by the task that holds it
+ * @coverage xRWLockTakeWrite xRWLockGiveWrite
+ */
+void test_xRWLockTakeWrite_Exclusive( void )
+{
+    prvCreateRWLock();
+
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeWrite( xRWLock, 0 ) );
+    TEST_ASSERT_EQUAL_PTR( TASK_A, xRWLockGetWriteHolder( xRWLock ) );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xRWLockTakeRead( xRWLock, 0 ) );
+
+    xCurrentTask = TASK_B;
+    TEST_ASSERT_EQUAL( pdFAIL, xRWLockTakeWrite( xRWLock, 0 ) );
+    TEST_ASSERT_EQUAL( pdFAIL, xRWLockGiveWrite( xRWLock ) );
+
+    xCurrentTask = TASK_A;
+    xTaskPriorityDisinherit_ExpectAndReturn( TASK_A, pdFALSE );
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockGiveWrite( xRWLock ) );
+    TEST_ASSERT_NULL( xRWLockGetWriteHolder( xRWLock ) );
+}
+
+/*!
+ * @brief validate a task cannot take the write lock it already holds
+ * @coverage xRWLockTakeWrite
+ */
+void test_xRWLockTakeWrite_Recursive( void )
+{
+    prvCreateRWLock();
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeWrite( xRWLock, 0 ) );
+
+    EXPECT_ASSERT_BREAK( xRWLockTakeWrite( xRWLock, 0 ) );
+}
+
+/*!
+ * @brief validate giving the write lock yields if a priority was disinherited
+ * @coverage xRWLockGiveWrite
+ */
+void test_xRWLockGiveWrite_Disinherit( void )
+{
+    prvCreateRWLock();
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeWrite( xRWLock, 0 ) );
+
+    xTaskPriorityDisinherit_ExpectAndReturn( TASK_A, pdTRUE );
+    vFakePortYieldWithinAPI_Expect();
+
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockGiveWrite( xRWLock ) );
+}
+
+/*!
+ * @brief validate a task waiting to write keeps new readers out, and that the
+ * last reader to give the lock passes it straight to that task
+ * @coverage xRWLockTakeWrite xRWLockTakeRead xRWLockGiveRead
+ */
+void test_xRWLockTakeWrite_HandOffFromReader( void )
+{
+    prvCreateRWLock();
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeRead( xRWLock, 0 ) );
+
+    xCurrentTask = TASK_B;
+    vTaskInternalSetTimeOutState_ExpectAnyArgs();
+    vTaskPlaceOnEventList_Stub( vPlaceWriterThenGiveReadStub );
+    vFakePortYieldWithinAPI_Expect();
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeWrite( xRWLock, 10 ) );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xReadWhileWriterWaiting );
+    TEST_ASSERT_EQUAL_PTR( TASK_B, xRWLockGetWriteHolder( xRWLock ) );
+    TEST_ASSERT_EQUAL( 0, uxRWLockGetReaderCount( xRWLock ) );
+    TEST_ASSERT_NULL( listLIST_ITEM_CONTAINER( &xBlockedWriterItem ) );
+}
+
+/*!
+ * @brief validate a task that blocks to read on a lock held for writing raises
+ * the priority of the writer, and takes the lock once the writer gives it
+ * @coverage xRWLockTakeRead xRWLockGiveWrite
+ */
+void test_xRWLockTakeRead_UnblockedByWriter( void )
+{
+    prvCreateRWLock();
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeWrite( xRWLock, 0 ) );
+
+    xCurrentTask = TASK_B;
+    xRemoveReturn = pdTRUE;
+    vTaskInternalSetTimeOutState_ExpectAnyArgs();
+    xTaskPriorityInherit_ExpectAndReturn( TASK_A, pdTRUE );
+    vTaskPlaceOnEventList_Stub( vPlaceReaderThenGiveWriteStub );
+    xTaskPriorityDisinherit_ExpectAndReturn( TASK_A, pdTRUE );
+    vFakePortYieldWithinAPI_Expect(); /* Writer yields to the reader. */
+    vFakePortYieldWithinAPI_Expect(); /* Reader blocks. */
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeRead( xRWLock, 10 ) );
+
+    TEST_ASSERT_EQUAL( 1, uxRWLockGetReaderCount( xRWLock ) );
+    TEST_ASSERT_NULL( xRWLockGetWriteHolder( xRWLock ) );
+    TEST_ASSERT_NULL( listLIST_ITEM_CONTAINER( &xBlockedReaderItem ) );
+}
+
+/*!
+ * @brief validate a writer that times out undoes the priority it gave the
+ * holder, down to the priority of the highest priority task still waiting
+ * @coverage xRWLockTakeWrite
+ */
+void test_xRWLockTakeWrite_TimeoutDisinherits( void )
+{
+    prvCreateRWLock();
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeWrite( xRWLock, 0 ) );
+
+    xCurrentTask = TASK_B;
+    vTaskInternalSetTimeOutState_ExpectAnyArgs();
+    xTaskPriorityInherit_ExpectAndReturn( TASK_A, pdTRUE );
+    vTaskPlaceOnEventList_Stub( vPlaceSecondWriterStub );
+    vFakePortYieldWithinAPI_Expect();
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdTRUE );
+    vTaskPriorityDisinheritAfterTimeout_Expect( TASK_A, 3 );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xRWLockTakeWrite( xRWLock, 10 ) );
+    TEST_ASSERT_EQUAL_PTR( TASK_A, xRWLockGetWriteHolder( xRWLock ) );
+}
+
+/*!
+ * @brief validate readers that blocked behind a waiting writer are unblocked
+ * when that writer times out
+ * @coverage xRWLockTakeWrite xRWLockTakeRead
+ */
+void test_xRWLockTakeWrite_TimeoutUnblocksReaders( void )
+{
+    prvCreateRWLock();
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeRead( xRWLock, 0 ) );
+
+    xCurrentTask = TASK_B;
+    xRemoveReturn = pdTRUE;
+    vTaskInternalSetTimeOutState_ExpectAnyArgs(); /* Writer. */
+    vTaskPlaceOnEventList_Stub( vPlaceWriterThenQueueReaderStub );
+    vTaskInternalSetTimeOutState_ExpectAnyArgs(); /* Reader. */
+    vFakePortYieldWithinAPI_Expect();             /* Writer blocks. */
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdTRUE );
+    vFakePortYieldWithinAPI_Expect(); /* Yield to the unblocked reader. */
+
+    TEST_ASSERT_EQUAL( pdFAIL, xRWLockTakeWrite( xRWLock, 10 ) );
+
+    TEST_ASSERT_NULL( listLIST_ITEM_CONTAINER( &xBlockedReaderItem ) );
+    TEST_ASSERT_EQUAL( 1, uxRWLockGetReaderCount( xRWLock ) );
+}
+
+/*!
+ * @brief validate a reader times out while the lock is held for writing
+ * @coverage xRWLockTakeRead
+ */
+void test_xRWLockTakeRead_Timeout( void )
+{
+    prvCreateRWLock();
+    TEST_ASSERT_EQUAL( pdPASS, xRWLockTakeWrite( xRWLock, 0 ) );
+
+    xCurrentTask = TASK_B;
+    vTaskInternalSetTimeOutState_ExpectAnyArgs();
+    xTaskPriorityInherit_ExpectAndReturn( TASK_A, pdFALSE );
+    vTaskPlaceOnEventList_ExpectAnyArgs();
+    vFakePortYieldWithinAPI_Expect();
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdTRUE );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xRWLockTakeRead( xRWLock, 10 ) );
+    TEST_ASSERT_EQUAL( 0, uxRWLockGetReaderCount( xRWLock ) );
+}
@@ -28,6 +28,7 @@
 /* C runtime includes. */
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 
 /* Stream Buffer includes */
 #include "FreeRTOS.h"
@@ -375,6 +376,45 @@ static BaseType_t receiverTaskNotificationCallback( TaskHandle_t xTaskToNotify,
     return pdTRUE;
 }
 
+static BaseType_t streamBufferCommitCallback( UBaseType_t uxIndexToWaitOn,
+                                              uint32_t ulBitsToClearOnEntry,
+                                              uint32_t ulBitsToClearOnExit,
+                                              uint32_t * pulNotificationValue,
+                                              TickType_t xTicksToWait,
+                                              int cmock_num_calls )
+{
+    void * pvSpace = NULL;
+    size_t space = 0, committed = 0;
+
+    /* Write trigger level bytes in place to wake up the receiver task. */
+    space = xStreamBufferReserve( xStreamBuffer, &pvSpace );
+    TEST_ASSERT_GREATER_OR_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, space );
+    memset( pvSpace, 0xA5, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    committed = xStreamBufferCommit( xStreamBuffer, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, committed );
+    return pdTRUE;
+}
+
+static BaseType_t streamBufferConsumeFromISRCallback( UBaseType_t uxIndexToWaitOn,
+                                                      uint32_t ulBitsToClearOnEntry,
+                                                      uint32_t ulBitsToClearOnExit,
+                                                      uint32_t * pulNotificationValue,
+                                                      TickType_t xTicksToWait,
+                                                      int cmock_num_calls )
+{
+    void * pvData = NULL;
+    size_t available = 0, consumed = 0;
+    BaseType_t senderTaskWokenFromISR = pdFALSE;
+
+    /* Consume all the bytes in place to wake up the sender task. */
+    available = xStreamBufferPeekContiguous( xStreamBuffer, &pvData );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, available );
+    consumed = xStreamBufferConsumeFromISR( xStreamBuffer, available, &senderTaskWokenFromISR );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, consumed );
+    TEST_ASSERT_EQUAL( pdTRUE, senderTaskWokenFromISR );
+    return pdTRUE;
+}
+
 /*******************************************************************************
  * Unity fixtures
  ******************************************************************************/
@@ -1455,3 +1495,249 @@ void test_xStreamBufferSend_WrapOver( void )
 
     vStreamBufferDelete( xStreamBuffer );
 }
+
+/**
+ * @brief Validates that bytes written in place at the reserved space are received after they are committed.
+ */
+void test_xStreamBufferReserve_commit_success( void )
+{
+    uint8_t dataReceived[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+    uint8_t expected[ TEST_STREAM_BUFFER_SIZE ];
+    void * pvSpace = NULL;
+    size_t space = 0, committed = 0, received = 0;
+
+    vTaskSetTimeOutState_Ignore();
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    memset( expected, 0x5A, sizeof( expected ) );
+
+    /* Create a stream buffer of the default test sample size. */
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    /* The whole of an empty buffer can be reserved. */
+    space = xStreamBufferReserve( xStreamBuffer, &pvSpace );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, space );
+    TEST_ASSERT_NOT_NULL( pvSpace );
+
+    /* Reserved bytes are not visible to the reader until they are committed. */
+    memset( pvSpace, 0x5A, 10U );
+    TEST_ASSERT_EQUAL( 0, xStreamBufferBytesAvailable( xStreamBuffer ) );
+
+    /* Committing nothing has no effect. */
+    committed = xStreamBufferCommit( xStreamBuffer, 0 );
+    TEST_ASSERT_EQUAL( 0, committed );
+    TEST_ASSERT_EQUAL( 0, xStreamBufferBytesAvailable( xStreamBuffer ) );
+
+    committed = xStreamBufferCommit( xStreamBuffer, 10U );
+    TEST_ASSERT_EQUAL( 10U, committed );
+    TEST_ASSERT_EQUAL( 10U, xStreamBufferBytesAvailable( xStreamBuffer ) );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE - 10U, xStreamBufferSpacesAvailable( xStreamBuffer ) );
+
+    received = xStreamBufferReceive( xStreamBuffer, dataReceived, TEST_STREAM_BUFFER_SIZE, 0 );
+    TEST_ASSERT_EQUAL( 10U, received );
+    TEST_ASSERT_EQUAL_HEX8_ARRAY( expected, dataReceived, received );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that the reserved space stops at the end of the storage area and then restarts at its beginning.
+ */
+void test_xStreamBufferReserve_WrapOver( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+    uint8_t dataReceived[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+    void * pvFirst = NULL, * pvSecond = NULL;
+    size_t first = 0, second = 0, received = 0, x;
+
+    vTaskSetTimeOutState_Ignore();
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    for( x = 0; x < TEST_STREAM_BUFFER_SIZE; x++ )
+    {
+        data[ x ] = ( uint8_t ) x;
+    }
+
+    /* Create a stream buffer of the default test sample size. */
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    /* Move the head and tail close to the end of the storage area. */
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE - 4U, xStreamBufferSend( xStreamBuffer, data, TEST_STREAM_BUFFER_SIZE - 4U, 0 ) );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE - 4U, xStreamBufferReceive( xStreamBuffer, dataReceived, TEST_STREAM_BUFFER_SIZE, 0 ) );
+
+    /* Only the space up to the end of the storage area is handed out, although the whole buffer is free. */
+    first = xStreamBufferReserve( xStreamBuffer, &pvFirst );
+    TEST_ASSERT_LESS_THAN( TEST_STREAM_BUFFER_SIZE, first );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSpacesAvailable( xStreamBuffer ) );
+    memcpy( pvFirst, data, first );
+    TEST_ASSERT_EQUAL( first, xStreamBufferCommit( xStreamBuffer, first ) );
+
+    /* The rest of the space starts at the beginning of the storage area. */
+    second = xStreamBufferReserve( xStreamBuffer, &pvSecond );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE - first, second );
+    TEST_ASSERT_TRUE( ( uint8_t * ) pvSecond < ( uint8_t * ) pvFirst );
+    memcpy( pvSecond, &( data[ first ] ), second );
+    TEST_ASSERT_EQUAL( second, xStreamBufferCommit( xStreamBuffer, second ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xStreamBufferIsFull( xStreamBuffer ) );
+
+    /* A full buffer has nothing to reserve. */
+    TEST_ASSERT_EQUAL( 0, xStreamBufferReserve( xStreamBuffer, &pvSecond ) );
+    TEST_ASSERT_NULL( pvSecond );
+
+    /* The bytes written in place are received in order across the wrap. */
+    received = xStreamBufferReceive( xStreamBuffer, dataReceived, TEST_STREAM_BUFFER_SIZE, 0 );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, received );
+    TEST_ASSERT_EQUAL_HEX8_ARRAY( data, dataReceived, TEST_STREAM_BUFFER_SIZE );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that data can be read in place and then consumed, including across the end of the storage area.
+ */
+void test_xStreamBufferPeekContiguous_consume_success( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+    uint8_t dataReceived[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+    void * pvData = ( void * ) data;
+    size_t available = 0, consumed = 0, x;
+
+    vTaskSetTimeOutState_Ignore();
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    for( x = 0; x < TEST_STREAM_BUFFER_SIZE; x++ )
+    {
+        data[ x ] = ( uint8_t ) x;
+    }
+
+    /* Create a stream buffer of the default test sample size. */
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    /* Nothing to read in an empty buffer. */
+    available = xStreamBufferPeekContiguous( xStreamBuffer, &pvData );
+    TEST_ASSERT_EQUAL( 0, available );
+    TEST_ASSERT_NULL( pvData );
+    TEST_ASSERT_EQUAL( 0, xStreamBufferConsume( xStreamBuffer, 1U ) );
+
+    /* Peeking does not remove the data. */
+    TEST_ASSERT_EQUAL( 40U, xStreamBufferSend( xStreamBuffer, data, 40U, 0 ) );
+    available = xStreamBufferPeekContiguous( xStreamBuffer, &pvData );
+    TEST_ASSERT_EQUAL( 40U, available );
+    TEST_ASSERT_EQUAL_HEX8_ARRAY( data, pvData, available );
+    TEST_ASSERT_EQUAL( 40U, xStreamBufferBytesAvailable( xStreamBuffer ) );
+
+    /* Part of the data can be consumed. */
+    consumed = xStreamBufferConsume( xStreamBuffer, 16U );
+    TEST_ASSERT_EQUAL( 16U, consumed );
+    available = xStreamBufferPeekContiguous( xStreamBuffer, &pvData );
+    TEST_ASSERT_EQUAL( 24U, available );
+    TEST_ASSERT_EQUAL_HEX8_ARRAY( &( data[ 16 ] ), pvData, available );
+
+    /* Consuming more than is available only consumes what is there. */
+    consumed = xStreamBufferConsume( xStreamBuffer, TEST_STREAM_BUFFER_SIZE );
+    TEST_ASSERT_EQUAL( 24U, consumed );
+    TEST_ASSERT_EQUAL( pdTRUE, xStreamBufferIsEmpty( xStreamBuffer ) );
+
+    /* Data written across the end of the storage area is peeked in two parts. */
+    TEST_ASSERT_EQUAL( 20U, xStreamBufferSend( xStreamBuffer, data, 20U, 0 ) );
+    TEST_ASSERT_EQUAL( 20U, xStreamBufferReceive( xStreamBuffer, dataReceived, 20U, 0 ) );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, TEST_STREAM_BUFFER_SIZE, 0 ) );
+    available = xStreamBufferPeekContiguous( xStreamBuffer, &pvData );
+    TEST_ASSERT_LESS_THAN( TEST_STREAM_BUFFER_SIZE, available );
+    TEST_ASSERT_EQUAL_HEX8_ARRAY( data, pvData, available );
+    TEST_ASSERT_EQUAL( available, xStreamBufferConsume( xStreamBuffer, available ) );
+    consumed = available;
+    available = xStreamBufferPeekContiguous( xStreamBuffer, &pvData );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE - consumed, available );
+    TEST_ASSERT_EQUAL_HEX8_ARRAY( &( data[ consumed ] ), pvData, available );
+
+    /* Bytes can be consumed across the end of the storage area in one call. */
+    TEST_ASSERT_EQUAL( available, xStreamBufferConsume( xStreamBuffer, available ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xStreamBufferIsEmpty( xStreamBuffer ) );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that committing bytes written in place wakes up a task waiting to receive.
+ */
+void test_xStreamBufferCommit_unblocks_receiver( void )
+{
+    uint8_t dataReceived[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+    size_t received = 0;
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+    xTaskGenericNotifyWait_StubWithCallback( streamBufferCommitCallback );
+    xTaskGenericNotify_StubWithCallback( receiverTaskNotificationCallback );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    /* Create a stream buffer of the default test sample size. */
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    /* The receiver blocks on the empty buffer and is woken by the commit. */
+    received = xStreamBufferReceive( xStreamBuffer, dataReceived, TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_WAIT_TICKS );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, received );
+    TEST_ASSERT_EQUAL( 1, receiverTaskWoken );
+    TEST_ASSERT_EACH_EQUAL_HEX8( 0xA5, dataReceived, received );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that consuming bytes from an ISR wakes up a task waiting to send.
+ */
+void test_xStreamBufferConsumeFromISR_unblocks_sender( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+    size_t sent = 0;
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( senderTask );
+    xTaskGenericNotifyWait_StubWithCallback( streamBufferConsumeFromISRCallback );
+    xTaskGenericNotifyFromISR_StubWithCallback( senderTaskNotificationFromISRCallback );
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdFALSE );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    /* Create a stream buffer of the default test sample size. */
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, TEST_STREAM_BUFFER_SIZE, 0 ) );
+
+    /* The sender blocks on the full buffer and is woken by the consume. */
+    sent = xStreamBufferSend( xStreamBuffer, data, TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_WAIT_TICKS );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, sent );
+    TEST_ASSERT_EQUAL( 1, senderTaskWoken );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that committing more bytes than were reserved fails an assertion.
+ */
+void test_xStreamBufferCommit_more_than_reserved( void )
+{
+    void * pvSpace = NULL;
+
+    /* Create a stream buffer of the default test sample size. */
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferReserve( xStreamBuffer, &pvSpace ) );
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferCommit( xStreamBuffer, TEST_STREAM_BUFFER_SIZE + 1U ) );
+    validate_and_clear_assertions();
+
+    vStreamBufferDelete( xStreamBuffer );
+}
@@ -107,6 +107,32 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        volatile BaseType_t xTaskRunState;
+    #endif
+
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        UBaseType_t uxCoreAffinityMask;
+    #endif
+
+    #if ( configUSE_TASK_PERF_COUNTERS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulPerfRunTime;
+        configRUN_TIME_COUNTER_TYPE ulPerfReadyTime;
+        configRUN_TIME_COUNTER_TYPE ulPerfBlockedTime;
+        configRUN_TIME_COUNTER_TYPE ulPerfStateTime;
+        UBaseType_t uxPerfSwitchesIn;
+        volatile UBaseType_t uxPerfSequence;
+        uint8_t ucPerfState;
+    #endif
+
+    #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+        TaskHandle_t * pxBlockingMutexHolder;
+    #endif
+
+    #if ( configUSE_STACK_HIGH_WATER_TRACKING == 1 )
+        StackType_t * pxStackHighWater;
+    #endif
 } tskTCB;
 
 
@@ -0,0 +1,660 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*! @file tasks_smp_one_priority_utest.c */
+
+/* The scheduler of a two core build with configRUN_MULTIPLE_PRIORITIES set to
+ * 0, so only tasks of the top ready priority run and any other core runs its
+ * idle task.  The port layer and the list functions are stubbed as in
+ * tasks_smp_utest.c. */
+
+/* Tasks includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "task.h"
+
+#include "mock_list.h"
+#include "mock_list_macros.h"
+#include "mock_timers.h"
+#include "mock_portable.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "global_vars.h"
+
+/* C runtime includes. */
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Values of the xTaskRunState member of the TCB, as defined in tasks.c. */
+#define TASK_NOT_RUNNING           ( ( BaseType_t ) -1 )
+#define TASK_SCHEDULED_TO_YIELD    ( ( BaseType_t ) -2 )
+
+/* tcb[ 0 ] and tcb[ 1 ] are the idle tasks of core 0 and core 1. */
+#define IDLE_TASK_0                0U
+#define IDLE_TASK_1                1U
+#define BOTH_CORES                 ( ( UBaseType_t ) 0x03U )
+#define CORE_0_ONLY                ( ( UBaseType_t ) 0x01U )
+#define CORE_1_ONLY                ( ( UBaseType_t ) 0x02U )
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+extern TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ];
+extern List_t pxReadyTasksLists[ configMAX_PRIORITIES ];
+extern volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ];
+extern TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ];
+
+extern volatile UBaseType_t uxTopReadyPriority;
+extern volatile BaseType_t xSchedulerRunning;
+extern volatile UBaseType_t uxSchedulerSuspended;
+
+/* =========================  EXTERN FUNCTIONS  ============================ */
+extern void prvInitialiseTaskLists( void );
+extern void prvSelectHighestPriorityTask( BaseType_t xCoreID );
+extern void prvYieldForTask( const TCB_t * pxTCB );
+extern void prvYieldCore( BaseType_t xCoreID );
+extern void prvCheckForRunStateChange( void );
+
+/* ===========================  GLOBAL VARIABLES  =========================== */
+static TCB_t tcb[ 6 ];
+static UBaseType_t critical_section_counter = 0;
+static BaseType_t core_id = 0;
+static UBaseType_t yield_core_mask = 0;
+static int task_lock_count = 0;
+static int isr_lock_count = 0;
+static TCB_t * yield_on_enable_interrupts = NULL;
+static bool vTaskDeletePre_called = false;
+static bool getIddleTaskMemory_called = false;
+static bool vApplicationTickHook_called = false;
+static bool port_yield_called = false;
+static bool port_enable_interrupts_called = false;
+static bool port_disable_interrupts_called = false;
+static bool port_yield_within_api_called = false;
+static bool port_setup_tcb_called = false;
+static bool portClear_Interrupt_called = false;
+static bool portSet_Interrupt_called = false;
+static bool portClear_Interrupt_from_isr_called = false;
+static bool portSet_Interrupt_from_isr_called = false;
+static bool port_invalid_interrupt_called = false;
+static bool vApplicationStackOverflowHook_called = false;
+static bool port_allocate_secure_context_called = false;
+static bool port_assert_if_in_isr_called = false;
+
+/* ============================  HOOK FUNCTIONS  ============================ */
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    char cMessage[ 64 ];
+
+    ( void ) snprintf( cMessage, sizeof( cMessage ), "configASSERT failed at line %lu", ulLine );
+    TEST_FAIL_MESSAGE( cMessage );
+}
+
+BaseType_t xFakePortGetCoreID( void )
+{
+    return core_id;
+}
+
+void vFakePortYieldCore( BaseType_t xCoreID )
+{
+    HOOK_DIAG();
+    TEST_ASSERT_NOT_EQUAL( core_id, xCoreID );
+    yield_core_mask |= ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID );
+}
+
+void vFakePortGetTaskLock( void )
+{
+    task_lock_count++;
+}
+
+void vFakePortReleaseTaskLock( void )
+{
+    task_lock_count--;
+}
+
+void vFakePortGetISRLock( void )
+{
+    isr_lock_count++;
+}
+
+void vFakePortReleaseISRLock( void )
+{
+    isr_lock_count--;
+}
+
+UBaseType_t uxFakePortGetCriticalNesting( void )
+{
+    return critical_section_counter;
+}
+
+void vFakePortSetCriticalNesting( UBaseType_t uxCriticalNesting )
+{
+    critical_section_counter = uxCriticalNesting;
+}
+
+void vFakePortAssertIfISR( void )
+{
+    port_assert_if_in_isr_called = true;
+    HOOK_DIAG();
+}
+
+void port_allocate_secure_context( BaseType_t stackSize )
+{
+    HOOK_DIAG();
+    port_allocate_secure_context_called = true;
+}
+
+void vApplicationIdleHook( void )
+{
+    HOOK_DIAG();
+}
+
+void vApplicationMallocFailedHook( void )
+{
+    HOOK_DIAG();
+}
+
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    uint32_t * pulIdleTaskStackSize )
+{
+    HOOK_DIAG();
+    *ppxIdleTaskTCBBuffer = NULL;
+    *ppxIdleTaskStackBuffer = NULL;
+    *pulIdleTaskStackSize = 0;
+    getIddleTaskMemory_called = true;
+}
+
+void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                           StackType_t ** ppxIdleTaskStackBuffer,
+                                           uint32_t * pulIdleTaskStackSize,
+                                           BaseType_t xPassiveIdleTaskIndex )
+{
+    HOOK_DIAG();
+    *ppxIdleTaskTCBBuffer = NULL;
+    *ppxIdleTaskStackBuffer = NULL;
+    *pulIdleTaskStackSize = 0;
+    getIddleTaskMemory_called = true;
+}
+
+void vConfigureTimerForRunTimeStats( void )
+{
+    HOOK_DIAG();
+}
+
+long unsigned int ulGetRunTimeCounterValue( void )
+{
+    HOOK_DIAG();
+    return 3;
+}
+
+void vApplicationTickHook()
+{
+    HOOK_DIAG();
+    vApplicationTickHook_called = true;
+}
+
+void vPortCurrentTaskDying( void * pvTaskToDelete,
+                            volatile BaseType_t * pxPendYield )
+{
+    HOOK_DIAG();
+    vTaskDeletePre_called = true;
+}
+
+void vFakePortEnterCriticalSection( void )
+{
+    HOOK_DIAG();
+    critical_section_counter++;
+}
+
+void vFakePortExitCriticalSection( void )
+{
+    HOOK_DIAG();
+    critical_section_counter--;
+}
+
+void vFakePortYieldWithinAPI()
+{
+    HOOK_DIAG();
+    port_yield_within_api_called = true;
+}
+
+void vFakePortYieldFromISR()
+{
+    HOOK_DIAG();
+}
+
+void vFakePortDisableInterrupts()
+{
+    port_disable_interrupts_called = true;
+    HOOK_DIAG();
+}
+
+/* Enabling interrupts is when a yield requested by another core is taken. */
+void vFakePortEnableInterrupts()
+{
+    port_enable_interrupts_called = true;
+    HOOK_DIAG();
+
+    if( yield_on_enable_interrupts != NULL )
+    {
+        yield_on_enable_interrupts->xTaskRunState = core_id;
+        yield_on_enable_interrupts = NULL;
+    }
+}
+
+void vFakePortYield()
+{
+    HOOK_DIAG();
+    port_yield_called = true;
+}
+
+void portSetupTCB_CB( void * tcb )
+{
+    HOOK_DIAG();
+    port_setup_tcb_called = true;
+}
+
+void vFakePortClearInterruptMask( UBaseType_t bt )
+{
+    HOOK_DIAG();
+    portClear_Interrupt_called = true;
+}
+
+UBaseType_t ulFakePortSetInterruptMask( void )
+{
+    HOOK_DIAG();
+    portSet_Interrupt_called = true;
+    return 1;
+}
+
+void vFakePortClearInterruptMaskFromISR( UBaseType_t bt )
+{
+    HOOK_DIAG();
+    portClear_Interrupt_from_isr_called = true;
+}
+
+UBaseType_t ulFakePortSetInterruptMaskFromISR( void )
+{
+    HOOK_DIAG();
+    portSet_Interrupt_from_isr_called = true;
+    return 1;
+}
+
+void vFakePortAssertIfInterruptPriorityInvalid( void )
+{
+    HOOK_DIAG();
+    port_invalid_interrupt_called = true;
+}
+
+void vApplicationStackOverflowHook( TaskHandle_t xTask,
+                                    char * stack )
+{
+    HOOK_DIAG();
+    vApplicationStackOverflowHook_called = true;
+}
+
+/* ===============================  LIST STUBS  ============================= */
+static void vListInitialise_Stub_Impl( List_t * const pxList,
+                                       int cmock_num_calls )
+{
+    pxList->pxIndex = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.xItemValue = portMAX_DELAY;
+    pxList->xListEnd.pxNext = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.pxPrevious = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
+}
+
+static void vListInsertEnd_Stub_Impl( List_t * const pxList,
+                                      ListItem_t * const pxNewListItem,
+                                      int cmock_num_calls )
+{
+    ListItem_t * const pxIndex = pxList->pxIndex;
+
+    pxNewListItem->pxNext = pxIndex;
+    pxNewListItem->pxPrevious = pxIndex->pxPrevious;
+    pxIndex->pxPrevious->pxNext = pxNewListItem;
+    pxIndex->pxPrevious = pxNewListItem;
+    pxNewListItem->pxContainer = pxList;
+    ( pxList->uxNumberOfItems )++;
+}
+
+static UBaseType_t uxListRemove_Stub_Impl( ListItem_t * const pxItemToRemove,
+                                           int cmock_num_calls )
+{
+    List_t * const pxList = pxItemToRemove->pxContainer;
+
+    pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
+    pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+
+    if( pxList->pxIndex == pxItemToRemove )
+    {
+        pxList->pxIndex = pxItemToRemove->pxPrevious;
+    }
+
+    pxItemToRemove->pxContainer = NULL;
+    ( pxList->uxNumberOfItems )--;
+
+    return pxList->uxNumberOfItems;
+}
+
+static void listINSERT_END_Stub_Impl( List_t * pxList,
+                                      ListItem_t * pxNewListItem,
+                                      int cmock_num_calls )
+{
+    vListInsertEnd_Stub_Impl( pxList, pxNewListItem, cmock_num_calls );
+}
+
+static void listREMOVE_ITEM_Stub_Impl( ListItem_t * pxItemToRemove,
+                                       int cmock_num_calls )
+{
+    ( void ) uxListRemove_Stub_Impl( pxItemToRemove, cmock_num_calls );
+}
+
+static BaseType_t listLIST_IS_EMPTY_Stub_Impl( const List_t * pxList,
+                                               int cmock_num_calls )
+{
+    return ( pxList->uxNumberOfItems == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+}
+
+static BaseType_t listIS_CONTAINED_WITHIN_Stub_Impl( List_t * pxList,
+                                                     const ListItem_t * pxListItem,
+                                                     int cmock_num_calls )
+{
+    return ( pxListItem->pxContainer == pxList ) ? pdTRUE : pdFALSE;
+}
+
+static TCB_t * listGET_LIST_ITEM_OWNER_Stub_Impl( ListItem_t * pxListItem,
+                                                  int cmock_num_calls )
+{
+    return ( TCB_t * ) pxListItem->pvOwner;
+}
+
+static TickType_t listGET_LIST_ITEM_VALUE_Stub_Impl( ListItem_t * pxListItem,
+                                                     int cmock_num_calls )
+{
+    return pxListItem->xItemValue;
+}
+
+static void listSET_LIST_ITEM_VALUE_Stub_Impl( ListItem_t * pxListItem,
+                                               TickType_t xValue,
+                                               int cmock_num_calls )
+{
+    pxListItem->xItemValue = xValue;
+}
+
+/* ============================  Static Functions  ========================== */
+
+/* Make tcb[ uxTask ] a ready task of priority uxPriority that may run on the
+ * cores in uxAffinity. */
+static void create_task( UBaseType_t uxTask,
+                         UBaseType_t uxPriority,
+                         UBaseType_t uxAffinity )
+{
+    TCB_t * pxTCB = &tcb[ uxTask ];
+
+    pxTCB->uxPriority = uxPriority;
+    pxTCB->uxBasePriority = uxPriority;
+    pxTCB->uxCoreAffinityMask = uxAffinity;
+    pxTCB->xTaskRunState = TASK_NOT_RUNNING;
+    pxTCB->xStateListItem.pvOwner = pxTCB;
+    pxTCB->xEventListItem.pvOwner = pxTCB;
+    vListInsertEnd_Stub_Impl( &pxReadyTasksLists[ uxPriority ], &( pxTCB->xStateListItem ), 0 );
+
+    if( uxPriority > uxTopReadyPriority )
+    {
+        uxTopReadyPriority = uxPriority;
+    }
+}
+
+/* Make tcb[ uxTask ] the task running on core xCoreID. */
+static void run_task( UBaseType_t uxTask,
+                      BaseType_t xCoreID )
+{
+    pxCurrentTCBs[ xCoreID ]->xTaskRunState = TASK_NOT_RUNNING;
+    tcb[ uxTask ].xTaskRunState = xCoreID;
+    pxCurrentTCBs[ xCoreID ] = &tcb[ uxTask ];
+}
+
+/* ============================  Unity Fixtures  ============================ */
+/*! called before each testcase */
+void setUp( void )
+{
+    RESET_ALL_HOOKS();
+
+    vListInitialise_Stub( vListInitialise_Stub_Impl );
+    vListInsertEnd_Stub( vListInsertEnd_Stub_Impl );
+    uxListRemove_Stub( uxListRemove_Stub_Impl );
+    listINSERT_END_Stub( listINSERT_END_Stub_Impl );
+    listREMOVE_ITEM_Stub( listREMOVE_ITEM_Stub_Impl );
+    listLIST_IS_EMPTY_Stub( listLIST_IS_EMPTY_Stub_Impl );
+    listIS_CONTAINED_WITHIN_Stub( listIS_CONTAINED_WITHIN_Stub_Impl );
+    listGET_LIST_ITEM_OWNER_Stub( listGET_LIST_ITEM_OWNER_Stub_Impl );
+    listGET_LIST_ITEM_VALUE_Stub( listGET_LIST_ITEM_VALUE_Stub_Impl );
+    listSET_LIST_ITEM_VALUE_Stub( listSET_LIST_ITEM_VALUE_Stub_Impl );
+
+    memset( tcb, 0x00, sizeof( tcb ) );
+    critical_section_counter = 0;
+    core_id = 0;
+    yield_core_mask = 0;
+    task_lock_count = 0;
+    isr_lock_count = 0;
+    yield_on_enable_interrupts = NULL;
+    uxTopReadyPriority = tskIDLE_PRIORITY;
+    uxSchedulerSuspended = ( UBaseType_t ) pdFALSE;
+    prvInitialiseTaskLists();
+
+    /* The scheduler is running, with each core running its idle task. */
+    create_task( IDLE_TASK_0, tskIDLE_PRIORITY, BOTH_CORES );
+    create_task( IDLE_TASK_1, tskIDLE_PRIORITY, BOTH_CORES );
+    xIdleTaskHandles[ 0 ] = &tcb[ IDLE_TASK_0 ];
+    xIdleTaskHandles[ 1 ] = &tcb[ IDLE_TASK_1 ];
+    pxCurrentTCBs[ 0 ] = &tcb[ IDLE_TASK_0 ];
+    pxCurrentTCBs[ 1 ] = &tcb[ IDLE_TASK_1 ];
+    tcb[ IDLE_TASK_0 ].xTaskRunState = 0;
+    tcb[ IDLE_TASK_1 ].xTaskRunState = 1;
+    xYieldPendings[ 0 ] = pdFALSE;
+    xYieldPendings[ 1 ] = pdFALSE;
+    xSchedulerRunning = pdTRUE;
+}
+
+/*! called after each testcase */
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL( 0, critical_section_counter );
+    TEST_ASSERT_EQUAL( 0, task_lock_count );
+    TEST_ASSERT_EQUAL( 0, isr_lock_count );
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/**
+ * @brief A core does not run a task below the priority of the task running on
+ * the other core - it keeps running its idle task.
+ */
+void test_prvSelectHighestPriorityTask_lower_priority_task_waits( void )
+{
+    create_task( 2, 2, BOTH_CORES );
+    create_task( 3, 1, BOTH_CORES );
+    run_task( 2, 1 );
+
+    prvSelectHighestPriorityTask( 0 );
+
+    /* Either idle task may run on core 0. */
+    TEST_ASSERT_EQUAL( tskIDLE_PRIORITY, pxCurrentTCBs[ 0 ]->uxPriority );
+    TEST_ASSERT_EQUAL( 0, pxCurrentTCBs[ 0 ]->xTaskRunState );
+    TEST_ASSERT_EQUAL( TASK_NOT_RUNNING, tcb[ 3 ].xTaskRunState );
+    TEST_ASSERT_EQUAL( 2, uxTopReadyPriority );
+    TEST_ASSERT_EQUAL( 0, yield_core_mask );
+}
+
+/**
+ * @brief Falling back to the idle priority only runs an idle task, not an
+ * application task that shares the idle priority.
+ */
+void test_prvSelectHighestPriorityTask_skips_application_task_at_idle_priority( void )
+{
+    create_task( 2, 2, BOTH_CORES );
+    create_task( 3, tskIDLE_PRIORITY, BOTH_CORES );
+    run_task( 2, 1 );
+
+    /* Keep the idle task of core 1 off core 0, so task 3 is ahead of the idle
+     * task of core 0 once that has been moved to the end of the list. */
+    tcb[ IDLE_TASK_1 ].uxCoreAffinityMask = CORE_1_ONLY;
+
+    prvSelectHighestPriorityTask( 0 );
+
+    TEST_ASSERT_EQUAL_PTR( &tcb[ IDLE_TASK_0 ], pxCurrentTCBs[ 0 ] );
+    TEST_ASSERT_EQUAL( TASK_NOT_RUNNING, tcb[ 3 ].xTaskRunState );
+}
+
+/**
+ * @brief A core that starts running a task of a higher priority evicts the
+ * lower priority task from the other core.
+ */
+void test_prvSelectHighestPriorityTask_evicts_lower_priority_core( void )
+{
+    create_task( 2, 1, BOTH_CORES );
+    create_task( 3, 2, BOTH_CORES );
+    run_task( 2, 1 );
+
+    prvSelectHighestPriorityTask( 0 );
+
+    TEST_ASSERT_EQUAL_PTR( &tcb[ 3 ], pxCurrentTCBs[ 0 ] );
+    TEST_ASSERT_EQUAL( CORE_1_ONLY, yield_core_mask );
+    TEST_ASSERT_EQUAL( TASK_SCHEDULED_TO_YIELD, tcb[ 2 ].xTaskRunState );
+
+    /* Core 1 then runs its idle task, and does not yield core 0. */
+    yield_core_mask = 0;
+    core_id = 1;
+    prvSelectHighestPriorityTask( 1 );
+
+    TEST_ASSERT_EQUAL_PTR( &tcb[ IDLE_TASK_1 ], pxCurrentTCBs[ 1 ] );
+    TEST_ASSERT_EQUAL( TASK_NOT_RUNNING, tcb[ 2 ].xTaskRunState );
+    TEST_ASSERT_EQUAL( 0, yield_core_mask );
+}
+
+/**
+ * @brief When the last task of the top priority leaves the ready list the core
+ * that was held on its idle task is rescheduled to run the tasks of the new top
+ * priority.
+ */
+void test_prvSelectHighestPriorityTask_top_priority_drop_reschedules_idle_core( void )
+{
+    create_task( 2, 2, BOTH_CORES );
+    create_task( 3, 1, BOTH_CORES );
+    create_task( 4, 1, BOTH_CORES );
+    run_task( 2, 0 );
+
+    /* Task 2 blocks. */
+    ( void ) uxListRemove_Stub_Impl( &( tcb[ 2 ].xStateListItem ), 0 );
+
+    prvSelectHighestPriorityTask( 0 );
+
+    TEST_ASSERT_EQUAL_PTR( &tcb[ 3 ], pxCurrentTCBs[ 0 ] );
+    TEST_ASSERT_EQUAL( 1, uxTopReadyPriority );
+    TEST_ASSERT_EQUAL( CORE_1_ONLY, yield_core_mask );
+
+    core_id = 1;
+    prvSelectHighestPriorityTask( 1 );
+
+    TEST_ASSERT_EQUAL_PTR( &tcb[ 4 ], pxCurrentTCBs[ 1 ] );
+}
+
+/**
+ * @brief A readied task below the top ready priority does not preempt a core,
+ * even one that is running its idle task.
+ */
+void test_prvYieldForTask_below_top_priority( void )
+{
+    create_task( 2, 2, BOTH_CORES );
+    create_task( 3, 1, BOTH_CORES );
+    run_task( 2, 1 );
+
+    critical_section_counter = 1;
+    prvYieldForTask( &tcb[ 3 ] );
+    critical_section_counter = 0;
+
+    TEST_ASSERT_EQUAL( 0, yield_core_mask );
+    TEST_ASSERT_EQUAL( pdFALSE, xYieldPendings[ 0 ] );
+}
+
+/**
+ * @brief A readied task at the top ready priority preempts the idle core.
+ */
+void test_prvYieldForTask_at_top_priority( void )
+{
+    create_task( 2, 2, BOTH_CORES );
+    create_task( 3, 2, BOTH_CORES );
+    run_task( 2, 1 );
+    core_id = 1;
+
+    critical_section_counter = 1;
+    prvYieldForTask( &tcb[ 3 ] );
+    critical_section_counter = 0;
+
+    TEST_ASSERT_EQUAL( CORE_0_ONLY, yield_core_mask );
+    TEST_ASSERT_EQUAL( TASK_SCHEDULED_TO_YIELD, tcb[ IDLE_TASK_0 ].xTaskRunState );
+}
+
+/**
+ * @brief Raising the priority of a running task reschedules its core, which
+ * then evicts the task of the old priority from the other core.
+ */
+void test_vTaskPrioritySet_raising_running_task_evicts_other_core( void )
+{
+    create_task( 2, 1, BOTH_CORES );
+    create_task( 3, 1, BOTH_CORES );
+    run_task( 2, 1 );
+    run_task( 3, 0 );
+
+    vTaskPrioritySet( &tcb[ 2 ], 2 );
+
+    TEST_ASSERT_EQUAL( 2, uxTopReadyPriority );
+    TEST_ASSERT_EQUAL( CORE_1_ONLY, yield_core_mask );
+    TEST_ASSERT_EQUAL( TASK_SCHEDULED_TO_YIELD, tcb[ 2 ].xTaskRunState );
+
+    yield_core_mask = 0;
+    core_id = 1;
+    prvSelectHighestPriorityTask( 1 );
+
+    TEST_ASSERT_EQUAL_PTR( &tcb[ 2 ], pxCurrentTCBs[ 1 ] );
+    TEST_ASSERT_EQUAL( 1, tcb[ 2 ].xTaskRunState );
+    TEST_ASSERT_EQUAL( CORE_0_ONLY, yield_core_mask );
+    TEST_ASSERT_EQUAL( TASK_SCHEDULED_TO_YIELD, tcb[ 3 ].xTaskRunState );
+}
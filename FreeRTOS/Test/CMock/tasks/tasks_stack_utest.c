@@ -0,0 +1,427 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*! @file tasks_stack_utest.c */
+
+/* The tasks are given a stack that the tests fill and use by hand, so the
+ * words uxTaskGetStackHighWaterMarkIncremental() finds in use are known
+ * exactly.  The stack grows down, so word 0 is the deepest. */
+
+/* Tasks includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "task.h"
+
+#include "mock_list.h"
+#include "mock_list_macros.h"
+#include "mock_timers.h"
+#include "mock_portable.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "global_vars.h"
+
+/* C runtime includes. */
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define STACK_WORDS      32U
+
+/* The initial context of the task occupies the words above this one. */
+#define INITIAL_TOP      28U
+
+/* ===========================  GLOBAL VARIABLES  =========================== */
+static TCB_t tcb;
+static StackType_t task_stack[ STACK_WORDS ];
+static uint32_t critical_section_counter = 0;
+static bool vTaskDeletePre_called = false;
+static bool getIddleTaskMemory_called = false;
+static bool vApplicationTickHook_called = false;
+static bool port_yield_called = false;
+static bool port_enable_interrupts_called = false;
+static bool port_disable_interrupts_called = false;
+static bool port_yield_within_api_called = false;
+static bool port_setup_tcb_called = false;
+static bool portClear_Interrupt_called = false;
+static bool portSet_Interrupt_called = false;
+static bool portClear_Interrupt_from_isr_called = false;
+static bool portSet_Interrupt_from_isr_called = false;
+static bool port_invalid_interrupt_called = false;
+static bool vApplicationStackOverflowHook_called = false;
+static bool port_allocate_secure_context_called = false;
+static bool port_assert_if_in_isr_called = false;
+static UBaseType_t stack_pressure_hook_calls = 0;
+static TaskHandle_t stack_pressure_task = NULL;
+static configSTACK_DEPTH_TYPE stack_pressure_free = 0;
+
+/* ============================  HOOK FUNCTIONS  ============================ */
+void vFakePortAssertIfISR( void )
+{
+    port_assert_if_in_isr_called = true;
+    HOOK_DIAG();
+}
+
+void port_allocate_secure_context( BaseType_t stackSize )
+{
+    HOOK_DIAG();
+    port_allocate_secure_context_called = true;
+}
+
+void vApplicationIdleHook( void )
+{
+    HOOK_DIAG();
+}
+
+void vApplicationMallocFailedHook( void )
+{
+    HOOK_DIAG();
+}
+
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    uint32_t * pulIdleTaskStackSize )
+{
+    HOOK_DIAG();
+    *ppxIdleTaskTCBBuffer = NULL;
+    *ppxIdleTaskStackBuffer = NULL;
+    *pulIdleTaskStackSize = 0;
+    getIddleTaskMemory_called = true;
+}
+
+void vConfigureTimerForRunTimeStats( void )
+{
+    HOOK_DIAG();
+}
+
+long unsigned int ulGetRunTimeCounterValue( void )
+{
+    HOOK_DIAG();
+    return 3;
+}
+
+void vApplicationTickHook()
+{
+    HOOK_DIAG();
+    vApplicationTickHook_called = true;
+}
+
+void vPortCurrentTaskDying( void * pvTaskToDelete,
+                            volatile BaseType_t * pxPendYield )
+{
+    HOOK_DIAG();
+    vTaskDeletePre_called = true;
+}
+
+void vFakePortEnterCriticalSection( void )
+{
+    HOOK_DIAG();
+    critical_section_counter++;
+}
+
+void vFakePortExitCriticalSection( void )
+{
+    HOOK_DIAG();
+    critical_section_counter--;
+}
+
+void vFakePortYieldWithinAPI()
+{
+    HOOK_DIAG();
+    port_yield_within_api_called = true;
+}
+
+void vFakePortYieldFromISR()
+{
+    HOOK_DIAG();
+}
+
+void vFakePortDisableInterrupts()
+{
+    port_disable_interrupts_called = true;
+    HOOK_DIAG();
+}
+
+void vFakePortEnableInterrupts()
+{
+    port_enable_interrupts_called = true;
+    HOOK_DIAG();
+}
+
+void vFakePortYield()
+{
+    HOOK_DIAG();
+    port_yield_called = true;
+}
+
+void portSetupTCB_CB( void * tcb )
+{
+    HOOK_DIAG();
+    port_setup_tcb_called = true;
+}
+
+void vFakePortClearInterruptMask( UBaseType_t bt )
+{
+    HOOK_DIAG();
+    portClear_Interrupt_called = true;
+}
+
+UBaseType_t ulFakePortSetInterruptMask( void )
+{
+    HOOK_DIAG();
+    portSet_Interrupt_called = true;
+    return 1;
+}
+
+void vFakePortClearInterruptMaskFromISR( UBaseType_t bt )
+{
+    HOOK_DIAG();
+    portClear_Interrupt_from_isr_called = true;
+}
+
+UBaseType_t ulFakePortSetInterruptMaskFromISR( void )
+{
+    HOOK_DIAG();
+    portSet_Interrupt_from_isr_called = true;
+    return 1;
+}
+
+void vFakePortAssertIfInterruptPriorityInvalid( void )
+{
+    HOOK_DIAG();
+    port_invalid_interrupt_called = true;
+}
+
+void vApplicationStackOverflowHook( TaskHandle_t xTask,
+                                    char * stack )
+{
+    HOOK_DIAG();
+    vApplicationStackOverflowHook_called = true;
+}
+
+void vApplicationStackPressureHook( TaskHandle_t xTask,
+                                    configSTACK_DEPTH_TYPE uxFreeStack )
+{
+    HOOK_DIAG();
+    stack_pressure_hook_calls++;
+    stack_pressure_task = xTask;
+    stack_pressure_free = uxFreeStack;
+}
+
+/* ============================  Static Functions  ========================== */
+
+/* Write to every word of the stack from the initial context down to, and
+ * including, word uxDeepest, as a task calling deeper functions would. */
+static void use_stack( UBaseType_t uxDeepest )
+{
+    UBaseType_t uxWord;
+
+    for( uxWord = uxDeepest; uxWord < INITIAL_TOP; uxWord++ )
+    {
+        task_stack[ uxWord ] = ( StackType_t ) 0U;
+    }
+}
+
+/* ============================  Unity Fixtures  ============================ */
+/*! called before each testcase */
+void setUp( void )
+{
+    RESET_ALL_HOOKS();
+    stack_pressure_hook_calls = 0;
+    stack_pressure_task = NULL;
+    stack_pressure_free = 0;
+
+    /* As prvInitialiseNewTask() with the stack filled with
+     * tskSTACK_FILL_BYTE and the initial context written above INITIAL_TOP. */
+    memset( &tcb, 0x00, sizeof( tcb ) );
+    memset( task_stack, 0xa5, sizeof( task_stack ) );
+    memset( &task_stack[ INITIAL_TOP ], 0x00, sizeof( StackType_t ) * ( STACK_WORDS - INITIAL_TOP ) );
+    tcb.pxStack = &task_stack[ 0 ];
+    tcb.pxEndOfStack = &task_stack[ STACK_WORDS - 1U ];
+    tcb.pxTopOfStack = &task_stack[ INITIAL_TOP ];
+    tcb.pxStackHighWater = &task_stack[ INITIAL_TOP ];
+}
+
+/*! called after each testcase */
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL( 0, critical_section_counter );
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/**
+ * @brief With no new use of the stack the mark stays at the initial context.
+ */
+void test_uxTaskGetStackHighWaterMarkIncremental_unused( void )
+{
+    configSTACK_DEPTH_TYPE uxFree;
+
+    uxFree = uxTaskGetStackHighWaterMarkIncremental( &tcb );
+
+    TEST_ASSERT_EQUAL( INITIAL_TOP, uxFree );
+    TEST_ASSERT_EQUAL_PTR( &task_stack[ INITIAL_TOP ], tcb.pxStackHighWater );
+    TEST_ASSERT_EQUAL( 0, stack_pressure_hook_calls );
+}
+
+/**
+ * @brief The mark moves to the deepest word in use.
+ */
+void test_uxTaskGetStackHighWaterMarkIncremental_used( void )
+{
+    configSTACK_DEPTH_TYPE uxFree;
+
+    use_stack( 20 );
+
+    uxFree = uxTaskGetStackHighWaterMarkIncremental( &tcb );
+
+    TEST_ASSERT_EQUAL( 20, uxFree );
+    TEST_ASSERT_EQUAL_PTR( &task_stack[ 20 ], tcb.pxStackHighWater );
+}
+
+/**
+ * @brief A used word fewer than configSTACK_HIGH_WATER_SCAN_GAP unused words
+ * beyond the deepest contiguous use is found.
+ */
+void test_uxTaskGetStackHighWaterMarkIncremental_within_gap( void )
+{
+    configSTACK_DEPTH_TYPE uxFree;
+
+    use_stack( 24 );
+    task_stack[ 24 - configSTACK_HIGH_WATER_SCAN_GAP ] = ( StackType_t ) 0U;
+
+    uxFree = uxTaskGetStackHighWaterMarkIncremental( &tcb );
+
+    TEST_ASSERT_EQUAL( 24 - configSTACK_HIGH_WATER_SCAN_GAP, uxFree );
+    TEST_ASSERT_EQUAL_PTR( &task_stack[ 24 - configSTACK_HIGH_WATER_SCAN_GAP ], tcb.pxStackHighWater );
+}
+
+/**
+ * @brief The scan stops after configSTACK_HIGH_WATER_SCAN_GAP unused words, so
+ * a used word beyond them is not found.
+ */
+void test_uxTaskGetStackHighWaterMarkIncremental_beyond_gap( void )
+{
+    configSTACK_DEPTH_TYPE uxFree;
+
+    use_stack( 24 );
+    task_stack[ 24 - configSTACK_HIGH_WATER_SCAN_GAP - 1 ] = ( StackType_t ) 0U;
+
+    uxFree = uxTaskGetStackHighWaterMarkIncremental( &tcb );
+
+    TEST_ASSERT_EQUAL( 24, uxFree );
+    TEST_ASSERT_EQUAL_PTR( &task_stack[ 24 ], tcb.pxStackHighWater );
+}
+
+/**
+ * @brief The scan resumes from the mark, so use found by an earlier call is not
+ * lost when the words it found hold the fill value again.
+ */
+void test_uxTaskGetStackHighWaterMarkIncremental_never_moves_back( void )
+{
+    configSTACK_DEPTH_TYPE uxFree;
+
+    use_stack( 16 );
+    uxFree = uxTaskGetStackHighWaterMarkIncremental( &tcb );
+    TEST_ASSERT_EQUAL( 16, uxFree );
+
+    memset( &task_stack[ 16 ], 0xa5, sizeof( StackType_t ) * ( INITIAL_TOP - 16U ) );
+
+    uxFree = uxTaskGetStackHighWaterMarkIncremental( &tcb );
+
+    TEST_ASSERT_EQUAL( 16, uxFree );
+    TEST_ASSERT_EQUAL_PTR( &task_stack[ 16 ], tcb.pxStackHighWater );
+
+    /* Later use that does not reach the mark does not move it either. */
+    use_stack( 18 );
+
+    uxFree = uxTaskGetStackHighWaterMarkIncremental( &tcb );
+
+    TEST_ASSERT_EQUAL( 16, uxFree );
+    TEST_ASSERT_EQUAL_PTR( &task_stack[ 16 ], tcb.pxStackHighWater );
+}
+
+/**
+ * @brief The stack pressure hook is called once when the mark crosses
+ * configSTACK_PRESSURE_THRESHOLD, and not again while the mark stays put.
+ */
+void test_uxTaskGetStackHighWaterMarkIncremental_pressure_hook( void )
+{
+    configSTACK_DEPTH_TYPE uxFree;
+
+    /* Above the threshold. */
+    use_stack( configSTACK_PRESSURE_THRESHOLD + 1 );
+    uxFree = uxTaskGetStackHighWaterMarkIncremental( &tcb );
+    TEST_ASSERT_EQUAL( configSTACK_PRESSURE_THRESHOLD + 1, uxFree );
+    TEST_ASSERT_EQUAL( 0, stack_pressure_hook_calls );
+
+    /* Crossing it. */
+    use_stack( configSTACK_PRESSURE_THRESHOLD - 2 );
+    uxFree = uxTaskGetStackHighWaterMarkIncremental( &tcb );
+    TEST_ASSERT_EQUAL( configSTACK_PRESSURE_THRESHOLD - 2, uxFree );
+    TEST_ASSERT_EQUAL( 1, stack_pressure_hook_calls );
+    TEST_ASSERT_EQUAL_PTR( &tcb, stack_pressure_task );
+    TEST_ASSERT_EQUAL( configSTACK_PRESSURE_THRESHOLD - 2, stack_pressure_free );
+
+    /* The mark does not move. */
+    uxFree = uxTaskGetStackHighWaterMarkIncremental( &tcb );
+    uxFree = uxTaskGetStackHighWaterMarkIncremental( &tcb );
+    TEST_ASSERT_EQUAL( configSTACK_PRESSURE_THRESHOLD - 2, uxFree );
+    TEST_ASSERT_EQUAL( 1, stack_pressure_hook_calls );
+}
+
+/**
+ * @brief Below the threshold the hook is called again each time the mark
+ * moves, down to a fully used stack.
+ */
+void test_uxTaskGetStackHighWaterMarkIncremental_pressure_hook_deeper( void )
+{
+    configSTACK_DEPTH_TYPE uxFree;
+
+    use_stack( configSTACK_PRESSURE_THRESHOLD );
+    ( void ) uxTaskGetStackHighWaterMarkIncremental( &tcb );
+    TEST_ASSERT_EQUAL( 1, stack_pressure_hook_calls );
+    TEST_ASSERT_EQUAL( configSTACK_PRESSURE_THRESHOLD, stack_pressure_free );
+
+    use_stack( 0 );
+    uxFree = uxTaskGetStackHighWaterMarkIncremental( &tcb );
+
+    TEST_ASSERT_EQUAL( 0, uxFree );
+    TEST_ASSERT_EQUAL_PTR( &task_stack[ 0 ], tcb.pxStackHighWater );
+    TEST_ASSERT_EQUAL( 2, stack_pressure_hook_calls );
+    TEST_ASSERT_EQUAL( 0, stack_pressure_free );
+}
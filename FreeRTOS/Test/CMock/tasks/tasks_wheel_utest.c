@@ -0,0 +1,462 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*! @file tasks_wheel_utest.c */
+
+/* The delayed tasks are held in the timer wheel.  The list functions are
+ * stubbed with working implementations so the tests can check which slot of
+ * the wheel holds a task after the tick count is stepped. */
+
+/* Tasks includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "task.h"
+
+#include "mock_list.h"
+#include "mock_list_macros.h"
+#include "mock_timers.h"
+#include "mock_portable.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "global_vars.h"
+
+/* C runtime includes. */
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* configTIMER_WHEEL_SLOT_BITS is left at its default of 5. */
+#define WHEEL_SLOTS    32U
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+extern TCB_t * volatile pxCurrentTCB;
+extern List_t pxReadyTasksLists[ configMAX_PRIORITIES ];
+extern List_t xTimerWheel[][ WHEEL_SLOTS ];
+extern uint32_t ulTimerWheelOccupied[];
+extern List_t * volatile pxDelayedTaskList;
+
+extern volatile TickType_t xTickCount;
+extern volatile UBaseType_t uxTopReadyPriority;
+extern volatile TickType_t xPendedTicks;
+extern volatile TickType_t xNextTaskUnblockTime;
+extern volatile UBaseType_t uxSchedulerSuspended;
+
+/* =========================  EXTERN FUNCTIONS  ============================ */
+extern void prvInitialiseTaskLists( void );
+extern void prvTimerWheelInsert( ListItem_t * const pxListItem,
+                                 const TickType_t xNextTick );
+
+/* ===========================  GLOBAL VARIABLES  =========================== */
+static TCB_t tcb[ 3 ];
+static uint32_t critical_section_counter = 0;
+static bool vTaskDeletePre_called = false;
+static bool getIddleTaskMemory_called = false;
+static bool vApplicationTickHook_called = false;
+static bool port_yield_called = false;
+static bool port_enable_interrupts_called = false;
+static bool port_disable_interrupts_called = false;
+static bool port_yield_within_api_called = false;
+static bool port_setup_tcb_called = false;
+static bool portClear_Interrupt_called = false;
+static bool portSet_Interrupt_called = false;
+static bool portClear_Interrupt_from_isr_called = false;
+static bool portSet_Interrupt_from_isr_called = false;
+static bool port_invalid_interrupt_called = false;
+static bool vApplicationStackOverflowHook_called = false;
+static bool port_allocate_secure_context_called = false;
+static bool port_assert_if_in_isr_called = false;
+
+/* ============================  HOOK FUNCTIONS  ============================ */
+void vFakePortAssertIfISR( void )
+{
+    port_assert_if_in_isr_called = true;
+    HOOK_DIAG();
+}
+
+void port_allocate_secure_context( BaseType_t stackSize )
+{
+    HOOK_DIAG();
+    port_allocate_secure_context_called = true;
+}
+
+void vApplicationIdleHook( void )
+{
+    HOOK_DIAG();
+}
+
+void vApplicationMallocFailedHook( void )
+{
+    HOOK_DIAG();
+}
+
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    uint32_t * pulIdleTaskStackSize )
+{
+    HOOK_DIAG();
+    *ppxIdleTaskTCBBuffer = NULL;
+    *ppxIdleTaskStackBuffer = NULL;
+    *pulIdleTaskStackSize = 0;
+    getIddleTaskMemory_called = true;
+}
+
+void vConfigureTimerForRunTimeStats( void )
+{
+    HOOK_DIAG();
+}
+
+long unsigned int ulGetRunTimeCounterValue( void )
+{
+    HOOK_DIAG();
+    return 3;
+}
+
+void vApplicationTickHook()
+{
+    HOOK_DIAG();
+    vApplicationTickHook_called = true;
+}
+
+void vPortCurrentTaskDying( void * pvTaskToDelete,
+                            volatile BaseType_t * pxPendYield )
+{
+    HOOK_DIAG();
+    vTaskDeletePre_called = true;
+}
+
+void vFakePortEnterCriticalSection( void )
+{
+    HOOK_DIAG();
+    critical_section_counter++;
+}
+
+void vFakePortExitCriticalSection( void )
+{
+    HOOK_DIAG();
+    critical_section_counter--;
+}
+
+void vFakePortYieldWithinAPI()
+{
+    HOOK_DIAG();
+    port_yield_within_api_called = true;
+}
+
+void vFakePortYieldFromISR()
+{
+    HOOK_DIAG();
+}
+
+void vFakePortDisableInterrupts()
+{
+    port_disable_interrupts_called = true;
+    HOOK_DIAG();
+}
+
+void vFakePortEnableInterrupts()
+{
+    port_enable_interrupts_called = true;
+    HOOK_DIAG();
+}
+
+void vFakePortYield()
+{
+    HOOK_DIAG();
+    port_yield_called = true;
+}
+
+void portSetupTCB_CB( void * tcb )
+{
+    HOOK_DIAG();
+    port_setup_tcb_called = true;
+}
+
+void vFakePortClearInterruptMask( UBaseType_t bt )
+{
+    HOOK_DIAG();
+    portClear_Interrupt_called = true;
+}
+
+UBaseType_t ulFakePortSetInterruptMask( void )
+{
+    HOOK_DIAG();
+    portSet_Interrupt_called = true;
+    return 1;
+}
+
+void vFakePortClearInterruptMaskFromISR( UBaseType_t bt )
+{
+    HOOK_DIAG();
+    portClear_Interrupt_from_isr_called = true;
+}
+
+UBaseType_t ulFakePortSetInterruptMaskFromISR( void )
+{
+    HOOK_DIAG();
+    portSet_Interrupt_from_isr_called = true;
+    return 1;
+}
+
+void vFakePortAssertIfInterruptPriorityInvalid( void )
+{
+    HOOK_DIAG();
+    port_invalid_interrupt_called = true;
+}
+
+void vApplicationStackOverflowHook( TaskHandle_t xTask,
+                                    char * stack )
+{
+    HOOK_DIAG();
+    vApplicationStackOverflowHook_called = true;
+}
+
+/* ===============================  LIST STUBS  ============================= */
+static void vListInitialise_Stub_Impl( List_t * const pxList,
+                                       int cmock_num_calls )
+{
+    pxList->pxIndex = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.xItemValue = portMAX_DELAY;
+    pxList->xListEnd.pxNext = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.pxPrevious = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
+}
+
+static void listINSERT_END_Stub_Impl( List_t * pxList,
+                                      ListItem_t * pxNewListItem,
+                                      int cmock_num_calls )
+{
+    ListItem_t * const pxIndex = pxList->pxIndex;
+
+    pxNewListItem->pxNext = pxIndex;
+    pxNewListItem->pxPrevious = pxIndex->pxPrevious;
+    pxIndex->pxPrevious->pxNext = pxNewListItem;
+    pxIndex->pxPrevious = pxNewListItem;
+    pxNewListItem->pxContainer = pxList;
+    ( pxList->uxNumberOfItems )++;
+}
+
+static void listREMOVE_ITEM_Stub_Impl( ListItem_t * pxItemToRemove,
+                                       int cmock_num_calls )
+{
+    List_t * const pxList = pxItemToRemove->pxContainer;
+
+    pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
+    pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+
+    if( pxList->pxIndex == pxItemToRemove )
+    {
+        pxList->pxIndex = pxItemToRemove->pxPrevious;
+    }
+
+    pxItemToRemove->pxContainer = NULL;
+    ( pxList->uxNumberOfItems )--;
+}
+
+static BaseType_t listLIST_IS_EMPTY_Stub_Impl( const List_t * pxList,
+                                               int cmock_num_calls )
+{
+    return ( pxList->uxNumberOfItems == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+}
+
+static TCB_t * listGET_OWNER_OF_HEAD_ENTRY_Stub_Impl( const List_t * pxList,
+                                                      int cmock_num_calls )
+{
+    return ( TCB_t * ) pxList->xListEnd.pxNext->pvOwner;
+}
+
+static TickType_t listGET_LIST_ITEM_VALUE_Stub_Impl( ListItem_t * pxListItem,
+                                                     int cmock_num_calls )
+{
+    return pxListItem->xItemValue;
+}
+
+static List_t * listLIST_ITEM_CONTAINER_Stub_Impl( const ListItem_t * pxListItem,
+                                                   int cmock_num_calls )
+{
+    return pxListItem->pxContainer;
+}
+
+static UBaseType_t listCURRENT_LIST_LENGTH_Stub_Impl( List_t * pxList,
+                                                      int cmock_num_calls )
+{
+    return pxList->uxNumberOfItems;
+}
+
+/* ============================  Static Functions  ========================== */
+
+/* Block tcb[ uxTask ] until xTimeToWake, as prvAddCurrentTaskToDelayedList()
+ * would at the current tick count. */
+static void delay_task( UBaseType_t uxTask,
+                        TickType_t xTimeToWake )
+{
+    TCB_t * pxTCB = &tcb[ uxTask ];
+
+    pxTCB->uxPriority = 2;
+    pxTCB->xStateListItem.pvOwner = pxTCB;
+    pxTCB->xStateListItem.xItemValue = xTimeToWake;
+    pxTCB->xEventListItem.pvOwner = pxTCB;
+    pxTCB->xEventListItem.pxContainer = NULL;
+    prvTimerWheelInsert( &( pxTCB->xStateListItem ), xTickCount + 1 );
+
+    if( xTimeToWake < xNextTaskUnblockTime )
+    {
+        xNextTaskUnblockTime = xTimeToWake;
+    }
+}
+
+/* ============================  Unity Fixtures  ============================ */
+/*! called before each testcase */
+void setUp( void )
+{
+    RESET_ALL_HOOKS();
+
+    vListInitialise_Stub( vListInitialise_Stub_Impl );
+    listINSERT_END_Stub( listINSERT_END_Stub_Impl );
+    listREMOVE_ITEM_Stub( listREMOVE_ITEM_Stub_Impl );
+    listLIST_IS_EMPTY_Stub( listLIST_IS_EMPTY_Stub_Impl );
+    listGET_OWNER_OF_HEAD_ENTRY_Stub( listGET_OWNER_OF_HEAD_ENTRY_Stub_Impl );
+    listGET_LIST_ITEM_VALUE_Stub( listGET_LIST_ITEM_VALUE_Stub_Impl );
+    listLIST_ITEM_CONTAINER_Stub( listLIST_ITEM_CONTAINER_Stub_Impl );
+    listCURRENT_LIST_LENGTH_Stub( listCURRENT_LIST_LENGTH_Stub_Impl );
+
+    memset( tcb, 0x00, sizeof( tcb ) );
+    xTickCount = ( TickType_t ) 0U;
+    uxTopReadyPriority = tskIDLE_PRIORITY;
+    xPendedTicks = ( TickType_t ) 0U;
+    xNextTaskUnblockTime = portMAX_DELAY;
+    prvInitialiseTaskLists();
+
+    /* The running task has the lowest priority. */
+    pxCurrentTCB = &tcb[ 0 ];
+    pxCurrentTCB->uxPriority = tskIDLE_PRIORITY;
+
+    /* vTaskStepTick() is called with the scheduler suspended. */
+    uxSchedulerSuspended = ( UBaseType_t ) pdTRUE;
+}
+
+/*! called after each testcase */
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL( 0, critical_section_counter );
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/**
+ * @brief Stepping past a level 1 cascade point moves the task down to level 0
+ * without pending a tick for each step, and the task then unblocks on the next
+ * tick.
+ */
+void test_vTaskStepTick_across_cascade( void )
+{
+    BaseType_t xSwitchRequired;
+
+    delay_task( 1, 100 );
+    TEST_ASSERT_EQUAL_PTR( &xTimerWheel[ 1 ][ 3 ], tcb[ 1 ].xStateListItem.pxContainer );
+
+    vTaskStepTick( 99 );
+
+    TEST_ASSERT_EQUAL( 99, xTickCount );
+    TEST_ASSERT_EQUAL( 0, xPendedTicks );
+    TEST_ASSERT_EQUAL_PTR( &xTimerWheel[ 0 ][ 100 % WHEEL_SLOTS ], tcb[ 1 ].xStateListItem.pxContainer );
+    TEST_ASSERT_EQUAL( 0, ulTimerWheelOccupied[ 1 ] );
+    TEST_ASSERT_EQUAL_PTR( &xTimerWheel[ 0 ][ 99 % WHEEL_SLOTS ], pxDelayedTaskList );
+
+    uxSchedulerSuspended = ( UBaseType_t ) pdFALSE;
+    xSwitchRequired = xTaskIncrementTick();
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSwitchRequired );
+    TEST_ASSERT_EQUAL( 100, xTickCount );
+    TEST_ASSERT_EQUAL_PTR( &pxReadyTasksLists[ 2 ], tcb[ 1 ].xStateListItem.pxContainer );
+    TEST_ASSERT_EQUAL( portMAX_DELAY, xNextTaskUnblockTime );
+}
+
+/**
+ * @brief Stepping to the wake time of a task pends the last tick, so the task
+ * is unblocked by xTaskIncrementTick().
+ */
+void test_vTaskStepTick_to_wake_time( void )
+{
+    delay_task( 1, 100 );
+
+    vTaskStepTick( 100 );
+
+    TEST_ASSERT_EQUAL( 99, xTickCount );
+    TEST_ASSERT_EQUAL( 1, xPendedTicks );
+    TEST_ASSERT_EQUAL_PTR( &xTimerWheel[ 0 ][ 100 % WHEEL_SLOTS ], tcb[ 1 ].xStateListItem.pxContainer );
+
+    uxSchedulerSuspended = ( UBaseType_t ) pdFALSE;
+    ( void ) xTaskIncrementTick();
+
+    TEST_ASSERT_EQUAL( 100, xTickCount );
+    TEST_ASSERT_EQUAL_PTR( &pxReadyTasksLists[ 2 ], tcb[ 1 ].xStateListItem.pxContainer );
+}
+
+/**
+ * @brief A step that covers several revolutions of level 1 and a level 2
+ * cascade point only moves the tasks due before the next level 3 cascade.
+ */
+void test_vTaskStepTick_across_levels( void )
+{
+    delay_task( 1, 5000 );
+    delay_task( 2, 40000 );
+    TEST_ASSERT_EQUAL_PTR( &xTimerWheel[ 2 ][ 4 ], tcb[ 1 ].xStateListItem.pxContainer );
+    TEST_ASSERT_EQUAL_PTR( &xTimerWheel[ 3 ][ 1 ], tcb[ 2 ].xStateListItem.pxContainer );
+
+    vTaskStepTick( 4990 );
+
+    TEST_ASSERT_EQUAL( 4990, xTickCount );
+    TEST_ASSERT_EQUAL( 0, xPendedTicks );
+    TEST_ASSERT_EQUAL_PTR( &xTimerWheel[ 0 ][ 5000 % WHEEL_SLOTS ], tcb[ 1 ].xStateListItem.pxContainer );
+    TEST_ASSERT_EQUAL_PTR( &xTimerWheel[ 3 ][ 1 ], tcb[ 2 ].xStateListItem.pxContainer );
+    TEST_ASSERT_EQUAL( 0, ulTimerWheelOccupied[ 2 ] );
+
+    /* Run the remaining ticks to check the first task unblocks on time. */
+    uxSchedulerSuspended = ( UBaseType_t ) pdFALSE;
+
+    while( xTickCount < 4999 )
+    {
+        ( void ) xTaskIncrementTick();
+        TEST_ASSERT_EQUAL_PTR( &xTimerWheel[ 0 ][ 5000 % WHEEL_SLOTS ], tcb[ 1 ].xStateListItem.pxContainer );
+    }
+
+    ( void ) xTaskIncrementTick();
+
+    TEST_ASSERT_EQUAL_PTR( &pxReadyTasksLists[ 2 ], tcb[ 1 ].xStateListItem.pxContainer );
+    TEST_ASSERT_EQUAL_PTR( &xTimerWheel[ 3 ][ 1 ], tcb[ 2 ].xStateListItem.pxContainer );
+}
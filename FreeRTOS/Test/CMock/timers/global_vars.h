@@ -57,6 +57,10 @@ typedef struct tmrTimerControl                  /* The old naming convention is
     TickType_t xTimerPeriodInTicks;             /*<< How quickly and often the timer expires. */
     void * pvTimerID;                           /*<< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
     TimerCallbackFunction_t pxCallbackFunction; /*<< The function that will be called when the timer expires. */
+    #if ( configUSE_TIMER_COALESCING == 1 )
+        TickType_t xTimerSlackInTicks;          /*<< How many ticks late the timer may expire so it expires together with other timers.  Always one less than a power of two. */
+        TickType_t xTimerDueTime;               /*<< The time at which the timer is due to expire, from which its next period is measured. */
+    #endif
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxTimerNumber;              /*<< An ID assigned by trace tools such as FreeRTOS+Trace */
     #endif
@@ -0,0 +1,644 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file timers_wheel_utest.c */
+
+/* The timer service task is run with the timer wheel, timer coalescing and
+ * command batching enabled.  The list functions are stubbed with working
+ * implementations and the tick count only moves forward when the timer
+ * service task blocks, so the tests check when each timer expires rather than
+ * the exact sequence of calls made by the timer service task. */
+
+/* Test includes. */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "portmacro.h"
+#include "timers.h"
+
+#include "global_vars.h"
+
+#include "unity.h"
+#include "unity_memory.h"
+
+/* Mock includes. */
+#include "mock_queue.h"
+#include "mock_list.h"
+#include "mock_list_macros.h"
+#include "mock_fake_assert.h"
+#include "mock_portable.h"
+#include "mock_task.h"
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+void stopTimers();
+
+#define MAX_COMMANDS    16
+#define MAX_EXPIRIES    64
+
+/* ============================  GLOBAL VARIABLES =========================== */
+static uint16_t usMallocFreeCalls = 0;
+static uint32_t critical_section_counter;
+
+/* The simulated tick count, and the tick count at which the timer service task
+ * is stopped. */
+static TickType_t xTickCount;
+static TickType_t xEndTime;
+
+/* Commands sent to the timer queue that the timer service task has not yet
+ * received. */
+static DaemonTaskMessage_t xCommands[ MAX_COMMANDS ];
+static UBaseType_t uxCommandsSent;
+static UBaseType_t uxCommandsReceived;
+static UBaseType_t uxReceiveCalls;
+static UBaseType_t uxBatchSizes[ MAX_COMMANDS ];
+
+/* The number of times the timer service task blocked with a timeout. */
+static UBaseType_t uxWakeUps;
+
+/* The timers that expired, and the tick counts at which they did. */
+static TimerHandle_t xExpiredTimers[ MAX_EXPIRIES ];
+static TickType_t xExpiryTimes[ MAX_EXPIRIES ];
+static UBaseType_t uxExpiries;
+
+/* =============================  FUNCTION HOOKS  =========================== */
+void vFakePortEnterCriticalSection( void )
+{
+    critical_section_counter++;
+}
+
+void vFakePortExitCriticalSection( void )
+{
+    critical_section_counter--;
+}
+
+void vFakePortYieldWithinAPI()
+{
+    HOOK_DIAG();
+    pthread_exit( NULL );
+}
+
+void vApplicationGetTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                     StackType_t ** ppxTimerTaskStackBuffer,
+                                     uint32_t * pulTimerTaskStackSize )
+{
+    static StaticTask_t xTimerTaskTCB;
+    static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+    *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+    *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+void vApplicationDaemonTaskStartupHook( void )
+{
+    HOOK_DIAG();
+}
+
+/* ===============================  LIST STUBS  ============================= */
+static void vListInitialise_Stub_Impl( List_t * const pxList,
+                                       int cmock_num_calls )
+{
+    pxList->pxIndex = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.xItemValue = portMAX_DELAY;
+    pxList->xListEnd.pxNext = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.pxPrevious = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
+}
+
+static void vListInitialiseItem_Stub_Impl( ListItem_t * const pxItem,
+                                           int cmock_num_calls )
+{
+    pxItem->pxContainer = NULL;
+}
+
+static void vListInsertEnd_Stub_Impl( List_t * const pxList,
+                                      ListItem_t * const pxNewListItem,
+                                      int cmock_num_calls )
+{
+    ListItem_t * const pxIndex = pxList->pxIndex;
+
+    pxNewListItem->pxNext = pxIndex;
+    pxNewListItem->pxPrevious = pxIndex->pxPrevious;
+    pxIndex->pxPrevious->pxNext = pxNewListItem;
+    pxIndex->pxPrevious = pxNewListItem;
+    pxNewListItem->pxContainer = pxList;
+    ( pxList->uxNumberOfItems )++;
+}
+
+static UBaseType_t uxListRemove_Stub_Impl( ListItem_t * const pxItemToRemove,
+                                           int cmock_num_calls )
+{
+    List_t * const pxList = pxItemToRemove->pxContainer;
+
+    pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
+    pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+
+    if( pxList->pxIndex == pxItemToRemove )
+    {
+        pxList->pxIndex = pxItemToRemove->pxPrevious;
+    }
+
+    pxItemToRemove->pxContainer = NULL;
+    ( pxList->uxNumberOfItems )--;
+
+    return pxList->uxNumberOfItems;
+}
+
+static BaseType_t listLIST_IS_EMPTY_Stub_Impl( const List_t * pxList,
+                                               int cmock_num_calls )
+{
+    return ( pxList->uxNumberOfItems == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+}
+
+static void * listGET_OWNER_OF_HEAD_ENTRY_Stub_Impl( const List_t * pxList,
+                                                     int cmock_num_calls )
+{
+    return pxList->xListEnd.pxNext->pvOwner;
+}
+
+static TickType_t listGET_ITEM_VALUE_OF_HEAD_ENTRY_Stub_Impl( List_t * pxList,
+                                                              int cmock_num_calls )
+{
+    return pxList->xListEnd.pxNext->xItemValue;
+}
+
+static BaseType_t listIS_CONTAINED_WITHIN_Stub_Impl( List_t * pxList,
+                                                     const ListItem_t * pxListItem,
+                                                     int cmock_num_calls )
+{
+    return ( pxListItem->pxContainer == pxList ) ? pdTRUE : pdFALSE;
+}
+
+static TickType_t listGET_LIST_ITEM_VALUE_Stub_Impl( ListItem_t * pxListItem,
+                                                     int cmock_num_calls )
+{
+    return pxListItem->xItemValue;
+}
+
+static void listSET_LIST_ITEM_VALUE_Stub_Impl( ListItem_t * pxListItem,
+                                               TickType_t xItemValue,
+                                               int cmock_num_calls )
+{
+    pxListItem->xItemValue = xItemValue;
+}
+
+/* ============================  KERNEL STUBS  ============================== */
+static TickType_t xTaskGetTickCount_Stub_Impl( int cmock_num_calls )
+{
+    return xTickCount;
+}
+
+static BaseType_t xQueueGenericSend_Stub_Impl( QueueHandle_t xQueue,
+                                               const void * const pvItemToQueue,
+                                               TickType_t xTicksToWait,
+                                               const BaseType_t xCopyPosition,
+                                               int cmock_num_calls )
+{
+    TEST_ASSERT_LESS_THAN( MAX_COMMANDS, uxCommandsSent );
+    memcpy( &( xCommands[ uxCommandsSent ] ), pvItemToQueue, sizeof( DaemonTaskMessage_t ) );
+    uxCommandsSent++;
+
+    return pdPASS;
+}
+
+static BaseType_t xQueueReceiveMultiple_Stub_Impl( QueueHandle_t xQueue,
+                                                   void * const pvBuffer,
+                                                   const UBaseType_t uxMaxItems,
+                                                   TickType_t xTicksToWait,
+                                                   int cmock_num_calls )
+{
+    UBaseType_t uxCount = uxCommandsSent - uxCommandsReceived;
+
+    TEST_ASSERT_EQUAL( configTIMER_COMMAND_BATCH_SIZE, uxMaxItems );
+    TEST_ASSERT_EQUAL( 0, xTicksToWait );
+
+    if( uxCount > uxMaxItems )
+    {
+        uxCount = uxMaxItems;
+    }
+
+    memcpy( pvBuffer, &( xCommands[ uxCommandsReceived ] ), uxCount * sizeof( DaemonTaskMessage_t ) );
+    uxCommandsReceived += uxCount;
+
+    if( uxReceiveCalls < MAX_COMMANDS )
+    {
+        uxBatchSizes[ uxReceiveCalls ] = uxCount;
+    }
+
+    uxReceiveCalls++;
+
+    return ( BaseType_t ) uxCount;
+}
+
+static void vQueueWaitForMessageRestricted_Stub_Impl( QueueHandle_t xQueue,
+                                                      TickType_t xTicksToWait,
+                                                      const BaseType_t xWaitIndefinitely,
+                                                      int cmock_num_calls )
+{
+    static int i = 1;
+
+    if( uxCommandsSent != uxCommandsReceived )
+    {
+        /* A command is waiting, so the timer service task does not block. */
+    }
+    else if( ( xWaitIndefinitely != pdFALSE ) || ( ( TickType_t ) ( xEndTime - xTickCount ) < xTicksToWait ) )
+    {
+        pthread_exit( &i );
+    }
+    else
+    {
+        xTickCount += xTicksToWait;
+        uxWakeUps++;
+    }
+}
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+static void xCallback_Record( TimerHandle_t xTimer )
+{
+    TEST_ASSERT_LESS_THAN( MAX_EXPIRIES, uxExpiries );
+    xExpiredTimers[ uxExpiries ] = xTimer;
+    xExpiryTimes[ uxExpiries ] = xTickCount;
+    uxExpiries++;
+}
+
+/* ============================  STATIC FUNCTIONS =========================== */
+static void * timer_thread_function( void * args )
+{
+    void * pvParameters = NULL;
+
+    portTASK_FUNCTION( prvTimerTask, pvParameters );
+    ( void ) fool_static2; /* ignore unused variable warning */
+    /* API Call */
+    prvTimerTask( pvParameters );
+    return NULL;
+}
+
+static void run_timer_task_until( TickType_t xTime )
+{
+    pthread_t thread_id;
+    int * retVal;
+
+    xEndTime = xTime;
+    pthread_create( &thread_id, NULL, &timer_thread_function, NULL );
+    pthread_join( thread_id, ( void ** ) &retVal );
+    TEST_ASSERT_EQUAL( 1, *retVal );
+}
+
+/* ==============================  UNITY FIXTURES  ========================== */
+
+void setUp( void )
+{
+    vFakeAssert_Ignore();
+    /* Track calls to malloc / free */
+    UnityMalloc_StartTest();
+    critical_section_counter = 0;
+    xTickCount = 0;
+    xEndTime = 0;
+    uxCommandsSent = 0;
+    uxCommandsReceived = 0;
+    uxReceiveCalls = 0;
+    memset( uxBatchSizes, 0, sizeof( uxBatchSizes ) );
+    uxWakeUps = 0;
+    uxExpiries = 0;
+    stopTimers();
+
+    vListInitialise_Stub( vListInitialise_Stub_Impl );
+    vListInitialiseItem_Stub( vListInitialiseItem_Stub_Impl );
+    vListInsertEnd_Stub( vListInsertEnd_Stub_Impl );
+    uxListRemove_Stub( uxListRemove_Stub_Impl );
+    listLIST_IS_EMPTY_Stub( listLIST_IS_EMPTY_Stub_Impl );
+    listGET_OWNER_OF_HEAD_ENTRY_Stub( listGET_OWNER_OF_HEAD_ENTRY_Stub_Impl );
+    listGET_ITEM_VALUE_OF_HEAD_ENTRY_Stub( listGET_ITEM_VALUE_OF_HEAD_ENTRY_Stub_Impl );
+    listIS_CONTAINED_WITHIN_Stub( listIS_CONTAINED_WITHIN_Stub_Impl );
+    listGET_LIST_ITEM_VALUE_Stub( listGET_LIST_ITEM_VALUE_Stub_Impl );
+    listSET_LIST_ITEM_VALUE_Stub( listSET_LIST_ITEM_VALUE_Stub_Impl );
+    xTaskGetTickCount_Stub( xTaskGetTickCount_Stub_Impl );
+    xQueueGenericSend_Stub( xQueueGenericSend_Stub_Impl );
+    xQueueReceiveMultiple_Stub( xQueueReceiveMultiple_Stub_Impl );
+    vQueueWaitForMessageRestricted_Stub( vQueueWaitForMessageRestricted_Stub_Impl );
+    xQueueGenericCreateStatic_IgnoreAndReturn( ( QueueHandle_t ) 3 );
+    vQueueAddToRegistry_Ignore();
+    xTaskGetSchedulerState_IgnoreAndReturn( taskSCHEDULER_RUNNING );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+}
+
+/*! called before each testcase */
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL_INT_MESSAGE( 0, usMallocFreeCalls,
+                                   "free is not called the same number of times as malloc,"
+                                   "you might have a memory leak!!" );
+    usMallocFreeCalls = 0;
+
+    UnityMalloc_EndTest();
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ==============================  TEST FUNCTIONS  ========================== */
+
+/**
+ * @brief Timers that are placed on different levels of the wheel expire in
+ *        expiry time order, each on the tick it is due.
+ */
+void test_timer_wheel_expires_timers_in_order( void )
+{
+    const TickType_t xPeriods[] = { 700, 3, 1000, 70, 17, 300, 4, 64 };
+    const UBaseType_t uxNumTimers = sizeof( xPeriods ) / sizeof( xPeriods[ 0 ] );
+    StaticTimer_t xTimerBuffers[ sizeof( xPeriods ) / sizeof( xPeriods[ 0 ] ) ];
+    TimerHandle_t xTimers[ sizeof( xPeriods ) / sizeof( xPeriods[ 0 ] ) ];
+    UBaseType_t uxTimer;
+    const TickType_t xStartTime = 1237;
+
+    /* Setup */
+    xTickCount = xStartTime;
+
+    for( uxTimer = 0; uxTimer < uxNumTimers; uxTimer++ )
+    {
+        xTimers[ uxTimer ] = xTimerCreateStatic( "ut_timer", xPeriods[ uxTimer ], pdFALSE, NULL, xCallback_Record, &( xTimerBuffers[ uxTimer ] ) );
+        TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ uxTimer ], 0 ) );
+    }
+
+    /* API Call */
+    run_timer_task_until( xStartTime + 2000 );
+
+    /* Validations */
+    TEST_ASSERT_EQUAL( uxNumTimers, uxExpiries );
+
+    for( uxTimer = 1; uxTimer < uxExpiries; uxTimer++ )
+    {
+        TEST_ASSERT_GREATER_OR_EQUAL( xExpiryTimes[ uxTimer - 1 ], xExpiryTimes[ uxTimer ] );
+    }
+
+    for( uxTimer = 0; uxTimer < uxExpiries; uxTimer++ )
+    {
+        TimerHandle_t xTimer = xExpiredTimers[ uxTimer ];
+
+        TEST_ASSERT_EQUAL( xStartTime + xTimerGetPeriod( xTimer ), xExpiryTimes[ uxTimer ] );
+        TEST_ASSERT_FALSE( xTimerIsTimerActive( xTimer ) );
+    }
+}
+
+/**
+ * @brief The timer service task only wakes when a timer expires or a slot on
+ *        a higher level of the wheel is moved down, not on every tick.
+ */
+void test_timer_wheel_wakes_only_for_events( void )
+{
+    StaticTimer_t xTimerBuffer;
+    TimerHandle_t xTimer;
+
+    /* Setup */
+    xTimer = xTimerCreateStatic( "ut_timer", 1000, pdFALSE, NULL, xCallback_Record, &xTimerBuffer );
+    xTimerStart( xTimer, 0 );
+
+    /* API Call */
+    run_timer_task_until( 2000 );
+
+    /* Validations */
+    TEST_ASSERT_EQUAL( 1, uxExpiries );
+    TEST_ASSERT_EQUAL( 1000, xExpiryTimes[ 0 ] );
+    /* 1000 ticks with 4 slots per level needs at most one wake for each level
+     * the timer moves down through, plus one for each of the 3 slots it can
+     * pass on each level. */
+    TEST_ASSERT_LESS_OR_EQUAL( 4 * 5, uxWakeUps );
+}
+
+/**
+ * @brief Timers expire on the right tick when their expiry times overflow the
+ *        tick count.
+ */
+void test_timer_wheel_tick_count_overflow( void )
+{
+    const TickType_t xStartTime = portMAX_DELAY - ( TickType_t ) 100;
+    StaticTimer_t xTimerBuffers[ 3 ];
+    TimerHandle_t xTimers[ 3 ];
+
+    /* Setup */
+    xTickCount = xStartTime;
+    xTimers[ 0 ] = xTimerCreateStatic( "ut_timer", 600, pdFALSE, NULL, xCallback_Record, &( xTimerBuffers[ 0 ] ) );
+    xTimers[ 1 ] = xTimerCreateStatic( "ut_timer", 50, pdFALSE, NULL, xCallback_Record, &( xTimerBuffers[ 1 ] ) );
+    xTimers[ 2 ] = xTimerCreateStatic( "ut_timer", 101, pdFALSE, NULL, xCallback_Record, &( xTimerBuffers[ 2 ] ) );
+    xTimerStart( xTimers[ 0 ], 0 );
+    xTimerStart( xTimers[ 1 ], 0 );
+    xTimerStart( xTimers[ 2 ], 0 );
+
+    /* API Call */
+    run_timer_task_until( xStartTime + 1000 );
+
+    /* Validations */
+    TEST_ASSERT_EQUAL( 3, uxExpiries );
+    TEST_ASSERT_EQUAL_PTR( xTimers[ 1 ], xExpiredTimers[ 0 ] );
+    TEST_ASSERT_EQUAL( ( TickType_t ) ( xStartTime + 50 ), xExpiryTimes[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( xTimers[ 2 ], xExpiredTimers[ 1 ] );
+    TEST_ASSERT_EQUAL( ( TickType_t ) 0, xExpiryTimes[ 1 ] );
+    TEST_ASSERT_EQUAL_PTR( xTimers[ 0 ], xExpiredTimers[ 2 ] );
+    TEST_ASSERT_EQUAL( ( TickType_t ) ( xStartTime + 600 ), xExpiryTimes[ 2 ] );
+}
+
+/**
+ * @brief A stopped timer does not expire.
+ */
+void test_timer_wheel_stopped_timer_does_not_expire( void )
+{
+    StaticTimer_t xTimerBuffers[ 2 ];
+    TimerHandle_t xTimers[ 2 ];
+
+    /* Setup */
+    xTimers[ 0 ] = xTimerCreateStatic( "ut_timer", 200, pdFALSE, NULL, xCallback_Record, &( xTimerBuffers[ 0 ] ) );
+    xTimers[ 1 ] = xTimerCreateStatic( "ut_timer", 300, pdFALSE, NULL, xCallback_Record, &( xTimerBuffers[ 1 ] ) );
+    xTimerStart( xTimers[ 0 ], 0 );
+    xTimerStart( xTimers[ 1 ], 0 );
+    xTimerStop( xTimers[ 0 ], 0 );
+
+    /* API Call */
+    run_timer_task_until( 1000 );
+
+    /* Validations */
+    TEST_ASSERT_EQUAL( 1, uxExpiries );
+    TEST_ASSERT_EQUAL_PTR( xTimers[ 1 ], xExpiredTimers[ 0 ] );
+    TEST_ASSERT_EQUAL( 300, xExpiryTimes[ 0 ] );
+}
+
+/**
+ * @brief An auto-reload timer on the wheel expires once every period.
+ */
+void test_timer_wheel_auto_reload( void )
+{
+    StaticTimer_t xTimerBuffer;
+    TimerHandle_t xTimer;
+    UBaseType_t uxExpiry;
+
+    /* Setup */
+    xTimer = xTimerCreateStatic( "ut_timer", 37, pdTRUE, NULL, xCallback_Record, &xTimerBuffer );
+    xTimerStart( xTimer, 0 );
+
+    /* API Call */
+    run_timer_task_until( 37 * 20 );
+
+    /* Validations */
+    TEST_ASSERT_EQUAL( 20, uxExpiries );
+
+    for( uxExpiry = 0; uxExpiry < uxExpiries; uxExpiry++ )
+    {
+        TEST_ASSERT_EQUAL( 37 * ( uxExpiry + 1 ), xExpiryTimes[ uxExpiry ] );
+    }
+}
+
+/**
+ * @brief The slack is rounded down to one less than a power of two.
+ */
+void test_vTimerSetSlack_rounds_down( void )
+{
+    StaticTimer_t xTimerBuffer;
+    TimerHandle_t xTimer;
+
+    /* Setup */
+    xTimer = xTimerCreateStatic( "ut_timer", 10, pdFALSE, NULL, xCallback_Record, &xTimerBuffer );
+
+    /* API Calls and Validations */
+    TEST_ASSERT_EQUAL( 0, xTimerGetSlack( xTimer ) );
+    vTimerSetSlack( xTimer, 1 );
+    TEST_ASSERT_EQUAL( 1, xTimerGetSlack( xTimer ) );
+    vTimerSetSlack( xTimer, 10 );
+    TEST_ASSERT_EQUAL( 7, xTimerGetSlack( xTimer ) );
+    vTimerSetSlack( xTimer, 16 );
+    TEST_ASSERT_EQUAL( 15, xTimerGetSlack( xTimer ) );
+    vTimerSetSlack( xTimer, portMAX_DELAY );
+    TEST_ASSERT_EQUAL( portMAX_DELAY, xTimerGetSlack( xTimer ) );
+    vTimerSetSlack( xTimer, 0 );
+    TEST_ASSERT_EQUAL( 0, xTimerGetSlack( xTimer ) );
+    TEST_ASSERT_EQUAL( 0, critical_section_counter );
+}
+
+/**
+ * @brief Timers with slack that are due at different times expire together,
+ *        and xTimerGetExpiryTime() returns the later time.
+ */
+void test_timer_slack_coalesces_expiries( void )
+{
+    StaticTimer_t xTimerBuffers[ 3 ];
+    TimerHandle_t xTimers[ 3 ];
+
+    /* Setup */
+    xTimers[ 0 ] = xTimerCreateStatic( "ut_timer", 13, pdFALSE, NULL, xCallback_Record, &( xTimerBuffers[ 0 ] ) );
+    xTimers[ 1 ] = xTimerCreateStatic( "ut_timer", 15, pdFALSE, NULL, xCallback_Record, &( xTimerBuffers[ 1 ] ) );
+    xTimers[ 2 ] = xTimerCreateStatic( "ut_timer", 9, pdFALSE, NULL, xCallback_Record, &( xTimerBuffers[ 2 ] ) );
+    vTimerSetSlack( xTimers[ 0 ], 15 );
+    vTimerSetSlack( xTimers[ 1 ], 15 );
+    vTimerSetSlack( xTimers[ 2 ], 15 );
+    xTimerStart( xTimers[ 0 ], 0 );
+    xTimerStart( xTimers[ 1 ], 0 );
+    xTimerStart( xTimers[ 2 ], 0 );
+
+    /* API Call */
+    run_timer_task_until( 100 );
+
+    /* Validations */
+    TEST_ASSERT_EQUAL( 3, uxExpiries );
+    TEST_ASSERT_EQUAL( 16, xExpiryTimes[ 0 ] );
+    TEST_ASSERT_EQUAL( 16, xExpiryTimes[ 1 ] );
+    TEST_ASSERT_EQUAL( 16, xExpiryTimes[ 2 ] );
+    TEST_ASSERT_EQUAL( 16, xTimerGetExpiryTime( xTimers[ 0 ] ) );
+}
+
+/**
+ * @brief The period of an auto-reload timer with slack is measured from the
+ *        time it was due, so the timer does not drift.
+ */
+void test_timer_slack_does_not_drift( void )
+{
+    StaticTimer_t xTimerBuffer;
+    TimerHandle_t xTimer;
+    UBaseType_t uxExpiry;
+    TickType_t xDueTime;
+
+    /* Setup */
+    xTimer = xTimerCreateStatic( "ut_timer", 10, pdTRUE, NULL, xCallback_Record, &xTimerBuffer );
+    vTimerSetSlack( xTimer, 7 );
+    xTimerStart( xTimer, 0 );
+
+    /* API Call */
+    run_timer_task_until( 405 );
+
+    /* Validations */
+    TEST_ASSERT_EQUAL( 40, uxExpiries );
+
+    for( uxExpiry = 0; uxExpiry < uxExpiries; uxExpiry++ )
+    {
+        /* Due every 10 ticks, expiring on the next multiple of 8. */
+        xDueTime = 10 * ( uxExpiry + 1 );
+        TEST_ASSERT_EQUAL( ( xDueTime + 7 ) & ~7U, xExpiryTimes[ uxExpiry ] );
+    }
+}
+
+/**
+ * @brief The timer service task receives commands configTIMER_COMMAND_BATCH_SIZE
+ *        at a time, and processes them in the order they were sent.
+ */
+void test_timer_commands_received_in_batches( void )
+{
+    StaticTimer_t xTimerBuffers[ 6 ];
+    TimerHandle_t xTimers[ 6 ];
+    UBaseType_t uxTimer;
+
+    /* Setup */
+    for( uxTimer = 0; uxTimer < 6; uxTimer++ )
+    {
+        xTimers[ uxTimer ] = xTimerCreateStatic( "ut_timer", 5, pdFALSE, NULL, xCallback_Record, &( xTimerBuffers[ uxTimer ] ) );
+        xTimerStart( xTimers[ uxTimer ], 0 );
+    }
+
+    /* API Call */
+    run_timer_task_until( 100 );
+
+    /* Validations */
+    TEST_ASSERT_EQUAL( 6, uxCommandsReceived );
+    /* Two batches are received, then the queue is found to be empty. */
+    TEST_ASSERT_EQUAL( configTIMER_COMMAND_BATCH_SIZE, uxBatchSizes[ 0 ] );
+    TEST_ASSERT_EQUAL( 6 - configTIMER_COMMAND_BATCH_SIZE, uxBatchSizes[ 1 ] );
+    TEST_ASSERT_EQUAL( 0, uxBatchSizes[ 2 ] );
+    TEST_ASSERT_EQUAL( 6, uxExpiries );
+
+    for( uxTimer = 0; uxTimer < 6; uxTimer++ )
+    {
+        TEST_ASSERT_EQUAL_PTR( xTimers[ uxTimer ], xExpiredTimers[ uxTimer ] );
+        TEST_ASSERT_EQUAL( 5, xExpiryTimes[ uxTimer ] );
+    }
+}
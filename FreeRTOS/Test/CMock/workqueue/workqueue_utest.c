@@ -0,0 +1,472 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file workqueue_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Work queue includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "workqueue.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "unity_memory.h"
+#include "CException.h"
+
+/* Mock includes. */
+#include "mock_task.h"
+#include "mock_fake_assert.h"
+#include "mock_fake_port.h"
+
+/* ===========================  DEFINES CONSTANTS  ========================== */
+#define WORKQUEUE_ASSERT_E     ( 0xAA55 )
+#define WORKQUEUE_STOP_E       ( 0x55AA )
+#define WORKQUEUE_PRIORITY     ( configMAX_PRIORITIES - 1 )
+#define WORKQUEUE_STACK        ( configMINIMAL_STACK_SIZE )
+#define WORK_ITEM_COUNT        ( 3 )
+
+/* Expect call to fail a configASSERT(), and stop it at that point. */
+#define EXPECT_ASSERT_BREAK( call )                 \
+    do                                              \
+    {                                               \
+        CEXCEPTION_T e = CEXCEPTION_NONE;           \
+        xAbortOnAssert = true;                      \
+        Try                                         \
+        {                                           \
+            call;                                   \
+            TEST_FAIL();                            \
+        }                                           \
+        Catch( e )                                  \
+        TEST_ASSERT_EQUAL( WORKQUEUE_ASSERT_E, e ); \
+        xAbortOnAssert = false;                     \
+    } while( 0 )
+
+/* ===========================  GLOBAL VARIABLES  =========================== */
+
+/**
+ * @brief The work queue under test, and the worker task it creates.
+ */
+static WorkQueueHandle_t xWorkQueue = NULL;
+static uint32_t ulWorker;
+#define WORKER_TASK    ( ( TaskHandle_t ) &ulWorker )
+static TaskFunction_t pxWorkerFunction = NULL;
+static void * pvWorkerParameter = NULL;
+static BaseType_t xTaskCreateReturn = pdPASS;
+
+/**
+ * @brief The work items, and the order in which their functions ran.
+ */
+static StaticWorkItem_t xWorkItemBuffers[ WORK_ITEM_COUNT ];
+static WorkItemHandle_t xWorkItems[ WORK_ITEM_COUNT ];
+static uint32_t ulRunOrder[ WORK_ITEM_COUNT * 2 ];
+static uint32_t ulRunCount = 0;
+static BaseType_t xResubmitReturn = pdFALSE;
+
+/**
+ * @brief The value returned by the run time counter.
+ */
+static unsigned long ulRunTimeCounter = 0;
+
+/**
+ * @brief The number of failed configASSERT() calls, and whether a failed
+ * configASSERT() throws.
+ */
+static int iAssertFailures = 0;
+static bool xAbortOnAssert = false;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+void * pvPortMalloc( size_t xSize )
+{
+    return unity_malloc( xSize );
+}
+
+void vPortFree( void * pv )
+{
+    unity_free( pv );
+}
+
+unsigned long ulGetRunTimeCounterValue( void )
+{
+    return ulRunTimeCounter;
+}
+
+static void vFakeAssertStub( bool x,
+                             char * file,
+                             int line,
+                             int cmock_num_calls )
+{
+    ( void ) file;
+    ( void ) line;
+    ( void ) cmock_num_calls;
+
+    if( !x )
+    {
+        iAssertFailures++;
+
+        if( xAbortOnAssert )
+        {
+            Throw( WORKQUEUE_ASSERT_E );
+        }
+    }
+}
+
+static BaseType_t xTaskCreateStub( TaskFunction_t pxTaskCode,
+                                   const char * const pcName,
+                                   const configSTACK_DEPTH_TYPE usStackDepth,
+                                   void * const pvParameters,
+                                   UBaseType_t uxPriority,
+                                   TaskHandle_t * const pxCreatedTask,
+                                   int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    TEST_ASSERT_EQUAL_STRING( "Work", pcName );
+    TEST_ASSERT_EQUAL( WORKQUEUE_STACK, usStackDepth );
+    TEST_ASSERT_EQUAL( WORKQUEUE_PRIORITY, uxPriority );
+
+    pxWorkerFunction = pxTaskCode;
+    pvWorkerParameter = pvParameters;
+    *pxCreatedTask = WORKER_TASK;
+
+    return xTaskCreateReturn;
+}
+
+/* The first wait returns a notification.  The second stops the worker, which
+ * would otherwise block for ever. */
+static uint32_t ulNotifyTakeStub( UBaseType_t uxIndexToWaitOn,
+                                  BaseType_t xClearCountOnExit,
+                                  TickType_t xTicksToWait,
+                                  int cmock_num_calls )
+{
+    ( void ) uxIndexToWaitOn;
+    ( void ) xClearCountOnExit;
+
+    TEST_ASSERT_EQUAL( portMAX_DELAY, xTicksToWait );
+
+    if( cmock_num_calls > 0 )
+    {
+        Throw( WORKQUEUE_STOP_E );
+    }
+
+    return 1U;
+}
+
+static void vNotifyGiveFromISRStub( TaskHandle_t xTaskToNotify,
+                                    UBaseType_t uxIndexToNotify,
+                                    BaseType_t * pxHigherPriorityTaskWoken,
+                                    int cmock_num_calls )
+{
+    ( void ) uxIndexToNotify;
+    ( void ) cmock_num_calls;
+
+    TEST_ASSERT_EQUAL_PTR( WORKER_TASK, xTaskToNotify );
+
+    if( pxHigherPriorityTaskWoken != NULL )
+    {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+}
+
+/* The function of every work item records the index of the item it was
+ * created for. */
+static void prvRecordWork( void * pvParameter )
+{
+    ulRunOrder[ ulRunCount ] = ( uint32_t ) ( uintptr_t ) pvParameter;
+    ulRunCount++;
+}
+
+/* Submits its own item again while it runs. */
+static void prvResubmitWork( void * pvParameter )
+{
+    prvRecordWork( pvParameter );
+
+    if( ulRunCount == 1 )
+    {
+        xResubmitReturn = xWorkQueueSubmit( xWorkQueue, xWorkItems[ ( uintptr_t ) pvParameter ] );
+    }
+}
+
+/* ============================  Unity Fixtures  ============================ */
+/*! called before each testcase */
+void setUp( void )
+{
+    xWorkQueue = NULL;
+    pxWorkerFunction = NULL;
+    pvWorkerParameter = NULL;
+    xTaskCreateReturn = pdPASS;
+    ulRunCount = 0;
+    xResubmitReturn = pdFALSE;
+    ulRunTimeCounter = 0;
+    iAssertFailures = 0;
+    xAbortOnAssert = false;
+    memset( ulRunOrder, 0xFF, sizeof( ulRunOrder ) );
+
+    vFakeAssert_StubWithCallback( vFakeAssertStub );
+    vFakePortEnterCriticalSection_Ignore();
+    vFakePortExitCriticalSection_Ignore();
+    ulFakePortSetInterruptMaskFromISR_IgnoreAndReturn( 0U );
+    vFakePortClearInterruptMaskFromISR_Ignore();
+    vFakePortAssertIfInterruptPriorityInvalid_Ignore();
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdFALSE );
+    xTaskCreate_Stub( xTaskCreateStub );
+
+    /* Track calls to malloc / free */
+    UnityMalloc_StartTest();
+}
+
+/*! called after each testcase */
+void tearDown( void )
+{
+    /* Work queues cannot be deleted, so free the memory that holds the queue
+     * directly. */
+    if( xWorkQueue != NULL )
+    {
+        vPortFree( xWorkQueue );
+    }
+
+    UnityMalloc_EndTest();
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ===========================  Static Functions  =========================== */
+
+static void prvCreateWorkQueue( WorkFunction_t pxFunction )
+{
+    uint32_t x;
+
+    xWorkQueue = xWorkQueueCreate( "Work", WORKQUEUE_PRIORITY, WORKQUEUE_STACK );
+    TEST_ASSERT_NOT_NULL( xWorkQueue );
+
+    for( x = 0; x < WORK_ITEM_COUNT; x++ )
+    {
+        xWorkItems[ x ] = xWorkItemCreateStatic( pxFunction, ( void * ) ( uintptr_t ) x, &( xWorkItemBuffers[ x ] ) );
+        TEST_ASSERT_NOT_NULL( xWorkItems[ x ] );
+    }
+}
+
+/* Runs the worker until it has emptied its list once. */
+static void prvRunWorker( void )
+{
+    CEXCEPTION_T e = CEXCEPTION_NONE;
+
+    ulTaskGenericNotifyTake_Stub( ulNotifyTakeStub );
+
+    Try
+    {
+        pxWorkerFunction( pvWorkerParameter );
+        TEST_FAIL();
+    }
+    Catch( e )
+    TEST_ASSERT_EQUAL( WORKQUEUE_STOP_E, e );
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/*!
+ * @brief validate creating a work queue creates its worker, and the statistics
+ * of a new work queue
+ * @coverage xWorkQueueCreate xWorkQueueGetWorkerTask vWorkQueueGetStats
+ */
+void test_xWorkQueueCreate_Success( void )
+{
+    WorkQueueStats_t xStats;
+
+    prvCreateWorkQueue( prvRecordWork );
+
+    TEST_ASSERT_NOT_NULL( pxWorkerFunction );
+    TEST_ASSERT_EQUAL_PTR( xWorkQueue, pvWorkerParameter );
+    TEST_ASSERT_EQUAL_PTR( WORKER_TASK, xWorkQueueGetWorkerTask( xWorkQueue ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xWorkItemIsPending( xWorkItems[ 0 ] ) );
+
+    vWorkQueueGetStats( xWorkQueue, &xStats );
+    TEST_ASSERT_EQUAL( 0, xStats.ulExecuted );
+    TEST_ASSERT_EQUAL( 0, xStats.ulCoalesced );
+    TEST_ASSERT_EQUAL( 0, xStats.ulTotalLatency );
+    TEST_ASSERT_EQUAL( 0, xStats.ulMaximumLatency );
+    TEST_ASSERT_EQUAL( 0, iAssertFailures );
+}
+
+/*!
+ * @brief validate a work queue is not created, and nothing is leaked, if its
+ * memory or its worker cannot be allocated
+ * @coverage xWorkQueueCreate
+ */
+void test_xWorkQueueCreate_Fail( void )
+{
+    UnityMalloc_MakeMallocFailAfterCount( 0 );
+    TEST_ASSERT_NULL( xWorkQueueCreate( "Work", WORKQUEUE_PRIORITY, WORKQUEUE_STACK ) );
+    TEST_ASSERT_NULL( pxWorkerFunction );
+
+    UnityMalloc_MakeMallocFailAfterCount( -1 );
+    xTaskCreateReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+    TEST_ASSERT_NULL( xWorkQueueCreate( "Work", WORKQUEUE_PRIORITY, WORKQUEUE_STACK ) );
+}
+
+/*!
+ * @brief validate a work item is not created without a function or memory
+ * @coverage xWorkItemCreateStatic
+ */
+void test_xWorkItemCreateStatic_NullParameters( void )
+{
+    TEST_ASSERT_NULL( xWorkItemCreateStatic( prvRecordWork, NULL, NULL ) );
+    TEST_ASSERT_EQUAL( 1, iAssertFailures );
+
+    EXPECT_ASSERT_BREAK( xWorkItemCreateStatic( NULL, NULL, &( xWorkItemBuffers[ 0 ] ) ) );
+}
+
+/*!
+ * @brief validate only a submission to an empty work queue notifies the
+ * worker, and that submitting a pending item coalesces with the pending
+ * submission
+ * @coverage xWorkQueueSubmit xWorkItemIsPending
+ */
+void test_xWorkQueueSubmit_NotifyOnceAndCoalesce( void )
+{
+    WorkQueueStats_t xStats;
+
+    prvCreateWorkQueue( prvRecordWork );
+
+    xTaskGenericNotify_ExpectAndReturn( WORKER_TASK, tskDEFAULT_INDEX_TO_NOTIFY, 0, eIncrement, NULL, pdPASS );
+    TEST_ASSERT_EQUAL( pdPASS, xWorkQueueSubmit( xWorkQueue, xWorkItems[ 0 ] ) );
+    TEST_ASSERT_EQUAL( pdPASS, xWorkQueueSubmit( xWorkQueue, xWorkItems[ 1 ] ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xWorkQueueSubmit( xWorkQueue, xWorkItems[ 0 ] ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xWorkQueueSubmit( xWorkQueue, xWorkItems[ 1 ] ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xWorkItemIsPending( xWorkItems[ 0 ] ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xWorkItemIsPending( xWorkItems[ 1 ] ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xWorkItemIsPending( xWorkItems[ 2 ] ) );
+
+    vWorkQueueGetStats( xWorkQueue, &xStats );
+    TEST_ASSERT_EQUAL( 0, xStats.ulExecuted );
+    TEST_ASSERT_EQUAL( 2, xStats.ulCoalesced );
+    TEST_ASSERT_EQUAL( 0, ulRunCount );
+}
+
+/*!
+ * @brief validate the worker runs each item once, in the order the items were
+ * submitted, and records the latency from submission to running
+ * @coverage prvWorkerTask vWorkQueueGetStats
+ */
+void test_prvWorkerTask_RunsInSubmissionOrder( void )
+{
+    WorkQueueStats_t xStats;
+
+    prvCreateWorkQueue( prvRecordWork );
+    xTaskGenericNotify_IgnoreAndReturn( pdPASS );
+
+    ulRunTimeCounter = 100;
+    ( void ) xWorkQueueSubmit( xWorkQueue, xWorkItems[ 2 ] );
+    ulRunTimeCounter = 110;
+    ( void ) xWorkQueueSubmit( xWorkQueue, xWorkItems[ 0 ] );
+    ( void ) xWorkQueueSubmit( xWorkQueue, xWorkItems[ 2 ] );
+    ulRunTimeCounter = 130;
+    ( void ) xWorkQueueSubmit( xWorkQueue, xWorkItems[ 1 ] );
+
+    ulRunTimeCounter = 150;
+    prvRunWorker();
+
+    TEST_ASSERT_EQUAL( 3, ulRunCount );
+    TEST_ASSERT_EQUAL( 2, ulRunOrder[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, ulRunOrder[ 1 ] );
+    TEST_ASSERT_EQUAL( 1, ulRunOrder[ 2 ] );
+    TEST_ASSERT_EQUAL( pdFALSE, xWorkItemIsPending( xWorkItems[ 0 ] ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xWorkItemIsPending( xWorkItems[ 1 ] ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xWorkItemIsPending( xWorkItems[ 2 ] ) );
+
+    vWorkQueueGetStats( xWorkQueue, &xStats );
+    TEST_ASSERT_EQUAL( 3, xStats.ulExecuted );
+    TEST_ASSERT_EQUAL( 1, xStats.ulCoalesced );
+    TEST_ASSERT_EQUAL( 50 + 40 + 20, xStats.ulTotalLatency );
+    TEST_ASSERT_EQUAL( 50, xStats.ulMaximumLatency );
+}
+
+/*!
+ * @brief validate an item submitted again while it runs is not coalesced, and
+ * notifies the worker because the worker has already emptied its list
+ * @coverage xWorkQueueSubmit prvWorkerTask
+ */
+void test_xWorkQueueSubmit_WhileRunning( void )
+{
+    prvCreateWorkQueue( prvResubmitWork );
+
+    xTaskGenericNotify_ExpectAndReturn( WORKER_TASK, tskDEFAULT_INDEX_TO_NOTIFY, 0, eIncrement, NULL, pdPASS );
+    ( void ) xWorkQueueSubmit( xWorkQueue, xWorkItems[ 1 ] );
+
+    xTaskGenericNotify_ExpectAndReturn( WORKER_TASK, tskDEFAULT_INDEX_TO_NOTIFY, 0, eIncrement, NULL, pdPASS );
+    prvRunWorker();
+
+    TEST_ASSERT_EQUAL( pdPASS, xResubmitReturn );
+    TEST_ASSERT_EQUAL( 1, ulRunCount );
+    TEST_ASSERT_EQUAL( pdTRUE, xWorkItemIsPending( xWorkItems[ 1 ] ) );
+}
+
+/*!
+ * @brief validate submitting from an interrupt notifies the worker only when
+ * the work queue was empty, and reports whether the worker was woken
+ * @coverage xWorkQueueSubmitFromISR
+ */
+void test_xWorkQueueSubmitFromISR_Success( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    WorkQueueStats_t xStats;
+
+    prvCreateWorkQueue( prvRecordWork );
+    vTaskGenericNotifyGiveFromISR_Stub( vNotifyGiveFromISRStub );
+
+    TEST_ASSERT_EQUAL( pdPASS, xWorkQueueSubmitFromISR( xWorkQueue, xWorkItems[ 0 ], &xHigherPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xHigherPriorityTaskWoken );
+
+    xHigherPriorityTaskWoken = pdFALSE;
+    TEST_ASSERT_EQUAL( pdPASS, xWorkQueueSubmitFromISR( xWorkQueue, xWorkItems[ 1 ], &xHigherPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xWorkQueueSubmitFromISR( xWorkQueue, xWorkItems[ 1 ], NULL ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xHigherPriorityTaskWoken );
+
+    prvRunWorker();
+    TEST_ASSERT_EQUAL( 2, ulRunCount );
+
+    /* The work queue is empty again, and the woken flag is optional. */
+    TEST_ASSERT_EQUAL( pdPASS, xWorkQueueSubmitFromISR( xWorkQueue, xWorkItems[ 1 ], NULL ) );
+
+    vWorkQueueGetStats( xWorkQueue, &xStats );
+    TEST_ASSERT_EQUAL( 2, xStats.ulExecuted );
+    TEST_ASSERT_EQUAL( 1, xStats.ulCoalesced );
+}